@@ -0,0 +1,498 @@
+///////////////////////////////////////////////////////////////////////////////
+// allocationtracker.cpp
+// ============
+// count the general heap allocations by profiling scope and guard the code that
+// must not make any
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "AllocationTracker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <new>
+
+// declare the global variables
+namespace
+{
+	// most profiling scopes, and how deeply they can be nested on a thread
+	const int MAX_SCOPES = 32;
+	const int MAX_SCOPE_DEPTH = 16;
+
+	// allocations counted against one profiling scope
+	struct SCOPE_COUNTERS
+	{
+		const char* name;
+		std::atomic<unsigned long long> count;
+		std::atomic<unsigned long long> bytes;
+		std::atomic<unsigned long long> entries;
+		// totals when the current frame started and in the last frame
+		unsigned long long frameStartCount;
+		unsigned long long frameStartBytes;
+		unsigned long long lastFrameCount;
+		unsigned long long lastFrameBytes;
+		// totals when the counters were last reset
+		unsigned long long reportStartCount;
+		unsigned long long reportStartBytes;
+		unsigned long long reportStartEntries;
+	};
+
+	// the scopes in the order they were first entered, where scope 0
+	// holds the allocations made outside of every scope
+	SCOPE_COUNTERS g_scopes[MAX_SCOPES];
+	std::atomic<int> g_scopeCount(1);
+	std::mutex g_scopeLock;
+
+	// allocations and bytes made on every thread, the totals when the
+	// current frame started and the last closed frame
+	std::atomic<unsigned long long> g_allocationCount(0);
+	std::atomic<unsigned long long> g_allocationBytes(0);
+	unsigned long long g_frameStartCount = 0;
+	unsigned long long g_frameStartBytes = 0;
+	unsigned long long g_lastFrameCount = 0;
+	unsigned long long g_lastFrameBytes = 0;
+	// guarded scopes that allocated
+	std::atomic<unsigned long long> g_guardFailureCount(0);
+	std::atomic<bool> g_bGuardEnabled(false);
+
+	// allocations made on this thread
+	thread_local unsigned long long g_threadAllocationCount = 0;
+	// nesting of the no-allocation scopes on this thread, with the name
+	// and the allocation count at the start of the outermost one
+	thread_local int g_noAllocationDepth = 0;
+	thread_local const char* g_noAllocationScope = NULL;
+	thread_local unsigned long long g_noAllocationStart = 0;
+	// profiling scopes entered on this thread, innermost last
+	thread_local int g_scopeStack[MAX_SCOPE_DEPTH];
+	thread_local int g_scopeDepth = 0;
+
+	/***********************************************************
+	 *  AllocateCounted()
+	 *
+	 *  This function is used for counting an allocation against
+	 *  the innermost scope of the calling thread and taking its
+	 *  memory from the C heap.  It must not use anything that
+	 *  allocates through operator new.
+	 ***********************************************************/
+	void* AllocateCounted(size_t size)
+	{
+		g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+		g_allocationBytes.fetch_add(size, std::memory_order_relaxed);
+		g_threadAllocationCount++;
+
+		int scope = 0;
+		if (g_scopeDepth > 0)
+		{
+			scope = g_scopeStack[std::min(g_scopeDepth, MAX_SCOPE_DEPTH) - 1];
+		}
+		g_scopes[scope].count.fetch_add(1, std::memory_order_relaxed);
+		g_scopes[scope].bytes.fetch_add(size, std::memory_order_relaxed);
+
+		return(malloc((size > 0) ? size : 1));
+	}
+
+	/***********************************************************
+	 *  FindScope()
+	 *
+	 *  This function is used for finding the counters of the
+	 *  scope of the passed in name, which are added the first
+	 *  time the scope is entered.  When every slot is taken,
+	 *  the allocations are counted outside of every scope.
+	 ***********************************************************/
+	int FindScope(const char* scopeName)
+	{
+		int scopeCount = g_scopeCount.load();
+		for (int i = 1; i < scopeCount; i++)
+		{
+			if (strcmp(g_scopes[i].name, scopeName) == 0)
+			{
+				return(i);
+			}
+		}
+
+		std::lock_guard<std::mutex> lock(g_scopeLock);
+		scopeCount = g_scopeCount.load();
+		for (int i = 1; i < scopeCount; i++)
+		{
+			if (strcmp(g_scopes[i].name, scopeName) == 0)
+			{
+				return(i);
+			}
+		}
+		if (scopeCount == MAX_SCOPES)
+		{
+			return(0);
+		}
+
+		// the name is set before the scope is counted, so the
+		// lookup without the lock never sees a scope without it
+		g_scopes[scopeCount].name = scopeName;
+		g_scopeCount.store(scopeCount + 1);
+		return(scopeCount);
+	}
+
+	/***********************************************************
+	 *  GetScopeName()
+	 *
+	 *  This function is used for getting the name the scope of
+	 *  the passed in index is reported with.
+	 ***********************************************************/
+	const char* GetScopeName(int scope)
+	{
+		return((scope == 0) ? "outside of scopes" : g_scopes[scope].name);
+	}
+}
+
+/***********************************************************
+ *  operator new()
+ *
+ *  The replaced allocation functions of the application,
+ *  which count every allocation.  The aligned forms are not
+ *  replaced and are not counted.
+ ***********************************************************/
+void* operator new(size_t size)
+{
+	void* pMemory = AllocateCounted(size);
+	if (NULL == pMemory)
+	{
+		throw std::bad_alloc();
+	}
+	return(pMemory);
+}
+
+void* operator new[](size_t size)
+{
+	void* pMemory = AllocateCounted(size);
+	if (NULL == pMemory)
+	{
+		throw std::bad_alloc();
+	}
+	return(pMemory);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return(AllocateCounted(size));
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return(AllocateCounted(size));
+}
+
+/***********************************************************
+ *  operator delete()
+ *
+ *  The replaced release functions, matching the allocation
+ *  functions above.
+ ***********************************************************/
+void operator delete(void* pMemory) noexcept
+{
+	free(pMemory);
+}
+
+void operator delete[](void* pMemory) noexcept
+{
+	free(pMemory);
+}
+
+void operator delete(void* pMemory, size_t) noexcept
+{
+	free(pMemory);
+}
+
+void operator delete[](void* pMemory, size_t) noexcept
+{
+	free(pMemory);
+}
+
+void operator delete(void* pMemory, const std::nothrow_t&) noexcept
+{
+	free(pMemory);
+}
+
+void operator delete[](void* pMemory, const std::nothrow_t&) noexcept
+{
+	free(pMemory);
+}
+
+/***********************************************************
+ *  GetAllocationCount()
+ *
+ *  This method is used for getting the number of
+ *  allocations made on every thread since the start.
+ ***********************************************************/
+unsigned long long AllocationTracker::GetAllocationCount()
+{
+	return(g_allocationCount.load(std::memory_order_relaxed));
+}
+
+/***********************************************************
+ *  GetThreadAllocationCount()
+ *
+ *  This method is used for getting the number of
+ *  allocations made on the calling thread since it started.
+ ***********************************************************/
+unsigned long long AllocationTracker::GetThreadAllocationCount()
+{
+	return(g_threadAllocationCount);
+}
+
+/***********************************************************
+ *  GetAllocationBytes()
+ *
+ *  This method is used for getting the number of bytes
+ *  allocated on every thread since the start.
+ ***********************************************************/
+unsigned long long AllocationTracker::GetAllocationBytes()
+{
+	return(g_allocationBytes.load(std::memory_order_relaxed));
+}
+
+/***********************************************************
+ *  BeginScope()
+ *
+ *  This method is used for counting the allocations of the
+ *  calling thread against the scope of the passed in name,
+ *  until the matching EndScope().  The name must stay valid
+ *  while the application runs, such as a string literal.
+ ***********************************************************/
+void AllocationTracker::BeginScope(const char* scopeName)
+{
+	int scope = FindScope(scopeName);
+	g_scopes[scope].entries.fetch_add(1, std::memory_order_relaxed);
+
+	// scopes nested too deeply are counted against the last one kept
+	if (g_scopeDepth < MAX_SCOPE_DEPTH)
+	{
+		g_scopeStack[g_scopeDepth] = scope;
+	}
+	g_scopeDepth++;
+}
+
+/***********************************************************
+ *  EndScope()
+ *
+ *  This method is used for returning the counting of the
+ *  calling thread to the scope that was entered before.
+ ***********************************************************/
+void AllocationTracker::EndScope()
+{
+	if (g_scopeDepth > 0)
+	{
+		g_scopeDepth--;
+	}
+}
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method is used for closing the counts of the
+ *  current frame, made on every thread, and starting the
+ *  next frame.  Only the drawing thread may call it.
+ ***********************************************************/
+void AllocationTracker::EndFrame()
+{
+	unsigned long long count = g_allocationCount.load();
+	unsigned long long bytes = g_allocationBytes.load();
+	g_lastFrameCount = count - g_frameStartCount;
+	g_lastFrameBytes = bytes - g_frameStartBytes;
+	g_frameStartCount = count;
+	g_frameStartBytes = bytes;
+
+	int scopeCount = g_scopeCount.load();
+	for (int i = 0; i < scopeCount; i++)
+	{
+		SCOPE_COUNTERS& scope = g_scopes[i];
+		count = scope.count.load();
+		bytes = scope.bytes.load();
+		scope.lastFrameCount = count - scope.frameStartCount;
+		scope.lastFrameBytes = bytes - scope.frameStartBytes;
+		scope.frameStartCount = count;
+		scope.frameStartBytes = bytes;
+	}
+}
+
+/***********************************************************
+ *  GetLastFrameAllocationCount()
+ *
+ *  This method is used for getting the number of
+ *  allocations made in the last closed frame.
+ ***********************************************************/
+unsigned long long AllocationTracker::GetLastFrameAllocationCount()
+{
+	return(g_lastFrameCount);
+}
+
+/***********************************************************
+ *  GetLastFrameAllocationBytes()
+ *
+ *  This method is used for getting the number of bytes
+ *  allocated in the last closed frame.
+ ***********************************************************/
+unsigned long long AllocationTracker::GetLastFrameAllocationBytes()
+{
+	return(g_lastFrameBytes);
+}
+
+/***********************************************************
+ *  ReportLastFrame()
+ *
+ *  This method is used for outputting the allocations and
+ *  bytes of every scope that allocated in the last closed
+ *  frame.
+ ***********************************************************/
+void AllocationTracker::ReportLastFrame()
+{
+	int scopeCount = g_scopeCount.load();
+	for (int i = 0; i < scopeCount; i++)
+	{
+		if (g_scopes[i].lastFrameCount > 0)
+		{
+			std::cout << "INFO:   " << GetScopeName(i) << ": "
+				<< g_scopes[i].lastFrameCount << " allocations, "
+				<< g_scopes[i].lastFrameBytes << " bytes" << std::endl;
+		}
+	}
+}
+
+/***********************************************************
+ *  ReportCounters()
+ *
+ *  This method is used for outputting the allocations and
+ *  bytes per frame of every scope entered since the last
+ *  reset, and the allocations each time it was entered,
+ *  then starting the counts again.
+ ***********************************************************/
+void AllocationTracker::ReportCounters(int frameCount)
+{
+	if (frameCount <= 0)
+	{
+		return;
+	}
+
+	int scopeCount = g_scopeCount.load();
+	for (int i = 0; i < scopeCount; i++)
+	{
+		SCOPE_COUNTERS& scope = g_scopes[i];
+		unsigned long long count = scope.count.load() - scope.reportStartCount;
+		unsigned long long bytes = scope.bytes.load() - scope.reportStartBytes;
+		unsigned long long entries = scope.entries.load() - scope.reportStartEntries;
+		if ((count == 0) && (entries == 0))
+		{
+			continue;
+		}
+
+		std::cout << "INFO:   " << GetScopeName(i) << ": "
+			<< ((double)count / frameCount) << " allocations, "
+			<< ((double)bytes / frameCount) << " bytes per frame";
+		if (entries > 0)
+		{
+			std::cout << ", " << ((double)count / entries) << " allocations per entry over "
+				<< ((double)entries / frameCount) << " entries per frame";
+		}
+		std::cout << std::endl;
+	}
+	ResetCounters();
+}
+
+/***********************************************************
+ *  ResetCounters()
+ *
+ *  This method is used for starting the reported counts of
+ *  every scope again.
+ ***********************************************************/
+void AllocationTracker::ResetCounters()
+{
+	int scopeCount = g_scopeCount.load();
+	for (int i = 0; i < scopeCount; i++)
+	{
+		g_scopes[i].reportStartCount = g_scopes[i].count.load();
+		g_scopes[i].reportStartBytes = g_scopes[i].bytes.load();
+		g_scopes[i].reportStartEntries = g_scopes[i].entries.load();
+	}
+}
+
+/***********************************************************
+ *  SetGuardEnabled()
+ *
+ *  This method is used for turning on or off the check of
+ *  the no-allocation scopes.
+ ***********************************************************/
+void AllocationTracker::SetGuardEnabled(bool bEnabled)
+{
+	g_bGuardEnabled.store(bEnabled);
+}
+
+/***********************************************************
+ *  IsGuardEnabled()
+ *
+ *  This method is used for checking whether the no-allocation
+ *  scopes are checked.
+ ***********************************************************/
+bool AllocationTracker::IsGuardEnabled()
+{
+	return(g_bGuardEnabled.load());
+}
+
+/***********************************************************
+ *  BeginNoAllocation()
+ *
+ *  This method is used for marking the start of code that
+ *  must not allocate on the calling thread.  Only the
+ *  outermost of nested scopes is checked.
+ ***********************************************************/
+void AllocationTracker::BeginNoAllocation(const char* scopeName)
+{
+	if (g_noAllocationDepth == 0)
+	{
+		g_noAllocationScope = scopeName;
+		g_noAllocationStart = g_threadAllocationCount;
+	}
+	g_noAllocationDepth++;
+}
+
+/***********************************************************
+ *  EndNoAllocation()
+ *
+ *  This method is used for marking the end of code that
+ *  must not allocate.  When the guard is enabled and the
+ *  outermost scope allocated, the allocations are reported
+ *  and an assertion fails.  The report is made here rather
+ *  than in operator new, where printing would allocate.
+ ***********************************************************/
+void AllocationTracker::EndNoAllocation()
+{
+	g_noAllocationDepth--;
+	if ((g_noAllocationDepth > 0) || (g_bGuardEnabled.load() == false))
+	{
+		return;
+	}
+
+	unsigned long long allocations = g_threadAllocationCount - g_noAllocationStart;
+	if (allocations > 0)
+	{
+		g_guardFailureCount.fetch_add(1);
+		std::cout << "ERROR: " << allocations << " heap allocations in "
+			<< g_noAllocationScope << ", which must not allocate" << std::endl;
+		assert(allocations == 0);
+	}
+}
+
+/***********************************************************
+ *  GetGuardFailureCount()
+ *
+ *  This method is used for getting the number of guarded
+ *  scopes that allocated while the guard was enabled.
+ ***********************************************************/
+unsigned long long AllocationTracker::GetGuardFailureCount()
+{
+	return(g_guardFailureCount.load());
+}
@@ -0,0 +1,61 @@
+///////////////////////////////////////////////////////////////////////////////
+// allocationtracker.h
+// ============
+// count the general heap allocations by profiling scope and guard the code that
+// must not make any
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+/***********************************************************
+ *  AllocationTracker
+ *
+ *  This class contains the code for counting the memory
+ *  allocated through operator new, which the application
+ *  replaces.  Every allocation is counted against the
+ *  innermost profiling scope of its thread, and the counts
+ *  are kept for each frame and for each report.  Code that
+ *  must not allocate is put between BeginNoAllocation() and
+ *  EndNoAllocation(), and when the guard is enabled an
+ *  allocation made there on the same thread is reported and
+ *  fails an assertion.
+ ***********************************************************/
+class AllocationTracker
+{
+public:
+	// get the allocations made on every thread so far
+	static unsigned long long GetAllocationCount();
+	// get the allocations made on the calling thread so far
+	static unsigned long long GetThreadAllocationCount();
+	// get the bytes allocated on every thread so far
+	static unsigned long long GetAllocationBytes();
+
+	// count the allocations on the calling thread against a profiling
+	// scope until it ends, which can be nested
+	static void BeginScope(const char* scopeName);
+	static void EndScope();
+	// close the counts of the current frame, from the drawing thread
+	static void EndFrame();
+	// get the allocations and bytes of the last closed frame
+	static unsigned long long GetLastFrameAllocationCount();
+	static unsigned long long GetLastFrameAllocationBytes();
+	// output the allocations of each scope in the last closed frame
+	static void ReportLastFrame();
+	// output the allocations of each scope per frame since the last
+	// reset, and start counting again
+	static void ReportCounters(int frameCount);
+	static void ResetCounters();
+
+	// turn the no-allocation guard on or off
+	static void SetGuardEnabled(bool bEnabled);
+	static bool IsGuardEnabled();
+	// mark the start and end of code that must not allocate on the
+	// calling thread, which can be nested
+	static void BeginNoAllocation(const char* scopeName);
+	static void EndNoAllocation();
+	// get the guarded scopes that allocated so far
+	static unsigned long long GetGuardFailureCount();
+};
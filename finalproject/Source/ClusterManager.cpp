@@ -0,0 +1,393 @@
+///////////////////////////////////////////////////////////////////////////////
+// clustermanager.cpp
+// ============
+// manage the clustered forward lighting - froxel light binning
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ClusterManager.h"
+
+#include <cmath>
+#include <algorithm>
+
+// declare the global variables
+namespace
+{
+	const char* g_TileSizeName = "clusterTileSize";
+	const std::string g_SliceScaleName = "clusterSliceScale";
+	const std::string g_SliceBiasName = "clusterSliceBias";
+
+	// total number of clusters in the froxel grid
+	const int TOTAL_CLUSTERS =
+		ClusterManager::GRID_X * ClusterManager::GRID_Y * ClusterManager::GRID_Z;
+}
+
+/***********************************************************
+ *  ClusterManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ClusterManager::ClusterManager()
+{
+	m_clusters.resize(TOTAL_CLUSTERS, glm::uvec2(0, 0));
+	m_clusterMin.resize(TOTAL_CLUSTERS);
+	m_clusterMax.resize(TOTAL_CLUSTERS);
+	m_clusterProjection = glm::mat4(0.0f);
+	m_nearPlane = 0.0f;
+	m_farPlane = 0.0f;
+	m_screenWidth = 0;
+	m_screenHeight = 0;
+	m_clusterBuffer = 0;
+	m_indexBuffer = 0;
+	m_indexBufferCapacity = 0;
+	m_lastIndexCount = 0;
+}
+
+/***********************************************************
+ *  ~ClusterManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ClusterManager::~ClusterManager()
+{
+	// free the OpenGL buffers
+	DestroyBuffers();
+}
+
+/***********************************************************
+ *  CreateBuffers()
+ *
+ *  This method is used for creating the shader storage
+ *  buffers that hold the per cluster ranges and the light
+ *  index list.
+ ***********************************************************/
+void ClusterManager::CreateBuffers()
+{
+	glGenBuffers(1, &m_clusterBuffer);
+	glGenBuffers(1, &m_indexBuffer);
+
+	// the cluster buffer never changes size
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_clusterBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, TOTAL_CLUSTERS * sizeof(glm::uvec2), NULL, GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+/***********************************************************
+ *  DestroyBuffers()
+ *
+ *  This method is used for freeing the shader storage
+ *  buffers.
+ ***********************************************************/
+void ClusterManager::DestroyBuffers()
+{
+	if (m_clusterBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_clusterBuffer);
+		m_clusterBuffer = 0;
+	}
+	if (m_indexBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_indexBuffer);
+		m_indexBuffer = 0;
+	}
+	m_indexBufferCapacity = 0;
+}
+
+/***********************************************************
+ *  GetLastIndexCount()
+ *
+ *  This method is used for getting the total number of light
+ *  references written into the clusters by the last pass.
+ ***********************************************************/
+size_t ClusterManager::GetLastIndexCount() const
+{
+	return(m_lastIndexCount);
+}
+
+/***********************************************************
+ *  GetSliceDepth()
+ *
+ *  This method is used for getting the view space depth where
+ *  a depth slice begins.  The slices are spaced exponentially
+ *  so that clusters keep a similar shape along the frustum.
+ ***********************************************************/
+float ClusterManager::GetSliceDepth(int slice) const
+{
+	return(m_nearPlane * std::pow(m_farPlane / m_nearPlane, (float)slice / (float)GRID_Z));
+}
+
+/***********************************************************
+ *  BuildClusterBounds()
+ *
+ *  This method is used for calculating the view space
+ *  bounding box of every cluster in the froxel grid.  This
+ *  only needs to be done when the projection changes.
+ ***********************************************************/
+void ClusterManager::BuildClusterBounds(
+	const glm::mat4& projection,
+	float nearPlane,
+	float farPlane)
+{
+	glm::mat4 inverseProjection = glm::inverse(projection);
+
+	m_nearPlane = nearPlane;
+	m_farPlane = farPlane;
+	m_clusterProjection = projection;
+
+	for (int z = 0; z < GRID_Z; z++)
+	{
+		float sliceNear = GetSliceDepth(z);
+		float sliceFar = GetSliceDepth(z + 1);
+
+		for (int y = 0; y < GRID_Y; y++)
+		{
+			for (int x = 0; x < GRID_X; x++)
+			{
+				glm::vec3 boxMin = glm::vec3(1.0e30f);
+				glm::vec3 boxMax = glm::vec3(-1.0e30f);
+
+				// the four corners of the screen tile on the near plane
+				for (int corner = 0; corner < 4; corner++)
+				{
+					float ndcX = -1.0f + 2.0f * (float)(x + (corner & 1)) / (float)GRID_X;
+					float ndcY = -1.0f + 2.0f * (float)(y + (corner >> 1)) / (float)GRID_Y;
+					glm::vec4 nearPoint = inverseProjection * glm::vec4(ndcX, ndcY, -1.0f, 1.0f);
+					glm::vec3 ray = glm::vec3(nearPoint) / nearPoint.w;
+
+					// slide the corner along its view ray to both slice depths
+					glm::vec3 cornerNear = ray * (sliceNear / -ray.z);
+					glm::vec3 cornerFar = ray * (sliceFar / -ray.z);
+					boxMin = glm::min(boxMin, glm::min(cornerNear, cornerFar));
+					boxMax = glm::max(boxMax, glm::max(cornerNear, cornerFar));
+				}
+
+				int index = x + (y * GRID_X) + (z * GRID_X * GRID_Y);
+				m_clusterMin[index] = boxMin;
+				m_clusterMax[index] = boxMax;
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  BinLight()
+ *
+ *  This method is used for finding every cluster that the
+ *  sphere of influence of a light overlaps.  The projected
+ *  bounds of the sphere give the range of clusters to test
+ *  and each candidate cluster box is tested against the
+ *  sphere.
+ ***********************************************************/
+void ClusterManager::BinLight(
+	const LightManager::GPU_LIGHT& light,
+	GLuint lightIndex,
+	const glm::mat4& view,
+	const glm::mat4& projection)
+{
+	glm::vec3 center = glm::vec3(view * glm::vec4(glm::vec3(light.positionRadius), 1.0f));
+	float radius = light.positionRadius.w;
+	float depthNear = -center.z - radius;
+	float depthFar = -center.z + radius;
+
+	// skip the light if it is completely in front of or behind the frustum
+	if ((depthFar < m_nearPlane) || (depthNear > m_farPlane))
+	{
+		return;
+	}
+
+	// find the range of depth slices covered by the light
+	float sliceScale = (float)GRID_Z / std::log(m_farPlane / m_nearPlane);
+	int sliceMin = 0;
+	int sliceMax = GRID_Z - 1;
+	if (depthNear > m_nearPlane)
+	{
+		sliceMin = (int)std::floor(std::log(depthNear / m_nearPlane) * sliceScale);
+	}
+	if (depthFar < m_farPlane)
+	{
+		sliceMax = (int)std::floor(std::log(depthFar / m_nearPlane) * sliceScale);
+	}
+	sliceMin = std::max(0, std::min(sliceMin, GRID_Z - 1));
+	sliceMax = std::max(0, std::min(sliceMax, GRID_Z - 1));
+
+	// find the range of screen tiles covered by the light
+	int tileMinX = 0;
+	int tileMaxX = GRID_X - 1;
+	int tileMinY = 0;
+	int tileMaxY = GRID_Y - 1;
+	if (depthNear > m_nearPlane)
+	{
+		// the whole sphere is in front of the camera, so the projected
+		// corners of its bounding box enclose it on the screen
+		glm::vec2 ndcMin = glm::vec2(1.0e30f);
+		glm::vec2 ndcMax = glm::vec2(-1.0e30f);
+		for (int corner = 0; corner < 8; corner++)
+		{
+			glm::vec3 offset = glm::vec3(
+				(corner & 1) ? radius : -radius,
+				(corner & 2) ? radius : -radius,
+				(corner & 4) ? radius : -radius);
+			glm::vec4 clip = projection * glm::vec4(center + offset, 1.0f);
+			glm::vec2 ndc = glm::vec2(clip.x, clip.y) / clip.w;
+			ndcMin = glm::min(ndcMin, ndc);
+			ndcMax = glm::max(ndcMax, ndc);
+		}
+
+		// skip the light if it is completely outside of the screen
+		if ((ndcMax.x < -1.0f) || (ndcMin.x > 1.0f) || (ndcMax.y < -1.0f) || (ndcMin.y > 1.0f))
+		{
+			return;
+		}
+
+		tileMinX = std::max(0, (int)std::floor((ndcMin.x * 0.5f + 0.5f) * GRID_X));
+		tileMaxX = std::min(GRID_X - 1, (int)std::floor((ndcMax.x * 0.5f + 0.5f) * GRID_X));
+		tileMinY = std::max(0, (int)std::floor((ndcMin.y * 0.5f + 0.5f) * GRID_Y));
+		tileMaxY = std::min(GRID_Y - 1, (int)std::floor((ndcMax.y * 0.5f + 0.5f) * GRID_Y));
+	}
+
+	float radiusSquared = radius * radius;
+	for (int z = sliceMin; z <= sliceMax; z++)
+	{
+		for (int y = tileMinY; y <= tileMaxY; y++)
+		{
+			for (int x = tileMinX; x <= tileMaxX; x++)
+			{
+				int index = x + (y * GRID_X) + (z * GRID_X * GRID_Y);
+
+				// distance from the sphere center to the closest point in the cluster
+				glm::vec3 closest = glm::clamp(center, m_clusterMin[index], m_clusterMax[index]);
+				glm::vec3 delta = closest - center;
+				if (glm::dot(delta, delta) <= radiusSquared)
+				{
+					m_clusterLightPairs.push_back(glm::uvec2((GLuint)index, lightIndex));
+				}
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  BuildClusters()
+ *
+ *  This method is used for binning all of the lights into
+ *  the clusters of the current view frustum and uploading
+ *  the results for the fragment shader.  The pairs found for
+ *  each light are sorted by cluster with a counting sort so
+ *  every cluster ends up with one contiguous run of indices.
+ ***********************************************************/
+void ClusterManager::BuildClusters(
+	const LightManager* pLightManager,
+	const glm::mat4& view,
+	const glm::mat4& projection,
+	float nearPlane,
+	float farPlane,
+	int screenWidth,
+	int screenHeight)
+{
+	m_screenWidth = screenWidth;
+	m_screenHeight = screenHeight;
+
+	// the cluster boxes only change with the projection
+	if ((projection != m_clusterProjection) ||
+		(nearPlane != m_nearPlane) ||
+		(farPlane != m_farPlane))
+	{
+		BuildClusterBounds(projection, nearPlane, farPlane);
+	}
+
+	// find the clusters overlapped by every light
+	m_clusterLightPairs.clear();
+	if (NULL != pLightManager)
+	{
+		const std::vector<LightManager::GPU_LIGHT>& lights = pLightManager->GetLights();
+		for (size_t i = 0; i < lights.size(); i++)
+		{
+			BinLight(lights[i], (GLuint)i, view, projection);
+		}
+	}
+
+	// count the lights in each cluster
+	for (int i = 0; i < TOTAL_CLUSTERS; i++)
+	{
+		m_clusters[i] = glm::uvec2(0, 0);
+	}
+	for (size_t i = 0; i < m_clusterLightPairs.size(); i++)
+	{
+		m_clusters[m_clusterLightPairs[i].x].y++;
+	}
+
+	// convert the counts into offsets into the index list
+	GLuint offset = 0;
+	for (int i = 0; i < TOTAL_CLUSTERS; i++)
+	{
+		m_clusters[i].x = offset;
+		offset += m_clusters[i].y;
+		m_clusters[i].y = 0;
+	}
+
+	// scatter the light indices into their cluster ranges
+	m_lightIndices.resize(m_clusterLightPairs.size());
+	for (size_t i = 0; i < m_clusterLightPairs.size(); i++)
+	{
+		glm::uvec2& cluster = m_clusters[m_clusterLightPairs[i].x];
+		m_lightIndices[cluster.x + cluster.y] = m_clusterLightPairs[i].y;
+		cluster.y++;
+	}
+	m_lastIndexCount = m_lightIndices.size();
+
+	UploadBuffers();
+}
+
+/***********************************************************
+ *  UploadBuffers()
+ *
+ *  This method is used for copying the cluster ranges and
+ *  the light index list into the shader storage buffers.  The
+ *  index buffer is reallocated with extra room so that it is
+ *  not resized every frame.
+ ***********************************************************/
+void ClusterManager::UploadBuffers()
+{
+	size_t indexBytes = m_lightIndices.size() * sizeof(GLuint);
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_clusterBuffer);
+	glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, TOTAL_CLUSTERS * sizeof(glm::uvec2), m_clusters.data());
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_indexBuffer);
+	if ((indexBytes > m_indexBufferCapacity) || (m_indexBufferCapacity == 0))
+	{
+		m_indexBufferCapacity = std::max(indexBytes * 2, sizeof(GLuint));
+		glBufferData(GL_SHADER_STORAGE_BUFFER, m_indexBufferCapacity, NULL, GL_DYNAMIC_DRAW);
+	}
+	if (indexBytes > 0)
+	{
+		glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, indexBytes, m_lightIndices.data());
+	}
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+/***********************************************************
+ *  BindClusters()
+ *
+ *  This method is used for binding the shader storage buffers
+ *  and passing the cluster grid values into the shader.
+ ***********************************************************/
+void ClusterManager::BindClusters(ShaderManager* pShaderManager)
+{
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, CLUSTER_BUFFER_BINDING, m_clusterBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, INDEX_BUFFER_BINDING, m_indexBuffer);
+
+	if ((NULL != pShaderManager) && (m_nearPlane > 0.0f))
+	{
+		float logDepthRange = std::log(m_farPlane / m_nearPlane);
+
+		pShaderManager->setVec2Value(g_TileSizeName, glm::vec2(
+			(float)m_screenWidth / (float)GRID_X,
+			(float)m_screenHeight / (float)GRID_Y));
+		pShaderManager->setFloatValue(g_SliceScaleName, (float)GRID_Z / logDepthRange);
+		pShaderManager->setFloatValue(g_SliceBiasName, -(float)GRID_Z * std::log(m_nearPlane) / logDepthRange);
+	}
+}
@@ -0,0 +1,104 @@
+///////////////////////////////////////////////////////////////////////////////
+// clustermanager.h
+// ============
+// manage the clustered forward lighting - froxel light binning
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+#include "LightManager.h"
+
+#include <vector>
+
+/***********************************************************
+ *  ClusterManager
+ *
+ *  This class contains the code for binning point and spot
+ *  lights with finite radii into a 3D grid of view frustum
+ *  clusters (froxels), so that each fragment only has to
+ *  evaluate the lights that can actually reach it.
+ ***********************************************************/
+class ClusterManager
+{
+public:
+	// constructor
+	ClusterManager();
+	// destructor
+	~ClusterManager();
+
+	// number of clusters along each axis of the froxel grid
+	static const int GRID_X = 16;
+	static const int GRID_Y = 12;
+	static const int GRID_Z = 24;
+
+	// shader storage buffer binding points used by the shaders, the
+	// lights themselves are bound by the light manager
+	static const int CLUSTER_BUFFER_BINDING = 1;
+	static const int INDEX_BUFFER_BINDING = 2;
+
+private:
+	// per cluster offset and count into the light index list
+	std::vector<glm::uvec2> m_clusters;
+	// flattened list of light indices for all clusters
+	std::vector<GLuint> m_lightIndices;
+	// scratch list of (cluster, light) pairs found during binning
+	std::vector<glm::uvec2> m_clusterLightPairs;
+	// view space bounding boxes of every cluster
+	std::vector<glm::vec3> m_clusterMin;
+	std::vector<glm::vec3> m_clusterMax;
+	// frustum the cluster bounding boxes were built for
+	glm::mat4 m_clusterProjection;
+	// depth slicing parameters for the current frustum
+	float m_nearPlane;
+	float m_farPlane;
+	int m_screenWidth;
+	int m_screenHeight;
+	// OpenGL shader storage buffers
+	GLuint m_clusterBuffer;
+	GLuint m_indexBuffer;
+	// allocated size of the growable index buffer
+	size_t m_indexBufferCapacity;
+	// statistics from the last binning pass
+	size_t m_lastIndexCount;
+
+	// build the view space bounding boxes of the clusters
+	void BuildClusterBounds(
+		const glm::mat4& projection,
+		float nearPlane,
+		float farPlane);
+	// get the view space depth at the start of a depth slice
+	float GetSliceDepth(int slice) const;
+	// find the clusters overlapped by a single light
+	void BinLight(
+		const LightManager::GPU_LIGHT& light,
+		GLuint lightIndex,
+		const glm::mat4& view,
+		const glm::mat4& projection);
+	// upload the cluster and index lists into the buffers
+	void UploadBuffers();
+
+public:
+	// create the OpenGL shader storage buffers
+	void CreateBuffers();
+	// free the OpenGL shader storage buffers
+	void DestroyBuffers();
+
+	// get the number of light indices written by the last binning pass
+	size_t GetLastIndexCount() const;
+
+	// bin all lights into the clusters of the current view frustum
+	void BuildClusters(
+		const LightManager* pLightManager,
+		const glm::mat4& view,
+		const glm::mat4& projection,
+		float nearPlane,
+		float farPlane,
+		int screenWidth,
+		int screenHeight);
+	// bind the buffers and set the cluster grid values into the shader
+	void BindClusters(ShaderManager* pShaderManager);
+};
@@ -0,0 +1,216 @@
+///////////////////////////////////////////////////////////////////////////////
+// computeshadermanager.cpp
+// ============
+// manage the loading and use of a compute shader program
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ComputeShaderManager.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+/***********************************************************
+ *  ComputeShaderManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ComputeShaderManager::ComputeShaderManager()
+{
+	m_programID = 0;
+}
+
+/***********************************************************
+ *  ~ComputeShaderManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ComputeShaderManager::~ComputeShaderManager()
+{
+	if (m_programID != 0)
+	{
+		glDeleteProgram(m_programID);
+		m_programID = 0;
+	}
+}
+
+/***********************************************************
+ *  CheckErrors()
+ *
+ *  This method is used for checking the compile status of a
+ *  shader or the link status of a program, and outputting
+ *  the info log when it failed.
+ ***********************************************************/
+bool ComputeShaderManager::CheckErrors(GLuint objectID, bool bProgram, const char* filePath)
+{
+	GLint bSuccess = 0;
+	GLchar infoLog[1024];
+
+	if (bProgram == true)
+	{
+		glGetProgramiv(objectID, GL_LINK_STATUS, &bSuccess);
+		if (bSuccess == 0)
+		{
+			glGetProgramInfoLog(objectID, sizeof(infoLog), NULL, infoLog);
+			std::cout << "ERROR::COMPUTE_PROGRAM_LINKING_ERROR: " << filePath << "\n" << infoLog << std::endl;
+		}
+	}
+	else
+	{
+		glGetShaderiv(objectID, GL_COMPILE_STATUS, &bSuccess);
+		if (bSuccess == 0)
+		{
+			glGetShaderInfoLog(objectID, sizeof(infoLog), NULL, infoLog);
+			std::cout << "ERROR::COMPUTE_SHADER_COMPILATION_ERROR: " << filePath << "\n" << infoLog << std::endl;
+		}
+	}
+
+	return(bSuccess != 0);
+}
+
+/***********************************************************
+ *  LoadShader()
+ *
+ *  This method is used for reading the compute shader code
+ *  from the passed in GLSL file, then compiling and linking
+ *  it into a program.
+ ***********************************************************/
+bool ComputeShaderManager::LoadShader(const char* filePath)
+{
+	std::ifstream shaderFile(filePath);
+	if (!shaderFile.is_open())
+	{
+		std::cout << "ERROR::COMPUTE_SHADER_FILE_NOT_READ: " << filePath << std::endl;
+		return(false);
+	}
+
+	std::stringstream shaderStream;
+	shaderStream << shaderFile.rdbuf();
+	std::string shaderCode = shaderStream.str();
+	const char* pShaderCode = shaderCode.c_str();
+
+	GLuint shaderID = glCreateShader(GL_COMPUTE_SHADER);
+	glShaderSource(shaderID, 1, &pShaderCode, NULL);
+	glCompileShader(shaderID);
+	bool bSuccess = CheckErrors(shaderID, false, filePath);
+
+	if (bSuccess == true)
+	{
+		if (m_programID != 0)
+		{
+			glDeleteProgram(m_programID);
+		}
+		m_programID = glCreateProgram();
+		glAttachShader(m_programID, shaderID);
+		glLinkProgram(m_programID);
+		bSuccess = CheckErrors(m_programID, true, filePath);
+	}
+	glDeleteShader(shaderID);
+
+	return(bSuccess);
+}
+
+/***********************************************************
+ *  use()
+ *
+ *  This method is used for making the compute program the
+ *  current program.
+ ***********************************************************/
+void ComputeShaderManager::use()
+{
+	glUseProgram(m_programID);
+}
+
+/***********************************************************
+ *  Dispatch()
+ *
+ *  This method is used for running the compute program over
+ *  the passed in number of work groups.  The caller issues
+ *  the memory barrier that matches how the results are read.
+ ***********************************************************/
+void ComputeShaderManager::Dispatch(GLuint groupsX, GLuint groupsY, GLuint groupsZ)
+{
+	glDispatchCompute(groupsX, groupsY, groupsZ);
+}
+
+/***********************************************************
+ *  setBoolValue()
+ *
+ *  This method is used for passing a bool value into the
+ *  compute program.
+ ***********************************************************/
+void ComputeShaderManager::setBoolValue(const std::string& name, bool value) const
+{
+	glUniform1i(glGetUniformLocation(m_programID, name.c_str()), (int)value);
+}
+
+/***********************************************************
+ *  setIntValue()
+ *
+ *  This method is used for passing an int value into the
+ *  compute program.
+ ***********************************************************/
+void ComputeShaderManager::setIntValue(const std::string& name, int value) const
+{
+	glUniform1i(glGetUniformLocation(m_programID, name.c_str()), value);
+}
+
+/***********************************************************
+ *  setFloatValue()
+ *
+ *  This method is used for passing a float value into the
+ *  compute program.
+ ***********************************************************/
+void ComputeShaderManager::setFloatValue(const std::string& name, float value) const
+{
+	glUniform1f(glGetUniformLocation(m_programID, name.c_str()), value);
+}
+
+/***********************************************************
+ *  setSampler2DValue()
+ *
+ *  This method is used for passing a texture unit into a
+ *  sampler of the compute program.
+ ***********************************************************/
+void ComputeShaderManager::setSampler2DValue(const std::string& name, int value) const
+{
+	glUniform1i(glGetUniformLocation(m_programID, name.c_str()), value);
+}
+
+/***********************************************************
+ *  setVec2Value()
+ *
+ *  This method is used for passing a vec2 value into the
+ *  compute program.
+ ***********************************************************/
+void ComputeShaderManager::setVec2Value(const std::string& name, const glm::vec2& value) const
+{
+	glUniform2fv(glGetUniformLocation(m_programID, name.c_str()), 1, glm::value_ptr(value));
+}
+
+/***********************************************************
+ *  setVec3Value()
+ *
+ *  This method is used for passing a vec3 value into the
+ *  compute program.
+ ***********************************************************/
+void ComputeShaderManager::setVec3Value(const std::string& name, const glm::vec3& value) const
+{
+	glUniform3fv(glGetUniformLocation(m_programID, name.c_str()), 1, glm::value_ptr(value));
+}
+
+/***********************************************************
+ *  setMat4Value()
+ *
+ *  This method is used for passing a mat4 value into the
+ *  compute program.
+ ***********************************************************/
+void ComputeShaderManager::setMat4Value(const std::string& name, const glm::mat4& value) const
+{
+	glUniformMatrix4fv(glGetUniformLocation(m_programID, name.c_str()), 1, GL_FALSE, glm::value_ptr(value));
+}
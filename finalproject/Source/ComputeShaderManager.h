@@ -0,0 +1,56 @@
+///////////////////////////////////////////////////////////////////////////////
+// computeshadermanager.h
+// ============
+// manage the loading and use of a compute shader program
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <string>
+
+/***********************************************************
+ *  ComputeShaderManager
+ *
+ *  This class contains the code for loading a compute shader
+ *  from an external GLSL file, passing values into it, and
+ *  dispatching its work groups.  The value setters match the
+ *  ones in ShaderManager.
+ ***********************************************************/
+class ComputeShaderManager
+{
+public:
+	// constructor
+	ComputeShaderManager();
+	// destructor
+	~ComputeShaderManager();
+
+private:
+	// OpenGL compute program
+	GLuint m_programID;
+
+	// output the compile or link log when a step failed
+	bool CheckErrors(GLuint objectID, bool bProgram, const char* filePath);
+
+public:
+	// load, compile and link the compute shader file
+	bool LoadShader(const char* filePath);
+	// make the compute program current
+	void use();
+	// run the compute program over the passed in work group count
+	void Dispatch(GLuint groupsX, GLuint groupsY, GLuint groupsZ);
+
+	// pass values into the compute program
+	void setBoolValue(const std::string& name, bool value) const;
+	void setIntValue(const std::string& name, int value) const;
+	void setFloatValue(const std::string& name, float value) const;
+	void setSampler2DValue(const std::string& name, int value) const;
+	void setVec2Value(const std::string& name, const glm::vec2& value) const;
+	void setVec3Value(const std::string& name, const glm::vec3& value) const;
+	void setMat4Value(const std::string& name, const glm::mat4& value) const;
+};
@@ -0,0 +1,433 @@
+///////////////////////////////////////////////////////////////////////////////
+// deferredmanager.cpp
+// ============
+// manage the deferred shading path - G-buffer, lighting pass, light volumes
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "DeferredManager.h"
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+// declare the global variables
+namespace
+{
+	const char* g_AlbedoName = "gAlbedo";
+	const char* g_MaterialName = "gMaterial";
+	const char* g_NormalName = "gNormal";
+	const char* g_DepthName = "gDepth";
+	const std::string g_InverseViewProjectionName = "inverseViewProjection";
+}
+
+/***********************************************************
+ *  DeferredManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+DeferredManager::DeferredManager()
+{
+	m_gBuffer = 0;
+	m_albedoTexture = 0;
+	m_materialTexture = 0;
+	m_normalTexture = 0;
+	m_depthTexture = 0;
+	m_width = 0;
+	m_height = 0;
+	m_pGeometryShader = NULL;
+	m_pDirectionalShader = NULL;
+	m_pLightVolumeShader = NULL;
+	m_volumeVAO = 0;
+	m_volumeVBO = 0;
+	m_volumeIBO = 0;
+	m_volumeIndexCount = 0;
+	m_fullscreenVAO = 0;
+}
+
+/***********************************************************
+ *  ~DeferredManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+DeferredManager::~DeferredManager()
+{
+	DestroyGBuffer();
+
+	if (NULL != m_pGeometryShader)
+	{
+		delete m_pGeometryShader;
+		m_pGeometryShader = NULL;
+	}
+	if (NULL != m_pDirectionalShader)
+	{
+		delete m_pDirectionalShader;
+		m_pDirectionalShader = NULL;
+	}
+	if (NULL != m_pLightVolumeShader)
+	{
+		delete m_pLightVolumeShader;
+		m_pLightVolumeShader = NULL;
+	}
+}
+
+/***********************************************************
+ *  CreateGBuffer()
+ *
+ *  This method is used for creating the G-buffer textures
+ *  and framebuffer, and the meshes used by the lighting pass.
+ ***********************************************************/
+bool DeferredManager::CreateGBuffer(int width, int height)
+{
+	m_width = width;
+	m_height = height;
+
+	// color targets of the G-buffer
+	GLuint* colorTextures[3] = { &m_albedoTexture, &m_materialTexture, &m_normalTexture };
+	GLenum colorFormats[3] = { GL_RGBA8, GL_RGBA8, GL_RG16 };
+
+	glGenFramebuffers(1, &m_gBuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_gBuffer);
+
+	for (int i = 0; i < 3; i++)
+	{
+		glGenTextures(1, colorTextures[i]);
+		glBindTexture(GL_TEXTURE_2D, *colorTextures[i]);
+		glTexStorage2D(GL_TEXTURE_2D, 1, colorFormats[i], width, height);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, *colorTextures[i], 0);
+	}
+
+	// the depth buffer is sampled to rebuild the surface position
+	glGenTextures(1, &m_depthTexture);
+	glBindTexture(GL_TEXTURE_2D, m_depthTexture);
+	glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH_COMPONENT24, width, height);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_depthTexture, 0);
+
+	GLenum drawBuffers[3] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2 };
+	glDrawBuffers(3, drawBuffers);
+
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cout << "G-buffer framebuffer is not complete, status:" << status << std::endl;
+		return false;
+	}
+
+	CreateLightVolumeMesh();
+
+	// core profile needs a vertex array bound even when no
+	// vertex attributes are read
+	glGenVertexArrays(1, &m_fullscreenVAO);
+
+	return true;
+}
+
+/***********************************************************
+ *  DestroyGBuffer()
+ *
+ *  This method is used for freeing the G-buffer and the
+ *  lighting pass meshes.
+ ***********************************************************/
+void DeferredManager::DestroyGBuffer()
+{
+	GLuint textures[4] = { m_albedoTexture, m_materialTexture, m_normalTexture, m_depthTexture };
+
+	if (m_gBuffer != 0)
+	{
+		glDeleteTextures(4, textures);
+		glDeleteFramebuffers(1, &m_gBuffer);
+		m_gBuffer = 0;
+		m_albedoTexture = 0;
+		m_materialTexture = 0;
+		m_normalTexture = 0;
+		m_depthTexture = 0;
+	}
+	if (m_volumeVAO != 0)
+	{
+		glDeleteVertexArrays(1, &m_volumeVAO);
+		glDeleteBuffers(1, &m_volumeVBO);
+		glDeleteBuffers(1, &m_volumeIBO);
+		m_volumeVAO = 0;
+		m_volumeVBO = 0;
+		m_volumeIBO = 0;
+	}
+	if (m_fullscreenVAO != 0)
+	{
+		glDeleteVertexArrays(1, &m_fullscreenVAO);
+		m_fullscreenVAO = 0;
+	}
+}
+
+/***********************************************************
+ *  CreateLightVolumeMesh()
+ *
+ *  This method is used for creating the sphere that is drawn
+ *  for each point and spot light.  An icosahedron is split
+ *  once into 80 triangles and then pushed out so that its
+ *  faces enclose the unit sphere, so the volume never clips
+ *  the edge of a light.
+ ***********************************************************/
+void DeferredManager::CreateLightVolumeMesh()
+{
+	const float t = (1.0f + std::sqrt(5.0f)) / 2.0f;
+	std::vector<glm::vec3> vertices = {
+		glm::vec3(-1.0f, t, 0.0f), glm::vec3(1.0f, t, 0.0f), glm::vec3(-1.0f, -t, 0.0f), glm::vec3(1.0f, -t, 0.0f),
+		glm::vec3(0.0f, -1.0f, t), glm::vec3(0.0f, 1.0f, t), glm::vec3(0.0f, -1.0f, -t), glm::vec3(0.0f, 1.0f, -t),
+		glm::vec3(t, 0.0f, -1.0f), glm::vec3(t, 0.0f, 1.0f), glm::vec3(-t, 0.0f, -1.0f), glm::vec3(-t, 0.0f, 1.0f) };
+	std::vector<GLushort> indices = {
+		0, 11, 5, 0, 5, 1, 0, 1, 7, 0, 7, 10, 0, 10, 11,
+		1, 5, 9, 5, 11, 4, 11, 10, 2, 10, 7, 6, 7, 1, 8,
+		3, 9, 4, 3, 4, 2, 3, 2, 6, 3, 6, 8, 3, 8, 9,
+		4, 9, 5, 2, 4, 11, 6, 2, 10, 8, 6, 7, 9, 8, 1 };
+
+	for (size_t i = 0; i < vertices.size(); i++)
+	{
+		vertices[i] = glm::normalize(vertices[i]);
+	}
+
+	// split every triangle into four, sharing the new edge midpoints
+	std::vector<GLushort> subdivided;
+	std::vector<std::pair<GLushort, GLushort> > edgeKeys;
+	std::vector<GLushort> edgeMidpoints;
+	for (size_t i = 0; i < indices.size(); i += 3)
+	{
+		GLushort midpoints[3];
+		for (int edge = 0; edge < 3; edge++)
+		{
+			GLushort a = indices[i + edge];
+			GLushort b = indices[i + ((edge + 1) % 3)];
+			std::pair<GLushort, GLushort> key(std::min(a, b), std::max(a, b));
+			std::vector<std::pair<GLushort, GLushort> >::iterator found =
+				std::find(edgeKeys.begin(), edgeKeys.end(), key);
+			if (found != edgeKeys.end())
+			{
+				midpoints[edge] = edgeMidpoints[found - edgeKeys.begin()];
+			}
+			else
+			{
+				vertices.push_back(glm::normalize(vertices[a] + vertices[b]));
+				midpoints[edge] = (GLushort)(vertices.size() - 1);
+				edgeKeys.push_back(key);
+				edgeMidpoints.push_back(midpoints[edge]);
+			}
+		}
+
+		GLushort newTriangles[12] = {
+			indices[i], midpoints[0], midpoints[2],
+			indices[i + 1], midpoints[1], midpoints[0],
+			indices[i + 2], midpoints[2], midpoints[1],
+			midpoints[0], midpoints[1], midpoints[2] };
+		subdivided.insert(subdivided.end(), newTriangles, newTriangles + 12);
+	}
+	indices = subdivided;
+
+	// make every triangle face outwards and find the closest face plane
+	float closestFace = 1.0f;
+	for (size_t i = 0; i < indices.size(); i += 3)
+	{
+		glm::vec3 a = vertices[indices[i]];
+		glm::vec3 b = vertices[indices[i + 1]];
+		glm::vec3 c = vertices[indices[i + 2]];
+		glm::vec3 normal = glm::normalize(glm::cross(b - a, c - a));
+		float distance = glm::dot(normal, a);
+		if (distance < 0.0f)
+		{
+			std::swap(indices[i + 1], indices[i + 2]);
+			distance = -distance;
+		}
+		closestFace = std::min(closestFace, distance);
+	}
+	for (size_t i = 0; i < vertices.size(); i++)
+	{
+		vertices[i] = vertices[i] / closestFace;
+	}
+
+	glGenVertexArrays(1, &m_volumeVAO);
+	glBindVertexArray(m_volumeVAO);
+
+	glGenBuffers(1, &m_volumeVBO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_volumeVBO);
+	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec3), vertices.data(), GL_STATIC_DRAW);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+	glEnableVertexAttribArray(0);
+
+	glGenBuffers(1, &m_volumeIBO);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_volumeIBO);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLushort), indices.data(), GL_STATIC_DRAW);
+	m_volumeIndexCount = (GLsizei)indices.size();
+
+	glBindVertexArray(0);
+}
+
+/***********************************************************
+ *  LoadShaders()
+ *
+ *  This method is used for loading the shader that writes
+ *  the G-buffer and the shaders that light it.
+ ***********************************************************/
+void DeferredManager::LoadShaders()
+{
+	m_pGeometryShader = new ShaderManager();
+	m_pGeometryShader->LoadShaders(
+		"shaders/vertexShader.glsl",
+		"shaders/gBufferFragmentShader.glsl");
+
+	m_pDirectionalShader = new ShaderManager();
+	m_pDirectionalShader->LoadShaders(
+		"shaders/fullscreenVertexShader.glsl",
+		"shaders/deferredDirectionalFragmentShader.glsl");
+	m_pDirectionalShader->use();
+	SetGBufferSamplers(m_pDirectionalShader);
+
+	m_pLightVolumeShader = new ShaderManager();
+	m_pLightVolumeShader->LoadShaders(
+		"shaders/lightVolumeVertexShader.glsl",
+		"shaders/deferredLightFragmentShader.glsl");
+	m_pLightVolumeShader->use();
+	SetGBufferSamplers(m_pLightVolumeShader);
+}
+
+/***********************************************************
+ *  SetGBufferSamplers()
+ *
+ *  This method is used for pointing the G-buffer samplers of
+ *  a lighting shader at the G-buffer texture units.
+ ***********************************************************/
+void DeferredManager::SetGBufferSamplers(ShaderManager* pShaderManager)
+{
+	pShaderManager->setSampler2DValue(g_AlbedoName, ALBEDO_TEXTURE_UNIT);
+	pShaderManager->setSampler2DValue(g_MaterialName, MATERIAL_TEXTURE_UNIT);
+	pShaderManager->setSampler2DValue(g_NormalName, NORMAL_TEXTURE_UNIT);
+	pShaderManager->setSampler2DValue(g_DepthName, DEPTH_TEXTURE_UNIT);
+}
+
+/***********************************************************
+ *  GetGeometryShader()
+ *
+ *  This method is used for getting the shader that the scene
+ *  is drawn with during the geometry pass.
+ ***********************************************************/
+ShaderManager* DeferredManager::GetGeometryShader()
+{
+	return(m_pGeometryShader);
+}
+
+/***********************************************************
+ *  BeginGeometryPass()
+ *
+ *  This method is used for binding and clearing the G-buffer
+ *  so that the scene can be drawn into it.  Blending is off
+ *  because the G-buffer holds surface data, not colors.
+ ***********************************************************/
+void DeferredManager::BeginGeometryPass()
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, m_gBuffer);
+	glViewport(0, 0, m_width, m_height);
+	glEnable(GL_DEPTH_TEST);
+	glDisable(GL_BLEND);
+	glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+	m_pGeometryShader->use();
+}
+
+/***********************************************************
+ *  EndGeometryPass()
+ *
+ *  This method is used for going back to drawing into the
+ *  window framebuffer.
+ ***********************************************************/
+void DeferredManager::EndGeometryPass()
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glEnable(GL_BLEND);
+}
+
+/***********************************************************
+ *  BindGBufferTextures()
+ *
+ *  This method is used for binding the G-buffer textures to
+ *  their texture units.
+ ***********************************************************/
+void DeferredManager::BindGBufferTextures()
+{
+	glActiveTexture(GL_TEXTURE0 + ALBEDO_TEXTURE_UNIT);
+	glBindTexture(GL_TEXTURE_2D, m_albedoTexture);
+	glActiveTexture(GL_TEXTURE0 + MATERIAL_TEXTURE_UNIT);
+	glBindTexture(GL_TEXTURE_2D, m_materialTexture);
+	glActiveTexture(GL_TEXTURE0 + NORMAL_TEXTURE_UNIT);
+	glBindTexture(GL_TEXTURE_2D, m_normalTexture);
+	glActiveTexture(GL_TEXTURE0 + DEPTH_TEXTURE_UNIT);
+	glBindTexture(GL_TEXTURE_2D, m_depthTexture);
+	glActiveTexture(GL_TEXTURE0);
+}
+
+/***********************************************************
+ *  RenderLighting()
+ *
+ *  This method is used for shading the window from the
+ *  G-buffer.  A full screen triangle applies the ambient and
+ *  directional light, then the light volumes are added with
+ *  additive blending.  Only the back faces of the volumes
+ *  are drawn and depth testing is off, so each covered pixel
+ *  is shaded exactly once per light even when the camera is
+ *  inside a volume.
+ ***********************************************************/
+void DeferredManager::RenderLighting(
+	LightManager* pLightManager,
+	const glm::mat4& view,
+	const glm::mat4& projection)
+{
+	glm::mat4 inverseViewProjection = glm::inverse(projection * view);
+	glm::vec3 viewPosition = glm::vec3(glm::inverse(view)[3]);
+
+	BindGBufferTextures();
+	glDisable(GL_DEPTH_TEST);
+	glDepthMask(GL_FALSE);
+
+	// ambient and directional light for every covered pixel
+	glDisable(GL_BLEND);
+	m_pDirectionalShader->use();
+	m_pDirectionalShader->setMat4Value(g_InverseViewProjectionName, inverseViewProjection);
+	m_pDirectionalShader->setVec3Value("viewPosition", viewPosition);
+	pLightManager->SetDirectionalLightUniforms(m_pDirectionalShader);
+	glBindVertexArray(m_fullscreenVAO);
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+
+	// one instanced sphere volume per point and spot light
+	if (pLightManager->GetLightCount() > 0)
+	{
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_ONE, GL_ONE);
+		glEnable(GL_CULL_FACE);
+		glCullFace(GL_FRONT);
+
+		m_pLightVolumeShader->use();
+		m_pLightVolumeShader->setMat4Value("view", view);
+		m_pLightVolumeShader->setMat4Value("projection", projection);
+		m_pLightVolumeShader->setMat4Value(g_InverseViewProjectionName, inverseViewProjection);
+		m_pLightVolumeShader->setVec3Value("viewPosition", viewPosition);
+		pLightManager->BindLights(m_pLightVolumeShader);
+		glBindVertexArray(m_volumeVAO);
+		glDrawElementsInstanced(GL_TRIANGLES, m_volumeIndexCount, GL_UNSIGNED_SHORT, NULL, pLightManager->GetLightCount());
+
+		glCullFace(GL_BACK);
+		glDisable(GL_CULL_FACE);
+	}
+
+	// restore the state the forward scene rendering expects
+	glBindVertexArray(0);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glDepthMask(GL_TRUE);
+	glEnable(GL_DEPTH_TEST);
+}
@@ -0,0 +1,97 @@
+///////////////////////////////////////////////////////////////////////////////
+// deferredmanager.h
+// ============
+// manage the deferred shading path - G-buffer, lighting pass, light volumes
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+#include "LightManager.h"
+
+/***********************************************************
+ *  DeferredManager
+ *
+ *  This class contains the code for rendering the scene with
+ *  deferred shading.  The geometry pass writes the surface
+ *  properties into a compact G-buffer:
+ *
+ *    albedo   RGBA8  base color, specular intensity
+ *    material RGBA8  material diffuse color, shininess
+ *    normal   RG16   octahedral encoded normal
+ *    depth    D24    position is rebuilt from the depth
+ *
+ *  and the lighting pass shades each pixel once for the
+ *  directional light, then draws a sphere volume for every
+ *  point and spot light so that a light only costs the
+ *  pixels it covers on the screen.
+ ***********************************************************/
+class DeferredManager
+{
+public:
+	// constructor
+	DeferredManager();
+	// destructor
+	~DeferredManager();
+
+	// texture units used for reading the G-buffer, these are above
+	// the 16 units the scene textures are bound to
+	static const int ALBEDO_TEXTURE_UNIT = 16;
+	static const int MATERIAL_TEXTURE_UNIT = 17;
+	static const int NORMAL_TEXTURE_UNIT = 18;
+	static const int DEPTH_TEXTURE_UNIT = 19;
+
+private:
+	// G-buffer framebuffer and its attachments
+	GLuint m_gBuffer;
+	GLuint m_albedoTexture;
+	GLuint m_materialTexture;
+	GLuint m_normalTexture;
+	GLuint m_depthTexture;
+	int m_width;
+	int m_height;
+	// shader used for writing the G-buffer
+	ShaderManager* m_pGeometryShader;
+	// shader used for the ambient and directional lighting
+	ShaderManager* m_pDirectionalShader;
+	// shader used for the point and spot light volumes
+	ShaderManager* m_pLightVolumeShader;
+	// light volume sphere mesh
+	GLuint m_volumeVAO;
+	GLuint m_volumeVBO;
+	GLuint m_volumeIBO;
+	GLsizei m_volumeIndexCount;
+	// empty vertex array used for the full screen triangle
+	GLuint m_fullscreenVAO;
+
+	// create the sphere mesh used for the light volumes
+	void CreateLightVolumeMesh();
+	// bind the G-buffer textures for the lighting shaders
+	void BindGBufferTextures();
+	// set the G-buffer sampler units into a lighting shader
+	void SetGBufferSamplers(ShaderManager* pShaderManager);
+
+public:
+	// create the G-buffer and the light volume mesh
+	bool CreateGBuffer(int width, int height);
+	// free the G-buffer and the light volume mesh
+	void DestroyGBuffer();
+	// load the geometry and lighting shaders
+	void LoadShaders();
+
+	// get the shader that the scene is drawn with in the geometry pass
+	ShaderManager* GetGeometryShader();
+
+	// bind and clear the G-buffer before the scene is drawn
+	void BeginGeometryPass();
+	// go back to the window framebuffer after the scene is drawn
+	void EndGeometryPass();
+	// shade the window from the G-buffer
+	void RenderLighting(
+		LightManager* pLightManager,
+		const glm::mat4& view,
+		const glm::mat4& projection);
+};
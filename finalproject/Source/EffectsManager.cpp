@@ -0,0 +1,438 @@
+///////////////////////////////////////////////////////////////////////////////
+// effectsmanager.cpp
+// ============
+// manage the screen-space effects - reduced resolution passes and upsampling
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "EffectsManager.h"
+
+// declare the global variables
+namespace
+{
+	const char* g_DepthTextureName = "depthTexture";
+	const std::string g_LinearDepthTextureName = "linearDepthTexture";
+	const char* g_EffectTextureName = "effectTexture";
+	const char* g_ProjectionName = "projection";
+	const std::string g_ResolutionFactorName = "resolutionFactor";
+}
+
+/***********************************************************
+ *  EffectsManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+EffectsManager::EffectsManager()
+{
+	m_sceneColorResource = -1;
+	m_sceneDepthResource = -1;
+	m_linearDepthResource = -1;
+	m_occlusionResource = -1;
+	m_blurResources[0] = -1;
+	m_blurResources[1] = -1;
+	m_upsampledResource = -1;
+	m_resultResource = -1;
+	m_projection = glm::mat4(1.0f);
+	m_width = 0;
+	m_height = 0;
+	m_resolution = RESOLUTION_HALF;
+	m_pDownsampleShader = NULL;
+	m_pOcclusionShader = NULL;
+	m_pBlurShader = NULL;
+	m_pUpsampleShader = NULL;
+	m_pCompositeShader = NULL;
+	m_fullscreenVAO = 0;
+	for (int i = 0; i < PASS_COUNT; i++)
+	{
+		m_pPassTimers[i] = NULL;
+	}
+}
+
+/***********************************************************
+ *  ~EffectsManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+EffectsManager::~EffectsManager()
+{
+	SetPassTiming(false);
+	if (m_fullscreenVAO != 0)
+	{
+		glDeleteVertexArrays(1, &m_fullscreenVAO);
+		m_fullscreenVAO = 0;
+	}
+
+	ShaderManager** shaders[5] = {
+		&m_pDownsampleShader, &m_pOcclusionShader, &m_pBlurShader,
+		&m_pUpsampleShader, &m_pCompositeShader };
+	for (int i = 0; i < 5; i++)
+	{
+		if (NULL != *shaders[i])
+		{
+			delete *shaders[i];
+			*shaders[i] = NULL;
+		}
+	}
+}
+
+/***********************************************************
+ *  SetWindowSize()
+ *
+ *  This method is used for setting the window size that the
+ *  effects are upsampled to, and that the reduced sizes are
+ *  divided from.
+ ***********************************************************/
+void EffectsManager::SetWindowSize(int width, int height)
+{
+	m_width = width;
+	m_height = height;
+}
+
+/***********************************************************
+ *  LoadShaders()
+ *
+ *  This method is used for loading the shaders of the effect
+ *  passes, which all draw a full screen triangle.
+ ***********************************************************/
+void EffectsManager::LoadShaders()
+{
+	// core profile needs a vertex array bound even when no
+	// vertex attributes are read
+	glGenVertexArrays(1, &m_fullscreenVAO);
+
+	m_pDownsampleShader = new ShaderManager();
+	m_pDownsampleShader->LoadShaders(
+		"shaders/fullscreenVertexShader.glsl",
+		"shaders/depthDownsampleFragmentShader.glsl");
+	m_pDownsampleShader->use();
+	m_pDownsampleShader->setSampler2DValue(g_DepthTextureName, DEPTH_TEXTURE_UNIT);
+
+	m_pOcclusionShader = new ShaderManager();
+	m_pOcclusionShader->LoadShaders(
+		"shaders/fullscreenVertexShader.glsl",
+		"shaders/ssaoFragmentShader.glsl");
+	m_pOcclusionShader->use();
+	m_pOcclusionShader->setSampler2DValue(g_LinearDepthTextureName, LINEAR_DEPTH_TEXTURE_UNIT);
+
+	m_pBlurShader = new ShaderManager();
+	m_pBlurShader->LoadShaders(
+		"shaders/fullscreenVertexShader.glsl",
+		"shaders/bilateralBlurFragmentShader.glsl");
+	m_pBlurShader->use();
+	m_pBlurShader->setSampler2DValue(g_LinearDepthTextureName, LINEAR_DEPTH_TEXTURE_UNIT);
+	m_pBlurShader->setSampler2DValue(g_EffectTextureName, EFFECT_TEXTURE_UNIT);
+
+	m_pUpsampleShader = new ShaderManager();
+	m_pUpsampleShader->LoadShaders(
+		"shaders/fullscreenVertexShader.glsl",
+		"shaders/bilateralUpsampleFragmentShader.glsl");
+	m_pUpsampleShader->use();
+	m_pUpsampleShader->setSampler2DValue(g_DepthTextureName, DEPTH_TEXTURE_UNIT);
+	m_pUpsampleShader->setSampler2DValue(g_LinearDepthTextureName, LINEAR_DEPTH_TEXTURE_UNIT);
+	m_pUpsampleShader->setSampler2DValue(g_EffectTextureName, EFFECT_TEXTURE_UNIT);
+
+	m_pCompositeShader = new ShaderManager();
+	m_pCompositeShader->LoadShaders(
+		"shaders/fullscreenVertexShader.glsl",
+		"shaders/effectCompositeFragmentShader.glsl");
+	m_pCompositeShader->use();
+	m_pCompositeShader->setSampler2DValue(g_EffectTextureName, EFFECT_TEXTURE_UNIT);
+}
+
+/***********************************************************
+ *  SetResolution()
+ *
+ *  This method is used for selecting the resolution the
+ *  effects run at, from the next frame added to the graph.
+ ***********************************************************/
+void EffectsManager::SetResolution(EFFECT_RESOLUTION resolution)
+{
+	if (resolution == m_resolution)
+	{
+		return;
+	}
+
+	m_resolution = resolution;
+
+	// no time of the previous resolution is carried over
+	if (NULL != m_pPassTimers[0])
+	{
+		SetPassTiming(false);
+		SetPassTiming(true);
+	}
+}
+
+/***********************************************************
+ *  GetResolution()
+ *
+ *  This method is used for getting the resolution the
+ *  effects run at.
+ ***********************************************************/
+EffectsManager::EFFECT_RESOLUTION EffectsManager::GetResolution() const
+{
+	return(m_resolution);
+}
+
+/***********************************************************
+ *  SetPassTiming()
+ *
+ *  This method is used for creating or freeing the GPU
+ *  timers of the passes.
+ ***********************************************************/
+void EffectsManager::SetPassTiming(bool bEnabled)
+{
+	for (int i = 0; i < PASS_COUNT; i++)
+	{
+		if ((bEnabled == true) && (NULL == m_pPassTimers[i]))
+		{
+			m_pPassTimers[i] = new GpuTimer();
+			m_pPassTimers[i]->CreateQueries();
+		}
+		else if ((bEnabled == false) && (NULL != m_pPassTimers[i]))
+		{
+			delete m_pPassTimers[i];
+			m_pPassTimers[i] = NULL;
+		}
+	}
+}
+
+/***********************************************************
+ *  GetPassMilliseconds()
+ *
+ *  This method is used for getting the most recent GPU time
+ *  of a pass in milliseconds, or a negative time when the
+ *  pass has not been timed at the current resolution.
+ ***********************************************************/
+double EffectsManager::GetPassMilliseconds(EFFECT_PASS pass) const
+{
+	if ((NULL == m_pPassTimers[pass]) || (m_pPassTimers[pass]->HasResult() == false))
+	{
+		return(-1.0);
+	}
+	return(m_pPassTimers[pass]->GetLastMilliseconds());
+}
+
+/***********************************************************
+ *  GetResolutionName()
+ *
+ *  This method is used for getting the display name of an
+ *  effect resolution.
+ ***********************************************************/
+const char* EffectsManager::GetResolutionName(EFFECT_RESOLUTION resolution)
+{
+	if (resolution == RESOLUTION_FULL)
+	{
+		return("full resolution");
+	}
+	if (resolution == RESOLUTION_HALF)
+	{
+		return("half resolution");
+	}
+	return("quarter resolution");
+}
+
+/***********************************************************
+ *  GetPassName()
+ *
+ *  This method is used for getting the display name of an
+ *  effect pass.
+ ***********************************************************/
+const char* EffectsManager::GetPassName(EFFECT_PASS pass)
+{
+	const char* names[] = {
+		"depth downsample", "SSAO", "horizontal blur", "vertical blur",
+		"bilateral upsample", "composite" };
+	return(names[pass]);
+}
+
+/***********************************************************
+ *  DrawPass()
+ *
+ *  This method is used for drawing the full screen triangle
+ *  with the current shader, timed as the passed in pass.
+ ***********************************************************/
+void EffectsManager::DrawPass(EFFECT_PASS pass)
+{
+	if (NULL != m_pPassTimers[pass])
+	{
+		m_pPassTimers[pass]->Begin();
+	}
+	glBindVertexArray(m_fullscreenVAO);
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+	glBindVertexArray(0);
+	if (NULL != m_pPassTimers[pass])
+	{
+		m_pPassTimers[pass]->End();
+	}
+}
+
+/***********************************************************
+ *  AddAmbientOcclusionPasses()
+ *
+ *  This method is used for adding the passes that estimate
+ *  the ambient occlusion from the scene depth at the selected
+ *  resolution and darken the scene color by it.  The
+ *  projection is used for turning the depth back into view
+ *  positions.  The upsample pass is always added, but at
+ *  full resolution the composite reads the blurred result
+ *  and the graph culls the upsample.
+ ***********************************************************/
+void EffectsManager::AddAmbientOcclusionPasses(
+	RenderGraph& graph,
+	int sceneColorResource,
+	int sceneDepthResource,
+	const glm::mat4& projection)
+{
+	int width = (m_width + m_resolution - 1) / m_resolution;
+	int height = (m_height + m_resolution - 1) / m_resolution;
+
+	m_projection = projection;
+	m_sceneColorResource = sceneColorResource;
+	m_sceneDepthResource = sceneDepthResource;
+	m_linearDepthResource = graph.CreateTexture("linear depth", width, height, GL_R32F);
+	m_occlusionResource = graph.CreateTexture("occlusion", width, height, GL_R8);
+	m_blurResources[0] = graph.CreateTexture("horizontal blur", width, height, GL_R8);
+	m_blurResources[1] = graph.CreateTexture("vertical blur", width, height, GL_R8);
+	m_upsampledResource = graph.CreateTexture("upsampled occlusion", m_width, m_height, GL_R8);
+	m_resultResource = (m_resolution == RESOLUTION_FULL) ? m_blurResources[1] : m_upsampledResource;
+
+	int pass = graph.AddPass("depth downsample", ExecutePass, this, PASS_DEPTH_DOWNSAMPLE);
+	graph.ReadTexture(pass, m_sceneDepthResource);
+	graph.WriteTexture(pass, m_linearDepthResource);
+
+	pass = graph.AddPass("SSAO", ExecutePass, this, PASS_AMBIENT_OCCLUSION);
+	graph.ReadTexture(pass, m_linearDepthResource);
+	graph.WriteTexture(pass, m_occlusionResource);
+
+	pass = graph.AddPass("horizontal blur", ExecutePass, this, PASS_HORIZONTAL_BLUR);
+	graph.ReadTexture(pass, m_linearDepthResource);
+	graph.ReadTexture(pass, m_occlusionResource);
+	graph.WriteTexture(pass, m_blurResources[0]);
+
+	pass = graph.AddPass("vertical blur", ExecutePass, this, PASS_VERTICAL_BLUR);
+	graph.ReadTexture(pass, m_linearDepthResource);
+	graph.ReadTexture(pass, m_blurResources[0]);
+	graph.WriteTexture(pass, m_blurResources[1]);
+
+	pass = graph.AddPass("bilateral upsample", ExecutePass, this, PASS_UPSAMPLE);
+	graph.ReadTexture(pass, m_sceneDepthResource);
+	graph.ReadTexture(pass, m_linearDepthResource);
+	graph.ReadTexture(pass, m_blurResources[1]);
+	graph.WriteTexture(pass, m_upsampledResource);
+
+	// the composite blends over the scene, so it reads it as well
+	pass = graph.AddPass("SSAO composite", ExecutePass, this, PASS_COMPOSITE);
+	graph.ReadTexture(pass, m_resultResource);
+	graph.ReadTexture(pass, m_sceneColorResource);
+	graph.WriteTexture(pass, m_sceneColorResource);
+}
+
+/***********************************************************
+ *  ExecutePass()
+ *
+ *  This method is used by the render graph for drawing the
+ *  pass of the passed in tag with the passed in manager.
+ ***********************************************************/
+void EffectsManager::ExecutePass(RenderGraph& graph, void* pOwner, int tag)
+{
+	((EffectsManager*)pOwner)->DrawEffectPass(graph, (EFFECT_PASS)tag);
+}
+
+/***********************************************************
+ *  DrawEffectPass()
+ *
+ *  This method is used for binding the textures of one of
+ *  the effect passes from the render graph and drawing it.
+ ***********************************************************/
+void EffectsManager::DrawEffectPass(const RenderGraph& graph, EFFECT_PASS pass)
+{
+	int width = (m_width + m_resolution - 1) / m_resolution;
+	int height = (m_height + m_resolution - 1) / m_resolution;
+
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_BLEND);
+
+	glActiveTexture(GL_TEXTURE0 + DEPTH_TEXTURE_UNIT);
+	glBindTexture(GL_TEXTURE_2D, graph.GetTexture(m_sceneDepthResource));
+	// the downsample draws into the linear depth, so it is not bound
+	glActiveTexture(GL_TEXTURE0 + LINEAR_DEPTH_TEXTURE_UNIT);
+	glBindTexture(GL_TEXTURE_2D,
+		(pass == PASS_DEPTH_DOWNSAMPLE) ? 0 : graph.GetTexture(m_linearDepthResource));
+
+	switch (pass)
+	{
+	case PASS_DEPTH_DOWNSAMPLE:
+		// linear depth at the effect resolution
+		glBindFramebuffer(GL_FRAMEBUFFER, graph.GetFramebuffer(m_linearDepthResource));
+		glViewport(0, 0, width, height);
+		m_pDownsampleShader->use();
+		m_pDownsampleShader->setMat4Value(g_ProjectionName, m_projection);
+		m_pDownsampleShader->setIntValue(g_ResolutionFactorName, m_resolution);
+		break;
+	case PASS_AMBIENT_OCCLUSION:
+		glBindFramebuffer(GL_FRAMEBUFFER, graph.GetFramebuffer(m_occlusionResource));
+		glViewport(0, 0, width, height);
+		m_pOcclusionShader->use();
+		m_pOcclusionShader->setMat4Value(g_ProjectionName, m_projection);
+		break;
+	case PASS_HORIZONTAL_BLUR:
+	case PASS_VERTICAL_BLUR:
+		{
+			bool bHorizontal = (pass == PASS_HORIZONTAL_BLUR);
+			glBindFramebuffer(GL_FRAMEBUFFER, graph.GetFramebuffer(m_blurResources[bHorizontal ? 0 : 1]));
+			glViewport(0, 0, width, height);
+			glActiveTexture(GL_TEXTURE0 + EFFECT_TEXTURE_UNIT);
+			glBindTexture(GL_TEXTURE_2D, graph.GetTexture(bHorizontal ? m_occlusionResource : m_blurResources[0]));
+			m_pBlurShader->use();
+			m_pBlurShader->setVec2Value("blurDirection", bHorizontal ? glm::vec2(1.0f, 0.0f) : glm::vec2(0.0f, 1.0f));
+		}
+		break;
+	case PASS_UPSAMPLE:
+		// back up to the window size, keeping the edges of the depth
+		glBindFramebuffer(GL_FRAMEBUFFER, graph.GetFramebuffer(m_upsampledResource));
+		glViewport(0, 0, m_width, m_height);
+		glActiveTexture(GL_TEXTURE0 + EFFECT_TEXTURE_UNIT);
+		glBindTexture(GL_TEXTURE_2D, graph.GetTexture(m_blurResources[1]));
+		m_pUpsampleShader->use();
+		m_pUpsampleShader->setMat4Value(g_ProjectionName, m_projection);
+		m_pUpsampleShader->setIntValue(g_ResolutionFactorName, m_resolution);
+		break;
+	default:
+		// darken the scene by multiplying it with the occlusion
+		glBindFramebuffer(GL_FRAMEBUFFER, graph.GetFramebuffer(m_sceneColorResource));
+		glViewport(0, 0, m_width, m_height);
+		glActiveTexture(GL_TEXTURE0 + EFFECT_TEXTURE_UNIT);
+		glBindTexture(GL_TEXTURE_2D, graph.GetTexture(m_resultResource));
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_ZERO, GL_SRC_COLOR);
+		m_pCompositeShader->use();
+		break;
+	}
+	glActiveTexture(GL_TEXTURE0);
+
+	DrawPass(pass);
+
+	// restore the state the scene rendering expects
+	glViewport(0, 0, m_width, m_height);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glEnable(GL_BLEND);
+	glEnable(GL_DEPTH_TEST);
+}
+
+/***********************************************************
+ *  CaptureEffect()
+ *
+ *  This method is used for reading the ambient occlusion at
+ *  the window size, bottom row first, from the textures of
+ *  the graph that was last executed.
+ ***********************************************************/
+void EffectsManager::CaptureEffect(const RenderGraph& graph, std::vector<unsigned char>& pixels) const
+{
+	pixels.resize(m_width * m_height);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, graph.GetFramebuffer(m_resultResource));
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, m_width, m_height, GL_RED, GL_UNSIGNED_BYTE, pixels.data());
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+}
@@ -0,0 +1,136 @@
+///////////////////////////////////////////////////////////////////////////////
+// effectsmanager.h
+// ============
+// manage the screen-space effects - reduced resolution passes and upsampling
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+#include "GpuTimer.h"
+#include "RenderGraph.h"
+
+#include <vector>
+
+/***********************************************************
+ *  EffectsManager
+ *
+ *  This class contains the code for screen-space effects
+ *  that read the depth of the drawn scene, and that can run
+ *  at half or quarter resolution.  Each frame these passes
+ *  and their textures are added to the render graph:
+ *
+ *    depth downsample  the scene depth is made linear and
+ *                      reduced to the effect resolution,
+ *                      keeping the closest depth of each block
+ *    effect            the ambient occlusion is estimated from
+ *                      the reduced depth alone
+ *    blur              a separable blur that does not cross
+ *                      depth edges removes the sampling noise
+ *    upsample          each full resolution pixel blends the
+ *                      four nearest reduced pixels, weighted
+ *                      by how close their depth is to its own
+ *                      (culled at full resolution, where
+ *                      nothing reads it)
+ *    composite         the result darkens the scene target
+ *
+ *  so that an effect costs a quarter or a sixteenth of its
+ *  full resolution time without bleeding across the edges of
+ *  objects.  Each pass can be timed, and the full resolution
+ *  result can be captured for comparing the resolutions.
+ ***********************************************************/
+class EffectsManager
+{
+public:
+	// constructor
+	EffectsManager();
+	// destructor
+	~EffectsManager();
+
+	// texture units used for reading the effect targets
+	static const int DEPTH_TEXTURE_UNIT = 36;
+	static const int LINEAR_DEPTH_TEXTURE_UNIT = 37;
+	static const int EFFECT_TEXTURE_UNIT = 38;
+
+	// divisor of the window size that the effects run at
+	enum EFFECT_RESOLUTION
+	{
+		RESOLUTION_FULL = 1,
+		RESOLUTION_HALF = 2,
+		RESOLUTION_QUARTER = 4
+	};
+
+	// passes that can be timed
+	enum EFFECT_PASS
+	{
+		PASS_DEPTH_DOWNSAMPLE,
+		PASS_AMBIENT_OCCLUSION,
+		PASS_HORIZONTAL_BLUR,
+		PASS_VERTICAL_BLUR,
+		PASS_UPSAMPLE,
+		PASS_COMPOSITE,
+		PASS_COUNT
+	};
+
+private:
+	// render graph textures of the current frame
+	int m_sceneColorResource;
+	int m_sceneDepthResource;
+	int m_linearDepthResource;
+	int m_occlusionResource;
+	int m_blurResources[2];
+	int m_upsampledResource;
+	// occlusion at the window size that the composite reads
+	int m_resultResource;
+	// projection the scene depth was drawn with
+	glm::mat4 m_projection;
+	int m_width;
+	int m_height;
+	EFFECT_RESOLUTION m_resolution;
+	// shaders of the passes
+	ShaderManager* m_pDownsampleShader;
+	ShaderManager* m_pOcclusionShader;
+	ShaderManager* m_pBlurShader;
+	ShaderManager* m_pUpsampleShader;
+	ShaderManager* m_pCompositeShader;
+	// empty vertex array used for the full screen triangle
+	GLuint m_fullscreenVAO;
+	// timers of the passes, only created when timing is enabled
+	GpuTimer* m_pPassTimers[PASS_COUNT];
+
+	// called by the render graph to draw one of the passes
+	static void ExecutePass(RenderGraph& graph, void* pOwner, int tag);
+	void DrawEffectPass(const RenderGraph& graph, EFFECT_PASS pass);
+	// draw the full screen triangle, timed as the passed in pass
+	void DrawPass(EFFECT_PASS pass);
+
+public:
+	// set the window size the effects are upsampled to
+	void SetWindowSize(int width, int height);
+	// load the shaders of the passes
+	void LoadShaders();
+
+	// select the resolution the effects run at
+	void SetResolution(EFFECT_RESOLUTION resolution);
+	EFFECT_RESOLUTION GetResolution() const;
+	// enable the timing of each pass
+	void SetPassTiming(bool bEnabled);
+	// get the most recent GPU time of a pass in milliseconds
+	double GetPassMilliseconds(EFFECT_PASS pass) const;
+	// get the display name of a resolution or a pass
+	static const char* GetResolutionName(EFFECT_RESOLUTION resolution);
+	static const char* GetPassName(EFFECT_PASS pass);
+
+	// add the passes applying the ambient occlusion to the scene
+	void AddAmbientOcclusionPasses(
+		RenderGraph& graph,
+		int sceneColorResource,
+		int sceneDepthResource,
+		const glm::mat4& projection);
+
+	// read the full resolution ambient occlusion of the executed graph
+	void CaptureEffect(const RenderGraph& graph, std::vector<unsigned char>& pixels) const;
+};
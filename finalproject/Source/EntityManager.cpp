@@ -0,0 +1,760 @@
+///////////////////////////////////////////////////////////////////////////////
+// entitymanager.cpp
+// ============
+// store the scene entities by archetype in chunks of component arrays
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "EntityManager.h"
+#include "JobSystem.h"
+
+#include <glm/gtx/transform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// declare the global variables
+namespace
+{
+	// alignment of every component array, one cache line
+	const size_t ARRAY_ALIGNMENT = 64;
+	// chunks each job of a system takes
+	const size_t CHUNKS_PER_JOB = 8;
+
+	// size of one element of each component array
+	const size_t COMPONENT_SIZES[EntityManager::COMPONENT_COUNT] =
+	{
+		sizeof(EntityManager::TRANSFORM),
+		sizeof(glm::mat4),
+		sizeof(EntityManager::MESH_REF),
+		sizeof(EntityManager::MATERIAL_REF),
+		sizeof(EntityManager::BOUNDS),
+		sizeof(EntityManager::VISIBILITY),
+		sizeof(EntityManager::MOTION)
+	};
+
+	/***********************************************************
+	 *  AlignArrayOffset()
+	 *
+	 *  This function is used for rounding an offset in a chunk
+	 *  block up to the start of the next cache line.
+	 ***********************************************************/
+	size_t AlignArrayOffset(size_t offset)
+	{
+		return((offset + ARRAY_ALIGNMENT - 1) & ~(ARRAY_ALIGNMENT - 1));
+	}
+}
+
+/***********************************************************
+ *  EntityManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+EntityManager::EntityManager(int maxEntities)
+{
+	m_entities.SetCapacity(maxEntities);
+	m_pJobSystem = NULL;
+	for (int i = 0; i < 6; i++)
+	{
+		m_frustumPlanes[i] = glm::vec4(0.0f);
+	}
+	m_lastTransformMilliseconds = 0.0;
+	m_lastCullMilliseconds = 0.0;
+}
+
+/***********************************************************
+ *  ~EntityManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+EntityManager::~EntityManager()
+{
+	Clear();
+	for (size_t i = 0; i < m_archetypes.size(); i++)
+	{
+		delete m_archetypes[i];
+	}
+	m_archetypes.clear();
+}
+
+/***********************************************************
+ *  FindArchetype()
+ *
+ *  This method is used for getting the index of the
+ *  archetype of the passed in set of components.  A new set
+ *  gets an archetype with the offsets of its arrays in a
+ *  chunk, each array on its own cache lines.
+ ***********************************************************/
+int EntityManager::FindArchetype(COMPONENT_MASK mask)
+{
+	for (size_t i = 0; i < m_archetypes.size(); i++)
+	{
+		if (m_archetypes[i]->mask == mask)
+		{
+			return((int)i);
+		}
+	}
+
+	ARCHETYPE* pArchetype = new ARCHETYPE();
+	pArchetype->mask = mask;
+	// the entity handles come first, then each component present
+	size_t offset = AlignArrayOffset(sizeof(unsigned int) * CHUNK_CAPACITY);
+	pArchetype->offsets[COMPONENT_COUNT] = 0;
+	for (int c = 0; c < COMPONENT_COUNT; c++)
+	{
+		pArchetype->offsets[c] = offset;
+		if ((mask & (1u << c)) != 0)
+		{
+			offset = AlignArrayOffset(offset + COMPONENT_SIZES[c] * CHUNK_CAPACITY);
+		}
+	}
+	pArchetype->chunkBytes = offset;
+
+	m_archetypes.push_back(pArchetype);
+	return((int)m_archetypes.size() - 1);
+}
+
+/***********************************************************
+ *  CreateChunk()
+ *
+ *  This method is used for allocating an empty chunk with
+ *  the component arrays of the passed in archetype.
+ ***********************************************************/
+EntityManager::CHUNK* EntityManager::CreateChunk(const ARCHETYPE& archetype)
+{
+	CHUNK* pChunk = new CHUNK();
+	pChunk->count = 0;
+	pChunk->bTransformsDirty = false;
+	pChunk->pMemory = new unsigned char[archetype.chunkBytes + ARRAY_ALIGNMENT - 1];
+
+	uintptr_t start = (uintptr_t)pChunk->pMemory;
+	unsigned char* pBase = pChunk->pMemory + (((start + ARRAY_ALIGNMENT - 1) & ~(uintptr_t)(ARRAY_ALIGNMENT - 1)) - start);
+	void* arrays[COMPONENT_COUNT];
+	for (int c = 0; c < COMPONENT_COUNT; c++)
+	{
+		arrays[c] = ((archetype.mask & (1u << c)) != 0) ? pBase + archetype.offsets[c] : NULL;
+	}
+	pChunk->pEntities = (unsigned int*)(pBase + archetype.offsets[COMPONENT_COUNT]);
+	pChunk->pTransforms = (TRANSFORM*)arrays[COMPONENT_TRANSFORM];
+	pChunk->pWorldMatrices = (glm::mat4*)arrays[COMPONENT_WORLD_MATRIX];
+	pChunk->pMeshes = (MESH_REF*)arrays[COMPONENT_MESH];
+	pChunk->pMaterials = (MATERIAL_REF*)arrays[COMPONENT_MATERIAL];
+	pChunk->pBounds = (BOUNDS*)arrays[COMPONENT_BOUNDS];
+	pChunk->pVisibility = (VISIBILITY*)arrays[COMPONENT_VISIBILITY];
+	pChunk->pMotions = (MOTION*)arrays[COMPONENT_MOTION];
+	return(pChunk);
+}
+
+/***********************************************************
+ *  ClearRow()
+ *
+ *  This method is used for setting the components of a new
+ *  entity to their defaults: at the origin, unturned and at
+ *  unit scale, white, without a material or texture, inside
+ *  a unit box and visible.
+ ***********************************************************/
+void EntityManager::ClearRow(CHUNK& chunk, int row)
+{
+	if (NULL != chunk.pTransforms)
+	{
+		chunk.pTransforms[row].position = glm::vec3(0.0f);
+		chunk.pTransforms[row].rotationDegrees = glm::vec3(0.0f);
+		chunk.pTransforms[row].scale = glm::vec3(1.0f);
+	}
+	if (NULL != chunk.pWorldMatrices)
+	{
+		chunk.pWorldMatrices[row] = glm::mat4(1.0f);
+	}
+	if (NULL != chunk.pMeshes)
+	{
+		chunk.pMeshes[row].mesh = 0;
+	}
+	if (NULL != chunk.pMaterials)
+	{
+		chunk.pMaterials[row].color = glm::vec4(1.0f);
+		chunk.pMaterials[row].material = 0;
+		chunk.pMaterials[row].textureSlot = -1;
+		chunk.pMaterials[row].shininess = 32.0f;
+	}
+	if (NULL != chunk.pBounds)
+	{
+		chunk.pBounds[row].center = glm::vec3(0.0f);
+		chunk.pBounds[row].radius = 0.0f;
+		chunk.pBounds[row].extent = glm::vec3(0.0f);
+		chunk.pBounds[row].localExtent = 0.5f;
+	}
+	if (NULL != chunk.pVisibility)
+	{
+		chunk.pVisibility[row].depth = 0.0f;
+		chunk.pVisibility[row].bVisible = true;
+	}
+	if (NULL != chunk.pMotions)
+	{
+		chunk.pMotions[row].restPosition = glm::vec3(0.0f);
+	}
+}
+
+/***********************************************************
+ *  CopyRow()
+ *
+ *  This method is used for copying the entity handle and
+ *  every component of a row into a row of another chunk of
+ *  the same archetype.
+ ***********************************************************/
+void EntityManager::CopyRow(const ARCHETYPE& archetype, const CHUNK& source, int sourceRow, CHUNK& destination, int destinationRow)
+{
+	destination.pEntities[destinationRow] = source.pEntities[sourceRow];
+	const void* sourceArrays[COMPONENT_COUNT] =
+	{
+		source.pTransforms, source.pWorldMatrices, source.pMeshes, source.pMaterials,
+		source.pBounds, source.pVisibility, source.pMotions
+	};
+	void* destinationArrays[COMPONENT_COUNT] =
+	{
+		destination.pTransforms, destination.pWorldMatrices, destination.pMeshes, destination.pMaterials,
+		destination.pBounds, destination.pVisibility, destination.pMotions
+	};
+	for (int c = 0; c < COMPONENT_COUNT; c++)
+	{
+		if ((archetype.mask & (1u << c)) != 0)
+		{
+			memcpy(
+				(unsigned char*)destinationArrays[c] + COMPONENT_SIZES[c] * destinationRow,
+				(const unsigned char*)sourceArrays[c] + COMPONENT_SIZES[c] * sourceRow,
+				COMPONENT_SIZES[c]);
+		}
+	}
+}
+
+/***********************************************************
+ *  CreateEntity()
+ *
+ *  This method is used for adding an entity with the passed
+ *  in components at the end of the last chunk of their
+ *  archetype.  It returns the handle of the entity, or 0
+ *  when the most entities are already alive.
+ ***********************************************************/
+unsigned int EntityManager::CreateEntity(COMPONENT_MASK mask)
+{
+	if (m_entities.GetCount() >= m_entities.GetCapacity())
+	{
+		return(0);
+	}
+
+	ENTITY_RECORD record;
+	record.archetype = FindArchetype(mask);
+	ARCHETYPE& archetype = *m_archetypes[record.archetype];
+	if ((archetype.chunks.size() == 0) || (archetype.chunks.back()->count == CHUNK_CAPACITY))
+	{
+		archetype.chunks.push_back(CreateChunk(archetype));
+		// the systems list every chunk without allocating
+		m_systemChunks.reserve(GetChunkCount());
+	}
+	CHUNK& chunk = *archetype.chunks.back();
+	record.chunk = (int)archetype.chunks.size() - 1;
+	record.row = chunk.count;
+
+	unsigned int entity = m_entities.Add(record);
+	chunk.pEntities[record.row] = entity;
+	ClearRow(chunk, record.row);
+	chunk.count++;
+	chunk.bTransformsDirty = true;
+	return(entity);
+}
+
+/***********************************************************
+ *  DestroyEntity()
+ *
+ *  This method is used for destroying the entity of the
+ *  passed in handle.  The last entity of its archetype moves
+ *  into its row, and the last chunk is freed once it is
+ *  empty.  It returns false when the handle is stale.
+ ***********************************************************/
+bool EntityManager::DestroyEntity(unsigned int entity)
+{
+	const ENTITY_RECORD* pRecord = m_entities.Get(entity);
+	if (NULL == pRecord)
+	{
+		return(false);
+	}
+
+	ARCHETYPE& archetype = *m_archetypes[pRecord->archetype];
+	CHUNK& chunk = *archetype.chunks[pRecord->chunk];
+	CHUNK& lastChunk = *archetype.chunks.back();
+	int lastRow = lastChunk.count - 1;
+	if ((&chunk != &lastChunk) || (pRecord->row != lastRow))
+	{
+		CopyRow(archetype, lastChunk, lastRow, chunk, pRecord->row);
+		ENTITY_RECORD* pMoved = m_entities.Get(chunk.pEntities[pRecord->row]);
+		pMoved->chunk = pRecord->chunk;
+		pMoved->row = pRecord->row;
+		// the moved transform may not have been calculated yet
+		chunk.bTransformsDirty = chunk.bTransformsDirty || lastChunk.bTransformsDirty;
+	}
+	lastChunk.count--;
+	if (lastChunk.count == 0)
+	{
+		delete[] lastChunk.pMemory;
+		delete &lastChunk;
+		archetype.chunks.pop_back();
+	}
+
+	m_entities.Remove(entity);
+	return(true);
+}
+
+/***********************************************************
+ *  Clear()
+ *
+ *  This method is used for destroying every entity and
+ *  freeing the chunks.  The archetypes are kept.
+ ***********************************************************/
+void EntityManager::Clear()
+{
+	for (size_t a = 0; a < m_archetypes.size(); a++)
+	{
+		std::vector<CHUNK*>& chunks = m_archetypes[a]->chunks;
+		for (size_t c = 0; c < chunks.size(); c++)
+		{
+			delete[] chunks[c]->pMemory;
+			delete chunks[c];
+		}
+		chunks.clear();
+	}
+	m_entities.Clear();
+}
+
+/***********************************************************
+ *  IsEntityValid()
+ *
+ *  This method is used for checking that the passed in
+ *  handle refers to an entity that was not destroyed.
+ ***********************************************************/
+bool EntityManager::IsEntityValid(unsigned int entity) const
+{
+	return(m_entities.IsValid(entity));
+}
+
+/***********************************************************
+ *  GetEntityCount()
+ *
+ *  This method is used for getting the number of live
+ *  entities.
+ ***********************************************************/
+int EntityManager::GetEntityCount() const
+{
+	return(m_entities.GetCount());
+}
+
+/***********************************************************
+ *  GetMaxEntities()
+ *
+ *  This method is used for getting the most entities that
+ *  can be alive at once.
+ ***********************************************************/
+int EntityManager::GetMaxEntities() const
+{
+	return(m_entities.GetCapacity());
+}
+
+/***********************************************************
+ *  SetTransform()
+ *
+ *  This method is used for placing an entity, which marks
+ *  its chunk for the transform system.  It returns false
+ *  when the handle is stale or the entity has no transform.
+ ***********************************************************/
+bool EntityManager::SetTransform(unsigned int entity, glm::vec3 position, glm::vec3 rotationDegrees, glm::vec3 scale)
+{
+	const ENTITY_RECORD* pRecord = m_entities.Get(entity);
+	if (NULL == pRecord)
+	{
+		return(false);
+	}
+	CHUNK& chunk = *m_archetypes[pRecord->archetype]->chunks[pRecord->chunk];
+	if (NULL == chunk.pTransforms)
+	{
+		return(false);
+	}
+	chunk.pTransforms[pRecord->row].position = position;
+	chunk.pTransforms[pRecord->row].rotationDegrees = rotationDegrees;
+	chunk.pTransforms[pRecord->row].scale = scale;
+	chunk.bTransformsDirty = true;
+	return(true);
+}
+
+/***********************************************************
+ *  GetTransform()
+ *
+ *  These methods are used for getting one component of the
+ *  entity of the passed in handle.  They return NULL when
+ *  the handle is stale or the entity lacks the component.
+ *  The component moves when another entity is destroyed,
+ *  so the pointer is only kept until then.
+ ***********************************************************/
+const EntityManager::TRANSFORM* EntityManager::GetTransform(unsigned int entity) const
+{
+	const ENTITY_RECORD* pRecord = m_entities.Get(entity);
+	if (NULL == pRecord)
+	{
+		return(NULL);
+	}
+	const CHUNK& chunk = *m_archetypes[pRecord->archetype]->chunks[pRecord->chunk];
+	return((NULL != chunk.pTransforms) ? &chunk.pTransforms[pRecord->row] : NULL);
+}
+
+const glm::mat4* EntityManager::GetWorldMatrix(unsigned int entity) const
+{
+	const ENTITY_RECORD* pRecord = m_entities.Get(entity);
+	if (NULL == pRecord)
+	{
+		return(NULL);
+	}
+	const CHUNK& chunk = *m_archetypes[pRecord->archetype]->chunks[pRecord->chunk];
+	return((NULL != chunk.pWorldMatrices) ? &chunk.pWorldMatrices[pRecord->row] : NULL);
+}
+
+EntityManager::MESH_REF* EntityManager::GetMesh(unsigned int entity)
+{
+	const ENTITY_RECORD* pRecord = m_entities.Get(entity);
+	if (NULL == pRecord)
+	{
+		return(NULL);
+	}
+	CHUNK& chunk = *m_archetypes[pRecord->archetype]->chunks[pRecord->chunk];
+	return((NULL != chunk.pMeshes) ? &chunk.pMeshes[pRecord->row] : NULL);
+}
+
+EntityManager::MATERIAL_REF* EntityManager::GetMaterial(unsigned int entity)
+{
+	const ENTITY_RECORD* pRecord = m_entities.Get(entity);
+	if (NULL == pRecord)
+	{
+		return(NULL);
+	}
+	CHUNK& chunk = *m_archetypes[pRecord->archetype]->chunks[pRecord->chunk];
+	return((NULL != chunk.pMaterials) ? &chunk.pMaterials[pRecord->row] : NULL);
+}
+
+EntityManager::BOUNDS* EntityManager::GetBounds(unsigned int entity)
+{
+	const ENTITY_RECORD* pRecord = m_entities.Get(entity);
+	if (NULL == pRecord)
+	{
+		return(NULL);
+	}
+	CHUNK& chunk = *m_archetypes[pRecord->archetype]->chunks[pRecord->chunk];
+	// a new local extent needs the world bounds calculated again
+	chunk.bTransformsDirty = true;
+	return((NULL != chunk.pBounds) ? &chunk.pBounds[pRecord->row] : NULL);
+}
+
+EntityManager::VISIBILITY* EntityManager::GetVisibility(unsigned int entity)
+{
+	const ENTITY_RECORD* pRecord = m_entities.Get(entity);
+	if (NULL == pRecord)
+	{
+		return(NULL);
+	}
+	CHUNK& chunk = *m_archetypes[pRecord->archetype]->chunks[pRecord->chunk];
+	return((NULL != chunk.pVisibility) ? &chunk.pVisibility[pRecord->row] : NULL);
+}
+
+EntityManager::MOTION* EntityManager::GetMotion(unsigned int entity)
+{
+	const ENTITY_RECORD* pRecord = m_entities.Get(entity);
+	if (NULL == pRecord)
+	{
+		return(NULL);
+	}
+	CHUNK& chunk = *m_archetypes[pRecord->archetype]->chunks[pRecord->chunk];
+	return((NULL != chunk.pMotions) ? &chunk.pMotions[pRecord->row] : NULL);
+}
+
+/***********************************************************
+ *  FindChunks()
+ *
+ *  This method is used for listing the chunks of every
+ *  archetype that has all of the included components and
+ *  none of the excluded ones, in the order the archetypes
+ *  were first used.  The passed in list is cleared first,
+ *  so a list kept from frame to frame is not allocated again.
+ ***********************************************************/
+void EntityManager::FindChunks(COMPONENT_MASK include, COMPONENT_MASK exclude, std::vector<CHUNK*>& chunks) const
+{
+	chunks.clear();
+	for (size_t a = 0; a < m_archetypes.size(); a++)
+	{
+		const ARCHETYPE& archetype = *m_archetypes[a];
+		if (((archetype.mask & include) == include) && ((archetype.mask & exclude) == 0))
+		{
+			chunks.insert(chunks.end(), archetype.chunks.begin(), archetype.chunks.end());
+		}
+	}
+}
+
+/***********************************************************
+ *  GetArchetypeCount()
+ *
+ *  This method is used for getting the number of different
+ *  sets of components the entities have had.
+ ***********************************************************/
+int EntityManager::GetArchetypeCount() const
+{
+	return((int)m_archetypes.size());
+}
+
+/***********************************************************
+ *  GetChunkCount()
+ *
+ *  This method is used for getting the number of chunks of
+ *  all the archetypes.
+ ***********************************************************/
+int EntityManager::GetChunkCount() const
+{
+	size_t chunkCount = 0;
+	for (size_t a = 0; a < m_archetypes.size(); a++)
+	{
+		chunkCount += m_archetypes[a]->chunks.size();
+	}
+	return((int)chunkCount);
+}
+
+/***********************************************************
+ *  SetJobSystem()
+ *
+ *  This method is used for running the transform and
+ *  culling systems on the threads of a job system, rather
+ *  than on the calling thread alone.
+ ***********************************************************/
+void EntityManager::SetJobSystem(JobSystem* pJobSystem)
+{
+	m_pJobSystem = pJobSystem;
+}
+
+/***********************************************************
+ *  UpdateChunkTransforms()
+ *
+ *  This method is used for calculating the world matrices
+ *  of a chunk whose transforms changed, and its world boxes
+ *  and spheres when it has bounds.  The matrix scales, then
+ *  turns around X, Y and Z, then moves the mesh.
+ ***********************************************************/
+void EntityManager::UpdateChunkTransforms(CHUNK& chunk)
+{
+	if ((chunk.bTransformsDirty == false) || (NULL == chunk.pTransforms) || (NULL == chunk.pWorldMatrices))
+	{
+		return;
+	}
+
+	for (int i = 0; i < chunk.count; i++)
+	{
+		const TRANSFORM& transform = chunk.pTransforms[i];
+		glm::mat4 scale = glm::scale(transform.scale);
+		glm::mat4 rotationX = glm::rotate(glm::radians(transform.rotationDegrees.x), glm::vec3(1.0f, 0.0f, 0.0f));
+		glm::mat4 rotationY = glm::rotate(glm::radians(transform.rotationDegrees.y), glm::vec3(0.0f, 1.0f, 0.0f));
+		glm::mat4 rotationZ = glm::rotate(glm::radians(transform.rotationDegrees.z), glm::vec3(0.0f, 0.0f, 1.0f));
+		glm::mat4 translation = glm::translate(transform.position);
+		chunk.pWorldMatrices[i] = translation * rotationZ * rotationY * rotationX * scale;
+	}
+
+	if (NULL != chunk.pBounds)
+	{
+		for (int i = 0; i < chunk.count; i++)
+		{
+			const glm::mat4& world = chunk.pWorldMatrices[i];
+			BOUNDS& bounds = chunk.pBounds[i];
+			bounds.center = glm::vec3(world[3]);
+			bounds.extent = glm::vec3(0.0f);
+			float axisLengths = 0.0f;
+			for (int axis = 0; axis < 3; axis++)
+			{
+				glm::vec3 halfAxis = glm::vec3(world[axis]) * bounds.localExtent;
+				bounds.extent += glm::abs(halfAxis);
+				axisLengths += glm::dot(halfAxis, halfAxis);
+			}
+			// the corner of the turned box is the farthest point
+			bounds.radius = std::sqrt(axisLengths);
+		}
+	}
+	chunk.bTransformsDirty = false;
+}
+
+/***********************************************************
+ *  CullChunk()
+ *
+ *  This method is used for testing the bounding spheres of
+ *  a chunk against the passed in frustum planes, writing
+ *  whether each entity is visible and its distance in front
+ *  of the near plane.
+ ***********************************************************/
+void EntityManager::CullChunk(CHUNK& chunk, const glm::vec4 frustumPlanes[6])
+{
+	if ((NULL == chunk.pBounds) || (NULL == chunk.pVisibility))
+	{
+		return;
+	}
+
+	for (int i = 0; i < chunk.count; i++)
+	{
+		const BOUNDS& bounds = chunk.pBounds[i];
+		bool bVisible = true;
+		for (int p = 0; (p < 6) && (bVisible == true); p++)
+		{
+			bVisible = (glm::dot(glm::vec3(frustumPlanes[p]), bounds.center) + frustumPlanes[p].w) >= -bounds.radius;
+		}
+		chunk.pVisibility[i].bVisible = bVisible;
+		// the near plane faces into the frustum
+		chunk.pVisibility[i].depth = std::max(0.0f, glm::dot(glm::vec3(frustumPlanes[4]), bounds.center) + frustumPlanes[4].w);
+	}
+}
+
+/***********************************************************
+ *  ExtractFrustumPlanes()
+ *
+ *  This method is used for getting the six planes of the
+ *  view frustum from the passed in view projection matrix,
+ *  with their normals pointing into the frustum.  The near
+ *  plane is the fifth.
+ ***********************************************************/
+void EntityManager::ExtractFrustumPlanes(const glm::mat4& viewProjection, glm::vec4 frustumPlanes[6])
+{
+	glm::vec4 rows[4];
+	for (int i = 0; i < 4; i++)
+	{
+		rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+	}
+	for (int i = 0; i < 3; i++)
+	{
+		frustumPlanes[i * 2] = rows[3] + rows[i];
+		frustumPlanes[i * 2 + 1] = rows[3] - rows[i];
+	}
+	for (int i = 0; i < 6; i++)
+	{
+		frustumPlanes[i] /= glm::length(glm::vec3(frustumPlanes[i]));
+	}
+}
+
+/***********************************************************
+ *  TransformJob()
+ *
+ *  This method is used for running the transform system
+ *  over a range of the listed chunks as a job.
+ ***********************************************************/
+void EntityManager::TransformJob(void* pOwner, size_t first, size_t count)
+{
+	EntityManager* pManager = (EntityManager*)pOwner;
+	for (size_t i = first; i < first + count; i++)
+	{
+		UpdateChunkTransforms(*pManager->m_systemChunks[i]);
+	}
+}
+
+/***********************************************************
+ *  CullJob()
+ *
+ *  This method is used for running the culling system over
+ *  a range of the listed chunks as a job.
+ ***********************************************************/
+void EntityManager::CullJob(void* pOwner, size_t first, size_t count)
+{
+	EntityManager* pManager = (EntityManager*)pOwner;
+	for (size_t i = first; i < first + count; i++)
+	{
+		CullChunk(*pManager->m_systemChunks[i], pManager->m_frustumPlanes);
+	}
+}
+
+/***********************************************************
+ *  UpdateTransforms()
+ *
+ *  This method is used for running the transform system
+ *  over every chunk with transforms and world matrices.
+ *  Chunks whose transforms did not change are skipped, so a
+ *  scene that stands still costs one check per chunk.
+ ***********************************************************/
+void EntityManager::UpdateTransforms()
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	// keep only the chunks whose transforms changed
+	FindChunks(MASK_TRANSFORM | MASK_WORLD_MATRIX, 0, m_systemChunks);
+	size_t dirtyCount = 0;
+	for (size_t i = 0; i < m_systemChunks.size(); i++)
+	{
+		if (m_systemChunks[i]->bTransformsDirty == true)
+		{
+			m_systemChunks[dirtyCount++] = m_systemChunks[i];
+		}
+	}
+	m_systemChunks.resize(dirtyCount);
+
+	if ((NULL != m_pJobSystem) && (m_systemChunks.size() > CHUNKS_PER_JOB))
+	{
+		JobSystem::JOB_COUNTER updated;
+		m_pJobSystem->ParallelFor(&EntityManager::TransformJob, this, m_systemChunks.size(), CHUNKS_PER_JOB, &updated);
+		m_pJobSystem->Wait(&updated);
+	}
+	else
+	{
+		TransformJob(this, 0, m_systemChunks.size());
+	}
+
+	m_lastTransformMilliseconds = std::chrono::duration<double, std::milli>(
+		std::chrono::steady_clock::now() - start).count();
+}
+
+/***********************************************************
+ *  CullEntities()
+ *
+ *  This method is used for running the culling system over
+ *  every chunk with bounds and visibility, against the view
+ *  frustum of the passed in view projection matrix.
+ ***********************************************************/
+void EntityManager::CullEntities(const glm::mat4& viewProjection)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	ExtractFrustumPlanes(viewProjection, m_frustumPlanes);
+	FindChunks(MASK_BOUNDS | MASK_VISIBILITY, 0, m_systemChunks);
+	if ((NULL != m_pJobSystem) && (m_systemChunks.size() > CHUNKS_PER_JOB))
+	{
+		JobSystem::JOB_COUNTER culled;
+		m_pJobSystem->ParallelFor(&EntityManager::CullJob, this, m_systemChunks.size(), CHUNKS_PER_JOB, &culled);
+		m_pJobSystem->Wait(&culled);
+	}
+	else
+	{
+		CullJob(this, 0, m_systemChunks.size());
+	}
+
+	m_lastCullMilliseconds = std::chrono::duration<double, std::milli>(
+		std::chrono::steady_clock::now() - start).count();
+}
+
+/***********************************************************
+ *  GetLastTransformMilliseconds()
+ *
+ *  This method is used for getting the CPU time of the last
+ *  run of the transform system.
+ ***********************************************************/
+double EntityManager::GetLastTransformMilliseconds() const
+{
+	return(m_lastTransformMilliseconds);
+}
+
+/***********************************************************
+ *  GetLastCullMilliseconds()
+ *
+ *  This method is used for getting the CPU time of the last
+ *  run of the culling system.
+ ***********************************************************/
+double EntityManager::GetLastCullMilliseconds() const
+{
+	return(m_lastCullMilliseconds);
+}
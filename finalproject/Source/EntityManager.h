@@ -0,0 +1,240 @@
+///////////////////////////////////////////////////////////////////////////////
+// entitymanager.h
+// ============
+// store the scene entities by archetype in chunks of component arrays
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "HandlePool.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+class JobSystem;
+
+/***********************************************************
+ *  EntityManager
+ *
+ *  This class contains the code for storing entities as
+ *  sets of components.  Entities with the same components
+ *  share an archetype, whose entities are kept in chunks of
+ *  a fixed size.  A chunk holds one array for each of its
+ *  components, so a system that reads one component walks
+ *  straight through memory and never loads the others.
+ *  Destroying an entity moves the last one of its archetype
+ *  into its place, so the chunks stay full.  Entities are
+ *  referred to by generational handles, which no longer
+ *  match once their entity is destroyed.
+ *
+ *  The transform system turns the position, rotation and
+ *  scale of the entities into their world matrices and world
+ *  bounds, for the chunks whose transforms changed.  The
+ *  culling system tests the bounds against a view frustum
+ *  and writes the visibility of each entity.  Both run on a
+ *  job system, a range of chunks per job, when one is set.
+ *  The draws are emitted by the owner of the entities, which
+ *  walks the chunks of the archetypes it draws.
+ ***********************************************************/
+class EntityManager
+{
+public:
+	// constructor, with the most entities alive at once
+	EntityManager(int maxEntities);
+	// destructor
+	~EntityManager();
+
+	// kinds of components an entity can have
+	enum COMPONENT
+	{
+		COMPONENT_TRANSFORM,
+		COMPONENT_WORLD_MATRIX,
+		COMPONENT_MESH,
+		COMPONENT_MATERIAL,
+		COMPONENT_BOUNDS,
+		COMPONENT_VISIBILITY,
+		COMPONENT_MOTION,
+		COMPONENT_COUNT
+	};
+
+	// set of components, one bit for each
+	typedef unsigned int COMPONENT_MASK;
+	static const COMPONENT_MASK MASK_TRANSFORM = 1u << COMPONENT_TRANSFORM;
+	static const COMPONENT_MASK MASK_WORLD_MATRIX = 1u << COMPONENT_WORLD_MATRIX;
+	static const COMPONENT_MASK MASK_MESH = 1u << COMPONENT_MESH;
+	static const COMPONENT_MASK MASK_MATERIAL = 1u << COMPONENT_MATERIAL;
+	static const COMPONENT_MASK MASK_BOUNDS = 1u << COMPONENT_BOUNDS;
+	static const COMPONENT_MASK MASK_VISIBILITY = 1u << COMPONENT_VISIBILITY;
+	static const COMPONENT_MASK MASK_MOTION = 1u << COMPONENT_MOTION;
+
+	// entities in each chunk
+	static const int CHUNK_CAPACITY = 512;
+
+	// position, rotation and scale of an entity
+	struct TRANSFORM
+	{
+		glm::vec3 position;
+		glm::vec3 rotationDegrees;
+		glm::vec3 scale;
+	};
+
+	// mesh the entity is drawn with, numbered by its owner
+	struct MESH_REF
+	{
+		int mesh;
+	};
+
+	// surface the entity is drawn with
+	struct MATERIAL_REF
+	{
+		glm::vec4 color;
+		// handle of a defined material, 0 for none
+		unsigned int material;
+		// texture slot, -1 for none
+		int textureSlot;
+		float shininess;
+	};
+
+	// world box and sphere around an entity
+	struct BOUNDS
+	{
+		glm::vec3 center;
+		float radius;
+		// half size of the world box
+		glm::vec3 extent;
+		// half size of the object space box around the mesh
+		float localExtent;
+	};
+
+	// result of the culling system
+	struct VISIBILITY
+	{
+		// distance in front of the near plane
+		float depth;
+		bool bVisible;
+	};
+
+	// position an entity moves away from
+	struct MOTION
+	{
+		glm::vec3 restPosition;
+	};
+
+	// entities of one archetype and their component arrays,
+	// which are NULL for components the archetype lacks
+	struct CHUNK
+	{
+		int count;
+		// true when a transform changed since the world matrices
+		// and bounds were calculated
+		bool bTransformsDirty;
+		unsigned int* pEntities;
+		TRANSFORM* pTransforms;
+		glm::mat4* pWorldMatrices;
+		MESH_REF* pMeshes;
+		MATERIAL_REF* pMaterials;
+		BOUNDS* pBounds;
+		VISIBILITY* pVisibility;
+		MOTION* pMotions;
+		// block all of the arrays are cut from
+		unsigned char* pMemory;
+	};
+
+private:
+	// entities with the same set of components
+	struct ARCHETYPE
+	{
+		COMPONENT_MASK mask;
+		std::vector<CHUNK*> chunks;
+		// bytes from the aligned start of the block to each array
+		size_t offsets[COMPONENT_COUNT + 1];
+		size_t chunkBytes;
+	};
+
+	// where the components of an entity are kept
+	struct ENTITY_RECORD
+	{
+		int archetype;
+		int chunk;
+		int row;
+	};
+
+	// archetypes in the order they were first used
+	std::vector<ARCHETYPE*> m_archetypes;
+	// generational handles of the entities
+	HandlePool<ENTITY_RECORD> m_entities;
+	// pointer to the job system the systems run on, when it is used
+	JobSystem* m_pJobSystem;
+	// chunks and frustum planes of the system being run
+	std::vector<CHUNK*> m_systemChunks;
+	glm::vec4 m_frustumPlanes[6];
+	// CPU time of the last run of each system
+	double m_lastTransformMilliseconds;
+	double m_lastCullMilliseconds;
+
+	// find the archetype of a set of components, adding it when new
+	int FindArchetype(COMPONENT_MASK mask);
+	// get a chunk with its arrays laid out for an archetype
+	CHUNK* CreateChunk(const ARCHETYPE& archetype);
+	// set the components of a new row to their defaults
+	static void ClearRow(CHUNK& chunk, int row);
+	// copy every component of one row into another
+	static void CopyRow(const ARCHETYPE& archetype, const CHUNK& source, int sourceRow, CHUNK& destination, int destinationRow);
+	// run the systems over a range of chunks as a job
+	static void TransformJob(void* pOwner, size_t first, size_t count);
+	static void CullJob(void* pOwner, size_t first, size_t count);
+
+public:
+	// create an entity with the passed in components, or get 0
+	// when the most entities are alive
+	unsigned int CreateEntity(COMPONENT_MASK mask);
+	// destroy an entity, false when its handle is stale
+	bool DestroyEntity(unsigned int entity);
+	// destroy every entity
+	void Clear();
+	// check that a handle refers to a live entity
+	bool IsEntityValid(unsigned int entity) const;
+	// get the number of live entities and the most there can be
+	int GetEntityCount() const;
+	int GetMaxEntities() const;
+
+	// set the transform of an entity, so that its world matrix
+	// and bounds are calculated again
+	bool SetTransform(unsigned int entity, glm::vec3 position, glm::vec3 rotationDegrees, glm::vec3 scale);
+	// get the components of an entity, NULL when it has none
+	const TRANSFORM* GetTransform(unsigned int entity) const;
+	const glm::mat4* GetWorldMatrix(unsigned int entity) const;
+	MESH_REF* GetMesh(unsigned int entity);
+	MATERIAL_REF* GetMaterial(unsigned int entity);
+	BOUNDS* GetBounds(unsigned int entity);
+	VISIBILITY* GetVisibility(unsigned int entity);
+	MOTION* GetMotion(unsigned int entity);
+
+	// get the chunks of every archetype with all of the included
+	// components and none of the excluded ones
+	void FindChunks(COMPONENT_MASK include, COMPONENT_MASK exclude, std::vector<CHUNK*>& chunks) const;
+	// get the number of archetypes and chunks in use
+	int GetArchetypeCount() const;
+	int GetChunkCount() const;
+
+	// run the systems on the threads of a job system
+	void SetJobSystem(JobSystem* pJobSystem);
+	// calculate the world matrices and bounds of the changed chunks
+	void UpdateTransforms();
+	// find the entities inside the frustum of a view projection
+	void CullEntities(const glm::mat4& viewProjection);
+	// get the CPU time of the last run of each system
+	double GetLastTransformMilliseconds() const;
+	double GetLastCullMilliseconds() const;
+
+	// the systems for a single chunk, for owners that run them
+	// next to their own work on a chunk
+	static void UpdateChunkTransforms(CHUNK& chunk);
+	static void CullChunk(CHUNK& chunk, const glm::vec4 frustumPlanes[6]);
+	// get the planes of a view frustum, facing into it
+	static void ExtractFrustumPlanes(const glm::mat4& viewProjection, glm::vec4 frustumPlanes[6]);
+};
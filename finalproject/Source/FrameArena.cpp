@@ -0,0 +1,190 @@
+///////////////////////////////////////////////////////////////////////////////
+// framearena.cpp
+// ============
+// hand out the short-lived memory of a frame from per-thread linear blocks
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+/***********************************************************
+ *  FrameArena()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+FrameArena::FrameArena(size_t bytesPerThread, int threadCount)
+{
+	m_threadCount = std::max(1, threadCount);
+
+	// the sub-arenas are placed on the first cache line boundary
+	m_pSubArenaMemory = new unsigned char[m_threadCount * sizeof(SUB_ARENA) + SUB_ARENA_ALIGNMENT - 1];
+	uintptr_t start = (uintptr_t)m_pSubArenaMemory;
+	m_subArenas = (SUB_ARENA*)(m_pSubArenaMemory + (((start + SUB_ARENA_ALIGNMENT - 1) & ~(uintptr_t)(SUB_ARENA_ALIGNMENT - 1)) - start));
+	for (int i = 0; i < m_threadCount; i++)
+	{
+		new (&m_subArenas[i]) SUB_ARENA();
+		m_subArenas[i].capacity = bytesPerThread;
+		m_subArenas[i].pBlock = (bytesPerThread > 0) ? new unsigned char[bytesPerThread] : NULL;
+		m_subArenas[i].used = 0;
+		m_subArenas[i].pExtraBlocks = NULL;
+		m_subArenas[i].extraBytes = 0;
+		m_subArenas[i].extraBlockCount = 0;
+	}
+	m_lastFrameBytes = 0;
+	m_peakFrameBytes = 0;
+	m_extraBlockCount = 0;
+}
+
+/***********************************************************
+ *  ~FrameArena()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+FrameArena::~FrameArena()
+{
+	Reset();
+	for (int i = 0; i < m_threadCount; i++)
+	{
+		delete[] m_subArenas[i].pBlock;
+	}
+	delete[] m_pSubArenaMemory;
+	m_pSubArenaMemory = NULL;
+	m_subArenas = NULL;
+}
+
+/***********************************************************
+ *  Allocate()
+ *
+ *  This method is used for cutting the next aligned piece
+ *  from the block of the passed in sub-arena.  Only one
+ *  thread may allocate from a sub-arena at a time.
+ ***********************************************************/
+void* FrameArena::Allocate(size_t size, size_t alignment, int threadIndex)
+{
+	SUB_ARENA& subArena = m_subArenas[threadIndex];
+
+	uintptr_t base = (uintptr_t)subArena.pBlock;
+	size_t offset = (size_t)(((base + subArena.used + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base);
+	if ((NULL != subArena.pBlock) && (offset + size <= subArena.capacity))
+	{
+		subArena.used = offset + size;
+		return(subArena.pBlock + offset);
+	}
+
+	return(AllocateExtra(subArena, size, alignment));
+}
+
+/***********************************************************
+ *  AllocateExtra()
+ *
+ *  This method is used for taking a block from the general
+ *  heap for an allocation that does not fit in the block of
+ *  its sub-arena.  The extra blocks are chained through a
+ *  pointer at their start and freed at the next reset.
+ ***********************************************************/
+void* FrameArena::AllocateExtra(SUB_ARENA& subArena, size_t size, size_t alignment)
+{
+	size_t blockSize = sizeof(void*) + alignment + size;
+	unsigned char* pExtra = new unsigned char[blockSize];
+	*(void**)pExtra = subArena.pExtraBlocks;
+	subArena.pExtraBlocks = pExtra;
+	subArena.extraBytes += blockSize;
+	subArena.extraBlockCount++;
+
+	uintptr_t start = (uintptr_t)(pExtra + sizeof(void*));
+	start = (start + alignment - 1) & ~(uintptr_t)(alignment - 1);
+	return((void*)start);
+}
+
+/***********************************************************
+ *  Reset()
+ *
+ *  This method is used for releasing everything allocated
+ *  from the arena.  A sub-arena that needed extra blocks is
+ *  grown to hold all of this frame's allocations, so the
+ *  next frame like it fits in one block.  The extra blocks
+ *  the threads counted are added to the total here.
+ ***********************************************************/
+void FrameArena::Reset()
+{
+	size_t frameBytes = 0;
+	for (int i = 0; i < m_threadCount; i++)
+	{
+		SUB_ARENA& subArena = m_subArenas[i];
+		frameBytes += subArena.used + subArena.extraBytes;
+		m_extraBlockCount += subArena.extraBlockCount;
+		subArena.extraBlockCount = 0;
+
+		if (NULL != subArena.pExtraBlocks)
+		{
+			while (NULL != subArena.pExtraBlocks)
+			{
+				unsigned char* pExtra = (unsigned char*)subArena.pExtraBlocks;
+				subArena.pExtraBlocks = *(void**)pExtra;
+				delete[] pExtra;
+			}
+
+			// half again as much, so a slowly growing frame does not
+			// grow the block every time
+			size_t capacity = subArena.used + subArena.extraBytes;
+			capacity += capacity / 2;
+			delete[] subArena.pBlock;
+			subArena.pBlock = new unsigned char[capacity];
+			subArena.capacity = capacity;
+			subArena.extraBytes = 0;
+		}
+		subArena.used = 0;
+	}
+
+	m_lastFrameBytes = frameBytes;
+	m_peakFrameBytes = std::max(m_peakFrameBytes, frameBytes);
+}
+
+/***********************************************************
+ *  GetThreadCount()
+ *
+ *  This method is used for getting the number of sub-arenas.
+ ***********************************************************/
+int FrameArena::GetThreadCount() const
+{
+	return(m_threadCount);
+}
+
+/***********************************************************
+ *  GetLastFrameBytes()
+ *
+ *  This method is used for getting the bytes allocated in
+ *  the frame before the last reset.
+ ***********************************************************/
+size_t FrameArena::GetLastFrameBytes() const
+{
+	return(m_lastFrameBytes);
+}
+
+/***********************************************************
+ *  GetPeakFrameBytes()
+ *
+ *  This method is used for getting the most bytes any
+ *  frame allocated.
+ ***********************************************************/
+size_t FrameArena::GetPeakFrameBytes() const
+{
+	return(m_peakFrameBytes);
+}
+
+/***********************************************************
+ *  GetExtraBlockCount()
+ *
+ *  This method is used for getting the number of extra
+ *  blocks taken from the general heap by the frames reset
+ *  so far, which stops growing once the frames fit.
+ ***********************************************************/
+unsigned long long FrameArena::GetExtraBlockCount() const
+{
+	return(m_extraBlockCount);
+}
@@ -0,0 +1,180 @@
+///////////////////////////////////////////////////////////////////////////////
+// framearena.h
+// ============
+// hand out the short-lived memory of a frame from per-thread linear blocks
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/***********************************************************
+ *  FrameArena
+ *
+ *  This class contains the code for allocating the memory
+ *  that only lives for one frame.  Every thread has its own
+ *  sub-arena, a block that allocations are cut from one
+ *  after the other, so no lock is taken and nothing is freed
+ *  until the whole arena is reset at the end of the frame.
+ *  When a sub-arena runs out, the allocation comes from an
+ *  extra block, and the next reset grows the sub-arena to
+ *  everything the frame used, so a steady frame never goes
+ *  to the general heap.
+ ***********************************************************/
+class FrameArena
+{
+public:
+	// constructor, with the starting size of each thread's block
+	FrameArena(size_t bytesPerThread, int threadCount);
+	// destructor
+	~FrameArena();
+
+private:
+	// block of one thread, kept on its own cache lines
+	struct alignas(64) SUB_ARENA
+	{
+		unsigned char* pBlock;
+		size_t capacity;
+		size_t used;
+		// extra blocks of this frame, linked through their first bytes,
+		// counted here so that threads do not share a counter
+		void* pExtraBlocks;
+		size_t extraBytes;
+		unsigned long long extraBlockCount;
+	};
+
+	// alignment of the sub-arenas, the size of a cache line
+	static const size_t SUB_ARENA_ALIGNMENT = 64;
+
+	int m_threadCount;
+	// memory of the sub-arenas, larger than they need so that they
+	// can start on a cache line without an aligned new
+	unsigned char* m_pSubArenaMemory;
+	SUB_ARENA* m_subArenas;
+	// bytes used by the last reset frame, its peak, and the extra
+	// blocks taken by the frames reset so far
+	size_t m_lastFrameBytes;
+	size_t m_peakFrameBytes;
+	unsigned long long m_extraBlockCount;
+
+	// take an extra block when a sub-arena is full
+	void* AllocateExtra(SUB_ARENA& subArena, size_t size, size_t alignment);
+
+public:
+	// get memory for the calling thread of the passed in index,
+	// which lives until the next reset
+	void* Allocate(size_t size, size_t alignment, int threadIndex);
+	// release everything allocated, at the end of the frame, when
+	// no thread allocates from the arena
+	void Reset();
+
+	// get the number of sub-arenas
+	int GetThreadCount() const;
+	// get the bytes used by the last frame and the most any frame used
+	size_t GetLastFrameBytes() const;
+	size_t GetPeakFrameBytes() const;
+	// get the number of extra blocks taken from the general heap
+	unsigned long long GetExtraBlockCount() const;
+};
+
+/***********************************************************
+ *  ArenaAllocator
+ *
+ *  This class contains the code for letting the standard
+ *  containers take their memory from one sub-arena of a
+ *  frame arena.  Freed memory is only reclaimed when the
+ *  arena is reset, so the containers must not outlive the
+ *  frame.  Without an arena it uses the general heap, so
+ *  containers can be declared before the arena is known.
+ *  The allocator moves with the contents of a container.
+ ***********************************************************/
+template <typename T>
+class ArenaAllocator
+{
+public:
+	typedef T value_type;
+	typedef std::true_type propagate_on_container_copy_assignment;
+	typedef std::true_type propagate_on_container_move_assignment;
+	typedef std::true_type propagate_on_container_swap;
+
+	// constructor for the general heap
+	ArenaAllocator()
+	{
+		m_pArena = NULL;
+		m_threadIndex = 0;
+	}
+
+	// constructor, with the arena and the sub-arena to allocate from
+	ArenaAllocator(FrameArena* pArena, int threadIndex)
+	{
+		m_pArena = pArena;
+		m_threadIndex = threadIndex;
+	}
+
+	// constructor for the same sub-arena from an allocator of another type
+	template <typename U>
+	ArenaAllocator(const ArenaAllocator<U>& other)
+	{
+		m_pArena = other.GetArena();
+		m_threadIndex = other.GetThreadIndex();
+	}
+
+	// get memory for count objects from the sub-arena
+	T* allocate(size_t count)
+	{
+		if (NULL == m_pArena)
+		{
+			return((T*)::operator new(count * sizeof(T)));
+		}
+		return((T*)m_pArena->Allocate(count * sizeof(T), alignof(T), m_threadIndex));
+	}
+
+	// memory from an arena is only freed when the arena is reset
+	void deallocate(T* pMemory, size_t /*count*/)
+	{
+		if (NULL == m_pArena)
+		{
+			::operator delete(pMemory);
+		}
+	}
+
+	// get the arena and the sub-arena allocated from
+	FrameArena* GetArena() const
+	{
+		return(m_pArena);
+	}
+
+	int GetThreadIndex() const
+	{
+		return(m_threadIndex);
+	}
+
+private:
+	FrameArena* m_pArena;
+	int m_threadIndex;
+};
+
+// allocators of the same sub-arena can free each other's memory
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& first, const ArenaAllocator<U>& second)
+{
+	return((first.GetArena() == second.GetArena()) && (first.GetThreadIndex() == second.GetThreadIndex()));
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& first, const ArenaAllocator<U>& second)
+{
+	return(!(first == second));
+}
+
+// containers whose memory comes from a frame arena
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T> >;
+typedef std::basic_string<char, std::char_traits<char>, ArenaAllocator<char> > ArenaString;
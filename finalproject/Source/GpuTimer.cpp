@@ -0,0 +1,155 @@
+///////////////////////////////////////////////////////////////////////////////
+// gputimer.cpp
+// ============
+// measure the GPU time spent on rendering work with timestamp queries
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "GpuTimer.h"
+
+/***********************************************************
+ *  GpuTimer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+GpuTimer::GpuTimer()
+{
+	for (int i = 0; i < QUERY_FRAMES; i++)
+	{
+		m_startQueries[i] = 0;
+		m_endQueries[i] = 0;
+	}
+	m_frameCount = 0;
+	m_readCount = 0;
+	m_lastMilliseconds = 0.0;
+}
+
+/***********************************************************
+ *  ~GpuTimer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+GpuTimer::~GpuTimer()
+{
+	// free the OpenGL query objects
+	DestroyQueries();
+}
+
+/***********************************************************
+ *  CreateQueries()
+ *
+ *  This method is used for creating the timestamp query
+ *  objects.
+ ***********************************************************/
+void GpuTimer::CreateQueries()
+{
+	glGenQueries(QUERY_FRAMES, m_startQueries);
+	glGenQueries(QUERY_FRAMES, m_endQueries);
+	m_frameCount = 0;
+	m_readCount = 0;
+}
+
+/***********************************************************
+ *  DestroyQueries()
+ *
+ *  This method is used for freeing the timestamp query
+ *  objects.
+ ***********************************************************/
+void GpuTimer::DestroyQueries()
+{
+	if (m_startQueries[0] != 0)
+	{
+		glDeleteQueries(QUERY_FRAMES, m_startQueries);
+		glDeleteQueries(QUERY_FRAMES, m_endQueries);
+		for (int i = 0; i < QUERY_FRAMES; i++)
+		{
+			m_startQueries[i] = 0;
+			m_endQueries[i] = 0;
+		}
+	}
+}
+
+/***********************************************************
+ *  ReadResults()
+ *
+ *  This method is used for reading back the timestamps of
+ *  the finished timed sections, oldest first.
+ ***********************************************************/
+void GpuTimer::ReadResults(bool bWait)
+{
+	while (m_readCount < m_frameCount)
+	{
+		int slot = m_readCount % QUERY_FRAMES;
+		GLint bAvailable = 0;
+
+		if (bWait == false)
+		{
+			glGetQueryObjectiv(m_endQueries[slot], GL_QUERY_RESULT_AVAILABLE, &bAvailable);
+			if (bAvailable == 0)
+			{
+				return;
+			}
+		}
+
+		GLuint64 startTime = 0;
+		GLuint64 endTime = 0;
+		glGetQueryObjectui64v(m_startQueries[slot], GL_QUERY_RESULT, &startTime);
+		glGetQueryObjectui64v(m_endQueries[slot], GL_QUERY_RESULT, &endTime);
+		m_lastMilliseconds = (double)(endTime - startTime) / 1000000.0;
+		m_readCount++;
+	}
+}
+
+/***********************************************************
+ *  Begin()
+ *
+ *  This method is used for marking the start of the timed
+ *  section.  If every query slot is still in flight, the
+ *  oldest result is waited on before its slot is reused.
+ ***********************************************************/
+void GpuTimer::Begin()
+{
+	ReadResults(false);
+	if (m_frameCount - m_readCount >= QUERY_FRAMES)
+	{
+		ReadResults(true);
+	}
+
+	glQueryCounter(m_startQueries[m_frameCount % QUERY_FRAMES], GL_TIMESTAMP);
+}
+
+/***********************************************************
+ *  End()
+ *
+ *  This method is used for marking the end of the timed
+ *  section.
+ ***********************************************************/
+void GpuTimer::End()
+{
+	glQueryCounter(m_endQueries[m_frameCount % QUERY_FRAMES], GL_TIMESTAMP);
+	m_frameCount++;
+}
+
+/***********************************************************
+ *  HasResult()
+ *
+ *  This method is used for checking whether a measured time
+ *  has been read back yet.
+ ***********************************************************/
+bool GpuTimer::HasResult() const
+{
+	return(m_readCount > 0);
+}
+
+/***********************************************************
+ *  GetLastMilliseconds()
+ *
+ *  This method is used for getting the most recent measured
+ *  GPU time in milliseconds.
+ ***********************************************************/
+double GpuTimer::GetLastMilliseconds() const
+{
+	return(m_lastMilliseconds);
+}
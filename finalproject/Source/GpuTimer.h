@@ -0,0 +1,63 @@
+///////////////////////////////////////////////////////////////////////////////
+// gputimer.h
+// ============
+// measure the GPU time spent on rendering work with timestamp queries
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+/***********************************************************
+ *  GpuTimer
+ *
+ *  This class contains the code for timing a section of GPU
+ *  work.  Timestamps are written into a small ring of query
+ *  objects and read back a few frames later, so reading the
+ *  results never waits on the GPU.  Timers can be nested or
+ *  overlapped because they use timestamps rather than
+ *  elapsed time queries.
+ ***********************************************************/
+class GpuTimer
+{
+public:
+	// constructor
+	GpuTimer();
+	// destructor
+	~GpuTimer();
+
+	// number of frames of queries kept in flight
+	static const int QUERY_FRAMES = 4;
+
+private:
+	// timestamp queries for the start and end of each frame
+	GLuint m_startQueries[QUERY_FRAMES];
+	GLuint m_endQueries[QUERY_FRAMES];
+	// number of timed sections started so far
+	int m_frameCount;
+	// number of timed sections that have been read back
+	int m_readCount;
+	// most recent measured time in milliseconds
+	double m_lastMilliseconds;
+
+	// read back every finished query that is available
+	void ReadResults(bool bWait);
+
+public:
+	// create the OpenGL query objects
+	void CreateQueries();
+	// free the OpenGL query objects
+	void DestroyQueries();
+
+	// mark the start and the end of the timed section
+	void Begin();
+	void End();
+
+	// check whether any measured time has been read back yet
+	bool HasResult() const;
+	// get the most recent measured time in milliseconds
+	double GetLastMilliseconds() const;
+};
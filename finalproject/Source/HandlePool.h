@@ -0,0 +1,345 @@
+///////////////////////////////////////////////////////////////////////////////
+// handlepool.h
+// ============
+// store items in a fixed-size pool and refer to them through checked handles
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+
+/***********************************************************
+ *  HandlePool
+ *
+ *  This class contains the code for keeping up to a fixed
+ *  number of items in one block of memory.  The live items
+ *  are always packed at the front of the block, so they are
+ *  iterated without gaps, and removing an item moves the last
+ *  one into its place.  Items are referred to by handles,
+ *  which hold the slot of the item in their low bits and the
+ *  generation of the slot in their high bits.  The generation
+ *  goes up every time the slot is freed, so a handle kept
+ *  after its item was removed no longer matches and is found
+ *  to be stale, rather than reaching whichever item took its
+ *  slot.  Freed slots are reused oldest first, so a slot only
+ *  comes back to an old generation after it was freed once
+ *  for every generation.  Adding and removing items takes
+ *  the same time however many items there are, and nothing
+ *  is allocated after the capacity is set.  Handle 0 is never
+ *  given out, so it can mean "no item".
+ ***********************************************************/
+template <typename T>
+class HandlePool
+{
+public:
+	// bits of a handle holding the slot, the rest hold its generation
+	static const unsigned int INDEX_BITS = 22;
+	static const unsigned int INDEX_MASK = (1u << INDEX_BITS) - 1;
+	static const unsigned int GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1;
+	// most items a pool can hold
+	static const int MAX_CAPACITY = (int)INDEX_MASK;
+
+	// constructor, with the most items the pool holds
+	HandlePool(int capacity = 0)
+	{
+		m_items = NULL;
+		m_itemHandles = NULL;
+		m_slots = NULL;
+		m_capacity = 0;
+		m_count = 0;
+		m_firstFreeSlot = NO_SLOT;
+		m_lastFreeSlot = NO_SLOT;
+		SetCapacity(capacity);
+	}
+
+	// destructor
+	~HandlePool()
+	{
+		delete[] m_items;
+		delete[] m_itemHandles;
+		delete[] m_slots;
+	}
+
+	/***********************************************************
+	 *  SetCapacity()
+	 *
+	 *  This method is used for removing every item and making
+	 *  room for the passed in number of them.  The generations
+	 *  start over, so no handle from before may be used again.
+	 ***********************************************************/
+	void SetCapacity(int capacity)
+	{
+		if (capacity < 0)
+		{
+			capacity = 0;
+		}
+		if (capacity > MAX_CAPACITY)
+		{
+			capacity = MAX_CAPACITY;
+		}
+
+		delete[] m_items;
+		delete[] m_itemHandles;
+		delete[] m_slots;
+		m_items = NULL;
+		m_itemHandles = NULL;
+		m_slots = NULL;
+		m_capacity = capacity;
+		if (m_capacity > 0)
+		{
+			m_items = new T[m_capacity];
+			m_itemHandles = new unsigned int[m_capacity];
+			m_slots = new SLOT[m_capacity];
+		}
+		Clear();
+	}
+
+	/***********************************************************
+	 *  Clear()
+	 *
+	 *  This method is used for removing every item.  Each slot
+	 *  moves to its next generation, so the handles of the
+	 *  removed items are stale.
+	 ***********************************************************/
+	void Clear()
+	{
+		for (int i = 0; i < m_count; i++)
+		{
+			m_items[i] = T();
+		}
+		for (int i = 0; i < m_capacity; i++)
+		{
+			if (m_slots[i].generation == 0)
+			{
+				m_slots[i].generation = 1;
+			}
+			else if (m_slots[i].itemIndex != NO_SLOT)
+			{
+				m_slots[i].generation = NextGeneration(m_slots[i].generation);
+			}
+			m_slots[i].itemIndex = NO_SLOT;
+			m_slots[i].nextFreeSlot = (i + 1 < m_capacity) ? i + 1 : NO_SLOT;
+		}
+		m_count = 0;
+		m_firstFreeSlot = (m_capacity > 0) ? 0 : NO_SLOT;
+		m_lastFreeSlot = (m_capacity > 0) ? m_capacity - 1 : NO_SLOT;
+	}
+
+	/***********************************************************
+	 *  Add()
+	 *
+	 *  This method is used for copying the passed in item into
+	 *  the pool.  It returns the handle of the item, or 0 when
+	 *  the pool is full.
+	 ***********************************************************/
+	unsigned int Add(const T& item)
+	{
+		if (m_firstFreeSlot == NO_SLOT)
+		{
+			return(0);
+		}
+
+		int slotIndex = m_firstFreeSlot;
+		SLOT& slot = m_slots[slotIndex];
+		m_firstFreeSlot = slot.nextFreeSlot;
+		if (m_firstFreeSlot == NO_SLOT)
+		{
+			m_lastFreeSlot = NO_SLOT;
+		}
+
+		unsigned int handle = (slot.generation << INDEX_BITS) | (unsigned int)slotIndex;
+		slot.itemIndex = m_count;
+		slot.nextFreeSlot = NO_SLOT;
+		m_items[m_count] = item;
+		m_itemHandles[m_count] = handle;
+		m_count++;
+		return(handle);
+	}
+
+	/***********************************************************
+	 *  Remove()
+	 *
+	 *  This method is used for removing the item of the passed
+	 *  in handle, moving the last item into its place.  It
+	 *  returns false when the handle is stale or was never
+	 *  given out.
+	 ***********************************************************/
+	bool Remove(unsigned int handle)
+	{
+		if (IsValid(handle) == false)
+		{
+			return(false);
+		}
+
+		int slotIndex = (int)(handle & INDEX_MASK);
+		SLOT& slot = m_slots[slotIndex];
+		int itemIndex = slot.itemIndex;
+		int lastIndex = m_count - 1;
+		if (itemIndex != lastIndex)
+		{
+			m_items[itemIndex] = m_items[lastIndex];
+			m_itemHandles[itemIndex] = m_itemHandles[lastIndex];
+			m_slots[m_itemHandles[itemIndex] & INDEX_MASK].itemIndex = itemIndex;
+		}
+		m_items[lastIndex] = T();
+		m_count--;
+
+		// the slot goes to the back of the free list, so it is
+		// the last to be reused
+		slot.generation = NextGeneration(slot.generation);
+		slot.itemIndex = NO_SLOT;
+		slot.nextFreeSlot = NO_SLOT;
+		if (m_lastFreeSlot == NO_SLOT)
+		{
+			m_firstFreeSlot = slotIndex;
+		}
+		else
+		{
+			m_slots[m_lastFreeSlot].nextFreeSlot = slotIndex;
+		}
+		m_lastFreeSlot = slotIndex;
+		return(true);
+	}
+
+	/***********************************************************
+	 *  IsValid()
+	 *
+	 *  This method is used for checking that the passed in
+	 *  handle refers to an item that is still in the pool.
+	 ***********************************************************/
+	bool IsValid(unsigned int handle) const
+	{
+		unsigned int slotIndex = handle & INDEX_MASK;
+		if ((handle == 0) || (slotIndex >= (unsigned int)m_capacity))
+		{
+			return(false);
+		}
+		const SLOT& slot = m_slots[slotIndex];
+		return((slot.itemIndex != NO_SLOT) && (slot.generation == (handle >> INDEX_BITS)));
+	}
+
+	/***********************************************************
+	 *  Get()
+	 *
+	 *  This method is used for getting the item of the passed
+	 *  in handle, or NULL when the handle is stale.  The item
+	 *  moves when another item is removed, so the pointer is
+	 *  only kept until then.
+	 ***********************************************************/
+	T* Get(unsigned int handle)
+	{
+		if (IsValid(handle) == false)
+		{
+			return(NULL);
+		}
+		return(&m_items[m_slots[handle & INDEX_MASK].itemIndex]);
+	}
+
+	const T* Get(unsigned int handle) const
+	{
+		if (IsValid(handle) == false)
+		{
+			return(NULL);
+		}
+		return(&m_items[m_slots[handle & INDEX_MASK].itemIndex]);
+	}
+
+	/***********************************************************
+	 *  GetAt()
+	 *
+	 *  This method is used for getting the item at the passed
+	 *  in position of the packed items, for iterating over all
+	 *  of them from 0 to the count.
+	 ***********************************************************/
+	T& GetAt(int index)
+	{
+		return(m_items[index]);
+	}
+
+	const T& GetAt(int index) const
+	{
+		return(m_items[index]);
+	}
+
+	/***********************************************************
+	 *  GetHandleAt()
+	 *
+	 *  This method is used for getting the handle of the item
+	 *  at the passed in position of the packed items.
+	 ***********************************************************/
+	unsigned int GetHandleAt(int index) const
+	{
+		return(m_itemHandles[index]);
+	}
+
+	/***********************************************************
+	 *  GetIndex()
+	 *
+	 *  This method is used for getting the position of the
+	 *  item of the passed in handle in the packed items, or -1
+	 *  when the handle is stale.
+	 ***********************************************************/
+	int GetIndex(unsigned int handle) const
+	{
+		if (IsValid(handle) == false)
+		{
+			return(-1);
+		}
+		return(m_slots[handle & INDEX_MASK].itemIndex);
+	}
+
+	// get the number of items and the most the pool holds
+	int GetCount() const
+	{
+		return(m_count);
+	}
+
+	int GetCapacity() const
+	{
+		return(m_capacity);
+	}
+
+private:
+	// marks the end of the free list and a slot without an item
+	static const int NO_SLOT = -1;
+
+	// generation of a handle slot and where its item is, or the
+	// next free slot while it has no item
+	struct SLOT
+	{
+		unsigned int generation = 0;
+		int itemIndex = NO_SLOT;
+		int nextFreeSlot = NO_SLOT;
+	};
+
+	// the pool owns its memory, so it is never copied
+	HandlePool(const HandlePool&);
+	HandlePool& operator=(const HandlePool&);
+
+	/***********************************************************
+	 *  NextGeneration()
+	 *
+	 *  This method is used for getting the generation after the
+	 *  passed in one, which wraps around without reaching 0 so
+	 *  that no handle is ever 0.
+	 ***********************************************************/
+	static unsigned int NextGeneration(unsigned int generation)
+	{
+		generation = (generation + 1) & GENERATION_MASK;
+		return((generation == 0) ? 1 : generation);
+	}
+
+	// packed items and the handle of each
+	T* m_items;
+	unsigned int* m_itemHandles;
+	// handle slots, indexed by the low bits of a handle
+	SLOT* m_slots;
+	int m_capacity;
+	int m_count;
+	// free slots, reused from the first and freed onto the last
+	int m_firstFreeSlot;
+	int m_lastFreeSlot;
+};
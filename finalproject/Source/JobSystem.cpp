@@ -0,0 +1,449 @@
+///////////////////////////////////////////////////////////////////////////////
+// jobsystem.cpp
+// ============
+// run engine tasks on a pool of worker threads that steal work from each other
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "JobSystem.h"
+
+#include <algorithm>
+
+// declare the global variables
+namespace
+{
+	// job system the calling thread is a worker of, and its index there
+	thread_local const JobSystem* g_pThreadJobSystem = NULL;
+	thread_local int g_threadIndex = 0;
+}
+
+/***********************************************************
+ *  JOB_COUNTER()
+ *
+ *  The constructor for the counter, with no jobs pending
+ ***********************************************************/
+JobSystem::JOB_COUNTER::JOB_COUNTER()
+	: pending(0)
+{
+}
+
+/***********************************************************
+ *  JobSystem()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+JobSystem::JobSystem(int threadCount)
+{
+	m_threadCount = std::max(1, threadCount);
+	m_queues = new JOB_QUEUE[m_threadCount];
+	for (int i = 0; i < m_threadCount; i++)
+	{
+		m_queues[i].pJobs = new JOB[QUEUE_CAPACITY];
+		m_queues[i].capacity = QUEUE_CAPACITY;
+		m_queues[i].head = 0;
+		m_queues[i].count = 0;
+	}
+	m_bRunning.store(true);
+	m_queuedJobs.store(0);
+	m_sleepingWorkers.store(0);
+	m_waitingCount.store(0);
+	ResetCounters();
+
+	// the creating thread is thread 0, the workers are the rest
+	for (int i = 1; i < m_threadCount; i++)
+	{
+		m_threads.push_back(std::thread(&JobSystem::WorkerLoop, this, i));
+	}
+}
+
+/***********************************************************
+ *  ~JobSystem()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+JobSystem::~JobSystem()
+{
+	// the workers finish the queued jobs before they stop
+	{
+		std::lock_guard<std::mutex> lock(m_sleepLock);
+		m_bRunning.store(false);
+	}
+	m_wakeCondition.notify_all();
+	for (size_t i = 0; i < m_threads.size(); i++)
+	{
+		m_threads[i].join();
+	}
+	m_threads.clear();
+
+	for (int i = 0; i < m_threadCount; i++)
+	{
+		delete[] m_queues[i].pJobs;
+	}
+	delete[] m_queues;
+	m_queues = NULL;
+}
+
+/***********************************************************
+ *  WorkerLoop()
+ *
+ *  This method is used for running jobs on one worker
+ *  thread until the job system is destroyed.  The worker
+ *  sleeps while every queue is empty.
+ ***********************************************************/
+void JobSystem::WorkerLoop(int threadIndex)
+{
+	g_pThreadJobSystem = this;
+	g_threadIndex = threadIndex;
+
+	while (true)
+	{
+		JOB job;
+		if (PopJob(threadIndex, job) == true)
+		{
+			ExecuteJob(job);
+			continue;
+		}
+
+		// the sleeping count is raised before the queued jobs are
+		// checked, and a new job is counted before the sleeping
+		// workers are, so a worker never sleeps through a new job
+		std::unique_lock<std::mutex> lock(m_sleepLock);
+		m_sleepingWorkers.fetch_add(1);
+		while ((m_queuedJobs.load() == 0) && (m_bRunning.load() == true))
+		{
+			m_wakeCondition.wait(lock);
+		}
+		m_sleepingWorkers.fetch_sub(1);
+		if ((m_queuedJobs.load() == 0) && (m_bRunning.load() == false))
+		{
+			break;
+		}
+	}
+
+	g_pThreadJobSystem = NULL;
+	g_threadIndex = 0;
+}
+
+/***********************************************************
+ *  PushJob()
+ *
+ *  This method is used for adding a job to the back of the
+ *  queue of the calling thread and waking a sleeping worker
+ *  to run or steal it.  The queue only grows when more jobs
+ *  are queued at once than it was sized for.
+ ***********************************************************/
+void JobSystem::PushJob(const JOB& job)
+{
+	JOB_QUEUE& queue = m_queues[GetThreadIndex()];
+	{
+		std::lock_guard<std::mutex> lock(queue.lock);
+		if (queue.count == queue.capacity)
+		{
+			GrowQueue(queue);
+		}
+		queue.pJobs[(queue.head + queue.count) & (queue.capacity - 1)] = job;
+		queue.count++;
+	}
+	m_queuedJobs.fetch_add(1);
+
+	if (m_sleepingWorkers.load() > 0)
+	{
+		std::lock_guard<std::mutex> lock(m_sleepLock);
+		m_wakeCondition.notify_one();
+	}
+}
+
+/***********************************************************
+ *  PopJob()
+ *
+ *  This method is used for taking the newest job from the
+ *  back of the own queue, or else the oldest job from the
+ *  front of another queue, which is the largest range left
+ *  there.  It returns false when every queue is empty.
+ ***********************************************************/
+bool JobSystem::PopJob(int threadIndex, JOB& job)
+{
+	if (m_queuedJobs.load() == 0)
+	{
+		return(false);
+	}
+
+	JOB_QUEUE& ownQueue = m_queues[threadIndex];
+	{
+		std::lock_guard<std::mutex> lock(ownQueue.lock);
+		if (ownQueue.count > 0)
+		{
+			ownQueue.count--;
+			job = ownQueue.pJobs[(ownQueue.head + ownQueue.count) & (ownQueue.capacity - 1)];
+			m_queuedJobs.fetch_sub(1);
+			return(true);
+		}
+	}
+
+	for (int i = 1; i < m_threadCount; i++)
+	{
+		JOB_QUEUE& queue = m_queues[(threadIndex + i) % m_threadCount];
+		std::lock_guard<std::mutex> lock(queue.lock);
+		if (queue.count > 0)
+		{
+			job = queue.pJobs[queue.head];
+			queue.head = (queue.head + 1) & (queue.capacity - 1);
+			queue.count--;
+			m_queuedJobs.fetch_sub(1);
+			m_stolenCount.fetch_add(1, std::memory_order_relaxed);
+			return(true);
+		}
+	}
+
+	return(false);
+}
+
+/***********************************************************
+ *  GrowQueue()
+ *
+ *  This method is used for doubling the capacity of a full
+ *  queue, copying its jobs from the front so that the new
+ *  buffer starts at its head.  The queue must be locked.
+ ***********************************************************/
+void JobSystem::GrowQueue(JOB_QUEUE& queue)
+{
+	JOB* pJobs = new JOB[queue.capacity * 2];
+	for (size_t i = 0; i < queue.count; i++)
+	{
+		pJobs[i] = queue.pJobs[(queue.head + i) & (queue.capacity - 1)];
+	}
+
+	delete[] queue.pJobs;
+	queue.pJobs = pJobs;
+	queue.capacity = queue.capacity * 2;
+	queue.head = 0;
+}
+
+/***********************************************************
+ *  ExecuteJob()
+ *
+ *  This method is used for running one job.  While its range
+ *  is larger than the grain size, the upper half is queued
+ *  as a new job of the same counter, then the function is
+ *  called on what is left.  The counter is not touched once
+ *  it has been counted down, since a waiting thread may free
+ *  it as soon as it reaches zero.
+ ***********************************************************/
+void JobSystem::ExecuteJob(JOB job)
+{
+	while (job.count > job.grainSize)
+	{
+		JOB upperHalf = job;
+		upperHalf.first = job.first + (job.count / 2);
+		upperHalf.count = job.count - (job.count / 2);
+		job.count = job.count / 2;
+		if (NULL != upperHalf.pCounter)
+		{
+			upperHalf.pCounter->pending.fetch_add(1);
+		}
+		PushJob(upperHalf);
+	}
+
+	job.function(job.pOwner, job.first, job.count);
+	m_executedCount.fetch_add(1, std::memory_order_relaxed);
+
+	if ((NULL != job.pCounter) && (job.pCounter->pending.fetch_sub(1) == 1) &&
+		(m_waitingCount.load() > 0))
+	{
+		ReleaseWaitingJobs();
+	}
+}
+
+/***********************************************************
+ *  ReleaseWaitingJobs()
+ *
+ *  This method is used for queueing the held back jobs
+ *  whose dependency counters have reached zero.
+ ***********************************************************/
+void JobSystem::ReleaseWaitingJobs()
+{
+	std::lock_guard<std::mutex> lock(m_waitingLock);
+	size_t i = 0;
+	while (i < m_waitingJobs.size())
+	{
+		if (m_waitingJobs[i].pDependency->pending.load() == 0)
+		{
+			PushJob(m_waitingJobs[i].job);
+			m_waitingJobs[i] = m_waitingJobs.back();
+			m_waitingJobs.pop_back();
+			m_waitingCount.fetch_sub(1);
+		}
+		else
+		{
+			i++;
+		}
+	}
+}
+
+/***********************************************************
+ *  Run()
+ *
+ *  This method is used for queueing a function to be called
+ *  once, with item 0.
+ ***********************************************************/
+void JobSystem::Run(JOB_FUNCTION function, void* pOwner, JOB_COUNTER* pCounter)
+{
+	ParallelFor(function, pOwner, 1, 1, pCounter);
+}
+
+/***********************************************************
+ *  ParallelFor()
+ *
+ *  This method is used for queueing a function to be called
+ *  on the items 0 to count, in ranges no larger than the
+ *  grain size.  The counter, when passed, reaches zero once
+ *  every range is done.
+ ***********************************************************/
+void JobSystem::ParallelFor(JOB_FUNCTION function, void* pOwner, size_t count, size_t grainSize, JOB_COUNTER* pCounter)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	JOB job;
+	job.function = function;
+	job.pOwner = pOwner;
+	job.first = 0;
+	job.count = count;
+	job.grainSize = std::max((size_t)1, grainSize);
+	job.pCounter = pCounter;
+	if (NULL != pCounter)
+	{
+		pCounter->pending.fetch_add(1);
+	}
+	PushJob(job);
+}
+
+/***********************************************************
+ *  ParallelForAfter()
+ *
+ *  This method is used for queueing a parallel for that is
+ *  held back until the dependency counter reaches zero.  The
+ *  counter of the job is raised straight away, so waiting on
+ *  it also waits for the dependency.
+ ***********************************************************/
+void JobSystem::ParallelForAfter(const JOB_COUNTER* pDependency, JOB_FUNCTION function, void* pOwner, size_t count, size_t grainSize, JOB_COUNTER* pCounter)
+{
+	if ((NULL == pDependency) || (count == 0))
+	{
+		ParallelFor(function, pOwner, count, grainSize, pCounter);
+		return;
+	}
+
+	WAITING_JOB waitingJob;
+	waitingJob.job.function = function;
+	waitingJob.job.pOwner = pOwner;
+	waitingJob.job.first = 0;
+	waitingJob.job.count = count;
+	waitingJob.job.grainSize = std::max((size_t)1, grainSize);
+	waitingJob.job.pCounter = pCounter;
+	waitingJob.pDependency = pDependency;
+	if (NULL != pCounter)
+	{
+		pCounter->pending.fetch_add(1);
+	}
+
+	// the waiting count is raised before the dependency is checked,
+	// and the last job of the dependency counts it down before the
+	// waiting count is checked, so one of them always queues the job
+	m_waitingCount.fetch_add(1);
+	std::lock_guard<std::mutex> lock(m_waitingLock);
+	if (pDependency->pending.load() == 0)
+	{
+		PushJob(waitingJob.job);
+		m_waitingCount.fetch_sub(1);
+	}
+	else
+	{
+		m_waitingJobs.push_back(waitingJob);
+	}
+}
+
+/***********************************************************
+ *  Wait()
+ *
+ *  This method is used for running queued jobs on the
+ *  calling thread until the counter reaches zero.
+ ***********************************************************/
+void JobSystem::Wait(const JOB_COUNTER* pCounter)
+{
+	int threadIndex = GetThreadIndex();
+	while (pCounter->pending.load() > 0)
+	{
+		JOB job;
+		if (PopJob(threadIndex, job) == true)
+		{
+			ExecuteJob(job);
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+/***********************************************************
+ *  GetThreadCount()
+ *
+ *  This method is used for getting the number of threads
+ *  that run jobs, including the one that created the job
+ *  system.
+ ***********************************************************/
+int JobSystem::GetThreadCount() const
+{
+	return(m_threadCount);
+}
+
+/***********************************************************
+ *  GetThreadIndex()
+ *
+ *  This method is used for getting the index of the calling
+ *  thread, which is 0 for any thread that is not one of the
+ *  workers of this job system.
+ ***********************************************************/
+int JobSystem::GetThreadIndex() const
+{
+	return((g_pThreadJobSystem == this) ? g_threadIndex : 0);
+}
+
+/***********************************************************
+ *  GetExecutedCount()
+ *
+ *  This method is used for getting the number of jobs run
+ *  since the last reset, counting every split range.
+ ***********************************************************/
+unsigned long long JobSystem::GetExecutedCount() const
+{
+	return(m_executedCount.load());
+}
+
+/***********************************************************
+ *  GetStolenCount()
+ *
+ *  This method is used for getting the number of jobs taken
+ *  from the queue of another thread since the last reset.
+ ***********************************************************/
+unsigned long long JobSystem::GetStolenCount() const
+{
+	return(m_stolenCount.load());
+}
+
+/***********************************************************
+ *  ResetCounters()
+ *
+ *  This method is used for clearing the jobs run and the
+ *  jobs stolen.
+ ***********************************************************/
+void JobSystem::ResetCounters()
+{
+	m_executedCount.store(0);
+	m_stolenCount.store(0);
+}
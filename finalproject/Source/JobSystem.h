@@ -0,0 +1,139 @@
+///////////////////////////////////////////////////////////////////////////////
+// jobsystem.h
+// ============
+// run engine tasks on a pool of worker threads that steal work from each other
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/***********************************************************
+ *  JobSystem
+ *
+ *  This class contains the code for running jobs on worker
+ *  threads that live as long as the job system.  Every
+ *  thread has its own queue: it adds and takes its jobs at
+ *  the back, and when its queue is empty it steals from the
+ *  front of the others, where the largest ranges are.  The
+ *  queues are ring buffers sized when the job system is
+ *  created, so queueing a job does not allocate.  A job
+ *  is a function called on a range of items, and ranges
+ *  larger than the grain size are split in half as they
+ *  run, so idle threads can steal the other half.  Each job
+ *  counts down a counter when it finishes, which a thread
+ *  can wait on while running jobs itself, and jobs can be
+ *  held back until a counter reaches zero.  The thread that
+ *  creates the job system is thread 0 and only runs jobs
+ *  while it waits.
+ ***********************************************************/
+class JobSystem
+{
+public:
+	// function a job calls on its range of items
+	typedef void (*JOB_FUNCTION)(void* pOwner, size_t first, size_t count);
+
+	// number of unfinished jobs, which is zero when all are done
+	struct JOB_COUNTER
+	{
+		JOB_COUNTER();
+		std::atomic<int> pending;
+	};
+
+	// constructor, with the number of threads including the calling one
+	JobSystem(int threadCount);
+	// destructor
+	~JobSystem();
+
+private:
+	// range of items to call a job function on
+	struct JOB
+	{
+		JOB_FUNCTION function;
+		void* pOwner;
+		size_t first;
+		size_t count;
+		size_t grainSize;
+		JOB_COUNTER* pCounter;
+	};
+
+	// job held back until its dependency counter reaches zero
+	struct WAITING_JOB
+	{
+		JOB job;
+		const JOB_COUNTER* pDependency;
+	};
+
+	// queue of the jobs added by one thread, a ring buffer of jobs
+	// whose capacity is a power of two
+	struct JOB_QUEUE
+	{
+		std::mutex lock;
+		JOB* pJobs;
+		size_t capacity;
+		size_t head;
+		size_t count;
+	};
+
+	// jobs each queue has room for before it must grow
+	static const size_t QUEUE_CAPACITY = 1024;
+
+	int m_threadCount;
+	JOB_QUEUE* m_queues;
+	std::vector<std::thread> m_threads;
+	std::atomic<bool> m_bRunning;
+	// jobs in all the queues, and the workers asleep waiting for one
+	std::atomic<int> m_queuedJobs;
+	std::atomic<int> m_sleepingWorkers;
+	std::mutex m_sleepLock;
+	std::condition_variable m_wakeCondition;
+	// jobs held back by their dependencies
+	std::mutex m_waitingLock;
+	std::vector<WAITING_JOB> m_waitingJobs;
+	std::atomic<int> m_waitingCount;
+	// jobs run and jobs taken from the queue of another thread
+	std::atomic<unsigned long long> m_executedCount;
+	std::atomic<unsigned long long> m_stolenCount;
+
+	// loop of each worker thread
+	void WorkerLoop(int threadIndex);
+	// add a job to the queue of the calling thread
+	void PushJob(const JOB& job);
+	// take a job from the own queue or steal one from another
+	bool PopJob(int threadIndex, JOB& job);
+	// double the capacity of a full queue
+	static void GrowQueue(JOB_QUEUE& queue);
+	// split, run and count down one job
+	void ExecuteJob(JOB job);
+	// add the held back jobs whose dependencies are done
+	void ReleaseWaitingJobs();
+
+public:
+	// run a function once on item 0
+	void Run(JOB_FUNCTION function, void* pOwner, JOB_COUNTER* pCounter);
+	// run a function on the items 0 to count, split into ranges no
+	// larger than the grain size
+	void ParallelFor(JOB_FUNCTION function, void* pOwner, size_t count, size_t grainSize, JOB_COUNTER* pCounter);
+	// the same, started once the dependency counter reaches zero - the
+	// dependency must stay alive until the job has started
+	void ParallelForAfter(const JOB_COUNTER* pDependency, JOB_FUNCTION function, void* pOwner, size_t count, size_t grainSize, JOB_COUNTER* pCounter);
+	// run jobs until the counter reaches zero
+	void Wait(const JOB_COUNTER* pCounter);
+
+	// get the number of threads, including the creating one
+	int GetThreadCount() const;
+	// get the index of the calling thread, 0 for any thread that
+	// is not a worker of this job system
+	int GetThreadIndex() const;
+	// get and clear the jobs run and the jobs stolen
+	unsigned long long GetExecutedCount() const;
+	unsigned long long GetStolenCount() const;
+	void ResetCounters();
+};
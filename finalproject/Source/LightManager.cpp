@@ -0,0 +1,746 @@
+///////////////////////////////////////////////////////////////////////////////
+// lightmanager.cpp
+// ============
+// manage the buffered scene lights - point and spot lights with finite radii
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "LightManager.h"
+
+#include <cmath>
+#include <algorithm>
+
+// declare the global variables
+namespace
+{
+	const char* g_ObjectLightCountName = "objectLightCount";
+	const char* g_ObjectLightIndicesName = "objectLightIndices";
+	// directional light names, set every frame by the deferred and
+	// visibility resolves, built once so they never allocate
+	const std::string g_DirectionalDirectionName = "directionalLight.direction";
+	const std::string g_DirectionalAmbientName = "directionalLight.ambient";
+	const std::string g_DirectionalDiffuseName = "directionalLight.diffuse";
+	const std::string g_DirectionalSpecularName = "directionalLight.specular";
+	const std::string g_DirectionalActiveName = "directionalLight.bActive";
+
+	// preferred size of the light grid cells, in world units
+	const float LIGHT_GRID_CELL_SIZE = 2.0f;
+	// most light grid cells along one axis
+	const int MAX_LIGHT_GRID_SIZE = 32;
+	// most unchanged lights copied along to join two changed ones
+	// into one buffer range, instead of writing a range for each
+	const int LIGHT_UPLOAD_GAP = 4;
+}
+
+/***********************************************************
+ *  LightManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+LightManager::LightManager()
+{
+	m_directionalLight.direction = glm::vec3(0.0f, -1.0f, 0.0f);
+	m_directionalLight.ambient = glm::vec3(0.0f);
+	m_directionalLight.diffuse = glm::vec3(0.0f);
+	m_directionalLight.specular = glm::vec3(0.0f);
+	m_directionalLight.bActive = false;
+	m_lightBuffer = 0;
+	m_lightBufferCapacity = 0;
+	m_bAllLightsDirty = true;
+	m_lastUploadBytes = 0;
+	m_lastUploadRanges = 0;
+	m_gridMin = glm::vec3(0.0f);
+	m_gridCellSize = LIGHT_GRID_CELL_SIZE;
+	m_gridSize[0] = 0;
+	m_gridSize[1] = 0;
+	m_gridSize[2] = 0;
+	m_queryNumber = 0;
+	m_objectLightProgram = 0;
+	m_objectLightCountLocation = -1;
+	m_objectLightIndicesLocation = -1;
+	m_objectLightTotal = 0;
+	m_objectCount = 0;
+}
+
+/***********************************************************
+ *  ~LightManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+LightManager::~LightManager()
+{
+	// free the OpenGL buffer
+	DestroyBuffers();
+}
+
+/***********************************************************
+ *  CreateBuffers()
+ *
+ *  This method is used for creating the shader storage
+ *  buffer that holds the point and spot lights.
+ ***********************************************************/
+void LightManager::CreateBuffers()
+{
+	glGenBuffers(1, &m_lightBuffer);
+}
+
+/***********************************************************
+ *  DestroyBuffers()
+ *
+ *  This method is used for freeing the shader storage
+ *  buffer.
+ ***********************************************************/
+void LightManager::DestroyBuffers()
+{
+	if (m_lightBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_lightBuffer);
+		m_lightBuffer = 0;
+	}
+	m_lightBufferCapacity = 0;
+}
+
+/***********************************************************
+ *  SetDirectionalLight()
+ *
+ *  This method is used for setting the directional light
+ *  that lights the entire scene.
+ ***********************************************************/
+void LightManager::SetDirectionalLight(
+	glm::vec3 direction,
+	glm::vec3 ambient,
+	glm::vec3 diffuse,
+	glm::vec3 specular)
+{
+	m_directionalLight.direction = direction;
+	m_directionalLight.ambient = ambient;
+	m_directionalLight.diffuse = diffuse;
+	m_directionalLight.specular = specular;
+	m_directionalLight.bActive = true;
+}
+
+/***********************************************************
+ *  GetDirectionalLight()
+ *
+ *  This method is used for getting the directional light.
+ ***********************************************************/
+const LightManager::DIRECTIONAL_LIGHT& LightManager::GetDirectionalLight() const
+{
+	return(m_directionalLight);
+}
+
+/***********************************************************
+ *  ClearLights()
+ *
+ *  This method is used for removing all of the point and
+ *  spot lights.
+ ***********************************************************/
+void LightManager::ClearLights()
+{
+	m_lights.clear();
+	m_dirtyLights.clear();
+	m_bAllLightsDirty = true;
+	m_keyframes.clear();
+	m_tracks.clear();
+	// the grid refers to the removed lights until it is built again
+	m_cellStarts.clear();
+	m_cellLights.clear();
+}
+
+/***********************************************************
+ *  AddPointLight()
+ *
+ *  This method is used for adding a point light that only
+ *  lights the fragments inside of its radius.
+ ***********************************************************/
+int LightManager::AddPointLight(
+	glm::vec3 position,
+	float radius,
+	glm::vec3 color,
+	float specularScale)
+{
+	GPU_LIGHT light;
+
+	light.positionRadius = glm::vec4(position, radius);
+	light.colorType = glm::vec4(color, (float)LIGHT_POINT);
+	light.directionCutOff = glm::vec4(0.0f, -1.0f, 0.0f, -1.0f);
+	light.spotParams = glm::vec4(-1.0f, specularScale, 0.0f, 0.0f);
+	m_lights.push_back(light);
+	m_dirtyLights.push_back(1);
+
+	return((int)m_lights.size() - 1);
+}
+
+/***********************************************************
+ *  AddSpotLight()
+ *
+ *  This method is used for adding a spot light that only
+ *  lights the fragments inside of its radius and cone.
+ ***********************************************************/
+int LightManager::AddSpotLight(
+	glm::vec3 position,
+	glm::vec3 direction,
+	float radius,
+	float innerCutOffDegrees,
+	float outerCutOffDegrees,
+	glm::vec3 color,
+	float specularScale)
+{
+	GPU_LIGHT light;
+
+	light.positionRadius = glm::vec4(position, radius);
+	light.colorType = glm::vec4(color, (float)LIGHT_SPOT);
+	light.directionCutOff = glm::vec4(
+		glm::normalize(direction),
+		std::cos(glm::radians(innerCutOffDegrees)));
+	light.spotParams = glm::vec4(
+		std::cos(glm::radians(outerCutOffDegrees)),
+		specularScale, 0.0f, 0.0f);
+	m_lights.push_back(light);
+	m_dirtyLights.push_back(1);
+
+	return((int)m_lights.size() - 1);
+}
+
+/***********************************************************
+ *  SetLightPosition()
+ *
+ *  This method is used for moving a previously added light.
+ ***********************************************************/
+void LightManager::SetLightPosition(int index, glm::vec3 position)
+{
+	if ((index < 0) || (index >= (int)m_lights.size()))
+	{
+		return;
+	}
+
+	glm::vec4& positionRadius = m_lights[index].positionRadius;
+	if ((positionRadius.x != position.x) ||
+		(positionRadius.y != position.y) ||
+		(positionRadius.z != position.z))
+	{
+		positionRadius.x = position.x;
+		positionRadius.y = position.y;
+		positionRadius.z = position.z;
+		MarkLightDirty(index);
+	}
+}
+
+/***********************************************************
+ *  SetLightColor()
+ *
+ *  This method is used for changing the color of a
+ *  previously added light.
+ ***********************************************************/
+void LightManager::SetLightColor(int index, glm::vec3 color)
+{
+	if ((index < 0) || (index >= (int)m_lights.size()))
+	{
+		return;
+	}
+
+	glm::vec4& colorType = m_lights[index].colorType;
+	if ((colorType.r != color.r) ||
+		(colorType.g != color.g) ||
+		(colorType.b != color.b))
+	{
+		colorType.r = color.r;
+		colorType.g = color.g;
+		colorType.b = color.b;
+		MarkLightDirty(index);
+	}
+}
+
+/***********************************************************
+ *  MarkLightDirty()
+ *
+ *  This method is used for marking a light that changed, so
+ *  that the next upload copies it into the light buffer.
+ ***********************************************************/
+void LightManager::MarkLightDirty(int index)
+{
+	m_dirtyLights[index] = 1;
+}
+
+/***********************************************************
+ *  GetLightCount()
+ *
+ *  This method is used for getting the number of point and
+ *  spot lights.
+ ***********************************************************/
+int LightManager::GetLightCount() const
+{
+	return((int)m_lights.size());
+}
+
+/***********************************************************
+ *  GetLights()
+ *
+ *  This method is used for getting all of the point and spot
+ *  lights.
+ ***********************************************************/
+const std::vector<LightManager::GPU_LIGHT>& LightManager::GetLights() const
+{
+	return(m_lights);
+}
+
+/***********************************************************
+ *  AddLightAnimation()
+ *
+ *  This method is used for animating a light through the
+ *  passed in keyframes, which must be sorted by time.  The
+ *  animation loops after the last keyframe, and the time
+ *  offset lets lights share keyframes without moving in
+ *  step.  A keyframe repeated at a later time holds the
+ *  light still, and a still light is not uploaded again.
+ ***********************************************************/
+void LightManager::AddLightAnimation(
+	int index,
+	const std::vector<LIGHT_KEYFRAME>& keyframes,
+	float timeOffset)
+{
+	if ((index < 0) || (index >= (int)m_lights.size()) || (keyframes.empty() == true))
+	{
+		return;
+	}
+
+	LIGHT_TRACK track;
+	track.lightIndex = index;
+	track.firstKeyframe = (int)m_keyframes.size();
+	track.keyframeCount = (int)keyframes.size();
+	track.timeOffset = timeOffset;
+	track.cursor = 0;
+	m_keyframes.insert(m_keyframes.end(), keyframes.begin(), keyframes.end());
+	m_tracks.push_back(track);
+}
+
+/***********************************************************
+ *  AnimateLights()
+ *
+ *  This method is used for placing every animated light for
+ *  the passed in time in one pass over the tracks.  Each
+ *  track remembers the keyframe it was last at, so moving
+ *  forward in time only steps past the keyframes that were
+ *  reached since the last frame.
+ ***********************************************************/
+void LightManager::AnimateLights(float time)
+{
+	for (size_t i = 0; i < m_tracks.size(); i++)
+	{
+		LIGHT_TRACK& track = m_tracks[i];
+		const LIGHT_KEYFRAME* keyframes = &m_keyframes[track.firstKeyframe];
+		int lastKeyframe = track.keyframeCount - 1;
+		float duration = keyframes[lastKeyframe].time;
+
+		// wrap the time into the loop of the track
+		float localTime = 0.0f;
+		if (duration > 0.0f)
+		{
+			localTime = std::fmod(time + track.timeOffset, duration);
+			if (localTime < 0.0f)
+			{
+				localTime += duration;
+			}
+		}
+
+		// find the keyframe that the time is after
+		if (keyframes[track.cursor].time > localTime)
+		{
+			track.cursor = 0;
+		}
+		while ((track.cursor < lastKeyframe) && (keyframes[track.cursor + 1].time <= localTime))
+		{
+			track.cursor++;
+		}
+
+		// blend towards the next keyframe
+		const LIGHT_KEYFRAME& current = keyframes[track.cursor];
+		if (track.cursor == lastKeyframe)
+		{
+			SetLightPosition(track.lightIndex, current.position);
+			SetLightColor(track.lightIndex, current.color);
+			continue;
+		}
+		const LIGHT_KEYFRAME& next = keyframes[track.cursor + 1];
+		float blend = 0.0f;
+		if (next.time > current.time)
+		{
+			blend = glm::clamp((localTime - current.time) / (next.time - current.time), 0.0f, 1.0f);
+		}
+		SetLightPosition(track.lightIndex, glm::mix(current.position, next.position, blend));
+		SetLightColor(track.lightIndex, glm::mix(current.color, next.color, blend));
+	}
+}
+
+/***********************************************************
+ *  UploadLights()
+ *
+ *  This method is used for copying the point and spot lights
+ *  that changed since the last upload into the shader
+ *  storage buffer.  Neighbouring changed lights are copied
+ *  together as one range.  The buffer is reallocated with
+ *  extra room so that it is not resized every frame, and
+ *  every light is copied after it is.
+ ***********************************************************/
+void LightManager::UploadLights()
+{
+	size_t lightBytes = m_lights.size() * sizeof(GPU_LIGHT);
+
+	m_lastUploadBytes = 0;
+	m_lastUploadRanges = 0;
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_lightBuffer);
+	if ((lightBytes > m_lightBufferCapacity) || (m_lightBufferCapacity == 0))
+	{
+		m_lightBufferCapacity = std::max(lightBytes * 2, sizeof(GPU_LIGHT));
+		glBufferData(GL_SHADER_STORAGE_BUFFER, m_lightBufferCapacity, NULL, GL_DYNAMIC_DRAW);
+		m_bAllLightsDirty = true;
+	}
+
+	if (m_bAllLightsDirty == true)
+	{
+		if (lightBytes > 0)
+		{
+			glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, lightBytes, m_lights.data());
+			m_lastUploadBytes = lightBytes;
+			m_lastUploadRanges = 1;
+		}
+	}
+	else
+	{
+		int lightCount = (int)m_lights.size();
+		int i = 0;
+
+		while (i < lightCount)
+		{
+			if (m_dirtyLights[i] == 0)
+			{
+				i++;
+				continue;
+			}
+
+			// extend the range over the changed lights that follow
+			// closely enough
+			int first = i;
+			int last = i;
+			for (int j = i + 1; (j < lightCount) && (j - last <= LIGHT_UPLOAD_GAP); j++)
+			{
+				if (m_dirtyLights[j] != 0)
+				{
+					last = j;
+				}
+			}
+
+			size_t rangeBytes = (size_t)(last - first + 1) * sizeof(GPU_LIGHT);
+			glBufferSubData(GL_SHADER_STORAGE_BUFFER,
+				first * sizeof(GPU_LIGHT), rangeBytes, &m_lights[first]);
+			m_lastUploadBytes += rangeBytes;
+			m_lastUploadRanges++;
+			i = last + 1;
+		}
+	}
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	std::fill(m_dirtyLights.begin(), m_dirtyLights.end(), 0);
+	m_bAllLightsDirty = false;
+}
+
+/***********************************************************
+ *  GetLastUploadBytes()
+ *
+ *  This method is used for getting the number of bytes the
+ *  last upload copied into the light buffer.
+ ***********************************************************/
+size_t LightManager::GetLastUploadBytes() const
+{
+	return(m_lastUploadBytes);
+}
+
+/***********************************************************
+ *  GetLastUploadRanges()
+ *
+ *  This method is used for getting the number of buffer
+ *  ranges the last upload wrote.
+ ***********************************************************/
+int LightManager::GetLastUploadRanges() const
+{
+	return(m_lastUploadRanges);
+}
+
+/***********************************************************
+ *  BindLights()
+ *
+ *  This method is used for binding the light buffer to its
+ *  shader storage binding point.  The buffer is allocated
+ *  larger than needed, so the shaders get the light count.
+ *  The passed in shader must be in use, and it is the one
+ *  the object light lists are set into, so the uniforms of
+ *  the lists are looked up here instead of for every object.
+ ***********************************************************/
+void LightManager::BindLights(ShaderManager* pShaderManager)
+{
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, LIGHT_BUFFER_BINDING, m_lightBuffer);
+
+	if (NULL != pShaderManager)
+	{
+		pShaderManager->setIntValue("lightCount", (int)m_lights.size());
+
+		// the uniform locations are only looked up when the shader changes
+		GLint program = 0;
+		glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+		if (program != m_objectLightProgram)
+		{
+			m_objectLightProgram = program;
+			m_objectLightCountLocation = glGetUniformLocation(program, g_ObjectLightCountName);
+			m_objectLightIndicesLocation = glGetUniformLocation(program, g_ObjectLightIndicesName);
+		}
+	}
+}
+
+/***********************************************************
+ *  SetDirectionalLightUniforms()
+ *
+ *  This method is used for passing the directional light
+ *  into a shader that does not get the scene light setup.
+ ***********************************************************/
+void LightManager::SetDirectionalLightUniforms(ShaderManager* pShaderManager)
+{
+	if (NULL == pShaderManager)
+	{
+		return;
+	}
+
+	pShaderManager->setVec3Value(g_DirectionalDirectionName, m_directionalLight.direction);
+	pShaderManager->setVec3Value(g_DirectionalAmbientName, m_directionalLight.ambient);
+	pShaderManager->setVec3Value(g_DirectionalDiffuseName, m_directionalLight.diffuse);
+	pShaderManager->setVec3Value(g_DirectionalSpecularName, m_directionalLight.specular);
+	pShaderManager->setBoolValue(g_DirectionalActiveName, m_directionalLight.bActive);
+}
+
+/***********************************************************
+ *  BuildLightGrid()
+ *
+ *  This method is used for sorting the point and spot lights
+ *  into a uniform grid over the bounds of all their radii.
+ *  Each light is listed in every cell that the box around its
+ *  radius overlaps, so that the lights near an object are
+ *  found without testing all of them.  The grid must be
+ *  built again after the lights are moved.
+ ***********************************************************/
+void LightManager::BuildLightGrid()
+{
+	m_cellStarts.clear();
+	m_cellLights.clear();
+	m_lightQueries.assign(m_lights.size(), 0);
+	m_queryNumber = 0;
+	m_objectLightTotal = 0;
+	m_objectCount = 0;
+
+	if (m_lights.empty() == true)
+	{
+		return;
+	}
+
+	// find the bounds of all the light radii
+	glm::vec3 boundsMin = glm::vec3(m_lights[0].positionRadius) - m_lights[0].positionRadius.w;
+	glm::vec3 boundsMax = glm::vec3(m_lights[0].positionRadius) + m_lights[0].positionRadius.w;
+	for (size_t i = 1; i < m_lights.size(); i++)
+	{
+		glm::vec3 position = glm::vec3(m_lights[i].positionRadius);
+		float radius = m_lights[i].positionRadius.w;
+
+		boundsMin = glm::min(boundsMin, position - radius);
+		boundsMax = glm::max(boundsMax, position + radius);
+	}
+
+	// grow the cells when the lights are spread too far apart
+	glm::vec3 extent = boundsMax - boundsMin;
+	float largestExtent = std::max(extent.x, std::max(extent.y, extent.z));
+	m_gridMin = boundsMin;
+	m_gridCellSize = std::max(LIGHT_GRID_CELL_SIZE, largestExtent / (float)MAX_LIGHT_GRID_SIZE);
+	for (int axis = 0; axis < 3; axis++)
+	{
+		m_gridSize[axis] = (int)std::ceil(extent[axis] / m_gridCellSize);
+		m_gridSize[axis] = std::min(std::max(m_gridSize[axis], 1), MAX_LIGHT_GRID_SIZE);
+	}
+	int cellTotal = m_gridSize[0] * m_gridSize[1] * m_gridSize[2];
+
+	// count the lights of every cell, then place them after the
+	// lights of the cells before it
+	m_cellStarts.assign(cellTotal + 1, 0);
+	for (int pass = 0; pass < 2; pass++)
+	{
+		if (pass == 1)
+		{
+			for (int cell = 0; cell < cellTotal; cell++)
+			{
+				m_cellStarts[cell + 1] += m_cellStarts[cell];
+			}
+			m_cellLights.resize(m_cellStarts[cellTotal]);
+			m_cellCursors.assign(m_cellStarts.begin(), m_cellStarts.end() - 1);
+		}
+
+		for (size_t i = 0; i < m_lights.size(); i++)
+		{
+			glm::vec3 position = glm::vec3(m_lights[i].positionRadius);
+			float radius = m_lights[i].positionRadius.w;
+			int cellMin[3];
+			int cellMax[3];
+
+			FindGridCells(position - radius, position + radius, cellMin, cellMax);
+			for (int z = cellMin[2]; z <= cellMax[2]; z++)
+			{
+				for (int y = cellMin[1]; y <= cellMax[1]; y++)
+				{
+					for (int x = cellMin[0]; x <= cellMax[0]; x++)
+					{
+						int cell = x + (y * m_gridSize[0]) + (z * m_gridSize[0] * m_gridSize[1]);
+						if (pass == 0)
+						{
+							m_cellStarts[cell + 1]++;
+						}
+						else
+						{
+							m_cellLights[m_cellCursors[cell]++] = (int)i;
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  FindGridCells()
+ *
+ *  This method is used for getting the range of light grid
+ *  cells that a world box overlaps.  Boxes outside of the
+ *  grid are clamped to the closest cells.
+ ***********************************************************/
+void LightManager::FindGridCells(glm::vec3 boundsMin, glm::vec3 boundsMax, int cellMin[3], int cellMax[3]) const
+{
+	for (int axis = 0; axis < 3; axis++)
+	{
+		int first = (int)std::floor((boundsMin[axis] - m_gridMin[axis]) / m_gridCellSize);
+		int last = (int)std::floor((boundsMax[axis] - m_gridMin[axis]) / m_gridCellSize);
+
+		cellMin[axis] = std::min(std::max(first, 0), m_gridSize[axis] - 1);
+		cellMax[axis] = std::min(std::max(last, 0), m_gridSize[axis] - 1);
+	}
+}
+
+/***********************************************************
+ *  FindLights()
+ *
+ *  This method is used for finding the point and spot lights
+ *  whose influence radius overlaps the passed in world box.
+ *  Only the lights in the grid cells of the box are tested.
+ ***********************************************************/
+void LightManager::FindLights(glm::vec3 boundsMin, glm::vec3 boundsMax, std::vector<int>& indices)
+{
+	indices.clear();
+	if ((m_cellStarts.empty() == true) || (m_lightQueries.size() != m_lights.size()))
+	{
+		return;
+	}
+
+	// start over when the query numbers wrap around
+	m_queryNumber++;
+	if (m_queryNumber == 0)
+	{
+		std::fill(m_lightQueries.begin(), m_lightQueries.end(), 0);
+		m_queryNumber = 1;
+	}
+
+	int cellMin[3];
+	int cellMax[3];
+	FindGridCells(boundsMin, boundsMax, cellMin, cellMax);
+	for (int z = cellMin[2]; z <= cellMax[2]; z++)
+	{
+		for (int y = cellMin[1]; y <= cellMax[1]; y++)
+		{
+			for (int x = cellMin[0]; x <= cellMax[0]; x++)
+			{
+				int cell = x + (y * m_gridSize[0]) + (z * m_gridSize[0] * m_gridSize[1]);
+				for (int i = m_cellStarts[cell]; i < m_cellStarts[cell + 1]; i++)
+				{
+					int index = m_cellLights[i];
+					if (m_lightQueries[index] == m_queryNumber)
+					{
+						continue;
+					}
+					m_lightQueries[index] = m_queryNumber;
+
+					// distance from the light to the closest point of the box
+					glm::vec3 position = glm::vec3(m_lights[index].positionRadius);
+					float radius = m_lights[index].positionRadius.w;
+					glm::vec3 closest = glm::clamp(position, boundsMin, boundsMax);
+					glm::vec3 offset = position - closest;
+					if (glm::dot(offset, offset) <= radius * radius)
+					{
+						indices.push_back(index);
+					}
+				}
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  SetObjectLights()
+ *
+ *  This method is used for setting the lights that reach the
+ *  world bounds of the next object into the shader the
+ *  lights were last bound to, which must still be in use,
+ *  so that its fragments only loop over those lights.  An
+ *  object reached by more than MAX_OBJECT_LIGHTS lights gets
+ *  a count of -1 and evaluates every light instead.  Shaders
+ *  without object light lists are left alone.
+ ***********************************************************/
+void LightManager::SetObjectLights(glm::vec3 boundsMin, glm::vec3 boundsMax)
+{
+	if ((m_objectLightProgram == 0) || (m_objectLightCountLocation < 0))
+	{
+		return;
+	}
+
+	FindLights(boundsMin, boundsMax, m_objectLights);
+	int count = (int)m_objectLights.size();
+	if (count > MAX_OBJECT_LIGHTS)
+	{
+		glUniform1i(m_objectLightCountLocation, -1);
+		m_objectLightTotal += (int)m_lights.size();
+	}
+	else
+	{
+		// the indices are packed four to a uniform vector
+		int vectorCount = (count + 3) / 4;
+		m_objectLights.resize(vectorCount * 4, 0);
+		if (vectorCount > 0)
+		{
+			glUniform4iv(m_objectLightIndicesLocation, vectorCount, m_objectLights.data());
+		}
+		glUniform1i(m_objectLightCountLocation, count);
+		m_objectLightTotal += count;
+	}
+	m_objectCount++;
+}
+
+/***********************************************************
+ *  GetAverageObjectLights()
+ *
+ *  This method is used for getting the average number of
+ *  lights evaluated for each object since the light grid was
+ *  last built.
+ ***********************************************************/
+float LightManager::GetAverageObjectLights() const
+{
+	if (m_objectCount == 0)
+	{
+		return(0.0f);
+	}
+
+	return((float)m_objectLightTotal / (float)m_objectCount);
+}
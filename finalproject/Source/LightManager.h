@@ -0,0 +1,204 @@
+///////////////////////////////////////////////////////////////////////////////
+// lightmanager.h
+// ============
+// manage the buffered scene lights - point and spot lights with finite radii
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+
+#include <vector>
+
+/***********************************************************
+ *  LightManager
+ *
+ *  This class contains the code for storing the directional
+ *  light and any number of point and spot lights, and for
+ *  uploading the point and spot lights into a shader storage
+ *  buffer that the lighting shaders read from.
+ ***********************************************************/
+class LightManager
+{
+public:
+	// constructor
+	LightManager();
+	// destructor
+	~LightManager();
+
+	// light types stored in the light buffer
+	enum LIGHT_TYPE
+	{
+		LIGHT_POINT = 0,
+		LIGHT_SPOT = 1
+	};
+
+	// light record laid out to match the std430 light buffer
+	struct GPU_LIGHT
+	{
+		glm::vec4 positionRadius;    // xyz = world position, w = influence radius
+		glm::vec4 colorType;         // rgb = diffuse color, w = LIGHT_TYPE
+		glm::vec4 directionCutOff;   // xyz = spot direction, w = cosine of inner cone
+		glm::vec4 spotParams;        // x = cosine of outer cone, y = specular scale
+	};
+
+	// position and color of an animated light at one point in time
+	struct LIGHT_KEYFRAME
+	{
+		float time;
+		glm::vec3 position;
+		glm::vec3 color;
+	};
+
+	struct DIRECTIONAL_LIGHT
+	{
+		glm::vec3 direction;
+		glm::vec3 ambient;
+		glm::vec3 diffuse;
+		glm::vec3 specular;
+		bool bActive;
+	};
+
+	// shader storage buffer binding point of the light buffer
+	static const int LIGHT_BUFFER_BINDING = 0;
+	// most lights in the light list of one object, must match the shaders
+	static const int MAX_OBJECT_LIGHTS = 128;
+
+private:
+	// the single directional light
+	DIRECTIONAL_LIGHT m_directionalLight;
+	// point and spot lights stored in the light buffer
+	std::vector<GPU_LIGHT> m_lights;
+	// OpenGL shader storage buffer
+	GLuint m_lightBuffer;
+	// allocated size of the light buffer
+	size_t m_lightBufferCapacity;
+	// true for each light changed since it was last uploaded
+	std::vector<unsigned char> m_dirtyLights;
+	// true when every light must be uploaded, like after the
+	// buffer was allocated again
+	bool m_bAllLightsDirty;
+	// bytes and buffer ranges written by the last upload
+	size_t m_lastUploadBytes;
+	int m_lastUploadRanges;
+
+	// keyframes of one animated light, looped over their duration
+	struct LIGHT_TRACK
+	{
+		int lightIndex;
+		int firstKeyframe;
+		int keyframeCount;
+		float timeOffset;
+		// keyframe that the last evaluated time was after
+		int cursor;
+	};
+	// keyframes of all the tracks, each track's are kept together
+	std::vector<LIGHT_KEYFRAME> m_keyframes;
+	// animated lights, in the order they were added
+	std::vector<LIGHT_TRACK> m_tracks;
+
+	// world position of the first light grid cell and the cell size
+	glm::vec3 m_gridMin;
+	float m_gridCellSize;
+	// number of light grid cells along each axis
+	int m_gridSize[3];
+	// first entry of each cell in the cell lights, one extra at the end
+	std::vector<int> m_cellStarts;
+	// indices of the lights overlapping each cell
+	std::vector<int> m_cellLights;
+	// next free entry of each cell while the cell lights are placed,
+	// kept so that the grid is rebuilt without allocating
+	std::vector<int> m_cellCursors;
+	// query number each light was last found by, so that a light
+	// spanning several cells is only listed once
+	std::vector<unsigned int> m_lightQueries;
+	unsigned int m_queryNumber;
+	// light list of the current object, four indices per uniform
+	std::vector<int> m_objectLights;
+	// shader program the lights were last bound to, and the uniform
+	// locations of its object light lists
+	GLint m_objectLightProgram;
+	GLint m_objectLightCountLocation;
+	GLint m_objectLightIndicesLocation;
+	// lights listed and objects drawn since the grid was built
+	int m_objectLightTotal;
+	int m_objectCount;
+
+	// mark a light to be copied by the next upload
+	void MarkLightDirty(int index);
+	// get the range of light grid cells overlapped by a box
+	void FindGridCells(glm::vec3 boundsMin, glm::vec3 boundsMax, int cellMin[3], int cellMax[3]) const;
+
+public:
+	// create the OpenGL shader storage buffer
+	void CreateBuffers();
+	// free the OpenGL shader storage buffer
+	void DestroyBuffers();
+
+	// set the directional light
+	void SetDirectionalLight(
+		glm::vec3 direction,
+		glm::vec3 ambient,
+		glm::vec3 diffuse,
+		glm::vec3 specular);
+	// get the directional light
+	const DIRECTIONAL_LIGHT& GetDirectionalLight() const;
+
+	// remove all the point and spot lights
+	void ClearLights();
+	// add a light and get its index
+	int AddPointLight(
+		glm::vec3 position,
+		float radius,
+		glm::vec3 color,
+		float specularScale);
+	int AddSpotLight(
+		glm::vec3 position,
+		glm::vec3 direction,
+		float radius,
+		float innerCutOffDegrees,
+		float outerCutOffDegrees,
+		glm::vec3 color,
+		float specularScale);
+	// move an existing light to a new position
+	void SetLightPosition(int index, glm::vec3 position);
+	// change the color of an existing light
+	void SetLightColor(int index, glm::vec3 color);
+	// get the current number of point and spot lights
+	int GetLightCount() const;
+	// get all of the point and spot lights
+	const std::vector<GPU_LIGHT>& GetLights() const;
+
+	// animate a light through keyframes sorted by time, which
+	// loop after the last one
+	void AddLightAnimation(
+		int index,
+		const std::vector<LIGHT_KEYFRAME>& keyframes,
+		float timeOffset);
+	// place all of the animated lights for the passed in time
+	void AnimateLights(float time);
+
+	// copy the lights changed since the last upload into the light buffer
+	void UploadLights();
+	// get the bytes copied into the light buffer by the last upload
+	size_t GetLastUploadBytes() const;
+	// get the number of buffer ranges written by the last upload
+	int GetLastUploadRanges() const;
+	// bind the light buffer and set the light count into the shader
+	void BindLights(ShaderManager* pShaderManager);
+	// set the directional light values into the shader
+	void SetDirectionalLightUniforms(ShaderManager* pShaderManager);
+
+	// sort the lights into a uniform grid by their influence bounds
+	void BuildLightGrid();
+	// find the lights whose influence radius overlaps a world box
+	void FindLights(glm::vec3 boundsMin, glm::vec3 boundsMax, std::vector<int>& indices);
+	// set the light list of the next object into the shader the
+	// lights were last bound to
+	void SetObjectLights(glm::vec3 boundsMin, glm::vec3 boundsMax);
+	// get the average light list length since the grid was built
+	float GetAverageObjectLights() const;
+};
@@ -0,0 +1,955 @@
+///////////////////////////////////////////////////////////////////////////////
+// lightmapbaker.cpp
+// ============
+// bake the static lighting of the scene into lightmaps on the CPU
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "LightmapBaker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+// declare the global variables
+namespace
+{
+	// number of texels a thread takes from the queue at a time
+	const size_t SAMPLES_PER_JOB = 64;
+	// most triangles stored in one leaf of the hierarchy
+	const uint32_t MAX_LEAF_TRIANGLES = 4;
+	// number of bins the triangles are sorted into for each split
+	const int SPLIT_BINS = 8;
+	// deepest level of the hierarchy, so traversal stacks cannot overflow
+	const int MAX_BVH_DEPTH = 48;
+	// distance the rays start off the surface to miss the surface itself
+	const float RAY_OFFSET = 0.001f;
+	const float PI = 3.14159265f;
+
+	// small random number generator, one per texel so that the
+	// result does not depend on how the texels were split up
+	struct RANDOM
+	{
+		uint32_t state;
+
+		explicit RANDOM(uint32_t seed)
+		{
+			// spread the bits of neighbouring seeds apart
+			seed ^= seed >> 16;
+			seed *= 0x7feb352dU;
+			seed ^= seed >> 15;
+			seed *= 0x846ca68bU;
+			seed ^= seed >> 16;
+			state = (seed == 0) ? 1U : seed;
+		}
+
+		float Next()
+		{
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			return((float)(state >> 8) * (1.0f / 16777216.0f));
+		}
+	};
+
+	// get a random direction around a normal, more likely the
+	// closer it is to the normal, as diffuse surfaces reflect light
+	glm::vec3 SampleCosineDirection(const glm::vec3& normal, RANDOM& random)
+	{
+		float angle = 2.0f * PI * random.Next();
+		float radius2 = random.Next();
+		float radius = std::sqrt(radius2);
+
+		// orthonormal basis around the normal
+		float sign = (normal.z >= 0.0f) ? 1.0f : -1.0f;
+		float a = -1.0f / (sign + normal.z);
+		float b = normal.x * normal.y * a;
+		glm::vec3 tangent = glm::vec3(1.0f + sign * normal.x * normal.x * a, sign * b, -sign * normal.x);
+		glm::vec3 bitangent = glm::vec3(b, sign + normal.y * normal.y * a, -normal.y);
+
+		return(glm::normalize(
+			(tangent * (radius * std::cos(angle))) +
+			(bitangent * (radius * std::sin(angle))) +
+			(normal * std::sqrt(std::max(0.0f, 1.0f - radius2)))));
+	}
+
+	// get the axis and direction of a normal as a box face index
+	int FindBoxFace(const glm::vec3& normal)
+	{
+		glm::vec3 size = glm::abs(normal);
+		int axis = 0;
+
+		if ((size.y > size.x) && (size.y >= size.z))
+		{
+			axis = 1;
+		}
+		else if ((size.z > size.x) && (size.z > size.y))
+		{
+			axis = 2;
+		}
+		return((axis * 2) + ((normal[axis] < 0.0f) ? 1 : 0));
+	}
+
+	// check whether a ray passes through a box before a distance
+	bool IntersectBox(
+		const glm::vec3& origin,
+		const glm::vec3& inverseDirection,
+		const glm::vec3& boundsMin,
+		const glm::vec3& boundsMax,
+		float maxDistance)
+	{
+		glm::vec3 t0 = (boundsMin - origin) * inverseDirection;
+		glm::vec3 t1 = (boundsMax - origin) * inverseDirection;
+		glm::vec3 tNear = glm::min(t0, t1);
+		glm::vec3 tFar = glm::max(t0, t1);
+		float enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+		float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+
+		return(enter <= exit);
+	}
+}
+
+/***********************************************************
+ *  LightmapBaker()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+LightmapBaker::LightmapBaker()
+{
+	m_atlasWidth = 0;
+	m_atlasHeight = 0;
+}
+
+/***********************************************************
+ *  ~LightmapBaker()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+LightmapBaker::~LightmapBaker()
+{
+}
+
+/***********************************************************
+ *  SetTriangles()
+ *
+ *  This method is used for passing in the vertices of the
+ *  scene triangles, three vertices for each triangle, in the
+ *  order that the objects were drawn.
+ ***********************************************************/
+void LightmapBaker::SetTriangles(const std::vector<BAKE_VERTEX>& vertices)
+{
+	m_vertices = vertices;
+}
+
+/***********************************************************
+ *  AddLight()
+ *
+ *  This method is used for adding a static light that is
+ *  baked into the lightmap.
+ ***********************************************************/
+void LightmapBaker::AddLight(const BAKE_LIGHT& light)
+{
+	m_lights.push_back(light);
+}
+
+/***********************************************************
+ *  Prepare()
+ *
+ *  This method is used for unwrapping the objects into the
+ *  atlas charts, finding the surface point of every texel
+ *  and building the ray tracing hierarchy, before baking.
+ ***********************************************************/
+bool LightmapBaker::Prepare()
+{
+	if (m_vertices.size() < 3)
+	{
+		return(false);
+	}
+
+	BuildCharts();
+	RasterizeCharts();
+	BuildBVH();
+
+	return(m_samples.size() > 0);
+}
+
+/***********************************************************
+ *  PrepareTracing()
+ *
+ *  This method is used for building only the ray tracing
+ *  hierarchy, when rays are traced without baking an atlas.
+ ***********************************************************/
+bool LightmapBaker::PrepareTracing()
+{
+	if (m_vertices.size() < 3)
+	{
+		return(false);
+	}
+
+	BuildBVH();
+
+	return(true);
+}
+
+/***********************************************************
+ *  BuildCharts()
+ *
+ *  This method is used for sizing the six charts of every
+ *  object from its object space box and its scale, so each
+ *  world unit gets the same number of texels, and packing
+ *  the charts into rows of the atlas, tallest first.
+ ***********************************************************/
+void LightmapBaker::BuildCharts()
+{
+	int drawCount = 0;
+	for (size_t i = 0; i < m_vertices.size(); i++)
+	{
+		drawCount = std::max(drawCount, (int)m_vertices[i].drawID + 1);
+	}
+
+	std::vector<glm::vec3> boxMax(drawCount, glm::vec3(-1e30f));
+	std::vector<glm::vec3> axisScale(drawCount, glm::vec3(1.0f));
+
+	m_drawCharts.assign(drawCount, DRAW_CHARTS());
+	for (int d = 0; d < drawCount; d++)
+	{
+		m_drawCharts[d].boxMin = glm::vec3(1e30f);
+		m_drawCharts[d].bBaked = false;
+	}
+	for (size_t i = 0; i < m_vertices.size(); i++)
+	{
+		const BAKE_VERTEX& vertex = m_vertices[i];
+		int d = (int)vertex.drawID;
+
+		m_drawCharts[d].boxMin = glm::min(m_drawCharts[d].boxMin, vertex.objectPosition);
+		boxMax[d] = glm::max(boxMax[d], vertex.objectPosition);
+		axisScale[d] = vertex.axisScale;
+		m_drawCharts[d].bBaked = true;
+	}
+
+	// size the charts, flat objects still get a thin chart
+	std::vector<CHART*> charts;
+	for (int d = 0; d < drawCount; d++)
+	{
+		DRAW_CHARTS& draw = m_drawCharts[d];
+		if (draw.bBaked == false)
+		{
+			draw.boxMin = glm::vec3(0.0f);
+			draw.boxSize = glm::vec3(1.0f);
+			continue;
+		}
+		draw.boxSize = glm::max(boxMax[d] - draw.boxMin, glm::vec3(0.0001f));
+
+		for (int face = 0; face < 6; face++)
+		{
+			int axis = face / 2;
+			int uAxis = (axis + 1) % 3;
+			int vAxis = (axis + 2) % 3;
+			float uLength = draw.boxSize[uAxis] * axisScale[d][uAxis] * TEXELS_PER_UNIT;
+			float vLength = draw.boxSize[vAxis] * axisScale[d][vAxis] * TEXELS_PER_UNIT;
+
+			draw.faces[face].width = std::min(std::max(1, (int)std::ceil(uLength)), ATLAS_WIDTH - (2 * CHART_PADDING)) + (2 * CHART_PADDING);
+			draw.faces[face].height = std::max(1, (int)std::ceil(vLength)) + (2 * CHART_PADDING);
+			charts.push_back(&draw.faces[face]);
+		}
+	}
+
+	// pack the charts into shelves across the atlas
+	std::stable_sort(charts.begin(), charts.end(),
+		[](const CHART* a, const CHART* b) { return(a->height > b->height); });
+
+	int x = 0;
+	int y = 0;
+	int shelfHeight = 0;
+	for (size_t i = 0; i < charts.size(); i++)
+	{
+		CHART* chart = charts[i];
+		if (x + chart->width > ATLAS_WIDTH)
+		{
+			x = 0;
+			y += shelfHeight;
+			shelfHeight = 0;
+		}
+		chart->x = x;
+		chart->y = y;
+		x += chart->width;
+		shelfHeight = std::max(shelfHeight, chart->height);
+	}
+
+	m_atlasWidth = ATLAS_WIDTH;
+	m_atlasHeight = ((y + shelfHeight + 3) / 4) * 4;
+	m_texels.assign((size_t)m_atlasWidth * m_atlasHeight, glm::vec3(0.0f));
+	m_coverage.assign((size_t)m_atlasWidth * m_atlasHeight, 0);
+}
+
+/***********************************************************
+ *  RasterizeCharts()
+ *
+ *  This method is used for drawing every triangle into the
+ *  charts of its object on the CPU.  A texel belongs to the
+ *  triangle that covers its center, when the normal there
+ *  picks the same box face that the fragment shader picks.
+ ***********************************************************/
+void LightmapBaker::RasterizeCharts()
+{
+	std::vector<int> texelSamples((size_t)m_atlasWidth * m_atlasHeight, -1);
+
+	m_samples.clear();
+	for (size_t t = 0; t + 2 < m_vertices.size(); t += 3)
+	{
+		const BAKE_VERTEX* v = &m_vertices[t];
+		const DRAW_CHARTS& draw = m_drawCharts[(int)v[0].drawID];
+
+		for (int face = 0; face < 6; face++)
+		{
+			const CHART& chart = draw.faces[face];
+			int uAxis = ((face / 2) + 1) % 3;
+			int vAxis = ((face / 2) + 2) % 3;
+			float innerWidth = (float)(chart.width - (2 * CHART_PADDING));
+			float innerHeight = (float)(chart.height - (2 * CHART_PADDING));
+			glm::vec2 corners[3];
+
+			for (int k = 0; k < 3; k++)
+			{
+				glm::vec3 local = (v[k].objectPosition - draw.boxMin) / draw.boxSize;
+				corners[k] = glm::vec2(
+					chart.x + CHART_PADDING + (local[uAxis] * innerWidth),
+					chart.y + CHART_PADDING + (local[vAxis] * innerHeight));
+			}
+
+			glm::vec2 edge1 = corners[1] - corners[0];
+			glm::vec2 edge2 = corners[2] - corners[0];
+			float area = (edge1.x * edge2.y) - (edge1.y * edge2.x);
+			if (std::abs(area) < 1e-8f)
+			{
+				continue;
+			}
+
+			glm::vec2 lower = glm::min(corners[0], glm::min(corners[1], corners[2]));
+			glm::vec2 upper = glm::max(corners[0], glm::max(corners[1], corners[2]));
+			int xStart = std::max(0, (int)std::floor(lower.x));
+			int yStart = std::max(0, (int)std::floor(lower.y));
+			int xEnd = std::min(m_atlasWidth - 1, (int)std::ceil(upper.x));
+			int yEnd = std::min(m_atlasHeight - 1, (int)std::ceil(upper.y));
+
+			for (int py = yStart; py <= yEnd; py++)
+			{
+				for (int px = xStart; px <= xEnd; px++)
+				{
+					glm::vec2 offset = glm::vec2(px + 0.5f, py + 0.5f) - corners[0];
+					float b1 = ((offset.x * edge2.y) - (offset.y * edge2.x)) / area;
+					float b2 = ((edge1.x * offset.y) - (edge1.y * offset.x)) / area;
+					float b0 = 1.0f - b1 - b2;
+					if ((b0 < -1e-4f) || (b1 < -1e-4f) || (b2 < -1e-4f))
+					{
+						continue;
+					}
+
+					glm::vec3 objectNormal = (v[0].objectNormal * b0) + (v[1].objectNormal * b1) + (v[2].objectNormal * b2);
+					if (FindBoxFace(objectNormal) != face)
+					{
+						continue;
+					}
+
+					TEXEL_SAMPLE sample;
+					sample.texel = (uint32_t)((py * m_atlasWidth) + px);
+					sample.position = (v[0].worldPosition * b0) + (v[1].worldPosition * b1) + (v[2].worldPosition * b2);
+					sample.normal = glm::normalize((v[0].worldNormal * b0) + (v[1].worldNormal * b1) + (v[2].worldNormal * b2));
+
+					int& index = texelSamples[sample.texel];
+					if (index < 0)
+					{
+						index = (int)m_samples.size();
+						m_samples.push_back(sample);
+					}
+					else
+					{
+						m_samples[index] = sample;
+					}
+				}
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  BuildBVH()
+ *
+ *  This method is used for building the bounding volume
+ *  hierarchy that the rays are traced through.
+ ***********************************************************/
+void LightmapBaker::BuildBVH()
+{
+	m_triangles.clear();
+	for (size_t t = 0; t + 2 < m_vertices.size(); t += 3)
+	{
+		const BAKE_VERTEX* v = &m_vertices[t];
+		BAKE_TRIANGLE triangle;
+
+		triangle.v0 = v[0].worldPosition;
+		triangle.edge1 = v[1].worldPosition - v[0].worldPosition;
+		triangle.edge2 = v[2].worldPosition - v[0].worldPosition;
+		for (int k = 0; k < 3; k++)
+		{
+			triangle.normals[k] = v[k].worldNormal;
+		}
+		triangle.albedo = (v[0].albedo + v[1].albedo + v[2].albedo) / 3.0f;
+		m_triangles.push_back(triangle);
+	}
+
+	BVH_NODE root;
+	root.leftOrFirst = 0;
+	root.count = (uint32_t)m_triangles.size();
+
+	m_nodes.clear();
+	m_nodes.reserve(m_triangles.size() * 2);
+	m_nodes.push_back(root);
+	UpdateNodeBounds(0);
+	SplitNode(0, 0);
+}
+
+/***********************************************************
+ *  UpdateNodeBounds()
+ *
+ *  This method is used for fitting the box of a node around
+ *  all of its triangles.
+ ***********************************************************/
+void LightmapBaker::UpdateNodeBounds(uint32_t nodeIndex)
+{
+	BVH_NODE& node = m_nodes[nodeIndex];
+
+	node.boundsMin = glm::vec3(1e30f);
+	node.boundsMax = glm::vec3(-1e30f);
+	for (uint32_t i = 0; i < node.count; i++)
+	{
+		const BAKE_TRIANGLE& triangle = m_triangles[node.leftOrFirst + i];
+		glm::vec3 v1 = triangle.v0 + triangle.edge1;
+		glm::vec3 v2 = triangle.v0 + triangle.edge2;
+
+		node.boundsMin = glm::min(node.boundsMin, glm::min(triangle.v0, glm::min(v1, v2)));
+		node.boundsMax = glm::max(node.boundsMax, glm::max(triangle.v0, glm::max(v1, v2)));
+	}
+}
+
+/***********************************************************
+ *  SplitNode()
+ *
+ *  This method is used for splitting the triangles of a
+ *  node in two, where the surface area heuristic says rays
+ *  are cheapest to trace, using a few bins along each axis.
+ ***********************************************************/
+void LightmapBaker::SplitNode(uint32_t nodeIndex, int depth)
+{
+	BVH_NODE node = m_nodes[nodeIndex];
+	if ((node.count <= MAX_LEAF_TRIANGLES) || (depth >= MAX_BVH_DEPTH))
+	{
+		return;
+	}
+
+	// bounds of the triangle centers
+	glm::vec3 centerMin = glm::vec3(1e30f);
+	glm::vec3 centerMax = glm::vec3(-1e30f);
+	for (uint32_t i = 0; i < node.count; i++)
+	{
+		const BAKE_TRIANGLE& triangle = m_triangles[node.leftOrFirst + i];
+		glm::vec3 center = triangle.v0 + ((triangle.edge1 + triangle.edge2) / 3.0f);
+		centerMin = glm::min(centerMin, center);
+		centerMax = glm::max(centerMax, center);
+	}
+
+	int bestAxis = -1;
+	float bestSplit = 0.0f;
+	float bestCost = 1e30f;
+	for (int axis = 0; axis < 3; axis++)
+	{
+		float extent = centerMax[axis] - centerMin[axis];
+		if (extent <= 0.0f)
+		{
+			continue;
+		}
+
+		glm::vec3 binMin[SPLIT_BINS];
+		glm::vec3 binMax[SPLIT_BINS];
+		uint32_t binCount[SPLIT_BINS];
+		for (int b = 0; b < SPLIT_BINS; b++)
+		{
+			binMin[b] = glm::vec3(1e30f);
+			binMax[b] = glm::vec3(-1e30f);
+			binCount[b] = 0;
+		}
+		for (uint32_t i = 0; i < node.count; i++)
+		{
+			const BAKE_TRIANGLE& triangle = m_triangles[node.leftOrFirst + i];
+			glm::vec3 v1 = triangle.v0 + triangle.edge1;
+			glm::vec3 v2 = triangle.v0 + triangle.edge2;
+			float center = (triangle.v0[axis] + v1[axis] + v2[axis]) / 3.0f;
+			int b = std::min(SPLIT_BINS - 1, (int)(((center - centerMin[axis]) / extent) * SPLIT_BINS));
+
+			binMin[b] = glm::min(binMin[b], glm::min(triangle.v0, glm::min(v1, v2)));
+			binMax[b] = glm::max(binMax[b], glm::max(triangle.v0, glm::max(v1, v2)));
+			binCount[b]++;
+		}
+
+		// cost of splitting after each bin, from the area of both sides
+		for (int split = 1; split < SPLIT_BINS; split++)
+		{
+			glm::vec3 leftMin = glm::vec3(1e30f), leftMax = glm::vec3(-1e30f);
+			glm::vec3 rightMin = glm::vec3(1e30f), rightMax = glm::vec3(-1e30f);
+			uint32_t leftCount = 0;
+			uint32_t rightCount = 0;
+
+			for (int b = 0; b < SPLIT_BINS; b++)
+			{
+				if (binCount[b] == 0)
+				{
+					continue;
+				}
+				if (b < split)
+				{
+					leftMin = glm::min(leftMin, binMin[b]);
+					leftMax = glm::max(leftMax, binMax[b]);
+					leftCount += binCount[b];
+				}
+				else
+				{
+					rightMin = glm::min(rightMin, binMin[b]);
+					rightMax = glm::max(rightMax, binMax[b]);
+					rightCount += binCount[b];
+				}
+			}
+			if ((leftCount == 0) || (rightCount == 0))
+			{
+				continue;
+			}
+
+			glm::vec3 leftSize = leftMax - leftMin;
+			glm::vec3 rightSize = rightMax - rightMin;
+			float leftArea = (leftSize.x * leftSize.y) + (leftSize.y * leftSize.z) + (leftSize.z * leftSize.x);
+			float rightArea = (rightSize.x * rightSize.y) + (rightSize.y * rightSize.z) + (rightSize.z * rightSize.x);
+			float cost = (leftArea * leftCount) + (rightArea * rightCount);
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestAxis = axis;
+				bestSplit = centerMin[axis] + (extent * split / SPLIT_BINS);
+			}
+		}
+	}
+
+	// keep the node as a leaf when splitting does not pay off
+	glm::vec3 size = node.boundsMax - node.boundsMin;
+	float nodeCost = ((size.x * size.y) + (size.y * size.z) + (size.z * size.x)) * node.count;
+	if ((bestAxis < 0) || (bestCost >= nodeCost))
+	{
+		return;
+	}
+
+	// move the triangles left of the split to the front
+	uint32_t first = node.leftOrFirst;
+	uint32_t last = first + node.count;
+	uint32_t middle = first;
+	for (uint32_t i = first; i < last; i++)
+	{
+		const BAKE_TRIANGLE& triangle = m_triangles[i];
+		float center = triangle.v0[bestAxis] + ((triangle.edge1[bestAxis] + triangle.edge2[bestAxis]) / 3.0f);
+		if (center < bestSplit)
+		{
+			std::swap(m_triangles[i], m_triangles[middle]);
+			middle++;
+		}
+	}
+	if ((middle == first) || (middle == last))
+	{
+		return;
+	}
+
+	uint32_t leftIndex = (uint32_t)m_nodes.size();
+	BVH_NODE left;
+	left.leftOrFirst = first;
+	left.count = middle - first;
+	BVH_NODE right;
+	right.leftOrFirst = middle;
+	right.count = last - middle;
+	m_nodes.push_back(left);
+	m_nodes.push_back(right);
+
+	m_nodes[nodeIndex].leftOrFirst = leftIndex;
+	m_nodes[nodeIndex].count = 0;
+
+	UpdateNodeBounds(leftIndex);
+	UpdateNodeBounds(leftIndex + 1);
+	SplitNode(leftIndex, depth + 1);
+	SplitNode(leftIndex + 1, depth + 1);
+}
+
+/***********************************************************
+ *  TraceRay()
+ *
+ *  This method is used for finding the closest triangle that
+ *  a ray hits before a distance, and the interpolated normal
+ *  at the hit, turned to face back along the ray.
+ ***********************************************************/
+bool LightmapBaker::TraceRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, RAY_HIT& hit) const
+{
+	glm::vec3 inverseDirection = 1.0f / direction;
+	uint32_t stack[MAX_BVH_DEPTH + 2];
+	int stackSize = 0;
+	int hitTriangle = -1;
+	float hitU = 0.0f;
+	float hitV = 0.0f;
+
+	hit.distance = maxDistance;
+	stack[stackSize++] = 0;
+	while (stackSize > 0)
+	{
+		const BVH_NODE& node = m_nodes[stack[--stackSize]];
+		if (IntersectBox(origin, inverseDirection, node.boundsMin, node.boundsMax, hit.distance) == false)
+		{
+			continue;
+		}
+		if (node.count == 0)
+		{
+			stack[stackSize++] = node.leftOrFirst;
+			stack[stackSize++] = node.leftOrFirst + 1;
+			continue;
+		}
+
+		for (uint32_t i = 0; i < node.count; i++)
+		{
+			const BAKE_TRIANGLE& triangle = m_triangles[node.leftOrFirst + i];
+			glm::vec3 pvec = glm::cross(direction, triangle.edge2);
+			float determinant = glm::dot(triangle.edge1, pvec);
+			if (std::abs(determinant) < 1e-12f)
+			{
+				continue;
+			}
+
+			float inverseDeterminant = 1.0f / determinant;
+			glm::vec3 tvec = origin - triangle.v0;
+			float u = glm::dot(tvec, pvec) * inverseDeterminant;
+			if ((u < 0.0f) || (u > 1.0f))
+			{
+				continue;
+			}
+			glm::vec3 qvec = glm::cross(tvec, triangle.edge1);
+			float v = glm::dot(direction, qvec) * inverseDeterminant;
+			if ((v < 0.0f) || (u + v > 1.0f))
+			{
+				continue;
+			}
+			float distance = glm::dot(triangle.edge2, qvec) * inverseDeterminant;
+			if ((distance > 0.0f) && (distance < hit.distance))
+			{
+				hit.distance = distance;
+				hitTriangle = (int)(node.leftOrFirst + i);
+				hitU = u;
+				hitV = v;
+			}
+		}
+	}
+
+	if (hitTriangle < 0)
+	{
+		return(false);
+	}
+
+	const BAKE_TRIANGLE& triangle = m_triangles[hitTriangle];
+	hit.position = origin + (direction * hit.distance);
+	hit.normal = glm::normalize(
+		(triangle.normals[0] * (1.0f - hitU - hitV)) +
+		(triangle.normals[1] * hitU) +
+		(triangle.normals[2] * hitV));
+	if (glm::dot(hit.normal, direction) > 0.0f)
+	{
+		hit.normal = -hit.normal;
+	}
+	hit.albedo = triangle.albedo;
+
+	return(true);
+}
+
+/***********************************************************
+ *  IsOccluded()
+ *
+ *  This method is used for checking whether any triangle
+ *  blocks a ray before a distance.
+ ***********************************************************/
+bool LightmapBaker::IsOccluded(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const
+{
+	RAY_HIT hit;
+	return(TraceRay(origin, direction, maxDistance, hit));
+}
+
+/***********************************************************
+ *  CalculateDirectLight()
+ *
+ *  This method is used for adding up the diffuse light of
+ *  every static light that reaches a surface point, with a
+ *  shadow ray toward each light.  The lights are not
+ *  attenuated, the same as in the fragment shader.
+ ***********************************************************/
+glm::vec3 LightmapBaker::CalculateDirectLight(const glm::vec3& position, const glm::vec3& normal) const
+{
+	glm::vec3 light = glm::vec3(0.0f);
+	glm::vec3 origin = position + (normal * RAY_OFFSET);
+
+	for (size_t i = 0; i < m_lights.size(); i++)
+	{
+		const BAKE_LIGHT& bakeLight = m_lights[i];
+		glm::vec3 toLight;
+		float distance = 1e30f;
+
+		if (bakeLight.bDirectional == true)
+		{
+			toLight = -glm::normalize(bakeLight.vector);
+		}
+		else
+		{
+			toLight = bakeLight.vector - position;
+			distance = glm::length(toLight);
+			toLight /= distance;
+			distance -= RAY_OFFSET;
+		}
+
+		float lambert = glm::dot(normal, toLight);
+		if ((lambert > 0.0f) && (IsOccluded(origin, toLight, distance) == false))
+		{
+			light += bakeLight.color * lambert;
+		}
+	}
+
+	return(light);
+}
+
+/***********************************************************
+ *  TraceIncomingLight()
+ *
+ *  This method is used for path tracing the light that
+ *  arrives at a point from one direction - the direct light
+ *  reflected off the first surface the ray hits, plus the
+ *  light of the further bounces off other surfaces.  The
+ *  seed picks the bounce directions, so the same seed always
+ *  gives the same result.
+ ***********************************************************/
+glm::vec3 LightmapBaker::TraceIncomingLight(const glm::vec3& origin, const glm::vec3& direction, uint32_t seed) const
+{
+	RANDOM random(seed);
+	glm::vec3 light = glm::vec3(0.0f);
+	glm::vec3 throughput = glm::vec3(1.0f);
+	glm::vec3 position = origin;
+	glm::vec3 rayDirection = direction;
+
+	for (int bounce = 0; bounce < MAX_BOUNCES; bounce++)
+	{
+		RAY_HIT hit;
+
+		if (TraceRay(position, rayDirection, 1e30f, hit) == false)
+		{
+			break;
+		}
+		throughput *= hit.albedo;
+		light += throughput * CalculateDirectLight(hit.position, hit.normal);
+		position = hit.position + (hit.normal * RAY_OFFSET);
+		rayDirection = SampleCosineDirection(hit.normal, random);
+	}
+
+	return(light);
+}
+
+/***********************************************************
+ *  BakeTexel()
+ *
+ *  This method is used for path tracing the light that
+ *  reaches the surface point of one texel - the direct light
+ *  plus the indirect light of the paths traced off it.
+ ***********************************************************/
+glm::vec3 LightmapBaker::BakeTexel(const TEXEL_SAMPLE& sample) const
+{
+	RANDOM random(sample.texel);
+	glm::vec3 origin = sample.position + (sample.normal * RAY_OFFSET);
+	glm::vec3 indirect = glm::vec3(0.0f);
+
+	for (int s = 0; s < INDIRECT_SAMPLES; s++)
+	{
+		glm::vec3 direction = SampleCosineDirection(sample.normal, random);
+		uint32_t seed = (sample.texel * INDIRECT_SAMPLES) + s;
+
+		indirect += TraceIncomingLight(origin, direction, seed);
+	}
+
+	return(CalculateDirectLight(sample.position, sample.normal) + (indirect / (float)INDIRECT_SAMPLES));
+}
+
+/***********************************************************
+ *  BakeWorker()
+ *
+ *  This method is used for baking groups of texels on one
+ *  thread until the queue of texels is empty.  Every texel
+ *  is written by only one thread.
+ ***********************************************************/
+void LightmapBaker::BakeWorker(std::atomic<size_t>* pNextSample)
+{
+	while (true)
+	{
+		size_t first = pNextSample->fetch_add(SAMPLES_PER_JOB);
+		if (first >= m_samples.size())
+		{
+			return;
+		}
+
+		size_t last = std::min(first + SAMPLES_PER_JOB, m_samples.size());
+		for (size_t i = first; i < last; i++)
+		{
+			m_texels[m_samples[i].texel] = BakeTexel(m_samples[i]);
+		}
+	}
+}
+
+/***********************************************************
+ *  DilateTexels()
+ *
+ *  This method is used for filling the empty texels around
+ *  the baked texels with the average of their baked
+ *  neighbours, so the texture filtering at the chart edges
+ *  does not blend in black.
+ ***********************************************************/
+void LightmapBaker::DilateTexels()
+{
+	for (size_t i = 0; i < m_samples.size(); i++)
+	{
+		m_coverage[m_samples[i].texel] = 1;
+	}
+
+	for (int pass = 0; pass < CHART_PADDING; pass++)
+	{
+		std::vector<uint8_t> coverage = m_coverage;
+
+		for (int y = 0; y < m_atlasHeight; y++)
+		{
+			for (int x = 0; x < m_atlasWidth; x++)
+			{
+				size_t index = ((size_t)y * m_atlasWidth) + x;
+				if (m_coverage[index] != 0)
+				{
+					continue;
+				}
+
+				glm::vec3 sum = glm::vec3(0.0f);
+				int count = 0;
+				for (int dy = -1; dy <= 1; dy++)
+				{
+					for (int dx = -1; dx <= 1; dx++)
+					{
+						int nx = x + dx;
+						int ny = y + dy;
+						if ((nx < 0) || (ny < 0) || (nx >= m_atlasWidth) || (ny >= m_atlasHeight))
+						{
+							continue;
+						}
+						size_t neighbour = ((size_t)ny * m_atlasWidth) + nx;
+						if (m_coverage[neighbour] != 0)
+						{
+							sum += m_texels[neighbour];
+							count++;
+						}
+					}
+				}
+				if (count > 0)
+				{
+					m_texels[index] = sum / (float)count;
+					coverage[index] = 1;
+				}
+			}
+		}
+		m_coverage.swap(coverage);
+	}
+}
+
+/***********************************************************
+ *  Bake()
+ *
+ *  This method is used for baking every covered texel of
+ *  the atlas, spread over the passed in number of threads,
+ *  and getting the number of seconds that it took.  The
+ *  result is the same for any number of threads.
+ ***********************************************************/
+double LightmapBaker::Bake(int threadCount)
+{
+	std::atomic<size_t> nextSample(0);
+	std::vector<std::thread> threads;
+
+	std::fill(m_texels.begin(), m_texels.end(), glm::vec3(0.0f));
+	std::fill(m_coverage.begin(), m_coverage.end(), (uint8_t)0);
+
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 1; i < threadCount; i++)
+	{
+		threads.push_back(std::thread(&LightmapBaker::BakeWorker, this, &nextSample));
+	}
+	// the calling thread bakes its share too
+	BakeWorker(&nextSample);
+	for (size_t i = 0; i < threads.size(); i++)
+	{
+		threads[i].join();
+	}
+	DilateTexels();
+	auto end = std::chrono::steady_clock::now();
+
+	return(std::chrono::duration<double>(end - start).count());
+}
+
+/***********************************************************
+ *  GetAtlasWidth()
+ *
+ *  This method is used for getting the width of the atlas.
+ ***********************************************************/
+int LightmapBaker::GetAtlasWidth() const
+{
+	return(m_atlasWidth);
+}
+
+/***********************************************************
+ *  GetAtlasHeight()
+ *
+ *  This method is used for getting the height of the atlas.
+ ***********************************************************/
+int LightmapBaker::GetAtlasHeight() const
+{
+	return(m_atlasHeight);
+}
+
+/***********************************************************
+ *  GetSampleCount()
+ *
+ *  This method is used for getting the number of texels
+ *  that are baked.
+ ***********************************************************/
+size_t LightmapBaker::GetSampleCount() const
+{
+	return(m_samples.size());
+}
+
+/***********************************************************
+ *  GetTexels()
+ *
+ *  This method is used for getting the baked light of every
+ *  texel of the atlas, row by row.
+ ***********************************************************/
+const std::vector<glm::vec3>& LightmapBaker::GetTexels() const
+{
+	return(m_texels);
+}
+
+/***********************************************************
+ *  GetDrawCharts()
+ *
+ *  This method is used for getting the object space box and
+ *  the charts of every drawn object.
+ ***********************************************************/
+const std::vector<LightmapBaker::DRAW_CHARTS>& LightmapBaker::GetDrawCharts() const
+{
+	return(m_drawCharts);
+}
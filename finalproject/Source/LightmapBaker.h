@@ -0,0 +1,183 @@
+///////////////////////////////////////////////////////////////////////////////
+// lightmapbaker.h
+// ============
+// bake the static lighting of the scene into lightmaps on the CPU
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/***********************************************************
+ *  LightmapBaker
+ *
+ *  This class contains the code for baking the light that
+ *  the static lights leave on the static objects.  Every
+ *  object is unwrapped into six box projected charts, one
+ *  for each axis direction of its normals, and the charts
+ *  are packed into one atlas.  The texels of the atlas are
+ *  path traced against a bounding volume hierarchy of the
+ *  scene triangles, for the direct light with shadows and
+ *  a few bounces of indirect light, spread over any number
+ *  of threads.  This class does not use OpenGL, the scene
+ *  triangles are passed in by the LightmapManager.
+ ***********************************************************/
+class LightmapBaker
+{
+public:
+	// constructor
+	LightmapBaker();
+	// destructor
+	~LightmapBaker();
+
+	// number of texels along one world unit of an object surface
+	static const int TEXELS_PER_UNIT = 6;
+	// empty texels around each chart, filled from the chart edges
+	static const int CHART_PADDING = 2;
+	// width of the atlas that the charts are packed into
+	static const int ATLAS_WIDTH = 1024;
+	// paths traced from each texel for the indirect light
+	static const int INDIRECT_SAMPLES = 64;
+	// surfaces each indirect path bounces off at most
+	static const int MAX_BOUNCES = 2;
+
+	// scene vertex as it is captured from the drawn objects
+	struct BAKE_VERTEX
+	{
+		glm::vec3 worldPosition;
+		glm::vec3 objectPosition;
+		glm::vec3 objectNormal;
+		glm::vec3 worldNormal;
+		glm::vec3 albedo;
+		glm::vec3 axisScale;    // world length of each object axis
+		float drawID;
+	};
+
+	// static light, without ambient or specular light
+	struct BAKE_LIGHT
+	{
+		glm::vec3 vector;       // direction of a directional light, or position of a point light
+		glm::vec3 color;
+		bool bDirectional;
+	};
+
+	// area of the atlas, in texels, that one chart was packed into
+	struct CHART
+	{
+		int x;
+		int y;
+		int width;
+		int height;
+	};
+
+	// object space box and the six charts of one drawn object
+	struct DRAW_CHARTS
+	{
+		glm::vec3 boxMin;
+		glm::vec3 boxSize;
+		CHART faces[6];
+		bool bBaked;
+	};
+
+private:
+	// scene triangle prepared for the ray tests
+	struct BAKE_TRIANGLE
+	{
+		glm::vec3 v0;
+		glm::vec3 edge1;
+		glm::vec3 edge2;
+		glm::vec3 normals[3];
+		glm::vec3 albedo;
+	};
+
+	// node of the bounding volume hierarchy, a leaf when count > 0
+	struct BVH_NODE
+	{
+		glm::vec3 boundsMin;
+		glm::vec3 boundsMax;
+		uint32_t leftOrFirst;
+		uint32_t count;
+	};
+
+	// surface point that one atlas texel is baked for
+	struct TEXEL_SAMPLE
+	{
+		uint32_t texel;
+		glm::vec3 position;
+		glm::vec3 normal;
+	};
+
+	// closest surface that a ray hits
+	struct RAY_HIT
+	{
+		float distance;
+		glm::vec3 position;
+		glm::vec3 normal;
+		glm::vec3 albedo;
+	};
+
+	std::vector<BAKE_VERTEX> m_vertices;
+	std::vector<BAKE_TRIANGLE> m_triangles;
+	std::vector<BVH_NODE> m_nodes;
+	std::vector<BAKE_LIGHT> m_lights;
+	std::vector<DRAW_CHARTS> m_drawCharts;
+	std::vector<TEXEL_SAMPLE> m_samples;
+	std::vector<glm::vec3> m_texels;
+	std::vector<uint8_t> m_coverage;
+	int m_atlasWidth;
+	int m_atlasHeight;
+
+	// pack the charts of every object into the atlas
+	void BuildCharts();
+	// find the surface point of every texel that the charts cover
+	void RasterizeCharts();
+	// build the bounding volume hierarchy over the scene triangles
+	void BuildBVH();
+	void SplitNode(uint32_t nodeIndex, int depth);
+	void UpdateNodeBounds(uint32_t nodeIndex);
+
+	// find the closest triangle that a ray hits
+	bool TraceRay(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, RAY_HIT& hit) const;
+	// check whether anything blocks a ray
+	bool IsOccluded(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const;
+	// get the light of the static lights that reaches a point
+	glm::vec3 CalculateDirectLight(const glm::vec3& position, const glm::vec3& normal) const;
+	// get the direct and indirect light that reaches a texel
+	glm::vec3 BakeTexel(const TEXEL_SAMPLE& sample) const;
+	// bake a share of the texels on one thread
+	void BakeWorker(std::atomic<size_t>* pNextSample);
+	// fill the empty texels around the charts from their neighbours
+	void DilateTexels();
+
+public:
+	// set the scene triangles, three vertices for each triangle
+	void SetTriangles(const std::vector<BAKE_VERTEX>& vertices);
+	// add a static light to bake
+	void AddLight(const BAKE_LIGHT& light);
+	// unwrap and pack the objects and build the ray tracing hierarchy
+	bool Prepare();
+	// bake the lightmap on a number of threads and get the seconds it took
+	double Bake(int threadCount);
+	// build only the ray tracing hierarchy, without the atlas
+	bool PrepareTracing();
+	// get the light arriving at a point from a direction, can be
+	// called from any number of threads once prepared
+	glm::vec3 TraceIncomingLight(const glm::vec3& origin, const glm::vec3& direction, uint32_t seed) const;
+
+	// get the size of the atlas in texels
+	int GetAtlasWidth() const;
+	int GetAtlasHeight() const;
+	// get the number of texels that the charts cover
+	size_t GetSampleCount() const;
+	// get the baked light of every atlas texel
+	const std::vector<glm::vec3>& GetTexels() const;
+	// get the charts of every drawn object
+	const std::vector<DRAW_CHARTS>& GetDrawCharts() const;
+};
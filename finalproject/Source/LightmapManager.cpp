@@ -0,0 +1,487 @@
+///////////////////////////////////////////////////////////////////////////////
+// lightmapmanager.cpp
+// ============
+// manage the baked lightmaps - scene capture, baking, saving and sampling
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "LightmapManager.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+// declare the global variables
+namespace
+{
+	const char* g_UseLightmapName = "bUseLightmap";
+	const char* g_LightmapName = "lightmap";
+	const char* g_LightmapChartsName = "lightmapCharts";
+
+	// outputs of the capture shader, in the order of BAKE_VERTEX
+	const char* CAPTURE_VARYINGS[] =
+	{
+		"captureWorldPosition",
+		"captureObjectPosition",
+		"captureObjectNormal",
+		"captureWorldNormal",
+		"captureAlbedo",
+		"captureAxisScale",
+		"captureDrawID"
+	};
+
+	// identifies a lightmap file and the version of its layout
+	const char LIGHTMAP_FILE_MAGIC[4] = { 'L', 'M', 'A', 'P' };
+	const int LIGHTMAP_FILE_VERSION = 1;
+	// thread counts that the bake is measured with
+	const int BAKE_THREAD_COUNTS[] = { 1, 2, 4, 8, 16, 32, 64 };
+}
+
+/***********************************************************
+ *  LightmapManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+LightmapManager::LightmapManager()
+{
+	m_pCaptureShader = NULL;
+	m_width = 0;
+	m_height = 0;
+	m_lightmapTexture = 0;
+	m_chartTexture = 0;
+	m_bEnabled = true;
+}
+
+/***********************************************************
+ *  ~LightmapManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+LightmapManager::~LightmapManager()
+{
+	DestroyTextures();
+
+	if (NULL != m_pCaptureShader)
+	{
+		delete m_pCaptureShader;
+		m_pCaptureShader = NULL;
+	}
+}
+
+/***********************************************************
+ *  LoadShaders()
+ *
+ *  This method is used for loading the capture shader and
+ *  linking it again with its outputs written into the
+ *  transform feedback buffer.
+ ***********************************************************/
+bool LightmapManager::LoadShaders()
+{
+	m_pCaptureShader = new ShaderManager();
+	GLuint programID = m_pCaptureShader->LoadShaders(
+		"shaders/lightmapCaptureVertexShader.glsl",
+		"shaders/depthFragmentShader.glsl");
+
+	glTransformFeedbackVaryings(
+		programID,
+		sizeof(CAPTURE_VARYINGS) / sizeof(CAPTURE_VARYINGS[0]),
+		CAPTURE_VARYINGS,
+		GL_INTERLEAVED_ATTRIBS);
+	glLinkProgram(programID);
+
+	GLint linkStatus = GL_FALSE;
+	glGetProgramiv(programID, GL_LINK_STATUS, &linkStatus);
+	if (linkStatus != GL_TRUE)
+	{
+		std::cout << "Lightmap capture shader could not be linked" << std::endl;
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  AddDirectionalLight()
+ *
+ *  This method is used for adding a static directional light
+ *  that is baked into the lightmap.
+ ***********************************************************/
+void LightmapManager::AddDirectionalLight(glm::vec3 direction, glm::vec3 diffuse)
+{
+	LightmapBaker::BAKE_LIGHT light;
+
+	light.vector = direction;
+	light.color = diffuse;
+	light.bDirectional = true;
+	m_lights.push_back(light);
+}
+
+/***********************************************************
+ *  AddPointLight()
+ *
+ *  This method is used for adding a static point light that
+ *  is baked into the lightmap.
+ ***********************************************************/
+void LightmapManager::AddPointLight(glm::vec3 position, glm::vec3 diffuse)
+{
+	LightmapBaker::BAKE_LIGHT light;
+
+	light.vector = position;
+	light.color = diffuse;
+	light.bDirectional = false;
+	m_lights.push_back(light);
+}
+
+/***********************************************************
+ *  ClearLights()
+ *
+ *  This method is used for removing all the static lights.
+ ***********************************************************/
+void LightmapManager::ClearLights()
+{
+	m_lights.clear();
+}
+
+/***********************************************************
+ *  GetLights()
+ *
+ *  This method is used for getting the static lights, for
+ *  other bakes of the same lighting.
+ ***********************************************************/
+const std::vector<LightmapBaker::BAKE_LIGHT>& LightmapManager::GetLights() const
+{
+	return(m_lights);
+}
+
+/***********************************************************
+ *  CaptureScene()
+ *
+ *  This method is used for drawing the static objects with
+ *  the rasterizer turned off, once to count the triangles
+ *  and once to write their vertices into a transform
+ *  feedback buffer, which is then read back.  The orange is
+ *  treated as dynamic, so it is never baked even when it is
+ *  not animated.
+ ***********************************************************/
+bool LightmapManager::CaptureScene(SceneManager* pSceneManager, std::vector<LightmapBaker::BAKE_VERTEX>& vertices)
+{
+	bool bDynamic = pSceneManager->HasDynamicObjects();
+	GLuint query = 0;
+	GLuint captureBuffer = 0;
+	GLuint triangleCount = 0;
+
+	m_pCaptureShader->use();
+	pSceneManager->SetShaderManager(m_pCaptureShader);
+	pSceneManager->SetDynamicObjects(true);
+	pSceneManager->SetObjectFilter(SceneManager::DRAW_STATIC_OBJECTS);
+	glEnable(GL_RASTERIZER_DISCARD);
+
+	// count the triangles, to size the capture buffer
+	glGenQueries(1, &query);
+	glBeginQuery(GL_PRIMITIVES_GENERATED, query);
+	pSceneManager->RenderScene();
+	glEndQuery(GL_PRIMITIVES_GENERATED);
+	glGetQueryObjectuiv(query, GL_QUERY_RESULT, &triangleCount);
+
+	vertices.resize((size_t)triangleCount * 3);
+	if (triangleCount > 0)
+	{
+		GLsizeiptr bufferSize = (GLsizeiptr)(vertices.size() * sizeof(LightmapBaker::BAKE_VERTEX));
+
+		glGenBuffers(1, &captureBuffer);
+		glBindBuffer(GL_TRANSFORM_FEEDBACK_BUFFER, captureBuffer);
+		glBufferData(GL_TRANSFORM_FEEDBACK_BUFFER, bufferSize, NULL, GL_STATIC_READ);
+		glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, captureBuffer);
+
+		glBeginTransformFeedback(GL_TRIANGLES);
+		pSceneManager->RenderScene();
+		glEndTransformFeedback();
+
+		glGetBufferSubData(GL_TRANSFORM_FEEDBACK_BUFFER, 0, bufferSize, &vertices[0]);
+		glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+		glDeleteBuffers(1, &captureBuffer);
+	}
+
+	glDisable(GL_RASTERIZER_DISCARD);
+	glDeleteQueries(1, &query);
+	pSceneManager->SetObjectFilter(SceneManager::DRAW_ALL_OBJECTS);
+	pSceneManager->SetDynamicObjects(bDynamic);
+
+	return(triangleCount > 0);
+}
+
+/***********************************************************
+ *  BuildChartTable()
+ *
+ *  This method is used for filling a row of the chart table
+ *  for every draw.  The first texel holds the object space
+ *  box corner and whether the draw was baked, the second the
+ *  box size, and the rest the area of each chart inside its
+ *  padding, in atlas coordinates.
+ ***********************************************************/
+void LightmapManager::BuildChartTable(const LightmapBaker& baker)
+{
+	const std::vector<LightmapBaker::DRAW_CHARTS>& drawCharts = baker.GetDrawCharts();
+	glm::vec2 atlasSize = glm::vec2((float)m_width, (float)m_height);
+
+	m_chartTable.assign(MAX_DRAWS * CHART_TABLE_WIDTH, glm::vec4(0.0f));
+	for (size_t d = 0; (d < drawCharts.size()) && (d < MAX_DRAWS); d++)
+	{
+		const LightmapBaker::DRAW_CHARTS& draw = drawCharts[d];
+		glm::vec4* row = &m_chartTable[d * CHART_TABLE_WIDTH];
+
+		row[0] = glm::vec4(draw.boxMin, (draw.bBaked == true) ? 1.0f : 0.0f);
+		row[1] = glm::vec4(draw.boxSize, 0.0f);
+		for (int face = 0; face < 6; face++)
+		{
+			const LightmapBaker::CHART& chart = draw.faces[face];
+			glm::vec2 corner = glm::vec2(
+				(float)(chart.x + LightmapBaker::CHART_PADDING),
+				(float)(chart.y + LightmapBaker::CHART_PADDING));
+			glm::vec2 size = glm::vec2(
+				(float)(chart.width - (2 * LightmapBaker::CHART_PADDING)),
+				(float)(chart.height - (2 * LightmapBaker::CHART_PADDING)));
+
+			corner /= atlasSize;
+			size /= atlasSize;
+
+			row[2 + face] = glm::vec4(corner.x, corner.y, size.x, size.y);
+		}
+	}
+}
+
+/***********************************************************
+ *  BakeLightmaps()
+ *
+ *  This method is used for capturing the static objects and
+ *  baking their lightmap on all of the CPU cores.  When the
+ *  scaling is measured, the same lightmap is baked with 1 to
+ *  64 threads and the time of each bake is output.
+ ***********************************************************/
+bool LightmapManager::BakeLightmaps(SceneManager* pSceneManager, bool bMeasureScaling)
+{
+	std::vector<LightmapBaker::BAKE_VERTEX> vertices;
+	LightmapBaker baker;
+
+	if (CaptureScene(pSceneManager, vertices) == false)
+	{
+		std::cout << "Lightmap bake found no static triangles" << std::endl;
+		return(false);
+	}
+
+	baker.SetTriangles(vertices);
+	for (size_t i = 0; i < m_lights.size(); i++)
+	{
+		baker.AddLight(m_lights[i]);
+	}
+	if (baker.Prepare() == false)
+	{
+		std::cout << "Lightmap bake found no texels to bake" << std::endl;
+		return(false);
+	}
+	m_width = baker.GetAtlasWidth();
+	m_height = baker.GetAtlasHeight();
+
+	std::cout << "INFO: Lightmap atlas: " << m_width << "x" << m_height
+		<< ", baked texels: " << baker.GetSampleCount()
+		<< ", triangles: " << (vertices.size() / 3) << std::endl;
+
+	if (bMeasureScaling == true)
+	{
+		const int runTotal = sizeof(BAKE_THREAD_COUNTS) / sizeof(BAKE_THREAD_COUNTS[0]);
+		double singleSeconds = 0.0;
+
+		for (int r = 0; r < runTotal; r++)
+		{
+			double seconds = baker.Bake(BAKE_THREAD_COUNTS[r]);
+			bool bIdentical = true;
+
+			if (r == 0)
+			{
+				singleSeconds = seconds;
+				m_texels = baker.GetTexels();
+			}
+			else
+			{
+				bIdentical = (memcmp(&m_texels[0], &baker.GetTexels()[0], m_texels.size() * sizeof(glm::vec3)) == 0);
+			}
+
+			std::cout << "INFO: Lightmap bake threads: " << BAKE_THREAD_COUNTS[r]
+				<< ", time: " << (seconds * 1000.0) << " ms"
+				<< ", speedup: " << (singleSeconds / seconds)
+				<< ", identical: " << ((bIdentical == true) ? "yes" : "no")
+				<< std::endl;
+		}
+	}
+	else
+	{
+		int threadCount = std::max(1, (int)std::thread::hardware_concurrency());
+		double seconds = baker.Bake(threadCount);
+
+		std::cout << "INFO: Lightmap bake threads: " << threadCount
+			<< ", time: " << (seconds * 1000.0) << " ms" << std::endl;
+		m_texels = baker.GetTexels();
+	}
+
+	BuildChartTable(baker);
+
+	return(true);
+}
+
+/***********************************************************
+ *  SaveLightmaps()
+ *
+ *  This method is used for writing the size of the atlas,
+ *  the chart table and the baked texels into a file.
+ ***********************************************************/
+bool LightmapManager::SaveLightmaps(const char* filename) const
+{
+	std::ofstream file(filename, std::ios::binary);
+	if (!file)
+	{
+		std::cout << "Could not write lightmap:" << filename << std::endl;
+		return(false);
+	}
+
+	int header[3] = { LIGHTMAP_FILE_VERSION, m_width, m_height };
+	file.write(LIGHTMAP_FILE_MAGIC, sizeof(LIGHTMAP_FILE_MAGIC));
+	file.write((const char*)header, sizeof(header));
+	file.write((const char*)&m_chartTable[0], m_chartTable.size() * sizeof(glm::vec4));
+	file.write((const char*)&m_texels[0], m_texels.size() * sizeof(glm::vec3));
+
+	return(file.good());
+}
+
+/***********************************************************
+ *  LoadLightmaps()
+ *
+ *  This method is used for reading a lightmap file that was
+ *  written by SaveLightmaps().
+ ***********************************************************/
+bool LightmapManager::LoadLightmaps(const char* filename)
+{
+	std::ifstream file(filename, std::ios::binary);
+	char magic[4];
+	int header[3] = { 0, 0, 0 };
+
+	file.read(magic, sizeof(magic));
+	file.read((char*)header, sizeof(header));
+	if ((!file) ||
+		(memcmp(magic, LIGHTMAP_FILE_MAGIC, sizeof(magic)) != 0) ||
+		(header[0] != LIGHTMAP_FILE_VERSION) ||
+		(header[1] <= 0) || (header[2] <= 0))
+	{
+		std::cout << "Could not load lightmap:" << filename << std::endl;
+		return(false);
+	}
+
+	m_width = header[1];
+	m_height = header[2];
+	m_chartTable.resize(MAX_DRAWS * CHART_TABLE_WIDTH);
+	m_texels.resize((size_t)m_width * m_height);
+	file.read((char*)&m_chartTable[0], m_chartTable.size() * sizeof(glm::vec4));
+	file.read((char*)&m_texels[0], m_texels.size() * sizeof(glm::vec3));
+	if (!file)
+	{
+		std::cout << "Lightmap file is incomplete:" << filename << std::endl;
+		m_texels.clear();
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  CreateTextures()
+ *
+ *  This method is used for creating the filtered atlas
+ *  texture and the unfiltered chart table texture from the
+ *  baked or loaded lightmap.
+ ***********************************************************/
+bool LightmapManager::CreateTextures()
+{
+	if (m_texels.size() == 0)
+	{
+		return(false);
+	}
+	DestroyTextures();
+
+	// create the textures on their own units, so that the
+	// scene textures stay bound
+	glActiveTexture(GL_TEXTURE0 + LIGHTMAP_TEXTURE_UNIT);
+	glGenTextures(1, &m_lightmapTexture);
+	glBindTexture(GL_TEXTURE_2D, m_lightmapTexture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, m_width, m_height, 0, GL_RGB, GL_FLOAT, &m_texels[0]);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+	glActiveTexture(GL_TEXTURE0 + CHART_TEXTURE_UNIT);
+	glGenTextures(1, &m_chartTexture);
+	glBindTexture(GL_TEXTURE_2D, m_chartTexture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, CHART_TABLE_WIDTH, MAX_DRAWS, 0, GL_RGBA, GL_FLOAT, &m_chartTable[0]);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glActiveTexture(GL_TEXTURE0);
+
+	return(true);
+}
+
+/***********************************************************
+ *  DestroyTextures()
+ *
+ *  This method is used for freeing the lightmap textures.
+ ***********************************************************/
+void LightmapManager::DestroyTextures()
+{
+	if (m_lightmapTexture != 0)
+	{
+		glDeleteTextures(1, &m_lightmapTexture);
+		glDeleteTextures(1, &m_chartTexture);
+		m_lightmapTexture = 0;
+		m_chartTexture = 0;
+	}
+}
+
+/***********************************************************
+ *  SetEnabled()
+ *
+ *  This method is used for turning the lightmaps in the
+ *  shading pass on or off.
+ ***********************************************************/
+void LightmapManager::SetEnabled(bool bEnabled)
+{
+	m_bEnabled = bEnabled;
+}
+
+/***********************************************************
+ *  BindLightmap()
+ *
+ *  This method is used for binding the lightmap textures and
+ *  turning the lightmap on in the shader.  The samplers are
+ *  always set, so that they never share a texture unit with
+ *  the object texture.
+ ***********************************************************/
+void LightmapManager::BindLightmap(ShaderManager* pShaderManager)
+{
+	bool bUseLightmap = (m_bEnabled == true) && (m_lightmapTexture != 0);
+
+	pShaderManager->setSampler2DValue(g_LightmapName, LIGHTMAP_TEXTURE_UNIT);
+	pShaderManager->setSampler2DValue(g_LightmapChartsName, CHART_TEXTURE_UNIT);
+	pShaderManager->setBoolValue(g_UseLightmapName, bUseLightmap);
+	if (bUseLightmap == false)
+	{
+		return;
+	}
+
+	glActiveTexture(GL_TEXTURE0 + LIGHTMAP_TEXTURE_UNIT);
+	glBindTexture(GL_TEXTURE_2D, m_lightmapTexture);
+	glActiveTexture(GL_TEXTURE0 + CHART_TEXTURE_UNIT);
+	glBindTexture(GL_TEXTURE_2D, m_chartTexture);
+	glActiveTexture(GL_TEXTURE0);
+}
@@ -0,0 +1,97 @@
+///////////////////////////////////////////////////////////////////////////////
+// lightmapmanager.h
+// ============
+// manage the baked lightmaps - scene capture, baking, saving and sampling
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+#include "SceneManager.h"
+#include "LightmapBaker.h"
+
+#include <vector>
+
+/***********************************************************
+ *  LightmapManager
+ *
+ *  This class contains the code for the baked lightmaps of
+ *  the static objects.  The triangles of the static objects
+ *  are captured from the GPU with transform feedback, handed
+ *  to the LightmapBaker, and the baked atlas is saved to a
+ *  file.  When the lightmaps are used, the atlas and a table
+ *  of the charts of every draw are bound as textures, and the
+ *  fragment shader samples the baked light instead of
+ *  evaluating the static lights.
+ ***********************************************************/
+class LightmapManager
+{
+public:
+	// constructor
+	LightmapManager();
+	// destructor
+	~LightmapManager();
+
+	// texture units the shading pass reads the lightmaps from
+	static const int LIGHTMAP_TEXTURE_UNIT = 25;
+	static const int CHART_TEXTURE_UNIT = 26;
+	// most draws a frame can have charts for
+	static const int MAX_DRAWS = 64;
+	// texels in each row of the chart table, must match the shaders
+	static const int CHART_TABLE_WIDTH = 8;
+
+private:
+	// shader that captures the scene triangles with transform feedback
+	ShaderManager* m_pCaptureShader;
+	// static lights that are baked into the lightmap
+	std::vector<LightmapBaker::BAKE_LIGHT> m_lights;
+	// baked light of every atlas texel
+	std::vector<glm::vec3> m_texels;
+	// box and chart rectangles of every draw, CHART_TABLE_WIDTH texels each
+	std::vector<glm::vec4> m_chartTable;
+	int m_width;
+	int m_height;
+	// OpenGL textures of the atlas and the chart table
+	GLuint m_lightmapTexture;
+	GLuint m_chartTexture;
+	// true when the shading pass samples the lightmaps
+	bool m_bEnabled;
+
+	// fill the chart table from the charts of the baker
+	void BuildChartTable(const LightmapBaker& baker);
+
+public:
+	// load the shader the scene triangles are captured with
+	bool LoadShaders();
+
+	// add a static directional light, from its direction and diffuse color
+	void AddDirectionalLight(glm::vec3 direction, glm::vec3 diffuse);
+	// add a static point light, from its position and diffuse color
+	void AddPointLight(glm::vec3 position, glm::vec3 diffuse);
+	// remove all the static lights
+	void ClearLights();
+	// get the static lights
+	const std::vector<LightmapBaker::BAKE_LIGHT>& GetLights() const;
+
+	// capture the triangles of the static objects
+	bool CaptureScene(SceneManager* pSceneManager, std::vector<LightmapBaker::BAKE_VERTEX>& vertices);
+
+	// capture the static objects and bake their lightmap
+	bool BakeLightmaps(SceneManager* pSceneManager, bool bMeasureScaling);
+	// write the baked lightmap into a file
+	bool SaveLightmaps(const char* filename) const;
+	// read a baked lightmap from a file
+	bool LoadLightmaps(const char* filename);
+
+	// create the textures from the baked lightmap
+	bool CreateTextures();
+	// free the lightmap textures
+	void DestroyTextures();
+	// turn the lightmaps in the shading pass on or off
+	void SetEnabled(bool bEnabled);
+	// bind the lightmaps and set the lightmap values into the shader
+	void BindLightmap(ShaderManager* pShaderManager);
+};
@@ -1,186 +1,3076 @@
-///////////////////////////////////////////////////////////////////////////////
-// maincode.cpp
-// ============
-// gets called when application is launched - initializes GLEW, GLFW
-//
-//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
-//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
-///////////////////////////////////////////////////////////////////////////////
-
-#include <iostream>         // error handling and output
-#include <cstdlib>          // EXIT_FAILURE
-
-#include <GL/glew.h>        // GLEW library
-#include "GLFW/glfw3.h"     // GLFW library
-
-// GLM Math Header inclusions
-#include <glm/glm.hpp>
-#include <glm/gtx/transform.hpp>
-#include <glm/gtc/type_ptr.hpp>
-
-#include "SceneManager.h"
-#include "ViewManager.h"
-#include "ShapeMeshes.h"
-#include "ShaderManager.h"
-
-// Namespace for declaring global variables
-namespace
-{
-	// Macro for window title
-	const char* const WINDOW_TITLE = "5-2 Assignment"; 
-
-	// Main GLFW window
-	GLFWwindow* g_Window = nullptr;
-
-	// scene manager object for managing the 3D scene prepare and render
-	SceneManager* g_SceneManager = nullptr;
-	// shader manager object for dynamic interaction with the shader code
-	ShaderManager* g_ShaderManager = nullptr;
-	// view manager object for managing the 3D view setup and projection to 2D
-	ViewManager* g_ViewManager = nullptr;
-}
-
-// Function declarations - all functions that are called manually
-// need to be pre-declared at the beginning of the source code.
-bool InitializeGLFW();
-bool InitializeGLEW();
-
-
-/***********************************************************
- *  main(int, char*)
- *
- *  This function gets called after the application has been
- *  launched.
- ***********************************************************/
-int main(int argc, char* argv[])
-{
-	// if GLFW fails initialization, then terminate the application
-	if (InitializeGLFW() == false)
-	{
-		return(EXIT_FAILURE);
-	}
-
-	// try to create a new shader manager object
-	g_ShaderManager = new ShaderManager();
-	// try to create a new view manager object
-	g_ViewManager = new ViewManager(
-		g_ShaderManager);
-
-	// try to create the main display window
-	g_Window = g_ViewManager->CreateDisplayWindow(WINDOW_TITLE);
-
-	// if GLEW fails initialization, then terminate the application
-	if (InitializeGLEW() == false)
-	{
-		return(EXIT_FAILURE);
-	}
-
-	// load the shader code from the external GLSL files
-	g_ShaderManager->LoadShaders(
-		"shaders/vertexShader.glsl",
-		"shaders/fragmentShader.glsl");
-	g_ShaderManager->use();
-
-	// try to create a new scene manager object and prepare the 3D scene
-	g_SceneManager = new SceneManager(g_ShaderManager);
-	g_SceneManager->PrepareScene();
-
-	// loop will keep running until the application is closed 
-	// or until an error has occurred
-	while (!glfwWindowShouldClose(g_Window))
-	{
-		// Enable z-depth
-		glEnable(GL_DEPTH_TEST);
-
-		// Clear the frame and z buffers
-		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-		// convert from 3D object space to 2D view
-		g_ViewManager->PrepareSceneView();
-
-		// refresh the 3D scene
-		g_SceneManager->RenderScene();
-
-
-		// Flips the the back buffer with the front buffer every frame.
-		glfwSwapBuffers(g_Window);
-
-		// query the latest GLFW events
-		glfwPollEvents();
-	}
-
-	// clear the allocated manager objects from memory
-	if (NULL != g_SceneManager)
-	{
-		delete g_SceneManager;
-		g_SceneManager = NULL;
-	}
-	if (NULL != g_ViewManager)
-	{
-		delete g_ViewManager;
-		g_ViewManager = NULL;
-	}
-	if (NULL != g_ShaderManager)
-	{
-		delete g_ShaderManager;
-		g_ShaderManager = NULL;
-	}
-
-	// Terminates the program successfully
-	exit(EXIT_SUCCESS); 
-}
-
-/***********************************************************
- *	InitializeGLFW()
- * 
- *  This function is used to initialize the GLFW library.   
- ***********************************************************/
-bool InitializeGLFW()
-{
-	// GLFW: initialize and configure library
-	// --------------------------------------
-	glfwInit();
-
-#ifdef __APPLE__
-	// set the version of OpenGL and profile to use
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-#else
-	// set the version of OpenGL and profile to use
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
-	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-#endif
-	// GLFW: end -------------------------------
-
-	return(true);
-}
-
-/***********************************************************
- *	InitializeGLEW()
- *
- *  This function is used to initialize the GLEW library.
- ***********************************************************/
-bool InitializeGLEW()
-{
-	// GLEW: initialize
-	// -----------------------------------------
-	GLenum GLEWInitResult = GLEW_OK;
-
-	// try to initialize the GLEW library
-	GLEWInitResult = glewInit();
-	if (GLEW_OK != GLEWInitResult)
-	{
-		std::cerr << glewGetErrorString(GLEWInitResult) << std::endl;
-		return false;
-	}
-	// GLEW: end -------------------------------
-
-	// Displays a successful OpenGL initialization message
-	std::cout << "INFO: OpenGL Successfully Initialized\n";
-	std::cout << "INFO: OpenGL Version: " << glGetString(GL_VERSION) << "\n" << std::endl;
-
-	return(true);
-}
\ No newline at end of file
+///////////////////////////////////////////////////////////////////////////////
+// maincode.cpp
+// ============
+// gets called when application is launched - initializes GLEW, GLFW
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>         // error handling and output
+#include <cstdlib>          // EXIT_FAILURE
+#include <cstdio>           // removing the benchmark scene
+#include <cstring>          // strcmp
+#include <algorithm>        // std::max
+#include <vector>           // captured window pixels
+#include <thread>           // render thread
+#include <chrono>           // input latency
+#include <cmath>            // job benchmark items
+#include <random>           // pool benchmark order
+#include <string>           // uniform names
+
+#include <GL/glew.h>        // GLEW library
+#include "GLFW/glfw3.h"     // GLFW library
+
+// GLM Math Header inclusions
+#include <glm/glm.hpp>
+#include <glm/gtx/transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "SceneManager.h"
+#include "ViewManager.h"
+#include "ShapeMeshes.h"
+#include "ShaderManager.h"
+#include "LightManager.h"
+#include "ClusterManager.h"
+#include "DeferredManager.h"
+#include "TileManager.h"
+#include "VisibilityManager.h"
+#include "GpuTimer.h"
+#include "OverdrawCounter.h"
+#include "PrePassManager.h"
+#include "ShadowManager.h"
+#include "LightmapManager.h"
+#include "ProbeManager.h"
+#include "TransparencyManager.h"
+#include "ResolutionManager.h"
+#include "PostProcessManager.h"
+#include "EffectsManager.h"
+#include "RenderGraph.h"
+#include "RenderDevice.h"
+#include "ObjectManager.h"
+#include "TraceRecorder.h"
+#include "TracePlayer.h"
+#include "SnapshotBuffer.h"
+#include "JobSystem.h"
+#include "AllocationTracker.h"
+#include "FrameArena.h"
+#include "HandlePool.h"
+#include "EntityManager.h"
+#include "SceneFile.h"
+
+// Namespace for declaring global variables
+namespace
+{
+	// Macro for window title
+	const char* const WINDOW_TITLE = "5-2 Assignment"; 
+
+	// rendering paths that can be selected on the command line
+	enum RENDER_PATH
+	{
+		RENDER_DEFAULT,
+		RENDER_FORWARD,
+		RENDER_OBJECT_LIGHTS,
+		RENDER_CLUSTERED,
+		RENDER_TILED,
+		RENDER_DEFERRED,
+		RENDER_VISIBILITY
+	};
+
+	// Main GLFW window
+	GLFWwindow* g_Window = nullptr;
+
+	// scene manager object for managing the 3D scene prepare and render
+	SceneManager* g_SceneManager = nullptr;
+	// shader manager object for dynamic interaction with the shader code
+	ShaderManager* g_ShaderManager = nullptr;
+	// view manager object for managing the 3D view setup and projection to 2D
+	ViewManager* g_ViewManager = nullptr;
+	// light manager object for the buffered point and spot lights
+	LightManager* g_LightManager = nullptr;
+	// cluster manager object for binning the lights when clustered lighting is used
+	ClusterManager* g_ClusterManager = nullptr;
+	// tile manager object for the depth pre-pass and the compute light culling
+	TileManager* g_TileManager = nullptr;
+	// deferred manager object for the G-buffer and the lighting pass
+	DeferredManager* g_DeferredManager = nullptr;
+	// visibility manager object for the visibility buffer and the resolve pass
+	VisibilityManager* g_VisibilityManager = nullptr;
+	// pre-pass manager object for drawing the depth before shading
+	PrePassManager* g_PrePassManager = nullptr;
+	// shadow manager object for the cached shadow maps of the scene lights
+	ShadowManager* g_ShadowManager = nullptr;
+	// lightmap manager object for baking and sampling the static lighting
+	LightmapManager* g_LightmapManager = nullptr;
+	// probe manager object for the irradiance probes of the unbaked objects
+	ProbeManager* g_ProbeManager = nullptr;
+	// transparency manager object for blending the translucent objects
+	TransparencyManager* g_TransparencyManager = nullptr;
+	// resolution object for scaling the scene to the GPU time budget
+	ResolutionManager* g_ResolutionManager = nullptr;
+	// post-process object for smoothing the edges of the scene
+	PostProcessManager* g_PostProcessManager = nullptr;
+	// effects object for the ambient occlusion of the post-processed scene
+	EffectsManager* g_EffectsManager = nullptr;
+	// render graph object for the passes after the scene is drawn
+	RenderGraph* g_RenderGraph = nullptr;
+	// render device object for drawing the added objects
+	RenderDevice* g_RenderDevice = nullptr;
+	// object manager object for placing and drawing the added objects
+	ObjectManager* g_ObjectManager = nullptr;
+	// recorder object for tracing the OpenGL calls of a frame
+	TraceRecorder* g_TraceRecorder = nullptr;
+	// timer object for measuring the GPU time of each frame
+	GpuTimer* g_GpuTimer = nullptr;
+	// counter object for measuring the shaded fragments of each frame
+	OverdrawCounter* g_OverdrawCounter = nullptr;
+	// snapshot buffer object for handing the updated frames to the drawing
+	SnapshotBuffer* g_SnapshotBuffer = nullptr;
+	// job system object for the loading and recording work of the managers
+	JobSystem* g_JobSystem = nullptr;
+
+	// rendering path used for drawing the scene
+	RENDER_PATH g_renderPath = RENDER_DEFAULT;
+	// number of animated lights to add for benchmarking
+	int g_benchmarkLightCount = 0;
+	// true when the rendering paths are compared and the application exits
+	bool g_bRunBenchmark = false;
+	// true when the forward paths draw a depth pre-pass before shading
+	bool g_bDepthPrePass = false;
+	// true when the frame times are periodically reported
+	bool g_bReportStats = false;
+	// true when the scene lights cast shadows
+	bool g_bShadows = true;
+	// true when the objects with a motion are animated as dynamic objects
+	bool g_bAnimateObjects = false;
+	// true when the lightmaps are baked and saved
+	bool g_bBakeLightmaps = false;
+	// true when the bake is measured with 1 to 64 threads
+	bool g_bBakeScaling = false;
+	// true when the static lights are sampled from the lightmaps
+	bool g_bUseLightmaps = false;
+	// true when the ambient light comes from the irradiance probes
+	bool g_bUseProbes = false;
+	// true when the translucent objects are drawn after the opaque ones
+	bool g_bTransparency = false;
+	// how the translucent objects are blended over the opaque ones
+	TransparencyManager::TRANSPARENCY_MODE g_transparencyMode = TransparencyManager::TRANSPARENCY_WEIGHTED;
+	// number of instanced translucent boxes to add
+	int g_transparentBoxCount = 0;
+	// true when sorted and weighted blending are compared and the application exits
+	bool g_bRunTransparencyBenchmark = false;
+	// true when the scene is drawn at a resolution scaled to the GPU time budget
+	bool g_bDynamicResolution = false;
+	// GPU frame time in milliseconds that the resolution is scaled to
+	double g_gpuBudgetMilliseconds = 16.6;
+	// true when the camera follows the test path, then the application exits
+	bool g_bRunResolutionPath = false;
+	// true when the scene is drawn offscreen and anti-aliased into the window
+	bool g_bPostProcess = false;
+	// anti-aliasing applied to the scene
+	PostProcessManager::AA_MODE g_antiAliasingMode = PostProcessManager::AA_NONE;
+	// true when the anti-aliasing modes are compared and the application exits
+	bool g_bRunAntiAliasingBenchmark = false;
+	// true when the ambient occlusion darkens the post-processed scene
+	bool g_bAmbientOcclusion = false;
+	// resolution the ambient occlusion is estimated at
+	EffectsManager::EFFECT_RESOLUTION g_effectResolution = EffectsManager::RESOLUTION_HALF;
+	// true when the effect resolutions are compared and the application exits
+	bool g_bRunEffectsBenchmark = false;
+	// number of boxes drawn through the render device
+	int g_objectCount = 0;
+	// number of boxes the null backend is measured with, then the application exits
+	int g_nullBenchmarkObjectCount = 0;
+	// index of the frame whose OpenGL calls are traced, or -1
+	int g_traceFrame = -1;
+	// trace file that is replayed without the scene, then the application exits
+	const char* g_replayFilename = NULL;
+	// true when the frames are drawn on a render thread that owns the context
+	bool g_bRenderThread = false;
+	// true when the job system is measured, then the application exits
+	bool g_bRunJobBenchmark = false;
+	// true when the handle pools are measured, then the application exits
+	bool g_bRunPoolBenchmark = false;
+	// true when the entity systems are measured, then the application exits
+	bool g_bRunEcsBenchmark = false;
+	// number of objects the scene file reloads are measured with
+	int g_sceneBenchmarkObjectCount = 0;
+	// CPU time in milliseconds that every scene update is made to take
+	double g_updateLoadMilliseconds = 0.0;
+	// true when the heap allocations of each profiling scope are reported
+	bool g_bReportAllocations = false;
+	// true when a steady frame that allocates fails the run, and whether
+	// one did
+	bool g_bAllocationTest = false;
+	bool g_bAllocationTestFailed = false;
+
+	// snapshot of the frame being drawn, or NULL for the benchmark frames
+	const SnapshotBuffer::FRAME_SNAPSHOT* g_pDrawnSnapshot = NULL;
+	// number of scene updates and of drawn frames since the loop started
+	unsigned long long g_updateIndex = 0;
+	int g_frameIndex = 0;
+	// time the loop and the camera path started, and the last frame was shown
+	double g_pathStartTime = 0.0;
+	double g_lastFrameTime = 0.0;
+	// latency from reading the input to showing its first frame, since
+	// the last frame time report
+	double g_inputLatencyMilliseconds = 0.0;
+	int g_inputLatencyFrames = 0;
+
+	// scene file read at startup unless another one is passed in, and
+	// the file the scene is read from
+	const char* const SCENE_FILENAME = "scenes/default.scene";
+	const char* g_sceneFilename = SCENE_FILENAME;
+	// seconds between the checks for a changed scene file, and the
+	// time of the last check
+	const double SCENE_WATCH_SECONDS = 0.5;
+	double g_lastSceneCheckTime = 0.0;
+	// file the scene benchmark writes its scenes into
+	const char* const SCENE_BENCHMARK_FILENAME = "scene_benchmark.scene";
+	// materials the benchmark objects are drawn with, and half size of
+	// the cube they are scattered in
+	const int SCENE_BENCHMARK_MATERIALS = 8;
+	const float SCENE_BENCHMARK_HALF_EXTENT = 500.0f;
+	// every how many objects one is changed by the partial edits
+	const int SCENE_BENCHMARK_EDIT_INTERVAL = 100;
+	// file the baked lightmaps are saved to and loaded from
+	const char* const LIGHTMAP_FILENAME = "textures/scene.lightmap";
+	// file the traced frame is saved to
+	const char* const TRACE_FILENAME = "frame.gltrace";
+
+	// seconds between the updates of the main thread while a render
+	// thread draws, so that the update does not spin on a core
+	const double RENDER_THREAD_UPDATE_SECONDS = 1.0 / 240.0;
+	// number of frames averaged for each frame time report
+	const int FRAME_REPORT_INTERVAL = 120;
+	// number of frames drawn before each benchmark measurement starts
+	const int BENCHMARK_WARMUP_FRAMES = 30;
+	// light counts that every rendering path is measured with
+	const int BENCHMARK_LIGHT_COUNTS[] = { 5, 100, 5000 };
+	// instanced translucent boxes that the blending methods are measured with
+	const int BENCHMARK_TRANSPARENT_BOXES = 10000;
+	// frames the null backend is measured over along the camera path
+	const int NULL_BENCHMARK_FRAMES = 120;
+	// recording threads the null backend is measured with
+	const int NULL_BENCHMARK_THREAD_COUNTS[] = { 1, 2, 4, 8, 16, 32 };
+	// threads the job system is measured with
+	const int JOB_BENCHMARK_THREAD_COUNTS[] = { 1, 2, 4, 8, 16, 32 };
+	// empty jobs the spawn overhead is measured over
+	const int JOB_BENCHMARK_SPAWNS = 1000000;
+	// items of the measured parallel for, and the items of each range
+	const size_t JOB_BENCHMARK_ITEMS = 10000000;
+	const size_t JOB_BENCHMARK_GRAIN = 16384;
+	// times each job benchmark is repeated
+	const int JOB_BENCHMARK_REPEATS = 5;
+	// objects created and destroyed by the pool benchmark
+	const int POOL_BENCHMARK_OBJECTS = 1000000;
+
+	// object of the pool benchmark, laid out like a placed box
+	struct POOL_BENCHMARK_OBJECT
+	{
+		glm::mat4 model;
+		glm::vec4 color;
+		glm::vec3 center;
+		float radius;
+	};
+	// entities the entity systems are measured with, and the threads
+	const int ECS_BENCHMARK_ENTITY_COUNTS[] = { 10000, 100000, 1000000 };
+	const int ECS_BENCHMARK_THREAD_COUNTS[] = { 1, 2, 4, 8 };
+	// times each entity system is run for one measurement
+	const int ECS_BENCHMARK_REPEATS = 5;
+	// half size of the cube the entities are scattered in
+	const float ECS_BENCHMARK_HALF_EXTENT = 500.0f;
+	// frames drawn before the allocation test expects steady frames,
+	// and the steady frames it checks before it passes
+	const int ALLOCATION_TEST_WARMUP_FRAMES = 60;
+	const int ALLOCATION_TEST_FRAMES = 600;
+
+	// uniform names set every frame that are too long for the short
+	// string buffer, built once so that setting them never allocates
+	const std::string g_UseObjectLightsName = "bUseObjectLights";
+	const std::string g_TransparencyPassName = "transparencyPass";
+
+	// camera positions and the points they look at along the test
+	// path of the dynamic resolution, which ends where it starts
+	struct CAMERA_WAYPOINT
+	{
+		glm::vec3 position;
+		glm::vec3 target;
+	};
+	const CAMERA_WAYPOINT CAMERA_PATH[] =
+	{
+		{ glm::vec3(0.0f, 2.0f, 12.0f), glm::vec3(0.0f, 2.0f, 0.0f) },
+		{ glm::vec3(9.0f, 4.0f, 7.0f), glm::vec3(0.0f, 1.0f, 0.0f) },
+		{ glm::vec3(3.0f, 1.5f, 2.5f), glm::vec3(0.0f, 1.0f, -1.0f) },
+		{ glm::vec3(-4.0f, 2.0f, 1.0f), glm::vec3(2.0f, 1.0f, -2.0f) },
+		{ glm::vec3(-9.0f, 6.0f, 8.0f), glm::vec3(0.0f, 1.0f, 0.0f) },
+		{ glm::vec3(0.0f, 2.0f, 12.0f), glm::vec3(0.0f, 2.0f, 0.0f) }
+	};
+	// seconds the camera takes between two waypoints
+	const float CAMERA_PATH_SEGMENT_SECONDS = 4.0f;
+
+	// rendering path settings measured by the benchmark
+	struct BENCHMARK_RUN
+	{
+		RENDER_PATH renderPath;
+		bool bDepthPrePass;
+		const char* name;
+	};
+	const BENCHMARK_RUN BENCHMARK_RUNS[] =
+	{
+		{ RENDER_FORWARD, false, "forward" },
+		{ RENDER_FORWARD, true, "forward + pre-pass" },
+		{ RENDER_OBJECT_LIGHTS, false, "object lights" },
+		{ RENDER_OBJECT_LIGHTS, true, "object lights + pre-pass" },
+		{ RENDER_CLUSTERED, false, "clustered" },
+		{ RENDER_CLUSTERED, true, "clustered + pre-pass" },
+		{ RENDER_TILED, false, "tiled" },
+		{ RENDER_DEFERRED, false, "deferred" },
+		{ RENDER_VISIBILITY, false, "visibility" }
+	};
+}
+
+// Function declarations - all functions that are called manually
+// need to be pre-declared at the beginning of the source code.
+bool InitializeGLFW();
+bool InitializeGLEW();
+void ParseCommandLine(int argc, char* argv[]);
+void RenderFrame(RENDER_PATH renderPath, bool bDepthPrePass);
+void RenderTransparency();
+void RunBenchmark();
+void RunTransparencyBenchmark();
+void RunAntiAliasingBenchmark();
+void RunEffectsBenchmark();
+void RunNullBenchmark(int objectCount);
+void RunJobBenchmark();
+void RunPoolBenchmark();
+void RunEcsBenchmark();
+void RunSceneBenchmark(int objectCount);
+void ExecuteEmptyJob(void* pOwner, size_t first, size_t count);
+void ExecuteBenchmarkItems(void* pOwner, size_t first, size_t count);
+bool RunTraceReplay(const char* filename);
+void ExecuteAntiAliasingPass(RenderGraph& graph, void* pOwner, int tag);
+bool PlaceCameraOnPath(float pathSeconds);
+void UpdateFrame();
+void WaitForNextUpdate(double& nextUpdateTime);
+void DrawWindowFrame();
+void CheckSceneFile();
+void CheckFrameAllocations();
+void RunRenderThread();
+void ReportFrameTime(double frameSeconds);
+
+
+/***********************************************************
+ *  main(int, char*)
+ *
+ *  This function gets called after the application has been
+ *  launched.
+ ***********************************************************/
+int main(int argc, char* argv[])
+{
+	// read the rendering options from the command line
+	ParseCommandLine(argc, argv);
+
+	// the null backend needs no window or OpenGL context
+	if (g_nullBenchmarkObjectCount > 0)
+	{
+		RunNullBenchmark(g_nullBenchmarkObjectCount);
+		return(EXIT_SUCCESS);
+	}
+	// neither does the job system
+	if (g_bRunJobBenchmark == true)
+	{
+		RunJobBenchmark();
+		return(EXIT_SUCCESS);
+	}
+	// nor do the handle pools
+	if (g_bRunPoolBenchmark == true)
+	{
+		RunPoolBenchmark();
+		return(EXIT_SUCCESS);
+	}
+	// nor do the entity systems
+	if (g_bRunEcsBenchmark == true)
+	{
+		RunEcsBenchmark();
+		return(EXIT_SUCCESS);
+	}
+	// nor does reading the scene files
+	if (g_sceneBenchmarkObjectCount > 0)
+	{
+		RunSceneBenchmark(g_sceneBenchmarkObjectCount);
+		return(EXIT_SUCCESS);
+	}
+	// the replayed trace needs none of the scene objects
+	if (NULL != g_replayFilename)
+	{
+		return((RunTraceReplay(g_replayFilename) == true) ? EXIT_SUCCESS : EXIT_FAILURE);
+	}
+
+	// if GLFW fails initialization, then terminate the application
+	if (InitializeGLFW() == false)
+	{
+		return(EXIT_FAILURE);
+	}
+
+	// try to create a new shader manager object
+	g_ShaderManager = new ShaderManager();
+	// try to create a new view manager object
+	g_ViewManager = new ViewManager(
+		g_ShaderManager);
+
+	// try to create the main display window
+	g_Window = g_ViewManager->CreateDisplayWindow(WINDOW_TITLE);
+
+	// if GLEW fails initialization, then terminate the application
+	if (InitializeGLEW() == false)
+	{
+		return(EXIT_FAILURE);
+	}
+
+	// hook the OpenGL entry points before any object is created,
+	// so the traced frame sees every call
+	if (g_traceFrame >= 0)
+	{
+		if (TraceRecorder::InstallHooks() == false)
+		{
+			std::cout << "WARNING: The OpenGL 1.1 calls are only traced on Windows" << std::endl;
+		}
+		g_TraceRecorder = new TraceRecorder();
+	}
+
+	// load the shader code from the external GLSL files - the
+	// buffered light paths all read the lights from the light buffer
+	if (g_renderPath != RENDER_DEFAULT)
+	{
+		g_ShaderManager->LoadShaders(
+			"shaders/vertexShader.glsl",
+			"shaders/clusteredFragmentShader.glsl");
+	}
+	else
+	{
+		g_ShaderManager->LoadShaders(
+			"shaders/vertexShader.glsl",
+			"shaders/fragmentShader.glsl");
+	}
+	g_ShaderManager->use();
+
+	// the managers share one job system with a thread per core
+	g_JobSystem = new JobSystem((int)std::thread::hardware_concurrency());
+
+	// try to create a new scene manager object and prepare the 3D scene
+	g_SceneManager = new SceneManager(g_ShaderManager);
+	g_SceneManager->SetJobSystem(g_JobSystem);
+	g_SceneManager->SetDynamicObjects(g_bAnimateObjects);
+	if (g_renderPath == RENDER_DEFAULT)
+	{
+		// only the scene lights of the default path cast shadows
+		g_ShadowManager = new ShadowManager();
+		g_ShadowManager->CreateShadowMaps();
+		g_ShadowManager->LoadShaders();
+		g_ShadowManager->SetEnabled(g_bShadows);
+		g_SceneManager->SetShadowManager(g_ShadowManager);
+	}
+	if ((g_renderPath == RENDER_DEFAULT) &&
+		((g_bBakeLightmaps == true) || (g_bUseLightmaps == true) || (g_bUseProbes == true)))
+	{
+		// the baked light replaces the static lights of the default path,
+		// the probes are baked from the same captured scene and lights
+		g_LightmapManager = new LightmapManager();
+		g_LightmapManager->LoadShaders();
+		g_SceneManager->SetLightmapManager(g_LightmapManager);
+		if (g_bUseProbes == true)
+		{
+			g_ProbeManager = new ProbeManager();
+		}
+	}
+	if ((g_renderPath == RENDER_DEFAULT) && (g_bTransparency == true))
+	{
+		// the translucent objects of the default path are drawn last
+		g_TransparencyManager = new TransparencyManager();
+		g_TransparencyManager->CreateTargets(
+			g_ViewManager->GetWindowWidth(),
+			g_ViewManager->GetWindowHeight());
+		g_TransparencyManager->LoadShaders();
+		if (g_transparentBoxCount > 0)
+		{
+			g_TransparencyManager->CreateInstances(g_transparentBoxCount);
+		}
+	}
+	if (g_bDynamicResolution == true)
+	{
+		g_ResolutionManager = new ResolutionManager();
+		g_ResolutionManager->CreateTarget(
+			g_ViewManager->GetWindowWidth(),
+			g_ViewManager->GetWindowHeight());
+		g_ResolutionManager->LoadShaders();
+		g_ResolutionManager->SetBudget(g_gpuBudgetMilliseconds);
+	}
+	if (g_bPostProcess == true)
+	{
+		g_PostProcessManager = new PostProcessManager();
+		g_PostProcessManager->CreateTargets(
+			g_ViewManager->GetWindowWidth(),
+			g_ViewManager->GetWindowHeight());
+		g_PostProcessManager->LoadShaders();
+		g_PostProcessManager->SetMode(g_antiAliasingMode);
+		g_PostProcessManager->SetPassTiming(g_bReportStats);
+
+		g_RenderGraph = new RenderGraph();
+	}
+	if ((g_bAmbientOcclusion == true) && (NULL != g_PostProcessManager))
+	{
+		g_EffectsManager = new EffectsManager();
+		g_EffectsManager->SetWindowSize(
+			g_ViewManager->GetWindowWidth(),
+			g_ViewManager->GetWindowHeight());
+		g_EffectsManager->LoadShaders();
+		g_EffectsManager->SetResolution(g_effectResolution);
+		g_EffectsManager->SetPassTiming(g_bReportStats);
+	}
+	if (g_objectCount > 0)
+	{
+		g_RenderDevice = new RenderDevice(RenderDevice::BACKEND_OPENGL);
+		g_ObjectManager = new ObjectManager(g_RenderDevice);
+		g_ObjectManager->SetJobSystem(g_JobSystem);
+		if (g_ObjectManager->CreateResources() == true)
+		{
+			g_ObjectManager->CreateObjects(g_objectCount);
+		}
+		else
+		{
+			std::cout << "ERROR: Could not create the resources of the objects" << std::endl;
+			delete g_ObjectManager;
+			g_ObjectManager = NULL;
+		}
+		g_ShaderManager->use();
+	}
+	if (g_renderPath != RENDER_DEFAULT)
+	{
+		g_LightManager = new LightManager();
+		g_LightManager->CreateBuffers();
+		g_SceneManager->SetLightManager(g_LightManager);
+
+		g_ClusterManager = new ClusterManager();
+		g_ClusterManager->CreateBuffers();
+
+		if ((g_renderPath == RENDER_TILED) || (g_bRunBenchmark == true))
+		{
+			g_TileManager = new TileManager();
+			g_TileManager->CreateBuffers(
+				g_ViewManager->GetWindowWidth(),
+				g_ViewManager->GetWindowHeight());
+			g_TileManager->LoadShaders();
+		}
+		if ((g_renderPath == RENDER_DEFERRED) || (g_bRunBenchmark == true))
+		{
+			g_DeferredManager = new DeferredManager();
+			g_DeferredManager->CreateGBuffer(
+				g_ViewManager->GetWindowWidth(),
+				g_ViewManager->GetWindowHeight());
+			g_DeferredManager->LoadShaders();
+		}
+		if ((g_renderPath == RENDER_VISIBILITY) || (g_bRunBenchmark == true))
+		{
+			g_VisibilityManager = new VisibilityManager();
+			g_VisibilityManager->CreateBuffers(
+				g_ViewManager->GetWindowWidth(),
+				g_ViewManager->GetWindowHeight());
+			g_VisibilityManager->LoadShaders();
+		}
+
+	}
+	if (g_bDepthPrePass == true)
+	{
+		g_PrePassManager = new PrePassManager();
+		g_PrePassManager->LoadShaders();
+	}
+	if ((g_bReportStats == true) || (g_bDynamicResolution == true))
+	{
+		// the dynamic resolution is scaled by the measured GPU time
+		g_GpuTimer = new GpuTimer();
+		g_GpuTimer->CreateQueries();
+	}
+	if (g_bReportStats == true)
+	{
+		g_OverdrawCounter = new OverdrawCounter();
+		g_OverdrawCounter->CreateQueries();
+	}
+	g_ShaderManager->use();
+	g_SceneManager->PrepareScene(g_sceneFilename);
+	if (g_bReportAllocations == true)
+	{
+		std::cout << "INFO: Heap allocations by scope at startup" << std::endl;
+		AllocationTracker::ReportCounters(1);
+	}
+	if (g_benchmarkLightCount > 0)
+	{
+		g_SceneManager->CreateBenchmarkLights(g_benchmarkLightCount);
+	}
+	if ((NULL != g_LightmapManager) &&
+		((g_bBakeLightmaps == true) || (g_bUseLightmaps == true)))
+	{
+		bool bLightmapReady = false;
+
+		if (g_bBakeLightmaps == true)
+		{
+			bLightmapReady = g_LightmapManager->BakeLightmaps(g_SceneManager, g_bBakeScaling);
+			if (bLightmapReady == true)
+			{
+				g_LightmapManager->SaveLightmaps(LIGHTMAP_FILENAME);
+			}
+			g_ShaderManager->use();
+			g_SceneManager->SetShaderManager(g_ShaderManager);
+		}
+		else
+		{
+			bLightmapReady = g_LightmapManager->LoadLightmaps(LIGHTMAP_FILENAME);
+		}
+
+		if (g_bUseLightmaps == false)
+		{
+			// only baking was asked for, skip the interactive loop
+			glfwSetWindowShouldClose(g_Window, GLFW_TRUE);
+		}
+		else if (bLightmapReady == true)
+		{
+			g_LightmapManager->CreateTextures();
+		}
+	}
+	if (NULL != g_ProbeManager)
+	{
+		g_ProbeManager->UpdateProbes(g_LightmapManager, g_SceneManager);
+		g_ShaderManager->use();
+		g_SceneManager->SetShaderManager(g_ShaderManager);
+	}
+	if (g_bReportStats == true)
+	{
+		// do not let the display refresh rate limit the measured frame rate
+		glfwSwapInterval(0);
+	}
+
+	// compare the rendering paths and skip the interactive loop
+	if (g_bRunBenchmark == true)
+	{
+		RunBenchmark();
+		glfwSetWindowShouldClose(g_Window, GLFW_TRUE);
+	}
+	// compare the blending of the translucent objects and skip the interactive loop
+	if ((g_bRunTransparencyBenchmark == true) && (NULL != g_TransparencyManager))
+	{
+		RunTransparencyBenchmark();
+		glfwSetWindowShouldClose(g_Window, GLFW_TRUE);
+	}
+	// compare the anti-aliasing modes and skip the interactive loop
+	if ((g_bRunAntiAliasingBenchmark == true) && (NULL != g_PostProcessManager))
+	{
+		RunAntiAliasingBenchmark();
+		glfwSetWindowShouldClose(g_Window, GLFW_TRUE);
+	}
+	// compare the effect resolutions and skip the interactive loop
+	if ((g_bRunEffectsBenchmark == true) && (NULL != g_EffectsManager))
+	{
+		RunEffectsBenchmark();
+		glfwSetWindowShouldClose(g_Window, GLFW_TRUE);
+	}
+	g_lastFrameTime = glfwGetTime();
+	g_pathStartTime = g_lastFrameTime;
+	// the frames are counted from here, without the startup
+	AllocationTracker::EndFrame();
+	AllocationTracker::ResetCounters();
+
+	// the first frame is drawn from an updated snapshot
+	g_SnapshotBuffer = new SnapshotBuffer();
+	UpdateFrame();
+
+	if (g_bRenderThread == true)
+	{
+		// hand the OpenGL context over to the render thread, while
+		// this thread keeps reading the input and updating the scene
+		glfwMakeContextCurrent(NULL);
+		std::thread renderThread(RunRenderThread);
+		double nextUpdateTime = glfwGetTime();
+		while (!glfwWindowShouldClose(g_Window))
+		{
+			UpdateFrame();
+			WaitForNextUpdate(nextUpdateTime);
+		}
+		renderThread.join();
+		glfwMakeContextCurrent(g_Window);
+	}
+	else
+	{
+		// loop will keep running until the application is closed 
+		// or until an error has occurred
+		while (!glfwWindowShouldClose(g_Window))
+		{
+			DrawWindowFrame();
+			UpdateFrame();
+		}
+	}
+
+	// clear the allocated manager objects from memory
+	if (NULL != g_SceneManager)
+	{
+		delete g_SceneManager;
+		g_SceneManager = NULL;
+	}
+	if (NULL != g_GpuTimer)
+	{
+		delete g_GpuTimer;
+		g_GpuTimer = NULL;
+	}
+	if (NULL != g_TraceRecorder)
+	{
+		delete g_TraceRecorder;
+		g_TraceRecorder = NULL;
+	}
+	if (NULL != g_OverdrawCounter)
+	{
+		delete g_OverdrawCounter;
+		g_OverdrawCounter = NULL;
+	}
+	if (NULL != g_SnapshotBuffer)
+	{
+		delete g_SnapshotBuffer;
+		g_SnapshotBuffer = NULL;
+	}
+	if (NULL != g_PrePassManager)
+	{
+		delete g_PrePassManager;
+		g_PrePassManager = NULL;
+	}
+	if (NULL != g_ShadowManager)
+	{
+		delete g_ShadowManager;
+		g_ShadowManager = NULL;
+	}
+	if (NULL != g_ProbeManager)
+	{
+		delete g_ProbeManager;
+		g_ProbeManager = NULL;
+	}
+	if (NULL != g_TransparencyManager)
+	{
+		delete g_TransparencyManager;
+		g_TransparencyManager = NULL;
+	}
+	if (NULL != g_ResolutionManager)
+	{
+		delete g_ResolutionManager;
+		g_ResolutionManager = NULL;
+	}
+	if (NULL != g_RenderGraph)
+	{
+		delete g_RenderGraph;
+		g_RenderGraph = NULL;
+	}
+	if (NULL != g_ObjectManager)
+	{
+		delete g_ObjectManager;
+		g_ObjectManager = NULL;
+	}
+	if (NULL != g_RenderDevice)
+	{
+		delete g_RenderDevice;
+		g_RenderDevice = NULL;
+	}
+	if (NULL != g_EffectsManager)
+	{
+		delete g_EffectsManager;
+		g_EffectsManager = NULL;
+	}
+	if (NULL != g_PostProcessManager)
+	{
+		delete g_PostProcessManager;
+		g_PostProcessManager = NULL;
+	}
+	if (NULL != g_LightmapManager)
+	{
+		delete g_LightmapManager;
+		g_LightmapManager = NULL;
+	}
+	if (NULL != g_DeferredManager)
+	{
+		delete g_DeferredManager;
+		g_DeferredManager = NULL;
+	}
+	if (NULL != g_TileManager)
+	{
+		delete g_TileManager;
+		g_TileManager = NULL;
+	}
+	if (NULL != g_VisibilityManager)
+	{
+		delete g_VisibilityManager;
+		g_VisibilityManager = NULL;
+	}
+	if (NULL != g_ClusterManager)
+	{
+		delete g_ClusterManager;
+		g_ClusterManager = NULL;
+	}
+	if (NULL != g_LightManager)
+	{
+		delete g_LightManager;
+		g_LightManager = NULL;
+	}
+	if (NULL != g_ViewManager)
+	{
+		delete g_ViewManager;
+		g_ViewManager = NULL;
+	}
+	if (NULL != g_ShaderManager)
+	{
+		delete g_ShaderManager;
+		g_ShaderManager = NULL;
+	}
+	if (NULL != g_JobSystem)
+	{
+		delete g_JobSystem;
+		g_JobSystem = NULL;
+	}
+
+	// Terminates the program, unsuccessfully when a steady frame allocated
+	exit((g_bAllocationTestFailed == true) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+/***********************************************************
+ *	InitializeGLFW()
+ * 
+ *  This function is used to initialize the GLFW library.   
+ ***********************************************************/
+bool InitializeGLFW()
+{
+	// GLFW: initialize and configure library
+	// --------------------------------------
+	glfwInit();
+
+#ifdef __APPLE__
+	// set the version of OpenGL and profile to use
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#else
+	// set the version of OpenGL and profile to use
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#endif
+	// GLFW: end -------------------------------
+
+	return(true);
+}
+
+/***********************************************************
+ *	InitializeGLEW()
+ *
+ *  This function is used to initialize the GLEW library.
+ ***********************************************************/
+bool InitializeGLEW()
+{
+	// GLEW: initialize
+	// -----------------------------------------
+	GLenum GLEWInitResult = GLEW_OK;
+
+	// try to initialize the GLEW library
+	GLEWInitResult = glewInit();
+	if (GLEW_OK != GLEWInitResult)
+	{
+		std::cerr << glewGetErrorString(GLEWInitResult) << std::endl;
+		return false;
+	}
+	// GLEW: end -------------------------------
+
+	// Displays a successful OpenGL initialization message
+	std::cout << "INFO: OpenGL Successfully Initialized\n";
+	std::cout << "INFO: OpenGL Version: " << glGetString(GL_VERSION) << "\n" << std::endl;
+
+	return(true);
+}
+
+/***********************************************************
+ *	ParseCommandLine()
+ *
+ *  This function is used to read the rendering options that
+ *  were passed in on the command line.
+ *
+ *    --scene <file>    read the scene from <file> rather than
+ *                      scenes/default.scene, the file is read
+ *                      again whenever it is saved
+ *    --forward         shade every buffered light for every
+ *                      fragment in a single forward pass
+ *    --object-lights   shade only the lights that reach each
+ *                      object in a single forward pass
+ *    --clustered       shade point and spot lights with
+ *                      clustered forward lighting
+ *    --tiled           shade point and spot lights with
+ *                      light lists culled per screen tile by
+ *                      a compute pass after a depth pre-pass
+ *    --deferred        shade point and spot lights with
+ *                      deferred shading and light volumes
+ *    --lights <count>  add <count> animated lights and report
+ *                      frame times (uses --clustered unless
+ *                      another path was selected)
+ *    --visibility      write draw and triangle IDs per pixel,
+ *                      then shade each pixel once in a
+ *                      full screen resolve pass
+ *    --prepass         draw the depth first and shade each
+ *                      pixel once (default, forward, object
+ *                      lights and clustered paths)
+ *    --no-shadows      do not draw the shadows of the scene
+ *                      lights (default path)
+ *    --animate         move the objects with a motion, so that
+ *                      their shadows are drawn over the cached
+ *                      shadow maps
+ *    --bake-lightmaps  bake the static lighting on all CPU
+ *                      cores, save it to textures/, then exit
+ *    --bake-scaling    bake with 1 to 64 threads and report
+ *                      the bake time of each
+ *    --lightmaps       shade the static objects from the
+ *                      saved lightmaps (default path)
+ *    --probes          bake a grid of irradiance probes and
+ *                      use it for the ambient light of the
+ *                      objects without lightmaps (default path)
+ *    --oit             draw the translucent objects after the
+ *                      opaque ones with weighted blended
+ *                      order-independent transparency
+ *                      (default path)
+ *    --sorted-blend    draw the translucent objects after the
+ *                      opaque ones, sorted from back to front
+ *                      and blended over the window
+ *    --transparent-boxes <count>
+ *                      add <count> instanced translucent boxes
+ *    --oit-benchmark   measure sorted and weighted blending
+ *                      with 10000 translucent boxes, then exit
+ *    --dynamic-resolution
+ *                      draw the scene at a resolution scaled
+ *                      to keep the GPU time within the budget
+ *                      and upscale it into the window (default,
+ *                      forward, object lights and clustered
+ *                      paths)
+ *    --gpu-budget <ms> GPU frame time the dynamic resolution
+ *                      aims for, 16.6 ms unless set
+ *    --resolution-path fly the camera along a test path with
+ *                      the dynamic resolution and report the
+ *                      scale and GPU time, then exit
+ *    --fxaa            smooth the edges with FXAA (default,
+ *                      forward, object lights and clustered
+ *                      paths, as are the other AA options)
+ *    --smaa            smooth the edges with SMAA
+ *    --taa             jitter the view and blend each frame
+ *                      with the reprojected earlier frames
+ *    --ssaa            draw at 4x the width and height and
+ *                      average down into the window
+ *    --aa-benchmark    measure each anti-aliasing mode and its
+ *                      difference from the supersampled one,
+ *                      then exit
+ *    --ssao            darken the scene with ambient occlusion
+ *                      estimated at half resolution and
+ *                      upsampled along the depth edges (same
+ *                      paths as anti-aliasing)
+ *    --ssao-full       estimate the ambient occlusion at full
+ *                      resolution
+ *    --ssao-quarter    estimate the ambient occlusion at
+ *                      quarter resolution
+ *    --ssao-benchmark  measure the ambient occlusion at full,
+ *                      half and quarter resolution and the
+ *                      difference from the full one, then exit
+ *    --objects <count> add <count> boxes drawn one by one
+ *                      through the render device (default,
+ *                      forward, object lights, clustered and
+ *                      tiled paths)
+ *    --null-benchmark <count>
+ *                      record and submit <count> boxes along
+ *                      the camera path with the null backend
+ *                      on 1 to 32 recording threads and
+ *                      report the CPU times, without opening
+ *                      a window, then exit
+ *    --job-benchmark   measure the overhead of spawning jobs
+ *                      and a parallel for over 10M items on
+ *                      1 to 32 threads of the job system,
+ *                      without opening a window, then exit
+ *    --pool-benchmark  create and destroy 1M objects in a
+ *                      handle pool and on the general heap,
+ *                      iterate over them and check that the
+ *                      handles of destroyed objects are found
+ *                      to be stale, without opening a window,
+ *                      then exit
+ *    --ecs-benchmark   create 10k, 100k and 1M entities, run
+ *                      the transform and culling systems on
+ *                      1 to 8 threads of the job system and
+ *                      destroy half of them, without opening
+ *                      a window, then exit
+ *    --scene-benchmark <count>
+ *                      write a scene file of <count> objects,
+ *                      read it, then read it again unchanged,
+ *                      with 1% of the objects moved, with 1%
+ *                      replaced and with all of them moved,
+ *                      and report the CPU times, without
+ *                      opening a window, then exit
+ *    --trace <frame>   record the OpenGL calls of frame <frame>
+ *                      with the objects and state they start
+ *                      from into frame.gltrace, and report
+ *                      the calls by type
+ *    --replay <file>   replay a traced frame in a hidden window
+ *                      without the scene and report the CPU
+ *                      time of each call type and the GPU
+ *                      time, then exit
+ *    --render-thread   draw the frames on a render thread that
+ *                      owns the OpenGL context, from snapshots
+ *                      of the camera and scene time updated on
+ *                      the main thread 240 times a second, the
+ *                      objects and lights are still animated
+ *                      on the render thread
+ *    --update-load <ms>
+ *                      make every update take <ms> of CPU time,
+ *                      standing in for a heavy simulation
+ *    --alloc-guard     fail an assertion when the scene drawing
+ *                      allocates from the general heap
+ *    --alloc-report    report the heap allocations and bytes
+ *                      per frame of PrepareSceneView,
+ *                      RenderScene and each object draw every
+ *                      120 frames, and of PrepareScene at the
+ *                      start
+ *    --alloc-test      exit with a failure as soon as a frame
+ *                      after the first 60 allocates from the
+ *                      general heap, or successfully after 600
+ *                      frames that do not
+ *    --stats           report the frame time, GPU time,
+ *                      overdraw and input latency every 120
+ *                      frames
+ *    --benchmark       measure every path with 5, 100 and
+ *                      5000 lights, then exit
+ ***********************************************************/
+void ParseCommandLine(int argc, char* argv[])
+{
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--forward") == 0)
+		{
+			g_renderPath = RENDER_FORWARD;
+		}
+		else if (strcmp(argv[i], "--object-lights") == 0)
+		{
+			g_renderPath = RENDER_OBJECT_LIGHTS;
+		}
+		else if (strcmp(argv[i], "--clustered") == 0)
+		{
+			g_renderPath = RENDER_CLUSTERED;
+		}
+		else if (strcmp(argv[i], "--tiled") == 0)
+		{
+			g_renderPath = RENDER_TILED;
+		}
+		else if (strcmp(argv[i], "--deferred") == 0)
+		{
+			g_renderPath = RENDER_DEFERRED;
+		}
+		else if (strcmp(argv[i], "--visibility") == 0)
+		{
+			g_renderPath = RENDER_VISIBILITY;
+		}
+		else if ((strcmp(argv[i], "--lights") == 0) && (i + 1 < argc))
+		{
+			g_benchmarkLightCount = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--benchmark") == 0)
+		{
+			g_bRunBenchmark = true;
+		}
+		else if (strcmp(argv[i], "--prepass") == 0)
+		{
+			g_bDepthPrePass = true;
+		}
+		else if (strcmp(argv[i], "--stats") == 0)
+		{
+			g_bReportStats = true;
+		}
+		else if (strcmp(argv[i], "--no-shadows") == 0)
+		{
+			g_bShadows = false;
+		}
+		else if (strcmp(argv[i], "--animate") == 0)
+		{
+			g_bAnimateObjects = true;
+		}
+		else if (strcmp(argv[i], "--bake-lightmaps") == 0)
+		{
+			g_bBakeLightmaps = true;
+		}
+		else if (strcmp(argv[i], "--bake-scaling") == 0)
+		{
+			g_bBakeLightmaps = true;
+			g_bBakeScaling = true;
+		}
+		else if (strcmp(argv[i], "--lightmaps") == 0)
+		{
+			g_bUseLightmaps = true;
+		}
+		else if (strcmp(argv[i], "--probes") == 0)
+		{
+			g_bUseProbes = true;
+		}
+		else if (strcmp(argv[i], "--oit") == 0)
+		{
+			g_bTransparency = true;
+			g_transparencyMode = TransparencyManager::TRANSPARENCY_WEIGHTED;
+		}
+		else if (strcmp(argv[i], "--sorted-blend") == 0)
+		{
+			g_bTransparency = true;
+			g_transparencyMode = TransparencyManager::TRANSPARENCY_SORTED;
+		}
+		else if ((strcmp(argv[i], "--transparent-boxes") == 0) && (i + 1 < argc))
+		{
+			g_bTransparency = true;
+			g_transparentBoxCount = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--oit-benchmark") == 0)
+		{
+			g_bTransparency = true;
+			g_bRunTransparencyBenchmark = true;
+			g_transparentBoxCount = BENCHMARK_TRANSPARENT_BOXES;
+			g_bReportStats = true;
+		}
+		else if (strcmp(argv[i], "--dynamic-resolution") == 0)
+		{
+			g_bDynamicResolution = true;
+		}
+		else if ((strcmp(argv[i], "--gpu-budget") == 0) && (i + 1 < argc))
+		{
+			g_gpuBudgetMilliseconds = atof(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--resolution-path") == 0)
+		{
+			g_bDynamicResolution = true;
+			g_bRunResolutionPath = true;
+		}
+		else if (strcmp(argv[i], "--fxaa") == 0)
+		{
+			g_bPostProcess = true;
+			g_antiAliasingMode = PostProcessManager::AA_FXAA;
+		}
+		else if (strcmp(argv[i], "--smaa") == 0)
+		{
+			g_bPostProcess = true;
+			g_antiAliasingMode = PostProcessManager::AA_SMAA;
+		}
+		else if (strcmp(argv[i], "--taa") == 0)
+		{
+			g_bPostProcess = true;
+			g_antiAliasingMode = PostProcessManager::AA_TAA;
+		}
+		else if (strcmp(argv[i], "--ssaa") == 0)
+		{
+			g_bPostProcess = true;
+			g_antiAliasingMode = PostProcessManager::AA_SUPERSAMPLED;
+		}
+		else if (strcmp(argv[i], "--aa-benchmark") == 0)
+		{
+			g_bPostProcess = true;
+			g_bRunAntiAliasingBenchmark = true;
+			g_bReportStats = true;
+		}
+		else if (strcmp(argv[i], "--ssao") == 0)
+		{
+			g_bPostProcess = true;
+			g_bAmbientOcclusion = true;
+			g_effectResolution = EffectsManager::RESOLUTION_HALF;
+		}
+		else if (strcmp(argv[i], "--ssao-full") == 0)
+		{
+			g_bPostProcess = true;
+			g_bAmbientOcclusion = true;
+			g_effectResolution = EffectsManager::RESOLUTION_FULL;
+		}
+		else if (strcmp(argv[i], "--ssao-quarter") == 0)
+		{
+			g_bPostProcess = true;
+			g_bAmbientOcclusion = true;
+			g_effectResolution = EffectsManager::RESOLUTION_QUARTER;
+		}
+		else if ((strcmp(argv[i], "--objects") == 0) && (i + 1 < argc))
+		{
+			g_objectCount = atoi(argv[++i]);
+		}
+		else if ((strcmp(argv[i], "--null-benchmark") == 0) && (i + 1 < argc))
+		{
+			g_nullBenchmarkObjectCount = atoi(argv[++i]);
+		}
+		else if ((strcmp(argv[i], "--trace") == 0) && (i + 1 < argc))
+		{
+			g_traceFrame = atoi(argv[++i]);
+		}
+		else if ((strcmp(argv[i], "--replay") == 0) && (i + 1 < argc))
+		{
+			g_replayFilename = argv[++i];
+		}
+		else if (strcmp(argv[i], "--job-benchmark") == 0)
+		{
+			g_bRunJobBenchmark = true;
+		}
+		else if (strcmp(argv[i], "--pool-benchmark") == 0)
+		{
+			g_bRunPoolBenchmark = true;
+		}
+		else if (strcmp(argv[i], "--ecs-benchmark") == 0)
+		{
+			g_bRunEcsBenchmark = true;
+		}
+		else if ((strcmp(argv[i], "--scene-benchmark") == 0) && (i + 1 < argc))
+		{
+			g_sceneBenchmarkObjectCount = atoi(argv[++i]);
+		}
+		else if ((strcmp(argv[i], "--scene") == 0) && (i + 1 < argc))
+		{
+			g_sceneFilename = argv[++i];
+		}
+		else if (strcmp(argv[i], "--render-thread") == 0)
+		{
+			g_bRenderThread = true;
+		}
+		else if ((strcmp(argv[i], "--update-load") == 0) && (i + 1 < argc))
+		{
+			g_updateLoadMilliseconds = atof(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--alloc-guard") == 0)
+		{
+			AllocationTracker::SetGuardEnabled(true);
+		}
+		else if (strcmp(argv[i], "--alloc-report") == 0)
+		{
+			g_bReportAllocations = true;
+			g_bReportStats = true;
+		}
+		else if (strcmp(argv[i], "--alloc-test") == 0)
+		{
+			g_bAllocationTest = true;
+		}
+		else if (strcmp(argv[i], "--ssao-benchmark") == 0)
+		{
+			g_bPostProcess = true;
+			g_bAmbientOcclusion = true;
+			g_bRunEffectsBenchmark = true;
+			g_bReportStats = true;
+		}
+		else
+		{
+			std::cout << "WARNING: Unknown command line option " << argv[i] << std::endl;
+		}
+	}
+
+	// the animated lights are only stored in the light buffer
+	if (((g_benchmarkLightCount > 0) || (g_bRunBenchmark == true)) &&
+		(g_renderPath == RENDER_DEFAULT))
+	{
+		g_renderPath = RENDER_CLUSTERED;
+	}
+	if ((g_benchmarkLightCount > 0) || (g_bRunBenchmark == true))
+	{
+		g_bReportStats = true;
+	}
+	// the benchmark measures the paths with and without the pre-pass
+	if (g_bRunBenchmark == true)
+	{
+		g_bDepthPrePass = true;
+	}
+	// the other paths and the weighted blending draw into their own
+	// window sized targets, and the benchmarks compare full frames
+	if ((g_bDynamicResolution == true) &&
+		((g_renderPath == RENDER_TILED) || (g_renderPath == RENDER_DEFERRED) ||
+		(g_renderPath == RENDER_VISIBILITY) || (g_bTransparency == true) ||
+		(g_bRunBenchmark == true)))
+	{
+		std::cout << "WARNING: Dynamic resolution is only supported by the default, "
+			<< "forward, object lights and clustered paths without transparency" << std::endl;
+		g_bDynamicResolution = false;
+		g_bRunResolutionPath = false;
+	}
+	if ((g_bPostProcess == true) &&
+		((g_renderPath == RENDER_TILED) || (g_renderPath == RENDER_DEFERRED) ||
+		(g_renderPath == RENDER_VISIBILITY) || (g_bTransparency == true) ||
+		(g_bDynamicResolution == true) || (g_bRunBenchmark == true)))
+	{
+		std::cout << "WARNING: Anti-aliasing and ambient occlusion are only supported by the default, forward, "
+			<< "object lights and clustered paths without transparency or dynamic resolution" << std::endl;
+		g_bPostProcess = false;
+		g_bRunAntiAliasingBenchmark = false;
+		g_bAmbientOcclusion = false;
+		g_bRunEffectsBenchmark = false;
+	}
+	// both benchmarks select their own modes
+	if ((g_bRunEffectsBenchmark == true) && (g_bRunAntiAliasingBenchmark == true))
+	{
+		g_bRunEffectsBenchmark = false;
+	}
+}
+
+/***********************************************************
+ *	RenderFrame()
+ *
+ *  This function is used to draw one frame of the scene with
+ *  the passed in rendering path.  The depth pre-pass is only
+ *  used by the paths that shade while drawing the scene into
+ *  the window, the tiled path already draws its own.  The
+ *  added objects are recorded once, in the first pass that
+ *  draws them, and drawn into the depth passes as well, so
+ *  that they are not hidden by the depth test of the shading
+ *  pass and the tiles see their depth.
+ ***********************************************************/
+void RenderFrame(RENDER_PATH renderPath, bool bDepthPrePass)
+{
+	bDepthPrePass = bDepthPrePass && (renderPath != RENDER_TILED);
+	// true once the view of this frame has been calculated
+	bool bViewPrepared = false;
+	// true once the added objects have been recorded for this frame
+	bool bObjectsRecorded = false;
+	// the scene is animated to the time of the drawn snapshot, the
+	// benchmark frames are drawn at the current time
+	float sceneSeconds = (NULL != g_pDrawnSnapshot) ?
+		(float)g_pDrawnSnapshot->sceneSeconds : (float)glfwGetTime();
+
+	// place the dynamic objects for this frame
+	g_SceneManager->AnimateObjects(sceneSeconds);
+
+	// move the projection to the jitter of this frame
+	if (NULL != g_PostProcessManager)
+	{
+		g_PostProcessManager->BeginFrame();
+		g_ViewManager->SetProjectionJitter(g_PostProcessManager->GetJitter());
+	}
+
+	// the deferred path draws the scene into the G-buffer first
+	if (renderPath == RENDER_DEFERRED)
+	{
+		ShaderManager* pGeometryShader = g_DeferredManager->GetGeometryShader();
+
+		g_SceneManager->SetShaderManager(pGeometryShader);
+		g_ViewManager->SetShaderManager(pGeometryShader);
+		g_DeferredManager->BeginGeometryPass();
+
+		// convert from 3D object space to 2D view
+		g_ViewManager->PrepareSceneView();
+
+		// refresh the 3D scene into the G-buffer
+		if (NULL != g_OverdrawCounter)
+		{
+			g_OverdrawCounter->Begin();
+		}
+		g_SceneManager->RenderScene();
+		if (NULL != g_OverdrawCounter)
+		{
+			g_OverdrawCounter->End();
+		}
+		g_DeferredManager->EndGeometryPass();
+
+		// move the lights and shade the window from the G-buffer
+		g_SceneManager->AnimateLights(sceneSeconds);
+		g_LightManager->UploadLights();
+		g_DeferredManager->RenderLighting(
+			g_LightManager,
+			g_ViewManager->GetViewMatrix(),
+			g_ViewManager->GetProjectionMatrix());
+		return;
+	}
+
+	// the visibility path draws only the triangle IDs, then
+	// shades the window from the captured triangles
+	if (renderPath == RENDER_VISIBILITY)
+	{
+		ShaderManager* pGeometryShader = g_VisibilityManager->GetGeometryShader();
+
+		g_SceneManager->SetShaderManager(pGeometryShader);
+		g_ViewManager->SetShaderManager(pGeometryShader);
+		g_VisibilityManager->BeginGeometryPass();
+
+		// convert from 3D object space to 2D view
+		g_ViewManager->PrepareSceneView();
+
+		// refresh the 3D scene into the visibility buffer
+		if (NULL != g_OverdrawCounter)
+		{
+			g_OverdrawCounter->Begin();
+		}
+		g_SceneManager->RenderScene();
+		if (NULL != g_OverdrawCounter)
+		{
+			g_OverdrawCounter->End();
+		}
+		g_VisibilityManager->EndGeometryPass();
+
+		// move the lights, bin them and resolve the window
+		g_SceneManager->AnimateLights(sceneSeconds);
+		g_LightManager->UploadLights();
+		g_ClusterManager->BuildClusters(
+			g_LightManager,
+			g_ViewManager->GetViewMatrix(),
+			g_ViewManager->GetProjectionMatrix(),
+			g_ViewManager->GetNearPlane(),
+			g_ViewManager->GetFarPlane(),
+			g_ViewManager->GetWindowWidth(),
+			g_ViewManager->GetWindowHeight());
+		g_VisibilityManager->RenderResolve(
+			g_LightManager,
+			g_ClusterManager,
+			g_ViewManager->GetViewMatrix(),
+			g_ViewManager->GetProjectionMatrix());
+		return;
+	}
+
+	// the tiled path draws the scene depth first and culls the
+	// lights against it before the scene is shaded
+	if (renderPath == RENDER_TILED)
+	{
+		ShaderManager* pDepthShader = g_TileManager->GetDepthShader();
+
+		g_SceneManager->SetShaderManager(pDepthShader);
+		g_ViewManager->SetShaderManager(pDepthShader);
+		g_TileManager->BeginDepthPass();
+
+		// convert from 3D object space to 2D view
+		g_ViewManager->PrepareSceneView();
+
+		// refresh the 3D scene into the depth texture
+		g_SceneManager->RenderScene();
+		if (NULL != g_ObjectManager)
+		{
+			glm::mat4 viewProjection = g_ViewManager->GetProjectionMatrix() * g_ViewManager->GetViewMatrix();
+			g_ObjectManager->RecordPackets(viewProjection);
+			g_ObjectManager->SubmitPackets(viewProjection, ObjectManager::DRAW_DEPTH);
+			bObjectsRecorded = true;
+		}
+		g_TileManager->EndDepthPass();
+		bViewPrepared = true;
+
+		// move the lights and build the light list of every tile
+		g_SceneManager->AnimateLights(sceneSeconds);
+		g_LightManager->UploadLights();
+		g_TileManager->CullLights(
+			g_LightManager,
+			g_ViewManager->GetViewMatrix(),
+			g_ViewManager->GetProjectionMatrix());
+	}
+
+	// bring the shadow maps up to date for the view of this frame,
+	// which only draws anything when the view or an object moved
+	if (NULL != g_ShadowManager)
+	{
+		g_ShaderManager->use();
+		g_ViewManager->SetShaderManager(g_ShaderManager);
+		g_ViewManager->PrepareSceneView();
+		bViewPrepared = true;
+
+		g_ShadowManager->RenderShadowMaps(
+			g_SceneManager,
+			g_ViewManager->GetViewMatrix(),
+			g_ViewManager->GetProjectionMatrix(),
+			g_ViewManager->GetNearPlane(),
+			g_ViewManager->GetFarPlane());
+	}
+
+	// weighted blending tests the translucent objects against
+	// the depth of an offscreen copy of the opaque scene
+	if ((NULL != g_TransparencyManager) &&
+		(g_transparencyMode == TransparencyManager::TRANSPARENCY_WEIGHTED))
+	{
+		g_TransparencyManager->BeginOpaquePass();
+	}
+	// draw into the scaled offscreen target of the dynamic resolution
+	if (NULL != g_ResolutionManager)
+	{
+		g_ResolutionManager->BeginScene();
+	}
+	// draw into the offscreen target of the anti-aliasing
+	if (NULL != g_PostProcessManager)
+	{
+		g_PostProcessManager->BeginScene();
+	}
+
+	// Enable z-depth
+	glEnable(GL_DEPTH_TEST);
+
+	// Clear the frame and z buffers
+	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+	// fill the depth buffer so that only the closest surface
+	// of each pixel passes the depth test of the shading pass
+	if (bDepthPrePass == true)
+	{
+		ShaderManager* pDepthShader = g_PrePassManager->GetDepthShader();
+
+		g_SceneManager->SetShaderManager(pDepthShader);
+		g_ViewManager->SetShaderManager(pDepthShader);
+		g_PrePassManager->BeginDepthPass();
+
+		// convert from 3D object space to 2D view
+		if (bViewPrepared == true)
+		{
+			g_ViewManager->SetViewUniforms(pDepthShader);
+		}
+		else
+		{
+			g_ViewManager->PrepareSceneView();
+			bViewPrepared = true;
+		}
+
+		// refresh the 3D scene into the depth buffer, without the
+		// translucent objects when they are drawn last
+		if (NULL != g_TransparencyManager)
+		{
+			g_SceneManager->SetMaterialFilter(SceneManager::DRAW_OPAQUE_MATERIALS);
+		}
+		g_SceneManager->RenderScene();
+		g_SceneManager->SetMaterialFilter(SceneManager::DRAW_ALL_MATERIALS);
+		if (NULL != g_ObjectManager)
+		{
+			glm::mat4 viewProjection = g_ViewManager->GetProjectionMatrix() * g_ViewManager->GetViewMatrix();
+			g_ObjectManager->RecordPackets(viewProjection);
+			g_ObjectManager->SubmitPackets(viewProjection, ObjectManager::DRAW_DEPTH);
+			bObjectsRecorded = true;
+		}
+		g_PrePassManager->BeginShadingPass();
+	}
+
+	g_ShaderManager->use();
+	g_SceneManager->SetShaderManager(g_ShaderManager);
+	g_ViewManager->SetShaderManager(g_ShaderManager);
+
+	// convert from 3D object space to 2D view, unless an
+	// earlier pass already did it for this frame
+	if (bViewPrepared == true)
+	{
+		g_ViewManager->SetViewUniforms(g_ShaderManager);
+	}
+	else
+	{
+		g_ViewManager->PrepareSceneView();
+	}
+
+	// sample the shadow maps while the scene is shaded
+	if (NULL != g_ShadowManager)
+	{
+		g_ShadowManager->BindShadowMaps(g_ShaderManager);
+	}
+	// sample the baked light instead of the static lights
+	if (NULL != g_LightmapManager)
+	{
+		g_LightmapManager->BindLightmap(g_ShaderManager);
+	}
+	// replace the constant ambient light with the probe grid
+	if (NULL != g_ProbeManager)
+	{
+		g_ProbeManager->BindProbes(g_ShaderManager);
+	}
+
+	// move the lights and bin them into the clusters of the current view
+	if (NULL != g_LightManager)
+	{
+		if (renderPath != RENDER_TILED)
+		{
+			g_SceneManager->AnimateLights(sceneSeconds);
+			g_LightManager->UploadLights();
+		}
+		g_LightManager->BindLights(g_ShaderManager);
+		g_ShaderManager->setBoolValue("bUseClusters", renderPath == RENDER_CLUSTERED);
+		g_ShaderManager->setBoolValue("bUseTiles", false);
+		g_ShaderManager->setBoolValue(g_UseObjectLightsName, renderPath == RENDER_OBJECT_LIGHTS);
+
+		// sort the moved lights so each object can find the ones reaching it
+		if (renderPath == RENDER_OBJECT_LIGHTS)
+		{
+			g_LightManager->BuildLightGrid();
+		}
+		g_SceneManager->SetObjectLightLists(renderPath == RENDER_OBJECT_LIGHTS);
+
+		if (renderPath == RENDER_CLUSTERED)
+		{
+			// the clusters cover the pixels the scene is drawn into
+			int renderWidth = g_ViewManager->GetWindowWidth();
+			int renderHeight = g_ViewManager->GetWindowHeight();
+			if (NULL != g_ResolutionManager)
+			{
+				renderWidth = g_ResolutionManager->GetRenderWidth();
+				renderHeight = g_ResolutionManager->GetRenderHeight();
+			}
+			else if (NULL != g_PostProcessManager)
+			{
+				renderWidth = g_PostProcessManager->GetSceneWidth();
+				renderHeight = g_PostProcessManager->GetSceneHeight();
+			}
+			g_ClusterManager->BuildClusters(
+				g_LightManager,
+				g_ViewManager->GetViewMatrix(),
+				g_ViewManager->GetProjectionMatrix(),
+				g_ViewManager->GetNearPlane(),
+				g_ViewManager->GetFarPlane(),
+				renderWidth,
+				renderHeight);
+			g_ClusterManager->BindClusters(g_ShaderManager);
+		}
+		else if (renderPath == RENDER_TILED)
+		{
+			g_TileManager->BindTiles(g_ShaderManager);
+		}
+	}
+
+	// refresh the 3D scene, only the opaque objects when the
+	// translucent ones are drawn last
+	if (NULL != g_TransparencyManager)
+	{
+		g_SceneManager->SetMaterialFilter(SceneManager::DRAW_OPAQUE_MATERIALS);
+	}
+	if (NULL != g_OverdrawCounter)
+	{
+		g_OverdrawCounter->Begin();
+	}
+	g_SceneManager->RenderScene();
+	g_SceneManager->SetMaterialFilter(SceneManager::DRAW_ALL_MATERIALS);
+	if (NULL != g_ObjectManager)
+	{
+		// after the depth pre-pass only their closest surfaces are shaded
+		glm::mat4 viewProjection = g_ViewManager->GetProjectionMatrix() * g_ViewManager->GetViewMatrix();
+		if (bObjectsRecorded == false)
+		{
+			g_ObjectManager->RecordPackets(viewProjection);
+		}
+		g_ObjectManager->SubmitPackets(viewProjection,
+			(bDepthPrePass == true) ? ObjectManager::DRAW_SHADED_ON_DEPTH : ObjectManager::DRAW_SHADED);
+		g_ShaderManager->use();
+	}
+	if (NULL != g_OverdrawCounter)
+	{
+		g_OverdrawCounter->End();
+	}
+	g_SceneManager->SetObjectLightLists(false);
+
+	if (bDepthPrePass == true)
+	{
+		g_PrePassManager->EndShadingPass();
+	}
+
+	if (NULL != g_TransparencyManager)
+	{
+		RenderTransparency();
+	}
+	if (NULL != g_ResolutionManager)
+	{
+		g_ResolutionManager->EndScene();
+		g_ShaderManager->use();
+	}
+	// the passes after the scene are declared again every frame,
+	// then ordered and given their textures by the graph
+	if (NULL != g_PostProcessManager)
+	{
+		AllocationTracker::BeginScope("RenderGraph");
+		g_RenderGraph->Reset();
+		int sceneColor = g_RenderGraph->ImportTexture("scene color",
+			g_PostProcessManager->GetSceneColorTexture(),
+			g_PostProcessManager->GetSceneFramebuffer());
+		int sceneDepth = g_RenderGraph->ImportTexture("scene depth",
+			g_PostProcessManager->GetSceneDepthTexture(),
+			g_PostProcessManager->GetSceneFramebuffer());
+		int window = g_RenderGraph->ImportTexture("window", 0, 0);
+
+		// the supersampled target is larger than the effect targets
+		if ((NULL != g_EffectsManager) &&
+			(g_PostProcessManager->GetMode() != PostProcessManager::AA_SUPERSAMPLED))
+		{
+			g_EffectsManager->AddAmbientOcclusionPasses(
+				*g_RenderGraph,
+				sceneColor,
+				sceneDepth,
+				g_ViewManager->GetProjectionMatrix());
+		}
+
+		int pass = g_RenderGraph->AddPass("anti-aliasing", ExecuteAntiAliasingPass, g_PostProcessManager, 0);
+		g_RenderGraph->ReadTexture(pass, sceneColor);
+		g_RenderGraph->ReadTexture(pass, sceneDepth);
+		g_RenderGraph->WriteTexture(pass, window);
+
+		if (g_RenderGraph->Compile() == true)
+		{
+			g_RenderGraph->Execute();
+		}
+		g_ShaderManager->use();
+		AllocationTracker::EndScope();
+	}
+}
+
+/***********************************************************
+ *	ExecuteAntiAliasingPass()
+ *
+ *  This function is used by the render graph for applying
+ *  the anti-aliasing to the scene target and copying it into
+ *  the window.
+ ***********************************************************/
+void ExecuteAntiAliasingPass(RenderGraph& /*graph*/, void* pOwner, int /*tag*/)
+{
+	((PostProcessManager*)pOwner)->EndScene(
+		g_ViewManager->GetViewProjection(),
+		g_ViewManager->GetPreviousViewProjection());
+}
+
+/***********************************************************
+ *	RenderTransparency()
+ *
+ *  This function is used to draw the translucent objects of
+ *  the scene and the instanced translucent boxes after the
+ *  opaque objects, with the selected blending method.
+ ***********************************************************/
+void RenderTransparency()
+{
+	bool bWeighted = (g_transparencyMode == TransparencyManager::TRANSPARENCY_WEIGHTED);
+
+	g_TransparencyManager->BeginTransparentPass(g_transparencyMode);
+
+	// the translucent scene objects are sorted from back to front
+	// for sorted blending, weighted blending takes them in any order
+	g_ShaderManager->use();
+	g_ShaderManager->setIntValue(g_TransparencyPassName, 2);
+	g_ShaderManager->setBoolValue("bWeightedBlend", bWeighted);
+	g_SceneManager->SetMaterialFilter(SceneManager::DRAW_TRANSLUCENT_MATERIALS);
+	g_SceneManager->SetTranslucentSorting(bWeighted == false, g_ViewManager->GetViewMatrix());
+	g_SceneManager->RenderScene();
+	g_SceneManager->SetTranslucentSorting(false, glm::mat4(1.0f));
+	g_SceneManager->SetMaterialFilter(SceneManager::DRAW_ALL_MATERIALS);
+	g_ShaderManager->setIntValue(g_TransparencyPassName, 0);
+	g_ShaderManager->setBoolValue("bWeightedBlend", false);
+
+	g_TransparencyManager->RenderInstances(
+		g_transparencyMode,
+		g_ViewManager->GetViewMatrix(),
+		g_ViewManager->GetProjectionMatrix());
+	g_TransparencyManager->EndTransparentPass(g_transparencyMode);
+	g_ShaderManager->use();
+}
+
+/***********************************************************
+ *	RunBenchmark()
+ *
+ *  This function is used to draw the scene with the forward,
+ *  object lights, clustered, tiled, deferred and visibility
+ *  buffer paths for several light counts and output the
+ *  average CPU and GPU frame times, the overdraw and the
+ *  bytes of lights uploaded per frame for each one.
+ ***********************************************************/
+void RunBenchmark()
+{
+	const int runTotal = sizeof(BENCHMARK_RUNS) / sizeof(BENCHMARK_RUNS[0]);
+	const int lightCountTotal = sizeof(BENCHMARK_LIGHT_COUNTS) / sizeof(BENCHMARK_LIGHT_COUNTS[0]);
+
+	for (int c = 0; c < lightCountTotal; c++)
+	{
+		// replace the scene lights with the animated benchmark lights
+		g_LightManager->ClearLights();
+		g_SceneManager->CreateBenchmarkLights(BENCHMARK_LIGHT_COUNTS[c]);
+
+		for (int r = 0; r < runTotal; r++)
+		{
+			const BENCHMARK_RUN& run = BENCHMARK_RUNS[r];
+
+			for (int i = 0; i < BENCHMARK_WARMUP_FRAMES; i++)
+			{
+				RenderFrame(run.renderPath, run.bDepthPrePass);
+				glfwSwapBuffers(g_Window);
+				glfwPollEvents();
+			}
+			glFinish();
+
+			double cpuStart = glfwGetTime();
+			double gpuMilliseconds = 0.0;
+			double overdraw = 0.0;
+			double uploadBytes = 0.0;
+			for (int i = 0; i < FRAME_REPORT_INTERVAL; i++)
+			{
+				g_GpuTimer->Begin();
+				RenderFrame(run.renderPath, run.bDepthPrePass);
+				g_GpuTimer->End();
+				glfwSwapBuffers(g_Window);
+				glfwPollEvents();
+
+				uploadBytes += (double)g_LightManager->GetLastUploadBytes();
+				if (g_GpuTimer->HasResult() == true)
+				{
+					gpuMilliseconds += g_GpuTimer->GetLastMilliseconds();
+				}
+				if (g_OverdrawCounter->HasResult() == true)
+				{
+					overdraw += g_OverdrawCounter->GetOverdraw(
+						g_ViewManager->GetWindowWidth(),
+						g_ViewManager->GetWindowHeight());
+				}
+			}
+			glFinish();
+			double cpuMilliseconds = (glfwGetTime() - cpuStart) * 1000.0;
+
+			std::cout << "INFO: Benchmark " << run.name
+				<< ", lights: " << g_LightManager->GetLightCount()
+				<< ", frame time: " << (cpuMilliseconds / FRAME_REPORT_INTERVAL) << " ms"
+				<< ", GPU time: " << (gpuMilliseconds / FRAME_REPORT_INTERVAL) << " ms"
+				<< ", overdraw: " << (overdraw / FRAME_REPORT_INTERVAL)
+				<< ", light upload: " << (uploadBytes / FRAME_REPORT_INTERVAL) << " bytes"
+				<< std::endl;
+		}
+	}
+}
+
+/***********************************************************
+ *	RunTransparencyBenchmark()
+ *
+ *  This function is used to draw the scene and the instanced
+ *  translucent boxes with sorted and then weighted blending,
+ *  and output the average CPU and GPU frame times and the
+ *  time spent sorting the boxes for each one.
+ ***********************************************************/
+void RunTransparencyBenchmark()
+{
+	const TransparencyManager::TRANSPARENCY_MODE modes[2] = {
+		TransparencyManager::TRANSPARENCY_SORTED,
+		TransparencyManager::TRANSPARENCY_WEIGHTED };
+	const char* modeNames[2] = { "sorted blending", "weighted blending" };
+
+	for (int m = 0; m < 2; m++)
+	{
+		g_transparencyMode = modes[m];
+
+		for (int i = 0; i < BENCHMARK_WARMUP_FRAMES; i++)
+		{
+			RenderFrame(g_renderPath, g_bDepthPrePass);
+			glfwSwapBuffers(g_Window);
+			glfwPollEvents();
+		}
+		glFinish();
+
+		double cpuStart = glfwGetTime();
+		double gpuMilliseconds = 0.0;
+		double sortMilliseconds = 0.0;
+		for (int i = 0; i < FRAME_REPORT_INTERVAL; i++)
+		{
+			g_GpuTimer->Begin();
+			RenderFrame(g_renderPath, g_bDepthPrePass);
+			g_GpuTimer->End();
+			glfwSwapBuffers(g_Window);
+			glfwPollEvents();
+
+			if (g_GpuTimer->HasResult() == true)
+			{
+				gpuMilliseconds += g_GpuTimer->GetLastMilliseconds();
+			}
+			if (modes[m] == TransparencyManager::TRANSPARENCY_SORTED)
+			{
+				sortMilliseconds += g_TransparencyManager->GetLastSortMilliseconds();
+			}
+		}
+		glFinish();
+		double cpuMilliseconds = (glfwGetTime() - cpuStart) * 1000.0;
+
+		std::cout << "INFO: Benchmark " << modeNames[m]
+			<< ", translucent boxes: " << g_TransparencyManager->GetInstanceCount()
+			<< ", frame time: " << (cpuMilliseconds / FRAME_REPORT_INTERVAL) << " ms"
+			<< ", GPU time: " << (gpuMilliseconds / FRAME_REPORT_INTERVAL) << " ms"
+			<< ", sort time: " << (sortMilliseconds / FRAME_REPORT_INTERVAL) << " ms"
+			<< std::endl;
+	}
+}
+
+/***********************************************************
+ *	RunAntiAliasingBenchmark()
+ *
+ *  This function is used to draw the scene with each
+ *  anti-aliasing mode and output the average CPU and GPU
+ *  frame times, the GPU time of each post-process pass, and
+ *  how far the window is from the supersampled reference.
+ ***********************************************************/
+void RunAntiAliasingBenchmark()
+{
+	const PostProcessManager::AA_MODE modes[] = {
+		PostProcessManager::AA_SUPERSAMPLED,
+		PostProcessManager::AA_NONE,
+		PostProcessManager::AA_FXAA,
+		PostProcessManager::AA_SMAA,
+		PostProcessManager::AA_TAA };
+	const int modeTotal = sizeof(modes) / sizeof(modes[0]);
+	std::vector<unsigned char> reference;
+	std::vector<unsigned char> image;
+
+	for (int m = 0; m < modeTotal; m++)
+	{
+		g_PostProcessManager->SetMode(modes[m]);
+
+		// the warm up also lets the TAA history converge
+		for (int i = 0; i < BENCHMARK_WARMUP_FRAMES; i++)
+		{
+			RenderFrame(g_renderPath, g_bDepthPrePass);
+			glfwSwapBuffers(g_Window);
+			glfwPollEvents();
+		}
+		glFinish();
+
+		double cpuStart = glfwGetTime();
+		double gpuMilliseconds = 0.0;
+		double passMilliseconds[PostProcessManager::PASS_COUNT] = { 0.0 };
+		for (int i = 0; i < FRAME_REPORT_INTERVAL; i++)
+		{
+			g_GpuTimer->Begin();
+			RenderFrame(g_renderPath, g_bDepthPrePass);
+			g_GpuTimer->End();
+			glfwSwapBuffers(g_Window);
+			glfwPollEvents();
+
+			if (g_GpuTimer->HasResult() == true)
+			{
+				gpuMilliseconds += g_GpuTimer->GetLastMilliseconds();
+			}
+			for (int p = 0; p < PostProcessManager::PASS_COUNT; p++)
+			{
+				passMilliseconds[p] += std::max(0.0,
+					g_PostProcessManager->GetPassMilliseconds((PostProcessManager::POST_PASS)p));
+			}
+		}
+		glFinish();
+		double cpuMilliseconds = (glfwGetTime() - cpuStart) * 1000.0;
+
+		// capture one more frame before it is swapped away
+		RenderFrame(g_renderPath, g_bDepthPrePass);
+		g_PostProcessManager->CaptureWindow((modes[m] == PostProcessManager::AA_SUPERSAMPLED) ? reference : image);
+		glfwSwapBuffers(g_Window);
+		glfwPollEvents();
+
+		std::cout << "INFO: Benchmark " << PostProcessManager::GetModeName(modes[m])
+			<< ", frame time: " << (cpuMilliseconds / FRAME_REPORT_INTERVAL) << " ms"
+			<< ", GPU time: " << (gpuMilliseconds / FRAME_REPORT_INTERVAL) << " ms";
+		for (int p = 0; p < PostProcessManager::PASS_COUNT; p++)
+		{
+			if (passMilliseconds[p] > 0.0)
+			{
+				std::cout << ", " << PostProcessManager::GetPassName((PostProcessManager::POST_PASS)p)
+					<< ": " << (passMilliseconds[p] / FRAME_REPORT_INTERVAL) << " ms";
+			}
+		}
+		if (modes[m] != PostProcessManager::AA_SUPERSAMPLED)
+		{
+			double psnr = 0.0;
+			double meanError = 0.0;
+			PostProcessManager::CompareCaptures(image, reference, psnr, meanError);
+			std::cout << ", PSNR: " << psnr << " dB, mean error: " << meanError;
+		}
+		std::cout << std::endl;
+	}
+}
+
+/***********************************************************
+ *	RunEffectsBenchmark()
+ *
+ *  This function is used to draw the scene with the ambient
+ *  occlusion at full, half and quarter resolution and output
+ *  the average CPU and GPU frame times, the GPU time of each
+ *  effect pass, and how far the upsampled occlusion is from
+ *  the full resolution one.
+ ***********************************************************/
+void RunEffectsBenchmark()
+{
+	const EffectsManager::EFFECT_RESOLUTION resolutions[] = {
+		EffectsManager::RESOLUTION_FULL,
+		EffectsManager::RESOLUTION_HALF,
+		EffectsManager::RESOLUTION_QUARTER };
+	const int resolutionTotal = sizeof(resolutions) / sizeof(resolutions[0]);
+	std::vector<unsigned char> reference;
+	std::vector<unsigned char> image;
+
+	for (int r = 0; r < resolutionTotal; r++)
+	{
+		g_EffectsManager->SetResolution(resolutions[r]);
+
+		for (int i = 0; i < BENCHMARK_WARMUP_FRAMES; i++)
+		{
+			RenderFrame(g_renderPath, g_bDepthPrePass);
+			glfwSwapBuffers(g_Window);
+			glfwPollEvents();
+		}
+		glFinish();
+
+		double cpuStart = glfwGetTime();
+		double gpuMilliseconds = 0.0;
+		double passMilliseconds[EffectsManager::PASS_COUNT] = { 0.0 };
+		for (int i = 0; i < FRAME_REPORT_INTERVAL; i++)
+		{
+			g_GpuTimer->Begin();
+			RenderFrame(g_renderPath, g_bDepthPrePass);
+			g_GpuTimer->End();
+			glfwSwapBuffers(g_Window);
+			glfwPollEvents();
+
+			if (g_GpuTimer->HasResult() == true)
+			{
+				gpuMilliseconds += g_GpuTimer->GetLastMilliseconds();
+			}
+			for (int p = 0; p < EffectsManager::PASS_COUNT; p++)
+			{
+				passMilliseconds[p] += std::max(0.0,
+					g_EffectsManager->GetPassMilliseconds((EffectsManager::EFFECT_PASS)p));
+			}
+		}
+		glFinish();
+		double cpuMilliseconds = (glfwGetTime() - cpuStart) * 1000.0;
+
+		g_EffectsManager->CaptureEffect(*g_RenderGraph, (resolutions[r] == EffectsManager::RESOLUTION_FULL) ? reference : image);
+		g_RenderGraph->ReportSchedule();
+
+		std::cout << "INFO: Benchmark SSAO " << EffectsManager::GetResolutionName(resolutions[r])
+			<< ", frame time: " << (cpuMilliseconds / FRAME_REPORT_INTERVAL) << " ms"
+			<< ", GPU time: " << (gpuMilliseconds / FRAME_REPORT_INTERVAL) << " ms";
+		double effectMilliseconds = 0.0;
+		for (int p = 0; p < EffectsManager::PASS_COUNT; p++)
+		{
+			if (passMilliseconds[p] > 0.0)
+			{
+				std::cout << ", " << EffectsManager::GetPassName((EffectsManager::EFFECT_PASS)p)
+					<< ": " << (passMilliseconds[p] / FRAME_REPORT_INTERVAL) << " ms";
+				effectMilliseconds += passMilliseconds[p];
+			}
+		}
+		std::cout << ", effect total: " << (effectMilliseconds / FRAME_REPORT_INTERVAL) << " ms";
+		if (resolutions[r] != EffectsManager::RESOLUTION_FULL)
+		{
+			double psnr = 0.0;
+			double meanError = 0.0;
+			PostProcessManager::CompareCaptures(image, reference, psnr, meanError);
+			std::cout << ", PSNR: " << psnr << " dB, mean error: " << meanError;
+		}
+		std::cout << std::endl;
+	}
+}
+
+/***********************************************************
+ *	RunNullBenchmark()
+ *
+ *  This function is used to place the passed in number of
+ *  objects and record and submit them with the null backend
+ *  while the camera follows the test path, once for each
+ *  number of recording threads, then output the average CPU
+ *  times of a frame for each, and the commands of a frame.
+ ***********************************************************/
+void RunNullBenchmark(int objectCount)
+{
+	const int segmentTotal = (sizeof(CAMERA_PATH) / sizeof(CAMERA_PATH[0])) - 1;
+	const glm::mat4 projection = glm::perspective(glm::radians(45.0f), 1000.0f / 800.0f, 0.1f, 100.0f);
+
+	RenderDevice device(RenderDevice::BACKEND_NULL);
+	ObjectManager objects(&device);
+	if (objects.CreateResources() == false)
+	{
+		std::cout << "ERROR: Could not create the resources of the objects" << std::endl;
+		return;
+	}
+	objects.CreateObjects(objectCount);
+
+	const int runTotal = sizeof(NULL_BENCHMARK_THREAD_COUNTS) / sizeof(NULL_BENCHMARK_THREAD_COUNTS[0]);
+	double singleMilliseconds = 0.0;
+	for (int r = 0; r < runTotal; r++)
+	{
+		// the objects are recorded on the threads of a job system
+		JobSystem jobSystem(NULL_BENCHMARK_THREAD_COUNTS[r]);
+		objects.SetJobSystem(&jobSystem);
+
+		double recordMilliseconds = 0.0;
+		double submitMilliseconds = 0.0;
+		double visibleCount = 0.0;
+		double nearCount = 0.0;
+		device.ResetCounters();
+		// the first frame sizes the lists and the arena, so it is
+		// left out of the allocation count
+		objects.Render(projection);
+		unsigned long long startAllocations = AllocationTracker::GetAllocationCount();
+		for (int i = 0; i < NULL_BENCHMARK_FRAMES; i++)
+		{
+			// the same eased camera motion as PlaceCameraOnPath()
+			float pathPosition = (float)(i * segmentTotal) / NULL_BENCHMARK_FRAMES;
+			int segment = (int)pathPosition;
+			float t = pathPosition - segment;
+			t = t * t * (3.0f - (2.0f * t));
+			const CAMERA_WAYPOINT& from = CAMERA_PATH[segment];
+			const CAMERA_WAYPOINT& to = CAMERA_PATH[segment + 1];
+			glm::mat4 view = glm::lookAt(
+				glm::mix(from.position, to.position, t),
+				glm::mix(from.target, to.target, t),
+				glm::vec3(0.0f, 1.0f, 0.0f));
+
+			objects.Render(projection * view);
+			recordMilliseconds += objects.GetLastRecordMilliseconds();
+			submitMilliseconds += objects.GetLastSubmitMilliseconds();
+			visibleCount += objects.GetVisibleCount();
+			nearCount += objects.GetLODDrawCount(0);
+		}
+
+		double frameMilliseconds = (recordMilliseconds + submitMilliseconds) / NULL_BENCHMARK_FRAMES;
+		if (r == 0)
+		{
+			singleMilliseconds = frameMilliseconds;
+		}
+		std::cout << "INFO: Null backend threads: " << objects.GetThreadCount()
+			<< ", objects: " << objects.GetObjectCount()
+			<< ", visible: " << (visibleCount / NULL_BENCHMARK_FRAMES)
+			<< ", near LOD: " << (nearCount / NULL_BENCHMARK_FRAMES)
+			<< ", record time: " << (recordMilliseconds / NULL_BENCHMARK_FRAMES) << " ms"
+			<< ", submit time: " << (submitMilliseconds / NULL_BENCHMARK_FRAMES) << " ms"
+			<< ", frame time: " << frameMilliseconds << " ms"
+			<< ", speedup: " << (singleMilliseconds / frameMilliseconds)
+			<< ", heap allocations per frame: " << ((double)(AllocationTracker::GetAllocationCount() - startAllocations) / NULL_BENCHMARK_FRAMES)
+			<< ", frame arena: " << (objects.GetFrameArena()->GetPeakFrameBytes() / 1024) << " KB"
+			<< std::endl;
+		objects.SetJobSystem(NULL);
+	}
+	std::cout << "INFO: Commands over " << NULL_BENCHMARK_FRAMES << " frames" << std::endl;
+	device.ReportCounters();
+}
+
+/***********************************************************
+ *	ExecuteEmptyJob()
+ *
+ *  This function is used as the job of the spawn benchmark,
+ *  which does nothing so only the overhead is measured.
+ ***********************************************************/
+void ExecuteEmptyJob(void* /*pOwner*/, size_t /*first*/, size_t /*count*/)
+{
+}
+
+/***********************************************************
+ *	ExecuteBenchmarkItems()
+ *
+ *  This function is used as the job of the parallel for
+ *  benchmark, which writes a few math operations for each
+ *  item of a range, enough work that the memory bandwidth
+ *  does not limit the scaling.
+ ***********************************************************/
+void ExecuteBenchmarkItems(void* pOwner, size_t first, size_t count)
+{
+	float* pItems = (float*)pOwner;
+	for (size_t i = first; i < first + count; i++)
+	{
+		float x = (float)i * 0.001f;
+		pItems[i] = std::sqrt(x) * std::sin(x) + std::cos(x * 0.5f);
+	}
+}
+
+/***********************************************************
+ *	RunJobBenchmark()
+ *
+ *  This function is used to measure the job system with 1
+ *  to 32 threads: the time to spawn and run an empty job,
+ *  the time to hand one job to every thread compared to
+ *  starting and joining that many threads, and the time and
+ *  speedup of a parallel for over 10M items.
+ ***********************************************************/
+void RunJobBenchmark()
+{
+	std::vector<float> items(JOB_BENCHMARK_ITEMS);
+	const int runTotal = sizeof(JOB_BENCHMARK_THREAD_COUNTS) / sizeof(JOB_BENCHMARK_THREAD_COUNTS[0]);
+	double singleMilliseconds = 0.0;
+
+	for (int r = 0; r < runTotal; r++)
+	{
+		JobSystem jobSystem(JOB_BENCHMARK_THREAD_COUNTS[r]);
+		const int threadCount = jobSystem.GetThreadCount();
+
+		// spawn empty jobs from this thread, then run them
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		JobSystem::JOB_COUNTER spawned;
+		for (int i = 0; i < JOB_BENCHMARK_SPAWNS; i++)
+		{
+			jobSystem.Run(&ExecuteEmptyJob, NULL, &spawned);
+		}
+		jobSystem.Wait(&spawned);
+		double spawnNanoseconds = std::chrono::duration<double, std::nano>(
+			std::chrono::steady_clock::now() - start).count() / JOB_BENCHMARK_SPAWNS;
+
+		// one job for each thread, against a thread started for each
+		start = std::chrono::steady_clock::now();
+		for (int i = 0; i < JOB_BENCHMARK_REPEATS; i++)
+		{
+			JobSystem::JOB_COUNTER dispatched;
+			jobSystem.ParallelFor(&ExecuteEmptyJob, NULL, threadCount, 1, &dispatched);
+			jobSystem.Wait(&dispatched);
+		}
+		double dispatchMicroseconds = std::chrono::duration<double, std::micro>(
+			std::chrono::steady_clock::now() - start).count() / JOB_BENCHMARK_REPEATS;
+		start = std::chrono::steady_clock::now();
+		for (int i = 0; i < JOB_BENCHMARK_REPEATS; i++)
+		{
+			std::vector<std::thread> threads;
+			for (int t = 1; t < threadCount; t++)
+			{
+				threads.push_back(std::thread(&ExecuteEmptyJob, (void*)NULL, (size_t)t, (size_t)1));
+			}
+			for (size_t t = 0; t < threads.size(); t++)
+			{
+				threads[t].join();
+			}
+		}
+		double threadMicroseconds = std::chrono::duration<double, std::micro>(
+			std::chrono::steady_clock::now() - start).count() / JOB_BENCHMARK_REPEATS;
+
+		// the same parallel for, repeated
+		jobSystem.ResetCounters();
+		start = std::chrono::steady_clock::now();
+		for (int i = 0; i < JOB_BENCHMARK_REPEATS; i++)
+		{
+			JobSystem::JOB_COUNTER processed;
+			jobSystem.ParallelFor(&ExecuteBenchmarkItems, &items[0], items.size(), JOB_BENCHMARK_GRAIN, &processed);
+			jobSystem.Wait(&processed);
+		}
+		double forMilliseconds = std::chrono::duration<double, std::milli>(
+			std::chrono::steady_clock::now() - start).count() / JOB_BENCHMARK_REPEATS;
+		if (r == 0)
+		{
+			singleMilliseconds = forMilliseconds;
+		}
+
+		std::cout << "INFO: Job system threads: " << threadCount
+			<< ", spawn: " << spawnNanoseconds << " ns per job"
+			<< ", dispatch: " << dispatchMicroseconds << " us"
+			<< " (thread start and join: " << threadMicroseconds << " us)"
+			<< ", parallel for " << items.size() << " items: " << forMilliseconds << " ms"
+			<< ", speedup: " << (singleMilliseconds / forMilliseconds)
+			<< ", ranges: " << (jobSystem.GetExecutedCount() / JOB_BENCHMARK_REPEATS)
+			<< ", stolen: " << (jobSystem.GetStolenCount() / JOB_BENCHMARK_REPEATS)
+			<< std::endl;
+	}
+}
+
+/***********************************************************
+ *	RunPoolBenchmark()
+ *
+ *  This function is used to measure creating and destroying
+ *  1M objects in a handle pool against creating each one on
+ *  the general heap.  Half of the objects are destroyed in a
+ *  random order and created again, so the heap objects end up
+ *  scattered, before both are iterated over.  The handles of
+ *  the destroyed objects are then looked up, before and after
+ *  their slots are reused, and each must be found stale.
+ ***********************************************************/
+void RunPoolBenchmark()
+{
+	const int objectCount = POOL_BENCHMARK_OBJECTS;
+	HandlePool<POOL_BENCHMARK_OBJECT> pool(objectCount);
+	std::vector<unsigned int> handles(objectCount);
+	std::vector<POOL_BENCHMARK_OBJECT*> pointers(objectCount);
+
+	// fixed seed so every run destroys the objects in the same order
+	std::mt19937 generator(330);
+	std::vector<int> order(objectCount);
+	for (int i = 0; i < objectCount; i++)
+	{
+		order[i] = i;
+	}
+	std::shuffle(order.begin(), order.end(), generator);
+
+	POOL_BENCHMARK_OBJECT object;
+	object.model = glm::mat4(1.0f);
+	object.color = glm::vec4(1.0f);
+	object.radius = 1.0f;
+
+	// create every object
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int i = 0; i < objectCount; i++)
+	{
+		object.center = glm::vec3((float)i, 0.0f, 0.0f);
+		handles[i] = pool.Add(object);
+	}
+	double poolCreateNanoseconds = std::chrono::duration<double, std::nano>(
+		std::chrono::steady_clock::now() - start).count() / objectCount;
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < objectCount; i++)
+	{
+		object.center = glm::vec3((float)i, 0.0f, 0.0f);
+		pointers[i] = new POOL_BENCHMARK_OBJECT(object);
+	}
+	double heapCreateNanoseconds = std::chrono::duration<double, std::nano>(
+		std::chrono::steady_clock::now() - start).count() / objectCount;
+
+	// destroy half in a random order and create them again
+	for (int i = 0; i < objectCount / 2; i++)
+	{
+		int index = order[i];
+		pool.Remove(handles[index]);
+		delete pointers[index];
+	}
+	for (int i = 0; i < objectCount / 2; i++)
+	{
+		int index = order[i];
+		object.center = glm::vec3((float)index, 0.0f, 0.0f);
+		handles[index] = pool.Add(object);
+		pointers[index] = new POOL_BENCHMARK_OBJECT(object);
+	}
+
+	// iterate over the packed pool and over the heap objects
+	start = std::chrono::steady_clock::now();
+	float poolSum = 0.0f;
+	for (int i = 0; i < pool.GetCount(); i++)
+	{
+		poolSum += pool.GetAt(i).center.x * pool.GetAt(i).radius;
+	}
+	double poolIterateMilliseconds = std::chrono::duration<double, std::milli>(
+		std::chrono::steady_clock::now() - start).count();
+	start = std::chrono::steady_clock::now();
+	float heapSum = 0.0f;
+	for (int i = 0; i < objectCount; i++)
+	{
+		heapSum += pointers[i]->center.x * pointers[i]->radius;
+	}
+	double heapIterateMilliseconds = std::chrono::duration<double, std::milli>(
+		std::chrono::steady_clock::now() - start).count();
+
+	// destroy every object in a random order
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < objectCount; i++)
+	{
+		pool.Remove(handles[order[i]]);
+	}
+	double poolDestroyNanoseconds = std::chrono::duration<double, std::nano>(
+		std::chrono::steady_clock::now() - start).count() / objectCount;
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < objectCount; i++)
+	{
+		delete pointers[order[i]];
+	}
+	double heapDestroyNanoseconds = std::chrono::duration<double, std::nano>(
+		std::chrono::steady_clock::now() - start).count() / objectCount;
+
+	// every handle is stale now, and stays stale when its slot is reused
+	int staleCount = 0;
+	for (int i = 0; i < objectCount; i++)
+	{
+		staleCount += (NULL == pool.Get(handles[i])) ? 1 : 0;
+	}
+	for (int i = 0; i < objectCount; i++)
+	{
+		pool.Add(object);
+	}
+	int reusedStaleCount = 0;
+	for (int i = 0; i < objectCount; i++)
+	{
+		reusedStaleCount += (pool.IsValid(handles[i]) == false) ? 1 : 0;
+	}
+
+	std::cout << "INFO: Pool benchmark objects: " << objectCount
+		<< ", create: " << poolCreateNanoseconds << " ns per object"
+		<< " (heap: " << heapCreateNanoseconds << " ns)"
+		<< ", destroy: " << poolDestroyNanoseconds << " ns per object"
+		<< " (heap: " << heapDestroyNanoseconds << " ns)"
+		<< ", iterate: " << poolIterateMilliseconds << " ms"
+		<< " (heap: " << heapIterateMilliseconds << " ms)"
+		<< ", checksums: " << poolSum << " / " << heapSum
+		<< std::endl;
+	std::cout << "INFO: Pool benchmark stale handles found: " << staleCount << " of " << objectCount
+		<< " after destroying, " << reusedStaleCount << " of " << objectCount
+		<< " after reusing their slots" << std::endl;
+	if ((staleCount != objectCount) || (reusedStaleCount != objectCount))
+	{
+		std::cout << "ERROR: Pool benchmark handles of destroyed objects were not found stale" << std::endl;
+	}
+}
+
+/***********************************************************
+ *	RunEcsBenchmark()
+ *
+ *  This function is used to measure the entity storage and
+ *  systems as the entities grow from 10k to 1M.  Entities
+ *  with the components of a drawn object are scattered in a
+ *  cube and created, then the transform system calculates
+ *  all of their world matrices and the culling system tests
+ *  them against a view of part of the cube, on 1 to 8
+ *  threads.  Half of the entities are then destroyed in a
+ *  random order.
+ ***********************************************************/
+void RunEcsBenchmark()
+{
+	const EntityManager::COMPONENT_MASK components =
+		EntityManager::MASK_TRANSFORM | EntityManager::MASK_WORLD_MATRIX | EntityManager::MASK_MESH |
+		EntityManager::MASK_MATERIAL | EntityManager::MASK_BOUNDS | EntityManager::MASK_VISIBILITY;
+	const int countTotal = sizeof(ECS_BENCHMARK_ENTITY_COUNTS) / sizeof(ECS_BENCHMARK_ENTITY_COUNTS[0]);
+	const int runTotal = sizeof(ECS_BENCHMARK_THREAD_COUNTS) / sizeof(ECS_BENCHMARK_THREAD_COUNTS[0]);
+
+	// the view looks down the cube from one side of it
+	glm::mat4 viewProjection =
+		glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, ECS_BENCHMARK_HALF_EXTENT * 2.0f) *
+		glm::lookAt(
+			glm::vec3(0.0f, 0.0f, ECS_BENCHMARK_HALF_EXTENT),
+			glm::vec3(0.0f, 0.0f, 0.0f),
+			glm::vec3(0.0f, 1.0f, 0.0f));
+
+	std::vector<EntityManager::CHUNK*> chunks;
+	for (int n = 0; n < countTotal; n++)
+	{
+		const int entityCount = ECS_BENCHMARK_ENTITY_COUNTS[n];
+		EntityManager entities(entityCount);
+		std::vector<unsigned int> handles(entityCount);
+
+		// fixed seed so every run places and destroys the same entities
+		std::mt19937 generator(330);
+		std::uniform_real_distribution<float> place(-ECS_BENCHMARK_HALF_EXTENT, ECS_BENCHMARK_HALF_EXTENT);
+		std::uniform_real_distribution<float> turn(0.0f, 360.0f);
+		std::uniform_real_distribution<float> size(0.5f, 2.0f);
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (int i = 0; i < entityCount; i++)
+		{
+			handles[i] = entities.CreateEntity(components);
+			entities.SetTransform(
+				handles[i],
+				glm::vec3(place(generator), place(generator), place(generator)),
+				glm::vec3(0.0f, turn(generator), 0.0f),
+				glm::vec3(size(generator)));
+		}
+		double createNanoseconds = std::chrono::duration<double, std::nano>(
+			std::chrono::steady_clock::now() - start).count() / entityCount;
+		std::cout << "INFO: ECS benchmark entities: " << entityCount
+			<< ", archetypes: " << entities.GetArchetypeCount()
+			<< ", chunks: " << entities.GetChunkCount()
+			<< ", create: " << createNanoseconds << " ns per entity" << std::endl;
+
+		double singleTransformMilliseconds = 0.0;
+		double singleCullMilliseconds = 0.0;
+		for (int r = 0; r < runTotal; r++)
+		{
+			JobSystem jobSystem(ECS_BENCHMARK_THREAD_COUNTS[r]);
+			entities.SetJobSystem(&jobSystem);
+
+			// every transform changed before each run of the transform system
+			double transformMilliseconds = 0.0;
+			double cullMilliseconds = 0.0;
+			for (int i = 0; i < ECS_BENCHMARK_REPEATS; i++)
+			{
+				entities.FindChunks(EntityManager::MASK_TRANSFORM, 0, chunks);
+				for (size_t c = 0; c < chunks.size(); c++)
+				{
+					chunks[c]->bTransformsDirty = true;
+				}
+				entities.UpdateTransforms();
+				transformMilliseconds += entities.GetLastTransformMilliseconds();
+				entities.CullEntities(viewProjection);
+				cullMilliseconds += entities.GetLastCullMilliseconds();
+			}
+			transformMilliseconds /= ECS_BENCHMARK_REPEATS;
+			cullMilliseconds /= ECS_BENCHMARK_REPEATS;
+			if (r == 0)
+			{
+				singleTransformMilliseconds = transformMilliseconds;
+				singleCullMilliseconds = cullMilliseconds;
+			}
+
+			int visibleCount = 0;
+			entities.FindChunks(EntityManager::MASK_VISIBILITY, 0, chunks);
+			for (size_t c = 0; c < chunks.size(); c++)
+			{
+				for (int i = 0; i < chunks[c]->count; i++)
+				{
+					visibleCount += (chunks[c]->pVisibility[i].bVisible == true) ? 1 : 0;
+				}
+			}
+
+			std::cout << "INFO: ECS benchmark entities: " << entityCount
+				<< ", threads: " << jobSystem.GetThreadCount()
+				<< ", transforms: " << transformMilliseconds << " ms"
+				<< " (" << (transformMilliseconds * 1000000.0 / entityCount) << " ns per entity"
+				<< ", speedup: " << (singleTransformMilliseconds / transformMilliseconds) << ")"
+				<< ", culling: " << cullMilliseconds << " ms"
+				<< " (" << (cullMilliseconds * 1000000.0 / entityCount) << " ns per entity"
+				<< ", speedup: " << (singleCullMilliseconds / cullMilliseconds) << ")"
+				<< ", visible: " << visibleCount << std::endl;
+			entities.SetJobSystem(NULL);
+		}
+
+		// destroy half of the entities in a random order
+		std::shuffle(handles.begin(), handles.end(), generator);
+		start = std::chrono::steady_clock::now();
+		for (int i = 0; i < entityCount / 2; i++)
+		{
+			entities.DestroyEntity(handles[i]);
+		}
+		double destroyNanoseconds = std::chrono::duration<double, std::nano>(
+			std::chrono::steady_clock::now() - start).count() / (entityCount / 2);
+		std::cout << "INFO: ECS benchmark entities: " << entityCount
+			<< ", destroy: " << destroyNanoseconds << " ns per entity"
+			<< ", left: " << entities.GetEntityCount()
+			<< " in " << entities.GetChunkCount() << " chunks" << std::endl;
+	}
+}
+
+/***********************************************************
+ *	RunSceneBenchmark()
+ *
+ *  This function is used to measure reading a scene file
+ *  and applying it to a scene of the passed in number of
+ *  objects.  A scene of boxes and spheres scattered in a
+ *  cube is written and read, then written again and read
+ *  again unchanged, with every 100th object moved, with
+ *  every 100th object replaced by a new one, and with all
+ *  of the objects moved.  The scene has no textures, so no
+ *  OpenGL context is needed.
+ ***********************************************************/
+void RunSceneBenchmark(int objectCount)
+{
+	const char* const STEP_NAMES[] =
+	{
+		"first read",
+		"unchanged",
+		"1% moved",
+		"1% replaced",
+		"all moved"
+	};
+	const int stepTotal = sizeof(STEP_NAMES) / sizeof(STEP_NAMES[0]);
+	std::mt19937 generator(330);
+	std::uniform_real_distribution<float> place(-SCENE_BENCHMARK_HALF_EXTENT, SCENE_BENCHMARK_HALF_EXTENT);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+	SceneFile::SCENE_DESC scene;
+
+	for (int i = 0; i < SCENE_BENCHMARK_MATERIALS; i++)
+	{
+		SceneFile::MATERIAL_DESC material;
+		snprintf(material.tag, sizeof(material.tag), "material%d", i);
+		material.diffuseColor = glm::vec3(unit(generator), unit(generator), unit(generator));
+		material.specularColor = glm::vec3(0.5f);
+		material.shininess = 32.0f;
+		material.opacity = 1.0f;
+		scene.materials.push_back(material);
+	}
+	scene.objects.resize(objectCount);
+	for (int i = 0; i < objectCount; i++)
+	{
+		SceneFile::OBJECT_DESC& object = scene.objects[i];
+		snprintf(object.name, sizeof(object.name), "object%d", i);
+		object.mesh = ((i % 2) == 0) ? SceneFile::MESH_BOX : SceneFile::MESH_SPHERE;
+		object.position = glm::vec3(place(generator), place(generator), place(generator));
+		object.rotationDegrees = glm::vec3(0.0f, unit(generator) * 360.0f, 0.0f);
+		object.scale = glm::vec3(1.0f);
+		object.texture = -1;
+		object.material = i % SCENE_BENCHMARK_MATERIALS;
+		object.shininess = -1.0f;
+		object.bDynamic = false;
+	}
+
+	SceneManager sceneManager(NULL);
+	for (int step = 0; step < stepTotal; step++)
+	{
+		for (int i = 0; i < objectCount; i++)
+		{
+			bool bEdited = ((i % SCENE_BENCHMARK_EDIT_INTERVAL) == 0);
+			if ((step == 4) || ((step == 2) && (bEdited == true)))
+			{
+				scene.objects[i].position.y += 1.0f;
+			}
+			// a new name is a new object in place of the old one
+			if ((step == 3) && (bEdited == true))
+			{
+				snprintf(scene.objects[i].name, sizeof(scene.objects[i].name), "replaced%d", i);
+			}
+		}
+		if (SceneFile::Save(SCENE_BENCHMARK_FILENAME, scene) == false)
+		{
+			std::cout << "ERROR: Could not write the benchmark scene " << SCENE_BENCHMARK_FILENAME << std::endl;
+			return;
+		}
+
+		bool bLoaded = (step == 0) ?
+			sceneManager.LoadScene(SCENE_BENCHMARK_FILENAME) :
+			sceneManager.ReloadScene();
+		if (bLoaded == false)
+		{
+			break;
+		}
+		const SceneManager::SCENE_CHANGES& changes = sceneManager.GetLastSceneChanges();
+		std::cout << "INFO: Scene benchmark objects: " << sceneManager.GetSceneObjectCount()
+			<< ", " << STEP_NAMES[step]
+			<< ": " << (sceneManager.GetLastSceneLoadMilliseconds() + sceneManager.GetLastSceneApplyMilliseconds()) << " ms"
+			<< " (read: " << sceneManager.GetLastSceneLoadMilliseconds() << " ms"
+			<< ", apply: " << sceneManager.GetLastSceneApplyMilliseconds() << " ms)"
+			<< ", added: " << changes.addedObjects
+			<< ", changed: " << changes.changedObjects
+			<< ", removed: " << changes.removedObjects << std::endl;
+	}
+	std::remove(SCENE_BENCHMARK_FILENAME);
+}
+
+/***********************************************************
+ *	RunTraceReplay()
+ *
+ *  This function is used to load the passed in trace file,
+ *  replay its frame in a hidden window of the traced size,
+ *  then output the average CPU time of each call type and
+ *  the average GPU time of a frame.
+ ***********************************************************/
+bool RunTraceReplay(const char* filename)
+{
+	TracePlayer* pPlayer = new TracePlayer();
+	if (pPlayer->Load(filename) == false)
+	{
+		delete pPlayer;
+		return(false);
+	}
+
+	if (InitializeGLFW() == false)
+	{
+		delete pPlayer;
+		return(false);
+	}
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	GLFWwindow* window = glfwCreateWindow(
+		pPlayer->GetWindowWidth(), pPlayer->GetWindowHeight(), WINDOW_TITLE, NULL, NULL);
+#ifndef __APPLE__
+	// the same fallback as the display window
+	if (window == NULL)
+	{
+		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+		window = glfwCreateWindow(
+			pPlayer->GetWindowWidth(), pPlayer->GetWindowHeight(), WINDOW_TITLE, NULL, NULL);
+	}
+#endif
+	if (window == NULL)
+	{
+		std::cout << "Failed to create GLFW window" << std::endl;
+		glfwTerminate();
+		delete pPlayer;
+		return(false);
+	}
+	glfwMakeContextCurrent(window);
+
+	bool bReplayed = false;
+	if ((InitializeGLEW() == true) && (pPlayer->CreateResources() == true))
+	{
+		GpuTimer* pGpuTimer = new GpuTimer();
+		pGpuTimer->CreateQueries();
+
+		for (int i = 0; i < BENCHMARK_WARMUP_FRAMES; i++)
+		{
+			pPlayer->ReplayFrame();
+		}
+		glFinish();
+		pPlayer->ResetProfile();
+
+		double gpuMilliseconds = 0.0;
+		for (int i = 0; i < FRAME_REPORT_INTERVAL; i++)
+		{
+			pGpuTimer->Begin();
+			pPlayer->ReplayFrame();
+			pGpuTimer->End();
+			if (pGpuTimer->HasResult() == true)
+			{
+				gpuMilliseconds += pGpuTimer->GetLastMilliseconds();
+			}
+		}
+		glFinish();
+
+		pPlayer->ReportProfile();
+		std::cout << "INFO: Trace replay GPU time: " << (gpuMilliseconds / FRAME_REPORT_INTERVAL) << " ms" << std::endl;
+
+		delete pGpuTimer;
+		bReplayed = true;
+	}
+	else
+	{
+		std::cout << "ERROR: Could not create the resources of the trace" << std::endl;
+	}
+
+	pPlayer->DestroyResources();
+	delete pPlayer;
+	glfwDestroyWindow(window);
+	glfwTerminate();
+	return(bReplayed);
+}
+
+/***********************************************************
+ *	PlaceCameraOnPath()
+ *
+ *  This function is used to place the camera at the passed
+ *  in time along the test path of the dynamic resolution,
+ *  easing in and out of every waypoint.  It returns false
+ *  once the end of the path has been passed.
+ ***********************************************************/
+bool PlaceCameraOnPath(float pathSeconds)
+{
+	const int segmentTotal = (sizeof(CAMERA_PATH) / sizeof(CAMERA_PATH[0])) - 1;
+
+	int segment = (int)(pathSeconds / CAMERA_PATH_SEGMENT_SECONDS);
+	if (segment >= segmentTotal)
+	{
+		return(false);
+	}
+
+	float t = (pathSeconds / CAMERA_PATH_SEGMENT_SECONDS) - segment;
+	t = t * t * (3.0f - (2.0f * t));
+	const CAMERA_WAYPOINT& from = CAMERA_PATH[segment];
+	const CAMERA_WAYPOINT& to = CAMERA_PATH[segment + 1];
+	g_ViewManager->SetCameraPose(
+		glm::mix(from.position, to.position, t),
+		glm::mix(from.target, to.target, t));
+
+	return(true);
+}
+
+/***********************************************************
+ *	UpdateFrame()
+ *
+ *  This function is used to read the input, update the
+ *  camera and the scene time, and publish them as the
+ *  snapshot of the next frame to draw.  It always runs on
+ *  the main thread, which GLFW reads the events on.  The
+ *  objects and lights are animated to the scene time of the
+ *  snapshot by the thread that draws it, since they live in
+ *  the buffers of its OpenGL context.
+ ***********************************************************/
+void UpdateFrame()
+{
+	// query the latest GLFW events
+	glfwPollEvents();
+	std::chrono::steady_clock::time_point inputTime = std::chrono::steady_clock::now();
+
+	// move the camera along the test path, and stop at its end
+	float pathSeconds = (float)(glfwGetTime() - g_pathStartTime);
+	if ((g_bRunResolutionPath == true) && (PlaceCameraOnPath(pathSeconds) == false))
+	{
+		glfwSetWindowShouldClose(g_Window, GLFW_TRUE);
+	}
+	g_ViewManager->UpdateCamera();
+	double sceneSeconds = glfwGetTime();
+
+	// keep the CPU busy for the requested update time
+	if (g_updateLoadMilliseconds > 0.0)
+	{
+		std::chrono::duration<double, std::milli> load(g_updateLoadMilliseconds);
+		while ((std::chrono::steady_clock::now() - inputTime) < load)
+		{
+		}
+	}
+
+	SnapshotBuffer::FRAME_SNAPSHOT& snapshot = g_SnapshotBuffer->GetWriteSnapshot();
+	snapshot.updateIndex = g_updateIndex++;
+	snapshot.camera = g_ViewManager->GetCameraState();
+	snapshot.sceneSeconds = sceneSeconds;
+	snapshot.pathSeconds = pathSeconds;
+	snapshot.inputTime = inputTime;
+	g_SnapshotBuffer->Publish();
+}
+
+/***********************************************************
+ *	WaitForNextUpdate()
+ *
+ *  This function is used to pace the updates of the main
+ *  thread while a render thread draws, by waiting for the
+ *  passed in time of the next update and moving it on by
+ *  one interval.  The input events are handled while it
+ *  waits.  An update that fell behind starts the schedule
+ *  over rather than catching up.
+ ***********************************************************/
+void WaitForNextUpdate(double& nextUpdateTime)
+{
+	nextUpdateTime += RENDER_THREAD_UPDATE_SECONDS;
+	double currentTime = glfwGetTime();
+	if (currentTime >= nextUpdateTime)
+	{
+		nextUpdateTime = currentTime;
+		return;
+	}
+
+	while ((currentTime < nextUpdateTime) && (!glfwWindowShouldClose(g_Window)))
+	{
+		glfwWaitEventsTimeout(nextUpdateTime - currentTime);
+		currentTime = glfwGetTime();
+	}
+}
+
+/***********************************************************
+ *	DrawWindowFrame()
+ *
+ *  This function is used to draw the latest published
+ *  snapshot into the window and show it.  The last snapshot
+ *  is drawn again when no newer one is ready, so a slow
+ *  update never holds back the drawing.
+ ***********************************************************/
+void DrawWindowFrame()
+{
+	bool bNewSnapshot = g_SnapshotBuffer->Acquire();
+	const SnapshotBuffer::FRAME_SNAPSHOT& snapshot = g_SnapshotBuffer->GetReadSnapshot();
+	g_ViewManager->SetCameraState(snapshot.camera);
+	g_pDrawnSnapshot = &snapshot;
+
+	// apply the edits of the scene file before the frame is drawn
+	CheckSceneFile();
+
+	// save the objects and state, then record the calls of the frame
+	if ((NULL != g_TraceRecorder) && (g_frameIndex == g_traceFrame))
+	{
+		g_TraceRecorder->BeginFrame(
+			g_ViewManager->GetWindowWidth(),
+			g_ViewManager->GetWindowHeight());
+	}
+
+	// draw the scene with the selected rendering path
+	if (NULL != g_GpuTimer)
+	{
+		g_GpuTimer->Begin();
+	}
+	RenderFrame(g_renderPath, g_bDepthPrePass);
+	if (NULL != g_GpuTimer)
+	{
+		g_GpuTimer->End();
+	}
+
+	if ((NULL != g_TraceRecorder) && (g_TraceRecorder->IsRecording() == true))
+	{
+		g_TraceRecorder->EndFrame();
+		g_TraceRecorder->ReportCounts();
+		if (g_TraceRecorder->Save(TRACE_FILENAME) == true)
+		{
+			std::cout << "INFO: Frame " << g_frameIndex << " traced into " << TRACE_FILENAME << std::endl;
+		}
+	}
+	g_frameIndex++;
+
+	// scale the resolution of the next frames to the GPU time
+	if ((NULL != g_ResolutionManager) && (g_GpuTimer->HasResult() == true) &&
+		(g_ResolutionManager->AddFrameTime(g_GpuTimer->GetLastMilliseconds()) == true) &&
+		(g_bRunResolutionPath == true))
+	{
+		std::cout << "INFO: Camera path " << snapshot.pathSeconds << " s"
+			<< ", GPU time: " << g_ResolutionManager->GetAverageMilliseconds() << " ms"
+			<< ", render scale: " << g_ResolutionManager->GetScale()
+			<< " (" << g_ResolutionManager->GetRenderWidth()
+			<< "x" << g_ResolutionManager->GetRenderHeight() << ")"
+			<< std::endl;
+	}
+
+	// Flips the the back buffer with the front buffer every frame.
+	glfwSwapBuffers(g_Window);
+	g_pDrawnSnapshot = NULL;
+
+	// the input of a new snapshot is shown once the swap returns
+	if (bNewSnapshot == true)
+	{
+		std::chrono::duration<double, std::milli> latency =
+			std::chrono::steady_clock::now() - snapshot.inputTime;
+		g_inputLatencyMilliseconds += latency.count();
+		g_inputLatencyFrames++;
+	}
+
+	// close the heap allocation counts of the frame
+	AllocationTracker::EndFrame();
+	if (g_bAllocationTest == true)
+	{
+		CheckFrameAllocations();
+	}
+
+	// report the measured frame times when benchmarking
+	if (g_bReportStats == true)
+	{
+		double currentFrameTime = glfwGetTime();
+		ReportFrameTime(currentFrameTime - g_lastFrameTime);
+		g_lastFrameTime = currentFrameTime;
+	}
+}
+
+/***********************************************************
+ *	CheckSceneFile()
+ *
+ *  This function is used to read the scene file again when
+ *  it was saved since it was last read, checking it twice
+ *  a second.  It runs on the thread that owns the OpenGL
+ *  context, since new textures are uploaded and the lights
+ *  are set into the default shader.  When the objects or the
+ *  lights changed, the probes near them are baked again.
+ ***********************************************************/
+void CheckSceneFile()
+{
+	double currentTime = glfwGetTime();
+	if ((currentTime - g_lastSceneCheckTime) < SCENE_WATCH_SECONDS)
+	{
+		return;
+	}
+	g_lastSceneCheckTime = currentTime;
+
+	if (g_SceneManager->HasSceneFileChanged() == true)
+	{
+		g_ShaderManager->use();
+		g_SceneManager->SetShaderManager(g_ShaderManager);
+		if (g_SceneManager->ReloadScene() == false)
+		{
+			return;
+		}
+
+		const SceneManager::SCENE_CHANGES& changes = g_SceneManager->GetLastSceneChanges();
+		bool bSceneChanged = (changes.addedObjects > 0) || (changes.changedObjects > 0) ||
+			(changes.removedObjects > 0) || (changes.bLightsChanged == true);
+		if ((NULL != g_ProbeManager) && (bSceneChanged == true))
+		{
+			g_ProbeManager->UpdateProbes(g_LightmapManager, g_SceneManager);
+			g_ShaderManager->use();
+			g_SceneManager->SetShaderManager(g_ShaderManager);
+		}
+	}
+}
+
+/***********************************************************
+ *	CheckFrameAllocations()
+ *
+ *  This function is used to fail the allocation test when
+ *  a frame drawn after the warmup allocated from the general
+ *  heap on any thread, outputting the scopes it allocated
+ *  in, and to pass it once enough steady frames were drawn.
+ ***********************************************************/
+void CheckFrameAllocations()
+{
+	if (g_frameIndex <= ALLOCATION_TEST_WARMUP_FRAMES)
+	{
+		return;
+	}
+
+	if (AllocationTracker::GetLastFrameAllocationCount() > 0)
+	{
+		std::cout << "ERROR: Frame " << (g_frameIndex - 1) << " made "
+			<< AllocationTracker::GetLastFrameAllocationCount() << " heap allocations of "
+			<< AllocationTracker::GetLastFrameAllocationBytes() << " bytes" << std::endl;
+		AllocationTracker::ReportLastFrame();
+		g_bAllocationTestFailed = true;
+		glfwSetWindowShouldClose(g_Window, GLFW_TRUE);
+	}
+	else if (g_frameIndex >= ALLOCATION_TEST_WARMUP_FRAMES + ALLOCATION_TEST_FRAMES)
+	{
+		std::cout << "INFO: Allocation test passed, " << ALLOCATION_TEST_FRAMES
+			<< " steady frames without heap allocations" << std::endl;
+		glfwSetWindowShouldClose(g_Window, GLFW_TRUE);
+	}
+}
+
+/***********************************************************
+ *	RunRenderThread()
+ *
+ *  This function is used to draw the frames on the render
+ *  thread, which owns the OpenGL context of the window until
+ *  the window is closed.
+ ***********************************************************/
+void RunRenderThread()
+{
+	glfwMakeContextCurrent(g_Window);
+	while (!glfwWindowShouldClose(g_Window))
+	{
+		DrawWindowFrame();
+	}
+	glfwMakeContextCurrent(NULL);
+}
+
+/***********************************************************
+ *	ReportFrameTime()
+ *
+ *  This function is used to accumulate the frame times and
+ *  periodically output the average frame time.
+ ***********************************************************/
+void ReportFrameTime(double frameSeconds)
+{
+	static double totalSeconds = 0.0;
+	static int totalFrames = 0;
+	static unsigned long long lastAllocationCount = 0;
+	static unsigned long long lastAllocationBytes = 0;
+
+	totalSeconds += frameSeconds;
+	totalFrames++;
+	if (totalFrames < FRAME_REPORT_INTERVAL)
+	{
+		return;
+	}
+
+	unsigned long long allocationCount = AllocationTracker::GetAllocationCount();
+	unsigned long long allocationBytes = AllocationTracker::GetAllocationBytes();
+	std::cout << "INFO: Average frame time: " << (totalSeconds * 1000.0 / totalFrames) << " ms"
+		<< ", heap allocations per frame: " << ((double)(allocationCount - lastAllocationCount) / totalFrames)
+		<< " (" << ((double)(allocationBytes - lastAllocationBytes) / totalFrames) << " bytes)";
+	lastAllocationCount = allocationCount;
+	lastAllocationBytes = allocationBytes;
+	if ((NULL != g_ObjectManager) && (NULL != g_ObjectManager->GetFrameArena()))
+	{
+		std::cout << ", frame arena: " << (g_ObjectManager->GetFrameArena()->GetLastFrameBytes() / 1024) << " KB";
+	}
+	if (g_inputLatencyFrames > 0)
+	{
+		std::cout << ", input latency: " << (g_inputLatencyMilliseconds / g_inputLatencyFrames) << " ms";
+	}
+	if (NULL != g_SnapshotBuffer)
+	{
+		std::cout << ", updates: " << g_SnapshotBuffer->GetPublishedCount()
+			<< ", dropped: " << g_SnapshotBuffer->GetDroppedCount()
+			<< ", redrawn: " << g_SnapshotBuffer->GetRepeatedCount();
+		g_SnapshotBuffer->ResetCounters();
+	}
+	if (NULL != g_LightManager)
+	{
+		std::cout << ", lights: " << g_LightManager->GetLightCount()
+			<< ", light upload: " << g_LightManager->GetLastUploadBytes() << " bytes in "
+			<< g_LightManager->GetLastUploadRanges() << " ranges";
+	}
+	if ((NULL != g_ClusterManager) && (g_renderPath == RENDER_CLUSTERED))
+	{
+		std::cout << ", cluster light indices: " << g_ClusterManager->GetLastIndexCount();
+	}
+	if ((NULL != g_LightManager) && (g_renderPath == RENDER_OBJECT_LIGHTS))
+	{
+		std::cout << ", lights per object: " << g_LightManager->GetAverageObjectLights();
+	}
+	if ((NULL != g_GpuTimer) && (g_GpuTimer->HasResult() == true))
+	{
+		std::cout << ", GPU time: " << g_GpuTimer->GetLastMilliseconds() << " ms";
+	}
+	if ((NULL != g_OverdrawCounter) && (g_OverdrawCounter->HasResult() == true))
+	{
+		std::cout << ", overdraw: " << g_OverdrawCounter->GetOverdraw(
+			g_ViewManager->GetWindowWidth(),
+			g_ViewManager->GetWindowHeight());
+	}
+	if (NULL != g_ResolutionManager)
+	{
+		std::cout << ", render scale: " << g_ResolutionManager->GetScale();
+	}
+	if (NULL != g_PostProcessManager)
+	{
+		for (int p = 0; p < PostProcessManager::PASS_COUNT; p++)
+		{
+			double passMilliseconds = g_PostProcessManager->GetPassMilliseconds((PostProcessManager::POST_PASS)p);
+			if (passMilliseconds >= 0.0)
+			{
+				std::cout << ", " << PostProcessManager::GetPassName((PostProcessManager::POST_PASS)p)
+					<< ": " << passMilliseconds << " ms";
+			}
+		}
+	}
+	if (NULL != g_RenderGraph)
+	{
+		std::cout << ", transient memory: " << (g_RenderGraph->GetTransientBytes() / 1024)
+			<< " KB, aliased: " << (g_RenderGraph->GetAliasedBytes() / 1024) << " KB";
+	}
+	if (NULL != g_EffectsManager)
+	{
+		for (int p = 0; p < EffectsManager::PASS_COUNT; p++)
+		{
+			double passMilliseconds = g_EffectsManager->GetPassMilliseconds((EffectsManager::EFFECT_PASS)p);
+			if (passMilliseconds >= 0.0)
+			{
+				std::cout << ", " << EffectsManager::GetPassName((EffectsManager::EFFECT_PASS)p)
+					<< ": " << passMilliseconds << " ms";
+			}
+		}
+	}
+	if (NULL != g_ShadowManager)
+	{
+		std::cout << ", shadow maps drawn: " << g_ShadowManager->GetLastDrawnMapCount();
+	}
+	std::cout << std::endl;
+	if (g_bReportAllocations == true)
+	{
+		std::cout << "INFO: Heap allocations by scope" << std::endl;
+		AllocationTracker::ReportCounters(totalFrames);
+	}
+
+	totalSeconds = 0.0;
+	totalFrames = 0;
+	g_inputLatencyMilliseconds = 0.0;
+	g_inputLatencyFrames = 0;
+}
@@ -0,0 +1,746 @@
+///////////////////////////////////////////////////////////////////////////////
+// objectmanager.cpp
+// ============
+// manage a large field of simple objects drawn through the render device
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ObjectManager.h"
+
+#include <glm/gtx/transform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <thread>
+
+// declare the global variables
+namespace
+{
+	// area of the scene the objects are placed over
+	const float FIELD_MIN_X = -18.0f;
+	const float FIELD_MAX_X = 18.0f;
+	const float FIELD_MIN_Z = -9.5f;
+	const float FIELD_MAX_Z = 8.0f;
+	const float FIELD_MIN_Y = 0.25f;
+	const float FIELD_MAX_Y = 6.0f;
+	// largest edge length of an object
+	const float MAX_OBJECT_SIZE = 0.6f;
+	// direction the light of the object shaders comes from
+	const glm::vec3 LIGHT_DIRECTION = glm::vec3(-0.4f, -1.0f, -0.3f);
+	// entity chunks a thread takes from the queue at a time, 4096 objects
+	const size_t CHUNKS_PER_JOB = 4096 / EntityManager::CHUNK_CAPACITY;
+	// components of every placed object
+	const EntityManager::COMPONENT_MASK OBJECT_COMPONENTS =
+		EntityManager::MASK_TRANSFORM | EntityManager::MASK_WORLD_MATRIX | EntityManager::MASK_MESH |
+		EntityManager::MASK_MATERIAL | EntityManager::MASK_BOUNDS | EntityManager::MASK_VISIBILITY;
+	// starting size of the frame arena block of each thread
+	const size_t FRAME_ARENA_BYTES_PER_THREAD = 1 << 20;
+	// quads along each edge of the faces of the near mesh
+	const int NEAR_MESH_DIVISIONS = 4;
+	// objects farther than this many times their radius use the plain box
+	const float LOD_DISTANCE_RATIO = 40.0f;
+}
+
+/***********************************************************
+ *  ObjectManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ObjectManager::ObjectManager(RenderDevice* pDevice)
+{
+	m_pDevice = pDevice;
+	m_vertexBuffer = 0;
+	m_indexBuffer = 0;
+	m_objectBuffer = 0;
+	m_frameBuffer = 0;
+	for (int i = 0; i < DRAW_PASS_COUNT; i++)
+	{
+		m_pipelines[i] = 0;
+	}
+	for (int i = 0; i < LOD_COUNT; i++)
+	{
+		m_lodMeshes[i].firstIndex = 0;
+		m_lodMeshes[i].indexCount = 0;
+		m_lodDrawCounts[i] = 0;
+	}
+	m_objectStride = 0;
+	m_threadCount = 1;
+	m_pFrameArena = NULL;
+	SetThreadCount((int)std::thread::hardware_concurrency());
+	m_pJobSystem = NULL;
+	m_pEntities = new EntityManager(0);
+	m_nextChunk.store(0);
+	m_lastRecordMilliseconds = 0.0;
+	m_lastSubmitMilliseconds = 0.0;
+}
+
+/***********************************************************
+ *  ~ObjectManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ObjectManager::~ObjectManager()
+{
+	unsigned int buffers[4] = { m_vertexBuffer, m_indexBuffer, m_objectBuffer, m_frameBuffer };
+	for (int i = 0; i < 4; i++)
+	{
+		if (buffers[i] != 0)
+		{
+			m_pDevice->DestroyBuffer(buffers[i]);
+		}
+	}
+	for (int i = 0; i < DRAW_PASS_COUNT; i++)
+	{
+		if (m_pipelines[i] != 0)
+		{
+			m_pDevice->DestroyPipeline(m_pipelines[i]);
+		}
+	}
+
+	// the lists point into the arena, so they go first
+	m_threadPackets.clear();
+	m_threadOrders.clear();
+	m_sortedPackets = ArenaVector<SORT_ENTRY>();
+	m_mergeBuffer = ArenaVector<SORT_ENTRY>();
+	delete m_pFrameArena;
+	m_pFrameArena = NULL;
+	delete m_pEntities;
+	m_pEntities = NULL;
+}
+
+/***********************************************************
+ *  AddBoxMesh()
+ *
+ *  This method is used for adding a unit box centered on the
+ *  origin to the passed in vertices and indices, with each
+ *  face split into the passed in number of quads along its
+ *  edges.
+ ***********************************************************/
+void ObjectManager::AddBoxMesh(int divisions, std::vector<RenderDevice::VERTEX>& vertices, std::vector<GLuint>& indices)
+{
+	const glm::vec3 normals[6] = {
+		glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(-1.0f, 0.0f, 0.0f),
+		glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f),
+		glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, -1.0f) };
+
+	// a grid of corners for each face, counter clockwise seen from outside
+	for (int face = 0; face < 6; face++)
+	{
+		glm::vec3 normal = normals[face];
+		glm::vec3 v = (normal.y == 0.0f) ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(0.0f, 0.0f, 1.0f);
+		glm::vec3 u = glm::cross(v, normal);
+		GLuint first = (GLuint)vertices.size();
+		for (int y = 0; y <= divisions; y++)
+		{
+			for (int x = 0; x <= divisions; x++)
+			{
+				glm::vec2 corner = glm::vec2((float)x, (float)y) / (float)divisions;
+				RenderDevice::VERTEX vertex;
+				vertex.position = (normal + (u * (corner.x * 2.0f - 1.0f)) + (v * (corner.y * 2.0f - 1.0f))) * 0.5f;
+				vertex.normal = normal;
+				vertex.textureCoordinate = corner;
+				vertices.push_back(vertex);
+			}
+		}
+		for (int y = 0; y < divisions; y++)
+		{
+			for (int x = 0; x < divisions; x++)
+			{
+				GLuint corner = first + (y * (divisions + 1)) + x;
+				GLuint quadIndices[6] = {
+					corner, corner + 1, corner + divisions + 2,
+					corner, corner + divisions + 2, corner + divisions + 1 };
+				for (int i = 0; i < 6; i++)
+				{
+					indices.push_back(quadIndices[i]);
+				}
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  CreateResources()
+ *
+ *  This method is used for creating the box meshes of the
+ *  levels of detail, the uniform buffers of the objects and
+ *  the frame, and the pipelines the objects are drawn with.
+ *  Close objects are drawn with subdivided faces and the
+ *  distant ones with the plain box, from one vertex and one
+ *  index buffer.  Every pipeline sets all of the depth state
+ *  of its pass, and keeps the blending and culling the scene
+ *  is drawn with.
+ ***********************************************************/
+bool ObjectManager::CreateResources()
+{
+	std::vector<RenderDevice::VERTEX> vertices;
+	std::vector<GLuint> indices;
+	const int divisions[LOD_COUNT] = { NEAR_MESH_DIVISIONS, 1 };
+
+	for (int i = 0; i < LOD_COUNT; i++)
+	{
+		m_lodMeshes[i].firstIndex = (int)indices.size();
+		AddBoxMesh(divisions[i], vertices, indices);
+		m_lodMeshes[i].indexCount = (int)indices.size() - m_lodMeshes[i].firstIndex;
+	}
+
+	m_vertexBuffer = m_pDevice->CreateBuffer(
+		RenderDevice::BUFFER_VERTEX, vertices.size() * sizeof(RenderDevice::VERTEX), vertices.data());
+	m_indexBuffer = m_pDevice->CreateBuffer(
+		RenderDevice::BUFFER_INDEX, indices.size() * sizeof(GLuint), indices.data());
+
+	// each object reads its own aligned range of the object buffer
+	size_t alignment = m_pDevice->GetUniformAlignment();
+	m_objectStride = ((sizeof(OBJECT_DATA) + alignment - 1) / alignment) * alignment;
+	m_objectBuffer = m_pDevice->CreateBuffer(
+		RenderDevice::BUFFER_UNIFORM, m_objectStride * OBJECT_CHUNK_SIZE, NULL);
+	m_frameBuffer = m_pDevice->CreateBuffer(
+		RenderDevice::BUFFER_UNIFORM, sizeof(FRAME_DATA), NULL);
+	m_chunkData.resize(m_objectStride * OBJECT_CHUNK_SIZE);
+
+	RenderDevice::PIPELINE_DESC desc;
+	desc.vertexShaderFilename = "shaders/objectVertexShader.glsl";
+	desc.fragmentShaderFilename = "shaders/objectFragmentShader.glsl";
+	desc.bDepthTest = true;
+	desc.bDepthWrite = true;
+	desc.depthFunc = GL_LESS;
+	// the same state the scene is drawn with
+	desc.bBlend = true;
+	desc.bCullBackFaces = false;
+	m_pipelines[DRAW_SHADED] = m_pDevice->CreatePipeline(desc);
+
+	// the depth passes write no color, so no color is shaded
+	desc.fragmentShaderFilename = "shaders/depthFragmentShader.glsl";
+	m_pipelines[DRAW_DEPTH] = m_pDevice->CreatePipeline(desc);
+
+	// after a depth pass only the closest surface is shaded, and
+	// the depth is left as that pass wrote it
+	desc.fragmentShaderFilename = "shaders/objectFragmentShader.glsl";
+	desc.bDepthWrite = false;
+	desc.depthFunc = GL_EQUAL;
+	m_pipelines[DRAW_SHADED_ON_DEPTH] = m_pDevice->CreatePipeline(desc);
+
+	bool bPipelinesCreated = true;
+	for (int i = 0; i < DRAW_PASS_COUNT; i++)
+	{
+		bPipelinesCreated = bPipelinesCreated && (m_pipelines[i] != 0);
+	}
+	return((m_vertexBuffer != 0) && (m_indexBuffer != 0) && (m_objectBuffer != 0) &&
+		(m_frameBuffer != 0) && (bPipelinesCreated == true));
+}
+
+/***********************************************************
+ *  CreateObjects()
+ *
+ *  This method is used for placing the passed in number of
+ *  boxes on a grid over the scene, each at a random height
+ *  and turn and with a random color.
+ ***********************************************************/
+void ObjectManager::CreateObjects(int objectCount)
+{
+	// fixed seed so every run places the same objects
+	std::mt19937 generator(330);
+	std::uniform_real_distribution<float> height(FIELD_MIN_Y, FIELD_MAX_Y);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+	int side = std::max(1, (int)std::ceil(std::sqrt((double)objectCount)));
+	float spacingX = (FIELD_MAX_X - FIELD_MIN_X) / side;
+	float spacingZ = (FIELD_MAX_Z - FIELD_MIN_Z) / side;
+	float size = std::min(MAX_OBJECT_SIZE, std::min(spacingX, spacingZ) * 0.6f);
+
+	if (m_pEntities->GetMaxEntities() < objectCount)
+	{
+		SetObjectCapacity(objectCount);
+	}
+	else
+	{
+		m_pEntities->Clear();
+	}
+	for (int i = 0; i < objectCount; i++)
+	{
+		glm::vec3 position = glm::vec3(
+			FIELD_MIN_X + ((i % side) + 0.5f) * spacingX,
+			height(generator),
+			FIELD_MIN_Z + ((i / side) + 0.5f) * spacingZ);
+		float turn = unit(generator) * 6.2831853f;
+		glm::vec4 color = glm::vec4(unit(generator), unit(generator), unit(generator), 1.0f);
+		AddObject(position, turn, size, color);
+	}
+}
+
+/***********************************************************
+ *  SetObjectCapacity()
+ *
+ *  This method is used for removing every object and making
+ *  room for the passed in number of them.  The entity
+ *  handles are kept in one block of that size, and the
+ *  objects in chunks of their archetype.
+ ***********************************************************/
+void ObjectManager::SetObjectCapacity(int objectCapacity)
+{
+	delete m_pEntities;
+	m_pEntities = new EntityManager(objectCapacity);
+	m_pEntities->SetJobSystem(m_pJobSystem);
+}
+
+/***********************************************************
+ *  AddObject()
+ *
+ *  This method is used for placing one box of the passed in
+ *  edge length at a position, turned around the up axis.  It
+ *  returns the handle of the object, or 0 when the capacity
+ *  is used up.  Its world matrix and bounds are calculated
+ *  by the transform system when the objects are recorded.
+ ***********************************************************/
+unsigned int ObjectManager::AddObject(glm::vec3 position, float turnRadians, float size, glm::vec4 color)
+{
+	unsigned int object = m_pEntities->CreateEntity(OBJECT_COMPONENTS);
+	if (object == 0)
+	{
+		return(0);
+	}
+	m_pEntities->SetTransform(object, position, glm::vec3(0.0f, glm::degrees(turnRadians), 0.0f), glm::vec3(size));
+	m_pEntities->GetMaterial(object)->color = color;
+	return(object);
+}
+
+/***********************************************************
+ *  RemoveObject()
+ *
+ *  This method is used for removing the object of the passed
+ *  in handle.  The last object moves into its place, so the
+ *  objects stay packed.  It returns false when the handle is
+ *  stale, so the object was already removed.
+ ***********************************************************/
+bool ObjectManager::RemoveObject(unsigned int object)
+{
+	return(m_pEntities->DestroyEntity(object));
+}
+
+/***********************************************************
+ *  IsObjectValid()
+ *
+ *  This method is used for checking that the passed in
+ *  handle refers to an object that was not removed.
+ ***********************************************************/
+bool ObjectManager::IsObjectValid(unsigned int object) const
+{
+	return(m_pEntities->IsEntityValid(object));
+}
+
+/***********************************************************
+ *  SetThreadCount()
+ *
+ *  This method is used for setting the number of threads
+ *  the objects are recorded on, including the calling one,
+ *  with a sub-arena of the frame arena for each.
+ ***********************************************************/
+void ObjectManager::SetThreadCount(int threadCount)
+{
+	m_threadCount = std::max(1, threadCount);
+
+	// the lists point into the old arena, so they go first
+	m_threadPackets.clear();
+	m_threadOrders.clear();
+	m_sortedPackets = ArenaVector<SORT_ENTRY>();
+	m_mergeBuffer = ArenaVector<SORT_ENTRY>();
+	m_threadPackets.resize(m_threadCount);
+	m_threadOrders.resize(m_threadCount);
+	m_lastPacketCounts.assign(m_threadCount, 0);
+
+	if (NULL != m_pFrameArena)
+	{
+		delete m_pFrameArena;
+	}
+	m_pFrameArena = new FrameArena(FRAME_ARENA_BYTES_PER_THREAD, m_threadCount);
+}
+
+/***********************************************************
+ *  GetThreadCount()
+ *
+ *  This method is used for getting the number of threads
+ *  the objects are recorded on.
+ ***********************************************************/
+int ObjectManager::GetThreadCount() const
+{
+	return(m_threadCount);
+}
+
+/***********************************************************
+ *  SetJobSystem()
+ *
+ *  This method is used for recording the objects on the
+ *  threads of a job system, rather than on threads started
+ *  for every frame.  The objects are recorded into one list
+ *  per thread of the job system.
+ ***********************************************************/
+void ObjectManager::SetJobSystem(JobSystem* pJobSystem)
+{
+	m_pJobSystem = pJobSystem;
+	m_pEntities->SetJobSystem(m_pJobSystem);
+	if (NULL != m_pJobSystem)
+	{
+		SetThreadCount(m_pJobSystem->GetThreadCount());
+	}
+}
+
+/***********************************************************
+ *  ComparePackets()
+ *
+ *  This method is used for ordering two draw packets by
+ *  their sort keys.  The keys are sorted next to the packet
+ *  pointers, so the packets themselves are not read.
+ ***********************************************************/
+bool ObjectManager::ComparePackets(const SORT_ENTRY& first, const SORT_ENTRY& second)
+{
+	return(first.sortKey < second.sortKey);
+}
+
+/***********************************************************
+ *  RecordWorker()
+ *
+ *  This method is used for recording groups of object
+ *  chunks on one thread until the queue of chunks is empty.
+ *  The culling system runs on each chunk first, then each
+ *  visible object gets a level of detail from its distance
+ *  and a draw packet in the list of the thread, while the
+ *  chunk is still in the cache.  The key of the packet holds
+ *  the view depth above the position of the object in the
+ *  chunks, so the packets sort front to back, and always in
+ *  the same order for any number of threads.
+ ***********************************************************/
+void ObjectManager::RecordWorker(int threadIndex, std::atomic<size_t>* pNextChunk)
+{
+	ArenaVector<DRAW_PACKET>& packets = m_threadPackets[threadIndex];
+	ArenaVector<SORT_ENTRY>& order = m_threadOrders[threadIndex];
+
+	while (true)
+	{
+		size_t first = pNextChunk->fetch_add(CHUNKS_PER_JOB);
+		if (first >= m_recordChunks.size())
+		{
+			break;
+		}
+
+		size_t last = std::min(first + CHUNKS_PER_JOB, m_recordChunks.size());
+		for (size_t c = first; c < last; c++)
+		{
+			EntityManager::CHUNK& chunk = *m_recordChunks[c];
+			EntityManager::CullChunk(chunk, m_frustumPlanes);
+
+			for (int i = 0; i < chunk.count; i++)
+			{
+				if (chunk.pVisibility[i].bVisible == false)
+				{
+					continue;
+				}
+
+				float depth = chunk.pVisibility[i].depth;
+				// the bits of a positive float sort in the same order as its value
+				unsigned int depthBits = 0;
+				memcpy(&depthBits, &depth, sizeof(depthBits));
+				unsigned long long objectIndex = (unsigned long long)c * EntityManager::CHUNK_CAPACITY + i;
+
+				SORT_ENTRY entry;
+				entry.sortKey = ((unsigned long long)depthBits << 32) | objectIndex;
+				entry.pPacket = NULL;
+				order.push_back(entry);
+
+				DRAW_PACKET packet;
+				packet.data.model = chunk.pWorldMatrices[i];
+				packet.data.color = chunk.pMaterials[i].color;
+				packet.lod = (depth > chunk.pBounds[i].radius * LOD_DISTANCE_RATIO) ? 1 : 0;
+				packets.push_back(packet);
+			}
+		}
+	}
+
+	// the list is complete, so the packets no longer move
+	for (size_t i = 0; i < packets.size(); i++)
+	{
+		order[i].pPacket = &packets[i];
+	}
+	std::sort(order.begin(), order.end(), &ObjectManager::ComparePackets);
+}
+
+/***********************************************************
+ *  RecordJob()
+ *
+ *  This method is used for running the record workers of a
+ *  range of packet lists as a job of the job system.  Each
+ *  list belongs to one job, whichever thread runs it.
+ ***********************************************************/
+void ObjectManager::RecordJob(void* pOwner, size_t first, size_t count)
+{
+	ObjectManager* pManager = (ObjectManager*)pOwner;
+	for (size_t i = first; i < first + count; i++)
+	{
+		pManager->RecordWorker((int)i, &pManager->m_nextChunk);
+	}
+}
+
+/***********************************************************
+ *  ResetFrameMemory()
+ *
+ *  This method is used for giving the lists of the last
+ *  frame back to the frame arena, once they were submitted,
+ *  and starting empty lists in the sub-arena of each thread.
+ *  Each list reserves a quarter more than it held last
+ *  frame, so a steady frame grows none of them.
+ ***********************************************************/
+void ObjectManager::ResetFrameMemory()
+{
+	for (int t = 0; t < m_threadCount; t++)
+	{
+		m_lastPacketCounts[t] = m_threadPackets[t].size();
+		m_threadPackets[t] = ArenaVector<DRAW_PACKET>(ArenaAllocator<DRAW_PACKET>(m_pFrameArena, t));
+		m_threadOrders[t] = ArenaVector<SORT_ENTRY>(ArenaAllocator<SORT_ENTRY>(m_pFrameArena, t));
+	}
+	m_sortedPackets = ArenaVector<SORT_ENTRY>(ArenaAllocator<SORT_ENTRY>(m_pFrameArena, 0));
+	m_mergeBuffer = ArenaVector<SORT_ENTRY>(ArenaAllocator<SORT_ENTRY>(m_pFrameArena, 0));
+
+	m_pFrameArena->Reset();
+	for (int t = 0; t < m_threadCount; t++)
+	{
+		size_t reserveCount = m_lastPacketCounts[t] + (m_lastPacketCounts[t] / 4);
+		m_threadPackets[t].reserve(reserveCount);
+		m_threadOrders[t].reserve(reserveCount);
+	}
+}
+
+/***********************************************************
+ *  MergePackets()
+ *
+ *  This method is used for merging the sorted packet lists
+ *  of the threads into one sorted list, two neighbouring
+ *  lists at a time.
+ ***********************************************************/
+void ObjectManager::MergePackets()
+{
+	ArenaVector<size_t> runStarts(ArenaAllocator<size_t>(m_pFrameArena, 0));
+	size_t packetTotal = 0;
+	for (int t = 0; t < m_threadCount; t++)
+	{
+		packetTotal += m_threadOrders[t].size();
+	}
+	runStarts.reserve(m_threadCount + 1);
+	m_sortedPackets.reserve(packetTotal);
+	for (int t = 0; t < m_threadCount; t++)
+	{
+		runStarts.push_back(m_sortedPackets.size());
+		m_sortedPackets.insert(m_sortedPackets.end(), m_threadOrders[t].begin(), m_threadOrders[t].end());
+	}
+	runStarts.push_back(m_sortedPackets.size());
+
+	m_mergeBuffer.resize(m_sortedPackets.size());
+	while (runStarts.size() > 2)
+	{
+		ArenaVector<size_t> mergedStarts(ArenaAllocator<size_t>(m_pFrameArena, 0));
+		mergedStarts.reserve(runStarts.size());
+		for (size_t r = 0; r + 1 < runStarts.size(); r += 2)
+		{
+			size_t first = runStarts[r];
+			size_t middle = runStarts[r + 1];
+			size_t last = (r + 2 < runStarts.size()) ? runStarts[r + 2] : middle;
+			std::merge(
+				m_sortedPackets.begin() + first, m_sortedPackets.begin() + middle,
+				m_sortedPackets.begin() + middle, m_sortedPackets.begin() + last,
+				m_mergeBuffer.begin() + first, &ObjectManager::ComparePackets);
+			mergedStarts.push_back(first);
+		}
+		mergedStarts.push_back(m_sortedPackets.size());
+		m_sortedPackets.swap(m_mergeBuffer);
+		runStarts.swap(mergedStarts);
+	}
+}
+
+/***********************************************************
+ *  RecordPackets()
+ *
+ *  This method is used for recording the draw packets of
+ *  the visible objects, spread over the recording threads,
+ *  then merging the lists of the threads in front to back
+ *  order.  No thread uses the render device.
+ ***********************************************************/
+void ObjectManager::RecordPackets(const glm::mat4& viewProjection)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	// only the chunks of moved objects have their transforms calculated
+	m_pEntities->UpdateTransforms();
+	m_pEntities->FindChunks(OBJECT_COMPONENTS, 0, m_recordChunks);
+	EntityManager::ExtractFrustumPlanes(viewProjection, m_frustumPlanes);
+	ResetFrameMemory();
+
+	m_nextChunk.store(0);
+	if (NULL != m_pJobSystem)
+	{
+		JobSystem::JOB_COUNTER recorded;
+		m_pJobSystem->ParallelFor(&ObjectManager::RecordJob, this, m_threadCount, 1, &recorded);
+		m_pJobSystem->Wait(&recorded);
+	}
+	else
+	{
+		std::vector<std::thread> threads;
+		for (int i = 1; i < m_threadCount; i++)
+		{
+			threads.push_back(std::thread(&ObjectManager::RecordWorker, this, i, &m_nextChunk));
+		}
+		// the calling thread records its share too
+		RecordWorker(0, &m_nextChunk);
+		for (size_t i = 0; i < threads.size(); i++)
+		{
+			threads[i].join();
+		}
+	}
+	MergePackets();
+
+	m_lastRecordMilliseconds = std::chrono::duration<double, std::milli>(
+		std::chrono::steady_clock::now() - start).count();
+}
+
+/***********************************************************
+ *  SubmitPackets()
+ *
+ *  This method is used for drawing the recorded packets in
+ *  their sorted order, with the pipeline of the passed in
+ *  pass.  The object data is uploaded a chunk at a time,
+ *  then each packet of the chunk binds its range and draws
+ *  the mesh of its level of detail.
+ ***********************************************************/
+void ObjectManager::SubmitPackets(const glm::mat4& viewProjection, DRAW_PASS pass)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	FRAME_DATA frame;
+	frame.viewProjection = viewProjection;
+	frame.lightDirection = glm::vec4(glm::normalize(LIGHT_DIRECTION), 0.0f);
+	m_pDevice->UpdateBuffer(m_frameBuffer, 0, sizeof(FRAME_DATA), &frame);
+
+	m_pDevice->SetPipeline(m_pipelines[pass]);
+	m_pDevice->SetVertexBuffer(m_vertexBuffer);
+	m_pDevice->SetIndexBuffer(m_indexBuffer);
+	m_pDevice->SetUniformBuffer(FRAME_BINDING, m_frameBuffer, 0, sizeof(FRAME_DATA));
+
+	for (int i = 0; i < LOD_COUNT; i++)
+	{
+		m_lodDrawCounts[i] = 0;
+	}
+	int packetCount = (int)m_sortedPackets.size();
+	for (int first = 0; first < packetCount; first += OBJECT_CHUNK_SIZE)
+	{
+		int chunkCount = std::min(OBJECT_CHUNK_SIZE, packetCount - first);
+		for (int i = 0; i < chunkCount; i++)
+		{
+			memcpy(&m_chunkData[i * m_objectStride], &m_sortedPackets[first + i].pPacket->data, sizeof(OBJECT_DATA));
+		}
+		m_pDevice->UpdateBuffer(m_objectBuffer, 0, chunkCount * m_objectStride, m_chunkData.data());
+
+		for (int i = 0; i < chunkCount; i++)
+		{
+			int lod = m_sortedPackets[first + i].pPacket->lod;
+			m_pDevice->SetUniformBuffer(OBJECT_BINDING, m_objectBuffer, i * m_objectStride, sizeof(OBJECT_DATA));
+			m_pDevice->DrawIndexed(m_lodMeshes[lod].indexCount, m_lodMeshes[lod].firstIndex);
+			m_lodDrawCounts[lod]++;
+		}
+	}
+
+	m_lastSubmitMilliseconds = std::chrono::duration<double, std::milli>(
+		std::chrono::steady_clock::now() - start).count();
+}
+
+/***********************************************************
+ *  Render()
+ *
+ *  This method is used for recording the objects against
+ *  the passed in view and drawing the visible ones shaded.
+ ***********************************************************/
+void ObjectManager::Render(const glm::mat4& viewProjection)
+{
+	RecordPackets(viewProjection);
+	SubmitPackets(viewProjection, DRAW_SHADED);
+}
+
+/***********************************************************
+ *  GetObjectCount()
+ *
+ *  This method is used for getting the number of placed
+ *  objects.
+ ***********************************************************/
+int ObjectManager::GetObjectCount() const
+{
+	return(m_pEntities->GetEntityCount());
+}
+
+/***********************************************************
+ *  GetVisibleCount()
+ *
+ *  This method is used for getting the number of objects
+ *  found inside the view frustum by the last recording.
+ ***********************************************************/
+int ObjectManager::GetVisibleCount() const
+{
+	return((int)m_sortedPackets.size());
+}
+
+/***********************************************************
+ *  GetLODDrawCount()
+ *
+ *  This method is used for getting the number of objects
+ *  drawn with the passed in level of detail by the last
+ *  submission.
+ ***********************************************************/
+int ObjectManager::GetLODDrawCount(int lod) const
+{
+	return(m_lodDrawCounts[lod]);
+}
+
+/***********************************************************
+ *  GetLastRecordMilliseconds()
+ *
+ *  This method is used for getting the CPU time of the last
+ *  recording, from the traversal to the merged packets, in
+ *  milliseconds.
+ ***********************************************************/
+double ObjectManager::GetLastRecordMilliseconds() const
+{
+	return(m_lastRecordMilliseconds);
+}
+
+/***********************************************************
+ *  GetLastSubmitMilliseconds()
+ *
+ *  This method is used for getting the CPU time of the last
+ *  submission in milliseconds.
+ ***********************************************************/
+double ObjectManager::GetLastSubmitMilliseconds() const
+{
+	return(m_lastSubmitMilliseconds);
+}
+
+/***********************************************************
+ *  GetFrameArena()
+ *
+ *  This method is used for getting the frame arena that the
+ *  packets are recorded into, for reporting its size.
+ ***********************************************************/
+const FrameArena* ObjectManager::GetFrameArena() const
+{
+	return(m_pFrameArena);
+}
+
+/***********************************************************
+ *  GetEntityManager()
+ *
+ *  This method is used for getting the entity manager the
+ *  objects are stored in.
+ ***********************************************************/
+const EntityManager* ObjectManager::GetEntityManager() const
+{
+	return(m_pEntities);
+}
@@ -0,0 +1,198 @@
+///////////////////////////////////////////////////////////////////////////////
+// objectmanager.h
+// ============
+// manage a large field of simple objects drawn through the render device
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "RenderDevice.h"
+#include "JobSystem.h"
+#include "FrameArena.h"
+#include "EntityManager.h"
+
+#include <atomic>
+#include <vector>
+
+/***********************************************************
+ *  ObjectManager
+ *
+ *  This class contains the code for placing up to millions
+ *  of boxes around the scene and drawing them only through
+ *  the render device.  The boxes are entities of an entity
+ *  manager, so their components are walked in chunks.  Every
+ *  frame the objects are recorded on a number of threads:
+ *  each thread takes groups of chunks, runs the culling
+ *  system on them against the view frustum, selects
+ *  their level of detail and writes a draw packet for each
+ *  visible one into its own list, then sorts its list.  The
+ *  lists live in the sub-arena of their thread in a frame
+ *  arena, which is reset when the next frame is recorded.
+ *  The sorted lists are merged front to back, and the packets
+ *  are submitted on the calling thread, the only one that
+ *  uses the device, as one draw each with its own range of
+ *  a uniform buffer.  With the null backend the whole frame
+ *  runs without OpenGL, so the recording and submission can
+ *  be measured on their own.
+ ***********************************************************/
+class ObjectManager
+{
+public:
+	// constructor
+	ObjectManager(RenderDevice* pDevice);
+	// destructor
+	~ObjectManager();
+
+	// uniform buffer bindings of the object shaders
+	static const int OBJECT_BINDING = 0;
+	static const int FRAME_BINDING = 1;
+	// visible objects uploaded together into the object buffer
+	static const int OBJECT_CHUNK_SIZE = 1024;
+	// levels of detail, from the subdivided box to the plain box
+	static const int LOD_COUNT = 2;
+
+	// passes the objects are drawn in, each with its own pipeline
+	enum DRAW_PASS
+	{
+		// shaded, testing and writing the depth
+		DRAW_SHADED,
+		// only the depth, for a depth pass before the shading
+		DRAW_DEPTH,
+		// shaded where the depth pass left them the closest surface
+		DRAW_SHADED_ON_DEPTH,
+		DRAW_PASS_COUNT
+	};
+
+private:
+	// std140 contents of the object uniform block
+	struct OBJECT_DATA
+	{
+		glm::mat4 model;
+		glm::vec4 color;
+	};
+
+	// recorded draw of one visible object
+	struct DRAW_PACKET
+	{
+		OBJECT_DATA data;
+		int lod;
+	};
+
+	// position of a draw packet in the submission order
+	struct SORT_ENTRY
+	{
+		unsigned long long sortKey;
+		const DRAW_PACKET* pPacket;
+	};
+
+	// index range of the mesh of one level of detail
+	struct LOD_MESH
+	{
+		int firstIndex;
+		int indexCount;
+	};
+
+	// std140 contents of the frame uniform block
+	struct FRAME_DATA
+	{
+		glm::mat4 viewProjection;
+		glm::vec4 lightDirection;
+	};
+
+	// pointer to the render device the objects are drawn with
+	RenderDevice* m_pDevice;
+	// device resources of the box mesh and the shaders
+	unsigned int m_vertexBuffer;
+	unsigned int m_indexBuffer;
+	unsigned int m_objectBuffer;
+	unsigned int m_frameBuffer;
+	unsigned int m_pipelines[DRAW_PASS_COUNT];
+	LOD_MESH m_lodMeshes[LOD_COUNT];
+	// distance between the object ranges of the object buffer
+	size_t m_objectStride;
+	// placed objects, stored as entities with a transform, a world
+	// matrix, a mesh, a material, bounds and visibility
+	EntityManager* m_pEntities;
+	// chunks of the objects recorded this frame
+	std::vector<EntityManager::CHUNK*> m_recordChunks;
+	// number of threads the objects are recorded on
+	int m_threadCount;
+	// pointer to the job system the objects are recorded on, when it is used
+	JobSystem* m_pJobSystem;
+	// first chunk of the next group to record
+	std::atomic<size_t> m_nextChunk;
+	// frustum planes of the frame being recorded
+	glm::vec4 m_frustumPlanes[6];
+	// memory of the packets and their order, one sub-arena per thread
+	FrameArena* m_pFrameArena;
+	// draw packets written by each thread and their sorted order
+	std::vector<ArenaVector<DRAW_PACKET> > m_threadPackets;
+	std::vector<ArenaVector<SORT_ENTRY> > m_threadOrders;
+	// packets each thread wrote last frame, to reserve the lists
+	std::vector<size_t> m_lastPacketCounts;
+	// every packet of the frame in submission order
+	ArenaVector<SORT_ENTRY> m_sortedPackets;
+	ArenaVector<SORT_ENTRY> m_mergeBuffer;
+	// object data of one chunk before it is uploaded
+	std::vector<unsigned char> m_chunkData;
+	// submitted draws of each level of detail
+	int m_lodDrawCounts[LOD_COUNT];
+	// CPU time of the last recording and submission
+	double m_lastRecordMilliseconds;
+	double m_lastSubmitMilliseconds;
+
+	// add the vertices and indices of a box with subdivided faces
+	static void AddBoxMesh(int divisions, std::vector<RenderDevice::VERTEX>& vertices, std::vector<GLuint>& indices);
+	// order draw packets by their keys
+	static bool ComparePackets(const SORT_ENTRY& first, const SORT_ENTRY& second);
+	// record groups of object chunks on one thread until none are left
+	void RecordWorker(int threadIndex, std::atomic<size_t>* pNextChunk);
+	static void RecordJob(void* pOwner, size_t first, size_t count);
+	// give the lists of the last frame back to the frame arena
+	void ResetFrameMemory();
+	// merge the sorted lists of the threads into one
+	void MergePackets();
+
+public:
+	// create the box mesh, the buffers and the pipelines
+	bool CreateResources();
+	// place the passed in number of objects around the scene
+	void CreateObjects(int objectCount);
+	// remove every object and make room for the passed in number
+	void SetObjectCapacity(int objectCapacity);
+	// add one object and get its handle, or 0 when there is no room
+	unsigned int AddObject(glm::vec3 position, float turnRadians, float size, glm::vec4 color);
+	// remove the object of a handle, false when the handle is stale
+	bool RemoveObject(unsigned int object);
+	// check that a handle refers to a placed object
+	bool IsObjectValid(unsigned int object) const;
+
+	// set and get the number of threads the objects are recorded on
+	void SetThreadCount(int threadCount);
+	int GetThreadCount() const;
+	// record the objects on the threads of a job system
+	void SetJobSystem(JobSystem* pJobSystem);
+
+	// record a sorted draw packet for each visible object
+	void RecordPackets(const glm::mat4& viewProjection);
+	// draw the recorded packets in one of the passes
+	void SubmitPackets(const glm::mat4& viewProjection, DRAW_PASS pass);
+	// record and draw the objects shaded
+	void Render(const glm::mat4& viewProjection);
+
+	// get the placed and the visible numbers of objects
+	int GetObjectCount() const;
+	int GetVisibleCount() const;
+	// get the number of draws of a level of detail in the last submission
+	int GetLODDrawCount(int lod) const;
+	// get the CPU time of the last recording and submission
+	double GetLastRecordMilliseconds() const;
+	double GetLastSubmitMilliseconds() const;
+	// get the frame arena the packets are recorded into
+	const FrameArena* GetFrameArena() const;
+	// get the entities the objects are stored as
+	const EntityManager* GetEntityManager() const;
+};
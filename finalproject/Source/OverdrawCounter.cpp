@@ -0,0 +1,162 @@
+///////////////////////////////////////////////////////////////////////////////
+// overdrawcounter.cpp
+// ============
+// count the shaded fragments of a render pass with occlusion queries
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "OverdrawCounter.h"
+
+/***********************************************************
+ *  OverdrawCounter()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+OverdrawCounter::OverdrawCounter()
+{
+	for (int i = 0; i < QUERY_FRAMES; i++)
+	{
+		m_queries[i] = 0;
+	}
+	m_frameCount = 0;
+	m_readCount = 0;
+	m_lastSampleCount = 0;
+}
+
+/***********************************************************
+ *  ~OverdrawCounter()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+OverdrawCounter::~OverdrawCounter()
+{
+	// free the OpenGL query objects
+	DestroyQueries();
+}
+
+/***********************************************************
+ *  CreateQueries()
+ *
+ *  This method is used for creating the samples passed
+ *  query objects.
+ ***********************************************************/
+void OverdrawCounter::CreateQueries()
+{
+	glGenQueries(QUERY_FRAMES, m_queries);
+	m_frameCount = 0;
+	m_readCount = 0;
+}
+
+/***********************************************************
+ *  DestroyQueries()
+ *
+ *  This method is used for freeing the samples passed query
+ *  objects.
+ ***********************************************************/
+void OverdrawCounter::DestroyQueries()
+{
+	if (m_queries[0] != 0)
+	{
+		glDeleteQueries(QUERY_FRAMES, m_queries);
+		for (int i = 0; i < QUERY_FRAMES; i++)
+		{
+			m_queries[i] = 0;
+		}
+	}
+}
+
+/***********************************************************
+ *  ReadResults()
+ *
+ *  This method is used for reading back the fragment counts
+ *  of the finished sections, oldest first.
+ ***********************************************************/
+void OverdrawCounter::ReadResults(bool bWait)
+{
+	while (m_readCount < m_frameCount)
+	{
+		int slot = m_readCount % QUERY_FRAMES;
+		GLint bAvailable = 0;
+
+		if (bWait == false)
+		{
+			glGetQueryObjectiv(m_queries[slot], GL_QUERY_RESULT_AVAILABLE, &bAvailable);
+			if (bAvailable == 0)
+			{
+				return;
+			}
+		}
+
+		glGetQueryObjectui64v(m_queries[slot], GL_QUERY_RESULT, &m_lastSampleCount);
+		m_readCount++;
+	}
+}
+
+/***********************************************************
+ *  Begin()
+ *
+ *  This method is used for starting to count fragments.  If
+ *  every query slot is still in flight, the oldest result is
+ *  waited on before its slot is reused.
+ ***********************************************************/
+void OverdrawCounter::Begin()
+{
+	ReadResults(false);
+	if (m_frameCount - m_readCount >= QUERY_FRAMES)
+	{
+		ReadResults(true);
+	}
+
+	glBeginQuery(GL_SAMPLES_PASSED, m_queries[m_frameCount % QUERY_FRAMES]);
+}
+
+/***********************************************************
+ *  End()
+ *
+ *  This method is used for stopping the fragment count.
+ ***********************************************************/
+void OverdrawCounter::End()
+{
+	glEndQuery(GL_SAMPLES_PASSED);
+	m_frameCount++;
+}
+
+/***********************************************************
+ *  HasResult()
+ *
+ *  This method is used for checking whether a fragment count
+ *  has been read back yet.
+ ***********************************************************/
+bool OverdrawCounter::HasResult() const
+{
+	return(m_readCount > 0);
+}
+
+/***********************************************************
+ *  GetLastSampleCount()
+ *
+ *  This method is used for getting the most recent number
+ *  of fragments that passed the depth test.
+ ***********************************************************/
+GLuint64 OverdrawCounter::GetLastSampleCount() const
+{
+	return(m_lastSampleCount);
+}
+
+/***********************************************************
+ *  GetOverdraw()
+ *
+ *  This method is used for getting the average number of
+ *  times each pixel was shaded in the counted section.
+ ***********************************************************/
+double OverdrawCounter::GetOverdraw(int width, int height) const
+{
+	if ((width <= 0) || (height <= 0))
+	{
+		return(0.0);
+	}
+
+	return((double)m_lastSampleCount / ((double)width * height));
+}
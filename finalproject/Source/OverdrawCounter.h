@@ -0,0 +1,64 @@
+///////////////////////////////////////////////////////////////////////////////
+// overdrawcounter.h
+// ============
+// count the shaded fragments of a render pass with occlusion queries
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+/***********************************************************
+ *  OverdrawCounter
+ *
+ *  This class contains the code for counting the fragments
+ *  that pass the depth test during a render pass, which is
+ *  the number of fragments that get shaded.  Dividing the
+ *  count by the number of pixels gives the average overdraw.
+ *  Like GpuTimer, the queries are kept in a small ring and
+ *  read back a few frames later.
+ ***********************************************************/
+class OverdrawCounter
+{
+public:
+	// constructor
+	OverdrawCounter();
+	// destructor
+	~OverdrawCounter();
+
+	// number of frames of queries kept in flight
+	static const int QUERY_FRAMES = 4;
+
+private:
+	// samples passed queries for each frame
+	GLuint m_queries[QUERY_FRAMES];
+	// number of counted sections started so far
+	int m_frameCount;
+	// number of counted sections that have been read back
+	int m_readCount;
+	// most recent fragment count
+	GLuint64 m_lastSampleCount;
+
+	// read back every finished query that is available
+	void ReadResults(bool bWait);
+
+public:
+	// create the OpenGL query objects
+	void CreateQueries();
+	// free the OpenGL query objects
+	void DestroyQueries();
+
+	// mark the start and the end of the counted section
+	void Begin();
+	void End();
+
+	// check whether any fragment count has been read back yet
+	bool HasResult() const;
+	// get the most recent fragment count
+	GLuint64 GetLastSampleCount() const;
+	// get the most recent fragment count divided by the pixel count
+	double GetOverdraw(int width, int height) const;
+};
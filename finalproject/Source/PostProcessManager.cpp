@@ -0,0 +1,704 @@
+///////////////////////////////////////////////////////////////////////////////
+// postprocessmanager.cpp
+// ============
+// manage the post-process anti-aliasing - FXAA, SMAA, TAA and supersampling
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "PostProcessManager.h"
+
+#include <algorithm>
+#include <cmath>
+
+// declare the global variables
+namespace
+{
+	const char* g_SceneTextureName = "sceneTexture";
+	const char* g_DepthTextureName = "depthTexture";
+	const char* g_EdgesTextureName = "edgesTexture";
+	const char* g_WeightsTextureName = "weightsTexture";
+	const char* g_HistoryTextureName = "historyTexture";
+	const std::string g_InverseViewProjectionName = "inverseViewProjection";
+	const std::string g_PreviousViewProjectionName = "previousViewProjection";
+
+	// number of jitter positions the TAA cycles through
+	const int JITTER_SAMPLES = 8;
+	// PSNR reported for identical captures
+	const double MAX_PSNR = 100.0;
+
+	/***********************************************************
+	 *  Halton()
+	 *
+	 *  This function is used for getting the passed in element
+	 *  of the Halton sequence with the passed in base, which
+	 *  spreads the jitter evenly over the pixel.
+	 ***********************************************************/
+	float Halton(int index, int base)
+	{
+		float fraction = 1.0f;
+		float result = 0.0f;
+		while (index > 0)
+		{
+			fraction /= (float)base;
+			result += fraction * (float)(index % base);
+			index /= base;
+		}
+		return(result);
+	}
+
+	/***********************************************************
+	 *  CreateColorTarget()
+	 *
+	 *  This function is used for creating a texture and a
+	 *  framebuffer that draws into it.
+	 ***********************************************************/
+	GLenum CreateColorTarget(
+		GLenum format,
+		GLenum filter,
+		int width,
+		int height,
+		GLuint& texture,
+		GLuint& framebuffer)
+	{
+		glGenTextures(1, &texture);
+		glBindTexture(GL_TEXTURE_2D, texture);
+		glTexStorage2D(GL_TEXTURE_2D, 1, format, width, height);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+		glGenFramebuffers(1, &framebuffer);
+		glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+		GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		return(status);
+	}
+}
+
+/***********************************************************
+ *  PostProcessManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+PostProcessManager::PostProcessManager()
+{
+	m_sceneFramebuffer = 0;
+	m_sceneColorTexture = 0;
+	m_sceneDepthTexture = 0;
+	m_edgesFramebuffer = 0;
+	m_edgesTexture = 0;
+	m_weightsFramebuffer = 0;
+	m_weightsTexture = 0;
+	m_historyFramebuffers[0] = 0;
+	m_historyFramebuffers[1] = 0;
+	m_historyTextures[0] = 0;
+	m_historyTextures[1] = 0;
+	m_historyIndex = 0;
+	m_bHistoryValid = false;
+	m_supersampleFramebuffer = 0;
+	m_supersampleColorTexture = 0;
+	m_supersampleDepthRenderbuffer = 0;
+	m_width = 0;
+	m_height = 0;
+	m_pFxaaShader = NULL;
+	m_pEdgesShader = NULL;
+	m_pWeightsShader = NULL;
+	m_pBlendShader = NULL;
+	m_pResolveShader = NULL;
+	m_pDownsampleShader = NULL;
+	m_fullscreenVAO = 0;
+	m_mode = AA_NONE;
+	m_frameIndex = 0;
+	for (int i = 0; i < PASS_COUNT; i++)
+	{
+		m_pPassTimers[i] = NULL;
+	}
+}
+
+/***********************************************************
+ *  ~PostProcessManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+PostProcessManager::~PostProcessManager()
+{
+	DestroyTargets();
+	SetPassTiming(false);
+
+	ShaderManager** shaders[6] = {
+		&m_pFxaaShader, &m_pEdgesShader, &m_pWeightsShader,
+		&m_pBlendShader, &m_pResolveShader, &m_pDownsampleShader };
+	for (int i = 0; i < 6; i++)
+	{
+		if (NULL != *shaders[i])
+		{
+			delete *shaders[i];
+			*shaders[i] = NULL;
+		}
+	}
+}
+
+/***********************************************************
+ *  CreateTargets()
+ *
+ *  This method is used for creating the offscreen target of
+ *  the scene and the targets of the SMAA and TAA passes.
+ *  The scene color is filtered so that FXAA can read it
+ *  between pixels.
+ ***********************************************************/
+bool PostProcessManager::CreateTargets(int width, int height)
+{
+	m_width = width;
+	m_height = height;
+
+	// the textures are created on the first of the units they
+	// are read from, so the scene textures stay bound
+	glActiveTexture(GL_TEXTURE0 + SCENE_TEXTURE_UNIT);
+
+	GLenum statuses[5];
+	statuses[0] = CreateColorTarget(GL_RGBA16F, GL_LINEAR, width, height, m_sceneColorTexture, m_sceneFramebuffer);
+	statuses[1] = CreateColorTarget(GL_RG8, GL_NEAREST, width, height, m_edgesTexture, m_edgesFramebuffer);
+	statuses[2] = CreateColorTarget(GL_RGBA8, GL_NEAREST, width, height, m_weightsTexture, m_weightsFramebuffer);
+	statuses[3] = CreateColorTarget(GL_RGBA16F, GL_LINEAR, width, height, m_historyTextures[0], m_historyFramebuffers[0]);
+	statuses[4] = CreateColorTarget(GL_RGBA16F, GL_LINEAR, width, height, m_historyTextures[1], m_historyFramebuffers[1]);
+
+	// the depth is a texture so the TAA can reproject each pixel
+	glGenTextures(1, &m_sceneDepthTexture);
+	glBindTexture(GL_TEXTURE_2D, m_sceneDepthTexture);
+	glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH_COMPONENT24, width, height);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glActiveTexture(GL_TEXTURE0);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, m_sceneFramebuffer);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_sceneDepthTexture, 0);
+	statuses[0] = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	for (int i = 0; i < 5; i++)
+	{
+		if (statuses[i] != GL_FRAMEBUFFER_COMPLETE)
+		{
+			std::cout << "Post-process framebuffer " << i << " is not complete, status:" << statuses[i] << std::endl;
+			return false;
+		}
+	}
+
+	// core profile needs a vertex array bound even when no
+	// vertex attributes are read
+	glGenVertexArrays(1, &m_fullscreenVAO);
+
+	return true;
+}
+
+/***********************************************************
+ *  DestroyTargets()
+ *
+ *  This method is used for freeing the offscreen targets.
+ ***********************************************************/
+void PostProcessManager::DestroyTargets()
+{
+	DestroySupersampleTarget();
+
+	GLuint framebuffers[5] = {
+		m_sceneFramebuffer, m_edgesFramebuffer, m_weightsFramebuffer,
+		m_historyFramebuffers[0], m_historyFramebuffers[1] };
+	GLuint textures[6] = {
+		m_sceneColorTexture, m_sceneDepthTexture, m_edgesTexture,
+		m_weightsTexture, m_historyTextures[0], m_historyTextures[1] };
+	if (m_sceneFramebuffer != 0)
+	{
+		glDeleteFramebuffers(5, framebuffers);
+		glDeleteTextures(6, textures);
+	}
+	m_sceneFramebuffer = 0;
+	m_sceneColorTexture = 0;
+	m_sceneDepthTexture = 0;
+	m_edgesFramebuffer = 0;
+	m_edgesTexture = 0;
+	m_weightsFramebuffer = 0;
+	m_weightsTexture = 0;
+	m_historyFramebuffers[0] = 0;
+	m_historyFramebuffers[1] = 0;
+	m_historyTextures[0] = 0;
+	m_historyTextures[1] = 0;
+	m_bHistoryValid = false;
+
+	if (m_fullscreenVAO != 0)
+	{
+		glDeleteVertexArrays(1, &m_fullscreenVAO);
+		m_fullscreenVAO = 0;
+	}
+}
+
+/***********************************************************
+ *  CreateSupersampleTarget()
+ *
+ *  This method is used for creating the supersampled target,
+ *  which is large enough that it is only kept while the
+ *  supersampled mode is selected.
+ ***********************************************************/
+void PostProcessManager::CreateSupersampleTarget()
+{
+	if (m_supersampleFramebuffer != 0)
+	{
+		return;
+	}
+
+	int width = m_width * SUPERSAMPLE_FACTOR;
+	int height = m_height * SUPERSAMPLE_FACTOR;
+
+	glActiveTexture(GL_TEXTURE0 + SCENE_TEXTURE_UNIT);
+	CreateColorTarget(GL_RGBA16F, GL_NEAREST, width, height, m_supersampleColorTexture, m_supersampleFramebuffer);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glActiveTexture(GL_TEXTURE0);
+
+	glGenRenderbuffers(1, &m_supersampleDepthRenderbuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_supersampleDepthRenderbuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, m_supersampleFramebuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_supersampleDepthRenderbuffer);
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cout << "Supersampled framebuffer is not complete, status:" << status << std::endl;
+	}
+}
+
+/***********************************************************
+ *  DestroySupersampleTarget()
+ *
+ *  This method is used for freeing the supersampled target.
+ ***********************************************************/
+void PostProcessManager::DestroySupersampleTarget()
+{
+	if (m_supersampleFramebuffer != 0)
+	{
+		glDeleteFramebuffers(1, &m_supersampleFramebuffer);
+		m_supersampleFramebuffer = 0;
+	}
+	if (m_supersampleColorTexture != 0)
+	{
+		glDeleteTextures(1, &m_supersampleColorTexture);
+		m_supersampleColorTexture = 0;
+	}
+	if (m_supersampleDepthRenderbuffer != 0)
+	{
+		glDeleteRenderbuffers(1, &m_supersampleDepthRenderbuffer);
+		m_supersampleDepthRenderbuffer = 0;
+	}
+}
+
+/***********************************************************
+ *  LoadShaders()
+ *
+ *  This method is used for loading the shaders of the
+ *  post-process passes, which all draw a full screen
+ *  triangle.
+ ***********************************************************/
+void PostProcessManager::LoadShaders()
+{
+	m_pFxaaShader = new ShaderManager();
+	m_pFxaaShader->LoadShaders(
+		"shaders/fullscreenVertexShader.glsl",
+		"shaders/fxaaFragmentShader.glsl");
+	m_pFxaaShader->use();
+	m_pFxaaShader->setSampler2DValue(g_SceneTextureName, SCENE_TEXTURE_UNIT);
+
+	m_pEdgesShader = new ShaderManager();
+	m_pEdgesShader->LoadShaders(
+		"shaders/fullscreenVertexShader.glsl",
+		"shaders/smaaEdgeFragmentShader.glsl");
+	m_pEdgesShader->use();
+	m_pEdgesShader->setSampler2DValue(g_SceneTextureName, SCENE_TEXTURE_UNIT);
+
+	m_pWeightsShader = new ShaderManager();
+	m_pWeightsShader->LoadShaders(
+		"shaders/fullscreenVertexShader.glsl",
+		"shaders/smaaWeightFragmentShader.glsl");
+	m_pWeightsShader->use();
+	m_pWeightsShader->setSampler2DValue(g_EdgesTextureName, EDGES_TEXTURE_UNIT);
+
+	m_pBlendShader = new ShaderManager();
+	m_pBlendShader->LoadShaders(
+		"shaders/fullscreenVertexShader.glsl",
+		"shaders/smaaBlendFragmentShader.glsl");
+	m_pBlendShader->use();
+	m_pBlendShader->setSampler2DValue(g_SceneTextureName, SCENE_TEXTURE_UNIT);
+	m_pBlendShader->setSampler2DValue(g_WeightsTextureName, WEIGHTS_TEXTURE_UNIT);
+
+	m_pResolveShader = new ShaderManager();
+	m_pResolveShader->LoadShaders(
+		"shaders/fullscreenVertexShader.glsl",
+		"shaders/taaResolveFragmentShader.glsl");
+	m_pResolveShader->use();
+	m_pResolveShader->setSampler2DValue(g_SceneTextureName, SCENE_TEXTURE_UNIT);
+	m_pResolveShader->setSampler2DValue(g_DepthTextureName, DEPTH_TEXTURE_UNIT);
+	m_pResolveShader->setSampler2DValue(g_HistoryTextureName, HISTORY_TEXTURE_UNIT);
+
+	m_pDownsampleShader = new ShaderManager();
+	m_pDownsampleShader->LoadShaders(
+		"shaders/fullscreenVertexShader.glsl",
+		"shaders/downsampleFragmentShader.glsl");
+	m_pDownsampleShader->use();
+	m_pDownsampleShader->setSampler2DValue(g_SceneTextureName, SCENE_TEXTURE_UNIT);
+	m_pDownsampleShader->setIntValue("sampleFactor", SUPERSAMPLE_FACTOR);
+}
+
+/***********************************************************
+ *  SetMode()
+ *
+ *  This method is used for selecting the anti-aliasing
+ *  applied to the scene.  The TAA history starts over and
+ *  the pass timers are cleared, so that no result of the
+ *  previous mode is carried over.
+ ***********************************************************/
+void PostProcessManager::SetMode(AA_MODE mode)
+{
+	m_mode = mode;
+	m_bHistoryValid = false;
+
+	if (mode == AA_SUPERSAMPLED)
+	{
+		CreateSupersampleTarget();
+	}
+	else
+	{
+		DestroySupersampleTarget();
+	}
+
+	if (NULL != m_pPassTimers[0])
+	{
+		SetPassTiming(false);
+		SetPassTiming(true);
+	}
+}
+
+/***********************************************************
+ *  GetMode()
+ *
+ *  This method is used for getting the selected
+ *  anti-aliasing.
+ ***********************************************************/
+PostProcessManager::AA_MODE PostProcessManager::GetMode() const
+{
+	return(m_mode);
+}
+
+/***********************************************************
+ *  SetPassTiming()
+ *
+ *  This method is used for creating or freeing the GPU
+ *  timers of the passes.
+ ***********************************************************/
+void PostProcessManager::SetPassTiming(bool bEnabled)
+{
+	for (int i = 0; i < PASS_COUNT; i++)
+	{
+		if ((bEnabled == true) && (NULL == m_pPassTimers[i]))
+		{
+			m_pPassTimers[i] = new GpuTimer();
+			m_pPassTimers[i]->CreateQueries();
+		}
+		else if ((bEnabled == false) && (NULL != m_pPassTimers[i]))
+		{
+			delete m_pPassTimers[i];
+			m_pPassTimers[i] = NULL;
+		}
+	}
+}
+
+/***********************************************************
+ *  GetPassMilliseconds()
+ *
+ *  This method is used for getting the most recent GPU time
+ *  of a pass in milliseconds, or a negative time when the
+ *  pass has not been timed in the current mode.
+ ***********************************************************/
+double PostProcessManager::GetPassMilliseconds(POST_PASS pass) const
+{
+	if ((NULL == m_pPassTimers[pass]) || (m_pPassTimers[pass]->HasResult() == false))
+	{
+		return(-1.0);
+	}
+	return(m_pPassTimers[pass]->GetLastMilliseconds());
+}
+
+/***********************************************************
+ *  GetModeName()
+ *
+ *  This method is used for getting the display name of an
+ *  anti-aliasing mode.
+ ***********************************************************/
+const char* PostProcessManager::GetModeName(AA_MODE mode)
+{
+	const char* names[] = { "no AA", "FXAA", "SMAA", "TAA", "4x4 supersampled" };
+	return(names[mode]);
+}
+
+/***********************************************************
+ *  GetPassName()
+ *
+ *  This method is used for getting the display name of a
+ *  post-process pass.
+ ***********************************************************/
+const char* PostProcessManager::GetPassName(POST_PASS pass)
+{
+	const char* names[] = {
+		"copy", "FXAA", "SMAA edges", "SMAA weights",
+		"SMAA blend", "TAA resolve", "downsample" };
+	return(names[pass]);
+}
+
+/***********************************************************
+ *  BeginFrame()
+ *
+ *  This method is used for advancing the jitter to the next
+ *  frame.
+ ***********************************************************/
+void PostProcessManager::BeginFrame()
+{
+	m_frameIndex++;
+}
+
+/***********************************************************
+ *  GetJitter()
+ *
+ *  This method is used for getting the offset in pixels that
+ *  the projection is moved by in the current frame.  Only
+ *  the TAA jitters the projection, through the Halton 2, 3
+ *  sequence within one pixel.
+ ***********************************************************/
+glm::vec2 PostProcessManager::GetJitter() const
+{
+	if (m_mode != AA_TAA)
+	{
+		return(glm::vec2(0.0f));
+	}
+
+	int sample = (m_frameIndex % JITTER_SAMPLES) + 1;
+	return(glm::vec2(Halton(sample, 2) - 0.5f, Halton(sample, 3) - 0.5f));
+}
+
+/***********************************************************
+ *  BeginScene()
+ *
+ *  This method is used for drawing the scene into the
+ *  offscreen target, or into the supersampled target.
+ ***********************************************************/
+void PostProcessManager::BeginScene()
+{
+	if (m_mode == AA_SUPERSAMPLED)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, m_supersampleFramebuffer);
+	}
+	else
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, m_sceneFramebuffer);
+	}
+	glViewport(0, 0, GetSceneWidth(), GetSceneHeight());
+}
+
+/***********************************************************
+ *  GetSceneWidth()
+ *
+ *  This method is used for getting the width in pixels of
+ *  the target the scene is drawn into.
+ ***********************************************************/
+int PostProcessManager::GetSceneWidth() const
+{
+	return((m_mode == AA_SUPERSAMPLED) ? m_width * SUPERSAMPLE_FACTOR : m_width);
+}
+
+/***********************************************************
+ *  GetSceneHeight()
+ *
+ *  This method is used for getting the height in pixels of
+ *  the target the scene is drawn into.
+ ***********************************************************/
+int PostProcessManager::GetSceneHeight() const
+{
+	return((m_mode == AA_SUPERSAMPLED) ? m_height * SUPERSAMPLE_FACTOR : m_height);
+}
+
+/***********************************************************
+ *  DrawPass()
+ *
+ *  This method is used for drawing the full screen triangle
+ *  with the current shader, timed as the passed in pass.
+ ***********************************************************/
+void PostProcessManager::DrawPass(POST_PASS pass)
+{
+	if (NULL != m_pPassTimers[pass])
+	{
+		m_pPassTimers[pass]->Begin();
+	}
+	glBindVertexArray(m_fullscreenVAO);
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+	glBindVertexArray(0);
+	if (NULL != m_pPassTimers[pass])
+	{
+		m_pPassTimers[pass]->End();
+	}
+}
+
+/***********************************************************
+ *  EndScene()
+ *
+ *  This method is used for applying the selected
+ *  anti-aliasing to the scene and drawing it into the
+ *  window.  The TAA reprojects each pixel with the view
+ *  projection matrices of this and the previous frame, both
+ *  without the jitter.
+ ***********************************************************/
+void PostProcessManager::EndScene(
+	const glm::mat4& viewProjection,
+	const glm::mat4& previousViewProjection)
+{
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_BLEND);
+	glViewport(0, 0, m_width, m_height);
+
+	glActiveTexture(GL_TEXTURE0 + SCENE_TEXTURE_UNIT);
+	glBindTexture(GL_TEXTURE_2D, (m_mode == AA_SUPERSAMPLED) ? m_supersampleColorTexture : m_sceneColorTexture);
+
+	if (m_mode == AA_NONE)
+	{
+		if (NULL != m_pPassTimers[PASS_COPY])
+		{
+			m_pPassTimers[PASS_COPY]->Begin();
+		}
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, m_sceneFramebuffer);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+		glBlitFramebuffer(0, 0, m_width, m_height, 0, 0, m_width, m_height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+		if (NULL != m_pPassTimers[PASS_COPY])
+		{
+			m_pPassTimers[PASS_COPY]->End();
+		}
+	}
+	else if (m_mode == AA_FXAA)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		m_pFxaaShader->use();
+		m_pFxaaShader->setVec2Value("texelSize", glm::vec2(1.0f / m_width, 1.0f / m_height));
+		DrawPass(PASS_FXAA);
+	}
+	else if (m_mode == AA_SMAA)
+	{
+		// only the pixels on an edge are written by the first two passes
+		glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+		glBindFramebuffer(GL_FRAMEBUFFER, m_edgesFramebuffer);
+		glClear(GL_COLOR_BUFFER_BIT);
+		m_pEdgesShader->use();
+		DrawPass(PASS_SMAA_EDGES);
+
+		glBindFramebuffer(GL_FRAMEBUFFER, m_weightsFramebuffer);
+		glClear(GL_COLOR_BUFFER_BIT);
+		glActiveTexture(GL_TEXTURE0 + EDGES_TEXTURE_UNIT);
+		glBindTexture(GL_TEXTURE_2D, m_edgesTexture);
+		m_pWeightsShader->use();
+		DrawPass(PASS_SMAA_WEIGHTS);
+
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glActiveTexture(GL_TEXTURE0 + WEIGHTS_TEXTURE_UNIT);
+		glBindTexture(GL_TEXTURE_2D, m_weightsTexture);
+		m_pBlendShader->use();
+		DrawPass(PASS_SMAA_BLEND);
+	}
+	else if (m_mode == AA_TAA)
+	{
+		int writeIndex = 1 - m_historyIndex;
+
+		glBindFramebuffer(GL_FRAMEBUFFER, m_historyFramebuffers[writeIndex]);
+		glActiveTexture(GL_TEXTURE0 + DEPTH_TEXTURE_UNIT);
+		glBindTexture(GL_TEXTURE_2D, m_sceneDepthTexture);
+		glActiveTexture(GL_TEXTURE0 + HISTORY_TEXTURE_UNIT);
+		glBindTexture(GL_TEXTURE_2D, m_historyTextures[m_historyIndex]);
+		m_pResolveShader->use();
+		m_pResolveShader->setMat4Value(g_InverseViewProjectionName, glm::inverse(viewProjection));
+		m_pResolveShader->setMat4Value(g_PreviousViewProjectionName, previousViewProjection);
+		m_pResolveShader->setBoolValue("bHistoryValid", m_bHistoryValid);
+		DrawPass(PASS_TAA_RESOLVE);
+
+		// the resolved frame is the history of the next one
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, m_historyFramebuffers[writeIndex]);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+		glBlitFramebuffer(0, 0, m_width, m_height, 0, 0, m_width, m_height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+		m_historyIndex = writeIndex;
+		m_bHistoryValid = true;
+	}
+	else
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		m_pDownsampleShader->use();
+		DrawPass(PASS_DOWNSAMPLE);
+	}
+	glActiveTexture(GL_TEXTURE0);
+
+	// restore the state the scene rendering expects
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glEnable(GL_BLEND);
+	glEnable(GL_DEPTH_TEST);
+}
+
+/***********************************************************
+ *  CaptureWindow()
+ *
+ *  This method is used for reading the RGB pixels of the
+ *  window, bottom row first.
+ ***********************************************************/
+void PostProcessManager::CaptureWindow(std::vector<unsigned char>& pixels) const
+{
+	pixels.resize(m_width * m_height * 3);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, m_width, m_height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+}
+
+/***********************************************************
+ *  CompareCaptures()
+ *
+ *  This method is used for comparing two captures of the
+ *  window.  The peak signal to noise ratio in decibels
+ *  rises as the image gets closer to the reference, and the
+ *  mean error is the average difference of each channel in
+ *  the 0 to 1 range.
+ ***********************************************************/
+void PostProcessManager::CompareCaptures(
+	const std::vector<unsigned char>& image,
+	const std::vector<unsigned char>& reference,
+	double& psnr,
+	double& meanError)
+{
+	double squaredTotal = 0.0;
+	double absoluteTotal = 0.0;
+	size_t count = std::min(image.size(), reference.size());
+
+	for (size_t i = 0; i < count; i++)
+	{
+		double difference = (double)image[i] - (double)reference[i];
+		squaredTotal += difference * difference;
+		absoluteTotal += std::fabs(difference);
+	}
+
+	if (count == 0)
+	{
+		psnr = 0.0;
+		meanError = 0.0;
+		return;
+	}
+
+	double meanSquared = squaredTotal / count;
+	psnr = (meanSquared > 0.0) ? 10.0 * std::log10((255.0 * 255.0) / meanSquared) : MAX_PSNR;
+	meanError = absoluteTotal / (count * 255.0);
+}
@@ -0,0 +1,169 @@
+///////////////////////////////////////////////////////////////////////////////
+// postprocessmanager.h
+// ============
+// manage the post-process anti-aliasing - FXAA, SMAA, TAA and supersampling
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+#include "GpuTimer.h"
+
+#include <vector>
+
+/***********************************************************
+ *  PostProcessManager
+ *
+ *  This class contains the code for smoothing the edges of
+ *  the scene after it is drawn, instead of multisampling the
+ *  window.  The scene is drawn into an offscreen RGBA16F
+ *  target with a depth texture, and one of these chains
+ *  copies it into the window:
+ *
+ *    none          copied as it is
+ *    FXAA          one pass that blends across the luma edges
+ *    SMAA          edge detection, blend weights from the
+ *                  shape of each edge, neighborhood blending
+ *    TAA           the projection is jittered every frame and
+ *                  each pixel is blended with its reprojected
+ *                  history, clamped to its current neighbors
+ *    supersampled  drawn at 4x the width and height and box
+ *                  filtered, the reference for the others
+ *
+ *  Each pass can be timed, and the window can be captured
+ *  and compared with another capture.
+ ***********************************************************/
+class PostProcessManager
+{
+public:
+	// constructor
+	PostProcessManager();
+	// destructor
+	~PostProcessManager();
+
+	// texture units used for reading the post-process targets
+	static const int SCENE_TEXTURE_UNIT = 31;
+	static const int DEPTH_TEXTURE_UNIT = 32;
+	static const int EDGES_TEXTURE_UNIT = 33;
+	static const int WEIGHTS_TEXTURE_UNIT = 34;
+	static const int HISTORY_TEXTURE_UNIT = 35;
+
+	// width and height multiple of the supersampled target
+	static const int SUPERSAMPLE_FACTOR = 4;
+
+	// anti-aliasing applied to the scene
+	enum AA_MODE
+	{
+		AA_NONE,
+		AA_FXAA,
+		AA_SMAA,
+		AA_TAA,
+		AA_SUPERSAMPLED
+	};
+
+	// passes that can be timed
+	enum POST_PASS
+	{
+		PASS_COPY,
+		PASS_FXAA,
+		PASS_SMAA_EDGES,
+		PASS_SMAA_WEIGHTS,
+		PASS_SMAA_BLEND,
+		PASS_TAA_RESOLVE,
+		PASS_DOWNSAMPLE,
+		PASS_COUNT
+	};
+
+private:
+	// offscreen target that the scene is drawn into
+	GLuint m_sceneFramebuffer;
+	GLuint m_sceneColorTexture;
+	GLuint m_sceneDepthTexture;
+	// SMAA edges and blend weights
+	GLuint m_edgesFramebuffer;
+	GLuint m_edgesTexture;
+	GLuint m_weightsFramebuffer;
+	GLuint m_weightsTexture;
+	// TAA history, read from one while the other is written
+	GLuint m_historyFramebuffers[2];
+	GLuint m_historyTextures[2];
+	int m_historyIndex;
+	bool m_bHistoryValid;
+	// supersampled target, only created while it is used
+	GLuint m_supersampleFramebuffer;
+	GLuint m_supersampleColorTexture;
+	GLuint m_supersampleDepthRenderbuffer;
+	int m_width;
+	int m_height;
+	// shaders of the passes
+	ShaderManager* m_pFxaaShader;
+	ShaderManager* m_pEdgesShader;
+	ShaderManager* m_pWeightsShader;
+	ShaderManager* m_pBlendShader;
+	ShaderManager* m_pResolveShader;
+	ShaderManager* m_pDownsampleShader;
+	// empty vertex array used for the full screen triangle
+	GLuint m_fullscreenVAO;
+	// selected anti-aliasing and the frame count of the jitter
+	AA_MODE m_mode;
+	int m_frameIndex;
+	// timers of the passes, only created when timing is enabled
+	GpuTimer* m_pPassTimers[PASS_COUNT];
+
+	// create and free the supersampled target
+	void CreateSupersampleTarget();
+	void DestroySupersampleTarget();
+	// draw the full screen triangle, timed as the passed in pass
+	void DrawPass(POST_PASS pass);
+
+public:
+	// create the offscreen targets
+	bool CreateTargets(int width, int height);
+	// free the offscreen targets
+	void DestroyTargets();
+	// load the shaders of the passes
+	void LoadShaders();
+
+	// select the anti-aliasing applied to the scene
+	void SetMode(AA_MODE mode);
+	AA_MODE GetMode() const;
+	// enable the timing of each pass
+	void SetPassTiming(bool bEnabled);
+	// get the most recent GPU time of a pass in milliseconds
+	double GetPassMilliseconds(POST_PASS pass) const;
+	// get the display name of an anti-aliasing mode or a pass
+	static const char* GetModeName(AA_MODE mode);
+	static const char* GetPassName(POST_PASS pass);
+
+	// advance the jitter to the next frame
+	void BeginFrame();
+	// get the projection offset in pixels for the current frame
+	glm::vec2 GetJitter() const;
+
+	// draw the scene into the offscreen target
+	void BeginScene();
+	// get the size of the target the scene is drawn into
+	int GetSceneWidth() const;
+	int GetSceneHeight() const;
+	// get the window sized scene target, for the render graph passes
+	// that read and darken it
+	GLuint GetSceneFramebuffer() const { return m_sceneFramebuffer; }
+	GLuint GetSceneColorTexture() const { return m_sceneColorTexture; }
+	GLuint GetSceneDepthTexture() const { return m_sceneDepthTexture; }
+	// apply the anti-aliasing and copy the scene into the window
+	void EndScene(
+		const glm::mat4& viewProjection,
+		const glm::mat4& previousViewProjection);
+
+	// read the RGB pixels of the window
+	void CaptureWindow(std::vector<unsigned char>& pixels) const;
+	// compare two captures by peak signal to noise ratio and mean error
+	static void CompareCaptures(
+		const std::vector<unsigned char>& image,
+		const std::vector<unsigned char>& reference,
+		double& psnr,
+		double& meanError);
+};
@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////////////////////////
+// prepassmanager.cpp
+// ============
+// manage the depth pre-pass - depth only draw, then shade with equal depth
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "PrePassManager.h"
+
+/***********************************************************
+ *  PrePassManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+PrePassManager::PrePassManager()
+{
+	m_pDepthShader = NULL;
+}
+
+/***********************************************************
+ *  ~PrePassManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+PrePassManager::~PrePassManager()
+{
+	if (NULL != m_pDepthShader)
+	{
+		delete m_pDepthShader;
+		m_pDepthShader = NULL;
+	}
+}
+
+/***********************************************************
+ *  LoadShaders()
+ *
+ *  This method is used for loading the position only depth
+ *  shader.  Its vertex shader marks gl_Position invariant,
+ *  the same as the scene vertex shader, so both passes get
+ *  exactly the same depth values.
+ ***********************************************************/
+void PrePassManager::LoadShaders()
+{
+	m_pDepthShader = new ShaderManager();
+	m_pDepthShader->LoadShaders(
+		"shaders/depthVertexShader.glsl",
+		"shaders/depthFragmentShader.glsl");
+}
+
+/***********************************************************
+ *  GetDepthShader()
+ *
+ *  This method is used for getting the shader that the scene
+ *  is drawn with during the depth pre-pass.
+ ***********************************************************/
+ShaderManager* PrePassManager::GetDepthShader()
+{
+	return(m_pDepthShader);
+}
+
+/***********************************************************
+ *  BeginDepthPass()
+ *
+ *  This method is used for turning off the color writes so
+ *  that the scene only fills the depth buffer.
+ ***********************************************************/
+void PrePassManager::BeginDepthPass()
+{
+	glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+	glEnable(GL_DEPTH_TEST);
+	glDepthFunc(GL_LESS);
+	glDepthMask(GL_TRUE);
+
+	m_pDepthShader->use();
+}
+
+/***********************************************************
+ *  BeginShadingPass()
+ *
+ *  This method is used for turning the color writes back on
+ *  and only passing the fragments that match the depth that
+ *  the pre-pass kept.
+ ***********************************************************/
+void PrePassManager::BeginShadingPass()
+{
+	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+	glDepthFunc(GL_EQUAL);
+	glDepthMask(GL_FALSE);
+}
+
+/***********************************************************
+ *  EndShadingPass()
+ *
+ *  This method is used for going back to the normal depth
+ *  test, so the depth buffer can be cleared next frame.
+ ***********************************************************/
+void PrePassManager::EndShadingPass()
+{
+	glDepthFunc(GL_LESS);
+	glDepthMask(GL_TRUE);
+}
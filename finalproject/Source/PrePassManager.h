@@ -0,0 +1,48 @@
+///////////////////////////////////////////////////////////////////////////////
+// prepassmanager.h
+// ============
+// manage the depth pre-pass - depth only draw, then shade with equal depth
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+
+/***********************************************************
+ *  PrePassManager
+ *
+ *  This class contains the code for drawing the scene in two
+ *  passes to remove shading overdraw.  The first pass writes
+ *  only the depth buffer with a position only shader, then
+ *  the shading pass tests with GL_EQUAL and leaves the depth
+ *  buffer alone, so only the closest surface of each pixel
+ *  runs the lighting shader.
+ ***********************************************************/
+class PrePassManager
+{
+public:
+	// constructor
+	PrePassManager();
+	// destructor
+	~PrePassManager();
+
+private:
+	// shader used for the depth pre-pass
+	ShaderManager* m_pDepthShader;
+
+public:
+	// load the position only depth shader
+	void LoadShaders();
+	// get the shader that the scene is drawn with in the depth pre-pass
+	ShaderManager* GetDepthShader();
+
+	// set up the state for writing only the depth buffer
+	void BeginDepthPass();
+	// set up the state for shading the surfaces the pre-pass kept
+	void BeginShadingPass();
+	// go back to the normal depth test state
+	void EndShadingPass();
+};
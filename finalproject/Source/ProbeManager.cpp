@@ -0,0 +1,532 @@
+///////////////////////////////////////////////////////////////////////////////
+// probemanager.cpp
+// ============
+// manage the irradiance probe grid - spherical harmonics baking and sampling
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ProbeManager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+// declare the global variables
+namespace
+{
+	const char* g_UseProbesName = "bUseProbes";
+	const char* g_ProbeGridName = "probeGrid";
+	const std::string g_ProbeGridSpacingName = "probeGridSpacing";
+
+	// distance between neighbouring probes
+	const float PROBE_SPACING = 2.0f;
+	// probes closer than this to an object that changed are baked again
+	const float PROBE_UPDATE_DISTANCE = 6.0f;
+	// number of probes a thread takes from the queue at a time
+	const size_t PROBES_PER_JOB = 4;
+	const float PI = 3.14159265f;
+	// angle between the ray directions of the spiral around the sphere
+	const float GOLDEN_ANGLE = 2.39996323f;
+
+	// object space bounds and vertices of one draw in a capture
+	struct DRAW_RANGE
+	{
+		glm::vec3 boundsMin;
+		glm::vec3 boundsMax;
+		size_t first;
+		size_t count;
+	};
+
+	// split a capture into the vertex range of each draw
+	std::vector<DRAW_RANGE> FindDrawRanges(const std::vector<LightmapBaker::BAKE_VERTEX>& vertices)
+	{
+		std::vector<DRAW_RANGE> ranges;
+
+		for (size_t i = 0; i < vertices.size(); i++)
+		{
+			size_t drawID = (size_t)vertices[i].drawID;
+			if (drawID >= ranges.size())
+			{
+				DRAW_RANGE range;
+				range.boundsMin = glm::vec3(1e30f);
+				range.boundsMax = glm::vec3(-1e30f);
+				range.first = i;
+				range.count = 0;
+				ranges.resize(drawID + 1, range);
+			}
+
+			DRAW_RANGE& range = ranges[drawID];
+			if (range.count == 0)
+			{
+				range.first = i;
+			}
+			range.boundsMin = glm::min(range.boundsMin, vertices[i].worldPosition);
+			range.boundsMax = glm::max(range.boundsMax, vertices[i].worldPosition);
+			range.count++;
+		}
+
+		return(ranges);
+	}
+
+	// get the second order spherical harmonics basis for a direction
+	void EvaluateBasis(const glm::vec3& d, float basis[])
+	{
+		basis[0] = 0.282095f;
+		basis[1] = 0.488603f * d.y;
+		basis[2] = 0.488603f * d.z;
+		basis[3] = 0.488603f * d.x;
+		basis[4] = 1.092548f * d.x * d.y;
+		basis[5] = 1.092548f * d.y * d.z;
+		basis[6] = 0.315392f * ((3.0f * d.z * d.z) - 1.0f);
+		basis[7] = 1.092548f * d.x * d.z;
+		basis[8] = 0.546274f * ((d.x * d.x) - (d.y * d.y));
+	}
+}
+
+/***********************************************************
+ *  ProbeManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ProbeManager::ProbeManager()
+{
+	m_gridMin = glm::vec3(0.0f);
+	m_spacing = PROBE_SPACING;
+	for (int i = 0; i < 3; i++)
+	{
+		m_gridSize[i] = 0;
+	}
+	m_probeTexture = 0;
+	m_bEnabled = true;
+	m_lastBakedCount = 0;
+	m_lastBakeSeconds = 0.0;
+}
+
+/***********************************************************
+ *  ~ProbeManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ProbeManager::~ProbeManager()
+{
+	DestroyProbes();
+}
+
+/***********************************************************
+ *  PlaceGrid()
+ *
+ *  This method is used for spreading the probes evenly
+ *  through the bounds of the scene triangles, one spacing
+ *  apart, or farther apart when the scene is too large for
+ *  MAX_GRID_SIZE probes along an axis.  Returns true when
+ *  the grid moved, and every probe has to be baked again.
+ ***********************************************************/
+bool ProbeManager::PlaceGrid(const std::vector<LightmapBaker::BAKE_VERTEX>& vertices)
+{
+	glm::vec3 boundsMin = glm::vec3(1e30f);
+	glm::vec3 boundsMax = glm::vec3(-1e30f);
+
+	for (size_t i = 0; i < vertices.size(); i++)
+	{
+		boundsMin = glm::min(boundsMin, vertices[i].worldPosition);
+		boundsMax = glm::max(boundsMax, vertices[i].worldPosition);
+	}
+
+	glm::vec3 extent = boundsMax - boundsMin;
+	float largestExtent = std::max(extent.x, std::max(extent.y, extent.z));
+	float spacing = std::max(PROBE_SPACING, largestExtent / (float)MAX_GRID_SIZE);
+	int gridSize[3];
+	glm::vec3 gridMin;
+
+	// the probes sit in the middle of their cells, off the surfaces
+	for (int axis = 0; axis < 3; axis++)
+	{
+		gridSize[axis] = std::min(MAX_GRID_SIZE, std::max(1, (int)std::ceil(extent[axis] / spacing)));
+		gridMin[axis] = boundsMin[axis] + (0.5f * (extent[axis] - ((gridSize[axis] - 1) * spacing)));
+	}
+
+	bool bMoved = (gridMin != m_gridMin) || (spacing != m_spacing) ||
+		(gridSize[0] != m_gridSize[0]) || (gridSize[1] != m_gridSize[1]) || (gridSize[2] != m_gridSize[2]);
+
+	m_gridMin = gridMin;
+	m_spacing = spacing;
+	for (int axis = 0; axis < 3; axis++)
+	{
+		m_gridSize[axis] = gridSize[axis];
+	}
+	if (bMoved == true)
+	{
+		m_coefficients.assign((size_t)GetProbeCount() * SH_COEFFICIENT_COUNT, glm::vec3(0.0f));
+	}
+
+	return(bMoved);
+}
+
+/***********************************************************
+ *  GetProbePosition()
+ *
+ *  This method is used for getting the world position of a
+ *  probe from its index, which runs along x, then y, then z.
+ ***********************************************************/
+glm::vec3 ProbeManager::GetProbePosition(int index) const
+{
+	int x = index % m_gridSize[0];
+	int y = (index / m_gridSize[0]) % m_gridSize[1];
+	int z = index / (m_gridSize[0] * m_gridSize[1]);
+
+	return(m_gridMin + (glm::vec3((float)x, (float)y, (float)z) * m_spacing));
+}
+
+/***********************************************************
+ *  FindChangedProbes()
+ *
+ *  This method is used for comparing a new capture with the
+ *  one that the probes were baked for, draw by draw, and
+ *  listing the probes near the old or new bounds of any draw
+ *  that changed.  Farther probes only see the change as a
+ *  small part of their sphere of rays, so they are kept.
+ ***********************************************************/
+void ProbeManager::FindChangedProbes(const std::vector<LightmapBaker::BAKE_VERTEX>& vertices, std::vector<int>& probes) const
+{
+	std::vector<DRAW_RANGE> oldRanges = FindDrawRanges(m_vertices);
+	std::vector<DRAW_RANGE> newRanges = FindDrawRanges(vertices);
+	std::vector<glm::vec3> changedMin;
+	std::vector<glm::vec3> changedMax;
+	size_t drawCount = std::max(oldRanges.size(), newRanges.size());
+
+	for (size_t d = 0; d < drawCount; d++)
+	{
+		bool bOld = (d < oldRanges.size()) && (oldRanges[d].count > 0);
+		bool bNew = (d < newRanges.size()) && (newRanges[d].count > 0);
+		if ((bOld == false) && (bNew == false))
+		{
+			continue;
+		}
+		if ((bOld == true) && (bNew == true) &&
+			(oldRanges[d].count == newRanges[d].count) &&
+			(memcmp(&m_vertices[oldRanges[d].first], &vertices[newRanges[d].first],
+				oldRanges[d].count * sizeof(LightmapBaker::BAKE_VERTEX)) == 0))
+		{
+			continue;
+		}
+
+		if (bOld == true)
+		{
+			changedMin.push_back(oldRanges[d].boundsMin);
+			changedMax.push_back(oldRanges[d].boundsMax);
+		}
+		if (bNew == true)
+		{
+			changedMin.push_back(newRanges[d].boundsMin);
+			changedMax.push_back(newRanges[d].boundsMax);
+		}
+	}
+
+	probes.clear();
+	for (int i = 0; i < GetProbeCount(); i++)
+	{
+		glm::vec3 position = GetProbePosition(i);
+
+		for (size_t c = 0; c < changedMin.size(); c++)
+		{
+			glm::vec3 closest = glm::clamp(position, changedMin[c], changedMax[c]);
+			if (glm::distance(position, closest) <= PROBE_UPDATE_DISTANCE)
+			{
+				probes.push_back(i);
+				break;
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  BakeProbe()
+ *
+ *  This method is used for tracing rays from a probe in
+ *  directions spread evenly over the sphere, projecting the
+ *  arriving light onto the spherical harmonics basis, and
+ *  turning it into irradiance.  The coefficients are divided
+ *  by pi, so the shader multiplies them by the base color
+ *  the same way as the constant ambient light.
+ ***********************************************************/
+void ProbeManager::BakeProbe(const LightmapBaker& baker, int index)
+{
+	// cosine lobe convolution of each band, divided by pi
+	const float BAND_SCALE[SH_COEFFICIENT_COUNT] =
+	{
+		1.0f,
+		2.0f / 3.0f, 2.0f / 3.0f, 2.0f / 3.0f,
+		0.25f, 0.25f, 0.25f, 0.25f, 0.25f
+	};
+	glm::vec3 position = GetProbePosition(index);
+	glm::vec3 coefficients[SH_COEFFICIENT_COUNT];
+	float basis[SH_COEFFICIENT_COUNT];
+
+	for (int k = 0; k < SH_COEFFICIENT_COUNT; k++)
+	{
+		coefficients[k] = glm::vec3(0.0f);
+	}
+
+	for (int i = 0; i < PROBE_RAY_COUNT; i++)
+	{
+		float z = 1.0f - ((2.0f * i + 1.0f) / PROBE_RAY_COUNT);
+		float radius = std::sqrt(std::max(0.0f, 1.0f - (z * z)));
+		float angle = GOLDEN_ANGLE * i;
+		glm::vec3 direction = glm::vec3(radius * std::cos(angle), z, radius * std::sin(angle));
+		uint32_t seed = (uint32_t)((index * PROBE_RAY_COUNT) + i);
+		glm::vec3 light = baker.TraceIncomingLight(position, direction, seed);
+
+		EvaluateBasis(direction, basis);
+		for (int k = 0; k < SH_COEFFICIENT_COUNT; k++)
+		{
+			coefficients[k] += light * basis[k];
+		}
+	}
+
+	float weight = (4.0f * PI) / PROBE_RAY_COUNT;
+	for (int k = 0; k < SH_COEFFICIENT_COUNT; k++)
+	{
+		m_coefficients[((size_t)index * SH_COEFFICIENT_COUNT) + k] = coefficients[k] * (weight * BAND_SCALE[k]);
+	}
+}
+
+/***********************************************************
+ *  BakeWorker()
+ *
+ *  This method is used for baking groups of probes on one
+ *  thread until the list of probes is empty.
+ ***********************************************************/
+void ProbeManager::BakeWorker(const LightmapBaker* pBaker, const std::vector<int>* pProbes, std::atomic<size_t>* pNextProbe)
+{
+	while (true)
+	{
+		size_t first = pNextProbe->fetch_add(PROBES_PER_JOB);
+		if (first >= pProbes->size())
+		{
+			return;
+		}
+
+		size_t last = std::min(first + PROBES_PER_JOB, pProbes->size());
+		for (size_t i = first; i < last; i++)
+		{
+			BakeProbe(*pBaker, (*pProbes)[i]);
+		}
+	}
+}
+
+/***********************************************************
+ *  UploadProbes()
+ *
+ *  This method is used for copying the coefficients into
+ *  the 3D texture, with the whole grid repeated along z for
+ *  each coefficient, so a coefficient is filtered between
+ *  the eight closest probes in one texture fetch.
+ ***********************************************************/
+void ProbeManager::UploadProbes()
+{
+	int width = m_gridSize[0];
+	int height = m_gridSize[1];
+	int depth = m_gridSize[2] * SH_COEFFICIENT_COUNT;
+	int probeCount = GetProbeCount();
+	std::vector<glm::vec3> texels((size_t)probeCount * SH_COEFFICIENT_COUNT);
+
+	for (int i = 0; i < probeCount; i++)
+	{
+		for (int k = 0; k < SH_COEFFICIENT_COUNT; k++)
+		{
+			texels[((size_t)k * probeCount) + i] = m_coefficients[((size_t)i * SH_COEFFICIENT_COUNT) + k];
+		}
+	}
+
+	// the probe texture has its own unit, so the scene textures stay bound
+	glActiveTexture(GL_TEXTURE0 + PROBE_TEXTURE_UNIT);
+	if (m_probeTexture == 0)
+	{
+		glGenTextures(1, &m_probeTexture);
+		glBindTexture(GL_TEXTURE_3D, m_probeTexture);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+	}
+	glBindTexture(GL_TEXTURE_3D, m_probeTexture);
+	glTexImage3D(GL_TEXTURE_3D, 0, GL_RGB16F, width, height, depth, 0, GL_RGB, GL_FLOAT, &texels[0]);
+	glActiveTexture(GL_TEXTURE0);
+}
+
+/***********************************************************
+ *  UpdateProbes()
+ *
+ *  This method is used for capturing the static objects and
+ *  baking the probes on all of the CPU cores.  The first
+ *  update, or one where the lights or the grid changed,
+ *  bakes every probe, later updates only bake the probes
+ *  near the objects that changed.
+ ***********************************************************/
+bool ProbeManager::UpdateProbes(LightmapManager* pLightmapManager, SceneManager* pSceneManager)
+{
+	std::vector<LightmapBaker::BAKE_VERTEX> vertices;
+	const std::vector<LightmapBaker::BAKE_LIGHT>& lights = pLightmapManager->GetLights();
+
+	m_lastBakedCount = 0;
+	m_lastBakeSeconds = 0.0;
+	if (pLightmapManager->CaptureScene(pSceneManager, vertices) == false)
+	{
+		return(false);
+	}
+
+	bool bLightsChanged = (lights.size() != m_lights.size());
+	for (size_t i = 0; (i < lights.size()) && (bLightsChanged == false); i++)
+	{
+		bLightsChanged = (lights[i].vector != m_lights[i].vector) ||
+			(lights[i].color != m_lights[i].color) ||
+			(lights[i].bDirectional != m_lights[i].bDirectional);
+	}
+
+	std::vector<int> probes;
+	if ((PlaceGrid(vertices) == true) || (bLightsChanged == true) || (m_probeTexture == 0))
+	{
+		for (int i = 0; i < GetProbeCount(); i++)
+		{
+			probes.push_back(i);
+		}
+	}
+	else
+	{
+		FindChangedProbes(vertices, probes);
+	}
+	m_vertices.swap(vertices);
+	m_lights = lights;
+	if (probes.size() == 0)
+	{
+		return(true);
+	}
+
+	LightmapBaker baker;
+	baker.SetTriangles(m_vertices);
+	for (size_t i = 0; i < m_lights.size(); i++)
+	{
+		baker.AddLight(m_lights[i]);
+	}
+	baker.PrepareTracing();
+
+	int threadCount = std::max(1, (int)std::thread::hardware_concurrency());
+	std::atomic<size_t> nextProbe(0);
+	std::vector<std::thread> threads;
+
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 1; i < threadCount; i++)
+	{
+		threads.push_back(std::thread(&ProbeManager::BakeWorker, this, &baker, &probes, &nextProbe));
+	}
+	BakeWorker(&baker, &probes, &nextProbe);
+	for (size_t i = 0; i < threads.size(); i++)
+	{
+		threads[i].join();
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	m_lastBakedCount = (int)probes.size();
+	m_lastBakeSeconds = std::chrono::duration<double>(end - start).count();
+	UploadProbes();
+
+	std::cout << "INFO: Probe grid: " << m_gridSize[0] << "x" << m_gridSize[1] << "x" << m_gridSize[2]
+		<< ", probes baked: " << m_lastBakedCount << " of " << GetProbeCount()
+		<< ", threads: " << threadCount
+		<< ", time: " << (m_lastBakeSeconds * 1000.0) << " ms" << std::endl;
+
+	return(true);
+}
+
+/***********************************************************
+ *  DestroyProbes()
+ *
+ *  This method is used for freeing the probe texture.
+ ***********************************************************/
+void ProbeManager::DestroyProbes()
+{
+	if (m_probeTexture != 0)
+	{
+		glDeleteTextures(1, &m_probeTexture);
+		m_probeTexture = 0;
+	}
+}
+
+/***********************************************************
+ *  SetEnabled()
+ *
+ *  This method is used for turning the probes in the
+ *  shading pass on or off.
+ ***********************************************************/
+void ProbeManager::SetEnabled(bool bEnabled)
+{
+	m_bEnabled = bEnabled;
+}
+
+/***********************************************************
+ *  GetProbeCount()
+ *
+ *  This method is used for getting the number of probes in
+ *  the grid.
+ ***********************************************************/
+int ProbeManager::GetProbeCount() const
+{
+	return(m_gridSize[0] * m_gridSize[1] * m_gridSize[2]);
+}
+
+/***********************************************************
+ *  GetLastBakedCount()
+ *
+ *  This method is used for getting the number of probes
+ *  that the last update baked.
+ ***********************************************************/
+int ProbeManager::GetLastBakedCount() const
+{
+	return(m_lastBakedCount);
+}
+
+/***********************************************************
+ *  GetLastBakeSeconds()
+ *
+ *  This method is used for getting the seconds that the
+ *  last update spent baking.
+ ***********************************************************/
+double ProbeManager::GetLastBakeSeconds() const
+{
+	return(m_lastBakeSeconds);
+}
+
+/***********************************************************
+ *  BindProbes()
+ *
+ *  This method is used for binding the probe texture and
+ *  setting the grid placement into the shader.  The sampler
+ *  is always set, so that it never shares a texture unit
+ *  with the object texture.
+ ***********************************************************/
+void ProbeManager::BindProbes(ShaderManager* pShaderManager)
+{
+	bool bUseProbes = (m_bEnabled == true) && (m_probeTexture != 0);
+
+	pShaderManager->setSampler2DValue(g_ProbeGridName, PROBE_TEXTURE_UNIT);
+	pShaderManager->setBoolValue(g_UseProbesName, bUseProbes);
+	if (bUseProbes == false)
+	{
+		return;
+	}
+
+	glActiveTexture(GL_TEXTURE0 + PROBE_TEXTURE_UNIT);
+	glBindTexture(GL_TEXTURE_3D, m_probeTexture);
+	glActiveTexture(GL_TEXTURE0);
+
+	pShaderManager->setVec3Value("probeGridMin", m_gridMin);
+	pShaderManager->setFloatValue(g_ProbeGridSpacingName, m_spacing);
+	pShaderManager->setVec3Value("probeGridSize",
+		glm::vec3((float)m_gridSize[0], (float)m_gridSize[1], (float)m_gridSize[2]));
+}
@@ -0,0 +1,100 @@
+///////////////////////////////////////////////////////////////////////////////
+// probemanager.h
+// ============
+// manage the irradiance probe grid - spherical harmonics baking and sampling
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+#include "SceneManager.h"
+#include "LightmapManager.h"
+
+#include <atomic>
+#include <vector>
+
+/***********************************************************
+ *  ProbeManager
+ *
+ *  This class contains the code for a grid of irradiance
+ *  probes over the scene volume.  Each probe traces rays in
+ *  every direction on the CPU and stores the light that
+ *  arrives from the static objects as second order spherical
+ *  harmonics.  The nine coefficients of every probe are kept
+ *  in one 3D texture, one slab of the grid for each
+ *  coefficient, and the fragment shader blends the eight
+ *  closest probes in place of the constant ambient light.
+ *  When the static objects or the lights change, only the
+ *  probes close to the change are baked again.
+ ***********************************************************/
+class ProbeManager
+{
+public:
+	// constructor
+	ProbeManager();
+	// destructor
+	~ProbeManager();
+
+	// texture unit the shading pass reads the probe grid from
+	static const int PROBE_TEXTURE_UNIT = 27;
+	// spherical harmonics coefficients of each probe, must match the shaders
+	static const int SH_COEFFICIENT_COUNT = 9;
+	// rays traced from each probe
+	static const int PROBE_RAY_COUNT = 128;
+	// most probes along one axis of the grid
+	static const int MAX_GRID_SIZE = 32;
+
+private:
+	// captured scene triangles that the probes were baked for
+	std::vector<LightmapBaker::BAKE_VERTEX> m_vertices;
+	// lights that the probes were baked for
+	std::vector<LightmapBaker::BAKE_LIGHT> m_lights;
+	// world position of the first probe and the distance between probes
+	glm::vec3 m_gridMin;
+	float m_spacing;
+	// number of probes along each axis
+	int m_gridSize[3];
+	// coefficients of every probe, SH_COEFFICIENT_COUNT for each
+	std::vector<glm::vec3> m_coefficients;
+	// OpenGL 3D texture of the coefficients
+	GLuint m_probeTexture;
+	// true when the shading pass samples the probes
+	bool m_bEnabled;
+	// number of probes and seconds of the last update
+	int m_lastBakedCount;
+	double m_lastBakeSeconds;
+
+	// place the grid around the scene triangles
+	bool PlaceGrid(const std::vector<LightmapBaker::BAKE_VERTEX>& vertices);
+	// get the world position of a probe
+	glm::vec3 GetProbePosition(int index) const;
+	// find the probes close to the objects that changed since the last bake
+	void FindChangedProbes(const std::vector<LightmapBaker::BAKE_VERTEX>& vertices, std::vector<int>& probes) const;
+	// trace the rays of one probe and store its coefficients
+	void BakeProbe(const LightmapBaker& baker, int index);
+	// bake a share of the probes on one thread
+	void BakeWorker(const LightmapBaker* pBaker, const std::vector<int>* pProbes, std::atomic<size_t>* pNextProbe);
+	// copy the coefficients into the 3D texture
+	void UploadProbes();
+
+public:
+	// capture the static objects and bake the probes that changed
+	bool UpdateProbes(LightmapManager* pLightmapManager, SceneManager* pSceneManager);
+	// free the probe texture
+	void DestroyProbes();
+	// turn the probes in the shading pass on or off
+	void SetEnabled(bool bEnabled);
+
+	// get the number of probes in the grid
+	int GetProbeCount() const;
+	// get the number of probes baked by the last update
+	int GetLastBakedCount() const;
+	// get the seconds that the last update baked for
+	double GetLastBakeSeconds() const;
+
+	// bind the probe grid and set the grid values into the shader
+	void BindProbes(ShaderManager* pShaderManager);
+};
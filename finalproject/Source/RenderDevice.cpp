@@ -0,0 +1,673 @@
+///////////////////////////////////////////////////////////////////////////////
+// renderdevice.cpp
+// ============
+// submit buffers, textures, pipelines and draws to OpenGL or a null backend
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "RenderDevice.h"
+
+#include <fstream>
+
+// declare the global variables
+namespace
+{
+	// uniform offset alignment assumed by the null backend, the
+	// largest that OpenGL drivers ask for
+	const size_t NULL_UNIFORM_ALIGNMENT = 256;
+}
+
+/***********************************************************
+ *  RenderDevice()
+ *
+ *  The constructor for the class.  The OpenGL backend needs
+ *  the context to be current.
+ ***********************************************************/
+RenderDevice::RenderDevice(BACKEND backend)
+{
+	m_backend = backend;
+	m_boundPipeline = 0;
+	m_boundVertexBuffer = 0;
+	m_boundIndexBuffer = 0;
+	m_vertexArray = 0;
+	m_uniformAlignment = NULL_UNIFORM_ALIGNMENT;
+	m_buffers.SetCapacity(MAX_BUFFERS);
+	m_textures.SetCapacity(MAX_TEXTURES);
+	m_pipelines.SetCapacity(MAX_PIPELINES);
+	ResetCounters();
+
+	if (m_backend == BACKEND_OPENGL)
+	{
+		GLint alignment = 0;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		if (alignment > 0)
+		{
+			m_uniformAlignment = (size_t)alignment;
+		}
+
+		// the vertex layout never changes, only the buffer it reads
+		glGenVertexArrays(1, &m_vertexArray);
+		glBindVertexArray(m_vertexArray);
+		glEnableVertexAttribArray(0);
+		glVertexAttribFormat(0, 3, GL_FLOAT, GL_FALSE, offsetof(VERTEX, position));
+		glVertexAttribBinding(0, 0);
+		glEnableVertexAttribArray(1);
+		glVertexAttribFormat(1, 3, GL_FLOAT, GL_FALSE, offsetof(VERTEX, normal));
+		glVertexAttribBinding(1, 0);
+		glEnableVertexAttribArray(2);
+		glVertexAttribFormat(2, 2, GL_FLOAT, GL_FALSE, offsetof(VERTEX, textureCoordinate));
+		glVertexAttribBinding(2, 0);
+		glBindVertexArray(0);
+	}
+}
+
+/***********************************************************
+ *  ~RenderDevice()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+RenderDevice::~RenderDevice()
+{
+	// destroying a resource moves the last one into its place,
+	// so they are destroyed from the back
+	while (m_buffers.GetCount() > 0)
+	{
+		DestroyBuffer(m_buffers.GetHandleAt(m_buffers.GetCount() - 1));
+	}
+	while (m_textures.GetCount() > 0)
+	{
+		DestroyTexture(m_textures.GetHandleAt(m_textures.GetCount() - 1));
+	}
+	while (m_pipelines.GetCount() > 0)
+	{
+		DestroyPipeline(m_pipelines.GetHandleAt(m_pipelines.GetCount() - 1));
+	}
+	if (m_vertexArray != 0)
+	{
+		glDeleteVertexArrays(1, &m_vertexArray);
+		m_vertexArray = 0;
+	}
+}
+
+/***********************************************************
+ *  Validate()
+ *
+ *  This method is used for counting a failed check of a
+ *  command and outputting the first few.  It returns the
+ *  passed in condition, so that the command can be skipped.
+ ***********************************************************/
+bool RenderDevice::Validate(bool bCondition, const char* message)
+{
+	if (bCondition == false)
+	{
+		if (m_validationErrors < MAX_REPORTED_ERRORS)
+		{
+			std::cout << "ERROR: Render device " << message << std::endl;
+		}
+		m_validationErrors++;
+	}
+	return(bCondition);
+}
+
+/***********************************************************
+ *  IsLiveBuffer()
+ *
+ *  This method is used for checking that a buffer handle was
+ *  created and not yet destroyed.
+ ***********************************************************/
+bool RenderDevice::IsLiveBuffer(unsigned int buffer) const
+{
+	return(m_buffers.IsValid(buffer));
+}
+
+/***********************************************************
+ *  IsLiveTexture()
+ *
+ *  This method is used for checking that a texture handle
+ *  was created and not yet destroyed.
+ ***********************************************************/
+bool RenderDevice::IsLiveTexture(unsigned int texture) const
+{
+	return(m_textures.IsValid(texture));
+}
+
+/***********************************************************
+ *  IsLivePipeline()
+ *
+ *  This method is used for checking that a pipeline handle
+ *  was created and not yet destroyed.
+ ***********************************************************/
+bool RenderDevice::IsLivePipeline(unsigned int pipeline) const
+{
+	return(m_pipelines.IsValid(pipeline));
+}
+
+/***********************************************************
+ *  GetBackend()
+ *
+ *  This method is used for getting the API the commands are
+ *  made with.
+ ***********************************************************/
+RenderDevice::BACKEND RenderDevice::GetBackend() const
+{
+	return(m_backend);
+}
+
+/***********************************************************
+ *  GetUniformAlignment()
+ *
+ *  This method is used for getting the alignment that the
+ *  offsets of the bound uniform buffer ranges must have.
+ ***********************************************************/
+size_t RenderDevice::GetUniformAlignment() const
+{
+	return(m_uniformAlignment);
+}
+
+/***********************************************************
+ *  CreateBuffer()
+ *
+ *  This method is used for creating a buffer of the passed
+ *  in size, filled from the passed in data when it is not
+ *  NULL.  It returns 0 when the buffer is empty.
+ ***********************************************************/
+unsigned int RenderDevice::CreateBuffer(BUFFER_TYPE type, size_t size, const void* pData)
+{
+	m_commandCounts[COMMAND_CREATE_BUFFER]++;
+	if ((Validate(size > 0, "buffer created without a size") == false) ||
+		(Validate(m_buffers.GetCount() < m_buffers.GetCapacity(), "buffer created past the most alive at once") == false))
+	{
+		return(0);
+	}
+
+	BUFFER_RECORD record;
+	record.type = type;
+	record.size = size;
+	record.id = 0;
+
+	if (m_backend == BACKEND_OPENGL)
+	{
+		// the copy target leaves the bindings of the draws alone,
+		// an index buffer bound here would change the vertex array
+		glGenBuffers(1, &record.id);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, record.id);
+		glBufferData(GL_COPY_WRITE_BUFFER, size, pData, (type == BUFFER_UNIFORM) ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	}
+	if (NULL != pData)
+	{
+		m_uploadedBytes += size;
+	}
+
+	return(m_buffers.Add(record));
+}
+
+/***********************************************************
+ *  UpdateBuffer()
+ *
+ *  This method is used for replacing a range of a buffer
+ *  with the passed in data.
+ ***********************************************************/
+void RenderDevice::UpdateBuffer(unsigned int buffer, size_t offset, size_t size, const void* pData)
+{
+	m_commandCounts[COMMAND_UPDATE_BUFFER]++;
+	if ((Validate(IsLiveBuffer(buffer), "buffer updated through an unknown or destroyed handle") == false) ||
+		(Validate(offset + size <= m_buffers.Get(buffer)->size, "buffer updated past its end") == false) ||
+		(Validate(NULL != pData, "buffer updated without data") == false))
+	{
+		return;
+	}
+
+	if (m_backend == BACKEND_OPENGL)
+	{
+		glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffers.Get(buffer)->id);
+		glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, pData);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	}
+	m_uploadedBytes += size;
+}
+
+/***********************************************************
+ *  DestroyBuffer()
+ *
+ *  This method is used for freeing a buffer.
+ ***********************************************************/
+void RenderDevice::DestroyBuffer(unsigned int buffer)
+{
+	m_commandCounts[COMMAND_DESTROY_BUFFER]++;
+	if (Validate(IsLiveBuffer(buffer), "buffer destroyed through an unknown or destroyed handle") == false)
+	{
+		return;
+	}
+
+	BUFFER_RECORD& record = *m_buffers.Get(buffer);
+	if (m_backend == BACKEND_OPENGL)
+	{
+		glDeleteBuffers(1, &record.id);
+	}
+	m_buffers.Remove(buffer);
+
+	if (m_boundVertexBuffer == buffer)
+	{
+		m_boundVertexBuffer = 0;
+	}
+	if (m_boundIndexBuffer == buffer)
+	{
+		m_boundIndexBuffer = 0;
+	}
+}
+
+/***********************************************************
+ *  CreateTexture()
+ *
+ *  This method is used for creating an RGBA8 texture with
+ *  mipmaps, filled from the passed in pixels when they are
+ *  not NULL.
+ ***********************************************************/
+unsigned int RenderDevice::CreateTexture(int width, int height, const void* pPixels)
+{
+	m_commandCounts[COMMAND_CREATE_TEXTURE]++;
+	if ((Validate((width > 0) && (height > 0), "texture created without a size") == false) ||
+		(Validate(m_textures.GetCount() < m_textures.GetCapacity(), "texture created past the most alive at once") == false))
+	{
+		return(0);
+	}
+
+	TEXTURE_RECORD record;
+	record.width = width;
+	record.height = height;
+	record.format = GL_RGBA8;
+	record.id = 0;
+
+	if (m_backend == BACKEND_OPENGL)
+	{
+		glGenTextures(1, &record.id);
+		glBindTexture(GL_TEXTURE_2D, record.id);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pPixels);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glGenerateMipmap(GL_TEXTURE_2D);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+	if (NULL != pPixels)
+	{
+		m_uploadedBytes += (unsigned long long)width * height * 4;
+	}
+
+	return(m_textures.Add(record));
+}
+
+/***********************************************************
+ *  DestroyTexture()
+ *
+ *  This method is used for freeing a texture.
+ ***********************************************************/
+void RenderDevice::DestroyTexture(unsigned int texture)
+{
+	m_commandCounts[COMMAND_DESTROY_TEXTURE]++;
+	if (Validate(IsLiveTexture(texture), "texture destroyed through an unknown or destroyed handle") == false)
+	{
+		return;
+	}
+
+	TEXTURE_RECORD& record = *m_textures.Get(texture);
+	if (m_backend == BACKEND_OPENGL)
+	{
+		glDeleteTextures(1, &record.id);
+	}
+	m_textures.Remove(texture);
+}
+
+/***********************************************************
+ *  CreatePipeline()
+ *
+ *  This method is used for creating a pipeline from the
+ *  passed in shader files and fixed function state.  The
+ *  null backend only checks that the shader files exist.
+ ***********************************************************/
+unsigned int RenderDevice::CreatePipeline(const PIPELINE_DESC& desc)
+{
+	m_commandCounts[COMMAND_CREATE_PIPELINE]++;
+	std::ifstream vertexFile(desc.vertexShaderFilename);
+	std::ifstream fragmentFile(desc.fragmentShaderFilename);
+	if ((Validate(vertexFile.good(), "pipeline vertex shader file not found") == false) ||
+		(Validate(fragmentFile.good(), "pipeline fragment shader file not found") == false) ||
+		(Validate(m_pipelines.GetCount() < m_pipelines.GetCapacity(), "pipeline created past the most alive at once") == false))
+	{
+		return(0);
+	}
+
+	PIPELINE_RECORD record;
+	record.desc = desc;
+	record.pShader = NULL;
+
+	if (m_backend == BACKEND_OPENGL)
+	{
+		record.pShader = new ShaderManager();
+		record.pShader->LoadShaders(desc.vertexShaderFilename, desc.fragmentShaderFilename);
+	}
+
+	return(m_pipelines.Add(record));
+}
+
+/***********************************************************
+ *  DestroyPipeline()
+ *
+ *  This method is used for freeing a pipeline.
+ ***********************************************************/
+void RenderDevice::DestroyPipeline(unsigned int pipeline)
+{
+	m_commandCounts[COMMAND_DESTROY_PIPELINE]++;
+	if (Validate(IsLivePipeline(pipeline), "pipeline destroyed through an unknown or destroyed handle") == false)
+	{
+		return;
+	}
+
+	PIPELINE_RECORD& record = *m_pipelines.Get(pipeline);
+	if (NULL != record.pShader)
+	{
+		delete record.pShader;
+		record.pShader = NULL;
+	}
+	m_pipelines.Remove(pipeline);
+
+	if (m_boundPipeline == pipeline)
+	{
+		m_boundPipeline = 0;
+	}
+}
+
+/***********************************************************
+ *  SetPipeline()
+ *
+ *  This method is used for binding the shaders and the fixed
+ *  function state of the next draws.
+ ***********************************************************/
+void RenderDevice::SetPipeline(unsigned int pipeline)
+{
+	m_commandCounts[COMMAND_SET_PIPELINE]++;
+	if (Validate(IsLivePipeline(pipeline), "pipeline bound through an unknown or destroyed handle") == false)
+	{
+		return;
+	}
+	m_boundPipeline = pipeline;
+
+	if (m_backend == BACKEND_OPENGL)
+	{
+		const PIPELINE_RECORD& record = *m_pipelines.Get(pipeline);
+		record.pShader->use();
+		if (record.desc.bDepthTest == true)
+		{
+			glEnable(GL_DEPTH_TEST);
+		}
+		else
+		{
+			glDisable(GL_DEPTH_TEST);
+		}
+		glDepthMask(record.desc.bDepthWrite ? GL_TRUE : GL_FALSE);
+		glDepthFunc(record.desc.depthFunc);
+		if (record.desc.bBlend == true)
+		{
+			glEnable(GL_BLEND);
+		}
+		else
+		{
+			glDisable(GL_BLEND);
+		}
+		if (record.desc.bCullBackFaces == true)
+		{
+			glEnable(GL_CULL_FACE);
+		}
+		else
+		{
+			glDisable(GL_CULL_FACE);
+		}
+		glBindVertexArray(m_vertexArray);
+	}
+}
+
+/***********************************************************
+ *  SetVertexBuffer()
+ *
+ *  This method is used for binding the vertex buffer of the
+ *  next draws.
+ ***********************************************************/
+void RenderDevice::SetVertexBuffer(unsigned int buffer)
+{
+	m_commandCounts[COMMAND_SET_VERTEX_BUFFER]++;
+	if ((Validate(IsLiveBuffer(buffer), "vertex buffer bound through an unknown or destroyed handle") == false) ||
+		(Validate(m_buffers.Get(buffer)->type == BUFFER_VERTEX, "vertex buffer bound from another type") == false))
+	{
+		return;
+	}
+	m_boundVertexBuffer = buffer;
+
+	if (m_backend == BACKEND_OPENGL)
+	{
+		glBindVertexArray(m_vertexArray);
+		glBindVertexBuffer(0, m_buffers.Get(buffer)->id, 0, sizeof(VERTEX));
+	}
+}
+
+/***********************************************************
+ *  SetIndexBuffer()
+ *
+ *  This method is used for binding the 32 bit index buffer
+ *  of the next indexed draws.
+ ***********************************************************/
+void RenderDevice::SetIndexBuffer(unsigned int buffer)
+{
+	m_commandCounts[COMMAND_SET_INDEX_BUFFER]++;
+	if ((Validate(IsLiveBuffer(buffer), "index buffer bound through an unknown or destroyed handle") == false) ||
+		(Validate(m_buffers.Get(buffer)->type == BUFFER_INDEX, "index buffer bound from another type") == false))
+	{
+		return;
+	}
+	m_boundIndexBuffer = buffer;
+
+	if (m_backend == BACKEND_OPENGL)
+	{
+		glBindVertexArray(m_vertexArray);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_buffers.Get(buffer)->id);
+	}
+}
+
+/***********************************************************
+ *  SetTexture()
+ *
+ *  This method is used for binding a texture to one of the
+ *  texture slots of the next draws.
+ ***********************************************************/
+void RenderDevice::SetTexture(int slot, unsigned int texture)
+{
+	m_commandCounts[COMMAND_SET_TEXTURE]++;
+	if ((Validate((slot >= 0) && (slot < MAX_TEXTURE_SLOTS), "texture bound to a slot out of range") == false) ||
+		(Validate(IsLiveTexture(texture), "texture bound through an unknown or destroyed handle") == false))
+	{
+		return;
+	}
+
+	if (m_backend == BACKEND_OPENGL)
+	{
+		glActiveTexture(GL_TEXTURE0 + slot);
+		glBindTexture(GL_TEXTURE_2D, m_textures.Get(texture)->id);
+		glActiveTexture(GL_TEXTURE0);
+	}
+}
+
+/***********************************************************
+ *  SetUniformBuffer()
+ *
+ *  This method is used for binding a range of a uniform
+ *  buffer to one of the uniform block bindings of the next
+ *  draws.  The offset must be a multiple of the alignment.
+ ***********************************************************/
+void RenderDevice::SetUniformBuffer(int binding, unsigned int buffer, size_t offset, size_t size)
+{
+	m_commandCounts[COMMAND_SET_UNIFORM_BUFFER]++;
+	if ((Validate((binding >= 0) && (binding < MAX_UNIFORM_BINDINGS), "uniform buffer bound to a binding out of range") == false) ||
+		(Validate(IsLiveBuffer(buffer), "uniform buffer bound through an unknown or destroyed handle") == false) ||
+		(Validate(m_buffers.Get(buffer)->type == BUFFER_UNIFORM, "uniform buffer bound from another type") == false) ||
+		(Validate(offset + size <= m_buffers.Get(buffer)->size, "uniform buffer range past its end") == false) ||
+		(Validate((offset % m_uniformAlignment) == 0, "uniform buffer offset not aligned") == false))
+	{
+		return;
+	}
+
+	if (m_backend == BACKEND_OPENGL)
+	{
+		glBindBufferRange(GL_UNIFORM_BUFFER, binding, m_buffers.Get(buffer)->id, offset, size);
+	}
+}
+
+/***********************************************************
+ *  Draw()
+ *
+ *  This method is used for drawing triangles from the bound
+ *  vertex buffer.
+ ***********************************************************/
+void RenderDevice::Draw(int vertexCount, int firstVertex)
+{
+	m_commandCounts[COMMAND_DRAW]++;
+	if ((Validate(IsLivePipeline(m_boundPipeline), "draw without a pipeline") == false) ||
+		(Validate(IsLiveBuffer(m_boundVertexBuffer), "draw without a vertex buffer") == false) ||
+		(Validate((firstVertex + vertexCount) * sizeof(VERTEX) <= m_buffers.Get(m_boundVertexBuffer)->size,
+			"draw past the end of the vertex buffer") == false))
+	{
+		return;
+	}
+	m_drawnIndices += vertexCount;
+
+	if (m_backend == BACKEND_OPENGL)
+	{
+		glDrawArrays(GL_TRIANGLES, firstVertex, vertexCount);
+	}
+}
+
+/***********************************************************
+ *  DrawIndexed()
+ *
+ *  This method is used for drawing triangles from the bound
+ *  index buffer and vertex buffer.
+ ***********************************************************/
+void RenderDevice::DrawIndexed(int indexCount, int firstIndex)
+{
+	m_commandCounts[COMMAND_DRAW_INDEXED]++;
+	if ((Validate(IsLivePipeline(m_boundPipeline), "indexed draw without a pipeline") == false) ||
+		(Validate(IsLiveBuffer(m_boundVertexBuffer), "indexed draw without a vertex buffer") == false) ||
+		(Validate(IsLiveBuffer(m_boundIndexBuffer), "indexed draw without an index buffer") == false) ||
+		(Validate((firstIndex + indexCount) * sizeof(GLuint) <= m_buffers.Get(m_boundIndexBuffer)->size,
+			"indexed draw past the end of the index buffer") == false))
+	{
+		return;
+	}
+	m_drawnIndices += indexCount;
+
+	if (m_backend == BACKEND_OPENGL)
+	{
+		glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, (const void*)(firstIndex * sizeof(GLuint)));
+	}
+}
+
+/***********************************************************
+ *  ResetCounters()
+ *
+ *  This method is used for clearing the command counters.
+ ***********************************************************/
+void RenderDevice::ResetCounters()
+{
+	for (int i = 0; i < COMMAND_COUNT; i++)
+	{
+		m_commandCounts[i] = 0;
+	}
+	m_drawnIndices = 0;
+	m_uploadedBytes = 0;
+	m_validationErrors = 0;
+}
+
+/***********************************************************
+ *  GetCommandCount()
+ *
+ *  This method is used for getting the number of commands of
+ *  the passed in type since the last reset.
+ ***********************************************************/
+unsigned long long RenderDevice::GetCommandCount(COMMAND command) const
+{
+	return(m_commandCounts[command]);
+}
+
+/***********************************************************
+ *  GetDrawnIndices()
+ *
+ *  This method is used for getting the number of vertices
+ *  and indices drawn since the last reset.
+ ***********************************************************/
+unsigned long long RenderDevice::GetDrawnIndices() const
+{
+	return(m_drawnIndices);
+}
+
+/***********************************************************
+ *  GetUploadedBytes()
+ *
+ *  This method is used for getting the number of bytes sent
+ *  into buffers and textures since the last reset.
+ ***********************************************************/
+unsigned long long RenderDevice::GetUploadedBytes() const
+{
+	return(m_uploadedBytes);
+}
+
+/***********************************************************
+ *  GetValidationErrorCount()
+ *
+ *  This method is used for getting the number of commands
+ *  that failed their checks since the last reset.
+ ***********************************************************/
+int RenderDevice::GetValidationErrorCount() const
+{
+	return(m_validationErrors);
+}
+
+/***********************************************************
+ *  GetCommandName()
+ *
+ *  This method is used for getting the display name of a
+ *  command.
+ ***********************************************************/
+const char* RenderDevice::GetCommandName(COMMAND command)
+{
+	const char* names[] = {
+		"create buffer", "update buffer", "destroy buffer",
+		"create texture", "destroy texture",
+		"create pipeline", "destroy pipeline",
+		"set pipeline", "set vertex buffer", "set index buffer",
+		"set texture", "set uniform buffer",
+		"draw", "draw indexed" };
+	return(names[command]);
+}
+
+/***********************************************************
+ *  ReportCounters()
+ *
+ *  This method is used for outputting the commands made
+ *  since the last reset.
+ ***********************************************************/
+void RenderDevice::ReportCounters() const
+{
+	std::cout << "INFO: Render device " << ((m_backend == BACKEND_NULL) ? "null" : "OpenGL") << " commands:";
+	for (int i = 0; i < COMMAND_COUNT; i++)
+	{
+		if (m_commandCounts[i] > 0)
+		{
+			std::cout << " " << GetCommandName((COMMAND)i) << " " << m_commandCounts[i] << ",";
+		}
+	}
+	std::cout << " indices drawn " << m_drawnIndices
+		<< ", bytes uploaded " << m_uploadedBytes
+		<< ", validation errors " << m_validationErrors << std::endl;
+}
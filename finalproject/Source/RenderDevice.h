@@ -0,0 +1,200 @@
+///////////////////////////////////////////////////////////////////////////////
+// renderdevice.h
+// ============
+// submit buffers, textures, pipelines and draws to OpenGL or a null backend
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+#include "HandlePool.h"
+
+#include <cstddef>
+#include <vector>
+
+/***********************************************************
+ *  RenderDevice
+ *
+ *  This class contains the code for the thin layer between
+ *  the engine and the graphics API.  Resources are referred
+ *  to by handles, and draws are made from the bound pipeline,
+ *  vertex and index buffers, textures and uniform buffers.
+ *  Two backends are available:
+ *
+ *    OpenGL   every command is made with OpenGL
+ *    null     no OpenGL call is made, so no context is needed,
+ *             for measuring the CPU cost of the engine alone
+ *
+ *  Both backends check every command against the created
+ *  resources and the bound state, and count the commands by
+ *  type, so a frame can be compared between them.
+ ***********************************************************/
+class RenderDevice
+{
+public:
+	// API the commands are made with
+	enum BACKEND
+	{
+		BACKEND_OPENGL,
+		BACKEND_NULL
+	};
+
+	// use of a buffer
+	enum BUFFER_TYPE
+	{
+		BUFFER_VERTEX,
+		BUFFER_INDEX,
+		BUFFER_UNIFORM
+	};
+
+	// commands that are counted
+	enum COMMAND
+	{
+		COMMAND_CREATE_BUFFER,
+		COMMAND_UPDATE_BUFFER,
+		COMMAND_DESTROY_BUFFER,
+		COMMAND_CREATE_TEXTURE,
+		COMMAND_DESTROY_TEXTURE,
+		COMMAND_CREATE_PIPELINE,
+		COMMAND_DESTROY_PIPELINE,
+		COMMAND_SET_PIPELINE,
+		COMMAND_SET_VERTEX_BUFFER,
+		COMMAND_SET_INDEX_BUFFER,
+		COMMAND_SET_TEXTURE,
+		COMMAND_SET_UNIFORM_BUFFER,
+		COMMAND_DRAW,
+		COMMAND_DRAW_INDEXED,
+		COMMAND_COUNT
+	};
+
+	// layout of every vertex, matching the attributes of the shaders
+	struct VERTEX
+	{
+		glm::vec3 position;
+		glm::vec3 normal;
+		glm::vec2 textureCoordinate;
+	};
+
+	// shaders and fixed function state of a pipeline
+	struct PIPELINE_DESC
+	{
+		const char* vertexShaderFilename;
+		const char* fragmentShaderFilename;
+		bool bDepthTest;
+		bool bDepthWrite;
+		// comparison of the depth test, such as GL_LESS or GL_EQUAL
+		GLenum depthFunc;
+		bool bBlend;
+		bool bCullBackFaces;
+	};
+
+	// number of texture slots and uniform buffer bindings
+	static const int MAX_TEXTURE_SLOTS = 16;
+	static const int MAX_UNIFORM_BINDINGS = 8;
+	// most of the validation errors that are output
+	static const int MAX_REPORTED_ERRORS = 8;
+	// most resources of each type that are alive at once
+	static const int MAX_BUFFERS = 4096;
+	static const int MAX_TEXTURES = 1024;
+	static const int MAX_PIPELINES = 256;
+
+	// constructor
+	RenderDevice(BACKEND backend);
+	// destructor
+	~RenderDevice();
+
+private:
+	// created buffer
+	struct BUFFER_RECORD
+	{
+		BUFFER_TYPE type;
+		size_t size;
+		GLuint id;
+	};
+
+	// created texture
+	struct TEXTURE_RECORD
+	{
+		int width;
+		int height;
+		GLenum format;
+		GLuint id;
+	};
+
+	// created pipeline
+	struct PIPELINE_RECORD
+	{
+		PIPELINE_DESC desc;
+		ShaderManager* pShader;
+	};
+
+	BACKEND m_backend;
+	// records of the live resources, whose handles carry the
+	// generation of their slot, so that a destroyed handle is
+	// never mistaken for the resource that reused its slot
+	HandlePool<BUFFER_RECORD> m_buffers;
+	HandlePool<TEXTURE_RECORD> m_textures;
+	HandlePool<PIPELINE_RECORD> m_pipelines;
+	// bound state
+	unsigned int m_boundPipeline;
+	unsigned int m_boundVertexBuffer;
+	unsigned int m_boundIndexBuffer;
+	// vertex array holding the fixed vertex layout
+	GLuint m_vertexArray;
+	// alignment of the uniform buffer offsets
+	size_t m_uniformAlignment;
+	// counters since the last reset
+	unsigned long long m_commandCounts[COMMAND_COUNT];
+	unsigned long long m_drawnIndices;
+	unsigned long long m_uploadedBytes;
+	int m_validationErrors;
+
+	// count a failed check and output the first few
+	bool Validate(bool bCondition, const char* message);
+	// check a handle against the records of its type
+	bool IsLiveBuffer(unsigned int buffer) const;
+	bool IsLiveTexture(unsigned int texture) const;
+	bool IsLivePipeline(unsigned int pipeline) const;
+
+public:
+	// get the API the commands are made with
+	BACKEND GetBackend() const;
+	// get the alignment uniform buffer offsets are rounded up to
+	size_t GetUniformAlignment() const;
+
+	// create, fill and free buffers
+	unsigned int CreateBuffer(BUFFER_TYPE type, size_t size, const void* pData);
+	void UpdateBuffer(unsigned int buffer, size_t offset, size_t size, const void* pData);
+	void DestroyBuffer(unsigned int buffer);
+	// create and free RGBA8 textures
+	unsigned int CreateTexture(int width, int height, const void* pPixels);
+	void DestroyTexture(unsigned int texture);
+	// create and free pipelines
+	unsigned int CreatePipeline(const PIPELINE_DESC& desc);
+	void DestroyPipeline(unsigned int pipeline);
+
+	// bind the state of the next draws
+	void SetPipeline(unsigned int pipeline);
+	void SetVertexBuffer(unsigned int buffer);
+	void SetIndexBuffer(unsigned int buffer);
+	void SetTexture(int slot, unsigned int texture);
+	void SetUniformBuffer(int binding, unsigned int buffer, size_t offset, size_t size);
+	// draw triangles from the bound vertex buffer, or its indices
+	void Draw(int vertexCount, int firstVertex);
+	void DrawIndexed(int indexCount, int firstIndex);
+
+	// clear the command counters
+	void ResetCounters();
+	// get the counters since the last reset
+	unsigned long long GetCommandCount(COMMAND command) const;
+	unsigned long long GetDrawnIndices() const;
+	unsigned long long GetUploadedBytes() const;
+	int GetValidationErrorCount() const;
+	// get the display name of a command
+	static const char* GetCommandName(COMMAND command);
+	// output the counters since the last reset
+	void ReportCounters() const;
+};
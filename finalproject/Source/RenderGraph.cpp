@@ -0,0 +1,785 @@
+///////////////////////////////////////////////////////////////////////////////
+// rendergraph.cpp
+// ============
+// schedule the render passes of a frame and share their transient targets
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "RenderGraph.h"
+
+#include <algorithm>
+#include <iostream>
+
+// declare the global variables
+namespace
+{
+	/***********************************************************
+	 *  GetFormatBytes()
+	 *
+	 *  This function is used for getting the size in bytes of
+	 *  one texel of the passed in texture format.
+	 ***********************************************************/
+	size_t GetFormatBytes(GLenum format)
+	{
+		switch (format)
+		{
+		case GL_R8:
+			return(1);
+		case GL_RG8:
+		case GL_R16F:
+			return(2);
+		case GL_RGBA16F:
+		case GL_RG32F:
+			return(8);
+		case GL_RGBA32F:
+			return(16);
+		default:
+			// GL_RGBA8, GL_R32F, GL_RG16F and the depth formats
+			return(4);
+		}
+	}
+
+	/***********************************************************
+	 *  IsDepthFormat()
+	 *
+	 *  This function is used for checking whether the passed
+	 *  in format is attached as the depth of a framebuffer.
+	 ***********************************************************/
+	bool IsDepthFormat(GLenum format)
+	{
+		return((format == GL_DEPTH_COMPONENT16) ||
+			(format == GL_DEPTH_COMPONENT24) ||
+			(format == GL_DEPTH_COMPONENT32F) ||
+			(format == GL_DEPTH24_STENCIL8));
+	}
+
+	/***********************************************************
+	 *  Contains()
+	 *
+	 *  This function is used for checking whether a resource
+	 *  is in the passed in list of a pass.
+	 ***********************************************************/
+	bool Contains(const std::vector<int>& resources, int resource)
+	{
+		return(std::find(resources.begin(), resources.end(), resource) != resources.end());
+	}
+}
+
+/***********************************************************
+ *  RenderGraph()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+RenderGraph::RenderGraph()
+{
+	m_passCount = 0;
+	m_bCompiled = false;
+	m_culledPassCount = 0;
+	m_transientBytes = 0;
+	m_aliasedBytes = 0;
+}
+
+/***********************************************************
+ *  ~RenderGraph()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+RenderGraph::~RenderGraph()
+{
+	ReleaseTextures();
+}
+
+/***********************************************************
+ *  Reset()
+ *
+ *  This method is used for clearing the passes and textures
+ *  declared for the last frame.  The pooled textures are
+ *  kept for the next compile, and the records of the passes
+ *  are kept for the passes of the next frame.
+ ***********************************************************/
+void RenderGraph::Reset()
+{
+	m_resources.clear();
+	m_passCount = 0;
+	m_schedule.clear();
+	m_bCompiled = false;
+}
+
+/***********************************************************
+ *  CreateTexture()
+ *
+ *  This method is used for declaring a texture that is
+ *  written and read by the passes of this frame, and that
+ *  can share its memory with the other transient textures.
+ *  It returns the resource used to refer to it.
+ ***********************************************************/
+int RenderGraph::CreateTexture(const char* name, int width, int height, GLenum format)
+{
+	RESOURCE resource;
+	resource.name = name;
+	resource.width = width;
+	resource.height = height;
+	resource.format = format;
+	resource.bImported = false;
+	resource.texture = 0;
+	resource.framebuffer = 0;
+	resource.physical = -1;
+	resource.firstUse = -1;
+	resource.lastUse = -1;
+	resource.readerCount = 0;
+	m_resources.push_back(resource);
+
+	return((int)m_resources.size() - 1);
+}
+
+/***********************************************************
+ *  ImportTexture()
+ *
+ *  This method is used for declaring a texture owned outside
+ *  of the graph, with the framebuffer that draws into it.
+ *  The passes writing an imported texture are never culled.
+ ***********************************************************/
+int RenderGraph::ImportTexture(const char* name, GLuint texture, GLuint framebuffer)
+{
+	int resource = CreateTexture(name, 0, 0, GL_NONE);
+	m_resources[resource].bImported = true;
+	m_resources[resource].texture = texture;
+	m_resources[resource].framebuffer = framebuffer;
+
+	return(resource);
+}
+
+/***********************************************************
+ *  AddPass()
+ *
+ *  This method is used for declaring a pass, which is drawn
+ *  by calling the passed in function with the owner and tag.
+ *  It returns the pass used for declaring its textures.  A
+ *  record kept from an earlier frame is reused, so its lists
+ *  of textures keep their memory.
+ ***********************************************************/
+int RenderGraph::AddPass(const char* name, EXECUTE_FUNCTION pExecute, void* pOwner, int tag)
+{
+	if (m_passCount == (int)m_passes.size())
+	{
+		m_passes.push_back(PASS());
+	}
+
+	PASS& pass = m_passes[m_passCount];
+	pass.name = name;
+	pass.pExecute = pExecute;
+	pass.pOwner = pOwner;
+	pass.tag = tag;
+	pass.reads.clear();
+	pass.writes.clear();
+	pass.bCulled = false;
+
+	return(m_passCount++);
+}
+
+/***********************************************************
+ *  ReadTexture()
+ *
+ *  This method is used for declaring that the passed in pass
+ *  samples the passed in texture.
+ ***********************************************************/
+void RenderGraph::ReadTexture(int pass, int resource)
+{
+	if (Contains(m_passes[pass].reads, resource) == false)
+	{
+		m_passes[pass].reads.push_back(resource);
+	}
+}
+
+/***********************************************************
+ *  WriteTexture()
+ *
+ *  This method is used for declaring that the passed in pass
+ *  draws into the passed in texture.
+ ***********************************************************/
+void RenderGraph::WriteTexture(int pass, int resource)
+{
+	if (Contains(m_passes[pass].writes, resource) == false)
+	{
+		m_passes[pass].writes.push_back(resource);
+	}
+}
+
+/***********************************************************
+ *  Compile()
+ *
+ *  This method is used for culling, ordering and aliasing
+ *  the passes declared for this frame.  It returns false
+ *  when a texture is read before any pass writes it, or
+ *  when the passes depend on each other in a loop.
+ ***********************************************************/
+bool RenderGraph::Compile()
+{
+	m_bCompiled = false;
+
+	for (size_t r = 0; r < m_resources.size(); r++)
+	{
+		m_resources[r].readerCount = 0;
+		m_resources[r].physical = -1;
+		m_resources[r].firstUse = -1;
+		m_resources[r].lastUse = -1;
+	}
+	for (int p = 0; p < m_passCount; p++)
+	{
+		m_passes[p].bCulled = false;
+		for (size_t i = 0; i < m_passes[p].reads.size(); i++)
+		{
+			m_resources[m_passes[p].reads[i]].readerCount++;
+		}
+	}
+
+	// a transient texture holds nothing until a pass writes it
+	for (size_t r = 0; r < m_resources.size(); r++)
+	{
+		if ((m_resources[r].bImported == true) || (m_resources[r].readerCount == 0))
+		{
+			continue;
+		}
+		bool bWritten = false;
+		for (int p = 0; (p < m_passCount) && (bWritten == false); p++)
+		{
+			bWritten = Contains(m_passes[p].writes, (int)r);
+		}
+		if (bWritten == false)
+		{
+			std::cout << "ERROR: Render graph texture " << m_resources[r].name
+				<< " is read but never written" << std::endl;
+			return(false);
+		}
+	}
+
+	CullPasses();
+	if (SchedulePasses() == false)
+	{
+		return(false);
+	}
+	if (AliasTextures() == false)
+	{
+		return(false);
+	}
+
+	m_bCompiled = true;
+	return(true);
+}
+
+/***********************************************************
+ *  CullPasses()
+ *
+ *  This method is used for culling the passes whose written
+ *  textures are all transient and never read.  Culling a
+ *  pass can leave the textures it read without readers, so
+ *  their writers are checked in turn.
+ ***********************************************************/
+void RenderGraph::CullPasses()
+{
+	std::vector<int>& outputCounts = m_outputCounts;
+	std::vector<int>& unread = m_unreadResources;
+	outputCounts.assign(m_passCount, 0);
+	unread.clear();
+
+	for (int p = 0; p < m_passCount; p++)
+	{
+		outputCounts[p] = (int)m_passes[p].writes.size();
+		// a pass without outputs has nothing to contribute
+		m_passes[p].bCulled = (outputCounts[p] == 0);
+	}
+	for (size_t r = 0; r < m_resources.size(); r++)
+	{
+		if ((m_resources[r].bImported == false) && (m_resources[r].readerCount == 0))
+		{
+			unread.push_back((int)r);
+		}
+	}
+
+	while (unread.empty() == false)
+	{
+		int resource = unread.back();
+		unread.pop_back();
+
+		for (int p = 0; p < m_passCount; p++)
+		{
+			PASS& pass = m_passes[p];
+			if ((pass.bCulled == true) || (Contains(pass.writes, resource) == false))
+			{
+				continue;
+			}
+			if (--outputCounts[p] > 0)
+			{
+				continue;
+			}
+
+			pass.bCulled = true;
+			for (size_t i = 0; i < pass.reads.size(); i++)
+			{
+				RESOURCE& read = m_resources[pass.reads[i]];
+				if ((--read.readerCount == 0) && (read.bImported == false))
+				{
+					unread.push_back(pass.reads[i]);
+				}
+			}
+		}
+	}
+
+	m_culledPassCount = 0;
+	for (int p = 0; p < m_passCount; p++)
+	{
+		if (m_passes[p].bCulled == true)
+		{
+			m_culledPassCount++;
+		}
+	}
+}
+
+/***********************************************************
+ *  SchedulePasses()
+ *
+ *  This method is used for sorting the passes that were not
+ *  culled.  Two passes using the same texture, one of them
+ *  writing it, run in the order they were added, except that
+ *  a transient texture is always written before it is read.
+ *  Of the passes that are ready, the one reading the most
+ *  recently written texture runs first, which shortens the
+ *  lifetime of the transient textures.
+ ***********************************************************/
+bool RenderGraph::SchedulePasses()
+{
+	int passCount = m_passCount;
+	std::vector<std::vector<int> >& successors = m_successors;
+	std::vector<int>& predecessorCounts = m_predecessorCounts;
+	std::vector<int>& latestPredecessors = m_latestPredecessors;
+	std::vector<bool>& scheduled = m_scheduled;
+	// the successor lists are only added, so their memory is kept
+	if ((int)successors.size() < passCount)
+	{
+		successors.resize(passCount);
+	}
+	for (int p = 0; p < passCount; p++)
+	{
+		successors[p].clear();
+	}
+	predecessorCounts.assign(passCount, 0);
+	latestPredecessors.assign(passCount, -1);
+	scheduled.assign(passCount, false);
+
+	for (int a = 0; a < passCount; a++)
+	{
+		for (int b = a + 1; b < passCount; b++)
+		{
+			if ((m_passes[a].bCulled == true) || (m_passes[b].bCulled == true))
+			{
+				continue;
+			}
+
+			for (size_t r = 0; r < m_resources.size(); r++)
+			{
+				int resource = (int)r;
+				bool bReadsA = Contains(m_passes[a].reads, resource);
+				bool bWritesA = Contains(m_passes[a].writes, resource);
+				bool bReadsB = Contains(m_passes[b].reads, resource);
+				bool bWritesB = Contains(m_passes[b].writes, resource);
+				if (((bWritesA == false) && (bWritesB == false)) ||
+					((bReadsA == false) && (bWritesA == false)) ||
+					((bReadsB == false) && (bWritesB == false)))
+				{
+					continue;
+				}
+
+				int from = a;
+				int to = b;
+				if ((m_resources[r].bImported == false) && (bWritesA == false) && (bWritesB == true))
+				{
+					from = b;
+					to = a;
+				}
+				if (Contains(successors[from], to) == false)
+				{
+					successors[from].push_back(to);
+					predecessorCounts[to]++;
+				}
+			}
+		}
+	}
+
+	m_schedule.clear();
+	int liveCount = passCount - m_culledPassCount;
+	while ((int)m_schedule.size() < liveCount)
+	{
+		int best = -1;
+		for (int p = 0; p < passCount; p++)
+		{
+			if ((m_passes[p].bCulled == true) || (scheduled[p] == true) || (predecessorCounts[p] > 0))
+			{
+				continue;
+			}
+			if ((best < 0) || (latestPredecessors[p] > latestPredecessors[best]))
+			{
+				best = p;
+			}
+		}
+		if (best < 0)
+		{
+			std::cout << "ERROR: Render graph passes depend on each other in a loop" << std::endl;
+			return(false);
+		}
+
+		int position = (int)m_schedule.size();
+		m_schedule.push_back(best);
+		scheduled[best] = true;
+		for (size_t i = 0; i < successors[best].size(); i++)
+		{
+			int next = successors[best][i];
+			predecessorCounts[next]--;
+			latestPredecessors[next] = std::max(latestPredecessors[next], position);
+		}
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  AliasTextures()
+ *
+ *  This method is used for placing each transient texture
+ *  in a pooled texture of the same size and format that is
+ *  not used by another texture between its first and last
+ *  pass.  The pooled textures left unused this frame are
+ *  freed, so a change of size does not keep the old ones.
+ ***********************************************************/
+bool RenderGraph::AliasTextures()
+{
+	for (int position = 0; position < (int)m_schedule.size(); position++)
+	{
+		const PASS& pass = m_passes[m_schedule[position]];
+		for (int list = 0; list < 2; list++)
+		{
+			const std::vector<int>& resources = (list == 0) ? pass.reads : pass.writes;
+			for (size_t i = 0; i < resources.size(); i++)
+			{
+				RESOURCE& resource = m_resources[resources[i]];
+				if (resource.firstUse < 0)
+				{
+					resource.firstUse = position;
+				}
+				resource.lastUse = position;
+			}
+		}
+	}
+
+	for (size_t i = 0; i < m_physicalTextures.size(); i++)
+	{
+		m_physicalTextures[i].bUsed = false;
+		m_physicalTextures[i].lastUse = -1;
+	}
+
+	m_transientBytes = 0;
+	for (int position = 0; position < (int)m_schedule.size(); position++)
+	{
+		for (size_t r = 0; r < m_resources.size(); r++)
+		{
+			RESOURCE& resource = m_resources[r];
+			if ((resource.bImported == true) || (resource.firstUse != position))
+			{
+				continue;
+			}
+			m_transientBytes += GetFormatBytes(resource.format) * resource.width * resource.height;
+
+			// a pooled texture is free once its last texture was used
+			// by an earlier pass than the first pass of this one
+			int found = -1;
+			for (size_t i = 0; (i < m_physicalTextures.size()) && (found < 0); i++)
+			{
+				const PHYSICAL_TEXTURE& physical = m_physicalTextures[i];
+				if ((physical.width == resource.width) &&
+					(physical.height == resource.height) &&
+					(physical.format == resource.format) &&
+					((physical.bUsed == false) || (physical.lastUse < position)))
+				{
+					found = (int)i;
+				}
+			}
+			if (found < 0)
+			{
+				PHYSICAL_TEXTURE physical;
+				physical.width = resource.width;
+				physical.height = resource.height;
+				physical.format = resource.format;
+				if (CreatePhysicalTexture(physical) == false)
+				{
+					std::cout << "ERROR: Render graph texture " << resource.name
+						<< " could not be created" << std::endl;
+					return(false);
+				}
+				m_physicalTextures.push_back(physical);
+				found = (int)m_physicalTextures.size() - 1;
+			}
+
+			m_physicalTextures[found].bUsed = true;
+			m_physicalTextures[found].lastUse = resource.lastUse;
+			resource.physical = found;
+		}
+	}
+
+	// free the unused pooled textures and renumber the others
+	std::vector<int>& remap = m_physicalRemap;
+	std::vector<PHYSICAL_TEXTURE>& kept = m_keptTextures;
+	remap.assign(m_physicalTextures.size(), -1);
+	kept.clear();
+	m_aliasedBytes = 0;
+	for (size_t i = 0; i < m_physicalTextures.size(); i++)
+	{
+		PHYSICAL_TEXTURE& physical = m_physicalTextures[i];
+		if (physical.bUsed == true)
+		{
+			remap[i] = (int)kept.size();
+			kept.push_back(physical);
+			m_aliasedBytes += GetFormatBytes(physical.format) * physical.width * physical.height;
+		}
+		else
+		{
+			glDeleteFramebuffers(1, &physical.framebuffer);
+			glDeleteTextures(1, &physical.texture);
+		}
+	}
+	m_physicalTextures.swap(kept);
+	for (size_t r = 0; r < m_resources.size(); r++)
+	{
+		if (m_resources[r].physical >= 0)
+		{
+			m_resources[r].physical = remap[m_resources[r].physical];
+		}
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  CreatePhysicalTexture()
+ *
+ *  This method is used for creating the texture of a pooled
+ *  texture and the framebuffer that draws into it.
+ ***********************************************************/
+bool RenderGraph::CreatePhysicalTexture(PHYSICAL_TEXTURE& physical)
+{
+	// the textures are created on their own unit, so the scene
+	// textures stay bound
+	glActiveTexture(GL_TEXTURE0 + CREATE_TEXTURE_UNIT);
+	glGenTextures(1, &physical.texture);
+	glBindTexture(GL_TEXTURE_2D, physical.texture);
+	glTexStorage2D(GL_TEXTURE_2D, 1, physical.format, physical.width, physical.height);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glActiveTexture(GL_TEXTURE0);
+
+	glGenFramebuffers(1, &physical.framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, physical.framebuffer);
+	if (IsDepthFormat(physical.format) == true)
+	{
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, physical.texture, 0);
+		glDrawBuffer(GL_NONE);
+	}
+	else
+	{
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, physical.texture, 0);
+	}
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	physical.bUsed = false;
+	physical.lastUse = -1;
+
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		glDeleteFramebuffers(1, &physical.framebuffer);
+		glDeleteTextures(1, &physical.texture);
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  Execute()
+ *
+ *  This method is used for drawing the passes of the last
+ *  compile in their scheduled order.
+ ***********************************************************/
+void RenderGraph::Execute()
+{
+	if (m_bCompiled == false)
+	{
+		return;
+	}
+
+	for (size_t i = 0; i < m_schedule.size(); i++)
+	{
+		const PASS& pass = m_passes[m_schedule[i]];
+		pass.pExecute(*this, pass.pOwner, pass.tag);
+	}
+}
+
+/***********************************************************
+ *  ReleaseTextures()
+ *
+ *  This method is used for freeing the pooled textures.
+ ***********************************************************/
+void RenderGraph::ReleaseTextures()
+{
+	for (size_t i = 0; i < m_physicalTextures.size(); i++)
+	{
+		glDeleteFramebuffers(1, &m_physicalTextures[i].framebuffer);
+		glDeleteTextures(1, &m_physicalTextures[i].texture);
+	}
+	m_physicalTextures.clear();
+
+	for (size_t r = 0; r < m_resources.size(); r++)
+	{
+		m_resources[r].physical = -1;
+	}
+	m_bCompiled = false;
+}
+
+/***********************************************************
+ *  GetTexture()
+ *
+ *  This method is used for getting the texture of the passed
+ *  in resource, or 0 when a transient texture was not placed
+ *  in a pooled texture.
+ ***********************************************************/
+GLuint RenderGraph::GetTexture(int resource) const
+{
+	const RESOURCE& declared = m_resources[resource];
+	if (declared.bImported == true)
+	{
+		return(declared.texture);
+	}
+	if (declared.physical < 0)
+	{
+		return(0);
+	}
+
+	return(m_physicalTextures[declared.physical].texture);
+}
+
+/***********************************************************
+ *  GetFramebuffer()
+ *
+ *  This method is used for getting the framebuffer drawing
+ *  into the passed in resource.
+ ***********************************************************/
+GLuint RenderGraph::GetFramebuffer(int resource) const
+{
+	const RESOURCE& declared = m_resources[resource];
+	if (declared.bImported == true)
+	{
+		return(declared.framebuffer);
+	}
+	if (declared.physical < 0)
+	{
+		return(0);
+	}
+
+	return(m_physicalTextures[declared.physical].framebuffer);
+}
+
+/***********************************************************
+ *  GetPassCount()
+ *
+ *  This method is used for getting the number of passes
+ *  declared for this frame.
+ ***********************************************************/
+int RenderGraph::GetPassCount() const
+{
+	return(m_passCount);
+}
+
+/***********************************************************
+ *  GetCulledPassCount()
+ *
+ *  This method is used for getting the number of passes
+ *  culled by the last compile.
+ ***********************************************************/
+int RenderGraph::GetCulledPassCount() const
+{
+	return(m_culledPassCount);
+}
+
+/***********************************************************
+ *  GetPhysicalTextureCount()
+ *
+ *  This method is used for getting the number of pooled
+ *  textures used by the last compile.
+ ***********************************************************/
+int RenderGraph::GetPhysicalTextureCount() const
+{
+	return((int)m_physicalTextures.size());
+}
+
+/***********************************************************
+ *  GetTransientBytes()
+ *
+ *  This method is used for getting the memory the transient
+ *  textures of the last compile would need without aliasing.
+ ***********************************************************/
+size_t RenderGraph::GetTransientBytes() const
+{
+	return(m_transientBytes);
+}
+
+/***********************************************************
+ *  GetAliasedBytes()
+ *
+ *  This method is used for getting the memory of the pooled
+ *  textures that the transient textures were placed in.
+ ***********************************************************/
+size_t RenderGraph::GetAliasedBytes() const
+{
+	return(m_aliasedBytes);
+}
+
+/***********************************************************
+ *  ReportSchedule()
+ *
+ *  This method is used for outputting the order of the
+ *  passes, the culled passes, and the transient memory with
+ *  and without aliasing.
+ ***********************************************************/
+void RenderGraph::ReportSchedule() const
+{
+	std::cout << "INFO: Render graph schedule:";
+	for (size_t i = 0; i < m_schedule.size(); i++)
+	{
+		std::cout << ((i == 0) ? " " : ", ") << m_passes[m_schedule[i]].name;
+	}
+	std::cout << std::endl;
+
+	for (int p = 0; p < m_passCount; p++)
+	{
+		if (m_passes[p].bCulled == true)
+		{
+			std::cout << "INFO: Render graph culled " << m_passes[p].name << std::endl;
+		}
+	}
+	for (size_t r = 0; r < m_resources.size(); r++)
+	{
+		if ((m_resources[r].bImported == false) && (m_resources[r].physical >= 0))
+		{
+			std::cout << "INFO: Render graph texture " << m_resources[r].name
+				<< " in pooled texture " << m_resources[r].physical
+				<< ", passes " << m_resources[r].firstUse << " to " << m_resources[r].lastUse << std::endl;
+		}
+	}
+
+	std::cout << "INFO: Render graph transient memory: " << (m_transientBytes / 1024)
+		<< " KB without aliasing, " << (m_aliasedBytes / 1024) << " KB in "
+		<< m_physicalTextures.size() << " pooled textures with aliasing" << std::endl;
+}
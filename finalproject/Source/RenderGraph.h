@@ -0,0 +1,162 @@
+///////////////////////////////////////////////////////////////////////////////
+// rendergraph.h
+// ============
+// schedule the render passes of a frame and share their transient targets
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <vector>
+
+/***********************************************************
+ *  RenderGraph
+ *
+ *  This class contains the code for building the passes of
+ *  a frame from what each pass reads and writes, instead of
+ *  drawing into framebuffers owned by each manager.  Every
+ *  frame the passes and their textures are declared again,
+ *  then the graph is compiled:
+ *
+ *    culling     the passes whose outputs are never read are
+ *                dropped, unless they write an imported
+ *                texture such as the window
+ *    ordering    the passes are sorted so every texture is
+ *                written before it is read, preferring the
+ *                passes that read what was just written
+ *    aliasing    each transient texture is placed in a pooled
+ *                texture of the same size and format whose
+ *                earlier texture is no longer used
+ *
+ *  and executed by calling each pass in order.  The pooled
+ *  textures are kept from frame to frame, and so are the
+ *  records of the passes and the lists used to compile them,
+ *  so a frame declaring the same passes does not allocate.
+ ***********************************************************/
+class RenderGraph
+{
+public:
+	// constructor
+	RenderGraph();
+	// destructor
+	~RenderGraph();
+
+	// texture unit the pooled textures are created on
+	static const int CREATE_TEXTURE_UNIT = 39;
+
+	// called to draw a pass, with the owner and tag it was added with
+	typedef void (*EXECUTE_FUNCTION)(RenderGraph& graph, void* pOwner, int tag);
+
+private:
+	// texture declared for this frame
+	struct RESOURCE
+	{
+		const char* name;
+		int width;
+		int height;
+		GLenum format;
+		// imported textures are owned outside of the graph
+		bool bImported;
+		GLuint texture;
+		GLuint framebuffer;
+		// pooled texture the transient texture was placed in
+		int physical;
+		// scheduled positions of the first and last pass using it
+		int firstUse;
+		int lastUse;
+		int readerCount;
+	};
+
+	// pass declared for this frame
+	struct PASS
+	{
+		const char* name;
+		EXECUTE_FUNCTION pExecute;
+		void* pOwner;
+		int tag;
+		std::vector<int> reads;
+		std::vector<int> writes;
+		bool bCulled;
+	};
+
+	// texture and framebuffer in the pool
+	struct PHYSICAL_TEXTURE
+	{
+		int width;
+		int height;
+		GLenum format;
+		GLuint texture;
+		GLuint framebuffer;
+		// true once used this frame, until the last pass of lastUse
+		bool bUsed;
+		int lastUse;
+	};
+
+	std::vector<RESOURCE> m_resources;
+	// records of the passes, of which the first m_passCount are
+	// declared for this frame and the rest are kept for reuse
+	std::vector<PASS> m_passes;
+	int m_passCount;
+	// passes in the order they are executed
+	std::vector<int> m_schedule;
+	std::vector<PHYSICAL_TEXTURE> m_physicalTextures;
+	bool m_bCompiled;
+	int m_culledPassCount;
+	size_t m_transientBytes;
+	size_t m_aliasedBytes;
+	// lists used while compiling, kept so that they do not allocate
+	std::vector<int> m_outputCounts;
+	std::vector<int> m_unreadResources;
+	std::vector<std::vector<int> > m_successors;
+	std::vector<int> m_predecessorCounts;
+	std::vector<int> m_latestPredecessors;
+	std::vector<bool> m_scheduled;
+	std::vector<int> m_physicalRemap;
+	std::vector<PHYSICAL_TEXTURE> m_keptTextures;
+
+	// cull the passes that do not contribute to an imported texture
+	void CullPasses();
+	// sort the passes by their dependencies
+	bool SchedulePasses();
+	// place the transient textures in the pooled textures
+	bool AliasTextures();
+	// create a pooled texture of the passed in size and format
+	bool CreatePhysicalTexture(PHYSICAL_TEXTURE& physical);
+
+public:
+	// clear the passes and textures of the last frame
+	void Reset();
+	// declare a texture that only lives within the frame
+	int CreateTexture(const char* name, int width, int height, GLenum format);
+	// declare a texture owned outside of the graph
+	int ImportTexture(const char* name, GLuint texture, GLuint framebuffer);
+	// declare a pass and the textures it reads and writes
+	int AddPass(const char* name, EXECUTE_FUNCTION pExecute, void* pOwner, int tag);
+	void ReadTexture(int pass, int resource);
+	void WriteTexture(int pass, int resource);
+
+	// cull, order and alias the declared passes
+	bool Compile();
+	// draw the scheduled passes
+	void Execute();
+	// free the pooled textures
+	void ReleaseTextures();
+
+	// get the texture and the framebuffer drawing into a resource
+	GLuint GetTexture(int resource) const;
+	GLuint GetFramebuffer(int resource) const;
+
+	// get the statistics of the last compile
+	int GetPassCount() const;
+	int GetCulledPassCount() const;
+	int GetPhysicalTextureCount() const;
+	size_t GetTransientBytes() const;
+	size_t GetAliasedBytes() const;
+	// output the schedule and the transient memory of the last compile
+	void ReportSchedule() const;
+};
@@ -0,0 +1,307 @@
+///////////////////////////////////////////////////////////////////////////////
+// resolutionmanager.cpp
+// ============
+// manage the internal rendering resolution - dynamic scaling and upscaling
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ResolutionManager.h"
+
+#include <algorithm>
+#include <cmath>
+
+// declare the global variables
+namespace
+{
+	const char* g_SceneTextureName = "sceneTexture";
+	const char* g_RenderSizeName = "renderSize";
+	const char* g_TextureSizeName = "textureSize";
+
+	// range of the scale applied to the width and the height
+	const float MIN_SCALE = 0.5f;
+	const float MAX_SCALE = 1.0f;
+	// number of frame times averaged before the scale changes
+	const int ADJUST_INTERVAL_FRAMES = 8;
+	// the scale aims a little under the budget, and is left alone
+	// while the average stays between the two fractions of it
+	const double TARGET_FRACTION = 0.9;
+	const double LOWER_FRACTION = 0.75;
+	// part of the way to the wanted scale taken at each adjustment
+	const float SCALE_DAMPING = 0.5f;
+	// smallest increase of the scale that is applied
+	const float SCALE_STEP = 0.02f;
+	// budget used until another one is set, 60 frames per second
+	const double DEFAULT_BUDGET_MILLISECONDS = 16.6;
+}
+
+/***********************************************************
+ *  ResolutionManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ResolutionManager::ResolutionManager()
+{
+	m_framebuffer = 0;
+	m_colorTexture = 0;
+	m_depthRenderbuffer = 0;
+	m_width = 0;
+	m_height = 0;
+	m_pUpscaleShader = NULL;
+	m_fullscreenVAO = 0;
+	m_budgetMilliseconds = DEFAULT_BUDGET_MILLISECONDS;
+	m_scale = MAX_SCALE;
+	m_totalMilliseconds = 0.0;
+	m_frameCount = 0;
+	m_averageMilliseconds = 0.0;
+}
+
+/***********************************************************
+ *  ~ResolutionManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ResolutionManager::~ResolutionManager()
+{
+	DestroyTarget();
+
+	if (NULL != m_pUpscaleShader)
+	{
+		delete m_pUpscaleShader;
+		m_pUpscaleShader = NULL;
+	}
+}
+
+/***********************************************************
+ *  CreateTarget()
+ *
+ *  This method is used for creating the offscreen target
+ *  that the scene is drawn into.  It has the size of the
+ *  window, and the scene only uses the scaled corner of it.
+ ***********************************************************/
+bool ResolutionManager::CreateTarget(int width, int height)
+{
+	m_width = width;
+	m_height = height;
+
+	// the texture is created on the unit it is read from, so the
+	// scene textures stay bound
+	glActiveTexture(GL_TEXTURE0 + SCENE_TEXTURE_UNIT);
+	glGenTextures(1, &m_colorTexture);
+	glBindTexture(GL_TEXTURE_2D, m_colorTexture);
+	glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, width, height);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glActiveTexture(GL_TEXTURE0);
+
+	glGenRenderbuffers(1, &m_depthRenderbuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_depthRenderbuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glGenFramebuffers(1, &m_framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_colorTexture, 0);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthRenderbuffer);
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cout << "Resolution framebuffer is not complete, status:" << status << std::endl;
+		return false;
+	}
+
+	// core profile needs a vertex array bound even when no
+	// vertex attributes are read
+	glGenVertexArrays(1, &m_fullscreenVAO);
+
+	return true;
+}
+
+/***********************************************************
+ *  DestroyTarget()
+ *
+ *  This method is used for freeing the offscreen target.
+ ***********************************************************/
+void ResolutionManager::DestroyTarget()
+{
+	if (m_framebuffer != 0)
+	{
+		glDeleteFramebuffers(1, &m_framebuffer);
+		m_framebuffer = 0;
+	}
+	if (m_colorTexture != 0)
+	{
+		glDeleteTextures(1, &m_colorTexture);
+		m_colorTexture = 0;
+	}
+	if (m_depthRenderbuffer != 0)
+	{
+		glDeleteRenderbuffers(1, &m_depthRenderbuffer);
+		m_depthRenderbuffer = 0;
+	}
+	if (m_fullscreenVAO != 0)
+	{
+		glDeleteVertexArrays(1, &m_fullscreenVAO);
+		m_fullscreenVAO = 0;
+	}
+}
+
+/***********************************************************
+ *  LoadShaders()
+ *
+ *  This method is used for loading the shader that upscales
+ *  the scene into the window.
+ ***********************************************************/
+void ResolutionManager::LoadShaders()
+{
+	m_pUpscaleShader = new ShaderManager();
+	m_pUpscaleShader->LoadShaders(
+		"shaders/fullscreenVertexShader.glsl",
+		"shaders/upscaleFragmentShader.glsl");
+	m_pUpscaleShader->use();
+	m_pUpscaleShader->setSampler2DValue(g_SceneTextureName, SCENE_TEXTURE_UNIT);
+}
+
+/***********************************************************
+ *  SetBudget()
+ *
+ *  This method is used for setting the GPU frame time in
+ *  milliseconds that the scale aims for.
+ ***********************************************************/
+void ResolutionManager::SetBudget(double milliseconds)
+{
+	m_budgetMilliseconds = milliseconds;
+}
+
+/***********************************************************
+ *  AddFrameTime()
+ *
+ *  This method is used for adding a measured GPU frame time.
+ *  Every few frames the times are averaged, and since the
+ *  GPU time mostly follows the number of pixels drawn, the
+ *  scale that would reach the target is the current scale
+ *  times the square root of the target over the average.
+ *  The scale only moves part of the way there, and not at
+ *  all while the average is a little under the budget, so
+ *  it settles instead of hunting between two sizes.
+ ***********************************************************/
+bool ResolutionManager::AddFrameTime(double milliseconds)
+{
+	m_totalMilliseconds += milliseconds;
+	m_frameCount++;
+	if (m_frameCount < ADJUST_INTERVAL_FRAMES)
+	{
+		return false;
+	}
+
+	m_averageMilliseconds = m_totalMilliseconds / m_frameCount;
+	m_totalMilliseconds = 0.0;
+	m_frameCount = 0;
+
+	if ((m_averageMilliseconds > m_budgetMilliseconds) ||
+		(m_averageMilliseconds < m_budgetMilliseconds * LOWER_FRACTION))
+	{
+		double target = m_budgetMilliseconds * TARGET_FRACTION;
+		float wanted = m_scale * (float)std::sqrt(target / std::max(m_averageMilliseconds, 0.001));
+		float scale = m_scale + ((wanted - m_scale) * SCALE_DAMPING);
+		scale = std::min(std::max(scale, MIN_SCALE), MAX_SCALE);
+		// going over the budget is always corrected, while growing
+		// waits for a worthwhile step unless it reaches the top
+		if ((m_averageMilliseconds > m_budgetMilliseconds) ||
+			(scale - m_scale >= SCALE_STEP) || (scale == MAX_SCALE))
+		{
+			m_scale = scale;
+		}
+	}
+
+	return true;
+}
+
+/***********************************************************
+ *  GetScale()
+ *
+ *  This method is used for getting the current scale of the
+ *  width and the height.
+ ***********************************************************/
+float ResolutionManager::GetScale() const
+{
+	return(m_scale);
+}
+
+/***********************************************************
+ *  GetRenderWidth()
+ *
+ *  This method is used for getting the width in pixels that
+ *  the scene is drawn at.
+ ***********************************************************/
+int ResolutionManager::GetRenderWidth() const
+{
+	return(std::max(1, (int)(m_width * m_scale + 0.5f)));
+}
+
+/***********************************************************
+ *  GetRenderHeight()
+ *
+ *  This method is used for getting the height in pixels that
+ *  the scene is drawn at.
+ ***********************************************************/
+int ResolutionManager::GetRenderHeight() const
+{
+	return(std::max(1, (int)(m_height * m_scale + 0.5f)));
+}
+
+/***********************************************************
+ *  GetAverageMilliseconds()
+ *
+ *  This method is used for getting the average GPU frame
+ *  time that the last adjustment of the scale was based on.
+ ***********************************************************/
+double ResolutionManager::GetAverageMilliseconds() const
+{
+	return(m_averageMilliseconds);
+}
+
+/***********************************************************
+ *  BeginScene()
+ *
+ *  This method is used for drawing the scene into the scaled
+ *  corner of the offscreen target.  Clearing ignores the
+ *  viewport, so the whole target is still cleared.
+ ***********************************************************/
+void ResolutionManager::BeginScene()
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+	glViewport(0, 0, GetRenderWidth(), GetRenderHeight());
+}
+
+/***********************************************************
+ *  EndScene()
+ *
+ *  This method is used for upscaling the scaled corner of the
+ *  offscreen target into the whole window.
+ ***********************************************************/
+void ResolutionManager::EndScene()
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glViewport(0, 0, m_width, m_height);
+	glDisable(GL_DEPTH_TEST);
+
+	glActiveTexture(GL_TEXTURE0 + SCENE_TEXTURE_UNIT);
+	glBindTexture(GL_TEXTURE_2D, m_colorTexture);
+	glActiveTexture(GL_TEXTURE0);
+
+	m_pUpscaleShader->use();
+	m_pUpscaleShader->setVec2Value(g_RenderSizeName, glm::vec2((float)GetRenderWidth(), (float)GetRenderHeight()));
+	m_pUpscaleShader->setVec2Value(g_TextureSizeName, glm::vec2((float)m_width, (float)m_height));
+	glBindVertexArray(m_fullscreenVAO);
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+	glBindVertexArray(0);
+
+	glEnable(GL_DEPTH_TEST);
+}
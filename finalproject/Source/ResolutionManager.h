@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////////
+// resolutionmanager.h
+// ============
+// manage the internal rendering resolution - dynamic scaling and upscaling
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+
+/***********************************************************
+ *  ResolutionManager
+ *
+ *  This class contains the code for drawing the scene at a
+ *  lower internal resolution when the GPU cannot finish a
+ *  frame within its time budget.  The scene is drawn into
+ *  the lower left corner of a window sized offscreen target,
+ *  so changing the resolution never reallocates anything,
+ *  and a full screen pass upscales that corner into the
+ *  window with a Catmull-Rom filter.  The measured GPU frame
+ *  times are averaged over a few frames, and the scale is
+ *  moved toward the one that would meet the budget, assuming
+ *  the GPU time follows the number of pixels drawn.
+ ***********************************************************/
+class ResolutionManager
+{
+public:
+	// constructor
+	ResolutionManager();
+	// destructor
+	~ResolutionManager();
+
+	// texture unit used for reading the scaled scene
+	static const int SCENE_TEXTURE_UNIT = 30;
+
+private:
+	// offscreen target that the scaled scene is drawn into
+	GLuint m_framebuffer;
+	GLuint m_colorTexture;
+	GLuint m_depthRenderbuffer;
+	int m_width;
+	int m_height;
+	// shader that upscales the scene into the window
+	ShaderManager* m_pUpscaleShader;
+	// empty vertex array used for the full screen triangle
+	GLuint m_fullscreenVAO;
+	// GPU frame time in milliseconds that the scale aims for
+	double m_budgetMilliseconds;
+	// current scale of the width and the height
+	float m_scale;
+	// frame times collected since the last adjustment
+	double m_totalMilliseconds;
+	int m_frameCount;
+	// average frame time of the last adjustment
+	double m_averageMilliseconds;
+
+public:
+	// create the offscreen target at the window size
+	bool CreateTarget(int width, int height);
+	// free the offscreen target
+	void DestroyTarget();
+	// load the upscale shader
+	void LoadShaders();
+
+	// set the GPU frame time in milliseconds to aim for
+	void SetBudget(double milliseconds);
+	// add a measured GPU frame time, returns true when the average was
+	// taken and the scale adjusted to it
+	bool AddFrameTime(double milliseconds);
+
+	// get the current scale and the size the scene is drawn at
+	float GetScale() const;
+	int GetRenderWidth() const;
+	int GetRenderHeight() const;
+	// get the average frame time of the last adjustment
+	double GetAverageMilliseconds() const;
+
+	// draw the scene into the scaled corner of the offscreen target
+	void BeginScene();
+	// upscale the scene into the window
+	void EndScene();
+};
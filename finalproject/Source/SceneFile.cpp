@@ -0,0 +1,813 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenefile.cpp
+// ============
+// read and write text scene descriptions and watch their files for changes
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SceneFile.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+// declare the global variables
+namespace
+{
+	// bytes of the file read at a time, which is also the longest line
+	const size_t READ_BLOCK_SIZE = 64 * 1024;
+	// most words on one line
+	const int MAX_LINE_WORDS = 48;
+	// errors output for one file, the rest are only counted
+	const int MAX_REPORTED_ERRORS = 20;
+	// keyword of each mesh in the file, in the order of MESH_TYPE
+	const char* const MESH_NAMES[SceneFile::MESH_COUNT] =
+	{
+		"box",
+		"plane",
+		"cylinder",
+		"tapered_cylinder",
+		"sphere",
+		"torus"
+	};
+}
+
+/***********************************************************
+ *  SceneFile()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+SceneFile::SceneFile()
+{
+	m_lastWriteTime = 0;
+	m_lastFileSize = -1;
+	m_lineNumber = 0;
+	m_errorCount = 0;
+	m_lastLoadMilliseconds = 0.0;
+}
+
+/***********************************************************
+ *  ~SceneFile()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+SceneFile::~SceneFile()
+{
+}
+
+/***********************************************************
+ *  SplitWords()
+ *
+ *  This method is used for splitting a line into the words
+ *  between its spaces and tabs, ending each word in place.
+ *  Everything after a '#' is a comment.  It returns the
+ *  number of words, or one more than the most when the line
+ *  has too many.
+ ***********************************************************/
+int SceneFile::SplitWords(char* line, char* words[], int maxWords)
+{
+	int wordCount = 0;
+	char* pCurrent = line;
+
+	while (*pCurrent != '\0')
+	{
+		while ((*pCurrent == ' ') || (*pCurrent == '\t') || (*pCurrent == '\r'))
+		{
+			pCurrent++;
+		}
+		if ((*pCurrent == '\0') || (*pCurrent == '#'))
+		{
+			break;
+		}
+		if (wordCount == maxWords)
+		{
+			return(maxWords + 1);
+		}
+
+		words[wordCount++] = pCurrent;
+		while ((*pCurrent != '\0') && (*pCurrent != ' ') && (*pCurrent != '\t') &&
+			(*pCurrent != '\r') && (*pCurrent != '#'))
+		{
+			pCurrent++;
+		}
+		if (*pCurrent == '#')
+		{
+			*pCurrent = '\0';
+			break;
+		}
+		if (*pCurrent != '\0')
+		{
+			*pCurrent++ = '\0';
+		}
+	}
+
+	return(wordCount);
+}
+
+/***********************************************************
+ *  GetFileStamp()
+ *
+ *  This method is used for getting the modification time and
+ *  size of a file, which change when the file is written.
+ ***********************************************************/
+bool SceneFile::GetFileStamp(const char* filename, time_t& writeTime, long long& fileSize)
+{
+	struct stat status;
+	if (stat(filename, &status) != 0)
+	{
+		return(false);
+	}
+
+	writeTime = status.st_mtime;
+	fileSize = (long long)status.st_size;
+	return(true);
+}
+
+/***********************************************************
+ *  ReportError()
+ *
+ *  This method is used for counting an error on the current
+ *  line and outputting it with the word it was found at.
+ ***********************************************************/
+void SceneFile::ReportError(const char* message, const char* word)
+{
+	m_errorCount++;
+	if (m_errorCount <= MAX_REPORTED_ERRORS)
+	{
+		std::cout << "ERROR: " << m_filename << ":" << m_lineNumber << ": " << message;
+		if (NULL != word)
+		{
+			std::cout << " '" << word << "'";
+		}
+		std::cout << std::endl;
+	}
+}
+
+/***********************************************************
+ *  CopyName()
+ *
+ *  This method is used for copying a tag or name into its
+ *  fixed size buffer, reporting an error when it does not
+ *  fit.
+ ***********************************************************/
+bool SceneFile::CopyName(const char* name, char* destination, int destinationSize)
+{
+	size_t length = strlen(name);
+	if (length >= (size_t)destinationSize)
+	{
+		ReportError("name is too long", name);
+		return(false);
+	}
+
+	memcpy(destination, name, length + 1);
+	return(true);
+}
+
+/***********************************************************
+ *  ParseFloats()
+ *
+ *  This method is used for parsing the passed in number of
+ *  values from the words after a key, moving the index past
+ *  them.
+ ***********************************************************/
+bool SceneFile::ParseFloats(char* words[], int wordCount, int& index, float* values, int valueCount)
+{
+	if (index + valueCount > wordCount)
+	{
+		ReportError("missing values after", words[index - 1]);
+		return(false);
+	}
+
+	for (int i = 0; i < valueCount; i++)
+	{
+		char* pEnd = NULL;
+		values[i] = strtof(words[index], &pEnd);
+		if ((pEnd == words[index]) || (*pEnd != '\0'))
+		{
+			ReportError("expected a number at", words[index]);
+			return(false);
+		}
+		index++;
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  ParseVector()
+ *
+ *  This method is used for parsing the three values of a
+ *  position, rotation, scale or color after its key.
+ ***********************************************************/
+bool SceneFile::ParseVector(char* words[], int wordCount, int& index, glm::vec3& value)
+{
+	float values[3];
+	if (ParseFloats(words, wordCount, index, values, 3) == false)
+	{
+		return(false);
+	}
+
+	value = glm::vec3(values[0], values[1], values[2]);
+	return(true);
+}
+
+/***********************************************************
+ *  ParseTexture()
+ *
+ *  This method is used for parsing a texture record, which
+ *  names the image file of a texture tag.
+ ***********************************************************/
+void SceneFile::ParseTexture(char* words[], int wordCount, SCENE_DESC& scene)
+{
+	if (wordCount != 3)
+	{
+		ReportError("expected a tag and an image file after", words[0]);
+		return;
+	}
+	if (FindTexture(scene, words[1]) >= 0)
+	{
+		ReportError("texture is defined again", words[1]);
+		return;
+	}
+
+	TEXTURE_DESC texture;
+	if ((CopyName(words[1], texture.tag, MAX_NAME_LENGTH) == true) &&
+		(CopyName(words[2], texture.filename, MAX_PATH_LENGTH) == true))
+	{
+		scene.textures.push_back(texture);
+	}
+}
+
+/***********************************************************
+ *  ParseMaterial()
+ *
+ *  This method is used for parsing a material record.  The
+ *  values that are left out keep their defaults.
+ ***********************************************************/
+void SceneFile::ParseMaterial(char* words[], int wordCount, SCENE_DESC& scene)
+{
+	if (wordCount < 2)
+	{
+		ReportError("expected a tag after", words[0]);
+		return;
+	}
+	if (FindMaterial(scene, words[1]) >= 0)
+	{
+		ReportError("material is defined again", words[1]);
+		return;
+	}
+
+	MATERIAL_DESC material;
+	material.diffuseColor = glm::vec3(1.0f);
+	material.specularColor = glm::vec3(0.0f);
+	material.shininess = 32.0f;
+	material.opacity = 1.0f;
+	if (CopyName(words[1], material.tag, MAX_NAME_LENGTH) == false)
+	{
+		return;
+	}
+
+	int index = 2;
+	bool bValid = true;
+	while ((bValid == true) && (index < wordCount))
+	{
+		const char* key = words[index++];
+		if (strcmp(key, "diffuse") == 0)
+		{
+			bValid = ParseVector(words, wordCount, index, material.diffuseColor);
+		}
+		else if (strcmp(key, "specular") == 0)
+		{
+			bValid = ParseVector(words, wordCount, index, material.specularColor);
+		}
+		else if (strcmp(key, "shininess") == 0)
+		{
+			bValid = ParseFloats(words, wordCount, index, &material.shininess, 1);
+		}
+		else if (strcmp(key, "opacity") == 0)
+		{
+			bValid = ParseFloats(words, wordCount, index, &material.opacity, 1);
+		}
+		else
+		{
+			ReportError("unknown material key", key);
+			bValid = false;
+		}
+	}
+
+	if (bValid == true)
+	{
+		scene.materials.push_back(material);
+	}
+}
+
+/***********************************************************
+ *  ParseLight()
+ *
+ *  This method is used for parsing a directional or point
+ *  light record.  The values that are left out keep their
+ *  defaults, and the light only casts shadows and is only
+ *  baked when it is marked so.
+ ***********************************************************/
+void SceneFile::ParseLight(LIGHT_TYPE type, char* words[], int wordCount, SCENE_DESC& scene)
+{
+	LIGHT_DESC light;
+	light.type = type;
+	light.position = glm::vec3(0.0f);
+	light.direction = glm::vec3(0.0f, -1.0f, 0.0f);
+	light.ambient = glm::vec3(0.0f);
+	light.diffuse = glm::vec3(1.0f);
+	light.specular = glm::vec3(1.0f);
+	light.radius = 10.0f;
+	light.specularScale = 1.0f;
+	light.bShadows = false;
+	light.bBaked = false;
+
+	int index = 1;
+	bool bValid = true;
+	while ((bValid == true) && (index < wordCount))
+	{
+		const char* key = words[index++];
+		if ((type == LIGHT_DIRECTIONAL) && (strcmp(key, "direction") == 0))
+		{
+			bValid = ParseVector(words, wordCount, index, light.direction);
+		}
+		else if ((type == LIGHT_POINT) && (strcmp(key, "position") == 0))
+		{
+			bValid = ParseVector(words, wordCount, index, light.position);
+		}
+		else if ((type == LIGHT_POINT) && (strcmp(key, "radius") == 0))
+		{
+			bValid = ParseFloats(words, wordCount, index, &light.radius, 1);
+		}
+		else if (strcmp(key, "ambient") == 0)
+		{
+			bValid = ParseVector(words, wordCount, index, light.ambient);
+		}
+		else if (strcmp(key, "diffuse") == 0)
+		{
+			bValid = ParseVector(words, wordCount, index, light.diffuse);
+		}
+		else if (strcmp(key, "specular") == 0)
+		{
+			bValid = ParseVector(words, wordCount, index, light.specular);
+		}
+		else if (strcmp(key, "specular_scale") == 0)
+		{
+			bValid = ParseFloats(words, wordCount, index, &light.specularScale, 1);
+		}
+		else if (strcmp(key, "shadows") == 0)
+		{
+			light.bShadows = true;
+		}
+		else if (strcmp(key, "baked") == 0)
+		{
+			light.bBaked = true;
+		}
+		else
+		{
+			ReportError("unknown light key", key);
+			bValid = false;
+		}
+	}
+
+	// the shaders have a single directional light
+	if ((bValid == true) && (type == LIGHT_DIRECTIONAL))
+	{
+		for (size_t i = 0; i < scene.lights.size(); i++)
+		{
+			if (scene.lights[i].type == LIGHT_DIRECTIONAL)
+			{
+				ReportError("the scene already has a directional light", NULL);
+				bValid = false;
+				break;
+			}
+		}
+	}
+
+	if (bValid == true)
+	{
+		scene.lights.push_back(light);
+	}
+}
+
+/***********************************************************
+ *  ParseObject()
+ *
+ *  This method is used for parsing an object record.  Its
+ *  texture and material must have been defined on an
+ *  earlier line.
+ ***********************************************************/
+void SceneFile::ParseObject(char* words[], int wordCount, SCENE_DESC& scene)
+{
+	if (wordCount < 3)
+	{
+		ReportError("expected a name and a mesh after", words[0]);
+		return;
+	}
+
+	OBJECT_DESC object;
+	if (CopyName(words[1], object.name, MAX_NAME_LENGTH) == false)
+	{
+		return;
+	}
+	object.mesh = MESH_COUNT;
+	for (int i = 0; i < MESH_COUNT; i++)
+	{
+		if (strcmp(words[2], MESH_NAMES[i]) == 0)
+		{
+			object.mesh = (MESH_TYPE)i;
+			break;
+		}
+	}
+	if (object.mesh == MESH_COUNT)
+	{
+		ReportError("unknown mesh", words[2]);
+		return;
+	}
+	object.position = glm::vec3(0.0f);
+	object.rotationDegrees = glm::vec3(0.0f);
+	object.scale = glm::vec3(1.0f);
+	object.texture = -1;
+	object.material = -1;
+	object.shininess = -1.0f;
+	object.bDynamic = false;
+
+	int index = 3;
+	bool bValid = true;
+	while ((bValid == true) && (index < wordCount))
+	{
+		const char* key = words[index++];
+		if (strcmp(key, "position") == 0)
+		{
+			bValid = ParseVector(words, wordCount, index, object.position);
+		}
+		else if (strcmp(key, "rotation") == 0)
+		{
+			bValid = ParseVector(words, wordCount, index, object.rotationDegrees);
+		}
+		else if (strcmp(key, "scale") == 0)
+		{
+			bValid = ParseVector(words, wordCount, index, object.scale);
+		}
+		else if ((strcmp(key, "texture") == 0) && (index < wordCount))
+		{
+			object.texture = FindTexture(scene, words[index]);
+			if (object.texture < 0)
+			{
+				ReportError("unknown texture", words[index]);
+				bValid = false;
+			}
+			index++;
+		}
+		else if ((strcmp(key, "material") == 0) && (index < wordCount))
+		{
+			object.material = FindMaterial(scene, words[index]);
+			if (object.material < 0)
+			{
+				ReportError("unknown material", words[index]);
+				bValid = false;
+			}
+			index++;
+		}
+		else if (strcmp(key, "shininess") == 0)
+		{
+			bValid = ParseFloats(words, wordCount, index, &object.shininess, 1);
+		}
+		else if (strcmp(key, "dynamic") == 0)
+		{
+			object.bDynamic = true;
+		}
+		else
+		{
+			ReportError("unknown or incomplete object key", key);
+			bValid = false;
+		}
+	}
+
+	if (bValid == true)
+	{
+		scene.objects.push_back(object);
+	}
+}
+
+/***********************************************************
+ *  ParseLine()
+ *
+ *  This method is used for parsing one line of the file by
+ *  the keyword of its record.  Empty and comment lines are
+ *  skipped.
+ ***********************************************************/
+void SceneFile::ParseLine(char* line, SCENE_DESC& scene)
+{
+	char* words[MAX_LINE_WORDS];
+	int wordCount = SplitWords(line, words, MAX_LINE_WORDS);
+	if (wordCount == 0)
+	{
+		return;
+	}
+	if (wordCount > MAX_LINE_WORDS)
+	{
+		ReportError("too many words on the line", NULL);
+		return;
+	}
+
+	if (strcmp(words[0], "object") == 0)
+	{
+		ParseObject(words, wordCount, scene);
+	}
+	else if (strcmp(words[0], "material") == 0)
+	{
+		ParseMaterial(words, wordCount, scene);
+	}
+	else if (strcmp(words[0], "texture") == 0)
+	{
+		ParseTexture(words, wordCount, scene);
+	}
+	else if (strcmp(words[0], "point_light") == 0)
+	{
+		ParseLight(LIGHT_POINT, words, wordCount, scene);
+	}
+	else if (strcmp(words[0], "directional_light") == 0)
+	{
+		ParseLight(LIGHT_DIRECTIONAL, words, wordCount, scene);
+	}
+	else
+	{
+		ReportError("unknown record", words[0]);
+	}
+}
+
+/***********************************************************
+ *  Load()
+ *
+ *  This method is used for reading a scene file into the
+ *  passed in description.  The file is read a block at a
+ *  time, the complete lines of each block are parsed, and
+ *  the unfinished last line is moved to the front to be
+ *  completed by the next block.  The description keeps the
+ *  memory of its lists, so reading the file again into the
+ *  same description only allocates when the scene grows.
+ *  A file with errors is read to its end, so that all of
+ *  them are found, but it is not valid.
+ ***********************************************************/
+bool SceneFile::Load(const char* filename, SCENE_DESC& scene)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	scene.textures.clear();
+	scene.materials.clear();
+	scene.lights.clear();
+	scene.objects.clear();
+	m_filename = filename;
+	m_lineNumber = 0;
+	m_errorCount = 0;
+
+	// the stamp is taken before reading, so a write during the
+	// read is found as a change
+	if (GetFileStamp(filename, m_lastWriteTime, m_lastFileSize) == false)
+	{
+		m_lastFileSize = -1;
+	}
+	std::ifstream file(filename, std::ios::binary);
+	if (!file)
+	{
+		std::cout << "Could not load scene:" << filename << std::endl;
+		return(false);
+	}
+
+	// room for a terminator after the last line of the file
+	m_readBuffer.resize(READ_BLOCK_SIZE + 1);
+	char* pBlock = &m_readBuffer[0];
+	size_t carried = 0;
+	bool bEnd = false;
+	while (bEnd == false)
+	{
+		file.read(pBlock + carried, READ_BLOCK_SIZE - carried);
+		size_t readSize = (size_t)file.gcount();
+		bEnd = (carried + readSize < READ_BLOCK_SIZE);
+		char* pEnd = pBlock + carried + readSize;
+
+		char* pLine = pBlock;
+		char* pNewline = (char*)memchr(pLine, '\n', pEnd - pLine);
+		while (NULL != pNewline)
+		{
+			*pNewline = '\0';
+			m_lineNumber++;
+			ParseLine(pLine, scene);
+			pLine = pNewline + 1;
+			pNewline = (char*)memchr(pLine, '\n', pEnd - pLine);
+		}
+
+		carried = pEnd - pLine;
+		if ((bEnd == true) && (carried > 0))
+		{
+			// the last line of the file has no newline
+			pLine[carried] = '\0';
+			m_lineNumber++;
+			ParseLine(pLine, scene);
+		}
+		else if (carried == READ_BLOCK_SIZE)
+		{
+			m_lineNumber++;
+			ReportError("line is too long", NULL);
+			break;
+		}
+		else if (carried > 0)
+		{
+			memmove(pBlock, pLine, carried);
+		}
+	}
+
+	m_lastLoadMilliseconds = std::chrono::duration<double, std::milli>(
+		std::chrono::steady_clock::now() - start).count();
+
+	if (m_errorCount > 0)
+	{
+		std::cout << "ERROR: " << m_errorCount << " errors in scene:" << filename << std::endl;
+		return(false);
+	}
+	return(true);
+}
+
+/***********************************************************
+ *  Save()
+ *
+ *  This method is used for writing a description into a
+ *  scene file, textures and materials first.  The numbers
+ *  are written with enough digits to read back exactly, so
+ *  reading the file again changes nothing.
+ ***********************************************************/
+bool SceneFile::Save(const char* filename, const SCENE_DESC& scene)
+{
+	std::ofstream file(filename, std::ios::binary);
+	if (!file)
+	{
+		std::cout << "Could not write scene:" << filename << std::endl;
+		return(false);
+	}
+
+	char line[1024];
+	for (size_t i = 0; i < scene.textures.size(); i++)
+	{
+		const TEXTURE_DESC& texture = scene.textures[i];
+		int length = snprintf(line, sizeof(line), "texture %s %s\n", texture.tag, texture.filename);
+		file.write(line, length);
+	}
+	for (size_t i = 0; i < scene.materials.size(); i++)
+	{
+		const MATERIAL_DESC& material = scene.materials[i];
+		int length = snprintf(line, sizeof(line),
+			"material %s diffuse %.9g %.9g %.9g specular %.9g %.9g %.9g shininess %.9g opacity %.9g\n",
+			material.tag,
+			material.diffuseColor.x, material.diffuseColor.y, material.diffuseColor.z,
+			material.specularColor.x, material.specularColor.y, material.specularColor.z,
+			material.shininess, material.opacity);
+		file.write(line, length);
+	}
+	for (size_t i = 0; i < scene.lights.size(); i++)
+	{
+		const LIGHT_DESC& light = scene.lights[i];
+		int length = 0;
+		if (light.type == LIGHT_DIRECTIONAL)
+		{
+			length = snprintf(line, sizeof(line), "directional_light direction %.9g %.9g %.9g",
+				light.direction.x, light.direction.y, light.direction.z);
+		}
+		else
+		{
+			length = snprintf(line, sizeof(line), "point_light position %.9g %.9g %.9g radius %.9g",
+				light.position.x, light.position.y, light.position.z, light.radius);
+		}
+		length += snprintf(line + length, sizeof(line) - length,
+			" ambient %.9g %.9g %.9g diffuse %.9g %.9g %.9g specular %.9g %.9g %.9g specular_scale %.9g%s%s\n",
+			light.ambient.x, light.ambient.y, light.ambient.z,
+			light.diffuse.x, light.diffuse.y, light.diffuse.z,
+			light.specular.x, light.specular.y, light.specular.z,
+			light.specularScale,
+			(light.bShadows == true) ? " shadows" : "",
+			(light.bBaked == true) ? " baked" : "");
+		file.write(line, length);
+	}
+	for (size_t i = 0; i < scene.objects.size(); i++)
+	{
+		const OBJECT_DESC& object = scene.objects[i];
+		int length = snprintf(line, sizeof(line),
+			"object %s %s position %.9g %.9g %.9g rotation %.9g %.9g %.9g scale %.9g %.9g %.9g",
+			object.name, MESH_NAMES[object.mesh],
+			object.position.x, object.position.y, object.position.z,
+			object.rotationDegrees.x, object.rotationDegrees.y, object.rotationDegrees.z,
+			object.scale.x, object.scale.y, object.scale.z);
+		if (object.texture >= 0)
+		{
+			length += snprintf(line + length, sizeof(line) - length, " texture %s", scene.textures[object.texture].tag);
+		}
+		if (object.material >= 0)
+		{
+			length += snprintf(line + length, sizeof(line) - length, " material %s", scene.materials[object.material].tag);
+		}
+		length += snprintf(line + length, sizeof(line) - length, " shininess %.9g%s\n",
+			object.shininess, (object.bDynamic == true) ? " dynamic" : "");
+		file.write(line, length);
+	}
+
+	return(file.good());
+}
+
+/***********************************************************
+ *  HasFileChanged()
+ *
+ *  This method is used for checking whether the file was
+ *  written since it was last read, by its modification time
+ *  and size.  A file that cannot be found, like while it is
+ *  being replaced, has not changed yet.
+ ***********************************************************/
+bool SceneFile::HasFileChanged() const
+{
+	time_t writeTime = 0;
+	long long fileSize = 0;
+	if ((m_filename.empty() == true) ||
+		(GetFileStamp(m_filename.c_str(), writeTime, fileSize) == false))
+	{
+		return(false);
+	}
+
+	return((writeTime != m_lastWriteTime) || (fileSize != m_lastFileSize));
+}
+
+/***********************************************************
+ *  GetFilename()
+ *
+ *  This method is used for getting the file the scene was
+ *  last read from.
+ ***********************************************************/
+const char* SceneFile::GetFilename() const
+{
+	return(m_filename.c_str());
+}
+
+/***********************************************************
+ *  GetLastLoadMilliseconds()
+ *
+ *  This method is used for getting the CPU time of reading
+ *  and parsing the file the last time.
+ ***********************************************************/
+double SceneFile::GetLastLoadMilliseconds() const
+{
+	return(m_lastLoadMilliseconds);
+}
+
+/***********************************************************
+ *  FindTexture()
+ *
+ *  This method is used for getting the position of the
+ *  texture of the passed in tag in a description, or -1.
+ ***********************************************************/
+int SceneFile::FindTexture(const SCENE_DESC& scene, const char* tag)
+{
+	for (size_t i = 0; i < scene.textures.size(); i++)
+	{
+		if (strcmp(scene.textures[i].tag, tag) == 0)
+		{
+			return((int)i);
+		}
+	}
+	return(-1);
+}
+
+/***********************************************************
+ *  FindMaterial()
+ *
+ *  This method is used for getting the position of the
+ *  material of the passed in tag in a description, or -1.
+ ***********************************************************/
+int SceneFile::FindMaterial(const SCENE_DESC& scene, const char* tag)
+{
+	for (size_t i = 0; i < scene.materials.size(); i++)
+	{
+		if (strcmp(scene.materials[i].tag, tag) == 0)
+		{
+			return((int)i);
+		}
+	}
+	return(-1);
+}
+
+/***********************************************************
+ *  GetMeshName()
+ *
+ *  This method is used for getting the keyword of a mesh
+ *  in the file.
+ ***********************************************************/
+const char* SceneFile::GetMeshName(MESH_TYPE mesh)
+{
+	return(MESH_NAMES[mesh]);
+}
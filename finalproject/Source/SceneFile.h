@@ -0,0 +1,191 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenefile.h
+// ============
+// read and write text scene descriptions and watch their files for changes
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <ctime>
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  SceneFile
+ *
+ *  This class contains the code for reading a scene from a
+ *  text file, which describes its textures, materials,
+ *  lights and objects one record per line:
+ *
+ *    # comment
+ *    texture <tag> <image file>
+ *    material <tag> diffuse <r g b> specular <r g b>
+ *        shininess <s> [opacity <o>]
+ *    directional_light direction <x y z> ambient <r g b>
+ *        diffuse <r g b> specular <r g b> [shadows] [baked]
+ *    point_light position <x y z> radius <r> ambient <r g b>
+ *        diffuse <r g b> specular <r g b>
+ *        [specular_scale <s>] [shadows] [baked]
+ *    object <name> <box|plane|cylinder|tapered_cylinder|
+ *        sphere|torus> position <x y z> [rotation <x y z>]
+ *        [scale <x y z>] [texture <tag>] [material <tag>]
+ *        [shininess <s>] [dynamic]
+ *
+ *  The file is read a block at a time and each line is split
+ *  and parsed in place, so reading never holds the whole file
+ *  and allocates nothing per line.  Textures and materials
+ *  must come before the objects that use them, so an object
+ *  refers to them by their position in the description.  The
+ *  modification time and size of the file are kept from the
+ *  last read, for finding out when it was changed.
+ ***********************************************************/
+class SceneFile
+{
+public:
+	// constructor
+	SceneFile();
+	// destructor
+	~SceneFile();
+
+	// longest tag or object name, with its terminator
+	static const int MAX_NAME_LENGTH = 32;
+	// longest texture image path, with its terminator
+	static const int MAX_PATH_LENGTH = 260;
+
+	// basic meshes an object can be drawn with
+	enum MESH_TYPE
+	{
+		MESH_BOX,
+		MESH_PLANE,
+		MESH_CYLINDER,
+		MESH_TAPERED_CYLINDER,
+		MESH_SPHERE,
+		MESH_TORUS,
+		MESH_COUNT
+	};
+
+	enum LIGHT_TYPE
+	{
+		LIGHT_DIRECTIONAL,
+		LIGHT_POINT
+	};
+
+	struct TEXTURE_DESC
+	{
+		char tag[MAX_NAME_LENGTH];
+		char filename[MAX_PATH_LENGTH];
+	};
+
+	struct MATERIAL_DESC
+	{
+		char tag[MAX_NAME_LENGTH];
+		glm::vec3 diffuseColor;
+		glm::vec3 specularColor;
+		float shininess;
+		float opacity;
+	};
+
+	struct LIGHT_DESC
+	{
+		LIGHT_TYPE type;
+		// position of a point light, direction of a directional one
+		glm::vec3 position;
+		glm::vec3 direction;
+		glm::vec3 ambient;
+		glm::vec3 diffuse;
+		glm::vec3 specular;
+		// reach of a point light and the scale of its specular
+		// light in the light buffer
+		float radius;
+		float specularScale;
+		// true when the light casts shadows, and when its diffuse
+		// light is baked into the lightmaps
+		bool bShadows;
+		bool bBaked;
+	};
+
+	struct OBJECT_DESC
+	{
+		char name[MAX_NAME_LENGTH];
+		MESH_TYPE mesh;
+		glm::vec3 position;
+		glm::vec3 rotationDegrees;
+		glm::vec3 scale;
+		// positions of the texture and material in the description,
+		// -1 for none
+		int texture;
+		int material;
+		// below zero the shininess of the material is kept
+		float shininess;
+		// true when the object moves while the objects are animated
+		bool bDynamic;
+	};
+
+	// everything a scene file describes, in the order of the file
+	struct SCENE_DESC
+	{
+		std::vector<TEXTURE_DESC> textures;
+		std::vector<MATERIAL_DESC> materials;
+		std::vector<LIGHT_DESC> lights;
+		std::vector<OBJECT_DESC> objects;
+	};
+
+private:
+	// file the scene was last read from
+	std::string m_filename;
+	// modification time and size of the file when it was last read
+	time_t m_lastWriteTime;
+	long long m_lastFileSize;
+	// block of the file being read, with the unfinished line of the
+	// block before it at the front
+	std::vector<char> m_readBuffer;
+	// line being parsed and the errors found so far
+	int m_lineNumber;
+	int m_errorCount;
+	// CPU time of the last read
+	double m_lastLoadMilliseconds;
+
+	// parse one line of the file into the description
+	void ParseLine(char* line, SCENE_DESC& scene);
+	// parse each kind of record from its split words
+	void ParseTexture(char* words[], int wordCount, SCENE_DESC& scene);
+	void ParseMaterial(char* words[], int wordCount, SCENE_DESC& scene);
+	void ParseLight(LIGHT_TYPE type, char* words[], int wordCount, SCENE_DESC& scene);
+	void ParseObject(char* words[], int wordCount, SCENE_DESC& scene);
+	// parse the numbers after a key, false when any is missing
+	bool ParseFloats(char* words[], int wordCount, int& index, float* values, int valueCount);
+	bool ParseVector(char* words[], int wordCount, int& index, glm::vec3& value);
+	// copy a name into a fixed size buffer, false when it is too long
+	bool CopyName(const char* name, char* destination, int destinationSize);
+	// output an error for the current line
+	void ReportError(const char* message, const char* word);
+	// split a line into words in place
+	static int SplitWords(char* line, char* words[], int maxWords);
+	// get the modification time and size of a file
+	static bool GetFileStamp(const char* filename, time_t& writeTime, long long& fileSize);
+
+public:
+	// read a scene file into a description, which is emptied first,
+	// false when the file cannot be read or has errors
+	bool Load(const char* filename, SCENE_DESC& scene);
+	// write a description into a scene file that Load() reads back
+	// into the same values
+	static bool Save(const char* filename, const SCENE_DESC& scene);
+	// check whether the file was changed since it was last read
+	bool HasFileChanged() const;
+	// get the file the scene was last read from
+	const char* GetFilename() const;
+	// get the CPU time of the last read
+	double GetLastLoadMilliseconds() const;
+
+	// find a texture or material of a description by tag, or -1
+	static int FindTexture(const SCENE_DESC& scene, const char* tag);
+	static int FindMaterial(const SCENE_DESC& scene, const char* tag);
+	// get the keyword of a mesh in the file
+	static const char* GetMeshName(MESH_TYPE mesh);
+};
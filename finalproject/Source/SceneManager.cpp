@@ -1,814 +1,1675 @@
-///////////////////////////////////////////////////////////////////////////////
-// scenemanager.cpp
-// ============
-// manage the preparing and rendering of 3D scenes - textures, materials, lighting
-//
-//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
-//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
-///////////////////////////////////////////////////////////////////////////////
-
-#include "SceneManager.h"
-
-#ifndef STB_IMAGE_IMPLEMENTATION
-#define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
-#endif
-
-#include <glm/gtx/transform.hpp>
-
-// declare the global variables
-namespace
-{
-	const char* g_ModelName = "model";
-	const char* g_ColorValueName = "objectColor";
-	const char* g_TextureValueName = "objectTexture";
-	const char* g_UseTextureName = "bUseTexture";
-	const char* g_UseLightingName = "bUseLighting";
-}
-
-/***********************************************************
- *  SceneManager()
- *
- *  The constructor for the class
- ***********************************************************/
-SceneManager::SceneManager(ShaderManager *pShaderManager)
-{
-	m_pShaderManager = pShaderManager;
-	m_basicMeshes = new ShapeMeshes();
-
-	// initialize the texture collection
-	for (int i = 0; i < 16; i++)
-	{
-		m_textureIDs[i].tag = "/0";
-		m_textureIDs[i].ID = -1;
-	}
-	m_loadedTextures = 0;
-}
-
-/***********************************************************
- *  ~SceneManager()
- *
- *  The destructor for the class
- ***********************************************************/
-SceneManager::~SceneManager()
-{
-	// clear the allocated memory
-	m_pShaderManager = NULL;
-	delete m_basicMeshes;
-	m_basicMeshes = NULL;
-	// destroy the created OpenGL textures
-	DestroyGLTextures();
-}
-
-/***********************************************************
- *  CreateGLTexture()
- *
- *  This method is used for loading textures from image files,
- *  configuring the texture mapping parameters in OpenGL,
- *  generating the mipmaps, and loading the read texture into
- *  the next available texture slot in memory.
- ***********************************************************/
-bool SceneManager::CreateGLTexture(const char* filename, std::string tag)
-{
-	int width = 0;
-	int height = 0;
-	int colorChannels = 0;
-	GLuint textureID = 0;
-
-	// indicate to always flip images vertically when loaded
-	stbi_set_flip_vertically_on_load(true);
-
-	// try to parse the image data from the specified image file
-	unsigned char* image = stbi_load(
-		filename,
-		&width,
-		&height,
-		&colorChannels,
-		0);
-
-	// if the image was successfully read from the image file
-	if (image)
-	{
-		std::cout << "Successfully loaded image:" << filename << ", width:" << width << ", height:" << height << ", channels:" << colorChannels << std::endl;
-
-		glGenTextures(1, &textureID);
-		glBindTexture(GL_TEXTURE_2D, textureID);
-
-		// set the texture wrapping parameters
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		// set texture filtering parameters
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-		// if the loaded image is in RGB format
-		if (colorChannels == 3)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
-		// if the loaded image is in RGBA format - it supports transparency
-		else if (colorChannels == 4)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
-		else
-		{
-			std::cout << "Not implemented to handle image with " << colorChannels << " channels" << std::endl;
-			return false;
-		}
-
-		// generate the texture mipmaps for mapping textures to lower resolutions
-		glGenerateMipmap(GL_TEXTURE_2D);
-
-		// free the image data from local memory
-		stbi_image_free(image);
-		glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
-
-		// register the loaded texture and associate it with the special tag string
-		m_textureIDs[m_loadedTextures].ID = textureID;
-		m_textureIDs[m_loadedTextures].tag = tag;
-		m_loadedTextures++;
-
-		return true;
-	}
-
-	std::cout << "Could not load image:" << filename << std::endl;
-
-	// Error loading the image
-	return false;
-}
-
-/***********************************************************
- *  BindGLTextures()
- *
- *  This method is used for binding the loaded textures to
- *  OpenGL texture memory slots.  There are up to 16 slots.
- ***********************************************************/
-void SceneManager::BindGLTextures()
-{
-	for (int i = 0; i < m_loadedTextures; i++)
-	{
-		// bind textures on corresponding texture units
-		glActiveTexture(GL_TEXTURE0 + i);
-		glBindTexture(GL_TEXTURE_2D, m_textureIDs[i].ID);
-	}
-}
-
-
-
-/***********************************************************
- *  DestroyGLTextures()
- *
- *  This method is used for freeing the memory in all the
- *  used texture memory slots.
- ***********************************************************/
-void SceneManager::DestroyGLTextures()
-{
-	for (int i = 0; i < m_loadedTextures; i++)
-	{
-		glGenTextures(1, &m_textureIDs[i].ID);
-	}
-}
-
-/***********************************************************
- *  FindTextureID()
- *
- *  This method is used for getting an ID for the previously
- *  loaded texture bitmap associated with the passed in tag.
- ***********************************************************/
-int SceneManager::FindTextureID(std::string tag)
-{
-	int textureID = -1;
-	int index = 0;
-	bool bFound = false;
-
-	while ((index < m_loadedTextures) && (bFound == false))
-	{
-		if (m_textureIDs[index].tag.compare(tag) == 0)
-		{
-			textureID = m_textureIDs[index].ID;
-			bFound = true;
-		}
-		else
-			index++;
-	}
-
-	return(textureID);
-}
-
-/***********************************************************
- *  FindTextureSlot()
- *
- *  This method is used for getting a slot index for the previously
- *  loaded texture bitmap associated with the passed in tag.
- ***********************************************************/
-int SceneManager::FindTextureSlot(std::string tag)
-{
-	int textureSlot = -1;
-	int index = 0;
-	bool bFound = false;
-
-	while ((index < m_loadedTextures) && (bFound == false))
-	{
-		if (m_textureIDs[index].tag.compare(tag) == 0)
-		{
-			textureSlot = index;
-			bFound = true;
-		}
-		else
-			index++;
-	}
-
-	return(textureSlot);
-}
-
-/***********************************************************
- *  FindMaterial()
- *
- *  This method is used for getting a material from the previously
- *  defined materials list that is associated with the passed in tag.
- ***********************************************************/
-bool SceneManager::FindMaterial(std::string tag, OBJECT_MATERIAL& material)
-{
-	if (m_objectMaterials.size() == 0)
-	{
-		return(false);
-	}
-
-	int index = 0;
-	bool bFound = false;
-	while ((index < m_objectMaterials.size()) && (bFound == false))
-	{
-		if (m_objectMaterials[index].tag.compare(tag) == 0)
-		{
-			bFound = true;
-			material.diffuseColor = m_objectMaterials[index].diffuseColor;
-			material.specularColor = m_objectMaterials[index].specularColor;
-			material.shininess = m_objectMaterials[index].shininess;
-		}
-		else
-		{
-			index++;
-		}
-	}
-
-	return(true);
-}
-
-
-/***********************************************************
- *  SetTransformations()
- *
- *  This method is used for setting the transform buffer
- *  using the passed in transformation values.
- ***********************************************************/
-void SceneManager::SetTransformations(
-	glm::vec3 scaleXYZ,
-	float XrotationDegrees,
-	float YrotationDegrees,
-	float ZrotationDegrees,
-	glm::vec3 positionXYZ)
-{
-	// variables for this method
-	glm::mat4 modelView;
-	glm::mat4 scale;
-	glm::mat4 rotationX;
-	glm::mat4 rotationY;
-	glm::mat4 rotationZ;
-	glm::mat4 translation;
-
-	// set the scale value in the transform buffer
-	scale = glm::scale(scaleXYZ);
-	// set the rotation values in the transform buffer
-	rotationX = glm::rotate(glm::radians(XrotationDegrees), glm::vec3(1.0f, 0.0f, 0.0f));
-	rotationY = glm::rotate(glm::radians(YrotationDegrees), glm::vec3(0.0f, 1.0f, 0.0f));
-	rotationZ = glm::rotate(glm::radians(ZrotationDegrees), glm::vec3(0.0f, 0.0f, 1.0f));
-	// set the translation value in the transform buffer
-	translation = glm::translate(positionXYZ);
-
-	modelView = translation * rotationZ * rotationY * rotationX * scale;
-
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setMat4Value(g_ModelName, modelView);
-	}
-}
-
-/***********************************************************
- *  SetShaderColor()
- *
- *  This method is used for setting the passed in color
- *  into the shader for the next draw command
- ***********************************************************/
-void SceneManager::SetShaderColor(
-	float redColorValue,
-	float greenColorValue,
-	float blueColorValue,
-	float alphaValue)
-{
-	// variables for this method
-	glm::vec4 currentColor;
-
-	currentColor.r = redColorValue;
-	currentColor.g = greenColorValue;
-	currentColor.b = blueColorValue;
-	currentColor.a = alphaValue;
-
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setIntValue(g_UseTextureName, false);
-		m_pShaderManager->setVec4Value(g_ColorValueName, currentColor);
-	}
-}
-
-/***********************************************************
- *  SetShaderTexture()
- *
- *  This method is used for setting the texture data
- *  associated with the passed in ID into the shader.
- ***********************************************************/
-void SceneManager::SetShaderTexture(
-	std::string textureTag)
-{
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setIntValue(g_UseTextureName, true);
-
-		int textureID = -1;
-		textureID = FindTextureSlot(textureTag);
-		m_pShaderManager->setSampler2DValue(g_TextureValueName, textureID);
-	}
-}
-
-/***********************************************************
- *  SetTextureUVScale()
- *
- *  This method is used for setting the texture UV scale
- *  values into the shader.
- ***********************************************************/
-void SceneManager::SetTextureUVScale(float u, float v)
-{
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setVec2Value("UVscale", glm::vec2(u, v));
-	}
-}
-
-/***********************************************************
- *  SetShaderMaterial()
- *
- *  This method is used for passing the material values
- *  into the shader.
- ***********************************************************/
-void SceneManager::SetShaderMaterial(
-	std::string materialTag)
-{
-	if (m_objectMaterials.size() > 0)
-	{
-		OBJECT_MATERIAL material;
-		bool bReturn = false;
-
-		bReturn = FindMaterial(materialTag, material);
-		if (bReturn == true)
-		{
-			m_pShaderManager->setVec3Value("material.diffuseColor", material.diffuseColor);
-			m_pShaderManager->setVec3Value("material.specularColor", material.specularColor);
-			m_pShaderManager->setFloatValue("material.shininess", material.shininess);
-		}
-	}
-}
-
-/**************************************************************/
-/*** STUDENTS CAN MODIFY the code in the methods BELOW for  ***/
-/*** preparing and rendering their own 3D replicated scenes.***/
-/*** Please refer to the code in the OpenGL sample project  ***/
-/*** for assistance.                                        ***/
-/**************************************************************/
-
- /***********************************************************
-  *  LoadSceneTextures()
-  *
-  *  This method is used for preparing the 3D scene by loading
-  *  the shapes, textures in memory to support the 3D scene
-  *  rendering
-  ***********************************************************/
-void SceneManager::LoadSceneTextures()
-{
-	CreateGLTexture("textures/floor.jpg", "floor");
-	CreateGLTexture("textures/background.jpg", "background");
-	CreateGLTexture("textures/orange.jpg", "orange");
-	CreateGLTexture("textures/stem.jpg", "stem");
-	CreateGLTexture("textures/leaf.jpg", "leaf");
-	CreateGLTexture("textures/orangesticker.jpg", "orangesticker");
-	CreateGLTexture("textures/lighter.jpg", "lighter");
-	CreateGLTexture("textures/cup.jpg", "cup");
-	CreateGLTexture("textures/waterbottle.jpg", "waterbottle");
-	CreateGLTexture("textures/white.jpg", "white");
-	CreateGLTexture("textures/waterbottlecap.jpg", "thecap");
-	CreateGLTexture("textures/waterbottlelabel.jpg", "thelabel");
-	CreateGLTexture("textures/cuplabel.jpg", "cuplabel");
-	CreateGLTexture("textures/lightertop.jpg", "lightertop");
-	BindGLTextures();
-}
-/***********************************************************
- *  DefineObjectMaterials()
- *
- *  This method is used for configuring the various material
- *  settings for all of the objects within the 3D scene.
- ***********************************************************/
-void SceneManager::DefineObjectMaterials()
-{
-	// Enable blending for transparency
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-	// Wooden Floor
-	OBJECT_MATERIAL floors;
-	floors.diffuseColor = glm::vec3(0.6f, 0.4f, 0.2f); // Wood color
-	floors.specularColor = glm::vec3(0.2f, 0.1f, 0.0f); // Slight specular reflection
-	floors.shininess = 20.0; // Semi-glossy
-	floors.tag = "floors";
-	m_objectMaterials.push_back(floors);
-
-	// wall
-	OBJECT_MATERIAL whiteWallMaterial;
-	whiteWallMaterial.ambientColor = glm::vec3(1.0f, 1.0f, 1.0f);      // Pure white ambient color
-	whiteWallMaterial.ambientStrength = 0.5f;                          // Increased ambient strength for a brighter look
-	whiteWallMaterial.diffuseColor = glm::vec3(1.0f, 1.0f, 1.0f);      // Pure white diffuse color
-	whiteWallMaterial.specularColor = glm::vec3(1.0f, 1.0f, 1.0f);     // High specular reflection for a bright, reflective surface
-	whiteWallMaterial.shininess = 64.0f;                                // Increased shininess for a more polished look
-	whiteWallMaterial.tag = "wall";                                // Tag to identify the material
-	m_objectMaterials.push_back(whiteWallMaterial);                     // Add to materials list                    // Add to materials list
-
-
-	// Orange
-	OBJECT_MATERIAL oranges;
-	oranges.diffuseColor = glm::vec4(1.0f, 0.65f, 0.0f, 0.8f); // Bright orange with 20% transparency
-	oranges.specularColor = glm::vec3(0.0f, 0.0f, 0.0f); // Matte finish
-	oranges.shininess = 0.0; // Matte finish
-	oranges.tag = "oranges2";
-	m_objectMaterials.push_back(oranges);
-
-	// Leaf on Orange
-	OBJECT_MATERIAL leafs;
-	leafs.diffuseColor = glm::vec4(0.0f, 0.6f, 0.0f, 0.9f); // Leaf green with 10% transparency
-	leafs.specularColor = glm::vec3(0.0f, 0.2f, 0.0f); // Slight specular reflection
-	leafs.shininess = 10.0; // Slightly glossy
-	leafs.tag = "leafs";
-	m_objectMaterials.push_back(leafs);
-
-	// Stem on Orange
-	OBJECT_MATERIAL stems;
-	stems.diffuseColor = glm::vec4(0.3f, 0.2f, 0.1f, 1.0f); // Stem brown, opaque
-	stems.specularColor = glm::vec3(0.1f, 0.1f, 0.0f); // Slight specular reflection
-	stems.shininess = 10.0; // Slightly glossy
-	stems.tag = "stems";
-	m_objectMaterials.push_back(stems);
-
-	// Sticker on Orange
-	OBJECT_MATERIAL stickers;
-	stickers.diffuseColor = glm::vec4(1.0f, 1.0f, 1.0f, 0.6f); // White sticker with 40% transparency
-	stickers.specularColor = glm::vec3(0.0f, 0.0f, 0.0f); // Matte finish
-	stickers.shininess = 0.0; // Matte finish
-	stickers.tag = "stickers";
-	m_objectMaterials.push_back(stickers);
-
-	// Neon Green Lighter Plastic
-	OBJECT_MATERIAL lighters;
-	lighters.diffuseColor = glm::vec4(0.0f, 1.0f, 0.0f, 0.8f); // Neon green with 20% transparency
-	lighters.specularColor = glm::vec3(0.8f, 0.8f, 0.8f); // Shiny
-	lighters.shininess = 50.0; // Glossy
-	lighters.tag = "lighters";
-	m_objectMaterials.push_back(lighters);
-
-	// Ceramic Green Cup
-	OBJECT_MATERIAL cups;
-	cups.diffuseColor = glm::vec4(0.0f, 0.8f, 0.0f, 1.0f); // Green ceramic, opaque
-	cups.specularColor = glm::vec3(0.5f, 0.5f, 0.5f); // Slightly shiny
-	cups.shininess = 30.0; // Glossy
-	cups.tag = "cups";
-	m_objectMaterials.push_back(cups);
-
-	// Clear Plastic on Water Bottle
-	OBJECT_MATERIAL plastic;
-	plastic.diffuseColor = glm::vec4(1.0f, 1.0f, 1.0f, 0.9f); // Clear plastic with 10% transparency
-	plastic.specularColor = glm::vec3(1.0f, 1.0f, 1.0f); // Very shiny
-	plastic.shininess = 200.0f; // Very shiny surface
-	plastic.tag = "plastic";
-	m_objectMaterials.push_back(plastic);
-
-	OBJECT_MATERIAL woodMaterial;
-	woodMaterial.ambientColor = glm::vec3(0.4f, 0.3f, 0.1f);
-	woodMaterial.ambientStrength = 0.2f;
-	woodMaterial.diffuseColor = glm::vec3(0.3f, 0.2f, 0.1f);
-	woodMaterial.specularColor = glm::vec3(0.1f, 0.1f, 0.1f);
-	woodMaterial.shininess = 0.3;
-	woodMaterial.tag = "wood";
-	m_objectMaterials.push_back(woodMaterial);
-
-	OBJECT_MATERIAL redMaterial;
-	redMaterial.ambientColor = glm::vec3(1.0f, 0.0f, 0.0f); // Bright red ambient color
-	redMaterial.ambientStrength = 0.8f; // Strong ambient light
-	redMaterial.diffuseColor = glm::vec3(1.0f, 0.1f, 0.1f); // Very bright red diffuse color
-	redMaterial.specularColor = glm::vec3(1.0f, 0.0f, 0.0f); // Red specular highlights
-	redMaterial.shininess = 0.05f; // Low shininess for a rough look
-	redMaterial.tag = "red";
-	m_objectMaterials.push_back(redMaterial);
-
-	
-
-
-}
-
-/***********************************************************
- *  SetupSceneLights()
- *
- *  This method is called to add and configure the light
- *  sources for the 3D scene.  There are up to 4 light sources.
- ***********************************************************/
-void SceneManager::SetupSceneLights()
-{
-	// Enable lighting
-	m_pShaderManager->setBoolValue(g_UseLightingName, true);
-
-	// Directional light to emulate sunlight coming from the right side
-	m_pShaderManager->setVec3Value("directionalLight.direction", -1.0f, -0.2f, 0.0f); // Adjust direction to come from the right
-	m_pShaderManager->setVec3Value("directionalLight.ambient", 0.2f, 0.2f, 0.2f); // Brighter ambient light
-	m_pShaderManager->setVec3Value("directionalLight.diffuse", 1.0f, 1.0f, 1.0f); // Bright diffuse light
-	m_pShaderManager->setVec3Value("directionalLight.specular", 0.5f, 0.5f, 0.5f); // Increased specular reflection
-	m_pShaderManager->setBoolValue("directionalLight.bActive", true);
-
-	// Point light 1
-	m_pShaderManager->setVec3Value("pointLights[0].position", -4.0f, 8.0f, 0.0f); // Position on the left
-	m_pShaderManager->setVec3Value("pointLights[0].ambient", 0.1f, 0.1f, 0.1f); // Slightly brighter ambient light
-	m_pShaderManager->setVec3Value("pointLights[0].diffuse", 0.6f, 0.6f, 0.6f); // Brighter diffuse light
-	m_pShaderManager->setVec3Value("pointLights[0].specular", 0.3f, 0.3f, 0.3f); // Increased specular reflection
-	m_pShaderManager->setBoolValue("pointLights[0].bActive", true);
-
-	// Point light 2
-	m_pShaderManager->setVec3Value("pointLights[1].position", 4.0f, 8.0f, 0.0f); // Position on the right
-	m_pShaderManager->setVec3Value("pointLights[1].ambient", 0.2f, 0.2f, 0.2f); // Brighter ambient light on the right side
-	m_pShaderManager->setVec3Value("pointLights[1].diffuse", 1.0f, 1.0f, 1.0f); // Bright diffuse light
-	m_pShaderManager->setVec3Value("pointLights[1].specular", 0.5f, 0.5f, 0.5f); // Increased specular reflection
-	m_pShaderManager->setBoolValue("pointLights[1].bActive", true);
-
-}
-
-
-
-/***********************************************************
- *  PrepareScene()
- *
- *  This method is used for preparing the 3D scene by loading
- *  the shapes, textures in memory to support the 3D scene
- *  rendering
- ***********************************************************/
-void SceneManager::PrepareScene()
-{
-	// load the textures for the 3D scene
-	LoadSceneTextures();
-	// in the 3D scene
-	DefineObjectMaterials();
-	// add and defile the light sources for the 3D scene
-	SetupSceneLights();
-
-	// only one instance of a particular mesh needs to be
-	// loaded in memory no matter how many times it is drawn
-	// in the rendered 3D scene
-
-	m_basicMeshes->LoadBoxMesh();
-	m_basicMeshes->LoadPlaneMesh();
-	m_basicMeshes->LoadCylinderMesh();
-	m_basicMeshes->LoadConeMesh();
-	m_basicMeshes->LoadPrismMesh();
-	m_basicMeshes->LoadPyramid4Mesh();
-	m_basicMeshes->LoadSphereMesh();
-	m_basicMeshes->LoadTaperedCylinderMesh();
-	m_basicMeshes->LoadTorusMesh();
-}
-
-/***********************************************************
- *  RenderScene()
- *
- *  This method is used for rendering the 3D scene by
- *  transforming and drawing the basic 3D shapes
- ***********************************************************/
-void SceneManager::RenderScene()
-{
-	// Declare the variables for the transformations
-	glm::vec3 scaleXYZ;          // Vector to store scale factors along X, Y, Z axes
-	float XrotationDegrees = 0.0f; // Rotation angle around the X axis in degrees
-	float YrotationDegrees = 0.0f; // Rotation angle around the Y axis in degrees
-	float ZrotationDegrees = 0.0f; // Rotation angle around the Z axis in degrees
-	glm::vec3 positionXYZ;       // Vector to store position coordinates in X, Y, Z axes
-
-	// Render the floor
-		glm::vec3 floorScale = glm::vec3(20.0f, 1.0f, 10.0f);   // Scale factors for X, Y, Z
-	glm::vec3 floorPosition = glm::vec3(0.0f, 0.0f, 0.0f);   // Position at the origin
-	SetTransformations(floorScale, 0.0f, 0.0f, 0.0f, floorPosition);
-	SetShaderMaterial("wood");
-	SetShaderTexture("floor");
-	m_pShaderManager->setVec3Value("material.ambient", glm::vec3(1.0f, 1.0f, 1.0f));   // White ambient color
-	m_pShaderManager->setVec3Value("material.diffuse", glm::vec3(1.0f, 1.0f, 1.0f));   // White diffuse color
-	m_pShaderManager->setVec3Value("material.specular", glm::vec3(1.0f, 1.0f, 1.0f));  // White specular color
-	m_pShaderManager->setFloatValue("material.shininess", 32.0f);                       // Shininess
-	m_basicMeshes->DrawPlaneMesh();
-
-	// Render the Background
-	scaleXYZ = glm::vec3(20.0f, 1.0f, 10.0f);   // Set scale factors for X, Y, Z
-	XrotationDegrees = 90.0f;                   // Rotate 90 degrees around X axis
-	YrotationDegrees = 0.0f;                    // No rotation around Y axis
-	ZrotationDegrees = 0.0f;                    // No rotation around Z axis
-	positionXYZ = glm::vec3(0.0f, 9.0f, -10.0f); // Position in the scene
-	SetTransformations(scaleXYZ, XrotationDegrees, YrotationDegrees, ZrotationDegrees, positionXYZ);
-	SetShaderTexture("background"); 
-	SetShaderMaterial("wood");// Set texture for the background
-	m_pShaderManager->setVec3Value("material.ambient", glm::vec3(1.0f, 1.0f, 1.0f));   // White ambient color
-	m_pShaderManager->setVec3Value("material.diffuse", glm::vec3(1.0f, 1.0f, 1.0f));   // White diffuse color
-	m_pShaderManager->setVec3Value("material.specular", glm::vec3(1.0f, 1.0f, 1.0f));  // White specular color
-	m_pShaderManager->setFloatValue("material.shininess", 32.0f);                       // Shininess
-	m_basicMeshes->DrawPlaneMesh();             // Draw the vertical plane mesh                
-
-	// Orange
-	scaleXYZ = glm::vec3(2.0f, 2.0f, 2.0f);     // Set scale factors for X, Y, Z (two times smaller)
-	XrotationDegrees = 0.0f;                    // No rotation around X axis
-	YrotationDegrees = 0.0f;                    // No rotation around Y axis
-	ZrotationDegrees = 0.0f;                    // No rotation around Z axis
-	positionXYZ = glm::vec3(5.0f, 1.75f, -3.0f); // Position in the scene
-	SetTransformations(scaleXYZ, XrotationDegrees, YrotationDegrees, ZrotationDegrees, positionXYZ);
-	SetShaderTexture("orange");
-	SetShaderMaterial("oranges2");// Set texture for the orange
-	m_pShaderManager->setVec3Value("material.ambient", glm::vec3(0.9f, 0.4f, 0.0f));   // Set orange ambient color
-	m_pShaderManager->setVec3Value("material.diffuse", glm::vec3(0.9f, 0.4f, 0.0f));   // Set orange diffuse color
-	m_pShaderManager->setVec3Value("material.specular", glm::vec3(0.2f, 0.2f, 0.2f));  // Set low specular for matte look
-	m_pShaderManager->setFloatValue("material.shininess", 16.0f);                      // Set orange shininess
-	m_basicMeshes->DrawSphereMesh();            // Draw the orange (sphere mesh)
-
-	// Leaf on orange
-	scaleXYZ = glm::vec3(.2f, 0.2f, 0.6f);     // Set scale factors for X, Y, Z (make leaf more prominent)
-	XrotationDegrees = 45.0f;                   // Rotate 45 degrees around X axis
-	YrotationDegrees = 0.0f;                    // No rotation around Y axis
-	ZrotationDegrees = 0.0f;                    // No rotation around Z axis
-	positionXYZ = glm::vec3(5.0f, 4.25f, -3.0f); // Position on top of the orange
-	SetTransformations(scaleXYZ, XrotationDegrees, YrotationDegrees, ZrotationDegrees, positionXYZ);
-	SetShaderTexture("leaf"); 
-	SetShaderMaterial("leafs");// Set texture for the leaf
-	m_pShaderManager->setVec3Value("material.ambient", glm::vec3(0.0f, 0.5f, 0.0f));   // Set leaf ambient color
-	m_pShaderManager->setVec3Value("material.diffuse", glm::vec3(0.0f, 0.8f, 0.0f));   // Set leaf diffuse color
-	m_pShaderManager->setVec3Value("material.specular", glm::vec3(0.1f, 0.1f, 0.1f));  // Set low specular for leaf
-	m_pShaderManager->setFloatValue("material.shininess", 16.0f);                      // Set leaf shininess
-	m_basicMeshes->DrawBoxMesh();               // Draw the leaf (box mesh)
-
-	// Stem on orange
-	scaleXYZ = glm::vec3(0.1f, 0.5f, 0.2f);     // Set scale factors for X, Y, Z (adjusted for smaller and more realistic stem)
-	XrotationDegrees = 0.0f;                    // No rotation around X axis
-	YrotationDegrees = 0.0f;                    // No rotation around Y axis
-	ZrotationDegrees = 0.0f;                    // No rotation around Z axis
-	positionXYZ = glm::vec3(5.0f, 3.75f, -3.0f); // Position on top of the orange
-	SetTransformations(scaleXYZ, XrotationDegrees, YrotationDegrees, ZrotationDegrees, positionXYZ);
-	SetShaderTexture("stem");
-	SetShaderMaterial("stems"); // Set texture for the stem
-	m_pShaderManager->setVec3Value("material.ambient", glm::vec3(0.3f, 0.2f, 0.1f));   // Set stem ambient color
-	m_pShaderManager->setVec3Value("material.diffuse", glm::vec3(0.4f, 0.3f, 0.2f));   // Set stem diffuse color
-	m_pShaderManager->setVec3Value("material.specular", glm::vec3(0.1f, 0.1f, 0.1f));  // Set low specular for stem
-	m_pShaderManager->setFloatValue("material.shininess", 16.0f);                      // Set stem shininess
-	m_basicMeshes->DrawCylinderMesh();          // Draw the stem (cylinder mesh)
-
-	// Sticker on orange
-	scaleXYZ = glm::vec3(0.5f, 0.5f, 0.01f);    // Set scale factors for X, Y, Z (make it small and thin)
-	XrotationDegrees = 0.0f;                    // No rotation around X axis
-	YrotationDegrees = 0.0f;                    // No rotation around Y axis
-	ZrotationDegrees = 0.0f;                    // No rotation around Z axis
-	positionXYZ = glm::vec3(5.0f, 2.01f, -3.0f); // Position on top of the orange
-	SetTransformations(scaleXYZ, XrotationDegrees, YrotationDegrees, ZrotationDegrees, positionXYZ);
-	SetShaderTexture("sticker");
-	SetShaderMaterial("stickers"); // Set texture for the sticker
-	m_pShaderManager->setVec3Value("material.ambient", glm::vec3(1.0f, 1.0f, 1.0f));   // Set sticker ambient color
-	m_pShaderManager->setVec3Value("material.diffuse", glm::vec3(1.0f, 1.0f, 1.0f));   // Set sticker diffuse color
-	m_pShaderManager->setVec3Value("material.specular", glm::vec3(0.1f, 0.1f, 0.1f));  // Set low specular for sticker
-	m_pShaderManager->setFloatValue("material.shininess", 16.0f);                      // Set sticker shininess
-	m_basicMeshes->DrawCylinderMesh();          // Draw the sticker (cylinder mesh)
-
-	// Lime green lighter 
-	scaleXYZ = glm::vec3(0.5f, 0.50f, 1.50f);     // Set scale factors for X, Y, Z (adjusted for cylindrical shape)
-	XrotationDegrees = 0.0f;                    // No rotation around X axis
-	YrotationDegrees = 0.0f;                    // No rotation around Y axis
-	ZrotationDegrees = 90.0f;                   // Rotate 90 degrees around Z axis to lay flat
-	positionXYZ = glm::vec3(10.0f, 0.28f, -3.0f); // New position of the lighter (swapped with water bottle)
-	SetTransformations(scaleXYZ, XrotationDegrees, YrotationDegrees, ZrotationDegrees, positionXYZ);
-	SetShaderTexture("lighter");
-	SetShaderMaterial("lighters"); // Set texture for the lighter
-	m_pShaderManager->setVec3Value("material.ambient", glm::vec3(0.7f, 1.0f, 0.7f));   // Set lighter ambient color
-	m_pShaderManager->setVec3Value("material.diffuse", glm::vec3(0.8f, 1.0f, 0.8f));   // Set lighter diffuse color
-	m_pShaderManager->setVec3Value("material.specular", glm::vec3(0.9f, 0.9f, 0.9f));  // Set high specular for shininess
-	m_pShaderManager->setFloatValue("material.shininess", 128.0f);                     // Set lighter shininess
-	m_basicMeshes->DrawCylinderMesh();          // Draw the lighter (cylinder mesh)
-	
-	// Create a white bottom piece for the lighter
-	glm::vec3 whiteBottomScale = glm::vec3(0.5f, 0.5f, 0.4f); // Thinner and shorter cylinder for the bottom
-	XrotationDegrees = 0.0f;                    // No rotation around X axis
-	YrotationDegrees = 0.0f;                    // No rotation around Y axis
-	ZrotationDegrees = 90.0f; 
-	glm::vec3 whiteBottomPosition = glm::vec3(10.0f, 0.20f, -2.0f);
-	SetTransformations(whiteBottomScale, XrotationDegrees, YrotationDegrees, ZrotationDegrees, whiteBottomPosition);                 
-	SetShaderTexture("white"); // Ensure this texture is specifically for the white bottom
-	m_basicMeshes->DrawCylinderMesh();             // Set shininess
- 
-	// Render a small red box
-	glm::vec3 redBoxScale = glm::vec3(0.40f, 0.5f, 0.70f); // Thicker box // Thicker and shorter box dimensions
-	XrotationDegrees = 0.0f;                         // No rotation around X axis
-	YrotationDegrees = 0.0f;                         // No rotation around Y axis
-	ZrotationDegrees = 0.0f;                         // No rotation around Z axis
-	glm::vec3 redBoxPosition = glm::vec3(9.65f, 0.38f, -3.90f); // Position in the scene
-	SetTransformations(redBoxScale, XrotationDegrees, YrotationDegrees, ZrotationDegrees, redBoxPosition);
-	SetShaderTexture("lightertop");
-	SetShaderMaterial("red"); // Set texture for the lighter
-	m_pShaderManager->setVec4Value("color", glm::vec4(1.0f, 0.0f, 0.0f, 1.0f)); // Bright red color
-	m_pShaderManager->setVec3Value("specularColor", glm::vec3(1.0f, 1.0f, 1.0f)); // Shiny specular color
-	m_basicMeshes->DrawBoxMesh(); // Draw the box
-
-	// Green ceramic cup
-	scaleXYZ = glm::vec3(2.0f, 3.75f, 1.0f);     // Set scale factors for X, Y, Z
-	XrotationDegrees = 0.0f;                    // No rotation around X axis
-	YrotationDegrees = 0.0f;                    // No rotation around Y axis
-	ZrotationDegrees = 0.0f;                    // No rotation around Z axis
-	positionXYZ = glm::vec3(-9.0f, -1.0f, -3.0f); // Position of the cup
-	SetTransformations(scaleXYZ, XrotationDegrees, YrotationDegrees, ZrotationDegrees, positionXYZ);
-	SetShaderTexture("cup");
-	SetShaderMaterial("cups");                  // Set texture for the cup
-	m_pShaderManager->setVec3Value("material.ambient", glm::vec3(0.0f, 0.5f, 0.0f));   // Set cup ambient color
-	m_pShaderManager->setVec3Value("material.diffuse", glm::vec3(0.1f, 0.8f, 0.1f));   // Set cup diffuse color
-	m_pShaderManager->setVec3Value("material.specular", glm::vec3(0.6f, 0.6f, 0.6f));  // Set cup specular for glossiness
-	m_pShaderManager->setFloatValue("material.shininess", 128.0f);                     // Set cup shininess
-	m_basicMeshes->DrawCylinderMesh();          // Draw the cup (cylinder mesh)
-
-	// Cup handle
-	glm::vec3 handleScale = glm::vec3(0.80f, 1.20f, 0.2f); // Adjust to match the cup size and desired handle thickness
-    glm::vec3 handlePosition = glm::vec3(-10.50f, 1.50f, -2.25f); // Adjust X to move it beside the cup
-	SetTransformations(handleScale, 0.0f, 0.0f, 90.0f, handlePosition); // Rotate to align with the cup
-	m_pShaderManager->setVec3Value("material.ambient", glm::vec3(0.3f, 0.6f, 0.3f));   // Green ambient color
-	m_pShaderManager->setVec3Value("material.diffuse", glm::vec3(0.4f, 0.8f, 0.4f));   // Green diffuse color
-	m_pShaderManager->setVec3Value("material.specular", glm::vec3(0.6f, 0.9f, 0.6f));  // Green specular color
-	m_pShaderManager->setFloatValue("material.shininess", 64.0f);                     // Adjust shininess
-	m_basicMeshes->DrawTorusMesh(); // Draw the handle
-
-	// label on cup
-	glm::vec3 labelScale = glm::vec3(0.80f, 0.50f, 01.0f); // Adjust X and Z to match desired size, Y for flatness
-	glm::vec3 labelPosition = glm::vec3(-8.25f, 1.25f, -1.5f); // Position to align with the side of the cup
-	SetTransformations(labelScale, 90.0f, 0.0f, 0.0f, labelPosition); // Rotate around Y-axis to align with the cup's side
-	SetShaderTexture("cuplabel");
-	m_pShaderManager->setVec3Value("material.ambient", glm::vec3(1.0f, 1.0f, 1.0f));   // White ambient color
-	m_pShaderManager->setVec3Value("material.diffuse", glm::vec3(1.0f, 1.0f, 1.0f));   // White diffuse color
-	m_pShaderManager->setVec3Value("material.specular", glm::vec3(1.0f, 1.0f, 1.0f));  // White specular color
-	m_pShaderManager->setFloatValue("material.shininess", 32.0f);                     // Adjust shininess
-	m_basicMeshes->DrawTaperedCylinderMesh(); // Draw the flat circular label
-
-	// Water bottle
-	scaleXYZ = glm::vec3(1.0f, 6.0f, 0.50f);     // Set scale factors for X, Y, Z (adjusted for bottle shape)
-	// Adjust width to match sphere's diameter
-	XrotationDegrees = 0.0f;                    // No rotation around X axis
-	YrotationDegrees = 0.0f;                    // No rotation around Y axis
-	ZrotationDegrees = 0.0f;                    // No rotation around Z axis
-	positionXYZ = glm::vec3(-2.0f, -1.25f, -3.0f); // Position of the water bottle
-	SetTransformations(scaleXYZ, XrotationDegrees, YrotationDegrees, ZrotationDegrees, positionXYZ);
-	SetShaderTexture("waterbottle");
-	SetShaderMaterial("plastic"); // Set texture for the water bottle
-	m_basicMeshes->DrawCylinderMesh();          // Draw the water bottle (cylinder mesh)
-
-	// Round top on waterbottle
-	glm::vec3 domeScale = glm::vec3(1.0f, 0.75f, 0.5f); // Scale Z-axis to create a dome effect
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	glm::vec3 domePosition = glm::vec3(-2.0f, -1.25f + 6.0f, -3.0f); // Position to align with the water bottle
-	SetTransformations(domeScale, XrotationDegrees, YrotationDegrees, ZrotationDegrees, domePosition);
-	m_pShaderManager->setVec3Value("material.ambient", glm::vec3(1.0f, 1.0f, 1.0f));   // White ambient color
-	m_pShaderManager->setVec3Value("material.diffuse", glm::vec3(1.0f, 1.0f, 1.0f));   // White diffuse color
-	m_pShaderManager->setVec3Value("material.specular", glm::vec3(1.0f, 1.0f, 1.0f));  // White specular color
-	m_pShaderManager->setFloatValue("material.shininess", 32.0f);                     // Adjust shininess
-	m_basicMeshes->DrawSphereMesh();
-
-	//water bottle cap
-	glm::vec3 capScale = glm::vec3(0.4f, 0.4f, 0.05f); // Small, thin cylinder for the cap
-	XrotationDegrees = 0.0f;  // No rotation around X axis
-	YrotationDegrees = 0.0f;  // No rotation around Y axis
-	ZrotationDegrees = 0.0f;  // No rotation around Z axis
-	glm::vec3 capPosition = glm::vec3(-2.0f, -1.25f + 6.0f + 0.75f, -3.0f); // Position to sit on top of the water bottle and move up
-	SetTransformations(capScale, XrotationDegrees, YrotationDegrees, ZrotationDegrees, capPosition);
-	SetShaderTexture("thecap"); // Set the texture for the cap (assuming it's white)
-	SetShaderMaterial("plastic"); // Ensure the material is set if needed
-	m_pShaderManager->setVec3Value("material.ambient", glm::vec3(1.0f, 1.0f, 1.0f));   // White ambient color
-	m_pShaderManager->setVec3Value("material.diffuse", glm::vec3(1.0f, 1.0f, 1.0f));   // White diffuse color
-	m_pShaderManager->setVec3Value("material.specular", glm::vec3(1.0f, 1.0f, 1.0f));  // White specular color
-	m_pShaderManager->setFloatValue("material.shininess", 32.0f);                     // Adjust shininess
-	m_basicMeshes->DrawCylinderMesh();  // Draw the cap using the cylinder mesh
-
-	//waterbottle label
-	glm::vec3 boxScale = glm::vec3 (2.0f, 1.60f, 0.1f); // Width matches the bottle, height is appropriate for a label
-	glm::vec3 boxPosition = glm::vec3(-2.0f + 0.20f, -2.25f + 3.0f + 2.0f, -2.50f); // Adjust X to move right
-	SetTransformations(boxScale, 0.0f, 0.0f, 0.0f, boxPosition);
-	SetShaderTexture("thelabel"); // Ensure "thelabel" texture is loaded and applied
-	m_pShaderManager->setVec3Value("material.ambient", glm::vec3(1.0f, 1.0f, 1.0f));   // White ambient color
-	m_pShaderManager->setVec3Value("material.diffuse", glm::vec3(1.0f, 1.0f, 1.0f));   // White diffuse color
-	m_pShaderManager->setVec3Value("material.specular", glm::vec3(1.0f, 1.0f, 1.0f));  // White specular color
-	m_pShaderManager->setFloatValue("material.shininess", 32.0f);                     // Adjust shininess
-	m_basicMeshes->DrawBoxMesh();
-
-}
-
+///////////////////////////////////////////////////////////////////////////////
+// scenemanager.cpp
+// ============
+// manage the preparing and rendering of 3D scenes - textures, materials, lighting
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SceneManager.h"
+#include "ShadowManager.h"
+#include "LightmapManager.h"
+#include "JobSystem.h"
+#include "AllocationTracker.h"
+
+#ifndef STB_IMAGE_IMPLEMENTATION
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#endif
+
+#include <glm/gtx/transform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <random>
+
+// declare the global variables
+namespace
+{
+	const char* g_ModelName = "model";
+	const char* g_ColorValueName = "objectColor";
+	const char* g_TextureValueName = "objectTexture";
+	const char* g_UseTextureName = "bUseTexture";
+	const char* g_UseLightingName = "bUseLighting";
+	const char* g_DrawIDName = "drawID";
+	// uniform names too long for the short string buffer, built once so
+	// that setting them never allocates a temporary string
+	const std::string g_TextureSlotName = "objectTextureSlot";
+	const std::string g_MaterialShininessName = "material.shininess";
+	const std::string g_MaterialDiffuseColorName = "material.diffuseColor";
+	const std::string g_MaterialSpecularColorName = "material.specularColor";
+	const std::string g_MaterialOpacityName = "material.opacity";
+
+	// half size of an object space box that holds every basic
+	// mesh, with room for the torus tube past the unit radius
+	const float MESH_BOUNDS_EXTENT = 1.25f;
+	// components of every object of the scene
+	const EntityManager::COMPONENT_MASK DRAWN_OBJECT_COMPONENTS =
+		EntityManager::MASK_TRANSFORM | EntityManager::MASK_WORLD_MATRIX | EntityManager::MASK_MESH |
+		EntityManager::MASK_MATERIAL | EntityManager::MASK_BOUNDS;
+	// keyframes around the circle that each benchmark light moves on
+	const int LIGHT_PATH_KEYFRAMES = 8;
+}
+
+/***********************************************************
+ *  SceneManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+SceneManager::SceneManager(ShaderManager *pShaderManager)
+{
+	m_pShaderManager = pShaderManager;
+	m_basicMeshes = new ShapeMeshes();
+	m_pLightManager = NULL;
+	m_drawCount = 0;
+	m_bRenderingScene = false;
+	m_pShadowManager = NULL;
+	m_objectFilter = DRAW_ALL_OBJECTS;
+	m_bAnimateObjects = false;
+	m_objectTime = 0.0f;
+	m_pLightmapManager = NULL;
+	m_bObjectLightLists = false;
+	m_pJobSystem = NULL;
+	m_pEntities = new EntityManager(SCENE_OBJECT_CAPACITY);
+	m_motionOffset = glm::vec3(0.0f);
+	m_bMotionObjects = false;
+	m_materialFilter = DRAW_ALL_MATERIALS;
+	m_bSortTranslucent = false;
+	m_sortView = glm::mat4(1.0f);
+	m_benchmarkLightCount = 0;
+	m_loadNumber = 0;
+	memset(&m_lastSceneChanges, 0, sizeof(m_lastSceneChanges));
+	m_lastApplyMilliseconds = 0.0;
+
+	// initialize the texture and material collections
+	m_textures.SetCapacity(MAX_TEXTURES);
+	m_objectMaterials.SetCapacity(MAX_MATERIALS);
+}
+
+/***********************************************************
+ *  ~SceneManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+SceneManager::~SceneManager()
+{
+	// clear the allocated memory
+	m_pShaderManager = NULL;
+	delete m_basicMeshes;
+	m_basicMeshes = NULL;
+	delete m_pEntities;
+	m_pEntities = NULL;
+	// destroy the created OpenGL textures
+	DestroyGLTextures();
+}
+
+/***********************************************************
+ *  DecodeImage()
+ *
+ *  This method is used for reading the pixels of a texture
+ *  image from its file.  It only touches the passed in image,
+ *  so several images can be read at once on different
+ *  threads, once the vertical flip has been set.
+ ***********************************************************/
+void SceneManager::DecodeImage(DECODED_IMAGE& image)
+{
+	image.width = 0;
+	image.height = 0;
+	image.colorChannels = 0;
+
+	// try to parse the image data from the specified image file
+	image.pPixels = stbi_load(
+		image.filename,
+		&image.width,
+		&image.height,
+		&image.colorChannels,
+		0);
+}
+
+/***********************************************************
+ *  DecodeImageJob()
+ *
+ *  This method is used for reading a range of the texture
+ *  images as a job of the job system.
+ ***********************************************************/
+void SceneManager::DecodeImageJob(void* pOwner, size_t first, size_t count)
+{
+	DECODED_IMAGE* pImages = (DECODED_IMAGE*)pOwner;
+	for (size_t i = first; i < first + count; i++)
+	{
+		DecodeImage(pImages[i]);
+	}
+}
+
+/***********************************************************
+ *  UploadGLTexture()
+ *
+ *  This method is used for configuring the texture mapping
+ *  parameters in OpenGL, uploading the read image and
+ *  generating the mipmaps.  The pixels of the image are
+ *  freed.  It returns the ID of the new texture, or 0 when
+ *  the image could not be read or uploaded.
+ ***********************************************************/
+GLuint SceneManager::UploadGLTexture(DECODED_IMAGE& image)
+{
+	GLuint textureID = 0;
+
+	// if the image was successfully read from the image file
+	if (image.pPixels)
+	{
+		std::cout << "Successfully loaded image:" << image.filename << ", width:" << image.width << ", height:" << image.height << ", channels:" << image.colorChannels << std::endl;
+
+		glGenTextures(1, &textureID);
+		glBindTexture(GL_TEXTURE_2D, textureID);
+
+		// set the texture wrapping parameters
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		// set texture filtering parameters
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+		// if the loaded image is in RGB format
+		if (image.colorChannels == 3)
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, image.width, image.height, 0, GL_RGB, GL_UNSIGNED_BYTE, image.pPixels);
+		// if the loaded image is in RGBA format - it supports transparency
+		else if (image.colorChannels == 4)
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, image.width, image.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image.pPixels);
+		else
+		{
+			std::cout << "Not implemented to handle image with " << image.colorChannels << " channels" << std::endl;
+			stbi_image_free(image.pPixels);
+			image.pPixels = NULL;
+			glBindTexture(GL_TEXTURE_2D, 0);
+			glDeleteTextures(1, &textureID);
+			return(0);
+		}
+
+		// generate the texture mipmaps for mapping textures to lower resolutions
+		glGenerateMipmap(GL_TEXTURE_2D);
+
+		// free the image data from local memory
+		stbi_image_free(image.pPixels);
+		image.pPixels = NULL;
+		glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
+
+		return(textureID);
+	}
+
+	std::cout << "Could not load image:" << image.filename << std::endl;
+
+	// Error loading the image
+	return(0);
+}
+
+/***********************************************************
+ *  RegisterGLTexture()
+ *
+ *  This method is used for loading an uploaded texture into
+ *  the next available texture slot, associated with the
+ *  passed in tag.  The texture is deleted when every slot
+ *  is used.
+ ***********************************************************/
+bool SceneManager::RegisterGLTexture(GLuint textureID, const char* filename, const char* tag)
+{
+	TEXTURE_INFO texture;
+	texture.ID = textureID;
+	strncpy(texture.tag, tag, sizeof(texture.tag) - 1);
+	texture.tag[sizeof(texture.tag) - 1] = '\0';
+	strncpy(texture.filename, filename, sizeof(texture.filename) - 1);
+	texture.filename[sizeof(texture.filename) - 1] = '\0';
+	if (m_textures.Add(texture) == 0)
+	{
+		std::cout << "Could not register image:" << filename << ", all texture slots are used" << std::endl;
+		glDeleteTextures(1, &textureID);
+		return false;
+	}
+
+	return true;
+}
+
+/***********************************************************
+ *  CreateGLTexture()
+ *
+ *  This method is used for loading textures from image files,
+ *  configuring the texture mapping parameters in OpenGL,
+ *  generating the mipmaps, and loading the read texture into
+ *  the next available texture slot in memory.
+ ***********************************************************/
+bool SceneManager::CreateGLTexture(const char* filename, const char* tag)
+{
+	DECODED_IMAGE image;
+	image.filename = filename;
+	image.tag = tag;
+
+	// indicate to always flip images vertically when loaded
+	stbi_set_flip_vertically_on_load(true);
+
+	DecodeImage(image);
+	GLuint textureID = UploadGLTexture(image);
+	if (textureID == 0)
+	{
+		return false;
+	}
+	return(RegisterGLTexture(textureID, filename, tag));
+}
+
+/***********************************************************
+ *  BindGLTextures()
+ *
+ *  This method is used for binding the loaded textures to
+ *  OpenGL texture memory slots.  There are up to 16 slots.
+ ***********************************************************/
+void SceneManager::BindGLTextures()
+{
+	for (int i = 0; i < m_textures.GetCount(); i++)
+	{
+		// bind textures on corresponding texture units
+		glActiveTexture(GL_TEXTURE0 + i);
+		glBindTexture(GL_TEXTURE_2D, m_textures.GetAt(i).ID);
+	}
+}
+
+
+
+/***********************************************************
+ *  DestroyGLTextures()
+ *
+ *  This method is used for freeing the memory in all the
+ *  used texture memory slots.
+ ***********************************************************/
+void SceneManager::DestroyGLTextures()
+{
+	for (int i = 0; i < m_textures.GetCount(); i++)
+	{
+		glDeleteTextures(1, &m_textures.GetAt(i).ID);
+	}
+	m_textures.Clear();
+}
+
+/***********************************************************
+ *  FindTextureID()
+ *
+ *  This method is used for getting an ID for the previously
+ *  loaded texture bitmap associated with the passed in tag.
+ ***********************************************************/
+int SceneManager::FindTextureID(const char* tag)
+{
+	int textureID = -1;
+	int index = 0;
+	bool bFound = false;
+
+	while ((index < m_textures.GetCount()) && (bFound == false))
+	{
+		if (strcmp(m_textures.GetAt(index).tag, tag) == 0)
+		{
+			textureID = m_textures.GetAt(index).ID;
+			bFound = true;
+		}
+		else
+			index++;
+	}
+
+	return(textureID);
+}
+
+/***********************************************************
+ *  FindTextureSlot()
+ *
+ *  This method is used for getting a slot index for the previously
+ *  loaded texture bitmap associated with the passed in tag.
+ ***********************************************************/
+int SceneManager::FindTextureSlot(const char* tag)
+{
+	int textureSlot = -1;
+	int index = 0;
+	bool bFound = false;
+
+	while ((index < m_textures.GetCount()) && (bFound == false))
+	{
+		if (strcmp(m_textures.GetAt(index).tag, tag) == 0)
+		{
+			textureSlot = index;
+			bFound = true;
+		}
+		else
+			index++;
+	}
+
+	return(textureSlot);
+}
+
+/***********************************************************
+ *  FindMaterial()
+ *
+ *  This method is used for getting the handle of a material
+ *  from the previously defined materials list that is
+ *  associated with the passed in tag, or 0 when none is.
+ ***********************************************************/
+unsigned int SceneManager::FindMaterial(const char* tag)
+{
+	for (int index = 0; index < m_objectMaterials.GetCount(); index++)
+	{
+		if (strcmp(m_objectMaterials.GetAt(index).tag, tag) == 0)
+		{
+			return(m_objectMaterials.GetHandleAt(index));
+		}
+	}
+
+	return(0);
+}
+
+/***********************************************************
+ *  AddMaterial()
+ *
+ *  This method is used for adding a material to the defined
+ *  materials list.  It returns the handle of the material,
+ *  or 0 when the list is full.
+ ***********************************************************/
+unsigned int SceneManager::AddMaterial(const OBJECT_MATERIAL& material)
+{
+	unsigned int handle = m_objectMaterials.Add(material);
+	if (handle == 0)
+	{
+		std::cout << "Could not define material:" << material.tag << ", the materials list is full" << std::endl;
+	}
+	return(handle);
+}
+
+
+/***********************************************************
+ *  SetTransformations()
+ *
+ *  This method is used for setting the world matrix of the
+ *  next object into the shader, with the light list of its
+ *  world bounds when the objects have light lists.
+ ***********************************************************/
+void SceneManager::SetTransformations(
+	const glm::mat4& modelView,
+	const EntityManager::BOUNDS& bounds)
+{
+	if (NULL != m_pShaderManager)
+	{
+		m_pShaderManager->setMat4Value(g_ModelName, modelView);
+		// each transformed object is one draw in the visibility buffer
+		m_pShaderManager->setIntValue(g_DrawIDName, m_drawCount);
+	}
+
+	// every object drawn by the scene starts here, so the allocations
+	// until the next one are counted against its draw
+	if (m_bRenderingScene == true)
+	{
+		if (m_drawCount > 0)
+		{
+			AllocationTracker::EndScope();
+		}
+		AllocationTracker::BeginScope("DrawObject");
+	}
+	m_drawCount++;
+
+	// only the lights that reach the world bounds of the
+	// object are evaluated by its fragments
+	if ((m_bObjectLightLists == true) && (NULL != m_pLightManager))
+	{
+		m_pLightManager->SetObjectLights(bounds.center - bounds.extent, bounds.center + bounds.extent);
+	}
+}
+
+/***********************************************************
+ *  SetShaderColor()
+ *
+ *  This method is used for setting the passed in color
+ *  into the shader for the next draw command
+ ***********************************************************/
+void SceneManager::SetShaderColor(
+	float redColorValue,
+	float greenColorValue,
+	float blueColorValue,
+	float alphaValue)
+{
+	// variables for this method
+	glm::vec4 currentColor;
+
+	currentColor.r = redColorValue;
+	currentColor.g = greenColorValue;
+	currentColor.b = blueColorValue;
+	currentColor.a = alphaValue;
+
+	if (NULL != m_pShaderManager)
+	{
+		m_pShaderManager->setIntValue(g_UseTextureName, false);
+		m_pShaderManager->setVec4Value(g_ColorValueName, currentColor);
+	}
+}
+
+/***********************************************************
+ *  SetShaderTexture()
+ *
+ *  This method is used for setting the texture bound to the
+ *  passed in slot into the shader.
+ ***********************************************************/
+void SceneManager::SetShaderTexture(
+	int textureSlot)
+{
+	if (NULL != m_pShaderManager)
+	{
+		m_pShaderManager->setIntValue(g_UseTextureName, true);
+
+		m_pShaderManager->setSampler2DValue(g_TextureValueName, textureSlot);
+		// the visibility resolve pass cannot read the sampler unit
+		if (textureSlot >= 0)
+		{
+			m_pShaderManager->setIntValue(g_TextureSlotName, textureSlot);
+		}
+	}
+}
+
+/***********************************************************
+ *  SetTextureUVScale()
+ *
+ *  This method is used for setting the texture UV scale
+ *  values into the shader.
+ ***********************************************************/
+void SceneManager::SetTextureUVScale(float u, float v)
+{
+	if (NULL != m_pShaderManager)
+	{
+		m_pShaderManager->setVec2Value("UVscale", glm::vec2(u, v));
+	}
+}
+
+/***********************************************************
+ *  SetShaderMaterial()
+ *
+ *  This method is used for passing the values of the
+ *  material of the passed in handle into the shader.
+ ***********************************************************/
+void SceneManager::SetShaderMaterial(
+	unsigned int material)
+{
+	const OBJECT_MATERIAL* pMaterial = m_objectMaterials.Get(material);
+	if ((NULL != pMaterial) && (NULL != m_pShaderManager))
+	{
+		m_pShaderManager->setVec3Value(g_MaterialDiffuseColorName, pMaterial->diffuseColor);
+		m_pShaderManager->setVec3Value(g_MaterialSpecularColorName, pMaterial->specularColor);
+		m_pShaderManager->setFloatValue(g_MaterialShininessName, pMaterial->shininess);
+		m_pShaderManager->setFloatValue(g_MaterialOpacityName, pMaterial->opacity);
+	}
+}
+
+/***********************************************************
+ *  CreateSceneObject()
+ *
+ *  This method is used for adding an object of the scene
+ *  description as an entity, which keeps the mesh,
+ *  transformation, texture and material it is drawn with.
+ *  A dynamic object moves away from its position while the
+ *  objects are animated.  It returns the handle of the
+ *  object, or 0 when the scene is full.
+ ***********************************************************/
+unsigned int SceneManager::CreateSceneObject(const SceneFile::OBJECT_DESC& object)
+{
+	EntityManager::COMPONENT_MASK components = DRAWN_OBJECT_COMPONENTS;
+	if (object.bDynamic == true)
+	{
+		components |= EntityManager::MASK_MOTION;
+	}
+
+	unsigned int entity = m_pEntities->CreateEntity(components);
+	if (entity == 0)
+	{
+		std::cout << "Could not add scene object:" << object.name << ", the scene is full" << std::endl;
+		return(0);
+	}
+
+	glm::vec3 position = object.position;
+	if (object.bDynamic == true)
+	{
+		m_pEntities->GetMotion(entity)->restPosition = object.position;
+		position += m_motionOffset;
+	}
+	m_pEntities->SetTransform(entity, position, object.rotationDegrees, object.scale);
+	m_pEntities->GetMesh(entity)->mesh = object.mesh;
+	EntityManager::MATERIAL_REF* pMaterial = m_pEntities->GetMaterial(entity);
+	pMaterial->textureSlot = GetObjectTextureSlot(object);
+	pMaterial->material = GetObjectMaterial(object);
+	pMaterial->shininess = object.shininess;
+	m_pEntities->GetBounds(entity)->localExtent = MESH_BOUNDS_EXTENT;
+	return(entity);
+}
+
+/***********************************************************
+ *  UpdateSceneObject()
+ *
+ *  This method is used for changing the components of an
+ *  entity that differ from its object in the description.
+ *  The transform is only set when it changed, so unchanged
+ *  objects leave their chunks clean.  It returns true when
+ *  anything was changed.
+ ***********************************************************/
+bool SceneManager::UpdateSceneObject(unsigned int entity, const SceneFile::OBJECT_DESC& object)
+{
+	bool bChanged = false;
+
+	// a dynamic object is compared by the position it rests at
+	const EntityManager::TRANSFORM* pTransform = m_pEntities->GetTransform(entity);
+	EntityManager::MOTION* pMotion = m_pEntities->GetMotion(entity);
+	glm::vec3 restPosition = pTransform->position;
+	if (NULL != pMotion)
+	{
+		restPosition = pMotion->restPosition;
+	}
+	if ((restPosition != object.position) ||
+		(pTransform->rotationDegrees != object.rotationDegrees) ||
+		(pTransform->scale != object.scale))
+	{
+		glm::vec3 position = object.position;
+		if (NULL != pMotion)
+		{
+			pMotion->restPosition = object.position;
+			position += m_motionOffset;
+		}
+		m_pEntities->SetTransform(entity, position, object.rotationDegrees, object.scale);
+		bChanged = true;
+	}
+
+	EntityManager::MESH_REF* pMesh = m_pEntities->GetMesh(entity);
+	if (pMesh->mesh != object.mesh)
+	{
+		pMesh->mesh = object.mesh;
+		bChanged = true;
+	}
+
+	EntityManager::MATERIAL_REF* pMaterial = m_pEntities->GetMaterial(entity);
+	int textureSlot = GetObjectTextureSlot(object);
+	unsigned int material = GetObjectMaterial(object);
+	if ((pMaterial->textureSlot != textureSlot) ||
+		(pMaterial->material != material) ||
+		(pMaterial->shininess != object.shininess))
+	{
+		pMaterial->textureSlot = textureSlot;
+		pMaterial->material = material;
+		pMaterial->shininess = object.shininess;
+		bChanged = true;
+	}
+
+	return(bChanged);
+}
+
+/***********************************************************
+ *  GetObjectTextureSlot()
+ *
+ *  This method is used for getting the texture slot of an
+ *  object of the applied description, or -1 when it has no
+ *  texture or its texture could not be loaded.
+ ***********************************************************/
+int SceneManager::GetObjectTextureSlot(const SceneFile::OBJECT_DESC& object) const
+{
+	if ((object.texture < 0) || (object.texture >= (int)m_textureSlots.size()))
+	{
+		return(-1);
+	}
+	return(m_textureSlots[object.texture]);
+}
+
+/***********************************************************
+ *  GetObjectMaterial()
+ *
+ *  This method is used for getting the material handle of
+ *  an object of the applied description, or 0 when it has
+ *  no material.
+ ***********************************************************/
+unsigned int SceneManager::GetObjectMaterial(const SceneFile::OBJECT_DESC& object) const
+{
+	if ((object.material < 0) || (object.material >= (int)m_materialHandles.size()))
+	{
+		return(0);
+	}
+	return(m_materialHandles[object.material]);
+}
+
+/***********************************************************
+ *  MoveDynamicObjects()
+ *
+ *  This method is used for placing the dynamic objects for
+ *  the current time.  While the objects are animated, they
+ *  bounce up and down, otherwise they rest.  Only a
+ *  change of the offset marks the chunks for the transform
+ *  system.
+ ***********************************************************/
+void SceneManager::MoveDynamicObjects()
+{
+	glm::vec3 offset = glm::vec3(0.0f);
+	if (m_bAnimateObjects == true)
+	{
+		offset.y = 0.5f * (1.0f - std::cos(m_objectTime * 2.0f));
+	}
+	if (offset == m_motionOffset)
+	{
+		return;
+	}
+	m_motionOffset = offset;
+
+	m_pEntities->FindChunks(EntityManager::MASK_TRANSFORM | EntityManager::MASK_MOTION, 0, m_drawChunks);
+	for (size_t c = 0; c < m_drawChunks.size(); c++)
+	{
+		EntityManager::CHUNK& chunk = *m_drawChunks[c];
+		for (int i = 0; i < chunk.count; i++)
+		{
+			chunk.pTransforms[i].position = chunk.pMotions[i].restPosition + offset;
+		}
+		chunk.bTransformsDirty = true;
+	}
+}
+
+/***********************************************************
+ *  DrawObjectChunks()
+ *
+ *  This method is used for drawing the objects of the passed
+ *  in chunks that pass the material filter, in the order
+ *  they were added.  Each object sets everything it is drawn
+ *  with, so the objects can be drawn in any subset.  While
+ *  the translucent objects are sorted, they are only listed
+ *  with their view depth, and drawn once RenderScene has
+ *  listed all of them.
+ ***********************************************************/
+void SceneManager::DrawObjectChunks(const std::vector<EntityManager::CHUNK*>& chunks)
+{
+	bool bSort = (m_bSortTranslucent == true) && (m_materialFilter == DRAW_TRANSLUCENT_MATERIALS);
+
+	for (size_t c = 0; c < chunks.size(); c++)
+	{
+		const EntityManager::CHUNK& chunk = *chunks[c];
+		for (int i = 0; i < chunk.count; i++)
+		{
+			if (IsMaterialDrawn(chunk.pMaterials[i].material) == false)
+			{
+				continue;
+			}
+
+			if (bSort == true)
+			{
+				SORTED_OBJECT object;
+				object.depth = (m_sortView * glm::vec4(chunk.pBounds[i].center, 1.0f)).z;
+				object.pChunk = &chunk;
+				object.row = i;
+				m_sortedObjects.push_back(object);
+			}
+			else
+			{
+				DrawObject(chunk, i);
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  DrawObject()
+ *
+ *  This method is used for setting the transformation,
+ *  texture and material of one object of a chunk into the
+ *  shader and drawing its mesh.
+ ***********************************************************/
+void SceneManager::DrawObject(const EntityManager::CHUNK& chunk, int row)
+{
+	const EntityManager::MATERIAL_REF& material = chunk.pMaterials[row];
+	SetTransformations(chunk.pWorldMatrices[row], chunk.pBounds[row]);
+	SetShaderTexture(material.textureSlot);
+	SetShaderMaterial(material.material);
+	if ((material.shininess >= 0.0f) && (NULL != m_pShaderManager))
+	{
+		m_pShaderManager->setFloatValue(g_MaterialShininessName, material.shininess);
+	}
+
+	switch (chunk.pMeshes[row].mesh)
+	{
+	case SceneFile::MESH_BOX:
+		m_basicMeshes->DrawBoxMesh();
+		break;
+	case SceneFile::MESH_PLANE:
+		m_basicMeshes->DrawPlaneMesh();
+		break;
+	case SceneFile::MESH_CYLINDER:
+		m_basicMeshes->DrawCylinderMesh();
+		break;
+	case SceneFile::MESH_TAPERED_CYLINDER:
+		m_basicMeshes->DrawTaperedCylinderMesh();
+		break;
+	case SceneFile::MESH_SPHERE:
+		m_basicMeshes->DrawSphereMesh();
+		break;
+	case SceneFile::MESH_TORUS:
+		m_basicMeshes->DrawTorusMesh();
+		break;
+	}
+}
+
+/***********************************************************
+ *  IsMaterialDrawn()
+ *
+ *  This method is used for checking whether the objects of
+ *  the material of the passed in handle are drawn with the
+ *  current material filter.  Objects without a material are
+ *  opaque.  The objects of the other pass are skipped here
+ *  rather than discarded by the shader, so the shader keeps
+ *  its early depth test.
+ ***********************************************************/
+bool SceneManager::IsMaterialDrawn(unsigned int material) const
+{
+	if (m_materialFilter == DRAW_ALL_MATERIALS)
+	{
+		return(true);
+	}
+
+	const OBJECT_MATERIAL* pMaterial = m_objectMaterials.Get(material);
+	bool bTranslucent = (NULL != pMaterial) && (pMaterial->opacity < 1.0f);
+	return(bTranslucent == (m_materialFilter == DRAW_TRANSLUCENT_MATERIALS));
+}
+
+/***********************************************************
+ *  IsFartherObject()
+ *
+ *  This method is used for ordering the sorted objects from
+ *  back to front.  The view looks down its negative Z axis,
+ *  so the farther object has the lower depth.
+ ***********************************************************/
+bool SceneManager::IsFartherObject(const SORTED_OBJECT& first, const SORTED_OBJECT& second)
+{
+	return(first.depth < second.depth);
+}
+
+/***********************************************************
+ *  ApplyScene()
+ *
+ *  This method is used for changing the live scene into the
+ *  passed in description.  The textures and materials come
+ *  first, since the objects refer to them.  When a reload
+ *  moves objects or changes lights, the cached shadow maps
+ *  are drawn again, and the baked lightmaps are turned off
+ *  until they are baked for the new scene.
+ ***********************************************************/
+void SceneManager::ApplyScene(const SceneFile::SCENE_DESC& scene)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	bool bReload = (m_loadNumber > 0);
+
+	memset(&m_lastSceneChanges, 0, sizeof(m_lastSceneChanges));
+	m_lastSceneChanges.changedTextures = ApplyTextures(scene);
+	m_lastSceneChanges.changedMaterials = ApplyMaterials(scene);
+	m_lastSceneChanges.bLightsChanged = ApplyLights(scene);
+	ApplyObjects(scene);
+
+	// only the chunks of the added and changed objects are transformed
+	m_pEntities->UpdateTransforms();
+	m_drawChunks.reserve(m_pEntities->GetChunkCount());
+	m_sortedObjects.reserve(m_pEntities->GetMaxEntities());
+
+	// empty chunks are freed, so any chunk with a motion holds an object
+	m_pEntities->FindChunks(EntityManager::MASK_MOTION, 0, m_drawChunks);
+	m_bMotionObjects = (m_drawChunks.empty() == false);
+
+	bool bObjectsChanged =
+		(m_lastSceneChanges.addedObjects > 0) ||
+		(m_lastSceneChanges.changedObjects > 0) ||
+		(m_lastSceneChanges.removedObjects > 0);
+	if ((bReload == true) && ((bObjectsChanged == true) || (m_lastSceneChanges.bLightsChanged == true)))
+	{
+		if (NULL != m_pShadowManager)
+		{
+			m_pShadowManager->InvalidateMaps();
+		}
+		if (NULL != m_pLightmapManager)
+		{
+			m_pLightmapManager->SetEnabled(false);
+			std::cout << "INFO: The lightmaps no longer match the scene and are turned off until they are baked again" << std::endl;
+		}
+	}
+
+	m_lastApplyMilliseconds = std::chrono::duration<double, std::milli>(
+		std::chrono::steady_clock::now() - start).count();
+}
+
+/***********************************************************
+ *  ApplyTextures()
+ *
+ *  This method is used for loading the textures of the
+ *  description that are not loaded yet, and freeing the
+ *  loaded ones that it no longer has or whose image file
+ *  changed.  The new images are read at the same time on
+ *  the job system.  It returns the number of textures that
+ *  were loaded or freed.
+ ***********************************************************/
+int SceneManager::ApplyTextures(const SceneFile::SCENE_DESC& scene)
+{
+	int changedCount = 0;
+
+	// from the back, since removing a texture moves the last one
+	// into its place
+	for (int i = m_textures.GetCount() - 1; i >= 0; i--)
+	{
+		TEXTURE_INFO& texture = m_textures.GetAt(i);
+		int index = SceneFile::FindTexture(scene, texture.tag);
+		if ((index < 0) || (strcmp(scene.textures[index].filename, texture.filename) != 0))
+		{
+			glDeleteTextures(1, &texture.ID);
+			m_textures.Remove(m_textures.GetHandleAt(i));
+			changedCount++;
+		}
+	}
+
+	std::vector<DECODED_IMAGE> images;
+	for (size_t i = 0; i < scene.textures.size(); i++)
+	{
+		if (FindTextureSlot(scene.textures[i].tag) < 0)
+		{
+			DECODED_IMAGE image;
+			image.filename = scene.textures[i].filename;
+			image.tag = scene.textures[i].tag;
+			image.pPixels = NULL;
+			images.push_back(image);
+		}
+	}
+
+	if (images.empty() == false)
+	{
+		// indicate to always flip images vertically when loaded
+		stbi_set_flip_vertically_on_load(true);
+
+		// the images are read at the same time on the job system, but
+		// only this thread has the OpenGL context to upload them
+		if (NULL != m_pJobSystem)
+		{
+			JobSystem::JOB_COUNTER decoded;
+			m_pJobSystem->ParallelFor(&SceneManager::DecodeImageJob, images.data(), images.size(), 1, &decoded);
+			m_pJobSystem->Wait(&decoded);
+		}
+		else
+		{
+			DecodeImageJob(images.data(), 0, images.size());
+		}
+
+		for (size_t i = 0; i < images.size(); i++)
+		{
+			GLuint textureID = UploadGLTexture(images[i]);
+			if (textureID != 0)
+			{
+				RegisterGLTexture(textureID, images[i].filename, images[i].tag);
+			}
+			changedCount++;
+		}
+	}
+
+	// the textures are bound to the units of their slots, which
+	// moved when any was removed
+	if (changedCount > 0)
+	{
+		BindGLTextures();
+	}
+
+	m_textureSlots.resize(scene.textures.size());
+	for (size_t i = 0; i < scene.textures.size(); i++)
+	{
+		m_textureSlots[i] = FindTextureSlot(scene.textures[i].tag);
+	}
+	return(changedCount);
+}
+
+/***********************************************************
+ *  ApplyMaterials()
+ *
+ *  This method is used for defining the materials of the
+ *  description.  A material that is already defined keeps
+ *  its handle and only has its values changed, so the
+ *  objects drawn with it pick them up.  It returns the
+ *  number of materials that were added, changed or removed.
+ ***********************************************************/
+int SceneManager::ApplyMaterials(const SceneFile::SCENE_DESC& scene)
+{
+	int changedCount = 0;
+
+	for (int i = m_objectMaterials.GetCount() - 1; i >= 0; i--)
+	{
+		if (SceneFile::FindMaterial(scene, m_objectMaterials.GetAt(i).tag) < 0)
+		{
+			m_objectMaterials.Remove(m_objectMaterials.GetHandleAt(i));
+			changedCount++;
+		}
+	}
+
+	m_materialHandles.resize(scene.materials.size());
+	for (size_t i = 0; i < scene.materials.size(); i++)
+	{
+		const SceneFile::MATERIAL_DESC& description = scene.materials[i];
+		unsigned int handle = FindMaterial(description.tag);
+		OBJECT_MATERIAL* pMaterial = m_objectMaterials.Get(handle);
+
+		if (NULL == pMaterial)
+		{
+			OBJECT_MATERIAL material;
+			material.diffuseColor = description.diffuseColor;
+			material.specularColor = description.specularColor;
+			material.shininess = description.shininess;
+			material.opacity = description.opacity;
+			strcpy(material.tag, description.tag);
+			handle = AddMaterial(material);
+			changedCount++;
+		}
+		else if ((pMaterial->diffuseColor != description.diffuseColor) ||
+			(pMaterial->specularColor != description.specularColor) ||
+			(pMaterial->shininess != description.shininess) ||
+			(pMaterial->opacity != description.opacity))
+		{
+			pMaterial->diffuseColor = description.diffuseColor;
+			pMaterial->specularColor = description.specularColor;
+			pMaterial->shininess = description.shininess;
+			pMaterial->opacity = description.opacity;
+			changedCount++;
+		}
+		m_materialHandles[i] = handle;
+	}
+	return(changedCount);
+}
+
+/***********************************************************
+ *  IsSameLight()
+ *
+ *  This method is used for checking whether two lights of a
+ *  description have the same values.
+ ***********************************************************/
+bool SceneManager::IsSameLight(const SceneFile::LIGHT_DESC& first, const SceneFile::LIGHT_DESC& second)
+{
+	return((first.type == second.type) &&
+		(first.position == second.position) &&
+		(first.direction == second.direction) &&
+		(first.ambient == second.ambient) &&
+		(first.diffuse == second.diffuse) &&
+		(first.specular == second.specular) &&
+		(first.radius == second.radius) &&
+		(first.specularScale == second.specularScale) &&
+		(first.bShadows == second.bShadows) &&
+		(first.bBaked == second.bBaked));
+}
+
+/***********************************************************
+ *  ApplyLights()
+ *
+ *  This method is used for setting the lights of the
+ *  description into the shader, the light buffer, the shadow
+ *  maps and the lightmaps.  The lights are only set again
+ *  when any of them changed.  The first point lights are
+ *  also set into the uniforms of the default shader, and
+ *  the benchmark lights are added after the scene lights.
+ *  It returns true when the lights were set.
+ ***********************************************************/
+bool SceneManager::ApplyLights(const SceneFile::SCENE_DESC& scene)
+{
+	bool bChanged = (m_loadNumber == 0) || (m_sceneLights.size() != scene.lights.size());
+	for (size_t i = 0; (i < scene.lights.size()) && (bChanged == false); i++)
+	{
+		bChanged = (IsSameLight(m_sceneLights[i], scene.lights[i]) == false);
+	}
+	if (bChanged == false)
+	{
+		return(false);
+	}
+	m_sceneLights = scene.lights;
+
+	// the directional light, black when the scene has none
+	SceneFile::LIGHT_DESC directional = SceneFile::LIGHT_DESC();
+	directional.direction = glm::vec3(0.0f, -1.0f, 0.0f);
+	bool bDirectional = false;
+	for (size_t i = 0; i < scene.lights.size(); i++)
+	{
+		if (scene.lights[i].type == SceneFile::LIGHT_DIRECTIONAL)
+		{
+			directional = scene.lights[i];
+			bDirectional = true;
+		}
+	}
+
+	if (NULL != m_pShaderManager)
+	{
+		m_pShaderManager->setVec3Value("directionalLight.direction", directional.direction);
+		m_pShaderManager->setVec3Value("directionalLight.ambient", directional.ambient);
+		m_pShaderManager->setVec3Value("directionalLight.diffuse", directional.diffuse);
+		m_pShaderManager->setVec3Value("directionalLight.specular", directional.specular);
+		m_pShaderManager->setBoolValue("directionalLight.bActive", bDirectional);
+
+		int shaderLight = 0;
+		for (size_t i = 0; i < scene.lights.size(); i++)
+		{
+			const SceneFile::LIGHT_DESC& light = scene.lights[i];
+			if ((light.type != SceneFile::LIGHT_POINT) || (shaderLight >= MAX_SHADER_POINT_LIGHTS))
+			{
+				continue;
+			}
+			std::string prefix = "pointLights[" + std::to_string(shaderLight) + "].";
+			m_pShaderManager->setVec3Value(prefix + "position", light.position);
+			m_pShaderManager->setVec3Value(prefix + "ambient", light.ambient);
+			m_pShaderManager->setVec3Value(prefix + "diffuse", light.diffuse);
+			m_pShaderManager->setVec3Value(prefix + "specular", light.specular);
+			m_pShaderManager->setBoolValue(prefix + "bActive", true);
+			shaderLight++;
+		}
+		for (; shaderLight < MAX_SHADER_POINT_LIGHTS; shaderLight++)
+		{
+			m_pShaderManager->setBoolValue("pointLights[" + std::to_string(shaderLight) + "].bActive", false);
+		}
+	}
+
+	// the clustered and deferred shaders read the point lights from the
+	// light buffer, so they need a radius that covers the whole scene
+	if (NULL != m_pLightManager)
+	{
+		m_pLightManager->ClearLights();
+		m_pLightManager->SetDirectionalLight(
+			directional.direction, directional.ambient, directional.diffuse, directional.specular);
+		for (size_t i = 0; i < scene.lights.size(); i++)
+		{
+			const SceneFile::LIGHT_DESC& light = scene.lights[i];
+			if (light.type == SceneFile::LIGHT_POINT)
+			{
+				m_pLightManager->AddPointLight(light.position, light.radius, light.diffuse, light.specularScale);
+			}
+		}
+		if (m_benchmarkLightCount > 0)
+		{
+			CreateBenchmarkLights(m_benchmarkLightCount);
+		}
+	}
+
+	if (NULL != m_pShadowManager)
+	{
+		m_pShadowManager->ClearLights();
+		for (size_t i = 0; i < scene.lights.size(); i++)
+		{
+			const SceneFile::LIGHT_DESC& light = scene.lights[i];
+			if (light.bShadows == false)
+			{
+				continue;
+			}
+			if (light.type == SceneFile::LIGHT_DIRECTIONAL)
+			{
+				m_pShadowManager->SetDirectionalLight(light.direction);
+			}
+			else
+			{
+				m_pShadowManager->AddPointLight(light.position, light.radius);
+			}
+		}
+	}
+
+	// only the diffuse light of the baked lights goes into the lightmap
+	if (NULL != m_pLightmapManager)
+	{
+		m_pLightmapManager->ClearLights();
+		for (size_t i = 0; i < scene.lights.size(); i++)
+		{
+			const SceneFile::LIGHT_DESC& light = scene.lights[i];
+			if (light.bBaked == false)
+			{
+				continue;
+			}
+			if (light.type == SceneFile::LIGHT_DIRECTIONAL)
+			{
+				m_pLightmapManager->AddDirectionalLight(light.direction, light.diffuse);
+			}
+			else
+			{
+				m_pLightmapManager->AddPointLight(light.position, light.diffuse);
+			}
+		}
+	}
+	return(true);
+}
+
+/***********************************************************
+ *  ApplyObjects()
+ *
+ *  This method is used for matching the objects of the
+ *  description to the live objects by name.  New names are
+ *  added as entities, names that are gone are destroyed, and
+ *  the remaining objects only have the components that
+ *  differ changed.  An object that became dynamic or static
+ *  changes its archetype, so it is created again.
+ ***********************************************************/
+void SceneManager::ApplyObjects(const SceneFile::SCENE_DESC& scene)
+{
+	// never a valid handle, for the second object with a name
+	const unsigned int DUPLICATE_OBJECT = 0xFFFFFFFFu;
+	int objectCount = (int)scene.objects.size();
+
+	m_loadNumber++;
+
+	// a scene larger than the entities have room for starts over
+	// with room for it
+	if (objectCount > m_pEntities->GetMaxEntities())
+	{
+		int capacity = m_pEntities->GetMaxEntities();
+		while (capacity < objectCount)
+		{
+			capacity *= 2;
+		}
+		delete m_pEntities;
+		m_pEntities = new EntityManager(capacity);
+		m_pEntities->SetJobSystem(m_pJobSystem);
+		m_lastSceneChanges.removedObjects = (int)m_sceneObjects.size();
+		m_sceneObjects.clear();
+	}
+
+	// mark the objects that are still in the scene
+	m_objectEntities.resize(objectCount);
+	for (int i = 0; i < objectCount; i++)
+	{
+		std::unordered_map<std::string, SCENE_OBJECT>::iterator found = m_sceneObjects.find(scene.objects[i].name);
+		m_objectEntities[i] = 0;
+		if (found != m_sceneObjects.end())
+		{
+			if (found->second.loadNumber == m_loadNumber)
+			{
+				std::cout << "WARNING: Scene object " << scene.objects[i].name << " is defined more than once, only the first is used" << std::endl;
+				m_objectEntities[i] = DUPLICATE_OBJECT;
+			}
+			else
+			{
+				found->second.loadNumber = m_loadNumber;
+				m_objectEntities[i] = found->second.entity;
+			}
+		}
+	}
+
+	// destroy the objects that are gone
+	std::unordered_map<std::string, SCENE_OBJECT>::iterator object = m_sceneObjects.begin();
+	while (object != m_sceneObjects.end())
+	{
+		if (object->second.loadNumber != m_loadNumber)
+		{
+			m_pEntities->DestroyEntity(object->second.entity);
+			object = m_sceneObjects.erase(object);
+			m_lastSceneChanges.removedObjects++;
+		}
+		else
+		{
+			++object;
+		}
+	}
+
+	for (int i = 0; i < objectCount; i++)
+	{
+		const SceneFile::OBJECT_DESC& description = scene.objects[i];
+		unsigned int entity = m_objectEntities[i];
+		if (entity == DUPLICATE_OBJECT)
+		{
+			continue;
+		}
+
+		if (entity == 0)
+		{
+			SCENE_OBJECT added;
+			added.entity = 0;
+			added.loadNumber = m_loadNumber;
+			std::pair<std::unordered_map<std::string, SCENE_OBJECT>::iterator, bool> inserted =
+				m_sceneObjects.insert(std::make_pair(std::string(description.name), added));
+			// a new name given to two objects is only added once
+			if (inserted.second == false)
+			{
+				std::cout << "WARNING: Scene object " << description.name << " is defined more than once, only the first is used" << std::endl;
+				continue;
+			}
+			inserted.first->second.entity = CreateSceneObject(description);
+			if (inserted.first->second.entity == 0)
+			{
+				m_sceneObjects.erase(inserted.first);
+				continue;
+			}
+			m_lastSceneChanges.addedObjects++;
+		}
+		else if ((NULL != m_pEntities->GetMotion(entity)) != description.bDynamic)
+		{
+			m_pEntities->DestroyEntity(entity);
+			m_sceneObjects[description.name].entity = CreateSceneObject(description);
+			m_lastSceneChanges.changedObjects++;
+		}
+		else if (UpdateSceneObject(entity, description) == true)
+		{
+			m_lastSceneChanges.changedObjects++;
+		}
+	}
+}
+
+/**************************************************************/
+/*** STUDENTS CAN MODIFY the code in the methods BELOW for  ***/
+/*** preparing and rendering their own 3D replicated scenes.***/
+/*** Please refer to the code in the OpenGL sample project  ***/
+/*** for assistance.                                        ***/
+/**************************************************************/
+
+/***********************************************************
+ *  SetShaderManager()
+ *
+ *  This method is used for changing the shader that the
+ *  shader values are passed into when the scene is drawn,
+ *  for render passes that use their own shaders.
+ ***********************************************************/
+void SceneManager::SetShaderManager(ShaderManager* pShaderManager)
+{
+	m_pShaderManager = pShaderManager;
+}
+
+/***********************************************************
+ *  SetLightManager()
+ *
+ *  This method is used for passing in the light buffer object
+ *  that the point and spot lights are added to.
+ ***********************************************************/
+void SceneManager::SetLightManager(LightManager* pLightManager)
+{
+	m_pLightManager = pLightManager;
+}
+
+/***********************************************************
+ *  CreateBenchmarkLights()
+ *
+ *  This method is used for filling the scene volume with
+ *  small colored point and spot lights that move around, for
+ *  measuring the cost of many dynamic lights.
+ ***********************************************************/
+void SceneManager::CreateBenchmarkLights(int lightCount)
+{
+	// kept so that the lights are added again after the scene lights
+	// when a scene file changes them
+	m_benchmarkLightCount = lightCount;
+	if (NULL == m_pLightManager)
+	{
+		return;
+	}
+	// fixed seed so every benchmark run uses the same lights
+	std::mt19937 generator(330);
+	std::uniform_real_distribution<float> positionX(-18.0f, 18.0f);
+	std::uniform_real_distribution<float> positionY(0.25f, 10.0f);
+	std::uniform_real_distribution<float> positionZ(-9.5f, 8.0f);
+	std::uniform_real_distribution<float> radius(0.75f, 2.5f);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+	for (int i = 0; i < lightCount; i++)
+	{
+		glm::vec3 position = glm::vec3(positionX(generator), positionY(generator), positionZ(generator));
+		glm::vec3 color = glm::vec3(unit(generator), unit(generator), unit(generator)) * 0.8f;
+		int index = -1;
+
+		// every fourth light is a spot light pointing at the floor
+		if ((i % 4) == 3)
+		{
+			index = m_pLightManager->AddSpotLight(
+				position, glm::vec3(0.0f, -1.0f, 0.0f), radius(generator) * 2.0f,
+				20.0f, 30.0f, color, 0.5f);
+		}
+		else
+		{
+			index = m_pLightManager->AddPointLight(
+				position, radius(generator), color, 0.5f);
+		}
+		float phase = unit(generator);
+		float speed = 0.5f + unit(generator) * 1.5f;
+
+		// one loop around a small circle, then a rest for as long
+		// at the start, so about half of the lights are still
+		std::vector<LightManager::LIGHT_KEYFRAME> keyframes;
+		float loopSeconds = 6.2831853f / speed;
+		for (int k = 0; k <= LIGHT_PATH_KEYFRAMES; k++)
+		{
+			float angle = 6.2831853f * (float)k / (float)LIGHT_PATH_KEYFRAMES;
+			LightManager::LIGHT_KEYFRAME keyframe;
+
+			keyframe.time = loopSeconds * (float)k / (float)LIGHT_PATH_KEYFRAMES;
+			keyframe.position = position + glm::vec3(std::cos(angle), 0.0f, std::sin(angle)) * 0.75f;
+			keyframe.color = color;
+			keyframes.push_back(keyframe);
+		}
+		keyframes.push_back(keyframes.back());
+		keyframes.back().time = loopSeconds * 2.0f;
+
+		m_pLightManager->AddLightAnimation(index, keyframes, phase * loopSeconds * 2.0f);
+	}
+}
+
+/***********************************************************
+ *  AnimateLights()
+ *
+ *  This method is used for moving each of the animated
+ *  lights through its keyframes for the passed in time.
+ ***********************************************************/
+void SceneManager::AnimateLights(float time)
+{
+	if (NULL == m_pLightManager)
+	{
+		return;
+	}
+
+	m_pLightManager->AnimateLights(time);
+}
+
+/***********************************************************
+ *  SetObjectLightLists()
+ *
+ *  This method is used for turning on or off the light lists
+ *  that each transformed object sets into the shader.  The
+ *  light grid of the light manager must be built for the
+ *  current light positions, and its lights bound to the
+ *  shader the scene is drawn with, while they are on.
+ ***********************************************************/
+void SceneManager::SetObjectLightLists(bool bEnabled)
+{
+	m_bObjectLightLists = bEnabled;
+}
+
+/***********************************************************
+ *  SetShadowManager()
+ *
+ *  This method is used for passing in the shadow maps object
+ *  that the shadow casting lights are added to.
+ ***********************************************************/
+void SceneManager::SetShadowManager(ShadowManager* pShadowManager)
+{
+	m_pShadowManager = pShadowManager;
+}
+
+/***********************************************************
+ *  SetObjectFilter()
+ *
+ *  This method is used for choosing whether RenderScene
+ *  draws all of the objects, only the static objects or only
+ *  the dynamic objects.
+ ***********************************************************/
+void SceneManager::SetObjectFilter(OBJECT_FILTER filter)
+{
+	m_objectFilter = filter;
+}
+
+/***********************************************************
+ *  SetMaterialFilter()
+ *
+ *  This method is used for choosing whether RenderScene
+ *  draws the objects of all materials, only the opaque ones
+ *  or only the translucent ones.
+ ***********************************************************/
+void SceneManager::SetMaterialFilter(MATERIAL_FILTER filter)
+{
+	m_materialFilter = filter;
+}
+
+/***********************************************************
+ *  SetTranslucentSorting()
+ *
+ *  This method is used for turning on or off the drawing of
+ *  the translucent objects from back to front for the passed
+ *  in view matrix, when only they are drawn.
+ ***********************************************************/
+void SceneManager::SetTranslucentSorting(bool bSort, const glm::mat4& view)
+{
+	m_bSortTranslucent = bSort;
+	m_sortView = view;
+}
+
+/***********************************************************
+ *  SetDynamicObjects()
+ *
+ *  This method is used for turning the animation of the
+ *  objects with a motion on or off.  They are drawn with the
+ *  dynamic objects while they are animated.
+ ***********************************************************/
+void SceneManager::SetDynamicObjects(bool bAnimate)
+{
+	m_bAnimateObjects = bAnimate;
+}
+
+/***********************************************************
+ *  HasDynamicObjects()
+ *
+ *  This method is used for checking whether any of the
+ *  objects can move from one frame to the next, which needs
+ *  the animation on and an object with a motion.
+ ***********************************************************/
+bool SceneManager::HasDynamicObjects() const
+{
+	return((m_bAnimateObjects == true) && (m_bMotionObjects == true));
+}
+
+/***********************************************************
+ *  AnimateObjects()
+ *
+ *  This method is used for setting the time that the dynamic
+ *  objects are placed for when the scene is drawn.
+ ***********************************************************/
+void SceneManager::AnimateObjects(float time)
+{
+	m_objectTime = time;
+}
+
+/***********************************************************
+ *  SetLightmapManager()
+ *
+ *  This method is used for passing in the baked lightmaps
+ *  object that the static lights are added to.
+ ***********************************************************/
+void SceneManager::SetLightmapManager(LightmapManager* pLightmapManager)
+{
+	m_pLightmapManager = pLightmapManager;
+}
+
+/***********************************************************
+ *  SetJobSystem()
+ *
+ *  This method is used for passing in the job system that
+ *  the texture images are decoded on.
+ ***********************************************************/
+void SceneManager::SetJobSystem(JobSystem* pJobSystem)
+{
+	m_pJobSystem = pJobSystem;
+}
+
+
+
+/***********************************************************
+ *  PrepareScene()
+ *
+ *  This method is used for preparing the 3D scene by loading
+ *  the shapes in memory and reading the textures, materials,
+ *  lights and objects of the scene from the passed in scene
+ *  file.
+ ***********************************************************/
+void SceneManager::PrepareScene(const char* sceneFilename)
+{
+	AllocationTracker::BeginScope("PrepareScene");
+
+	// Enable blending for transparency
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	// Enable lighting
+	if (NULL != m_pShaderManager)
+	{
+		m_pShaderManager->setBoolValue(g_UseLightingName, true);
+	}
+
+	// only one instance of a particular mesh needs to be
+	// loaded in memory no matter how many times it is drawn
+	// in the rendered 3D scene
+
+	m_basicMeshes->LoadBoxMesh();
+	m_basicMeshes->LoadPlaneMesh();
+	m_basicMeshes->LoadCylinderMesh();
+	m_basicMeshes->LoadConeMesh();
+	m_basicMeshes->LoadPrismMesh();
+	m_basicMeshes->LoadPyramid4Mesh();
+	m_basicMeshes->LoadSphereMesh();
+	m_basicMeshes->LoadTaperedCylinderMesh();
+	m_basicMeshes->LoadTorusMesh();
+
+	// the textures, materials, lights and objects of the scene
+	LoadScene(sceneFilename);
+
+	AllocationTracker::EndScope();
+}
+
+/***********************************************************
+ *  RenderScene()
+ *
+ *  This method is used for rendering the 3D scene by
+ *  transforming and drawing the basic 3D shapes
+ ***********************************************************/
+void SceneManager::RenderScene()
+{
+	// drawing the scene must not touch the general heap
+	AllocationTracker::BeginNoAllocation("RenderScene");
+	AllocationTracker::BeginScope("RenderScene");
+	m_bRenderingScene = true;
+
+	// number the objects from zero again for this frame
+	m_drawCount = 0;
+	m_sortedObjects.clear();
+
+	// the objects with a motion are only dynamic while they are animated
+	bool bDrawStatic = (m_objectFilter != DRAW_DYNAMIC_OBJECTS);
+	bool bDrawDynamic = bDrawStatic;
+	if (m_bAnimateObjects == true)
+	{
+		bDrawDynamic = (m_objectFilter != DRAW_STATIC_OBJECTS);
+	}
+
+	// only the chunks of moved objects have their transforms calculated
+	MoveDynamicObjects();
+	m_pEntities->UpdateTransforms();
+
+	if (bDrawStatic == true)
+	{
+		m_pEntities->FindChunks(DRAWN_OBJECT_COMPONENTS, EntityManager::MASK_MOTION, m_drawChunks);
+		DrawObjectChunks(m_drawChunks);
+	}
+	if (bDrawDynamic == true)
+	{
+		m_pEntities->FindChunks(DRAWN_OBJECT_COMPONENTS | EntityManager::MASK_MOTION, 0, m_drawChunks);
+		DrawObjectChunks(m_drawChunks);
+	}
+
+	// the sorted translucent objects of both lists are drawn together
+	if (m_sortedObjects.empty() == false)
+	{
+		std::sort(m_sortedObjects.begin(), m_sortedObjects.end(), &SceneManager::IsFartherObject);
+		for (size_t i = 0; i < m_sortedObjects.size(); i++)
+		{
+			DrawObject(*m_sortedObjects[i].pChunk, m_sortedObjects[i].row);
+		}
+	}
+
+	// close the scope of the last object drawn
+	if (m_drawCount > 0)
+	{
+		AllocationTracker::EndScope();
+	}
+	m_bRenderingScene = false;
+	AllocationTracker::EndScope();
+	AllocationTracker::EndNoAllocation();
+}
+
+/***********************************************************
+ *  LoadScene()
+ *
+ *  This method is used for reading the passed in scene file
+ *  and applying what it changes to the live scene.  A file
+ *  that cannot be read or has errors leaves the scene as it
+ *  was, so a half written file is never shown.
+ ***********************************************************/
+bool SceneManager::LoadScene(const char* filename)
+{
+	if (m_sceneFile.Load(filename, m_sceneDescription) == false)
+	{
+		std::cout << "ERROR: Scene " << filename << " was not applied" << std::endl;
+		return(false);
+	}
+
+	ApplyScene(m_sceneDescription);
+
+	std::cout << "INFO: Scene " << filename
+		<< " read in " << m_sceneFile.GetLastLoadMilliseconds() << " ms"
+		<< ", applied in " << m_lastApplyMilliseconds << " ms: "
+		<< m_lastSceneChanges.addedObjects << " objects added, "
+		<< m_lastSceneChanges.changedObjects << " changed, "
+		<< m_lastSceneChanges.removedObjects << " removed, "
+		<< m_lastSceneChanges.changedTextures << " textures and "
+		<< m_lastSceneChanges.changedMaterials << " materials changed"
+		<< ((m_lastSceneChanges.bLightsChanged == true) ? ", lights changed" : "") << std::endl;
+	return(true);
+}
+
+/***********************************************************
+ *  ReloadScene()
+ *
+ *  This method is used for reading the scene file that was
+ *  last read again.
+ ***********************************************************/
+bool SceneManager::ReloadScene()
+{
+	// the name is kept by the scene file, which a read replaces
+	std::string filename = m_sceneFile.GetFilename();
+	return(LoadScene(filename.c_str()));
+}
+
+/***********************************************************
+ *  HasSceneFileChanged()
+ *
+ *  This method is used for checking whether the scene file
+ *  was written since it was last read.  It only reads the
+ *  modification time and size of the file, so it can be
+ *  called often.
+ ***********************************************************/
+bool SceneManager::HasSceneFileChanged() const
+{
+	return(m_sceneFile.HasFileChanged());
+}
+
+/***********************************************************
+ *  GetLastSceneChanges()
+ *
+ *  This method is used for getting what the last scene file
+ *  read changed in the live scene.
+ ***********************************************************/
+const SceneManager::SCENE_CHANGES& SceneManager::GetLastSceneChanges() const
+{
+	return(m_lastSceneChanges);
+}
+
+/***********************************************************
+ *  GetLastSceneLoadMilliseconds()
+ *
+ *  This method is used for getting the CPU time of reading
+ *  the scene file the last time.
+ ***********************************************************/
+double SceneManager::GetLastSceneLoadMilliseconds() const
+{
+	return(m_sceneFile.GetLastLoadMilliseconds());
+}
+
+/***********************************************************
+ *  GetLastSceneApplyMilliseconds()
+ *
+ *  This method is used for getting the CPU time of applying
+ *  the last scene file read to the live scene.
+ ***********************************************************/
+double SceneManager::GetLastSceneApplyMilliseconds() const
+{
+	return(m_lastApplyMilliseconds);
+}
+
+/***********************************************************
+ *  GetSceneObjectCount()
+ *
+ *  This method is used for getting the number of objects in
+ *  the scene.
+ ***********************************************************/
+int SceneManager::GetSceneObjectCount() const
+{
+	return(m_pEntities->GetEntityCount());
+}
@@ -1,112 +1,324 @@
-///////////////////////////////////////////////////////////////////////////////
-// scenemanager.h
-// ============
-// manage the preparing and rendering of 3D scenes - textures, materials, lighting
-//
-//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
-//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
-///////////////////////////////////////////////////////////////////////////////
-
-#pragma once
-
-#include "ShaderManager.h"
-#include "ShapeMeshes.h"
-
-#include <string>
-#include <vector>
-
-/***********************************************************
- *  SceneManager
- *
- *  This class contains the code for preparing and rendering
- *  3D scenes, including the shader settings.
- ***********************************************************/
-class SceneManager
-{
-public:
-	// constructor
-	SceneManager(ShaderManager* pShaderManager);
-	// destructor
-	~SceneManager();
-
-	struct TEXTURE_INFO
-	{
-		std::string tag;
-		uint32_t ID;
-	};
-
-	struct OBJECT_MATERIAL
-	{
-		float ambientStrength;
-		glm::vec3 ambientColor;
-		glm::vec3 diffuseColor;
-		glm::vec3 specularColor;
-		float shininess;
-		std::string tag;
-	};
-
-private:
-	// pointer to shader manager object
-	ShaderManager* m_pShaderManager;
-	// pointer to basic shapes object
-	ShapeMeshes* m_basicMeshes;
-	// total number of loaded textures
-	int m_loadedTextures;
-	// loaded textures info
-	TEXTURE_INFO m_textureIDs[16];
-	// defined object materials
-	std::vector<OBJECT_MATERIAL> m_objectMaterials;
-
-	// load texture images and convert to OpenGL texture data
-	bool CreateGLTexture(const char* filename, std::string tag);
-	// bind loaded OpenGL textures to slots in memory
-	void BindGLTextures();
-	// free the loaded OpenGL textures
-	void DestroyGLTextures();
-	// find a loaded texture by tag
-	int FindTextureID(std::string tag);
-	int FindTextureSlot(std::string tag);
-	// find a defined material by tag
-	bool FindMaterial(std::string tag, OBJECT_MATERIAL& material);
-
-	// set the transformation values 
-	// into the transform buffer
-	void SetTransformations(
-		glm::vec3 scaleXYZ,
-		float XrotationDegrees,
-		float YrotationDegrees,
-		float ZrotationDegrees,
-		glm::vec3 positionXYZ);
-
-	// set the color values into the shader
-	void SetShaderColor(
-		float redColorValue,
-		float greenColorValue,
-		float blueColorValue,
-		float alphaValue);
-
-	// set the texture data into the shader
-	void SetShaderTexture(
-		std::string textureTag);
-
-	// set the UV scale for the texture mapping
-	void SetTextureUVScale(
-		float u, float v);
-
-	// set the object material into the shader
-	void SetShaderMaterial(
-		std::string materialTag);
-
-public:
-
-	// The following methods are for the students to 
-	// customize for their own 3D scene
-	void PrepareScene();
-	void RenderScene();
-	// load all of the needed textures before rendering
-	void LoadSceneTextures();
-	// define all the object materials before rendering
-	void DefineObjectMaterials();
-	// add and define the light sources before rendering
-	void SetupSceneLights();
+///////////////////////////////////////////////////////////////////////////////
+// scenemanager.h
+// ============
+// manage the preparing and rendering of 3D scenes - textures, materials, lighting
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+#include "ShapeMeshes.h"
+#include "LightManager.h"
+#include "HandlePool.h"
+#include "EntityManager.h"
+#include "SceneFile.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ShadowManager;
+class LightmapManager;
+class JobSystem;
+
+/***********************************************************
+ *  SceneManager
+ *
+ *  This class contains the code for preparing and rendering
+ *  3D scenes, including the shader settings.  The textures,
+ *  materials, lights and objects of the scene are read from
+ *  a scene file.  When the file is read again, only what
+ *  changed is applied to the live scene: objects are matched
+ *  by name, so unchanged objects keep their entities and only
+ *  the chunks of moved objects have their transforms
+ *  calculated again.
+ ***********************************************************/
+class SceneManager
+{
+public:
+	// constructor
+	SceneManager(ShaderManager* pShaderManager);
+	// destructor
+	~SceneManager();
+
+	struct TEXTURE_INFO
+	{
+		char tag[SceneFile::MAX_NAME_LENGTH];
+		char filename[SceneFile::MAX_PATH_LENGTH];
+		uint32_t ID;
+	};
+
+	struct OBJECT_MATERIAL
+	{
+		glm::vec3 diffuseColor;
+		glm::vec3 specularColor;
+		float shininess;
+		char tag[SceneFile::MAX_NAME_LENGTH];
+		// below one the object is drawn with the translucent objects
+		float opacity = 1.0f;
+	};
+
+	// what the last scene file read changed in the live scene
+	struct SCENE_CHANGES
+	{
+		int addedObjects;
+		int changedObjects;
+		int removedObjects;
+		int changedTextures;
+		int changedMaterials;
+		bool bLightsChanged;
+	};
+
+	// objects drawn by RenderScene, for passes that cache the static ones
+	enum OBJECT_FILTER
+	{
+		DRAW_ALL_OBJECTS,
+		DRAW_STATIC_OBJECTS,
+		DRAW_DYNAMIC_OBJECTS
+	};
+
+	// objects drawn by RenderScene by their material, for the passes
+	// that draw the opaque and the translucent objects apart
+	enum MATERIAL_FILTER
+	{
+		DRAW_ALL_MATERIALS,
+		DRAW_OPAQUE_MATERIALS,
+		DRAW_TRANSLUCENT_MATERIALS
+	};
+
+	// most loaded textures, one for each texture unit they are bound to
+	static const int MAX_TEXTURES = 16;
+	// most defined object materials
+	static const int MAX_MATERIALS = 32;
+	// objects the scene has room for, until a scene file needs more
+	static const int SCENE_OBJECT_CAPACITY = 256;
+	// point lights of the default shader, must match the shaders
+	static const int MAX_SHADER_POINT_LIGHTS = 5;
+
+private:
+	// pointer to shader manager object
+	ShaderManager* m_pShaderManager;
+	// pointer to basic shapes object
+	ShapeMeshes* m_basicMeshes;
+	// loaded textures info, packed so that each is bound to the
+	// texture unit of its position
+	HandlePool<TEXTURE_INFO> m_textures;
+	// defined object materials
+	HandlePool<OBJECT_MATERIAL> m_objectMaterials;
+	// pointer to the buffered lights object, when it is used
+	LightManager* m_pLightManager;
+	// number of objects transformed so far in the current frame
+	int m_drawCount;
+	// true while RenderScene() counts the allocations of each object
+	bool m_bRenderingScene;
+	// pointer to the shadow maps object, when it is used
+	ShadowManager* m_pShadowManager;
+	// objects that are drawn by RenderScene
+	OBJECT_FILTER m_objectFilter;
+	// true when the objects with a motion are animated and treated
+	// as dynamic objects
+	bool m_bAnimateObjects;
+	// time the dynamic objects are placed for
+	float m_objectTime;
+	// pointer to the baked lightmaps object, when it is used
+	LightmapManager* m_pLightmapManager;
+	// true when each object gets the list of lights that reach it
+	bool m_bObjectLightLists;
+	// pointer to the job system the textures are decoded on, when it is used
+	JobSystem* m_pJobSystem;
+	// objects of the scene, stored as entities
+	EntityManager* m_pEntities;
+	// chunks of the objects drawn by RenderScene, kept so that
+	// listing them does not allocate
+	std::vector<EntityManager::CHUNK*> m_drawChunks;
+	// offset the dynamic objects are currently moved by
+	glm::vec3 m_motionOffset;
+	// true when any object of the scene has a motion
+	bool m_bMotionObjects;
+	// materials of the objects that are drawn by RenderScene
+	MATERIAL_FILTER m_materialFilter;
+	// true when the translucent objects are drawn from back to front
+	// for the view matrix
+	bool m_bSortTranslucent;
+	glm::mat4 m_sortView;
+	// object of a chunk and its view depth, for drawing the translucent
+	// objects in order
+	struct SORTED_OBJECT
+	{
+		float depth;
+		const EntityManager::CHUNK* pChunk;
+		int row;
+	};
+	// translucent objects of the frame being sorted, kept so that
+	// sorting them does not allocate
+	std::vector<SORTED_OBJECT> m_sortedObjects;
+	// number of benchmark lights added after the scene lights
+	int m_benchmarkLightCount;
+
+	// entity of a named object and the scene file read it was
+	// last found in
+	struct SCENE_OBJECT
+	{
+		unsigned int entity;
+		unsigned int loadNumber;
+	};
+	// scene file and the description last read from it, kept so
+	// that reading it again reuses the memory
+	SceneFile m_sceneFile;
+	SceneFile::SCENE_DESC m_sceneDescription;
+	// objects of the scene by name
+	std::unordered_map<std::string, SCENE_OBJECT> m_sceneObjects;
+	// number of the last scene file read that was applied
+	unsigned int m_loadNumber;
+	// lights of the last applied description
+	std::vector<SceneFile::LIGHT_DESC> m_sceneLights;
+	// texture slot and material handle of each texture and material
+	// of the description, and the entity each object was matched to
+	std::vector<int> m_textureSlots;
+	std::vector<unsigned int> m_materialHandles;
+	std::vector<unsigned int> m_objectEntities;
+	// what the last scene file read changed, and the CPU time of
+	// applying it
+	SCENE_CHANGES m_lastSceneChanges;
+	double m_lastApplyMilliseconds;
+
+	// texture image read from its file, before it is uploaded
+	struct DECODED_IMAGE
+	{
+		const char* filename;
+		const char* tag;
+		unsigned char* pPixels;
+		int width;
+		int height;
+		int colorChannels;
+	};
+
+	// read the pixels of texture images, on any thread
+	static void DecodeImage(DECODED_IMAGE& image);
+	static void DecodeImageJob(void* pOwner, size_t first, size_t count);
+	// convert a read image to OpenGL texture data
+	GLuint UploadGLTexture(DECODED_IMAGE& image);
+	// add an uploaded texture to the loaded textures
+	bool RegisterGLTexture(GLuint textureID, const char* filename, const char* tag);
+	// load texture images and convert to OpenGL texture data
+	bool CreateGLTexture(const char* filename, const char* tag);
+	// bind loaded OpenGL textures to slots in memory
+	void BindGLTextures();
+	// free the loaded OpenGL textures
+	void DestroyGLTextures();
+	// find a loaded texture by tag
+	int FindTextureID(const char* tag);
+	int FindTextureSlot(const char* tag);
+	// find the handle of a defined material by tag
+	unsigned int FindMaterial(const char* tag);
+	// add a material to the defined materials
+	unsigned int AddMaterial(const OBJECT_MATERIAL& material);
+
+	// set the world matrix of the next object into the shader
+	void SetTransformations(
+		const glm::mat4& modelView,
+		const EntityManager::BOUNDS& bounds);
+
+	// set the color values into the shader
+	void SetShaderColor(
+		float redColorValue,
+		float greenColorValue,
+		float blueColorValue,
+		float alphaValue);
+
+	// set the texture of a texture slot into the shader
+	void SetShaderTexture(
+		int textureSlot);
+
+	// set the UV scale for the texture mapping
+	void SetTextureUVScale(
+		float u, float v);
+
+	// set the object material into the shader
+	void SetShaderMaterial(
+		unsigned int material);
+
+	// apply a scene description to the live scene, changing only
+	// what differs from it
+	void ApplyScene(const SceneFile::SCENE_DESC& scene);
+	int ApplyTextures(const SceneFile::SCENE_DESC& scene);
+	int ApplyMaterials(const SceneFile::SCENE_DESC& scene);
+	bool ApplyLights(const SceneFile::SCENE_DESC& scene);
+	void ApplyObjects(const SceneFile::SCENE_DESC& scene);
+	// add an object of the description as an entity
+	unsigned int CreateSceneObject(const SceneFile::OBJECT_DESC& object);
+	// change the components of an entity that differ from its
+	// object in the description, true when any did
+	bool UpdateSceneObject(unsigned int entity, const SceneFile::OBJECT_DESC& object);
+	// get the texture slot and material handle of an object
+	int GetObjectTextureSlot(const SceneFile::OBJECT_DESC& object) const;
+	unsigned int GetObjectMaterial(const SceneFile::OBJECT_DESC& object) const;
+	// check whether two lights of a description are the same
+	static bool IsSameLight(const SceneFile::LIGHT_DESC& first, const SceneFile::LIGHT_DESC& second);
+	// move the dynamic objects to where they are at the current time
+	void MoveDynamicObjects();
+	// draw the objects of a list of chunks in their order
+	void DrawObjectChunks(const std::vector<EntityManager::CHUNK*>& chunks);
+	// draw one object of a chunk
+	void DrawObject(const EntityManager::CHUNK& chunk, int row);
+	// check whether the objects of a material pass the material filter
+	bool IsMaterialDrawn(unsigned int material) const;
+	// order the sorted objects from the farthest to the nearest
+	static bool IsFartherObject(const SORTED_OBJECT& first, const SORTED_OBJECT& second);
+
+public:
+
+	// The following methods are for the students to 
+	// customize for their own 3D scene
+	void PrepareScene(const char* sceneFilename);
+	void RenderScene();
+	// read a scene file and apply what it changes to the scene,
+	// false when it could not be read and nothing was changed
+	bool LoadScene(const char* filename);
+	// read the scene file again
+	bool ReloadScene();
+	// check whether the scene file was written since it was read
+	bool HasSceneFileChanged() const;
+	// get what the last scene file read changed, and the CPU
+	// time of reading and of applying it
+	const SCENE_CHANGES& GetLastSceneChanges() const;
+	double GetLastSceneLoadMilliseconds() const;
+	double GetLastSceneApplyMilliseconds() const;
+	// get the number of objects in the scene
+	int GetSceneObjectCount() const;
+
+	// change the shader that the scene is drawn with
+	void SetShaderManager(ShaderManager* pShaderManager);
+	// store the point and spot lights in a light buffer
+	void SetLightManager(LightManager* pLightManager);
+	// add randomly placed animated lights for benchmarking
+	void CreateBenchmarkLights(int lightCount);
+	// move the animated lights for the current time
+	void AnimateLights(float time);
+	// turn the per object light lists of the shading pass on or off
+	void SetObjectLightLists(bool bEnabled);
+
+	// add the shadow casting lights to a shadow maps object
+	void SetShadowManager(ShadowManager* pShadowManager);
+	// choose which objects RenderScene draws
+	void SetObjectFilter(OBJECT_FILTER filter);
+	// choose the materials of the objects RenderScene draws
+	void SetMaterialFilter(MATERIAL_FILTER filter);
+	// draw the translucent objects from back to front for a view,
+	// rather than in the order of the scene
+	void SetTranslucentSorting(bool bSort, const glm::mat4& view);
+	// turn the animation of the dynamic objects on or off
+	void SetDynamicObjects(bool bAnimate);
+	// check whether any object moves from frame to frame
+	bool HasDynamicObjects() const;
+	// move the dynamic objects for the current time
+	void AnimateObjects(float time);
+
+	// add the static lights to a baked lightmaps object
+	void SetLightmapManager(LightmapManager* pLightmapManager);
+	// decode the texture images on a job system
+	void SetJobSystem(JobSystem* pJobSystem);
 };
\ No newline at end of file
@@ -0,0 +1,702 @@
+///////////////////////////////////////////////////////////////////////////////
+// shadowmanager.cpp
+// ============
+// manage the cached shadow maps - directional cascades and point light cubes
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ShadowManager.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+// declare the global variables
+namespace
+{
+	const char* g_ViewName = "view";
+	const char* g_ProjectionName = "projection";
+	const char* g_UseShadowsName = "bUseShadows";
+	const std::string g_DirectionalShadowMapName = "directionalShadowMap";
+	const std::string g_UseDirectionalShadowName = "bUseDirectionalShadow";
+
+	// farthest view distance that the cascades cover
+	const float SHADOW_DISTANCE = 40.0f;
+	// blend between logarithmic and even cascade splits
+	const float SPLIT_LAMBDA = 0.75f;
+	// how much larger than the view slice each cascade is drawn, so
+	// that the view can move a little before it has to be drawn again
+	const float CASCADE_GUARD_BAND = 1.25f;
+	// distance toward the light that objects still cast shadows from
+	const float SHADOW_CASTER_DISTANCE = 50.0f;
+	// near plane of the cube map faces, must match the shaders
+	const float POINT_SHADOW_NEAR_PLANE = 0.1f;
+
+	// look direction and up vector of each cube map face
+	const glm::vec3 CUBE_FACE_DIRECTIONS[6] =
+	{
+		glm::vec3(1.0f, 0.0f, 0.0f),
+		glm::vec3(-1.0f, 0.0f, 0.0f),
+		glm::vec3(0.0f, 1.0f, 0.0f),
+		glm::vec3(0.0f, -1.0f, 0.0f),
+		glm::vec3(0.0f, 0.0f, 1.0f),
+		glm::vec3(0.0f, 0.0f, -1.0f)
+	};
+	const glm::vec3 CUBE_FACE_UPS[6] =
+	{
+		glm::vec3(0.0f, -1.0f, 0.0f),
+		glm::vec3(0.0f, -1.0f, 0.0f),
+		glm::vec3(0.0f, 0.0f, 1.0f),
+		glm::vec3(0.0f, 0.0f, -1.0f),
+		glm::vec3(0.0f, -1.0f, 0.0f),
+		glm::vec3(0.0f, -1.0f, 0.0f)
+	};
+}
+
+/***********************************************************
+ *  ShadowManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ShadowManager::ShadowManager()
+{
+	m_staticCascadeTexture = 0;
+	m_dynamicCascadeTexture = 0;
+	for (int i = 0; i < MAX_SHADOW_POINT_LIGHTS; i++)
+	{
+		m_staticCubeTextures[i] = 0;
+		m_dynamicCubeTextures[i] = 0;
+	}
+	m_drawFramebuffer = 0;
+	m_readFramebuffer = 0;
+	m_pDepthShader = NULL;
+	m_lightDirection = glm::vec3(0.0f);
+	m_lightView = glm::mat4(1.0f);
+	for (int i = 0; i < CASCADE_COUNT; i++)
+	{
+		m_cascades[i].center = glm::vec3(0.0f);
+		m_cascades[i].halfExtent = 0.0f;
+		m_cascades[i].splitDepth = 0.0f;
+		m_cascades[i].matrix = glm::mat4(1.0f);
+		m_cascades[i].bValid = false;
+
+		std::string index = "[" + std::to_string(i) + "]";
+		m_cascadeMatrixNames[i] = "cascadeMatrices" + index;
+		m_cascadeSplitNames[i] = "cascadeSplits" + index;
+	}
+	for (int i = 0; i < MAX_SHADOW_POINT_LIGHTS; i++)
+	{
+		std::string prefix = "pointShadows[" + std::to_string(i) + "].";
+		m_pointMapNames[i] = "pointShadowMaps[" + std::to_string(i) + "]";
+		m_pointActiveNames[i] = prefix + "bActive";
+		m_pointPositionNames[i] = prefix + "position";
+		m_pointFarPlaneNames[i] = prefix + "farPlane";
+	}
+	m_bUseDynamicMaps = false;
+	m_bEnabled = true;
+	m_lastDrawnMapCount = 0;
+}
+
+/***********************************************************
+ *  ~ShadowManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ShadowManager::~ShadowManager()
+{
+	DestroyShadowMaps();
+
+	if (NULL != m_pDepthShader)
+	{
+		delete m_pDepthShader;
+		m_pDepthShader = NULL;
+	}
+}
+
+/***********************************************************
+ *  CreateCascadeTexture()
+ *
+ *  This method is used for creating a depth texture array
+ *  with one layer for each cascade.  The texture compares
+ *  the depths when it is sampled, and everything outside of
+ *  a cascade is lit.
+ ***********************************************************/
+GLuint ShadowManager::CreateCascadeTexture()
+{
+	const float borderColor[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	GLuint textureID = 0;
+
+	glGenTextures(1, &textureID);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, textureID);
+	glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT24, CASCADE_SIZE, CASCADE_SIZE, CASCADE_COUNT, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+	glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, borderColor);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+	return(textureID);
+}
+
+/***********************************************************
+ *  CreateCubeTexture()
+ *
+ *  This method is used for creating a depth cube map for one
+ *  point light.  The texture compares the depths when it is
+ *  sampled.
+ ***********************************************************/
+GLuint ShadowManager::CreateCubeTexture()
+{
+	GLuint textureID = 0;
+
+	glGenTextures(1, &textureID);
+	glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+	for (int face = 0; face < 6; face++)
+	{
+		glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, GL_DEPTH_COMPONENT24, CUBE_SIZE, CUBE_SIZE, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+	}
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+	glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+	return(textureID);
+}
+
+/***********************************************************
+ *  CreateShadowMaps()
+ *
+ *  This method is used for creating the cached and dynamic
+ *  shadow maps and the framebuffers that they are drawn
+ *  and copied with.
+ ***********************************************************/
+bool ShadowManager::CreateShadowMaps()
+{
+	m_staticCascadeTexture = CreateCascadeTexture();
+	m_dynamicCascadeTexture = CreateCascadeTexture();
+	for (int i = 0; i < MAX_SHADOW_POINT_LIGHTS; i++)
+	{
+		m_staticCubeTextures[i] = CreateCubeTexture();
+		m_dynamicCubeTextures[i] = CreateCubeTexture();
+	}
+
+	// only the depth is drawn and copied
+	glGenFramebuffers(1, &m_drawFramebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_drawFramebuffer);
+	glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_staticCascadeTexture, 0, 0);
+	glDrawBuffer(GL_NONE);
+	glReadBuffer(GL_NONE);
+
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+
+	glGenFramebuffers(1, &m_readFramebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_readFramebuffer);
+	glDrawBuffer(GL_NONE);
+	glReadBuffer(GL_NONE);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	// filter across the cube map faces when the shadows are sampled
+	glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cout << "Shadow map framebuffer is not complete, status:" << status << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+/***********************************************************
+ *  DestroyShadowMaps()
+ *
+ *  This method is used for freeing the shadow map textures
+ *  and framebuffers.
+ ***********************************************************/
+void ShadowManager::DestroyShadowMaps()
+{
+	if (m_drawFramebuffer != 0)
+	{
+		glDeleteFramebuffers(1, &m_drawFramebuffer);
+		glDeleteFramebuffers(1, &m_readFramebuffer);
+		m_drawFramebuffer = 0;
+		m_readFramebuffer = 0;
+	}
+	if (m_staticCascadeTexture != 0)
+	{
+		glDeleteTextures(1, &m_staticCascadeTexture);
+		glDeleteTextures(1, &m_dynamicCascadeTexture);
+		glDeleteTextures(MAX_SHADOW_POINT_LIGHTS, m_staticCubeTextures);
+		glDeleteTextures(MAX_SHADOW_POINT_LIGHTS, m_dynamicCubeTextures);
+		m_staticCascadeTexture = 0;
+		m_dynamicCascadeTexture = 0;
+		for (int i = 0; i < MAX_SHADOW_POINT_LIGHTS; i++)
+		{
+			m_staticCubeTextures[i] = 0;
+			m_dynamicCubeTextures[i] = 0;
+		}
+	}
+}
+
+/***********************************************************
+ *  LoadShaders()
+ *
+ *  This method is used for loading the position only depth
+ *  shader that the shadow casting objects are drawn with.
+ ***********************************************************/
+bool ShadowManager::LoadShaders()
+{
+	m_pDepthShader = new ShaderManager();
+	m_pDepthShader->LoadShaders(
+		"shaders/depthVertexShader.glsl",
+		"shaders/depthFragmentShader.glsl");
+
+	return(true);
+}
+
+/***********************************************************
+ *  SetDirectionalLight()
+ *
+ *  This method is used for setting the direction of the
+ *  directional light that casts the cascaded shadows.  The
+ *  cascades are drawn again when the direction changes.
+ ***********************************************************/
+void ShadowManager::SetDirectionalLight(glm::vec3 direction)
+{
+	m_lightDirection = glm::normalize(direction);
+
+	// any up vector that is not parallel to the light will do
+	glm::vec3 up = glm::vec3(0.0f, 1.0f, 0.0f);
+	if (std::abs(m_lightDirection.y) > 0.99f)
+	{
+		up = glm::vec3(0.0f, 0.0f, 1.0f);
+	}
+	m_lightView = glm::lookAt(glm::vec3(0.0f), m_lightDirection, up);
+
+	for (int i = 0; i < CASCADE_COUNT; i++)
+	{
+		m_cascades[i].bValid = false;
+	}
+}
+
+/***********************************************************
+ *  AddPointLight()
+ *
+ *  This method is used for adding a point light that casts
+ *  shadows into a cube map, as far as the light reaches.
+ *  Only the first MAX_SHADOW_POINT_LIGHTS lights are kept.
+ ***********************************************************/
+int ShadowManager::AddPointLight(glm::vec3 position, float radius)
+{
+	if (m_pointLights.size() >= MAX_SHADOW_POINT_LIGHTS)
+	{
+		return(-1);
+	}
+
+	SHADOW_POINT_LIGHT light;
+	light.position = position;
+	light.farPlane = radius;
+	light.bValid = false;
+	m_pointLights.push_back(light);
+
+	return((int)m_pointLights.size() - 1);
+}
+
+/***********************************************************
+ *  ClearLights()
+ *
+ *  This method is used for removing all of the shadow
+ *  casting lights.
+ ***********************************************************/
+void ShadowManager::ClearLights()
+{
+	m_lightDirection = glm::vec3(0.0f);
+	m_pointLights.clear();
+	for (int i = 0; i < CASCADE_COUNT; i++)
+	{
+		m_cascades[i].bValid = false;
+	}
+}
+
+/***********************************************************
+ *  InvalidateMaps()
+ *
+ *  This method is used for marking the cached maps of the
+ *  cascades and the point lights as out of date, so they
+ *  are drawn again with the next update.  It is needed when
+ *  static objects were added, moved or removed.
+ ***********************************************************/
+void ShadowManager::InvalidateMaps()
+{
+	for (int i = 0; i < CASCADE_COUNT; i++)
+	{
+		m_cascades[i].bValid = false;
+	}
+	for (size_t i = 0; i < m_pointLights.size(); i++)
+	{
+		m_pointLights[i].bValid = false;
+	}
+}
+
+/***********************************************************
+ *  SetEnabled()
+ *
+ *  This method is used for turning the shadows in the
+ *  shading pass on or off.  No maps are drawn while the
+ *  shadows are off.
+ ***********************************************************/
+void ShadowManager::SetEnabled(bool bEnabled)
+{
+	m_bEnabled = bEnabled;
+}
+
+/***********************************************************
+ *  GetLastDrawnMapCount()
+ *
+ *  This method is used for getting the number of cascades
+ *  and cube map faces that were drawn during the last
+ *  update, which is zero when nothing moved.
+ ***********************************************************/
+int ShadowManager::GetLastDrawnMapCount() const
+{
+	return(m_lastDrawnMapCount);
+}
+
+/***********************************************************
+ *  CalculateSplitDepths()
+ *
+ *  This method is used for calculating the view distance
+ *  where each cascade ends, blending logarithmic splits
+ *  near the camera with even splits further away.
+ ***********************************************************/
+void ShadowManager::CalculateSplitDepths(float nearPlane, float farPlane, float splitDepths[]) const
+{
+	float shadowFar = std::min(farPlane, SHADOW_DISTANCE);
+
+	for (int i = 0; i < CASCADE_COUNT; i++)
+	{
+		float fraction = (float)(i + 1) / CASCADE_COUNT;
+		float logSplit = nearPlane * std::pow(shadowFar / nearPlane, fraction);
+		float evenSplit = nearPlane + ((shadowFar - nearPlane) * fraction);
+
+		splitDepths[i] = (SPLIT_LAMBDA * logSplit) + ((1.0f - SPLIT_LAMBDA) * evenSplit);
+	}
+}
+
+/***********************************************************
+ *  CalculateSliceBounds()
+ *
+ *  This method is used for calculating the bounding sphere
+ *  of the part of the view frustum between two distances.
+ *  The sphere only depends on the distances and the field of
+ *  view, so its size does not change when the camera turns.
+ ***********************************************************/
+void ShadowManager::CalculateSliceBounds(
+	const glm::mat4& view,
+	const glm::mat4& projection,
+	float sliceNear,
+	float sliceFar,
+	glm::vec3& center,
+	float& radius) const
+{
+	// half of the frustum diagonal for each unit of distance
+	float tanHalfFovY = 1.0f / projection[1][1];
+	float tanHalfFovX = 1.0f / projection[0][0];
+	float slope2 = (tanHalfFovX * tanHalfFovX) + (tanHalfFovY * tanHalfFovY);
+
+	// the center lies on the view axis, as close to the far
+	// corners as it needs to be to also reach the near corners
+	float centerDepth = 0.5f * (sliceNear + sliceFar) * (1.0f + slope2);
+	if (centerDepth > sliceFar)
+	{
+		centerDepth = sliceFar;
+		radius = sliceFar * std::sqrt(slope2);
+	}
+	else
+	{
+		float depthToFar = sliceFar - centerDepth;
+		radius = std::sqrt((depthToFar * depthToFar) + (sliceFar * sliceFar * slope2));
+	}
+
+	center = glm::vec3(glm::inverse(view) * glm::vec4(0.0f, 0.0f, -centerDepth, 1.0f));
+}
+
+/***********************************************************
+ *  PlaceCascade()
+ *
+ *  This method is used for checking whether the view slice
+ *  of a cascade is still inside the area that the cascade
+ *  was drawn for.  When it is not, the cascade is moved to
+ *  the slice with a guard band around it, snapped to whole
+ *  texels so the shadow edges do not shimmer, and true is
+ *  returned so that it gets drawn again.
+ ***********************************************************/
+bool ShadowManager::PlaceCascade(int index, const glm::vec3& lightSpaceCenter, float radius)
+{
+	CASCADE& cascade = m_cascades[index];
+
+	if (cascade.bValid == true)
+	{
+		glm::vec3 offset = glm::abs(lightSpaceCenter - cascade.center);
+		float maxOffset = std::max(offset.x, std::max(offset.y, offset.z));
+
+		if (maxOffset + radius <= cascade.halfExtent)
+		{
+			return(false);
+		}
+	}
+
+	float halfExtent = radius * CASCADE_GUARD_BAND;
+	float texelSize = (2.0f * halfExtent) / CASCADE_SIZE;
+	glm::vec3 center = glm::floor(lightSpaceCenter / texelSize) * texelSize;
+	float depthExtent = halfExtent + SHADOW_CASTER_DISTANCE;
+
+	glm::mat4 projection = glm::ortho(
+		center.x - halfExtent, center.x + halfExtent,
+		center.y - halfExtent, center.y + halfExtent,
+		-(center.z + depthExtent), -(center.z - depthExtent));
+
+	cascade.center = center;
+	cascade.halfExtent = halfExtent;
+	cascade.matrix = projection * m_lightView;
+	cascade.bValid = true;
+
+	return(true);
+}
+
+/***********************************************************
+ *  GetCubeFaceMatrix()
+ *
+ *  This method is used for calculating the view projection
+ *  matrix of one face of a point light cube map.
+ ***********************************************************/
+glm::mat4 ShadowManager::GetCubeFaceMatrix(const SHADOW_POINT_LIGHT& light, int face) const
+{
+	glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, POINT_SHADOW_NEAR_PLANE, light.farPlane);
+	glm::mat4 view = glm::lookAt(light.position, light.position + CUBE_FACE_DIRECTIONS[face], CUBE_FACE_UPS[face]);
+
+	return(projection * view);
+}
+
+/***********************************************************
+ *  BeginMap()
+ *
+ *  This method is used for attaching one cascade layer or
+ *  cube map face to the framebuffer and setting its view
+ *  projection matrix into the depth shader.
+ ***********************************************************/
+void ShadowManager::BeginMap(GLenum target, GLuint texture, int layer, int size, const glm::mat4& matrix, bool bClear)
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, m_drawFramebuffer);
+	if (target == GL_TEXTURE_CUBE_MAP)
+	{
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_CUBE_MAP_POSITIVE_X + layer, texture, 0);
+	}
+	else
+	{
+		glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, texture, 0, layer);
+	}
+	glViewport(0, 0, size, size);
+
+	if (bClear == true)
+	{
+		glClear(GL_DEPTH_BUFFER_BIT);
+	}
+
+	m_pDepthShader->setMat4Value(g_ViewName, matrix);
+	m_pDepthShader->setMat4Value(g_ProjectionName, glm::mat4(1.0f));
+}
+
+/***********************************************************
+ *  CopyMap()
+ *
+ *  This method is used for copying one cascade layer or
+ *  cube map face of a cached map into a dynamic map, so the
+ *  dynamic objects can be drawn over the static ones.
+ ***********************************************************/
+void ShadowManager::CopyMap(GLenum target, GLuint source, GLuint destination, int layer, int size)
+{
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, m_readFramebuffer);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_drawFramebuffer);
+	if (target == GL_TEXTURE_CUBE_MAP)
+	{
+		glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_CUBE_MAP_POSITIVE_X + layer, source, 0);
+		glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_CUBE_MAP_POSITIVE_X + layer, destination, 0);
+	}
+	else
+	{
+		glFramebufferTextureLayer(GL_READ_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, source, 0, layer);
+		glFramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, destination, 0, layer);
+	}
+
+	glBlitFramebuffer(0, 0, size, size, 0, 0, size, size, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+}
+
+/***********************************************************
+ *  RenderShadowMaps()
+ *
+ *  This method is used for bringing the shadow maps up to
+ *  date for the current view.  The static objects are only
+ *  drawn into the cached maps that are no longer valid.  The
+ *  dynamic objects, when there are any, are drawn over a
+ *  copy of the cached maps every frame.
+ ***********************************************************/
+void ShadowManager::RenderShadowMaps(
+	SceneManager* pSceneManager,
+	const glm::mat4& view,
+	const glm::mat4& projection,
+	float nearPlane,
+	float farPlane)
+{
+	m_lastDrawnMapCount = 0;
+	m_bUseDynamicMaps = false;
+	if (m_bEnabled == false)
+	{
+		return;
+	}
+
+	bool bDynamic = pSceneManager->HasDynamicObjects();
+	GLint viewport[4];
+
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	glEnable(GL_DEPTH_TEST);
+	glDepthFunc(GL_LESS);
+	glDepthMask(GL_TRUE);
+	// push the depths back by the slope of each triangle to stop
+	// the surfaces from shadowing themselves
+	glEnable(GL_POLYGON_OFFSET_FILL);
+	glPolygonOffset(2.0f, 4.0f);
+
+	m_pDepthShader->use();
+	pSceneManager->SetShaderManager(m_pDepthShader);
+
+	// cascades of the directional light
+	if (m_lightDirection != glm::vec3(0.0f))
+	{
+		float splitDepths[CASCADE_COUNT];
+		float sliceNear = nearPlane;
+
+		CalculateSplitDepths(nearPlane, farPlane, splitDepths);
+		for (int i = 0; i < CASCADE_COUNT; i++)
+		{
+			glm::vec3 center;
+			float radius = 0.0f;
+
+			CalculateSliceBounds(view, projection, sliceNear, splitDepths[i], center, radius);
+			m_cascades[i].splitDepth = splitDepths[i];
+			sliceNear = splitDepths[i];
+
+			if (PlaceCascade(i, glm::vec3(m_lightView * glm::vec4(center, 1.0f)), radius) == true)
+			{
+				BeginMap(GL_TEXTURE_2D_ARRAY, m_staticCascadeTexture, i, CASCADE_SIZE, m_cascades[i].matrix, true);
+				pSceneManager->SetObjectFilter(SceneManager::DRAW_STATIC_OBJECTS);
+				pSceneManager->RenderScene();
+				m_lastDrawnMapCount++;
+			}
+			if (bDynamic == true)
+			{
+				CopyMap(GL_TEXTURE_2D_ARRAY, m_staticCascadeTexture, m_dynamicCascadeTexture, i, CASCADE_SIZE);
+				BeginMap(GL_TEXTURE_2D_ARRAY, m_dynamicCascadeTexture, i, CASCADE_SIZE, m_cascades[i].matrix, false);
+				pSceneManager->SetObjectFilter(SceneManager::DRAW_DYNAMIC_OBJECTS);
+				pSceneManager->RenderScene();
+				m_lastDrawnMapCount++;
+			}
+		}
+	}
+
+	// cube maps of the point lights
+	for (size_t i = 0; i < m_pointLights.size(); i++)
+	{
+		SHADOW_POINT_LIGHT& light = m_pointLights[i];
+
+		for (int face = 0; face < 6; face++)
+		{
+			glm::mat4 matrix = GetCubeFaceMatrix(light, face);
+
+			if (light.bValid == false)
+			{
+				BeginMap(GL_TEXTURE_CUBE_MAP, m_staticCubeTextures[i], face, CUBE_SIZE, matrix, true);
+				pSceneManager->SetObjectFilter(SceneManager::DRAW_STATIC_OBJECTS);
+				pSceneManager->RenderScene();
+				m_lastDrawnMapCount++;
+			}
+			if (bDynamic == true)
+			{
+				CopyMap(GL_TEXTURE_CUBE_MAP, m_staticCubeTextures[i], m_dynamicCubeTextures[i], face, CUBE_SIZE);
+				BeginMap(GL_TEXTURE_CUBE_MAP, m_dynamicCubeTextures[i], face, CUBE_SIZE, matrix, false);
+				pSceneManager->SetObjectFilter(SceneManager::DRAW_DYNAMIC_OBJECTS);
+				pSceneManager->RenderScene();
+				m_lastDrawnMapCount++;
+			}
+		}
+		light.bValid = true;
+	}
+
+	pSceneManager->SetObjectFilter(SceneManager::DRAW_ALL_OBJECTS);
+	m_bUseDynamicMaps = bDynamic;
+
+	glDisable(GL_POLYGON_OFFSET_FILL);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+}
+
+/***********************************************************
+ *  BindShadowMaps()
+ *
+ *  This method is used for binding the shadow maps and
+ *  setting the cascade and point light values into the
+ *  shader.  The samplers are always set, so that they never
+ *  share a texture unit with the object texture.
+ ***********************************************************/
+void ShadowManager::BindShadowMaps(ShaderManager* pShaderManager)
+{
+	pShaderManager->setSampler2DValue(g_DirectionalShadowMapName, DIRECTIONAL_SHADOW_TEXTURE_UNIT);
+	for (int i = 0; i < MAX_SHADOW_POINT_LIGHTS; i++)
+	{
+		pShaderManager->setSampler2DValue(m_pointMapNames[i], POINT_SHADOW_TEXTURE_UNIT + i);
+	}
+	pShaderManager->setBoolValue(g_UseShadowsName, m_bEnabled);
+	if (m_bEnabled == false)
+	{
+		return;
+	}
+
+	glActiveTexture(GL_TEXTURE0 + DIRECTIONAL_SHADOW_TEXTURE_UNIT);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, (m_bUseDynamicMaps == true) ? m_dynamicCascadeTexture : m_staticCascadeTexture);
+	for (int i = 0; i < MAX_SHADOW_POINT_LIGHTS; i++)
+	{
+		glActiveTexture(GL_TEXTURE0 + POINT_SHADOW_TEXTURE_UNIT + i);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, (m_bUseDynamicMaps == true) ? m_dynamicCubeTextures[i] : m_staticCubeTextures[i]);
+	}
+	glActiveTexture(GL_TEXTURE0);
+
+	pShaderManager->setBoolValue(g_UseDirectionalShadowName, m_cascades[0].bValid);
+	for (int i = 0; i < CASCADE_COUNT; i++)
+	{
+		pShaderManager->setMat4Value(m_cascadeMatrixNames[i], m_cascades[i].matrix);
+		pShaderManager->setFloatValue(m_cascadeSplitNames[i], m_cascades[i].splitDepth);
+	}
+	for (int i = 0; i < MAX_SHADOW_POINT_LIGHTS; i++)
+	{
+		bool bActive = (i < (int)m_pointLights.size()) && (m_pointLights[i].bValid == true);
+
+		pShaderManager->setBoolValue(m_pointActiveNames[i], bActive);
+		if (bActive == true)
+		{
+			pShaderManager->setVec3Value(m_pointPositionNames[i], m_pointLights[i].position);
+			pShaderManager->setFloatValue(m_pointFarPlaneNames[i], m_pointLights[i].farPlane);
+		}
+	}
+}
@@ -0,0 +1,156 @@
+///////////////////////////////////////////////////////////////////////////////
+// shadowmanager.h
+// ============
+// manage the cached shadow maps - directional cascades and point light cubes
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+#include "SceneManager.h"
+
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  ShadowManager
+ *
+ *  This class contains the code for the shadow maps of the
+ *  directional light and the first point lights.  The static
+ *  objects are drawn once into cached depth maps, which are
+ *  only drawn again when a light changes or the view leaves
+ *  the area a cascade was drawn for.  When the scene has
+ *  dynamic objects, the cached maps are copied into a second
+ *  set of maps each frame and only the dynamic objects are
+ *  drawn on top, otherwise the cached maps are sampled as
+ *  they are and the shadow pass costs nothing.
+ ***********************************************************/
+class ShadowManager
+{
+public:
+	// constructor
+	ShadowManager();
+	// destructor
+	~ShadowManager();
+
+	// number of cascades for the directional light, must match the shaders
+	static const int CASCADE_COUNT = 3;
+	// number of point lights that cast shadows, must match the shaders
+	static const int MAX_SHADOW_POINT_LIGHTS = 2;
+	// size of each cascade and each cube map face in texels
+	static const int CASCADE_SIZE = 2048;
+	static const int CUBE_SIZE = 512;
+	// texture units the shading pass reads the shadow maps from
+	static const int DIRECTIONAL_SHADOW_TEXTURE_UNIT = 22;
+	static const int POINT_SHADOW_TEXTURE_UNIT = 23;
+
+	// area of the light space that one cascade was drawn for
+	struct CASCADE
+	{
+		glm::vec3 center;
+		float halfExtent;
+		float splitDepth;
+		glm::mat4 matrix;
+		bool bValid;
+	};
+
+	// point light that casts shadows into a cube map
+	struct SHADOW_POINT_LIGHT
+	{
+		glm::vec3 position;
+		float farPlane;
+		bool bValid;
+	};
+
+private:
+	// cached depth maps of the static objects
+	GLuint m_staticCascadeTexture;
+	GLuint m_staticCubeTextures[MAX_SHADOW_POINT_LIGHTS];
+	// depth maps with the dynamic objects drawn over the cached ones
+	GLuint m_dynamicCascadeTexture;
+	GLuint m_dynamicCubeTextures[MAX_SHADOW_POINT_LIGHTS];
+	// framebuffers that the maps are drawn and copied with
+	GLuint m_drawFramebuffer;
+	GLuint m_readFramebuffer;
+	// shader used for drawing the depth of the objects
+	ShaderManager* m_pDepthShader;
+
+	// direction of the directional light, zero when it has no shadows
+	glm::vec3 m_lightDirection;
+	// rotation from world space into the light space
+	glm::mat4 m_lightView;
+	// cascades of the directional light
+	CASCADE m_cascades[CASCADE_COUNT];
+	// point lights that cast shadows
+	std::vector<SHADOW_POINT_LIGHT> m_pointLights;
+	// true when the dynamic maps were drawn this frame
+	bool m_bUseDynamicMaps;
+	// true when the shading pass samples the shadow maps
+	bool m_bEnabled;
+	// number of maps drawn during the last update
+	int m_lastDrawnMapCount;
+	// uniform names of the cascades and the point lights, built once
+	// rather than for every frame they are set in
+	std::string m_cascadeMatrixNames[CASCADE_COUNT];
+	std::string m_cascadeSplitNames[CASCADE_COUNT];
+	std::string m_pointMapNames[MAX_SHADOW_POINT_LIGHTS];
+	std::string m_pointActiveNames[MAX_SHADOW_POINT_LIGHTS];
+	std::string m_pointPositionNames[MAX_SHADOW_POINT_LIGHTS];
+	std::string m_pointFarPlaneNames[MAX_SHADOW_POINT_LIGHTS];
+
+	// create a depth texture array or cube map for the shadow maps
+	GLuint CreateCascadeTexture();
+	GLuint CreateCubeTexture();
+	// get the view distances where each cascade ends
+	void CalculateSplitDepths(float nearPlane, float farPlane, float splitDepths[]) const;
+	// get the bounding sphere of a slice of the view frustum
+	void CalculateSliceBounds(
+		const glm::mat4& view,
+		const glm::mat4& projection,
+		float sliceNear,
+		float sliceFar,
+		glm::vec3& center,
+		float& radius) const;
+	// move a cascade when the view slice leaves the area it was drawn for
+	bool PlaceCascade(int index, const glm::vec3& lightSpaceCenter, float radius);
+	// get the view and projection of one cube map face
+	glm::mat4 GetCubeFaceMatrix(const SHADOW_POINT_LIGHT& light, int face) const;
+	// attach one layer or face of a shadow map and set its matrix
+	void BeginMap(GLenum target, GLuint texture, int layer, int size, const glm::mat4& matrix, bool bClear);
+	// copy one layer or face of a cached map into a dynamic map
+	void CopyMap(GLenum target, GLuint source, GLuint destination, int layer, int size);
+
+public:
+	// create the shadow map textures and framebuffers
+	bool CreateShadowMaps();
+	// free the shadow map textures and framebuffers
+	void DestroyShadowMaps();
+	// load the depth shader the objects are drawn with
+	bool LoadShaders();
+
+	// set the direction of the shadow casting directional light
+	void SetDirectionalLight(glm::vec3 direction);
+	// add a point light that casts shadows as far as its radius
+	int AddPointLight(glm::vec3 position, float radius);
+	// remove all the shadow casting lights
+	void ClearLights();
+	// draw every cached map again, after the static objects changed
+	void InvalidateMaps();
+	// turn the shadows in the shading pass on or off
+	void SetEnabled(bool bEnabled);
+	// get the number of maps drawn during the last update
+	int GetLastDrawnMapCount() const;
+
+	// draw the maps that changed, then the dynamic objects
+	void RenderShadowMaps(
+		SceneManager* pSceneManager,
+		const glm::mat4& view,
+		const glm::mat4& projection,
+		float nearPlane,
+		float farPlane);
+	// bind the shadow maps and set the shadow values into the shader
+	void BindShadowMaps(ShaderManager* pShaderManager);
+};
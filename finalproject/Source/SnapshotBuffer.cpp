@@ -0,0 +1,144 @@
+///////////////////////////////////////////////////////////////////////////////
+// snapshotbuffer.cpp
+// ============
+// pass per-frame scene snapshots from the update thread to the render thread
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SnapshotBuffer.h"
+
+/***********************************************************
+ *  SnapshotBuffer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+SnapshotBuffer::SnapshotBuffer()
+{
+	for (int i = 0; i < 3; i++)
+	{
+		m_snapshots[i].updateIndex = 0;
+		m_snapshots[i].camera.position = glm::vec3(0.0f);
+		m_snapshots[i].camera.front = glm::vec3(0.0f, 0.0f, -1.0f);
+		m_snapshots[i].camera.up = glm::vec3(0.0f, 1.0f, 0.0f);
+		m_snapshots[i].camera.zoom = 45.0f;
+		m_snapshots[i].sceneSeconds = 0.0;
+		m_snapshots[i].pathSeconds = 0.0f;
+		m_snapshots[i].inputTime = std::chrono::steady_clock::now();
+	}
+	m_writeIndex = 0;
+	m_sharedIndex.store(1);
+	m_readIndex = 2;
+	ResetCounters();
+}
+
+/***********************************************************
+ *  GetWriteSnapshot()
+ *
+ *  This method is used for getting the snapshot that the
+ *  update thread fills before publishing it.  No other
+ *  thread reads it until then.
+ ***********************************************************/
+SnapshotBuffer::FRAME_SNAPSHOT& SnapshotBuffer::GetWriteSnapshot()
+{
+	return(m_snapshots[m_writeIndex]);
+}
+
+/***********************************************************
+ *  Publish()
+ *
+ *  This method is used for making the filled snapshot the
+ *  latest one, and taking the one it replaces to fill next.
+ *  If the replaced one was never acquired it is dropped.
+ ***********************************************************/
+void SnapshotBuffer::Publish()
+{
+	unsigned int previous = m_sharedIndex.exchange(m_writeIndex | NEW_SNAPSHOT_BIT, std::memory_order_acq_rel);
+	if ((previous & NEW_SNAPSHOT_BIT) != 0)
+	{
+		m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+	}
+	m_writeIndex = previous & ~NEW_SNAPSHOT_BIT;
+	m_publishedCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+/***********************************************************
+ *  Acquire()
+ *
+ *  This method is used for taking the latest published
+ *  snapshot to draw, and giving back the one drawn before,
+ *  when a newer one was published since the last acquire.
+ ***********************************************************/
+bool SnapshotBuffer::Acquire()
+{
+	if ((m_sharedIndex.load(std::memory_order_acquire) & NEW_SNAPSHOT_BIT) == 0)
+	{
+		m_repeatedCount.fetch_add(1, std::memory_order_relaxed);
+		return(false);
+	}
+
+	// only this thread clears the bit, so the snapshot is still new
+	m_readIndex = m_sharedIndex.exchange(m_readIndex, std::memory_order_acq_rel) & ~NEW_SNAPSHOT_BIT;
+	return(true);
+}
+
+/***********************************************************
+ *  GetReadSnapshot()
+ *
+ *  This method is used for getting the snapshot that the
+ *  render thread draws, which the update thread does not
+ *  touch until the next acquire gives it back.
+ ***********************************************************/
+const SnapshotBuffer::FRAME_SNAPSHOT& SnapshotBuffer::GetReadSnapshot() const
+{
+	return(m_snapshots[m_readIndex]);
+}
+
+/***********************************************************
+ *  ResetCounters()
+ *
+ *  This method is used for clearing the counters of the
+ *  published, dropped and repeated snapshots.
+ ***********************************************************/
+void SnapshotBuffer::ResetCounters()
+{
+	m_publishedCount.store(0);
+	m_droppedCount.store(0);
+	m_repeatedCount.store(0);
+}
+
+/***********************************************************
+ *  GetPublishedCount()
+ *
+ *  This method is used for getting the number of snapshots
+ *  published since the last reset.
+ ***********************************************************/
+unsigned long long SnapshotBuffer::GetPublishedCount() const
+{
+	return(m_publishedCount.load());
+}
+
+/***********************************************************
+ *  GetDroppedCount()
+ *
+ *  This method is used for getting the number of snapshots
+ *  that were replaced by a newer one before being acquired
+ *  since the last reset.
+ ***********************************************************/
+unsigned long long SnapshotBuffer::GetDroppedCount() const
+{
+	return(m_droppedCount.load());
+}
+
+/***********************************************************
+ *  GetRepeatedCount()
+ *
+ *  This method is used for getting the number of acquires
+ *  that found no newer snapshot, so the last one was drawn
+ *  again, since the last reset.
+ ***********************************************************/
+unsigned long long SnapshotBuffer::GetRepeatedCount() const
+{
+	return(m_repeatedCount.load());
+}
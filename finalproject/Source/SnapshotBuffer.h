@@ -0,0 +1,96 @@
+///////////////////////////////////////////////////////////////////////////////
+// snapshotbuffer.h
+// ============
+// pass per-frame scene snapshots from the update thread to the render thread
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <atomic>
+#include <chrono>
+
+/***********************************************************
+ *  SnapshotBuffer
+ *
+ *  This class contains the code for handing the state of
+ *  each updated frame - the camera, the scene time and when
+ *  the input was read - from the thread that updates the
+ *  scene to the thread that draws it.  Three snapshots are
+ *  kept: the update thread fills one, the render thread
+ *  draws from another, and the third holds the latest one
+ *  published.  Publishing and acquiring only exchange the
+ *  index of that third snapshot, so neither thread ever
+ *  waits for the other.  The update thread may publish
+ *  snapshots faster than they are drawn, which drops the
+ *  unread ones, and the render thread may draw the same
+ *  snapshot again when no newer one is ready.
+ ***********************************************************/
+class SnapshotBuffer
+{
+public:
+	// camera the frame is drawn from
+	struct CAMERA_STATE
+	{
+		glm::vec3 position;
+		glm::vec3 front;
+		glm::vec3 up;
+		float zoom;
+	};
+
+	// state of the scene for one frame, not changed once published
+	struct FRAME_SNAPSHOT
+	{
+		unsigned long long updateIndex;
+		CAMERA_STATE camera;
+		// seconds the animations of the frame are placed at
+		double sceneSeconds;
+		// seconds since the camera path started
+		float pathSeconds;
+		// time the input of the frame was read
+		std::chrono::steady_clock::time_point inputTime;
+	};
+
+	// constructor
+	SnapshotBuffer();
+
+private:
+	// bit of the shared index that marks a snapshot not acquired yet
+	static const unsigned int NEW_SNAPSHOT_BIT = 4;
+
+	FRAME_SNAPSHOT m_snapshots[3];
+	// snapshot filled by the update thread, only used by it
+	unsigned int m_writeIndex;
+	// snapshot drawn by the render thread, only used by it
+	unsigned int m_readIndex;
+	// latest published snapshot, with the new snapshot bit
+	std::atomic<unsigned int> m_sharedIndex;
+	// counters since the last reset
+	std::atomic<unsigned long long> m_publishedCount;
+	std::atomic<unsigned long long> m_droppedCount;
+	std::atomic<unsigned long long> m_repeatedCount;
+
+public:
+	// get the snapshot the update thread fills next
+	FRAME_SNAPSHOT& GetWriteSnapshot();
+	// make the filled snapshot the latest one
+	void Publish();
+
+	// take the latest snapshot if a newer one was published, and
+	// check whether it was
+	bool Acquire();
+	// get the snapshot the render thread draws
+	const FRAME_SNAPSHOT& GetReadSnapshot() const;
+
+	// clear the counters
+	void ResetCounters();
+	// get the published snapshots, the ones replaced before they
+	// were acquired, and the acquires that found no newer one
+	unsigned long long GetPublishedCount() const;
+	unsigned long long GetDroppedCount() const;
+	unsigned long long GetRepeatedCount() const;
+};
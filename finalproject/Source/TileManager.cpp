@@ -0,0 +1,256 @@
+///////////////////////////////////////////////////////////////////////////////
+// tilemanager.cpp
+// ============
+// manage the tiled light culling - depth pre-pass and compute light lists
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TileManager.h"
+
+// declare the global variables
+namespace
+{
+	const std::string g_InverseProjectionName = "inverseProjection";
+}
+
+/***********************************************************
+ *  TileManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TileManager::TileManager()
+{
+	m_depthFramebuffer = 0;
+	m_depthTexture = 0;
+	m_width = 0;
+	m_height = 0;
+	m_tileCountX = 0;
+	m_tileCountY = 0;
+	m_tileBuffer = 0;
+	m_indexBuffer = 0;
+	m_pDepthShader = NULL;
+	m_pCullingShader = NULL;
+}
+
+/***********************************************************
+ *  ~TileManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+TileManager::~TileManager()
+{
+	DestroyBuffers();
+
+	if (NULL != m_pDepthShader)
+	{
+		delete m_pDepthShader;
+		m_pDepthShader = NULL;
+	}
+	if (NULL != m_pCullingShader)
+	{
+		delete m_pCullingShader;
+		m_pCullingShader = NULL;
+	}
+}
+
+/***********************************************************
+ *  CreateBuffers()
+ *
+ *  This method is used for creating the depth pre-pass
+ *  framebuffer and the tile list buffers.  Every tile gets a
+ *  fixed block of MAX_LIGHTS_PER_TILE indices, so the lists
+ *  can be written without a global counter.
+ ***********************************************************/
+bool TileManager::CreateBuffers(int width, int height)
+{
+	m_width = width;
+	m_height = height;
+	m_tileCountX = (width + TILE_SIZE - 1) / TILE_SIZE;
+	m_tileCountY = (height + TILE_SIZE - 1) / TILE_SIZE;
+
+	glGenTextures(1, &m_depthTexture);
+	glBindTexture(GL_TEXTURE_2D, m_depthTexture);
+	glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH_COMPONENT24, width, height);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+	glGenFramebuffers(1, &m_depthFramebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_depthFramebuffer);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_depthTexture, 0);
+	glDrawBuffer(GL_NONE);
+	glReadBuffer(GL_NONE);
+
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cout << "Depth pre-pass framebuffer is not complete, status:" << status << std::endl;
+		return false;
+	}
+
+	size_t tileCount = (size_t)m_tileCountX * m_tileCountY;
+
+	glGenBuffers(1, &m_tileBuffer);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_tileBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, tileCount * 2 * sizeof(GLuint), NULL, GL_DYNAMIC_COPY);
+
+	glGenBuffers(1, &m_indexBuffer);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_indexBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, tileCount * MAX_LIGHTS_PER_TILE * sizeof(GLuint), NULL, GL_DYNAMIC_COPY);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	return true;
+}
+
+/***********************************************************
+ *  DestroyBuffers()
+ *
+ *  This method is used for freeing the depth pre-pass
+ *  framebuffer and the tile list buffers.
+ ***********************************************************/
+void TileManager::DestroyBuffers()
+{
+	if (m_depthFramebuffer != 0)
+	{
+		glDeleteFramebuffers(1, &m_depthFramebuffer);
+		glDeleteTextures(1, &m_depthTexture);
+		m_depthFramebuffer = 0;
+		m_depthTexture = 0;
+	}
+	if (m_tileBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_tileBuffer);
+		glDeleteBuffers(1, &m_indexBuffer);
+		m_tileBuffer = 0;
+		m_indexBuffer = 0;
+	}
+}
+
+/***********************************************************
+ *  LoadShaders()
+ *
+ *  This method is used for loading the position only depth
+ *  shader and the light culling compute shader.
+ ***********************************************************/
+bool TileManager::LoadShaders()
+{
+	m_pDepthShader = new ShaderManager();
+	m_pDepthShader->LoadShaders(
+		"shaders/depthVertexShader.glsl",
+		"shaders/depthFragmentShader.glsl");
+
+	m_pCullingShader = new ComputeShaderManager();
+	if (m_pCullingShader->LoadShader("shaders/tiledCullingComputeShader.glsl") == false)
+	{
+		return false;
+	}
+	m_pCullingShader->use();
+	m_pCullingShader->setSampler2DValue("depthTexture", DEPTH_TEXTURE_UNIT);
+
+	return true;
+}
+
+/***********************************************************
+ *  GetDepthShader()
+ *
+ *  This method is used for getting the shader that the scene
+ *  is drawn with during the depth pre-pass.
+ ***********************************************************/
+ShaderManager* TileManager::GetDepthShader()
+{
+	return(m_pDepthShader);
+}
+
+/***********************************************************
+ *  GetTileCountX()
+ *
+ *  This method is used for getting the number of tiles
+ *  across the screen.
+ ***********************************************************/
+int TileManager::GetTileCountX() const
+{
+	return(m_tileCountX);
+}
+
+/***********************************************************
+ *  BeginDepthPass()
+ *
+ *  This method is used for binding and clearing the depth
+ *  texture so that the scene depth can be drawn into it.
+ ***********************************************************/
+void TileManager::BeginDepthPass()
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, m_depthFramebuffer);
+	glViewport(0, 0, m_width, m_height);
+	glEnable(GL_DEPTH_TEST);
+	glDepthMask(GL_TRUE);
+	glClear(GL_DEPTH_BUFFER_BIT);
+
+	m_pDepthShader->use();
+}
+
+/***********************************************************
+ *  EndDepthPass()
+ *
+ *  This method is used for going back to drawing into the
+ *  window framebuffer.
+ ***********************************************************/
+void TileManager::EndDepthPass()
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+/***********************************************************
+ *  CullLights()
+ *
+ *  This method is used for running the compute pass that
+ *  writes the light list of every tile.  The light buffer
+ *  must already hold the lights of the current frame.
+ ***********************************************************/
+void TileManager::CullLights(
+	LightManager* pLightManager,
+	const glm::mat4& view,
+	const glm::mat4& projection)
+{
+	// the depth writes of the pre-pass must finish before
+	// the compute pass samples the depth texture
+	glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+
+	glActiveTexture(GL_TEXTURE0 + DEPTH_TEXTURE_UNIT);
+	glBindTexture(GL_TEXTURE_2D, m_depthTexture);
+	glActiveTexture(GL_TEXTURE0);
+
+	pLightManager->BindLights(NULL);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, TILE_BUFFER_BINDING, m_tileBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, INDEX_BUFFER_BINDING, m_indexBuffer);
+
+	m_pCullingShader->use();
+	m_pCullingShader->setMat4Value("view", view);
+	m_pCullingShader->setMat4Value(g_InverseProjectionName, glm::inverse(projection));
+	m_pCullingShader->setIntValue("lightCount", pLightManager->GetLightCount());
+	m_pCullingShader->setVec2Value("screenSize", glm::vec2((float)m_width, (float)m_height));
+	m_pCullingShader->Dispatch(m_tileCountX, m_tileCountY, 1);
+
+	// the tile lists are read by the fragment shader next
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
+/***********************************************************
+ *  BindTiles()
+ *
+ *  This method is used for binding the tile list buffers and
+ *  switching the shader over to the tile lists.
+ ***********************************************************/
+void TileManager::BindTiles(ShaderManager* pShaderManager)
+{
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, TILE_BUFFER_BINDING, m_tileBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, INDEX_BUFFER_BINDING, m_indexBuffer);
+
+	pShaderManager->setBoolValue("bUseClusters", true);
+	pShaderManager->setBoolValue("bUseTiles", true);
+	pShaderManager->setIntValue("tileCountX", m_tileCountX);
+}
@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////
+// tilemanager.h
+// ============
+// manage the tiled light culling - depth pre-pass and compute light lists
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+#include "ComputeShaderManager.h"
+#include "LightManager.h"
+
+/***********************************************************
+ *  TileManager
+ *
+ *  This class contains the code for tiled light culling on
+ *  the GPU.  A depth pre-pass writes the scene depth into a
+ *  texture, then a compute pass splits the screen into 16x16
+ *  pixel tiles, finds the depth range of each tile, and
+ *  writes the lights that touch each tile into a list that
+ *  the forward shading pass reads.  The tile lists use the
+ *  same layout and bindings as the cluster lists, so the
+ *  clustered fragment shader reads either one.
+ ***********************************************************/
+class TileManager
+{
+public:
+	// constructor
+	TileManager();
+	// destructor
+	~TileManager();
+
+	// size of a screen tile in pixels, must match the shaders
+	static const int TILE_SIZE = 16;
+	// most lights stored for one tile, must match the shaders
+	static const int MAX_LIGHTS_PER_TILE = 256;
+	// shader storage buffer binding points, shared with the cluster lists
+	static const int TILE_BUFFER_BINDING = 1;
+	static const int INDEX_BUFFER_BINDING = 2;
+	// texture unit the culling pass reads the depth from
+	static const int DEPTH_TEXTURE_UNIT = 20;
+
+private:
+	// depth pre-pass framebuffer and its depth texture
+	GLuint m_depthFramebuffer;
+	GLuint m_depthTexture;
+	int m_width;
+	int m_height;
+	// number of tiles across and down the screen
+	int m_tileCountX;
+	int m_tileCountY;
+	// OpenGL shader storage buffers of the tile lists
+	GLuint m_tileBuffer;
+	GLuint m_indexBuffer;
+	// shader used for the depth pre-pass
+	ShaderManager* m_pDepthShader;
+	// compute shader that builds the tile lists
+	ComputeShaderManager* m_pCullingShader;
+
+public:
+	// create the depth texture and the tile list buffers
+	bool CreateBuffers(int width, int height);
+	// free the depth texture and the tile list buffers
+	void DestroyBuffers();
+	// load the depth pre-pass and light culling shaders
+	bool LoadShaders();
+
+	// get the shader that the scene is drawn with in the depth pre-pass
+	ShaderManager* GetDepthShader();
+	// get the number of tiles across the screen
+	int GetTileCountX() const;
+
+	// bind and clear the depth texture before the scene is drawn
+	void BeginDepthPass();
+	// go back to the window framebuffer after the scene is drawn
+	void EndDepthPass();
+	// build the light list of every tile from the pre-pass depth
+	void CullLights(
+		LightManager* pLightManager,
+		const glm::mat4& view,
+		const glm::mat4& projection);
+	// bind the tile lists and set the tile values into the shader
+	void BindTiles(ShaderManager* pShaderManager);
+};
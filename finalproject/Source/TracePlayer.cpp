@@ -0,0 +1,1239 @@
+///////////////////////////////////////////////////////////////////////////////
+// traceplayer.cpp
+// ============
+// replay a recorded frame from a binary trace file
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TracePlayer.h"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+// declare the global variables
+namespace
+{
+	// texture parameters in the order the recorder saves them
+	const GLenum TEXTURE_PARAMETERS[] = {
+		GL_TEXTURE_MIN_FILTER, GL_TEXTURE_MAG_FILTER, GL_TEXTURE_WRAP_S, GL_TEXTURE_WRAP_T,
+		GL_TEXTURE_WRAP_R, GL_TEXTURE_COMPARE_MODE, GL_TEXTURE_COMPARE_FUNC };
+	const int TEXTURE_PARAMETER_COUNT = sizeof(TEXTURE_PARAMETERS) / sizeof(TEXTURE_PARAMETERS[0]);
+	// vertex attribute words saved for each attribute
+	const int ATTRIBUTE_WORDS = 7;
+	// words saved for each framebuffer attachment
+	const int ATTACHMENT_WORDS = 6;
+
+	/***********************************************************
+	 *  WordToFloat()
+	 *
+	 *  This function is used for getting the float whose bits
+	 *  were recorded in the passed in word.
+	 ***********************************************************/
+	GLfloat WordToFloat(GLuint word)
+	{
+		GLfloat value = 0.0f;
+		memcpy(&value, &word, sizeof(GLfloat));
+		return(value);
+	}
+
+	/***********************************************************
+	 *  MapWindowBuffer()
+	 *
+	 *  This function is used for replacing the buffers of the
+	 *  window with the color attachment of the framebuffer that
+	 *  stands in for the window.
+	 ***********************************************************/
+	GLenum MapWindowBuffer(GLenum buffer)
+	{
+		if ((buffer == GL_BACK) || (buffer == GL_FRONT) ||
+			(buffer == GL_BACK_LEFT) || (buffer == GL_FRONT_LEFT))
+		{
+			return(GL_COLOR_ATTACHMENT0);
+		}
+		return(buffer);
+	}
+}
+
+/***********************************************************
+ *  TracePlayer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TracePlayer::TracePlayer()
+{
+	m_windowWidth = 0;
+	m_windowHeight = 0;
+	m_windowFramebuffer = 0;
+	m_windowColorTexture = 0;
+	m_windowDepthRenderbuffer = 0;
+	m_currentProgram = 0;
+	ResetProfile();
+}
+
+/***********************************************************
+ *  ~TracePlayer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+TracePlayer::~TracePlayer()
+{
+	DestroyResources();
+}
+
+/***********************************************************
+ *  ReadWord()
+ *
+ *  This method is used for reading the next 32 bit word of a
+ *  section, and marking the reader as failed past its end.
+ ***********************************************************/
+GLuint TracePlayer::ReadWord(TRACE_READER& reader)
+{
+	GLuint word = 0;
+	if (reader.pCurrent + sizeof(GLuint) > reader.pEnd)
+	{
+		reader.bFailed = true;
+		reader.pCurrent = reader.pEnd;
+		return(0);
+	}
+	memcpy(&word, reader.pCurrent, sizeof(GLuint));
+	reader.pCurrent += sizeof(GLuint);
+	return(word);
+}
+
+/***********************************************************
+ *  ReadFloat()
+ *
+ *  This method is used for reading the next word of a
+ *  section as a float.
+ ***********************************************************/
+GLfloat TracePlayer::ReadFloat(TRACE_READER& reader)
+{
+	return(WordToFloat(ReadWord(reader)));
+}
+
+/***********************************************************
+ *  ReadData()
+ *
+ *  This method is used for reading the size of the next
+ *  block of memory of a section and getting its contents,
+ *  or NULL when the block is empty.
+ ***********************************************************/
+const unsigned char* TracePlayer::ReadData(TRACE_READER& reader, GLuint& size)
+{
+	size = ReadWord(reader);
+	if ((size == 0) || (reader.bFailed == true))
+	{
+		size = 0;
+		return(NULL);
+	}
+	if (size > (GLuint)(reader.pEnd - reader.pCurrent))
+	{
+		reader.bFailed = true;
+		reader.pCurrent = reader.pEnd;
+		size = 0;
+		return(NULL);
+	}
+	const unsigned char* pData = reader.pCurrent;
+	reader.pCurrent += size;
+	return(pData);
+}
+
+/***********************************************************
+ *  StartReading()
+ *
+ *  This method is used for getting a reader positioned at
+ *  the start of the passed in section.
+ ***********************************************************/
+TracePlayer::TRACE_READER TracePlayer::StartReading(const std::vector<unsigned char>& section)
+{
+	TRACE_READER reader;
+	reader.pCurrent = section.empty() ? NULL : &section[0];
+	reader.pEnd = reader.pCurrent + section.size();
+	reader.bFailed = false;
+	return(reader);
+}
+
+/***********************************************************
+ *  Load()
+ *
+ *  This method is used for reading a trace file that was
+ *  written by TraceRecorder::Save().
+ ***********************************************************/
+bool TracePlayer::Load(const char* filename)
+{
+	std::ifstream file(filename, std::ios::binary);
+	GLuint header[4] = { 0, 0, 0, 0 };
+
+	file.read((char*)header, sizeof(header));
+	if ((!file) ||
+		(header[0] != TraceRecorder::TRACE_MAGIC) ||
+		(header[1] != TraceRecorder::TRACE_VERSION) ||
+		(header[2] == 0) || (header[3] == 0))
+	{
+		std::cout << "Could not load trace:" << filename << std::endl;
+		return(false);
+	}
+
+	m_windowWidth = (int)header[2];
+	m_windowHeight = (int)header[3];
+	std::vector<unsigned char>* sections[] = { &m_resources, &m_state, &m_calls };
+	for (int i = 0; i < 3; i++)
+	{
+		GLuint size = 0;
+		file.read((char*)&size, sizeof(size));
+		sections[i]->resize(file ? size : 0);
+		if (sections[i]->empty() == false)
+		{
+			file.read((char*)&(*sections[i])[0], size);
+		}
+	}
+	if (!file)
+	{
+		std::cout << "Trace file is incomplete:" << filename << std::endl;
+		m_resources.clear();
+		m_state.clear();
+		m_calls.clear();
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  MapName()
+ *
+ *  This method is used for getting the created object of the
+ *  passed in recorded name.  The window is mapped to the
+ *  framebuffer that stands in for it, and objects that were
+ *  not saved are mapped to none.
+ ***********************************************************/
+GLuint TracePlayer::MapName(TraceRecorder::RESOURCE resource, GLuint name) const
+{
+	if (name == 0)
+	{
+		return((resource == TraceRecorder::RESOURCE_FRAMEBUFFER) ? m_windowFramebuffer : 0);
+	}
+	if (name < m_names[resource].size())
+	{
+		return(m_names[resource][name]);
+	}
+	return(0);
+}
+
+/***********************************************************
+ *  SetName()
+ *
+ *  This method is used for storing the created object of the
+ *  passed in recorded name.
+ ***********************************************************/
+void TracePlayer::SetName(TraceRecorder::RESOURCE resource, GLuint name, GLuint createdName)
+{
+	if (name >= m_names[resource].size())
+	{
+		m_names[resource].resize(name + 1, 0);
+	}
+	m_names[resource][name] = createdName;
+}
+
+/***********************************************************
+ *  MapLocation()
+ *
+ *  This method is used for getting the created location of
+ *  the passed in recorded uniform location of the program in
+ *  use, or -1 so the uniform call is ignored.
+ ***********************************************************/
+GLint TracePlayer::MapLocation(GLint location) const
+{
+	if ((location < 0) || (m_currentProgram >= m_uniformLocations.size()) ||
+		(location >= (GLint)m_uniformLocations[m_currentProgram].size()))
+	{
+		return(-1);
+	}
+	return(m_uniformLocations[m_currentProgram][location]);
+}
+
+/***********************************************************
+ *  SetLocation()
+ *
+ *  This method is used for storing the created location of
+ *  a recorded uniform location of the passed in program.
+ ***********************************************************/
+void TracePlayer::SetLocation(GLuint program, GLint location, GLint createdLocation)
+{
+	if (location < 0)
+	{
+		return;
+	}
+	if (program >= m_uniformLocations.size())
+	{
+		m_uniformLocations.resize(program + 1);
+	}
+	if (location >= (GLint)m_uniformLocations[program].size())
+	{
+		m_uniformLocations[program].resize(location + 1, -1);
+	}
+	m_uniformLocations[program][location] = createdLocation;
+}
+
+/***********************************************************
+ *  CreateResources()
+ *
+ *  This method is used for creating the framebuffer standing
+ *  in for the window, then every object saved in the trace.
+ ***********************************************************/
+bool TracePlayer::CreateResources()
+{
+	DestroyResources();
+
+	glCreateTextures(GL_TEXTURE_2D, 1, &m_windowColorTexture);
+	glTextureStorage2D(m_windowColorTexture, 1, GL_RGBA8, m_windowWidth, m_windowHeight);
+	glCreateRenderbuffers(1, &m_windowDepthRenderbuffer);
+	glNamedRenderbufferStorage(m_windowDepthRenderbuffer, GL_DEPTH24_STENCIL8, m_windowWidth, m_windowHeight);
+	glCreateFramebuffers(1, &m_windowFramebuffer);
+	glNamedFramebufferTexture(m_windowFramebuffer, GL_COLOR_ATTACHMENT0, m_windowColorTexture, 0);
+	glNamedFramebufferRenderbuffer(m_windowFramebuffer, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_windowDepthRenderbuffer);
+
+	TRACE_READER reader = StartReading(m_resources);
+	while ((reader.pCurrent < reader.pEnd) && (reader.bFailed == false))
+	{
+		switch (ReadWord(reader))
+		{
+		case TraceRecorder::RESOURCE_BUFFER:
+			CreateBuffer(reader);
+			break;
+		case TraceRecorder::RESOURCE_TEXTURE:
+			CreateTexture(reader);
+			break;
+		case TraceRecorder::RESOURCE_RENDERBUFFER:
+			CreateRenderbuffer(reader);
+			break;
+		case TraceRecorder::RESOURCE_PROGRAM:
+			CreateProgram(reader);
+			break;
+		case TraceRecorder::RESOURCE_VERTEX_ARRAY:
+			CreateVertexArray(reader);
+			break;
+		case TraceRecorder::RESOURCE_FRAMEBUFFER:
+			CreateFramebuffer(reader);
+			break;
+		default:
+			reader.bFailed = true;
+			break;
+		}
+	}
+	if (reader.bFailed == true)
+	{
+		std::cout << "Trace resources are damaged" << std::endl;
+		return(false);
+	}
+
+	return(glCheckNamedFramebufferStatus(m_windowFramebuffer, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE);
+}
+
+/***********************************************************
+ *  CreateBuffer()
+ *
+ *  This method is used for creating a saved buffer with its
+ *  usage and contents.
+ ***********************************************************/
+void TracePlayer::CreateBuffer(TRACE_READER& reader)
+{
+	GLuint name = ReadWord(reader);
+	GLenum usage = ReadWord(reader);
+	GLuint size = ReadWord(reader);
+	GLuint dataSize = 0;
+	const unsigned char* pData = ReadData(reader, dataSize);
+
+	GLuint buffer = 0;
+	glCreateBuffers(1, &buffer);
+	glNamedBufferData(buffer, size, (dataSize == size) ? pData : NULL, usage);
+	SetName(TraceRecorder::RESOURCE_BUFFER, name, buffer);
+}
+
+/***********************************************************
+ *  CreateTexture()
+ *
+ *  This method is used for creating a saved texture with
+ *  its sampling parameters, filling its top level, and
+ *  filling the lower levels from it.  The textures are
+ *  created with immutable storage.
+ ***********************************************************/
+void TracePlayer::CreateTexture(TRACE_READER& reader)
+{
+	GLuint name = ReadWord(reader);
+	GLenum target = ReadWord(reader);
+	GLenum internalFormat = ReadWord(reader);
+	GLsizei width = (GLsizei)ReadWord(reader);
+	GLsizei height = (GLsizei)ReadWord(reader);
+	GLsizei depth = (GLsizei)ReadWord(reader);
+	GLsizei levels = (GLsizei)ReadWord(reader);
+	GLint parameters[TEXTURE_PARAMETER_COUNT];
+	for (int i = 0; i < TEXTURE_PARAMETER_COUNT; i++)
+	{
+		parameters[i] = (GLint)ReadWord(reader);
+	}
+	GLfloat borderColor[4];
+	for (int i = 0; i < 4; i++)
+	{
+		borderColor[i] = ReadFloat(reader);
+	}
+	GLenum contentFormat = ReadWord(reader);
+	GLenum contentType = ReadWord(reader);
+	GLuint dataSize = 0;
+	const unsigned char* pData = ReadData(reader, dataSize);
+	if (reader.bFailed == true)
+	{
+		return;
+	}
+
+	GLuint texture = 0;
+	glCreateTextures(target, 1, &texture);
+	if (target == GL_TEXTURE_2D)
+	{
+		glTextureStorage2D(texture, levels, internalFormat, width, height);
+	}
+	else
+	{
+		glTextureStorage3D(texture, levels, internalFormat, width, height, depth);
+	}
+	for (int i = 0; i < TEXTURE_PARAMETER_COUNT; i++)
+	{
+		glTextureParameteri(texture, TEXTURE_PARAMETERS[i], parameters[i]);
+	}
+	glTextureParameterfv(texture, GL_TEXTURE_BORDER_COLOR, borderColor);
+
+	if (NULL != pData)
+	{
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		if (target == GL_TEXTURE_2D)
+		{
+			glTextureSubImage2D(texture, 0, 0, 0, width, height, contentFormat, contentType, pData);
+		}
+		else
+		{
+			glTextureSubImage3D(texture, 0, 0, 0, 0, width, height, depth, contentFormat, contentType, pData);
+		}
+		if (levels > 1)
+		{
+			glGenerateTextureMipmap(texture);
+		}
+	}
+
+	SetName(TraceRecorder::RESOURCE_TEXTURE, name, texture);
+	if (name >= m_textureTargets.size())
+	{
+		m_textureTargets.resize(name + 1, GL_NONE);
+	}
+	m_textureTargets[name] = target;
+}
+
+/***********************************************************
+ *  CreateRenderbuffer()
+ *
+ *  This method is used for creating a saved renderbuffer.
+ ***********************************************************/
+void TracePlayer::CreateRenderbuffer(TRACE_READER& reader)
+{
+	GLuint name = ReadWord(reader);
+	GLenum internalFormat = ReadWord(reader);
+	GLsizei width = (GLsizei)ReadWord(reader);
+	GLsizei height = (GLsizei)ReadWord(reader);
+	GLsizei samples = (GLsizei)ReadWord(reader);
+
+	GLuint renderbuffer = 0;
+	glCreateRenderbuffers(1, &renderbuffer);
+	if (samples > 0)
+	{
+		glNamedRenderbufferStorageMultisample(renderbuffer, samples, internalFormat, width, height);
+	}
+	else
+	{
+		glNamedRenderbufferStorage(renderbuffer, internalFormat, width, height);
+	}
+	SetName(TraceRecorder::RESOURCE_RENDERBUFFER, name, renderbuffer);
+}
+
+/***********************************************************
+ *  CreateProgram()
+ *
+ *  This method is used for compiling and linking a saved
+ *  program, mapping the locations of its uniforms and
+ *  keeping their saved values.
+ ***********************************************************/
+void TracePlayer::CreateProgram(TRACE_READER& reader)
+{
+	GLuint name = ReadWord(reader);
+	GLuint program = glCreateProgram();
+
+	GLuint shaderCount = ReadWord(reader);
+	std::vector<GLuint> shaders;
+	for (GLuint i = 0; (i < shaderCount) && (reader.bFailed == false); i++)
+	{
+		GLenum type = ReadWord(reader);
+		GLuint sourceSize = 0;
+		const GLchar* pSource = (const GLchar*)ReadData(reader, sourceSize);
+		if (NULL == pSource)
+		{
+			continue;
+		}
+		GLuint shader = glCreateShader(type);
+		glShaderSource(shader, 1, &pSource, NULL);
+		glCompileShader(shader);
+		glAttachShader(program, shader);
+		shaders.push_back(shader);
+	}
+
+	GLuint varyingCount = ReadWord(reader);
+	GLenum bufferMode = ReadWord(reader);
+	std::vector<const GLchar*> varyings;
+	for (GLuint i = 0; (i < varyingCount) && (reader.bFailed == false); i++)
+	{
+		GLuint varyingSize = 0;
+		varyings.push_back((const GLchar*)ReadData(reader, varyingSize));
+	}
+	if ((varyings.empty() == false) && (reader.bFailed == false))
+	{
+		glTransformFeedbackVaryings(program, (GLsizei)varyings.size(), &varyings[0], bufferMode);
+	}
+
+	glLinkProgram(program);
+	GLint linked = GL_FALSE;
+	glGetProgramiv(program, GL_LINK_STATUS, &linked);
+	if (linked == GL_FALSE)
+	{
+		GLchar log[1024] = { 0 };
+		glGetProgramInfoLog(program, sizeof(log), NULL, log);
+		std::cout << "Could not link traced program " << name << ": " << log << std::endl;
+	}
+	for (size_t i = 0; i < shaders.size(); i++)
+	{
+		glDeleteShader(shaders[i]);
+	}
+	SetName(TraceRecorder::RESOURCE_PROGRAM, name, program);
+
+	GLuint uniformCount = ReadWord(reader);
+	for (GLuint i = 0; (i < uniformCount) && (reader.bFailed == false); i++)
+	{
+		GLuint nameSize = 0;
+		const GLchar* pUniformName = (const GLchar*)ReadData(reader, nameSize);
+		UNIFORM_VALUE uniform;
+		uniform.program = program;
+		uniform.type = ReadWord(reader);
+		GLint location = (GLint)ReadWord(reader);
+		for (int w = 0; w < TraceRecorder::TRACE_UNIFORM_WORDS; w++)
+		{
+			uniform.values[w] = ReadWord(reader);
+		}
+		if ((NULL == pUniformName) || (reader.bFailed == true))
+		{
+			continue;
+		}
+
+		uniform.location = glGetUniformLocation(program, pUniformName);
+		SetLocation(name, location, uniform.location);
+		if (uniform.location >= 0)
+		{
+			m_uniforms.push_back(uniform);
+		}
+	}
+}
+
+/***********************************************************
+ *  CreateVertexArray()
+ *
+ *  This method is used for creating a saved vertex array
+ *  with its attribute formats and vertex buffer bindings.
+ ***********************************************************/
+void TracePlayer::CreateVertexArray(TRACE_READER& reader)
+{
+	GLuint name = ReadWord(reader);
+	GLuint elementBuffer = ReadWord(reader);
+
+	GLuint vertexArray = 0;
+	glCreateVertexArrays(1, &vertexArray);
+	glVertexArrayElementBuffer(vertexArray, MapName(TraceRecorder::RESOURCE_BUFFER, elementBuffer));
+
+	for (GLuint i = 0; i < TraceRecorder::TRACE_VERTEX_ATTRIBUTES; i++)
+	{
+		GLuint words[ATTRIBUTE_WORDS];
+		for (int w = 0; w < ATTRIBUTE_WORDS; w++)
+		{
+			words[w] = ReadWord(reader);
+		}
+		// enabled, size, type, normalized, integer, offset, binding
+		if (words[0] == GL_FALSE)
+		{
+			continue;
+		}
+		glEnableVertexArrayAttrib(vertexArray, i);
+		if (words[4] == GL_TRUE)
+		{
+			glVertexArrayAttribIFormat(vertexArray, i, (GLint)words[1], words[2], words[5]);
+		}
+		else
+		{
+			glVertexArrayAttribFormat(vertexArray, i, (GLint)words[1], words[2], (GLboolean)words[3], words[5]);
+		}
+		glVertexArrayAttribBinding(vertexArray, i, words[6]);
+	}
+
+	for (GLuint i = 0; i < TraceRecorder::TRACE_VERTEX_ATTRIBUTES; i++)
+	{
+		GLuint buffer = ReadWord(reader);
+		GLuint offset = ReadWord(reader);
+		GLsizei stride = (GLsizei)ReadWord(reader);
+		GLuint divisor = ReadWord(reader);
+		if (buffer != 0)
+		{
+			glVertexArrayVertexBuffer(vertexArray, i, MapName(TraceRecorder::RESOURCE_BUFFER, buffer), offset, stride);
+		}
+		glVertexArrayBindingDivisor(vertexArray, i, divisor);
+	}
+
+	SetName(TraceRecorder::RESOURCE_VERTEX_ARRAY, name, vertexArray);
+}
+
+/***********************************************************
+ *  CreateFramebuffer()
+ *
+ *  This method is used for creating a saved framebuffer with
+ *  its attachments, draw buffers and read buffer.
+ ***********************************************************/
+void TracePlayer::CreateFramebuffer(TRACE_READER& reader)
+{
+	GLuint name = ReadWord(reader);
+	GLuint framebuffer = 0;
+	glCreateFramebuffers(1, &framebuffer);
+
+	for (int i = 0; i < TraceRecorder::TRACE_COLOR_ATTACHMENTS + 2; i++)
+	{
+		GLuint words[ATTACHMENT_WORDS];
+		for (int w = 0; w < ATTACHMENT_WORDS; w++)
+		{
+			words[w] = ReadWord(reader);
+		}
+		// attachment, object type, object, level, layer, layered
+		GLenum attachment = words[0];
+		if (words[1] == GL_TEXTURE)
+		{
+			GLuint texture = MapName(TraceRecorder::RESOURCE_TEXTURE, words[2]);
+			GLenum target = (words[2] < m_textureTargets.size()) ? m_textureTargets[words[2]] : GL_NONE;
+			if ((words[5] == GL_TRUE) || (target == GL_TEXTURE_2D))
+			{
+				glNamedFramebufferTexture(framebuffer, attachment, texture, (GLint)words[3]);
+			}
+			else
+			{
+				glNamedFramebufferTextureLayer(framebuffer, attachment, texture, (GLint)words[3], (GLint)words[4]);
+			}
+		}
+		else if (words[1] == GL_RENDERBUFFER)
+		{
+			glNamedFramebufferRenderbuffer(framebuffer, attachment, GL_RENDERBUFFER,
+				MapName(TraceRecorder::RESOURCE_RENDERBUFFER, words[2]));
+		}
+	}
+
+	GLenum drawBuffers[TraceRecorder::TRACE_COLOR_ATTACHMENTS];
+	for (int i = 0; i < TraceRecorder::TRACE_COLOR_ATTACHMENTS; i++)
+	{
+		drawBuffers[i] = ReadWord(reader);
+	}
+	glNamedFramebufferDrawBuffers(framebuffer, TraceRecorder::TRACE_COLOR_ATTACHMENTS, drawBuffers);
+	glNamedFramebufferReadBuffer(framebuffer, ReadWord(reader));
+
+	SetName(TraceRecorder::RESOURCE_FRAMEBUFFER, name, framebuffer);
+}
+
+/***********************************************************
+ *  DestroyResources()
+ *
+ *  This method is used for freeing every created object and
+ *  the framebuffer standing in for the window.
+ ***********************************************************/
+void TracePlayer::DestroyResources()
+{
+	for (int resource = 0; resource < TraceRecorder::RESOURCE_COUNT; resource++)
+	{
+		for (size_t i = 0; i < m_names[resource].size(); i++)
+		{
+			GLuint name = m_names[resource][i];
+			if (name == 0)
+			{
+				continue;
+			}
+			switch (resource)
+			{
+			case TraceRecorder::RESOURCE_BUFFER:
+				glDeleteBuffers(1, &name);
+				break;
+			case TraceRecorder::RESOURCE_TEXTURE:
+				glDeleteTextures(1, &name);
+				break;
+			case TraceRecorder::RESOURCE_RENDERBUFFER:
+				glDeleteRenderbuffers(1, &name);
+				break;
+			case TraceRecorder::RESOURCE_PROGRAM:
+				glDeleteProgram(name);
+				break;
+			case TraceRecorder::RESOURCE_VERTEX_ARRAY:
+				glDeleteVertexArrays(1, &name);
+				break;
+			case TraceRecorder::RESOURCE_FRAMEBUFFER:
+				glDeleteFramebuffers(1, &name);
+				break;
+			}
+		}
+		m_names[resource].clear();
+	}
+	m_textureTargets.clear();
+	m_uniformLocations.clear();
+	m_uniforms.clear();
+
+	if (m_windowFramebuffer != 0)
+	{
+		glDeleteFramebuffers(1, &m_windowFramebuffer);
+		glDeleteTextures(1, &m_windowColorTexture);
+		glDeleteRenderbuffers(1, &m_windowDepthRenderbuffer);
+		m_windowFramebuffer = 0;
+		m_windowColorTexture = 0;
+		m_windowDepthRenderbuffer = 0;
+	}
+}
+
+/***********************************************************
+ *  RestoreState()
+ *
+ *  This method is used for binding the saved objects and
+ *  setting the saved fixed function state, in the order the
+ *  recorder saved them.
+ ***********************************************************/
+void TracePlayer::RestoreState()
+{
+	TRACE_READER reader = StartReading(m_state);
+
+	m_currentProgram = ReadWord(reader);
+	glUseProgram(MapName(TraceRecorder::RESOURCE_PROGRAM, m_currentProgram));
+	glBindVertexArray(MapName(TraceRecorder::RESOURCE_VERTEX_ARRAY, ReadWord(reader)));
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, MapName(TraceRecorder::RESOURCE_FRAMEBUFFER, ReadWord(reader)));
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, MapName(TraceRecorder::RESOURCE_FRAMEBUFFER, ReadWord(reader)));
+	glBindBuffer(GL_ARRAY_BUFFER, MapName(TraceRecorder::RESOURCE_BUFFER, ReadWord(reader)));
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, MapName(TraceRecorder::RESOURCE_BUFFER, ReadWord(reader)));
+	glBindBuffer(GL_UNIFORM_BUFFER, MapName(TraceRecorder::RESOURCE_BUFFER, ReadWord(reader)));
+	GLenum activeTexture = ReadWord(reader);
+
+	GLuint unitCount = ReadWord(reader);
+	GLuint targetCount = ReadWord(reader);
+	for (GLuint unit = 0; (unit < unitCount) && (reader.bFailed == false); unit++)
+	{
+		glActiveTexture(GL_TEXTURE0 + unit);
+		for (GLuint t = 0; t < targetCount; t++)
+		{
+			GLenum target = ReadWord(reader);
+			glBindTexture(target, MapName(TraceRecorder::RESOURCE_TEXTURE, ReadWord(reader)));
+		}
+	}
+	glActiveTexture(activeTexture);
+
+	for (int i = 0; i < 2 * TraceRecorder::TRACE_BUFFER_BINDINGS; i++)
+	{
+		GLenum target = ReadWord(reader);
+		GLuint buffer = MapName(TraceRecorder::RESOURCE_BUFFER, ReadWord(reader));
+		GLuint start = ReadWord(reader);
+		GLuint size = ReadWord(reader);
+		if ((buffer != 0) && (size > 0))
+		{
+			glBindBufferRange(target, i % TraceRecorder::TRACE_BUFFER_BINDINGS, buffer, start, size);
+		}
+		else
+		{
+			glBindBufferBase(target, i % TraceRecorder::TRACE_BUFFER_BINDINGS, buffer);
+		}
+	}
+
+	GLuint capabilityCount = ReadWord(reader);
+	for (GLuint i = 0; (i < capabilityCount) && (reader.bFailed == false); i++)
+	{
+		GLenum capability = ReadWord(reader);
+		if (ReadWord(reader) == GL_TRUE)
+		{
+			glEnable(capability);
+		}
+		else
+		{
+			glDisable(capability);
+		}
+	}
+
+	GLenum sourceColor = ReadWord(reader);
+	GLenum destinationColor = ReadWord(reader);
+	GLenum sourceAlpha = ReadWord(reader);
+	GLenum destinationAlpha = ReadWord(reader);
+	glBlendFuncSeparate(sourceColor, destinationColor, sourceAlpha, destinationAlpha);
+	glDepthFunc(ReadWord(reader));
+	glCullFace(ReadWord(reader));
+	glDepthMask((GLboolean)ReadWord(reader));
+	GLboolean colorMask[4];
+	for (int i = 0; i < 4; i++)
+	{
+		colorMask[i] = (GLboolean)ReadWord(reader);
+	}
+	glColorMask(colorMask[0], colorMask[1], colorMask[2], colorMask[3]);
+	GLint viewport[4];
+	for (int i = 0; i < 4; i++)
+	{
+		viewport[i] = (GLint)ReadWord(reader);
+	}
+	glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+	GLfloat clearColor[4];
+	for (int i = 0; i < 4; i++)
+	{
+		clearColor[i] = ReadFloat(reader);
+	}
+	glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+	GLfloat polygonOffsetFactor = ReadFloat(reader);
+	GLfloat polygonOffsetUnits = ReadFloat(reader);
+	glPolygonOffset(polygonOffsetFactor, polygonOffsetUnits);
+}
+
+/***********************************************************
+ *  RestoreUniforms()
+ *
+ *  This method is used for setting every saved uniform back
+ *  to its value at the start of the recorded frame.
+ ***********************************************************/
+void TracePlayer::RestoreUniforms()
+{
+	for (size_t i = 0; i < m_uniforms.size(); i++)
+	{
+		const UNIFORM_VALUE& uniform = m_uniforms[i];
+		const GLfloat* pFloats = (const GLfloat*)uniform.values;
+		const GLint* pInts = (const GLint*)uniform.values;
+		switch (uniform.type)
+		{
+		case GL_FLOAT:
+			glProgramUniform1fv(uniform.program, uniform.location, 1, pFloats);
+			break;
+		case GL_FLOAT_VEC2:
+			glProgramUniform2fv(uniform.program, uniform.location, 1, pFloats);
+			break;
+		case GL_FLOAT_VEC3:
+			glProgramUniform3fv(uniform.program, uniform.location, 1, pFloats);
+			break;
+		case GL_FLOAT_VEC4:
+			glProgramUniform4fv(uniform.program, uniform.location, 1, pFloats);
+			break;
+		case GL_FLOAT_MAT2:
+			glProgramUniformMatrix2fv(uniform.program, uniform.location, 1, GL_FALSE, pFloats);
+			break;
+		case GL_FLOAT_MAT3:
+			glProgramUniformMatrix3fv(uniform.program, uniform.location, 1, GL_FALSE, pFloats);
+			break;
+		case GL_FLOAT_MAT4:
+			glProgramUniformMatrix4fv(uniform.program, uniform.location, 1, GL_FALSE, pFloats);
+			break;
+		case GL_UNSIGNED_INT:
+			glProgramUniform1uiv(uniform.program, uniform.location, 1, uniform.values);
+			break;
+		case GL_UNSIGNED_INT_VEC2:
+			glProgramUniform2uiv(uniform.program, uniform.location, 1, uniform.values);
+			break;
+		case GL_UNSIGNED_INT_VEC3:
+			glProgramUniform3uiv(uniform.program, uniform.location, 1, uniform.values);
+			break;
+		case GL_UNSIGNED_INT_VEC4:
+			glProgramUniform4uiv(uniform.program, uniform.location, 1, uniform.values);
+			break;
+		case GL_INT_VEC2:
+		case GL_BOOL_VEC2:
+			glProgramUniform2iv(uniform.program, uniform.location, 1, pInts);
+			break;
+		case GL_INT_VEC3:
+		case GL_BOOL_VEC3:
+			glProgramUniform3iv(uniform.program, uniform.location, 1, pInts);
+			break;
+		case GL_INT_VEC4:
+		case GL_BOOL_VEC4:
+			glProgramUniform4iv(uniform.program, uniform.location, 1, pInts);
+			break;
+		default:
+			// integers, booleans, samplers and images
+			glProgramUniform1iv(uniform.program, uniform.location, 1, pInts);
+			break;
+		}
+	}
+}
+
+/***********************************************************
+ *  ReplayFrame()
+ *
+ *  This method is used for restoring the saved state, then
+ *  making every recorded call and adding its CPU time to its
+ *  call type.
+ ***********************************************************/
+void TracePlayer::ReplayFrame()
+{
+	RestoreState();
+	RestoreUniforms();
+
+	std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+	TRACE_READER reader = StartReading(m_calls);
+	GLuint words[16];
+	while ((reader.pCurrent < reader.pEnd) && (reader.bFailed == false))
+	{
+		GLuint callIndex = *reader.pCurrent;
+		reader.pCurrent++;
+		if (callIndex >= TraceRecorder::CALL_COUNT)
+		{
+			std::cout << "Trace calls are damaged" << std::endl;
+			break;
+		}
+		TraceRecorder::CALL call = (TraceRecorder::CALL)callIndex;
+
+		int wordCount = TraceRecorder::GetCallWordCount(call);
+		for (int i = 0; i < wordCount; i++)
+		{
+			words[i] = ReadWord(reader);
+		}
+		const unsigned char* pData = NULL;
+		GLuint dataSize = 0;
+		if (TraceRecorder::CallHasData(call) == true)
+		{
+			const unsigned char* pRead = ReadData(reader, dataSize);
+			if (NULL != pRead)
+			{
+				m_alignedData.resize((dataSize + sizeof(GLuint) - 1) / sizeof(GLuint));
+				memcpy(&m_alignedData[0], pRead, dataSize);
+				pData = (const unsigned char*)&m_alignedData[0];
+			}
+		}
+		if (reader.bFailed == true)
+		{
+			break;
+		}
+
+		std::chrono::steady_clock::time_point callStart = std::chrono::steady_clock::now();
+		ExecuteCall(call, words, pData, dataSize);
+		m_callMilliseconds[call] += std::chrono::duration<double, std::milli>(
+			std::chrono::steady_clock::now() - callStart).count();
+		m_callCounts[call]++;
+	}
+
+	m_lastMilliseconds = std::chrono::duration<double, std::milli>(
+		std::chrono::steady_clock::now() - frameStart).count();
+	m_totalMilliseconds += m_lastMilliseconds;
+	m_replayCount++;
+}
+
+/***********************************************************
+ *  ExecuteCall()
+ *
+ *  This method is used for making one recorded call with its
+ *  recorded arguments, after mapping the object names and
+ *  uniform locations to the created ones.
+ ***********************************************************/
+void TracePlayer::ExecuteCall(TraceRecorder::CALL call, const GLuint* pWords, const unsigned char* pData, GLuint dataSize)
+{
+	const GLfloat* pFloats = (const GLfloat*)pData;
+
+	switch (call)
+	{
+	case TraceRecorder::CALL_ENABLE:
+		glEnable(pWords[0]);
+		break;
+	case TraceRecorder::CALL_DISABLE:
+		glDisable(pWords[0]);
+		break;
+	case TraceRecorder::CALL_BLEND_FUNC:
+		glBlendFunc(pWords[0], pWords[1]);
+		break;
+	case TraceRecorder::CALL_BLEND_FUNCI:
+		glBlendFunci(pWords[0], pWords[1], pWords[2]);
+		break;
+	case TraceRecorder::CALL_DEPTH_MASK:
+		glDepthMask((GLboolean)pWords[0]);
+		break;
+	case TraceRecorder::CALL_DEPTH_FUNC:
+		glDepthFunc(pWords[0]);
+		break;
+	case TraceRecorder::CALL_CULL_FACE:
+		glCullFace(pWords[0]);
+		break;
+	case TraceRecorder::CALL_COLOR_MASK:
+		glColorMask((GLboolean)pWords[0], (GLboolean)pWords[1], (GLboolean)pWords[2], (GLboolean)pWords[3]);
+		break;
+	case TraceRecorder::CALL_POLYGON_OFFSET:
+		glPolygonOffset(WordToFloat(pWords[0]), WordToFloat(pWords[1]));
+		break;
+	case TraceRecorder::CALL_VIEWPORT:
+		glViewport((GLint)pWords[0], (GLint)pWords[1], (GLsizei)pWords[2], (GLsizei)pWords[3]);
+		break;
+	case TraceRecorder::CALL_CLEAR_COLOR:
+		glClearColor(WordToFloat(pWords[0]), WordToFloat(pWords[1]), WordToFloat(pWords[2]), WordToFloat(pWords[3]));
+		break;
+	case TraceRecorder::CALL_CLEAR:
+		glClear(pWords[0]);
+		break;
+	case TraceRecorder::CALL_CLEAR_BUFFERFV:
+		if (NULL != pFloats)
+		{
+			glClearBufferfv(pWords[0], (GLint)pWords[1], pFloats);
+		}
+		break;
+	case TraceRecorder::CALL_ACTIVE_TEXTURE:
+		glActiveTexture(pWords[0]);
+		break;
+	case TraceRecorder::CALL_BIND_TEXTURE:
+		glBindTexture(pWords[0], MapName(TraceRecorder::RESOURCE_TEXTURE, pWords[1]));
+		break;
+	case TraceRecorder::CALL_TEX_PARAMETERI:
+		glTexParameteri(pWords[0], pWords[1], (GLint)pWords[2]);
+		break;
+	case TraceRecorder::CALL_TEX_IMAGE_2D:
+		glPixelStorei(GL_UNPACK_ALIGNMENT, (GLint)pWords[8]);
+		glTexImage2D(pWords[0], (GLint)pWords[1], (GLint)pWords[2], (GLsizei)pWords[3], (GLsizei)pWords[4],
+			(GLint)pWords[5], pWords[6], pWords[7], pData);
+		break;
+	case TraceRecorder::CALL_GENERATE_MIPMAP:
+		glGenerateMipmap(pWords[0]);
+		break;
+	case TraceRecorder::CALL_USE_PROGRAM:
+		m_currentProgram = pWords[0];
+		glUseProgram(MapName(TraceRecorder::RESOURCE_PROGRAM, pWords[0]));
+		break;
+	case TraceRecorder::CALL_GET_UNIFORM_LOCATION:
+		if (NULL != pData)
+		{
+			GLint location = glGetUniformLocation(MapName(TraceRecorder::RESOURCE_PROGRAM, pWords[0]), (const GLchar*)pData);
+			SetLocation(pWords[0], (GLint)pWords[1], location);
+		}
+		break;
+	case TraceRecorder::CALL_UNIFORM_1I:
+		glUniform1i(MapLocation((GLint)pWords[0]), (GLint)pWords[1]);
+		break;
+	case TraceRecorder::CALL_UNIFORM_1F:
+		glUniform1f(MapLocation((GLint)pWords[0]), WordToFloat(pWords[1]));
+		break;
+	case TraceRecorder::CALL_UNIFORM_2F:
+		glUniform2f(MapLocation((GLint)pWords[0]), WordToFloat(pWords[1]), WordToFloat(pWords[2]));
+		break;
+	case TraceRecorder::CALL_UNIFORM_3F:
+		glUniform3f(MapLocation((GLint)pWords[0]), WordToFloat(pWords[1]), WordToFloat(pWords[2]),
+			WordToFloat(pWords[3]));
+		break;
+	case TraceRecorder::CALL_UNIFORM_4F:
+		glUniform4f(MapLocation((GLint)pWords[0]), WordToFloat(pWords[1]), WordToFloat(pWords[2]),
+			WordToFloat(pWords[3]), WordToFloat(pWords[4]));
+		break;
+	case TraceRecorder::CALL_UNIFORM_2FV:
+		if (dataSize >= pWords[1] * 2 * sizeof(GLfloat))
+		{
+			glUniform2fv(MapLocation((GLint)pWords[0]), (GLsizei)pWords[1], pFloats);
+		}
+		break;
+	case TraceRecorder::CALL_UNIFORM_3FV:
+		if (dataSize >= pWords[1] * 3 * sizeof(GLfloat))
+		{
+			glUniform3fv(MapLocation((GLint)pWords[0]), (GLsizei)pWords[1], pFloats);
+		}
+		break;
+	case TraceRecorder::CALL_UNIFORM_4FV:
+		if (dataSize >= pWords[1] * 4 * sizeof(GLfloat))
+		{
+			glUniform4fv(MapLocation((GLint)pWords[0]), (GLsizei)pWords[1], pFloats);
+		}
+		break;
+	case TraceRecorder::CALL_UNIFORM_4IV:
+		if (dataSize >= pWords[1] * 4 * sizeof(GLint))
+		{
+			glUniform4iv(MapLocation((GLint)pWords[0]), (GLsizei)pWords[1], (const GLint*)pData);
+		}
+		break;
+	case TraceRecorder::CALL_UNIFORM_MATRIX_3FV:
+		if (dataSize >= pWords[1] * 9 * sizeof(GLfloat))
+		{
+			glUniformMatrix3fv(MapLocation((GLint)pWords[0]), (GLsizei)pWords[1], (GLboolean)pWords[2], pFloats);
+		}
+		break;
+	case TraceRecorder::CALL_UNIFORM_MATRIX_4FV:
+		if (dataSize >= pWords[1] * 16 * sizeof(GLfloat))
+		{
+			glUniformMatrix4fv(MapLocation((GLint)pWords[0]), (GLsizei)pWords[1], (GLboolean)pWords[2], pFloats);
+		}
+		break;
+	case TraceRecorder::CALL_BIND_VERTEX_ARRAY:
+		glBindVertexArray(MapName(TraceRecorder::RESOURCE_VERTEX_ARRAY, pWords[0]));
+		break;
+	case TraceRecorder::CALL_BIND_BUFFER:
+		glBindBuffer(pWords[0], MapName(TraceRecorder::RESOURCE_BUFFER, pWords[1]));
+		break;
+	case TraceRecorder::CALL_BIND_BUFFER_BASE:
+		glBindBufferBase(pWords[0], pWords[1], MapName(TraceRecorder::RESOURCE_BUFFER, pWords[2]));
+		break;
+	case TraceRecorder::CALL_BIND_BUFFER_RANGE:
+		glBindBufferRange(pWords[0], pWords[1], MapName(TraceRecorder::RESOURCE_BUFFER, pWords[2]),
+			(GLintptr)pWords[3], (GLsizeiptr)pWords[4]);
+		break;
+	case TraceRecorder::CALL_BUFFER_DATA:
+		glBufferData(pWords[0], (GLsizeiptr)pWords[1], (dataSize == pWords[1]) ? pData : NULL, pWords[2]);
+		break;
+	case TraceRecorder::CALL_BUFFER_SUB_DATA:
+		if (dataSize == pWords[2])
+		{
+			glBufferSubData(pWords[0], (GLintptr)pWords[1], (GLsizeiptr)pWords[2], pData);
+		}
+		break;
+	case TraceRecorder::CALL_BIND_FRAMEBUFFER:
+		glBindFramebuffer(pWords[0], MapName(TraceRecorder::RESOURCE_FRAMEBUFFER, pWords[1]));
+		break;
+	case TraceRecorder::CALL_DRAW_BUFFER:
+		glDrawBuffer(MapWindowBuffer(pWords[0]));
+		break;
+	case TraceRecorder::CALL_DRAW_BUFFERS:
+		if (dataSize >= pWords[0] * sizeof(GLenum))
+		{
+			GLenum buffers[TraceRecorder::TRACE_COLOR_ATTACHMENTS];
+			GLsizei bufferCount = (pWords[0] < TraceRecorder::TRACE_COLOR_ATTACHMENTS) ?
+				(GLsizei)pWords[0] : TraceRecorder::TRACE_COLOR_ATTACHMENTS;
+			for (GLsizei i = 0; i < bufferCount; i++)
+			{
+				buffers[i] = MapWindowBuffer(((const GLenum*)pData)[i]);
+			}
+			glDrawBuffers(bufferCount, buffers);
+		}
+		break;
+	case TraceRecorder::CALL_READ_BUFFER:
+		glReadBuffer(MapWindowBuffer(pWords[0]));
+		break;
+	case TraceRecorder::CALL_BLIT_FRAMEBUFFER:
+		glBlitFramebuffer((GLint)pWords[0], (GLint)pWords[1], (GLint)pWords[2], (GLint)pWords[3],
+			(GLint)pWords[4], (GLint)pWords[5], (GLint)pWords[6], (GLint)pWords[7], pWords[8], pWords[9]);
+		break;
+	case TraceRecorder::CALL_DRAW_ARRAYS:
+		glDrawArrays(pWords[0], (GLint)pWords[1], (GLsizei)pWords[2]);
+		break;
+	case TraceRecorder::CALL_DRAW_ARRAYS_INSTANCED:
+		glDrawArraysInstanced(pWords[0], (GLint)pWords[1], (GLsizei)pWords[2], (GLsizei)pWords[3]);
+		break;
+	case TraceRecorder::CALL_DRAW_ELEMENTS:
+		glDrawElements(pWords[0], (GLsizei)pWords[1], pWords[2], (const void*)(size_t)pWords[3]);
+		break;
+	case TraceRecorder::CALL_DRAW_ELEMENTS_INSTANCED:
+		glDrawElementsInstanced(pWords[0], (GLsizei)pWords[1], pWords[2], (const void*)(size_t)pWords[3],
+			(GLsizei)pWords[4]);
+		break;
+	case TraceRecorder::CALL_DISPATCH_COMPUTE:
+		glDispatchCompute(pWords[0], pWords[1], pWords[2]);
+		break;
+	case TraceRecorder::CALL_MEMORY_BARRIER:
+		glMemoryBarrier(pWords[0]);
+		break;
+	default:
+		break;
+	}
+}
+
+/***********************************************************
+ *  GetWindowWidth()
+ *
+ *  This method is used for getting the width of the window
+ *  the frame was drawn into.
+ ***********************************************************/
+int TracePlayer::GetWindowWidth() const
+{
+	return(m_windowWidth);
+}
+
+/***********************************************************
+ *  GetWindowHeight()
+ *
+ *  This method is used for getting the height of the window
+ *  the frame was drawn into.
+ ***********************************************************/
+int TracePlayer::GetWindowHeight() const
+{
+	return(m_windowHeight);
+}
+
+/***********************************************************
+ *  GetLastMilliseconds()
+ *
+ *  This method is used for getting the CPU time of the last
+ *  replay in milliseconds.
+ ***********************************************************/
+double TracePlayer::GetLastMilliseconds() const
+{
+	return(m_lastMilliseconds);
+}
+
+/***********************************************************
+ *  ResetProfile()
+ *
+ *  This method is used for clearing the replayed calls and
+ *  their CPU times.
+ ***********************************************************/
+void TracePlayer::ResetProfile()
+{
+	for (int i = 0; i < TraceRecorder::CALL_COUNT; i++)
+	{
+		m_callCounts[i] = 0;
+		m_callMilliseconds[i] = 0.0;
+	}
+	m_replayCount = 0;
+	m_totalMilliseconds = 0.0;
+	m_lastMilliseconds = 0.0;
+}
+
+/***********************************************************
+ *  ReportProfile()
+ *
+ *  This method is used for outputting the average calls and
+ *  CPU time of a replayed frame, then the calls and CPU time
+ *  of each call type, the most expensive first.
+ ***********************************************************/
+void TracePlayer::ReportProfile() const
+{
+	if (m_replayCount == 0)
+	{
+		return;
+	}
+
+	unsigned long long totalCalls = 0;
+	double callMilliseconds = 0.0;
+	for (int i = 0; i < TraceRecorder::CALL_COUNT; i++)
+	{
+		totalCalls += m_callCounts[i];
+		callMilliseconds += m_callMilliseconds[i];
+	}
+	std::cout << "INFO: Trace replay of a " << m_windowWidth << "x" << m_windowHeight << " frame"
+		<< ", replays: " << m_replayCount
+		<< ", calls: " << (totalCalls / m_replayCount)
+		<< ", CPU time: " << (m_totalMilliseconds / m_replayCount) << " ms" << std::endl;
+
+	bool bReported[TraceRecorder::CALL_COUNT] = { false };
+	for (int i = 0; i < TraceRecorder::CALL_COUNT; i++)
+	{
+		int slowest = -1;
+		for (int c = 0; c < TraceRecorder::CALL_COUNT; c++)
+		{
+			if ((bReported[c] == false) && (m_callCounts[c] > 0) &&
+				((slowest < 0) || (m_callMilliseconds[c] > m_callMilliseconds[slowest])))
+			{
+				slowest = c;
+			}
+		}
+		if (slowest < 0)
+		{
+			break;
+		}
+		bReported[slowest] = true;
+		std::cout << "INFO:   " << TraceRecorder::GetCallName((TraceRecorder::CALL)slowest)
+			<< ": " << (m_callCounts[slowest] / m_replayCount) << " calls, "
+			<< (m_callMilliseconds[slowest] / m_replayCount) << " ms, "
+			<< (100.0 * m_callMilliseconds[slowest] / callMilliseconds) << "%" << std::endl;
+	}
+}
@@ -0,0 +1,128 @@
+///////////////////////////////////////////////////////////////////////////////
+// traceplayer.h
+// ============
+// replay a recorded frame from a binary trace file
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "TraceRecorder.h"
+
+#include <vector>
+
+/***********************************************************
+ *  TracePlayer
+ *
+ *  This class contains the code for replaying a frame that
+ *  was recorded by the TraceRecorder, without the scene,
+ *  shaders or utilities of the application.  The saved
+ *  objects are created again, and the names and uniform
+ *  locations in the recorded calls are mapped to the new
+ *  ones.  The window the frame was drawn into is replaced by
+ *  a framebuffer of the same size, so no visible window is
+ *  needed.  Each replay starts again from the saved state,
+ *  while buffer and texture contents carry over, and the CPU
+ *  time of every call type is accumulated for profiling.
+ ***********************************************************/
+class TracePlayer
+{
+public:
+	// constructor
+	TracePlayer();
+	// destructor
+	~TracePlayer();
+
+private:
+	// position in a section of the trace
+	struct TRACE_READER
+	{
+		const unsigned char* pCurrent;
+		const unsigned char* pEnd;
+		bool bFailed;
+	};
+
+	// saved uniform value, set again before each replay
+	struct UNIFORM_VALUE
+	{
+		GLuint program;
+		GLint location;
+		GLenum type;
+		GLuint values[TraceRecorder::TRACE_UNIFORM_WORDS];
+	};
+
+	// size of the window the frame was drawn into
+	int m_windowWidth;
+	int m_windowHeight;
+	// sections of the trace file
+	std::vector<unsigned char> m_resources;
+	std::vector<unsigned char> m_state;
+	std::vector<unsigned char> m_calls;
+	// created objects and the targets of the created textures,
+	// indexed by their recorded names
+	std::vector<GLuint> m_names[TraceRecorder::RESOURCE_COUNT];
+	std::vector<GLenum> m_textureTargets;
+	// created uniform locations by recorded program and location
+	std::vector<std::vector<GLint> > m_uniformLocations;
+	std::vector<UNIFORM_VALUE> m_uniforms;
+	// framebuffer standing in for the window
+	GLuint m_windowFramebuffer;
+	GLuint m_windowColorTexture;
+	GLuint m_windowDepthRenderbuffer;
+	// recorded name of the program in use during the replay
+	GLuint m_currentProgram;
+	// memory read by the current call, copied to word alignment
+	std::vector<GLuint> m_alignedData;
+	// replayed calls and their CPU time by type
+	unsigned long long m_callCounts[TraceRecorder::CALL_COUNT];
+	double m_callMilliseconds[TraceRecorder::CALL_COUNT];
+	int m_replayCount;
+	double m_totalMilliseconds;
+	double m_lastMilliseconds;
+
+	// read from a section of the trace
+	static GLuint ReadWord(TRACE_READER& reader);
+	static GLfloat ReadFloat(TRACE_READER& reader);
+	static const unsigned char* ReadData(TRACE_READER& reader, GLuint& size);
+	static TRACE_READER StartReading(const std::vector<unsigned char>& section);
+
+	// map recorded names and uniform locations to created ones
+	GLuint MapName(TraceRecorder::RESOURCE resource, GLuint name) const;
+	void SetName(TraceRecorder::RESOURCE resource, GLuint name, GLuint createdName);
+	GLint MapLocation(GLint location) const;
+	void SetLocation(GLuint program, GLint location, GLint createdLocation);
+
+	// create one saved object of each type
+	void CreateBuffer(TRACE_READER& reader);
+	void CreateTexture(TRACE_READER& reader);
+	void CreateRenderbuffer(TRACE_READER& reader);
+	void CreateProgram(TRACE_READER& reader);
+	void CreateVertexArray(TRACE_READER& reader);
+	void CreateFramebuffer(TRACE_READER& reader);
+	// set the saved state and uniform values
+	void RestoreState();
+	void RestoreUniforms();
+	// make one recorded call with the mapped arguments
+	void ExecuteCall(TraceRecorder::CALL call, const GLuint* pWords, const unsigned char* pData, GLuint dataSize);
+
+public:
+	// read a trace file written by the TraceRecorder
+	bool Load(const char* filename);
+	// create the saved objects and the window framebuffer
+	bool CreateResources();
+	// free every created object
+	void DestroyResources();
+	// make every recorded call of the frame
+	void ReplayFrame();
+
+	// get the size of the window the frame was drawn into
+	int GetWindowWidth() const;
+	int GetWindowHeight() const;
+	// get the CPU time of the last replay in milliseconds
+	double GetLastMilliseconds() const;
+	// clear and output the CPU time of each call type
+	void ResetProfile();
+	void ReportProfile() const;
+};
@@ -0,0 +1,1823 @@
+///////////////////////////////////////////////////////////////////////////////
+// tracerecorder.cpp
+// ============
+// record the OpenGL calls of a frame into a binary trace file
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TraceRecorder.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+// declare the global variables
+namespace
+{
+	// display name, number of argument words and whether the
+	// memory read by the call follows, for every recorded call
+	struct CALL_INFO
+	{
+		const char* name;
+		int wordCount;
+		bool bHasData;
+	};
+	const CALL_INFO CALL_TABLE[TraceRecorder::CALL_COUNT] =
+	{
+		{ "glEnable", 1, false },
+		{ "glDisable", 1, false },
+		{ "glBlendFunc", 2, false },
+		{ "glBlendFunci", 3, false },
+		{ "glDepthMask", 1, false },
+		{ "glDepthFunc", 1, false },
+		{ "glCullFace", 1, false },
+		{ "glColorMask", 4, false },
+		{ "glPolygonOffset", 2, false },
+		{ "glViewport", 4, false },
+		{ "glClearColor", 4, false },
+		{ "glClear", 1, false },
+		{ "glClearBufferfv", 2, true },
+		{ "glActiveTexture", 1, false },
+		{ "glBindTexture", 2, false },
+		{ "glTexParameteri", 3, false },
+		{ "glTexImage2D", 9, true },
+		{ "glGenerateMipmap", 1, false },
+		{ "glUseProgram", 1, false },
+		{ "glGetUniformLocation", 2, true },
+		{ "glUniform1i", 2, false },
+		{ "glUniform1f", 2, false },
+		{ "glUniform2f", 3, false },
+		{ "glUniform3f", 4, false },
+		{ "glUniform4f", 5, false },
+		{ "glUniform2fv", 2, true },
+		{ "glUniform3fv", 2, true },
+		{ "glUniform4fv", 2, true },
+		{ "glUniform4iv", 2, true },
+		{ "glUniformMatrix3fv", 3, true },
+		{ "glUniformMatrix4fv", 3, true },
+		{ "glBindVertexArray", 1, false },
+		{ "glBindBuffer", 2, false },
+		{ "glBindBufferBase", 3, false },
+		{ "glBindBufferRange", 5, false },
+		{ "glBufferData", 3, true },
+		{ "glBufferSubData", 3, true },
+		{ "glBindFramebuffer", 2, false },
+		{ "glDrawBuffer", 1, false },
+		{ "glDrawBuffers", 1, true },
+		{ "glReadBuffer", 1, false },
+		{ "glBlitFramebuffer", 10, false },
+		{ "glDrawArrays", 3, false },
+		{ "glDrawArraysInstanced", 4, false },
+		{ "glDrawElements", 4, false },
+		{ "glDrawElementsInstanced", 5, false },
+		{ "glDispatchCompute", 3, false },
+		{ "glMemoryBarrier", 1, false }
+	};
+
+	// capabilities whose enabled state is saved
+	const GLenum STATE_CAPABILITIES[] =
+	{
+		GL_BLEND,
+		GL_DEPTH_TEST,
+		GL_CULL_FACE,
+		GL_POLYGON_OFFSET_FILL,
+		GL_SCISSOR_TEST,
+		GL_STENCIL_TEST,
+		GL_RASTERIZER_DISCARD,
+		GL_PROGRAM_POINT_SIZE,
+		GL_TEXTURE_CUBE_MAP_SEAMLESS,
+		GL_FRAMEBUFFER_SRGB
+	};
+	// texture targets whose bindings are saved for every unit
+	const GLenum STATE_TEXTURE_TARGETS[] = { GL_TEXTURE_2D, GL_TEXTURE_2D_ARRAY, GL_TEXTURE_3D, GL_TEXTURE_CUBE_MAP };
+	const GLenum STATE_TEXTURE_BINDINGS[] = {
+		GL_TEXTURE_BINDING_2D, GL_TEXTURE_BINDING_2D_ARRAY, GL_TEXTURE_BINDING_3D, GL_TEXTURE_BINDING_CUBE_MAP };
+	// most texture units whose bindings are saved
+	const int STATE_TEXTURE_UNITS = 48;
+	// names probed past the last object found before giving up
+	const GLuint PROBE_MISS_LIMIT = 256;
+
+	// true while the calls are written into the call stream
+	bool g_bRecording = false;
+	// recorded calls and their numbers by type
+	std::vector<unsigned char> g_callData;
+	int g_callCounts[TraceRecorder::CALL_COUNT];
+
+	// OpenGL 1.1 entry points, hooked in the import table
+	typedef void (GLAPIENTRY* ENUM_FUNCTION)(GLenum);
+	typedef void (GLAPIENTRY* CLEAR_FUNCTION)(GLbitfield);
+	typedef void (GLAPIENTRY* BLEND_FUNC_FUNCTION)(GLenum, GLenum);
+	typedef void (GLAPIENTRY* DEPTH_MASK_FUNCTION)(GLboolean);
+	typedef void (GLAPIENTRY* COLOR_MASK_FUNCTION)(GLboolean, GLboolean, GLboolean, GLboolean);
+	typedef void (GLAPIENTRY* POLYGON_OFFSET_FUNCTION)(GLfloat, GLfloat);
+	typedef void (GLAPIENTRY* VIEWPORT_FUNCTION)(GLint, GLint, GLsizei, GLsizei);
+	typedef void (GLAPIENTRY* CLEAR_COLOR_FUNCTION)(GLfloat, GLfloat, GLfloat, GLfloat);
+	typedef void (GLAPIENTRY* BIND_TEXTURE_FUNCTION)(GLenum, GLuint);
+	typedef void (GLAPIENTRY* TEX_PARAMETERI_FUNCTION)(GLenum, GLenum, GLint);
+	typedef void (GLAPIENTRY* TEX_IMAGE_2D_FUNCTION)(GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const void*);
+	typedef void (GLAPIENTRY* DRAW_ARRAYS_FUNCTION)(GLenum, GLint, GLsizei);
+	typedef void (GLAPIENTRY* DRAW_ELEMENTS_FUNCTION)(GLenum, GLsizei, GLenum, const void*);
+
+	// original entry points the hooks call after recording
+	ENUM_FUNCTION g_originalEnable = NULL;
+	ENUM_FUNCTION g_originalDisable = NULL;
+	BLEND_FUNC_FUNCTION g_originalBlendFunc = NULL;
+	DEPTH_MASK_FUNCTION g_originalDepthMask = NULL;
+	ENUM_FUNCTION g_originalDepthFunc = NULL;
+	ENUM_FUNCTION g_originalCullFace = NULL;
+	COLOR_MASK_FUNCTION g_originalColorMask = NULL;
+	POLYGON_OFFSET_FUNCTION g_originalPolygonOffset = NULL;
+	VIEWPORT_FUNCTION g_originalViewport = NULL;
+	CLEAR_COLOR_FUNCTION g_originalClearColor = NULL;
+	CLEAR_FUNCTION g_originalClear = NULL;
+	BIND_TEXTURE_FUNCTION g_originalBindTexture = NULL;
+	TEX_PARAMETERI_FUNCTION g_originalTexParameteri = NULL;
+	TEX_IMAGE_2D_FUNCTION g_originalTexImage2D = NULL;
+	ENUM_FUNCTION g_originalDrawBuffer = NULL;
+	ENUM_FUNCTION g_originalReadBuffer = NULL;
+	DRAW_ARRAYS_FUNCTION g_originalDrawArrays = NULL;
+	DRAW_ELEMENTS_FUNCTION g_originalDrawElements = NULL;
+	PFNGLBLENDFUNCIPROC g_originalBlendFunci = NULL;
+	PFNGLCLEARBUFFERFVPROC g_originalClearBufferfv = NULL;
+	PFNGLACTIVETEXTUREPROC g_originalActiveTexture = NULL;
+	PFNGLGENERATEMIPMAPPROC g_originalGenerateMipmap = NULL;
+	PFNGLUSEPROGRAMPROC g_originalUseProgram = NULL;
+	PFNGLGETUNIFORMLOCATIONPROC g_originalGetUniformLocation = NULL;
+	PFNGLUNIFORM1IPROC g_originalUniform1i = NULL;
+	PFNGLUNIFORM1FPROC g_originalUniform1f = NULL;
+	PFNGLUNIFORM2FPROC g_originalUniform2f = NULL;
+	PFNGLUNIFORM3FPROC g_originalUniform3f = NULL;
+	PFNGLUNIFORM4FPROC g_originalUniform4f = NULL;
+	PFNGLUNIFORM2FVPROC g_originalUniform2fv = NULL;
+	PFNGLUNIFORM3FVPROC g_originalUniform3fv = NULL;
+	PFNGLUNIFORM4FVPROC g_originalUniform4fv = NULL;
+	PFNGLUNIFORM4IVPROC g_originalUniform4iv = NULL;
+	PFNGLUNIFORMMATRIX3FVPROC g_originalUniformMatrix3fv = NULL;
+	PFNGLUNIFORMMATRIX4FVPROC g_originalUniformMatrix4fv = NULL;
+	PFNGLBINDVERTEXARRAYPROC g_originalBindVertexArray = NULL;
+	PFNGLBINDBUFFERPROC g_originalBindBuffer = NULL;
+	PFNGLBINDBUFFERBASEPROC g_originalBindBufferBase = NULL;
+	PFNGLBINDBUFFERRANGEPROC g_originalBindBufferRange = NULL;
+	PFNGLBUFFERDATAPROC g_originalBufferData = NULL;
+	PFNGLBUFFERSUBDATAPROC g_originalBufferSubData = NULL;
+	PFNGLBINDFRAMEBUFFERPROC g_originalBindFramebuffer = NULL;
+	PFNGLDRAWBUFFERSPROC g_originalDrawBuffers = NULL;
+	PFNGLBLITFRAMEBUFFERPROC g_originalBlitFramebuffer = NULL;
+	PFNGLDRAWARRAYSINSTANCEDPROC g_originalDrawArraysInstanced = NULL;
+	PFNGLDRAWELEMENTSINSTANCEDPROC g_originalDrawElementsInstanced = NULL;
+	PFNGLDISPATCHCOMPUTEPROC g_originalDispatchCompute = NULL;
+	PFNGLMEMORYBARRIERPROC g_originalMemoryBarrier = NULL;
+
+	/***********************************************************
+	 *  PutWord()
+	 *
+	 *  This function is used for appending a 32 bit word to the
+	 *  passed in stream.
+	 ***********************************************************/
+	void PutWord(std::vector<unsigned char>& stream, GLuint word)
+	{
+		size_t offset = stream.size();
+		stream.resize(offset + sizeof(GLuint));
+		memcpy(&stream[offset], &word, sizeof(GLuint));
+	}
+
+	/***********************************************************
+	 *  PutFloat()
+	 *
+	 *  This function is used for appending the bits of a float
+	 *  to the passed in stream.
+	 ***********************************************************/
+	void PutFloat(std::vector<unsigned char>& stream, GLfloat value)
+	{
+		GLuint word = 0;
+		memcpy(&word, &value, sizeof(GLuint));
+		PutWord(stream, word);
+	}
+
+	/***********************************************************
+	 *  PutData()
+	 *
+	 *  This function is used for appending the size of a block
+	 *  of memory and its contents to the passed in stream.  A
+	 *  missing block is written with a size of zero.
+	 ***********************************************************/
+	void PutData(std::vector<unsigned char>& stream, const void* pData, size_t size)
+	{
+		if (NULL == pData)
+		{
+			size = 0;
+		}
+		PutWord(stream, (GLuint)size);
+		if (size > 0)
+		{
+			size_t offset = stream.size();
+			stream.resize(offset + size);
+			memcpy(&stream[offset], pData, size);
+		}
+	}
+
+	/***********************************************************
+	 *  BeginCall()
+	 *
+	 *  This function is used for starting the record of a call
+	 *  when the calls are being recorded.  It returns false when
+	 *  they are not, so the hook only forwards the call.
+	 ***********************************************************/
+	bool BeginCall(TraceRecorder::CALL call)
+	{
+		if (g_bRecording == false)
+		{
+			return(false);
+		}
+		g_callData.push_back((unsigned char)call);
+		g_callCounts[call]++;
+		return(true);
+	}
+
+	/***********************************************************
+	 *  GetPixelBytes()
+	 *
+	 *  This function is used for getting the size of one pixel
+	 *  of client memory with the passed in format and type.
+	 ***********************************************************/
+	size_t GetPixelBytes(GLenum format, GLenum type)
+	{
+		switch (type)
+		{
+		case GL_UNSIGNED_INT_24_8:
+		case GL_UNSIGNED_INT_10F_11F_11F_REV:
+		case GL_UNSIGNED_INT_2_10_10_10_REV:
+			return(4);
+		case GL_FLOAT_32_UNSIGNED_INT_24_8_REV:
+			return(8);
+		}
+
+		size_t componentBytes = 1;
+		if ((type == GL_SHORT) || (type == GL_UNSIGNED_SHORT) || (type == GL_HALF_FLOAT))
+		{
+			componentBytes = 2;
+		}
+		else if ((type == GL_INT) || (type == GL_UNSIGNED_INT) || (type == GL_FLOAT))
+		{
+			componentBytes = 4;
+		}
+
+		switch (format)
+		{
+		case GL_RG:
+		case GL_RG_INTEGER:
+			return(componentBytes * 2);
+		case GL_RGB:
+		case GL_BGR:
+		case GL_RGB_INTEGER:
+			return(componentBytes * 3);
+		case GL_RGBA:
+		case GL_BGRA:
+		case GL_RGBA_INTEGER:
+			return(componentBytes * 4);
+		}
+		return(componentBytes);
+	}
+
+	/***********************************************************
+	 *  The hooks below record each call when the calls are
+	 *  being recorded, then make the call through the original
+	 *  entry point.  Pointers into buffer objects, such as the
+	 *  index offset of a draw, are recorded as offsets.
+	 ***********************************************************/
+	void GLAPIENTRY TraceEnable(GLenum cap)
+	{
+		if (BeginCall(TraceRecorder::CALL_ENABLE) == true)
+		{
+			PutWord(g_callData, cap);
+		}
+		g_originalEnable(cap);
+	}
+
+	void GLAPIENTRY TraceDisable(GLenum cap)
+	{
+		if (BeginCall(TraceRecorder::CALL_DISABLE) == true)
+		{
+			PutWord(g_callData, cap);
+		}
+		g_originalDisable(cap);
+	}
+
+	void GLAPIENTRY TraceBlendFunc(GLenum sfactor, GLenum dfactor)
+	{
+		if (BeginCall(TraceRecorder::CALL_BLEND_FUNC) == true)
+		{
+			PutWord(g_callData, sfactor);
+			PutWord(g_callData, dfactor);
+		}
+		g_originalBlendFunc(sfactor, dfactor);
+	}
+
+	void GLAPIENTRY TraceBlendFunci(GLuint buf, GLenum src, GLenum dst)
+	{
+		if (BeginCall(TraceRecorder::CALL_BLEND_FUNCI) == true)
+		{
+			PutWord(g_callData, buf);
+			PutWord(g_callData, src);
+			PutWord(g_callData, dst);
+		}
+		g_originalBlendFunci(buf, src, dst);
+	}
+
+	void GLAPIENTRY TraceDepthMask(GLboolean flag)
+	{
+		if (BeginCall(TraceRecorder::CALL_DEPTH_MASK) == true)
+		{
+			PutWord(g_callData, flag);
+		}
+		g_originalDepthMask(flag);
+	}
+
+	void GLAPIENTRY TraceDepthFunc(GLenum func)
+	{
+		if (BeginCall(TraceRecorder::CALL_DEPTH_FUNC) == true)
+		{
+			PutWord(g_callData, func);
+		}
+		g_originalDepthFunc(func);
+	}
+
+	void GLAPIENTRY TraceCullFace(GLenum mode)
+	{
+		if (BeginCall(TraceRecorder::CALL_CULL_FACE) == true)
+		{
+			PutWord(g_callData, mode);
+		}
+		g_originalCullFace(mode);
+	}
+
+	void GLAPIENTRY TraceColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha)
+	{
+		if (BeginCall(TraceRecorder::CALL_COLOR_MASK) == true)
+		{
+			PutWord(g_callData, red);
+			PutWord(g_callData, green);
+			PutWord(g_callData, blue);
+			PutWord(g_callData, alpha);
+		}
+		g_originalColorMask(red, green, blue, alpha);
+	}
+
+	void GLAPIENTRY TracePolygonOffset(GLfloat factor, GLfloat units)
+	{
+		if (BeginCall(TraceRecorder::CALL_POLYGON_OFFSET) == true)
+		{
+			PutFloat(g_callData, factor);
+			PutFloat(g_callData, units);
+		}
+		g_originalPolygonOffset(factor, units);
+	}
+
+	void GLAPIENTRY TraceViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+	{
+		if (BeginCall(TraceRecorder::CALL_VIEWPORT) == true)
+		{
+			PutWord(g_callData, x);
+			PutWord(g_callData, y);
+			PutWord(g_callData, width);
+			PutWord(g_callData, height);
+		}
+		g_originalViewport(x, y, width, height);
+	}
+
+	void GLAPIENTRY TraceClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+	{
+		if (BeginCall(TraceRecorder::CALL_CLEAR_COLOR) == true)
+		{
+			PutFloat(g_callData, red);
+			PutFloat(g_callData, green);
+			PutFloat(g_callData, blue);
+			PutFloat(g_callData, alpha);
+		}
+		g_originalClearColor(red, green, blue, alpha);
+	}
+
+	void GLAPIENTRY TraceClear(GLbitfield mask)
+	{
+		if (BeginCall(TraceRecorder::CALL_CLEAR) == true)
+		{
+			PutWord(g_callData, mask);
+		}
+		g_originalClear(mask);
+	}
+
+	void GLAPIENTRY TraceClearBufferfv(GLenum buffer, GLint drawbuffer, const GLfloat* value)
+	{
+		if (BeginCall(TraceRecorder::CALL_CLEAR_BUFFERFV) == true)
+		{
+			PutWord(g_callData, buffer);
+			PutWord(g_callData, drawbuffer);
+			PutData(g_callData, value, ((buffer == GL_COLOR) ? 4 : 1) * sizeof(GLfloat));
+		}
+		g_originalClearBufferfv(buffer, drawbuffer, value);
+	}
+
+	void GLAPIENTRY TraceActiveTexture(GLenum texture)
+	{
+		if (BeginCall(TraceRecorder::CALL_ACTIVE_TEXTURE) == true)
+		{
+			PutWord(g_callData, texture);
+		}
+		g_originalActiveTexture(texture);
+	}
+
+	void GLAPIENTRY TraceBindTexture(GLenum target, GLuint texture)
+	{
+		if (BeginCall(TraceRecorder::CALL_BIND_TEXTURE) == true)
+		{
+			PutWord(g_callData, target);
+			PutWord(g_callData, texture);
+		}
+		g_originalBindTexture(target, texture);
+	}
+
+	void GLAPIENTRY TraceTexParameteri(GLenum target, GLenum pname, GLint param)
+	{
+		if (BeginCall(TraceRecorder::CALL_TEX_PARAMETERI) == true)
+		{
+			PutWord(g_callData, target);
+			PutWord(g_callData, pname);
+			PutWord(g_callData, param);
+		}
+		g_originalTexParameteri(target, pname, param);
+	}
+
+	void GLAPIENTRY TraceTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width,
+		GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels)
+	{
+		if (BeginCall(TraceRecorder::CALL_TEX_IMAGE_2D) == true)
+		{
+			// rows of client memory start on the unpack alignment
+			GLint alignment = 4;
+			glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+			size_t rowBytes = GetPixelBytes(format, type) * width;
+			rowBytes = ((rowBytes + alignment - 1) / alignment) * alignment;
+
+			PutWord(g_callData, target);
+			PutWord(g_callData, level);
+			PutWord(g_callData, internalformat);
+			PutWord(g_callData, width);
+			PutWord(g_callData, height);
+			PutWord(g_callData, border);
+			PutWord(g_callData, format);
+			PutWord(g_callData, type);
+			PutWord(g_callData, alignment);
+			PutData(g_callData, pixels, rowBytes * height);
+		}
+		g_originalTexImage2D(target, level, internalformat, width, height, border, format, type, pixels);
+	}
+
+	void GLAPIENTRY TraceGenerateMipmap(GLenum target)
+	{
+		if (BeginCall(TraceRecorder::CALL_GENERATE_MIPMAP) == true)
+		{
+			PutWord(g_callData, target);
+		}
+		g_originalGenerateMipmap(target);
+	}
+
+	void GLAPIENTRY TraceUseProgram(GLuint program)
+	{
+		if (BeginCall(TraceRecorder::CALL_USE_PROGRAM) == true)
+		{
+			PutWord(g_callData, program);
+		}
+		g_originalUseProgram(program);
+	}
+
+	GLint GLAPIENTRY TraceGetUniformLocation(GLuint program, const GLchar* name)
+	{
+		// the location is recorded so the player can map it
+		GLint location = g_originalGetUniformLocation(program, name);
+		if (BeginCall(TraceRecorder::CALL_GET_UNIFORM_LOCATION) == true)
+		{
+			PutWord(g_callData, program);
+			PutWord(g_callData, location);
+			PutData(g_callData, name, strlen(name) + 1);
+		}
+		return(location);
+	}
+
+	void GLAPIENTRY TraceUniform1i(GLint location, GLint v0)
+	{
+		if (BeginCall(TraceRecorder::CALL_UNIFORM_1I) == true)
+		{
+			PutWord(g_callData, location);
+			PutWord(g_callData, v0);
+		}
+		g_originalUniform1i(location, v0);
+	}
+
+	void GLAPIENTRY TraceUniform1f(GLint location, GLfloat v0)
+	{
+		if (BeginCall(TraceRecorder::CALL_UNIFORM_1F) == true)
+		{
+			PutWord(g_callData, location);
+			PutFloat(g_callData, v0);
+		}
+		g_originalUniform1f(location, v0);
+	}
+
+	void GLAPIENTRY TraceUniform2f(GLint location, GLfloat v0, GLfloat v1)
+	{
+		if (BeginCall(TraceRecorder::CALL_UNIFORM_2F) == true)
+		{
+			PutWord(g_callData, location);
+			PutFloat(g_callData, v0);
+			PutFloat(g_callData, v1);
+		}
+		g_originalUniform2f(location, v0, v1);
+	}
+
+	void GLAPIENTRY TraceUniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2)
+	{
+		if (BeginCall(TraceRecorder::CALL_UNIFORM_3F) == true)
+		{
+			PutWord(g_callData, location);
+			PutFloat(g_callData, v0);
+			PutFloat(g_callData, v1);
+			PutFloat(g_callData, v2);
+		}
+		g_originalUniform3f(location, v0, v1, v2);
+	}
+
+	void GLAPIENTRY TraceUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)
+	{
+		if (BeginCall(TraceRecorder::CALL_UNIFORM_4F) == true)
+		{
+			PutWord(g_callData, location);
+			PutFloat(g_callData, v0);
+			PutFloat(g_callData, v1);
+			PutFloat(g_callData, v2);
+			PutFloat(g_callData, v3);
+		}
+		g_originalUniform4f(location, v0, v1, v2, v3);
+	}
+
+	void GLAPIENTRY TraceUniform2fv(GLint location, GLsizei count, const GLfloat* value)
+	{
+		if (BeginCall(TraceRecorder::CALL_UNIFORM_2FV) == true)
+		{
+			PutWord(g_callData, location);
+			PutWord(g_callData, count);
+			PutData(g_callData, value, count * 2 * sizeof(GLfloat));
+		}
+		g_originalUniform2fv(location, count, value);
+	}
+
+	void GLAPIENTRY TraceUniform3fv(GLint location, GLsizei count, const GLfloat* value)
+	{
+		if (BeginCall(TraceRecorder::CALL_UNIFORM_3FV) == true)
+		{
+			PutWord(g_callData, location);
+			PutWord(g_callData, count);
+			PutData(g_callData, value, count * 3 * sizeof(GLfloat));
+		}
+		g_originalUniform3fv(location, count, value);
+	}
+
+	void GLAPIENTRY TraceUniform4fv(GLint location, GLsizei count, const GLfloat* value)
+	{
+		if (BeginCall(TraceRecorder::CALL_UNIFORM_4FV) == true)
+		{
+			PutWord(g_callData, location);
+			PutWord(g_callData, count);
+			PutData(g_callData, value, count * 4 * sizeof(GLfloat));
+		}
+		g_originalUniform4fv(location, count, value);
+	}
+
+	void GLAPIENTRY TraceUniform4iv(GLint location, GLsizei count, const GLint* value)
+	{
+		if (BeginCall(TraceRecorder::CALL_UNIFORM_4IV) == true)
+		{
+			PutWord(g_callData, location);
+			PutWord(g_callData, count);
+			PutData(g_callData, value, count * 4 * sizeof(GLint));
+		}
+		g_originalUniform4iv(location, count, value);
+	}
+
+	void GLAPIENTRY TraceUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+	{
+		if (BeginCall(TraceRecorder::CALL_UNIFORM_MATRIX_3FV) == true)
+		{
+			PutWord(g_callData, location);
+			PutWord(g_callData, count);
+			PutWord(g_callData, transpose);
+			PutData(g_callData, value, count * 9 * sizeof(GLfloat));
+		}
+		g_originalUniformMatrix3fv(location, count, transpose, value);
+	}
+
+	void GLAPIENTRY TraceUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+	{
+		if (BeginCall(TraceRecorder::CALL_UNIFORM_MATRIX_4FV) == true)
+		{
+			PutWord(g_callData, location);
+			PutWord(g_callData, count);
+			PutWord(g_callData, transpose);
+			PutData(g_callData, value, count * 16 * sizeof(GLfloat));
+		}
+		g_originalUniformMatrix4fv(location, count, transpose, value);
+	}
+
+	void GLAPIENTRY TraceBindVertexArray(GLuint array)
+	{
+		if (BeginCall(TraceRecorder::CALL_BIND_VERTEX_ARRAY) == true)
+		{
+			PutWord(g_callData, array);
+		}
+		g_originalBindVertexArray(array);
+	}
+
+	void GLAPIENTRY TraceBindBuffer(GLenum target, GLuint buffer)
+	{
+		if (BeginCall(TraceRecorder::CALL_BIND_BUFFER) == true)
+		{
+			PutWord(g_callData, target);
+			PutWord(g_callData, buffer);
+		}
+		g_originalBindBuffer(target, buffer);
+	}
+
+	void GLAPIENTRY TraceBindBufferBase(GLenum target, GLuint index, GLuint buffer)
+	{
+		if (BeginCall(TraceRecorder::CALL_BIND_BUFFER_BASE) == true)
+		{
+			PutWord(g_callData, target);
+			PutWord(g_callData, index);
+			PutWord(g_callData, buffer);
+		}
+		g_originalBindBufferBase(target, index, buffer);
+	}
+
+	void GLAPIENTRY TraceBindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+	{
+		if (BeginCall(TraceRecorder::CALL_BIND_BUFFER_RANGE) == true)
+		{
+			PutWord(g_callData, target);
+			PutWord(g_callData, index);
+			PutWord(g_callData, buffer);
+			PutWord(g_callData, (GLuint)offset);
+			PutWord(g_callData, (GLuint)size);
+		}
+		g_originalBindBufferRange(target, index, buffer, offset, size);
+	}
+
+	void GLAPIENTRY TraceBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+	{
+		if (BeginCall(TraceRecorder::CALL_BUFFER_DATA) == true)
+		{
+			PutWord(g_callData, target);
+			PutWord(g_callData, (GLuint)size);
+			PutWord(g_callData, usage);
+			PutData(g_callData, data, size);
+		}
+		g_originalBufferData(target, size, data, usage);
+	}
+
+	void GLAPIENTRY TraceBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+	{
+		if (BeginCall(TraceRecorder::CALL_BUFFER_SUB_DATA) == true)
+		{
+			PutWord(g_callData, target);
+			PutWord(g_callData, (GLuint)offset);
+			PutWord(g_callData, (GLuint)size);
+			PutData(g_callData, data, size);
+		}
+		g_originalBufferSubData(target, offset, size, data);
+	}
+
+	void GLAPIENTRY TraceBindFramebuffer(GLenum target, GLuint framebuffer)
+	{
+		if (BeginCall(TraceRecorder::CALL_BIND_FRAMEBUFFER) == true)
+		{
+			PutWord(g_callData, target);
+			PutWord(g_callData, framebuffer);
+		}
+		g_originalBindFramebuffer(target, framebuffer);
+	}
+
+	void GLAPIENTRY TraceDrawBuffer(GLenum buf)
+	{
+		if (BeginCall(TraceRecorder::CALL_DRAW_BUFFER) == true)
+		{
+			PutWord(g_callData, buf);
+		}
+		g_originalDrawBuffer(buf);
+	}
+
+	void GLAPIENTRY TraceDrawBuffers(GLsizei n, const GLenum* bufs)
+	{
+		if (BeginCall(TraceRecorder::CALL_DRAW_BUFFERS) == true)
+		{
+			PutWord(g_callData, n);
+			PutData(g_callData, bufs, n * sizeof(GLenum));
+		}
+		g_originalDrawBuffers(n, bufs);
+	}
+
+	void GLAPIENTRY TraceReadBuffer(GLenum src)
+	{
+		if (BeginCall(TraceRecorder::CALL_READ_BUFFER) == true)
+		{
+			PutWord(g_callData, src);
+		}
+		g_originalReadBuffer(src);
+	}
+
+	void GLAPIENTRY TraceBlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1,
+		GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter)
+	{
+		if (BeginCall(TraceRecorder::CALL_BLIT_FRAMEBUFFER) == true)
+		{
+			PutWord(g_callData, srcX0);
+			PutWord(g_callData, srcY0);
+			PutWord(g_callData, srcX1);
+			PutWord(g_callData, srcY1);
+			PutWord(g_callData, dstX0);
+			PutWord(g_callData, dstY0);
+			PutWord(g_callData, dstX1);
+			PutWord(g_callData, dstY1);
+			PutWord(g_callData, mask);
+			PutWord(g_callData, filter);
+		}
+		g_originalBlitFramebuffer(srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter);
+	}
+
+	void GLAPIENTRY TraceDrawArrays(GLenum mode, GLint first, GLsizei count)
+	{
+		if (BeginCall(TraceRecorder::CALL_DRAW_ARRAYS) == true)
+		{
+			PutWord(g_callData, mode);
+			PutWord(g_callData, first);
+			PutWord(g_callData, count);
+		}
+		g_originalDrawArrays(mode, first, count);
+	}
+
+	void GLAPIENTRY TraceDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instancecount)
+	{
+		if (BeginCall(TraceRecorder::CALL_DRAW_ARRAYS_INSTANCED) == true)
+		{
+			PutWord(g_callData, mode);
+			PutWord(g_callData, first);
+			PutWord(g_callData, count);
+			PutWord(g_callData, instancecount);
+		}
+		g_originalDrawArraysInstanced(mode, first, count, instancecount);
+	}
+
+	void GLAPIENTRY TraceDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
+	{
+		if (BeginCall(TraceRecorder::CALL_DRAW_ELEMENTS) == true)
+		{
+			PutWord(g_callData, mode);
+			PutWord(g_callData, count);
+			PutWord(g_callData, type);
+			PutWord(g_callData, (GLuint)(size_t)indices);
+		}
+		g_originalDrawElements(mode, count, type, indices);
+	}
+
+	void GLAPIENTRY TraceDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount)
+	{
+		if (BeginCall(TraceRecorder::CALL_DRAW_ELEMENTS_INSTANCED) == true)
+		{
+			PutWord(g_callData, mode);
+			PutWord(g_callData, count);
+			PutWord(g_callData, type);
+			PutWord(g_callData, (GLuint)(size_t)indices);
+			PutWord(g_callData, instancecount);
+		}
+		g_originalDrawElementsInstanced(mode, count, type, indices, instancecount);
+	}
+
+	void GLAPIENTRY TraceDispatchCompute(GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z)
+	{
+		if (BeginCall(TraceRecorder::CALL_DISPATCH_COMPUTE) == true)
+		{
+			PutWord(g_callData, num_groups_x);
+			PutWord(g_callData, num_groups_y);
+			PutWord(g_callData, num_groups_z);
+		}
+		g_originalDispatchCompute(num_groups_x, num_groups_y, num_groups_z);
+	}
+
+	void GLAPIENTRY TraceMemoryBarrier(GLbitfield barriers)
+	{
+		if (BeginCall(TraceRecorder::CALL_MEMORY_BARRIER) == true)
+		{
+			PutWord(g_callData, barriers);
+		}
+		g_originalMemoryBarrier(barriers);
+	}
+
+#ifdef _WIN32
+	// OpenGL 1.1 entry point, its hook, and where the original goes
+	struct IMPORT_HOOK
+	{
+		const char* name;
+		void* pHook;
+		void** ppOriginal;
+	};
+
+	/***********************************************************
+	 *  PatchImports()
+	 *
+	 *  This function is used for replacing the addresses of the
+	 *  passed in opengl32.dll functions in the import table of
+	 *  the executable with their hooks.  Every call the
+	 *  executable makes to them then goes through the hooks.
+	 *  It returns the number of functions that were replaced.
+	 ***********************************************************/
+	int PatchImports(IMPORT_HOOK* pHooks, int hookCount)
+	{
+		unsigned char* pBase = (unsigned char*)GetModuleHandle(NULL);
+		IMAGE_DOS_HEADER* pDosHeader = (IMAGE_DOS_HEADER*)pBase;
+		IMAGE_NT_HEADERS* pNtHeaders = (IMAGE_NT_HEADERS*)(pBase + pDosHeader->e_lfanew);
+		IMAGE_DATA_DIRECTORY& directory = pNtHeaders->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_IMPORT];
+		IMAGE_IMPORT_DESCRIPTOR* pImport = (IMAGE_IMPORT_DESCRIPTOR*)(pBase + directory.VirtualAddress);
+		int patchedCount = 0;
+
+		for (; (directory.VirtualAddress != 0) && (pImport->Name != 0); pImport++)
+		{
+			if (_stricmp((const char*)(pBase + pImport->Name), "opengl32.dll") != 0)
+			{
+				continue;
+			}
+
+			IMAGE_THUNK_DATA* pNames = (IMAGE_THUNK_DATA*)(pBase + pImport->OriginalFirstThunk);
+			IMAGE_THUNK_DATA* pAddresses = (IMAGE_THUNK_DATA*)(pBase + pImport->FirstThunk);
+			for (; pNames->u1.AddressOfData != 0; pNames++, pAddresses++)
+			{
+				if (IMAGE_SNAP_BY_ORDINAL(pNames->u1.Ordinal))
+				{
+					continue;
+				}
+				IMAGE_IMPORT_BY_NAME* pName = (IMAGE_IMPORT_BY_NAME*)(pBase + pNames->u1.AddressOfData);
+				for (int i = 0; i < hookCount; i++)
+				{
+					if (strcmp((const char*)pName->Name, pHooks[i].name) != 0)
+					{
+						continue;
+					}
+					DWORD oldProtection = 0;
+					VirtualProtect(&pAddresses->u1.Function, sizeof(pAddresses->u1.Function), PAGE_READWRITE, &oldProtection);
+					*pHooks[i].ppOriginal = (void*)pAddresses->u1.Function;
+					pAddresses->u1.Function = (ULONG_PTR)pHooks[i].pHook;
+					VirtualProtect(&pAddresses->u1.Function, sizeof(pAddresses->u1.Function), oldProtection, &oldProtection);
+					patchedCount++;
+				}
+			}
+		}
+		return(patchedCount);
+	}
+#endif
+}
+
+/***********************************************************
+ *  TraceRecorder()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TraceRecorder::TraceRecorder()
+{
+	m_windowWidth = 0;
+	m_windowHeight = 0;
+	for (int i = 0; i < CALL_COUNT; i++)
+	{
+		m_callCounts[i] = 0;
+	}
+}
+
+/***********************************************************
+ *  ~TraceRecorder()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+TraceRecorder::~TraceRecorder()
+{
+	EndFrame();
+}
+
+/***********************************************************
+ *  InstallHooks()
+ *
+ *  This method is used for replacing the OpenGL entry points
+ *  with the recording hooks, once GLEW has been initialized.
+ *  The hooks stay installed and only forward the calls while
+ *  nothing is recorded.  It returns false when some of the
+ *  entry points could not be hooked.
+ ***********************************************************/
+bool TraceRecorder::InstallHooks()
+{
+	static bool bInstalled = false;
+	static bool bComplete = false;
+	if (bInstalled == true)
+	{
+		return(bComplete);
+	}
+	bInstalled = true;
+	bComplete = true;
+
+	// the entry points loaded by GLEW are function pointers
+	// that can be swapped directly
+	if ((NULL == __glewBlendFunci) || (NULL == __glewDispatchCompute) || (NULL == __glewMemoryBarrier))
+	{
+		bComplete = false;
+	}
+	g_originalBlendFunci = __glewBlendFunci;
+	g_originalClearBufferfv = __glewClearBufferfv;
+	g_originalActiveTexture = __glewActiveTexture;
+	g_originalGenerateMipmap = __glewGenerateMipmap;
+	g_originalUseProgram = __glewUseProgram;
+	g_originalGetUniformLocation = __glewGetUniformLocation;
+	g_originalUniform1i = __glewUniform1i;
+	g_originalUniform1f = __glewUniform1f;
+	g_originalUniform2f = __glewUniform2f;
+	g_originalUniform3f = __glewUniform3f;
+	g_originalUniform4f = __glewUniform4f;
+	g_originalUniform2fv = __glewUniform2fv;
+	g_originalUniform3fv = __glewUniform3fv;
+	g_originalUniform4fv = __glewUniform4fv;
+	g_originalUniform4iv = __glewUniform4iv;
+	g_originalUniformMatrix3fv = __glewUniformMatrix3fv;
+	g_originalUniformMatrix4fv = __glewUniformMatrix4fv;
+	g_originalBindVertexArray = __glewBindVertexArray;
+	g_originalBindBuffer = __glewBindBuffer;
+	g_originalBindBufferBase = __glewBindBufferBase;
+	g_originalBindBufferRange = __glewBindBufferRange;
+	g_originalBufferData = __glewBufferData;
+	g_originalBufferSubData = __glewBufferSubData;
+	g_originalBindFramebuffer = __glewBindFramebuffer;
+	g_originalDrawBuffers = __glewDrawBuffers;
+	g_originalBlitFramebuffer = __glewBlitFramebuffer;
+	g_originalDrawArraysInstanced = __glewDrawArraysInstanced;
+	g_originalDrawElementsInstanced = __glewDrawElementsInstanced;
+	g_originalDispatchCompute = __glewDispatchCompute;
+	g_originalMemoryBarrier = __glewMemoryBarrier;
+
+	__glewBlendFunci = TraceBlendFunci;
+	__glewClearBufferfv = TraceClearBufferfv;
+	__glewActiveTexture = TraceActiveTexture;
+	__glewGenerateMipmap = TraceGenerateMipmap;
+	__glewUseProgram = TraceUseProgram;
+	__glewGetUniformLocation = TraceGetUniformLocation;
+	__glewUniform1i = TraceUniform1i;
+	__glewUniform1f = TraceUniform1f;
+	__glewUniform2f = TraceUniform2f;
+	__glewUniform3f = TraceUniform3f;
+	__glewUniform4f = TraceUniform4f;
+	__glewUniform2fv = TraceUniform2fv;
+	__glewUniform3fv = TraceUniform3fv;
+	__glewUniform4fv = TraceUniform4fv;
+	__glewUniform4iv = TraceUniform4iv;
+	__glewUniformMatrix3fv = TraceUniformMatrix3fv;
+	__glewUniformMatrix4fv = TraceUniformMatrix4fv;
+	__glewBindVertexArray = TraceBindVertexArray;
+	__glewBindBuffer = TraceBindBuffer;
+	__glewBindBufferBase = TraceBindBufferBase;
+	__glewBindBufferRange = TraceBindBufferRange;
+	__glewBufferData = TraceBufferData;
+	__glewBufferSubData = TraceBufferSubData;
+	__glewBindFramebuffer = TraceBindFramebuffer;
+	__glewDrawBuffers = TraceDrawBuffers;
+	__glewBlitFramebuffer = TraceBlitFramebuffer;
+	__glewDrawArraysInstanced = TraceDrawArraysInstanced;
+	__glewDrawElementsInstanced = TraceDrawElementsInstanced;
+	__glewDispatchCompute = TraceDispatchCompute;
+	__glewMemoryBarrier = TraceMemoryBarrier;
+
+#ifdef _WIN32
+	// the OpenGL 1.1 entry points are imported from opengl32.dll
+	IMPORT_HOOK importHooks[] =
+	{
+		{ "glEnable", (void*)TraceEnable, (void**)&g_originalEnable },
+		{ "glDisable", (void*)TraceDisable, (void**)&g_originalDisable },
+		{ "glBlendFunc", (void*)TraceBlendFunc, (void**)&g_originalBlendFunc },
+		{ "glDepthMask", (void*)TraceDepthMask, (void**)&g_originalDepthMask },
+		{ "glDepthFunc", (void*)TraceDepthFunc, (void**)&g_originalDepthFunc },
+		{ "glCullFace", (void*)TraceCullFace, (void**)&g_originalCullFace },
+		{ "glColorMask", (void*)TraceColorMask, (void**)&g_originalColorMask },
+		{ "glPolygonOffset", (void*)TracePolygonOffset, (void**)&g_originalPolygonOffset },
+		{ "glViewport", (void*)TraceViewport, (void**)&g_originalViewport },
+		{ "glClearColor", (void*)TraceClearColor, (void**)&g_originalClearColor },
+		{ "glClear", (void*)TraceClear, (void**)&g_originalClear },
+		{ "glBindTexture", (void*)TraceBindTexture, (void**)&g_originalBindTexture },
+		{ "glTexParameteri", (void*)TraceTexParameteri, (void**)&g_originalTexParameteri },
+		{ "glTexImage2D", (void*)TraceTexImage2D, (void**)&g_originalTexImage2D },
+		{ "glDrawBuffer", (void*)TraceDrawBuffer, (void**)&g_originalDrawBuffer },
+		{ "glReadBuffer", (void*)TraceReadBuffer, (void**)&g_originalReadBuffer },
+		{ "glDrawArrays", (void*)TraceDrawArrays, (void**)&g_originalDrawArrays },
+		{ "glDrawElements", (void*)TraceDrawElements, (void**)&g_originalDrawElements }
+	};
+	const int importHookCount = sizeof(importHooks) / sizeof(importHooks[0]);
+	if (PatchImports(importHooks, importHookCount) != importHookCount)
+	{
+		bComplete = false;
+	}
+#else
+	// the executable links the OpenGL 1.1 entry points itself
+	bComplete = false;
+#endif
+
+	return(bComplete);
+}
+
+/***********************************************************
+ *  BeginFrame()
+ *
+ *  This method is used for saving every object and the bound
+ *  state, then recording the calls that follow.
+ ***********************************************************/
+void TraceRecorder::BeginFrame(int windowWidth, int windowHeight)
+{
+	m_windowWidth = windowWidth;
+	m_windowHeight = windowHeight;
+
+	m_resources.clear();
+	m_state.clear();
+	// objects are saved before the objects that refer to them
+	for (int i = 0; i < RESOURCE_COUNT; i++)
+	{
+		CaptureObjects((RESOURCE)i);
+	}
+	CaptureState();
+
+	g_callData.clear();
+	for (int i = 0; i < CALL_COUNT; i++)
+	{
+		g_callCounts[i] = 0;
+	}
+	g_bRecording = true;
+}
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method is used for stopping the recording and taking
+ *  the recorded calls.
+ ***********************************************************/
+void TraceRecorder::EndFrame()
+{
+	if (g_bRecording == false)
+	{
+		return;
+	}
+	g_bRecording = false;
+
+	m_calls.swap(g_callData);
+	g_callData.clear();
+	for (int i = 0; i < CALL_COUNT; i++)
+	{
+		m_callCounts[i] = g_callCounts[i];
+	}
+}
+
+/***********************************************************
+ *  IsRecording()
+ *
+ *  This method is used for checking whether the calls are
+ *  being recorded.
+ ***********************************************************/
+bool TraceRecorder::IsRecording() const
+{
+	return(g_bRecording);
+}
+
+/***********************************************************
+ *  CaptureObjects()
+ *
+ *  This method is used for saving every object of the passed
+ *  in type.  OpenGL has no list of objects, so the names are
+ *  probed in order until no object has been found for a
+ *  while.
+ ***********************************************************/
+void TraceRecorder::CaptureObjects(RESOURCE resource)
+{
+	GLuint missCount = 0;
+	for (GLuint name = 1; missCount < PROBE_MISS_LIMIT; name++)
+	{
+		bool bFound = false;
+		switch (resource)
+		{
+		case RESOURCE_BUFFER:
+			bFound = (glIsBuffer(name) == GL_TRUE);
+			if (bFound == true)
+			{
+				CaptureBuffer(name);
+			}
+			break;
+		case RESOURCE_TEXTURE:
+			bFound = (glIsTexture(name) == GL_TRUE);
+			if (bFound == true)
+			{
+				CaptureTexture(name);
+			}
+			break;
+		case RESOURCE_RENDERBUFFER:
+			bFound = (glIsRenderbuffer(name) == GL_TRUE);
+			if (bFound == true)
+			{
+				CaptureRenderbuffer(name);
+			}
+			break;
+		case RESOURCE_PROGRAM:
+			bFound = (glIsProgram(name) == GL_TRUE) || (glIsShader(name) == GL_TRUE);
+			if (glIsProgram(name) == GL_TRUE)
+			{
+				CaptureProgram(name);
+			}
+			break;
+		case RESOURCE_VERTEX_ARRAY:
+			bFound = (glIsVertexArray(name) == GL_TRUE);
+			if (bFound == true)
+			{
+				CaptureVertexArray(name);
+			}
+			break;
+		case RESOURCE_FRAMEBUFFER:
+			bFound = (glIsFramebuffer(name) == GL_TRUE);
+			if (bFound == true)
+			{
+				CaptureFramebuffer(name);
+			}
+			break;
+		default:
+			break;
+		}
+		missCount = (bFound == true) ? 0 : missCount + 1;
+	}
+}
+
+/***********************************************************
+ *  CaptureBuffer()
+ *
+ *  This method is used for saving the usage and contents of
+ *  the passed in buffer.
+ ***********************************************************/
+void TraceRecorder::CaptureBuffer(GLuint buffer)
+{
+	GLint64 size = 0;
+	GLint usage = GL_STATIC_DRAW;
+	glGetNamedBufferParameteri64v(buffer, GL_BUFFER_SIZE, &size);
+	glGetNamedBufferParameteriv(buffer, GL_BUFFER_USAGE, &usage);
+
+	std::vector<unsigned char> contents((size_t)size);
+	if (size > 0)
+	{
+		glGetNamedBufferSubData(buffer, 0, (GLsizeiptr)size, &contents[0]);
+	}
+
+	PutWord(m_resources, RESOURCE_BUFFER);
+	PutWord(m_resources, buffer);
+	PutWord(m_resources, usage);
+	PutWord(m_resources, (GLuint)size);
+	PutData(m_resources, contents.empty() ? NULL : &contents[0], contents.size());
+}
+
+/***********************************************************
+ *  CaptureTexture()
+ *
+ *  This method is used for saving the size, format, sampling
+ *  parameters and top level of the passed in 2D, 2D array
+ *  or 3D texture.  Depth textures keep their depths, color
+ *  textures are saved as 8 bit or float RGBA, and integer
+ *  and stencil textures are saved without contents.
+ ***********************************************************/
+void TraceRecorder::CaptureTexture(GLuint texture)
+{
+	GLint target = 0;
+	glGetTextureParameteriv(texture, GL_TEXTURE_TARGET, &target);
+	if ((target != GL_TEXTURE_2D) && (target != GL_TEXTURE_2D_ARRAY) && (target != GL_TEXTURE_3D))
+	{
+		return;
+	}
+
+	GLint internalFormat = 0;
+	GLint width = 0;
+	GLint height = 0;
+	GLint depth = 0;
+	glGetTextureLevelParameteriv(texture, 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+	glGetTextureLevelParameteriv(texture, 0, GL_TEXTURE_WIDTH, &width);
+	glGetTextureLevelParameteriv(texture, 0, GL_TEXTURE_HEIGHT, &height);
+	glGetTextureLevelParameteriv(texture, 0, GL_TEXTURE_DEPTH, &depth);
+	if ((width <= 0) || (height <= 0) || (depth <= 0))
+	{
+		return;
+	}
+
+	GLint immutable = GL_FALSE;
+	GLint levels = 0;
+	glGetTextureParameteriv(texture, GL_TEXTURE_IMMUTABLE_FORMAT, &immutable);
+	if (immutable == GL_TRUE)
+	{
+		glGetTextureParameteriv(texture, GL_TEXTURE_IMMUTABLE_LEVELS, &levels);
+	}
+	else
+	{
+		GLint levelWidth = width;
+		while ((levels < 16) && (levelWidth > 0))
+		{
+			levels++;
+			levelWidth = 0;
+			glGetTextureLevelParameteriv(texture, levels, GL_TEXTURE_WIDTH, &levelWidth);
+		}
+	}
+
+	const GLenum parameters[] = {
+		GL_TEXTURE_MIN_FILTER, GL_TEXTURE_MAG_FILTER, GL_TEXTURE_WRAP_S, GL_TEXTURE_WRAP_T,
+		GL_TEXTURE_WRAP_R, GL_TEXTURE_COMPARE_MODE, GL_TEXTURE_COMPARE_FUNC };
+	GLfloat borderColor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+	glGetTextureParameterfv(texture, GL_TEXTURE_BORDER_COLOR, borderColor);
+
+	// choose how the top level is read back
+	GLint depthSize = 0;
+	GLint stencilSize = 0;
+	GLint redType = GL_NONE;
+	GLint redSize = 0;
+	glGetTextureLevelParameteriv(texture, 0, GL_TEXTURE_DEPTH_SIZE, &depthSize);
+	glGetTextureLevelParameteriv(texture, 0, GL_TEXTURE_STENCIL_SIZE, &stencilSize);
+	glGetTextureLevelParameteriv(texture, 0, GL_TEXTURE_RED_TYPE, &redType);
+	glGetTextureLevelParameteriv(texture, 0, GL_TEXTURE_RED_SIZE, &redSize);
+	GLenum contentFormat = GL_NONE;
+	GLenum contentType = GL_NONE;
+	size_t texelBytes = 0;
+	if ((depthSize > 0) && (stencilSize == 0))
+	{
+		contentFormat = GL_DEPTH_COMPONENT;
+		contentType = GL_FLOAT;
+		texelBytes = sizeof(GLfloat);
+	}
+	else if ((depthSize == 0) && (redType == GL_UNSIGNED_NORMALIZED) && (redSize <= 8))
+	{
+		contentFormat = GL_RGBA;
+		contentType = GL_UNSIGNED_BYTE;
+		texelBytes = 4;
+	}
+	else if ((depthSize == 0) && (redType != GL_INT) && (redType != GL_UNSIGNED_INT))
+	{
+		contentFormat = GL_RGBA;
+		contentType = GL_FLOAT;
+		texelBytes = 4 * sizeof(GLfloat);
+	}
+
+	std::vector<unsigned char> contents((size_t)width * height * depth * texelBytes);
+	if (contents.empty() == false)
+	{
+		GLint packAlignment = 4;
+		glGetIntegerv(GL_PACK_ALIGNMENT, &packAlignment);
+		glPixelStorei(GL_PACK_ALIGNMENT, 4);
+		glGetTextureImage(texture, 0, contentFormat, contentType, (GLsizei)contents.size(), &contents[0]);
+		glPixelStorei(GL_PACK_ALIGNMENT, packAlignment);
+	}
+
+	PutWord(m_resources, RESOURCE_TEXTURE);
+	PutWord(m_resources, texture);
+	PutWord(m_resources, target);
+	PutWord(m_resources, internalFormat);
+	PutWord(m_resources, width);
+	PutWord(m_resources, height);
+	PutWord(m_resources, depth);
+	PutWord(m_resources, levels);
+	for (int i = 0; i < (int)(sizeof(parameters) / sizeof(parameters[0])); i++)
+	{
+		GLint value = 0;
+		glGetTextureParameteriv(texture, parameters[i], &value);
+		PutWord(m_resources, value);
+	}
+	for (int i = 0; i < 4; i++)
+	{
+		PutFloat(m_resources, borderColor[i]);
+	}
+	PutWord(m_resources, contentFormat);
+	PutWord(m_resources, contentType);
+	PutData(m_resources, contents.empty() ? NULL : &contents[0], contents.size());
+}
+
+/***********************************************************
+ *  CaptureRenderbuffer()
+ *
+ *  This method is used for saving the size and format of the
+ *  passed in renderbuffer, which is drawn during the frame.
+ ***********************************************************/
+void TraceRecorder::CaptureRenderbuffer(GLuint renderbuffer)
+{
+	GLint internalFormat = 0;
+	GLint width = 0;
+	GLint height = 0;
+	GLint samples = 0;
+	glGetNamedRenderbufferParameteriv(renderbuffer, GL_RENDERBUFFER_INTERNAL_FORMAT, &internalFormat);
+	glGetNamedRenderbufferParameteriv(renderbuffer, GL_RENDERBUFFER_WIDTH, &width);
+	glGetNamedRenderbufferParameteriv(renderbuffer, GL_RENDERBUFFER_HEIGHT, &height);
+	glGetNamedRenderbufferParameteriv(renderbuffer, GL_RENDERBUFFER_SAMPLES, &samples);
+
+	PutWord(m_resources, RESOURCE_RENDERBUFFER);
+	PutWord(m_resources, renderbuffer);
+	PutWord(m_resources, internalFormat);
+	PutWord(m_resources, width);
+	PutWord(m_resources, height);
+	PutWord(m_resources, samples);
+}
+
+/***********************************************************
+ *  CaptureProgram()
+ *
+ *  This method is used for saving the source of every shader
+ *  attached to the passed in program, its transform feedback
+ *  outputs, and the location and value of each of its
+ *  uniforms outside of uniform blocks.
+ ***********************************************************/
+void TraceRecorder::CaptureProgram(GLuint program)
+{
+	GLint shaderCount = 0;
+	glGetProgramiv(program, GL_ATTACHED_SHADERS, &shaderCount);
+	std::vector<GLuint> shaders(shaderCount + 1);
+	glGetAttachedShaders(program, shaderCount, NULL, &shaders[0]);
+
+	PutWord(m_resources, RESOURCE_PROGRAM);
+	PutWord(m_resources, program);
+	PutWord(m_resources, shaderCount);
+	for (int i = 0; i < shaderCount; i++)
+	{
+		GLint type = 0;
+		GLint sourceLength = 0;
+		glGetShaderiv(shaders[i], GL_SHADER_TYPE, &type);
+		glGetShaderiv(shaders[i], GL_SHADER_SOURCE_LENGTH, &sourceLength);
+		std::vector<GLchar> source(sourceLength + 1, 0);
+		glGetShaderSource(shaders[i], sourceLength + 1, NULL, &source[0]);
+		PutWord(m_resources, type);
+		PutData(m_resources, &source[0], strlen(&source[0]) + 1);
+	}
+
+	// transform feedback outputs are chosen before linking
+	GLint varyingCount = 0;
+	GLint varyingLength = 0;
+	GLint bufferMode = GL_INTERLEAVED_ATTRIBS;
+	glGetProgramiv(program, GL_TRANSFORM_FEEDBACK_VARYINGS, &varyingCount);
+	glGetProgramiv(program, GL_TRANSFORM_FEEDBACK_VARYING_MAX_LENGTH, &varyingLength);
+	glGetProgramiv(program, GL_TRANSFORM_FEEDBACK_BUFFER_MODE, &bufferMode);
+	PutWord(m_resources, varyingCount);
+	PutWord(m_resources, bufferMode);
+	for (int i = 0; i < varyingCount; i++)
+	{
+		std::vector<GLchar> name(varyingLength + 1, 0);
+		GLsizei size = 0;
+		GLenum type = GL_NONE;
+		glGetTransformFeedbackVarying(program, i, varyingLength + 1, NULL, &size, &type, &name[0]);
+		PutData(m_resources, &name[0], strlen(&name[0]) + 1);
+	}
+
+	// each element of a uniform array has its own location
+	GLint uniformCount = 0;
+	GLint uniformLength = 0;
+	glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniformCount);
+	glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &uniformLength);
+	std::vector<unsigned char> uniforms;
+	int savedCount = 0;
+	for (int i = 0; i < uniformCount; i++)
+	{
+		std::vector<GLchar> nameBuffer(uniformLength + 1, 0);
+		GLint size = 0;
+		GLenum type = GL_NONE;
+		glGetActiveUniform(program, i, uniformLength + 1, NULL, &size, &type, &nameBuffer[0]);
+		std::string name = &nameBuffer[0];
+		if ((size > 1) && (name.size() > 3) && (name.compare(name.size() - 3, 3, "[0]") == 0))
+		{
+			name.resize(name.size() - 3);
+		}
+
+		for (int element = 0; element < size; element++)
+		{
+			std::string elementName = (size > 1) ? name + "[" + std::to_string(element) + "]" : name;
+			GLint location = glGetUniformLocation(program, elementName.c_str());
+			if (location < 0)
+			{
+				continue;
+			}
+
+			// the uniform is read as the kind of value it holds
+			GLuint values[TRACE_UNIFORM_WORDS] = { 0 };
+			if ((type == GL_FLOAT) || (type == GL_FLOAT_VEC2) || (type == GL_FLOAT_VEC3) ||
+				(type == GL_FLOAT_VEC4) || (type == GL_FLOAT_MAT2) || (type == GL_FLOAT_MAT3) ||
+				(type == GL_FLOAT_MAT4))
+			{
+				glGetUniformfv(program, location, (GLfloat*)values);
+			}
+			else if ((type == GL_UNSIGNED_INT) || (type == GL_UNSIGNED_INT_VEC2) ||
+				(type == GL_UNSIGNED_INT_VEC3) || (type == GL_UNSIGNED_INT_VEC4))
+			{
+				glGetUniformuiv(program, location, values);
+			}
+			else
+			{
+				glGetUniformiv(program, location, (GLint*)values);
+			}
+
+			PutData(uniforms, elementName.c_str(), elementName.size() + 1);
+			PutWord(uniforms, type);
+			PutWord(uniforms, location);
+			for (int w = 0; w < TRACE_UNIFORM_WORDS; w++)
+			{
+				PutWord(uniforms, values[w]);
+			}
+			savedCount++;
+		}
+	}
+	PutWord(m_resources, savedCount);
+	m_resources.insert(m_resources.end(), uniforms.begin(), uniforms.end());
+}
+
+/***********************************************************
+ *  CaptureVertexArray()
+ *
+ *  This method is used for saving the index buffer, vertex
+ *  attribute formats and vertex buffer bindings of the
+ *  passed in vertex array.
+ ***********************************************************/
+void TraceRecorder::CaptureVertexArray(GLuint vertexArray)
+{
+	GLint boundVertexArray = 0;
+	glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &boundVertexArray);
+	glBindVertexArray(vertexArray);
+
+	GLint elementBuffer = 0;
+	glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &elementBuffer);
+	PutWord(m_resources, RESOURCE_VERTEX_ARRAY);
+	PutWord(m_resources, vertexArray);
+	PutWord(m_resources, elementBuffer);
+
+	const GLenum attributeParameters[] = {
+		GL_VERTEX_ATTRIB_ARRAY_ENABLED, GL_VERTEX_ATTRIB_ARRAY_SIZE, GL_VERTEX_ATTRIB_ARRAY_TYPE,
+		GL_VERTEX_ATTRIB_ARRAY_NORMALIZED, GL_VERTEX_ATTRIB_ARRAY_INTEGER,
+		GL_VERTEX_ATTRIB_RELATIVE_OFFSET, GL_VERTEX_ATTRIB_BINDING };
+	for (int i = 0; i < TRACE_VERTEX_ATTRIBUTES; i++)
+	{
+		for (int p = 0; p < (int)(sizeof(attributeParameters) / sizeof(attributeParameters[0])); p++)
+		{
+			GLint value = 0;
+			glGetVertexAttribiv(i, attributeParameters[p], &value);
+			PutWord(m_resources, value);
+		}
+	}
+	for (int i = 0; i < TRACE_VERTEX_ATTRIBUTES; i++)
+	{
+		GLint buffer = 0;
+		GLint stride = 0;
+		GLint divisor = 0;
+		GLint64 offset = 0;
+		glGetIntegeri_v(GL_VERTEX_BINDING_BUFFER, i, &buffer);
+		glGetIntegeri_v(GL_VERTEX_BINDING_STRIDE, i, &stride);
+		glGetIntegeri_v(GL_VERTEX_BINDING_DIVISOR, i, &divisor);
+		glGetInteger64i_v(GL_VERTEX_BINDING_OFFSET, i, &offset);
+		PutWord(m_resources, buffer);
+		PutWord(m_resources, (GLuint)offset);
+		PutWord(m_resources, stride);
+		PutWord(m_resources, divisor);
+	}
+
+	glBindVertexArray(boundVertexArray);
+}
+
+/***********************************************************
+ *  CaptureFramebuffer()
+ *
+ *  This method is used for saving the attachments, draw
+ *  buffers and read buffer of the passed in framebuffer.
+ ***********************************************************/
+void TraceRecorder::CaptureFramebuffer(GLuint framebuffer)
+{
+	PutWord(m_resources, RESOURCE_FRAMEBUFFER);
+	PutWord(m_resources, framebuffer);
+
+	for (int i = 0; i < TRACE_COLOR_ATTACHMENTS + 2; i++)
+	{
+		GLenum attachment = GL_COLOR_ATTACHMENT0 + i;
+		if (i == TRACE_COLOR_ATTACHMENTS)
+		{
+			attachment = GL_DEPTH_ATTACHMENT;
+		}
+		else if (i == TRACE_COLOR_ATTACHMENTS + 1)
+		{
+			attachment = GL_STENCIL_ATTACHMENT;
+		}
+
+		GLint objectType = GL_NONE;
+		GLint objectName = 0;
+		GLint level = 0;
+		GLint layer = 0;
+		GLint layered = GL_FALSE;
+		glGetNamedFramebufferAttachmentParameteriv(framebuffer, attachment, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, &objectType);
+		if (objectType != GL_NONE)
+		{
+			glGetNamedFramebufferAttachmentParameteriv(framebuffer, attachment, GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME, &objectName);
+		}
+		if (objectType == GL_TEXTURE)
+		{
+			glGetNamedFramebufferAttachmentParameteriv(framebuffer, attachment, GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LEVEL, &level);
+			glGetNamedFramebufferAttachmentParameteriv(framebuffer, attachment, GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LAYER, &layer);
+			glGetNamedFramebufferAttachmentParameteriv(framebuffer, attachment, GL_FRAMEBUFFER_ATTACHMENT_LAYERED, &layered);
+		}
+		PutWord(m_resources, attachment);
+		PutWord(m_resources, objectType);
+		PutWord(m_resources, objectName);
+		PutWord(m_resources, level);
+		PutWord(m_resources, layer);
+		PutWord(m_resources, layered);
+	}
+
+	// the draw buffers can only be read from the bound framebuffer
+	GLint drawFramebuffer = 0;
+	GLint readFramebuffer = 0;
+	glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &drawFramebuffer);
+	glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &readFramebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	for (int i = 0; i < TRACE_COLOR_ATTACHMENTS; i++)
+	{
+		GLint drawBuffer = GL_NONE;
+		glGetIntegerv(GL_DRAW_BUFFER0 + i, &drawBuffer);
+		PutWord(m_resources, drawBuffer);
+	}
+	GLint readBuffer = GL_NONE;
+	glGetIntegerv(GL_READ_BUFFER, &readBuffer);
+	PutWord(m_resources, readBuffer);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, drawFramebuffer);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, readFramebuffer);
+}
+
+/***********************************************************
+ *  CaptureState()
+ *
+ *  This method is used for saving the bound program, vertex
+ *  array, framebuffers, textures and buffers, and the fixed
+ *  function state that the recorded calls start from.
+ ***********************************************************/
+void TraceRecorder::CaptureState()
+{
+	const GLenum bindings[] = {
+		GL_CURRENT_PROGRAM, GL_VERTEX_ARRAY_BINDING, GL_DRAW_FRAMEBUFFER_BINDING,
+		GL_READ_FRAMEBUFFER_BINDING, GL_ARRAY_BUFFER_BINDING, GL_SHADER_STORAGE_BUFFER_BINDING,
+		GL_UNIFORM_BUFFER_BINDING, GL_ACTIVE_TEXTURE };
+	for (int i = 0; i < (int)(sizeof(bindings) / sizeof(bindings[0])); i++)
+	{
+		GLint value = 0;
+		glGetIntegerv(bindings[i], &value);
+		PutWord(m_state, value);
+	}
+
+	// textures bound to each unit
+	GLint activeTexture = GL_TEXTURE0;
+	GLint unitCount = 0;
+	glGetIntegerv(GL_ACTIVE_TEXTURE, &activeTexture);
+	glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &unitCount);
+	unitCount = (unitCount < STATE_TEXTURE_UNITS) ? unitCount : STATE_TEXTURE_UNITS;
+	const int targetCount = sizeof(STATE_TEXTURE_TARGETS) / sizeof(STATE_TEXTURE_TARGETS[0]);
+	PutWord(m_state, unitCount);
+	PutWord(m_state, targetCount);
+	for (int unit = 0; unit < unitCount; unit++)
+	{
+		glActiveTexture(GL_TEXTURE0 + unit);
+		for (int t = 0; t < targetCount; t++)
+		{
+			GLint texture = 0;
+			glGetIntegerv(STATE_TEXTURE_BINDINGS[t], &texture);
+			PutWord(m_state, STATE_TEXTURE_TARGETS[t]);
+			PutWord(m_state, texture);
+		}
+	}
+	glActiveTexture(activeTexture);
+
+	// buffers bound to the indexed storage and uniform bindings
+	const GLenum indexedTargets[] = { GL_SHADER_STORAGE_BUFFER, GL_UNIFORM_BUFFER };
+	const GLenum indexedBindings[][3] = {
+		{ GL_SHADER_STORAGE_BUFFER_BINDING, GL_SHADER_STORAGE_BUFFER_START, GL_SHADER_STORAGE_BUFFER_SIZE },
+		{ GL_UNIFORM_BUFFER_BINDING, GL_UNIFORM_BUFFER_START, GL_UNIFORM_BUFFER_SIZE } };
+	for (int t = 0; t < 2; t++)
+	{
+		for (int i = 0; i < TRACE_BUFFER_BINDINGS; i++)
+		{
+			GLint buffer = 0;
+			GLint64 start = 0;
+			GLint64 size = 0;
+			glGetIntegeri_v(indexedBindings[t][0], i, &buffer);
+			glGetInteger64i_v(indexedBindings[t][1], i, &start);
+			glGetInteger64i_v(indexedBindings[t][2], i, &size);
+			PutWord(m_state, indexedTargets[t]);
+			PutWord(m_state, buffer);
+			PutWord(m_state, (GLuint)start);
+			PutWord(m_state, (GLuint)size);
+		}
+	}
+
+	const int capabilityCount = sizeof(STATE_CAPABILITIES) / sizeof(STATE_CAPABILITIES[0]);
+	PutWord(m_state, capabilityCount);
+	for (int i = 0; i < capabilityCount; i++)
+	{
+		PutWord(m_state, STATE_CAPABILITIES[i]);
+		PutWord(m_state, glIsEnabled(STATE_CAPABILITIES[i]));
+	}
+
+	const GLenum values[] = {
+		GL_BLEND_SRC_RGB, GL_BLEND_DST_RGB, GL_BLEND_SRC_ALPHA, GL_BLEND_DST_ALPHA,
+		GL_DEPTH_FUNC, GL_CULL_FACE_MODE };
+	for (int i = 0; i < (int)(sizeof(values) / sizeof(values[0])); i++)
+	{
+		GLint value = 0;
+		glGetIntegerv(values[i], &value);
+		PutWord(m_state, value);
+	}
+	GLboolean depthMask = GL_TRUE;
+	GLboolean colorMask[4] = { GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE };
+	GLint viewport[4] = { 0, 0, 0, 0 };
+	GLfloat clearColor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+	GLfloat polygonOffset[2] = { 0.0f, 0.0f };
+	glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMask);
+	glGetBooleanv(GL_COLOR_WRITEMASK, colorMask);
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+	glGetFloatv(GL_POLYGON_OFFSET_FACTOR, &polygonOffset[0]);
+	glGetFloatv(GL_POLYGON_OFFSET_UNITS, &polygonOffset[1]);
+	PutWord(m_state, depthMask);
+	for (int i = 0; i < 4; i++)
+	{
+		PutWord(m_state, colorMask[i]);
+	}
+	for (int i = 0; i < 4; i++)
+	{
+		PutWord(m_state, viewport[i]);
+	}
+	for (int i = 0; i < 4; i++)
+	{
+		PutFloat(m_state, clearColor[i]);
+	}
+	PutFloat(m_state, polygonOffset[0]);
+	PutFloat(m_state, polygonOffset[1]);
+}
+
+/***********************************************************
+ *  Save()
+ *
+ *  This method is used for writing the window size, saved
+ *  objects, saved state and recorded calls into the passed
+ *  in trace file.
+ ***********************************************************/
+bool TraceRecorder::Save(const char* filename) const
+{
+	std::ofstream file(filename, std::ios::binary);
+	if (!file)
+	{
+		std::cout << "Could not write trace:" << filename << std::endl;
+		return(false);
+	}
+
+	std::vector<unsigned char> header;
+	PutWord(header, TRACE_MAGIC);
+	PutWord(header, TRACE_VERSION);
+	PutWord(header, m_windowWidth);
+	PutWord(header, m_windowHeight);
+	file.write((const char*)&header[0], header.size());
+
+	const std::vector<unsigned char>* sections[] = { &m_resources, &m_state, &m_calls };
+	for (int i = 0; i < 3; i++)
+	{
+		GLuint size = (GLuint)sections[i]->size();
+		file.write((const char*)&size, sizeof(size));
+		if (size > 0)
+		{
+			file.write((const char*)&(*sections[i])[0], size);
+		}
+	}
+
+	return(file.good());
+}
+
+/***********************************************************
+ *  GetCallCount()
+ *
+ *  This method is used for getting the number of recorded
+ *  calls of the passed in type.
+ ***********************************************************/
+int TraceRecorder::GetCallCount(CALL call) const
+{
+	return(m_callCounts[call]);
+}
+
+/***********************************************************
+ *  GetTotalCallCount()
+ *
+ *  This method is used for getting the number of recorded
+ *  calls of every type.
+ ***********************************************************/
+int TraceRecorder::GetTotalCallCount() const
+{
+	int total = 0;
+	for (int i = 0; i < CALL_COUNT; i++)
+	{
+		total += m_callCounts[i];
+	}
+	return(total);
+}
+
+/***********************************************************
+ *  GetCallBytes()
+ *
+ *  This method is used for getting the size of the recorded
+ *  calls with their arguments and memory.
+ ***********************************************************/
+size_t TraceRecorder::GetCallBytes() const
+{
+	return(m_calls.size());
+}
+
+/***********************************************************
+ *  GetResourceBytes()
+ *
+ *  This method is used for getting the size of the objects
+ *  saved at the start of the frame.
+ ***********************************************************/
+size_t TraceRecorder::GetResourceBytes() const
+{
+	return(m_resources.size());
+}
+
+/***********************************************************
+ *  ReportCounts()
+ *
+ *  This method is used for outputting the number of recorded
+ *  calls of each type that was called, most called first.
+ ***********************************************************/
+void TraceRecorder::ReportCounts() const
+{
+	bool bReported[CALL_COUNT] = { false };
+
+	std::cout << "INFO: Traced calls: " << GetTotalCallCount()
+		<< ", call bytes: " << GetCallBytes()
+		<< ", resource bytes: " << GetResourceBytes() << std::endl;
+	for (int i = 0; i < CALL_COUNT; i++)
+	{
+		int mostCalled = -1;
+		for (int c = 0; c < CALL_COUNT; c++)
+		{
+			if ((bReported[c] == false) && (m_callCounts[c] > 0) &&
+				((mostCalled < 0) || (m_callCounts[c] > m_callCounts[mostCalled])))
+			{
+				mostCalled = c;
+			}
+		}
+		if (mostCalled < 0)
+		{
+			break;
+		}
+		bReported[mostCalled] = true;
+		std::cout << "INFO:   " << CALL_TABLE[mostCalled].name << ": " << m_callCounts[mostCalled] << std::endl;
+	}
+}
+
+/***********************************************************
+ *  GetCallName()
+ *
+ *  This method is used for getting the OpenGL name of the
+ *  passed in call.
+ ***********************************************************/
+const char* TraceRecorder::GetCallName(CALL call)
+{
+	return(CALL_TABLE[call].name);
+}
+
+/***********************************************************
+ *  GetCallWordCount()
+ *
+ *  This method is used for getting the number of argument
+ *  words recorded for the passed in call.
+ ***********************************************************/
+int TraceRecorder::GetCallWordCount(CALL call)
+{
+	return(CALL_TABLE[call].wordCount);
+}
+
+/***********************************************************
+ *  CallHasData()
+ *
+ *  This method is used for checking whether the arguments of
+ *  the passed in call are followed by the memory it reads.
+ ***********************************************************/
+bool TraceRecorder::CallHasData(CALL call)
+{
+	return(CALL_TABLE[call].bHasData);
+}
@@ -0,0 +1,172 @@
+///////////////////////////////////////////////////////////////////////////////
+// tracerecorder.h
+// ============
+// record the OpenGL calls of a frame into a binary trace file
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <vector>
+
+/***********************************************************
+ *  TraceRecorder
+ *
+ *  This class contains the code for recording every OpenGL
+ *  call of a frame, whichever manager or utility makes it.
+ *  The OpenGL entry points are replaced by hooks that write
+ *  the call, its arguments and the memory it reads (buffer
+ *  contents, uniform values, names and pixels) into a
+ *  compact stream, then make the call.  When the recording
+ *  starts, every buffer, texture, renderbuffer, program,
+ *  vertex array and framebuffer is saved with the bound
+ *  state, so the TracePlayer can replay the frame later
+ *  without the rest of the application.
+ *
+ *  The entry points loaded by GLEW are hooked by replacing
+ *  GLEW's function pointers.  The OpenGL 1.1 entry points
+ *  (draws, state and textures) are linked directly, so they
+ *  are hooked in the import table of the executable, which
+ *  is only available on Windows.
+ ***********************************************************/
+class TraceRecorder
+{
+public:
+	// recorded OpenGL calls
+	enum CALL
+	{
+		CALL_ENABLE,
+		CALL_DISABLE,
+		CALL_BLEND_FUNC,
+		CALL_BLEND_FUNCI,
+		CALL_DEPTH_MASK,
+		CALL_DEPTH_FUNC,
+		CALL_CULL_FACE,
+		CALL_COLOR_MASK,
+		CALL_POLYGON_OFFSET,
+		CALL_VIEWPORT,
+		CALL_CLEAR_COLOR,
+		CALL_CLEAR,
+		CALL_CLEAR_BUFFERFV,
+		CALL_ACTIVE_TEXTURE,
+		CALL_BIND_TEXTURE,
+		CALL_TEX_PARAMETERI,
+		CALL_TEX_IMAGE_2D,
+		CALL_GENERATE_MIPMAP,
+		CALL_USE_PROGRAM,
+		CALL_GET_UNIFORM_LOCATION,
+		CALL_UNIFORM_1I,
+		CALL_UNIFORM_1F,
+		CALL_UNIFORM_2F,
+		CALL_UNIFORM_3F,
+		CALL_UNIFORM_4F,
+		CALL_UNIFORM_2FV,
+		CALL_UNIFORM_3FV,
+		CALL_UNIFORM_4FV,
+		CALL_UNIFORM_4IV,
+		CALL_UNIFORM_MATRIX_3FV,
+		CALL_UNIFORM_MATRIX_4FV,
+		CALL_BIND_VERTEX_ARRAY,
+		CALL_BIND_BUFFER,
+		CALL_BIND_BUFFER_BASE,
+		CALL_BIND_BUFFER_RANGE,
+		CALL_BUFFER_DATA,
+		CALL_BUFFER_SUB_DATA,
+		CALL_BIND_FRAMEBUFFER,
+		CALL_DRAW_BUFFER,
+		CALL_DRAW_BUFFERS,
+		CALL_READ_BUFFER,
+		CALL_BLIT_FRAMEBUFFER,
+		CALL_DRAW_ARRAYS,
+		CALL_DRAW_ARRAYS_INSTANCED,
+		CALL_DRAW_ELEMENTS,
+		CALL_DRAW_ELEMENTS_INSTANCED,
+		CALL_DISPATCH_COMPUTE,
+		CALL_MEMORY_BARRIER,
+		CALL_COUNT
+	};
+
+	// objects saved when the recording starts
+	enum RESOURCE
+	{
+		RESOURCE_BUFFER,
+		RESOURCE_TEXTURE,
+		RESOURCE_RENDERBUFFER,
+		RESOURCE_PROGRAM,
+		RESOURCE_VERTEX_ARRAY,
+		RESOURCE_FRAMEBUFFER,
+		RESOURCE_COUNT
+	};
+
+	// first words of every trace file
+	static const unsigned int TRACE_MAGIC = 0x52544C47;
+	static const unsigned int TRACE_VERSION = 1;
+	// vertex attributes and bindings saved for each vertex array
+	static const int TRACE_VERTEX_ATTRIBUTES = 16;
+	// framebuffer color attachments and indexed buffer bindings saved
+	static const int TRACE_COLOR_ATTACHMENTS = 8;
+	static const int TRACE_BUFFER_BINDINGS = 8;
+	// largest uniform saved, a 4x4 matrix
+	static const int TRACE_UNIFORM_WORDS = 16;
+
+	// constructor
+	TraceRecorder();
+	// destructor
+	~TraceRecorder();
+
+private:
+	// size of the window the frame is drawn into
+	int m_windowWidth;
+	int m_windowHeight;
+	// saved objects and bound state at the start of the frame
+	std::vector<unsigned char> m_resources;
+	std::vector<unsigned char> m_state;
+	// recorded calls of the frame and their numbers by type
+	std::vector<unsigned char> m_calls;
+	int m_callCounts[CALL_COUNT];
+
+	// save every object of the passed in type
+	void CaptureObjects(RESOURCE resource);
+	// save one object of each type
+	void CaptureBuffer(GLuint buffer);
+	void CaptureTexture(GLuint texture);
+	void CaptureRenderbuffer(GLuint renderbuffer);
+	void CaptureProgram(GLuint program);
+	void CaptureVertexArray(GLuint vertexArray);
+	void CaptureFramebuffer(GLuint framebuffer);
+	// save the bound objects and the fixed function state
+	void CaptureState();
+
+public:
+	// replace the OpenGL entry points with the recording hooks
+	static bool InstallHooks();
+
+	// save the objects and state, then record the following calls
+	void BeginFrame(int windowWidth, int windowHeight);
+	// stop recording
+	void EndFrame();
+	// check whether the calls are being recorded
+	bool IsRecording() const;
+	// write the recorded frame into a trace file
+	bool Save(const char* filename) const;
+
+	// get the number of recorded calls of a type and in total
+	int GetCallCount(CALL call) const;
+	int GetTotalCallCount() const;
+	// get the size of the recorded calls and the saved objects
+	size_t GetCallBytes() const;
+	size_t GetResourceBytes() const;
+	// output the recorded calls by type
+	void ReportCounts() const;
+
+	// get the OpenGL name, argument words and whether the call
+	// is followed by the memory it reads
+	static const char* GetCallName(CALL call);
+	static int GetCallWordCount(CALL call);
+	static bool CallHasData(CALL call);
+};
@@ -0,0 +1,483 @@
+///////////////////////////////////////////////////////////////////////////////
+// transparencymanager.cpp
+// ============
+// manage the translucent objects - sorted and weighted blended transparency
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TransparencyManager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+// declare the global variables
+namespace
+{
+	const std::string g_AccumulationName = "accumulationTexture";
+	const std::string g_RevealageName = "revealageTexture";
+	const char* g_WeightedBlendName = "bWeightedBlend";
+}
+
+/***********************************************************
+ *  TransparencyManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TransparencyManager::TransparencyManager()
+{
+	m_sceneFramebuffer = 0;
+	m_sceneColorTexture = 0;
+	m_depthTexture = 0;
+	m_weightedFramebuffer = 0;
+	m_accumulationTexture = 0;
+	m_revealageTexture = 0;
+	m_width = 0;
+	m_height = 0;
+	m_pCompositeShader = NULL;
+	m_pInstanceShader = NULL;
+	m_fullscreenVAO = 0;
+	m_instanceVAO = 0;
+	m_boxVBO = 0;
+	m_boxIBO = 0;
+	m_instanceVBO = 0;
+	m_boxIndexCount = 0;
+	m_bInstancesSorted = false;
+	m_lastSortMilliseconds = 0.0;
+}
+
+/***********************************************************
+ *  ~TransparencyManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+TransparencyManager::~TransparencyManager()
+{
+	DestroyTargets();
+
+	if (NULL != m_pCompositeShader)
+	{
+		delete m_pCompositeShader;
+		m_pCompositeShader = NULL;
+	}
+	if (NULL != m_pInstanceShader)
+	{
+		delete m_pInstanceShader;
+		m_pInstanceShader = NULL;
+	}
+}
+
+/***********************************************************
+ *  CreateTargets()
+ *
+ *  This method is used for creating the offscreen target of
+ *  the opaque scene and the weighted blend targets, which
+ *  share its depth texture so that the translucent objects
+ *  are hidden behind the opaque ones.
+ ***********************************************************/
+bool TransparencyManager::CreateTargets(int width, int height)
+{
+	m_width = width;
+	m_height = height;
+
+	// the textures are created on the first of the units they
+	// are read from, so the scene textures stay bound
+	glActiveTexture(GL_TEXTURE0 + ACCUMULATION_TEXTURE_UNIT);
+
+	glGenTextures(1, &m_sceneColorTexture);
+	glBindTexture(GL_TEXTURE_2D, m_sceneColorTexture);
+	glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, width, height);
+
+	glGenTextures(1, &m_depthTexture);
+	glBindTexture(GL_TEXTURE_2D, m_depthTexture);
+	glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH_COMPONENT24, width, height);
+
+	glGenTextures(1, &m_accumulationTexture);
+	glBindTexture(GL_TEXTURE_2D, m_accumulationTexture);
+	glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA16F, width, height);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+	glGenTextures(1, &m_revealageTexture);
+	glBindTexture(GL_TEXTURE_2D, m_revealageTexture);
+	glTexStorage2D(GL_TEXTURE_2D, 1, GL_R8, width, height);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glActiveTexture(GL_TEXTURE0);
+
+	glGenFramebuffers(1, &m_sceneFramebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_sceneFramebuffer);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_sceneColorTexture, 0);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_depthTexture, 0);
+	GLenum sceneStatus = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+
+	glGenFramebuffers(1, &m_weightedFramebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_weightedFramebuffer);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_accumulationTexture, 0);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, m_revealageTexture, 0);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_depthTexture, 0);
+	GLenum drawBuffers[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+	glDrawBuffers(2, drawBuffers);
+	GLenum weightedStatus = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	if ((sceneStatus != GL_FRAMEBUFFER_COMPLETE) || (weightedStatus != GL_FRAMEBUFFER_COMPLETE))
+	{
+		std::cout << "Transparency framebuffers are not complete, status:"
+			<< sceneStatus << ", " << weightedStatus << std::endl;
+		return false;
+	}
+
+	// core profile needs a vertex array bound even when no
+	// vertex attributes are read
+	glGenVertexArrays(1, &m_fullscreenVAO);
+
+	return true;
+}
+
+/***********************************************************
+ *  DestroyTargets()
+ *
+ *  This method is used for freeing the offscreen targets and
+ *  the instanced batch.
+ ***********************************************************/
+void TransparencyManager::DestroyTargets()
+{
+	GLuint textures[4] = { m_sceneColorTexture, m_depthTexture, m_accumulationTexture, m_revealageTexture };
+
+	if (m_sceneFramebuffer != 0)
+	{
+		glDeleteTextures(4, textures);
+		glDeleteFramebuffers(1, &m_sceneFramebuffer);
+		glDeleteFramebuffers(1, &m_weightedFramebuffer);
+		m_sceneFramebuffer = 0;
+		m_weightedFramebuffer = 0;
+		m_sceneColorTexture = 0;
+		m_depthTexture = 0;
+		m_accumulationTexture = 0;
+		m_revealageTexture = 0;
+	}
+	if (m_instanceVAO != 0)
+	{
+		glDeleteVertexArrays(1, &m_instanceVAO);
+		glDeleteBuffers(1, &m_boxVBO);
+		glDeleteBuffers(1, &m_boxIBO);
+		glDeleteBuffers(1, &m_instanceVBO);
+		m_instanceVAO = 0;
+		m_boxVBO = 0;
+		m_boxIBO = 0;
+		m_instanceVBO = 0;
+	}
+	if (m_fullscreenVAO != 0)
+	{
+		glDeleteVertexArrays(1, &m_fullscreenVAO);
+		m_fullscreenVAO = 0;
+	}
+}
+
+/***********************************************************
+ *  LoadShaders()
+ *
+ *  This method is used for loading the shader that blends
+ *  the weighted targets over the opaque scene and the shader
+ *  that draws the instanced boxes.
+ ***********************************************************/
+void TransparencyManager::LoadShaders()
+{
+	m_pCompositeShader = new ShaderManager();
+	m_pCompositeShader->LoadShaders(
+		"shaders/fullscreenVertexShader.glsl",
+		"shaders/weightedCompositeFragmentShader.glsl");
+	m_pCompositeShader->use();
+	m_pCompositeShader->setSampler2DValue(g_AccumulationName, ACCUMULATION_TEXTURE_UNIT);
+	m_pCompositeShader->setSampler2DValue(g_RevealageName, REVEALAGE_TEXTURE_UNIT);
+
+	m_pInstanceShader = new ShaderManager();
+	m_pInstanceShader->LoadShaders(
+		"shaders/transparentInstanceVertexShader.glsl",
+		"shaders/transparentInstanceFragmentShader.glsl");
+}
+
+/***********************************************************
+ *  CreateBoxMesh()
+ *
+ *  This method is used for creating the box that is drawn
+ *  for each instance, with its own normal on every face.
+ ***********************************************************/
+void TransparencyManager::CreateBoxMesh()
+{
+	std::vector<glm::vec3> vertices;
+	std::vector<GLushort> indices;
+
+	// four corners for each of the six faces
+	for (int face = 0; face < 6; face++)
+	{
+		int axis = face / 2;
+		float side = ((face % 2) == 0) ? 1.0f : -1.0f;
+		glm::vec3 normal = glm::vec3(0.0f);
+		glm::vec3 tangent = glm::vec3(0.0f);
+		glm::vec3 bitangent = glm::vec3(0.0f);
+
+		normal[axis] = side;
+		tangent[(axis + 1) % 3] = 1.0f;
+		bitangent[(axis + 2) % 3] = side;
+
+		GLushort first = (GLushort)(vertices.size() / 2);
+		glm::vec3 corners[4] = {
+			normal - tangent - bitangent, normal + tangent - bitangent,
+			normal + tangent + bitangent, normal - tangent + bitangent };
+		for (int c = 0; c < 4; c++)
+		{
+			vertices.push_back(corners[c]);
+			vertices.push_back(normal);
+		}
+		GLushort faceIndices[6] = {
+			first, (GLushort)(first + 1), (GLushort)(first + 2),
+			first, (GLushort)(first + 2), (GLushort)(first + 3) };
+		indices.insert(indices.end(), faceIndices, faceIndices + 6);
+	}
+
+	glGenVertexArrays(1, &m_instanceVAO);
+	glBindVertexArray(m_instanceVAO);
+
+	glGenBuffers(1, &m_boxVBO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_boxVBO);
+	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec3), vertices.data(), GL_STATIC_DRAW);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 2 * sizeof(glm::vec3), (void*)0);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 2 * sizeof(glm::vec3), (void*)sizeof(glm::vec3));
+	glEnableVertexAttribArray(1);
+
+	glGenBuffers(1, &m_boxIBO);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_boxIBO);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLushort), indices.data(), GL_STATIC_DRAW);
+	m_boxIndexCount = (GLsizei)indices.size();
+
+	// one position and color for each drawn box
+	glGenBuffers(1, &m_instanceVBO);
+	glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+	glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(TRANSPARENT_INSTANCE), (void*)0);
+	glEnableVertexAttribArray(2);
+	glVertexAttribDivisor(2, 1);
+	glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(TRANSPARENT_INSTANCE), (void*)sizeof(glm::vec4));
+	glEnableVertexAttribArray(3);
+	glVertexAttribDivisor(3, 1);
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/***********************************************************
+ *  CreateInstances()
+ *
+ *  This method is used for filling the scene volume with
+ *  small translucent boxes of random sizes and colors.  The
+ *  boxes are uploaded in the order they were placed, which
+ *  is all the weighted blending needs.
+ ***********************************************************/
+void TransparencyManager::CreateInstances(int instanceCount)
+{
+	if (m_instanceVAO == 0)
+	{
+		CreateBoxMesh();
+	}
+
+	// fixed seed so every run uses the same boxes
+	std::mt19937 generator(330);
+	std::uniform_real_distribution<float> positionX(-18.0f, 18.0f);
+	std::uniform_real_distribution<float> positionY(0.25f, 10.0f);
+	std::uniform_real_distribution<float> positionZ(-9.5f, 8.0f);
+	std::uniform_real_distribution<float> size(0.1f, 0.4f);
+	std::uniform_real_distribution<float> opacity(0.15f, 0.5f);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+	m_instances.resize(instanceCount);
+	for (int i = 0; i < instanceCount; i++)
+	{
+		m_instances[i].positionScale = glm::vec4(
+			positionX(generator), positionY(generator), positionZ(generator), size(generator));
+		m_instances[i].color = glm::vec4(
+			unit(generator), unit(generator), unit(generator), opacity(generator));
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+	glBufferData(GL_ARRAY_BUFFER, m_instances.size() * sizeof(TRANSPARENT_INSTANCE), m_instances.data(), GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	m_bInstancesSorted = false;
+}
+
+/***********************************************************
+ *  GetInstanceCount()
+ *
+ *  This method is used for getting the number of instanced
+ *  translucent boxes.
+ ***********************************************************/
+int TransparencyManager::GetInstanceCount() const
+{
+	return((int)m_instances.size());
+}
+
+/***********************************************************
+ *  GetLastSortMilliseconds()
+ *
+ *  This method is used for getting the milliseconds that the
+ *  last back to front sort of the boxes took on the CPU.
+ ***********************************************************/
+double TransparencyManager::GetLastSortMilliseconds() const
+{
+	return(m_lastSortMilliseconds);
+}
+
+/***********************************************************
+ *  BeginOpaquePass()
+ *
+ *  This method is used for drawing the opaque scene into the
+ *  offscreen target, so that the weighted blend targets can
+ *  be tested against its depth.
+ ***********************************************************/
+void TransparencyManager::BeginOpaquePass()
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, m_sceneFramebuffer);
+	glViewport(0, 0, m_width, m_height);
+}
+
+/***********************************************************
+ *  BeginTransparentPass()
+ *
+ *  This method is used for setting up the blending of the
+ *  translucent objects.  Neither method writes the depth, so
+ *  the translucent surfaces never hide each other.  Sorted
+ *  blending draws over the window, and weighted blending
+ *  adds every surface into the accumulation target and takes
+ *  its coverage away from the revealage target.
+ ***********************************************************/
+void TransparencyManager::BeginTransparentPass(TRANSPARENCY_MODE mode)
+{
+	glEnable(GL_DEPTH_TEST);
+	glDepthMask(GL_FALSE);
+	glEnable(GL_BLEND);
+
+	if (mode == TRANSPARENCY_WEIGHTED)
+	{
+		const GLfloat noAccumulation[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		const GLfloat fullRevealage[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+		glBindFramebuffer(GL_FRAMEBUFFER, m_weightedFramebuffer);
+		glClearBufferfv(GL_COLOR, 0, noAccumulation);
+		glClearBufferfv(GL_COLOR, 1, fullRevealage);
+		glBlendFunci(0, GL_ONE, GL_ONE);
+		glBlendFunci(1, GL_ZERO, GL_ONE_MINUS_SRC_COLOR);
+	}
+	else
+	{
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	}
+}
+
+/***********************************************************
+ *  RenderInstances()
+ *
+ *  This method is used for drawing all of the instanced
+ *  boxes with one draw call.  Sorted blending first orders
+ *  the boxes from back to front for the passed in view and
+ *  uploads them again, weighted blending draws them in the
+ *  order they were placed.
+ ***********************************************************/
+void TransparencyManager::RenderInstances(
+	TRANSPARENCY_MODE mode,
+	const glm::mat4& view,
+	const glm::mat4& projection)
+{
+	if (m_instances.empty() == true)
+	{
+		return;
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+	if (mode == TRANSPARENCY_SORTED)
+	{
+		std::chrono::steady_clock::time_point sortStart = std::chrono::steady_clock::now();
+
+		// the farthest boxes have the most negative view depth
+		m_sortKeys.resize(m_instances.size());
+		for (size_t i = 0; i < m_instances.size(); i++)
+		{
+			glm::vec4 position = glm::vec4(glm::vec3(m_instances[i].positionScale), 1.0f);
+			m_sortKeys[i] = std::make_pair((view * position).z, (int)i);
+		}
+		std::sort(m_sortKeys.begin(), m_sortKeys.end());
+
+		m_sortedInstances.resize(m_instances.size());
+		for (size_t i = 0; i < m_sortKeys.size(); i++)
+		{
+			m_sortedInstances[i] = m_instances[m_sortKeys[i].second];
+		}
+		m_lastSortMilliseconds = std::chrono::duration<double, std::milli>(
+			std::chrono::steady_clock::now() - sortStart).count();
+
+		glBufferSubData(GL_ARRAY_BUFFER, 0, m_sortedInstances.size() * sizeof(TRANSPARENT_INSTANCE), m_sortedInstances.data());
+		m_bInstancesSorted = true;
+	}
+	else if (m_bInstancesSorted == true)
+	{
+		// any order works, but go back to the placed order so the
+		// weighted blending never pays for an upload each frame
+		glBufferSubData(GL_ARRAY_BUFFER, 0, m_instances.size() * sizeof(TRANSPARENT_INSTANCE), m_instances.data());
+		m_bInstancesSorted = false;
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	m_pInstanceShader->use();
+	m_pInstanceShader->setMat4Value("view", view);
+	m_pInstanceShader->setMat4Value("projection", projection);
+	m_pInstanceShader->setBoolValue(g_WeightedBlendName, mode == TRANSPARENCY_WEIGHTED);
+
+	glBindVertexArray(m_instanceVAO);
+	glDrawElementsInstanced(GL_TRIANGLES, m_boxIndexCount, GL_UNSIGNED_SHORT, NULL, (GLsizei)m_instances.size());
+	glBindVertexArray(0);
+}
+
+/***********************************************************
+ *  EndTransparentPass()
+ *
+ *  This method is used for finishing the translucent
+ *  objects.  Weighted blending blends the average color of
+ *  the translucent surfaces over the opaque scene, then
+ *  copies the scene into the window.  The state the scene
+ *  rendering expects is restored for both methods.
+ ***********************************************************/
+void TransparencyManager::EndTransparentPass(TRANSPARENCY_MODE mode)
+{
+	if (mode == TRANSPARENCY_WEIGHTED)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, m_sceneFramebuffer);
+		glDisable(GL_DEPTH_TEST);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+		glActiveTexture(GL_TEXTURE0 + ACCUMULATION_TEXTURE_UNIT);
+		glBindTexture(GL_TEXTURE_2D, m_accumulationTexture);
+		glActiveTexture(GL_TEXTURE0 + REVEALAGE_TEXTURE_UNIT);
+		glBindTexture(GL_TEXTURE_2D, m_revealageTexture);
+		glActiveTexture(GL_TEXTURE0);
+
+		m_pCompositeShader->use();
+		glBindVertexArray(m_fullscreenVAO);
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+		glBindVertexArray(0);
+
+		// copy the finished scene into the window
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, m_sceneFramebuffer);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+		glBlitFramebuffer(0, 0, m_width, m_height, 0, 0, m_width, m_height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	}
+
+	// restore the state the forward scene rendering expects
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glDepthMask(GL_TRUE);
+	glEnable(GL_DEPTH_TEST);
+}
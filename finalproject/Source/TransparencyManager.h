@@ -0,0 +1,124 @@
+///////////////////////////////////////////////////////////////////////////////
+// transparencymanager.h
+// ============
+// manage the translucent objects - sorted and weighted blended transparency
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+
+#include <vector>
+
+/***********************************************************
+ *  TransparencyManager
+ *
+ *  This class contains the code for drawing the translucent
+ *  objects after the opaque ones.  With sorted blending the
+ *  translucent surfaces are blended over the window from
+ *  back to front, which needs them sorted every frame and is
+ *  still wrong where they cross.  With weighted blended
+ *  order-independent transparency the opaque scene is drawn
+ *  into an offscreen target, and the translucent surfaces
+ *  are added in any order into two targets:
+ *
+ *    accumulation RGBA16F  color and coverage times a weight
+ *    revealage    R8       how much of the background shows
+ *
+ *  before a full screen pass blends their average color over
+ *  the opaque scene and copies it into the window.  A batch
+ *  of instanced translucent boxes can be added to measure
+ *  the cost of both methods.
+ ***********************************************************/
+class TransparencyManager
+{
+public:
+	// constructor
+	TransparencyManager();
+	// destructor
+	~TransparencyManager();
+
+	// texture units used for reading the weighted blend targets
+	static const int ACCUMULATION_TEXTURE_UNIT = 28;
+	static const int REVEALAGE_TEXTURE_UNIT = 29;
+
+	// ways of blending the translucent objects
+	enum TRANSPARENCY_MODE
+	{
+		TRANSPARENCY_SORTED,
+		TRANSPARENCY_WEIGHTED
+	};
+
+	// translucent box of the instanced batch
+	struct TRANSPARENT_INSTANCE
+	{
+		glm::vec4 positionScale;   // xyz = world position, w = half size
+		glm::vec4 color;           // rgb = color, a = opacity
+	};
+
+private:
+	// offscreen target that the opaque scene is drawn into
+	GLuint m_sceneFramebuffer;
+	GLuint m_sceneColorTexture;
+	GLuint m_depthTexture;
+	// weighted blend targets, tested against the opaque depth
+	GLuint m_weightedFramebuffer;
+	GLuint m_accumulationTexture;
+	GLuint m_revealageTexture;
+	int m_width;
+	int m_height;
+	// shader that blends the weighted targets over the opaque scene
+	ShaderManager* m_pCompositeShader;
+	// shader that draws the instanced boxes
+	ShaderManager* m_pInstanceShader;
+	// empty vertex array used for the full screen triangle
+	GLuint m_fullscreenVAO;
+	// box mesh and per instance buffer of the instanced batch
+	GLuint m_instanceVAO;
+	GLuint m_boxVBO;
+	GLuint m_boxIBO;
+	GLuint m_instanceVBO;
+	GLsizei m_boxIndexCount;
+	// instances in the order they were placed, and sorted from
+	// back to front for the current view
+	std::vector<TRANSPARENT_INSTANCE> m_instances;
+	std::vector<TRANSPARENT_INSTANCE> m_sortedInstances;
+	std::vector<std::pair<float, int> > m_sortKeys;
+	// true when the instance buffer holds the sorted instances
+	bool m_bInstancesSorted;
+	// milliseconds the last sort of the instances took
+	double m_lastSortMilliseconds;
+
+	// create the box mesh of the instanced batch
+	void CreateBoxMesh();
+
+public:
+	// create the offscreen targets
+	bool CreateTargets(int width, int height);
+	// free the offscreen targets and the instanced batch
+	void DestroyTargets();
+	// load the composite and instance shaders
+	void LoadShaders();
+
+	// place randomly sized and colored translucent boxes in the scene
+	void CreateInstances(int instanceCount);
+	// get the number of instanced boxes
+	int GetInstanceCount() const;
+	// get the milliseconds the last sort of the boxes took
+	double GetLastSortMilliseconds() const;
+
+	// draw the opaque scene into the offscreen target
+	void BeginOpaquePass();
+	// set up the blending of the translucent objects
+	void BeginTransparentPass(TRANSPARENCY_MODE mode);
+	// draw the instanced boxes for the passed in view
+	void RenderInstances(
+		TRANSPARENCY_MODE mode,
+		const glm::mat4& view,
+		const glm::mat4& projection);
+	// blend the translucent objects over the opaque scene in the window
+	void EndTransparentPass(TRANSPARENCY_MODE mode);
+};
@@ -1,227 +1,431 @@
-///////////////////////////////////////////////////////////////////////////////
-// viewmanager.cpp
-// ============
-// manage the viewing of 3D objects within the viewport - camera, projection
-//
-//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
-//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
-///////////////////////////////////////////////////////////////////////////////
-
-#include "ViewManager.h"
-
-// GLM Math Header inclusions
-#include <glm/glm.hpp>
-#include <glm/gtx/transform.hpp>
-#include <glm/gtc/type_ptr.hpp>    
-
-// declaration of the global variables and defines
-namespace
-{
-	// Variables for window width and height
-	const int WINDOW_WIDTH = 1000;
-	const int WINDOW_HEIGHT = 800;
-	const char* g_ViewName = "view";
-	const char* g_ProjectionName = "projection";
-
-	// camera object used for viewing and interacting with
-	// the 3D scene
-	Camera* g_pCamera = nullptr;
-
-	// these variables are used for mouse movement processing
-	float gLastX = WINDOW_WIDTH / 2.0f;
-	float gLastY = WINDOW_HEIGHT / 2.0f;
-	bool gFirstMouse = true;
-
-	// time between current frame and last frame
-	float gDeltaTime = 0.0f; 
-	float gLastFrame = 0.0f;
-
-	// the following variable is false when orthographic projection
-	// is off and true when it is on
-	bool bOrthographicProjection = false;
-}
-
-/***********************************************************
- *  ViewManager()
- *
- *  The constructor for the class
- ***********************************************************/
-ViewManager::ViewManager(
-	ShaderManager *pShaderManager)
-{
-	// initialize the member variables
-	m_pShaderManager = pShaderManager;
-	m_pWindow = NULL;
-	g_pCamera = new Camera();
-	// default camera view parameters
-	g_pCamera->Position = glm::vec3(0.0f, 2.0f, 12.0f);
-	g_pCamera->Front = glm::vec3(0.0f, 0.5f, -3.0f);
-	g_pCamera->Up = glm::vec3(0.0f, 1.0f, 0.0f);
-	g_pCamera->Zoom = 80;
-	g_pCamera->MovementSpeed = 20;
-}
-
-/***********************************************************
- *  ~ViewManager()
- *
- *  The destructor for the class
- ***********************************************************/
-ViewManager::~ViewManager()
-{
-	// free up allocated memory
-	m_pShaderManager = NULL;
-	m_pWindow = NULL;
-	if (NULL != g_pCamera)
-	{
-		delete g_pCamera;
-		g_pCamera = NULL;
-	}
-}
-
-/***********************************************************
- *  CreateDisplayWindow()
- *
- *  This method is used to create the main display window.
- ***********************************************************/
-GLFWwindow* ViewManager::CreateDisplayWindow(const char* windowTitle)
-{
-	GLFWwindow* window = nullptr;
-
-	// try to create the displayed OpenGL window
-	window = glfwCreateWindow(
-		WINDOW_WIDTH,
-		WINDOW_HEIGHT,
-		windowTitle,
-		NULL, NULL);
-	if (window == NULL)
-	{
-		std::cout << "Failed to create GLFW window" << std::endl;
-		glfwTerminate();
-		return NULL;
-	}
-	glfwMakeContextCurrent(window);
-
-	// this callback is used to receive mouse moving events
-	glfwSetCursorPosCallback(window, &ViewManager::Mouse_Position_Callback);
-
-	// tell GLFW to capture all mouse events
-	glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-
-	// enable blending for supporting tranparent rendering
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-	m_pWindow = window;
-
-	return(window);
-}
-
-/***********************************************************
- *  Mouse_Position_Callback()
- *
- *  This method is automatically called from GLFW whenever
- *  the mouse is moved within the active GLFW display window.
- ***********************************************************/
-void ViewManager::Mouse_Position_Callback(GLFWwindow* window, double xMousePos, double yMousePos)
-{
-	// when the first mouse move event is received, this needs to be recorded so that
-	// all subsequent mouse moves can correctly calculate the X position offset and Y
-	// position offset for proper operation
-	if (gFirstMouse)
-	{
-		gLastX = xMousePos;
-		gLastY = yMousePos;
-		gFirstMouse = false;
-	}
-
-	// calculate the X offset and Y offset values for moving the 3D camera accordingly
-	float xOffset = xMousePos - gLastX;
-	float yOffset = gLastY - yMousePos; // reversed since y-coordinates go from bottom to top
-
-	// set the current positions into the last position variables
-	gLastX = xMousePos;
-	gLastY = yMousePos;
-
-	// move the 3D camera according to the calculated offsets
-	g_pCamera->ProcessMouseMovement(xOffset, yOffset);
-}
-
-/***********************************************************
- *  ProcessKeyboardEvents()
- *
- *  This method is called to process any keyboard events
- *  that may be waiting in the event queue.
- ***********************************************************/
-void ViewManager::ProcessKeyboardEvents()
-{
-	// close the window if the escape key has been pressed
-	if (glfwGetKey(m_pWindow, GLFW_KEY_ESCAPE) == GLFW_PRESS)
-	{
-		glfwSetWindowShouldClose(m_pWindow, true);
-	}
-
-	// if the camera object is null, then exit this method
-	if (NULL == g_pCamera)
-	{
-		return;
-	}
-
-	// process camera zooming in and out
-	if (glfwGetKey(m_pWindow, GLFW_KEY_W) == GLFW_PRESS)
-	{
-		g_pCamera->ProcessKeyboard(FORWARD, gDeltaTime);
-	}
-	if (glfwGetKey(m_pWindow, GLFW_KEY_S) == GLFW_PRESS)
-	{
-		g_pCamera->ProcessKeyboard(BACKWARD, gDeltaTime);
-	}
-
-	// process camera panning left and right
-	if (glfwGetKey(m_pWindow, GLFW_KEY_A) == GLFW_PRESS)
-	{
-		g_pCamera->ProcessKeyboard(LEFT, gDeltaTime);
-	}
-	if (glfwGetKey(m_pWindow, GLFW_KEY_D) == GLFW_PRESS)
-	{
-		g_pCamera->ProcessKeyboard(RIGHT, gDeltaTime);
-	}
-}
-
-/***********************************************************
- *  PrepareSceneView()
- *
- *  This method is used for preparing the 3D scene by loading
- *  the shapes, textures in memory to support the 3D scene 
- *  rendering
- ***********************************************************/
-void ViewManager::PrepareSceneView()
-{
-	glm::mat4 view;
-	glm::mat4 projection;
-
-	// per-frame timing
-	float currentFrame = glfwGetTime();
-	gDeltaTime = currentFrame - gLastFrame;
-	gLastFrame = currentFrame;
-
-	// process any keyboard events that may be waiting in the 
-	// event queue
-	ProcessKeyboardEvents();
-
-	// get the current view matrix from the camera
-	view = g_pCamera->GetViewMatrix();
-
-	// define the current projection matrix
-	projection = glm::perspective(glm::radians(g_pCamera->Zoom), (GLfloat)WINDOW_WIDTH / (GLfloat)WINDOW_HEIGHT, 0.1f, 100.0f);
-
-	// if the shader manager object is valid
-	if (NULL != m_pShaderManager)
-	{
-		// set the view matrix into the shader for proper rendering
-		m_pShaderManager->setMat4Value(g_ViewName, view);
-		// set the view matrix into the shader for proper rendering
-		m_pShaderManager->setMat4Value(g_ProjectionName, projection);
-		// set the view position of the camera into the shader for proper rendering
-		m_pShaderManager->setVec3Value("viewPosition", g_pCamera->Position);
-	}
+///////////////////////////////////////////////////////////////////////////////
+// viewmanager.cpp
+// ============
+// manage the viewing of 3D objects within the viewport - camera, projection
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ViewManager.h"
+#include "AllocationTracker.h"
+
+// GLM Math Header inclusions
+#include <glm/glm.hpp>
+#include <glm/gtx/transform.hpp>
+#include <glm/gtc/type_ptr.hpp>    
+
+// declaration of the global variables and defines
+namespace
+{
+	// Variables for window width and height
+	const int WINDOW_WIDTH = 1000;
+	const int WINDOW_HEIGHT = 800;
+	// depth range of the perspective view frustum
+	const float NEAR_PLANE = 0.1f;
+	const float FAR_PLANE = 100.0f;
+	const char* g_ViewName = "view";
+	const char* g_ProjectionName = "projection";
+
+	// camera object used for viewing and interacting with
+	// the 3D scene
+	Camera* g_pCamera = nullptr;
+
+	// these variables are used for mouse movement processing
+	float gLastX = WINDOW_WIDTH / 2.0f;
+	float gLastY = WINDOW_HEIGHT / 2.0f;
+	bool gFirstMouse = true;
+
+	// time between current frame and last frame
+	float gDeltaTime = 0.0f; 
+	float gLastFrame = 0.0f;
+
+	// the following variable is false when orthographic projection
+	// is off and true when it is on
+	bool bOrthographicProjection = false;
+}
+
+/***********************************************************
+ *  ViewManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ViewManager::ViewManager(
+	ShaderManager *pShaderManager)
+{
+	// initialize the member variables
+	m_pShaderManager = pShaderManager;
+	m_pWindow = NULL;
+	m_viewMatrix = glm::mat4(1.0f);
+	m_projectionMatrix = glm::mat4(1.0f);
+	m_viewProjection = glm::mat4(1.0f);
+	m_previousViewProjection = glm::mat4(1.0f);
+	m_bHasViewProjection = false;
+	m_projectionJitter = glm::vec2(0.0f);
+	m_bUseCameraState = false;
+	m_viewPosition = glm::vec3(0.0f);
+	g_pCamera = new Camera();
+	// default camera view parameters
+	g_pCamera->Position = glm::vec3(0.0f, 2.0f, 12.0f);
+	g_pCamera->Front = glm::vec3(0.0f, 0.5f, -3.0f);
+	g_pCamera->Up = glm::vec3(0.0f, 1.0f, 0.0f);
+	g_pCamera->Zoom = 80;
+	g_pCamera->MovementSpeed = 20;
+}
+
+/***********************************************************
+ *  ~ViewManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ViewManager::~ViewManager()
+{
+	// free up allocated memory
+	m_pShaderManager = NULL;
+	m_pWindow = NULL;
+	if (NULL != g_pCamera)
+	{
+		delete g_pCamera;
+		g_pCamera = NULL;
+	}
+}
+
+/***********************************************************
+ *  CreateDisplayWindow()
+ *
+ *  This method is used to create the main display window.
+ ***********************************************************/
+GLFWwindow* ViewManager::CreateDisplayWindow(const char* windowTitle)
+{
+	GLFWwindow* window = nullptr;
+
+	// try to create the displayed OpenGL window
+	window = glfwCreateWindow(
+		WINDOW_WIDTH,
+		WINDOW_HEIGHT,
+		windowTitle,
+		NULL, NULL);
+#ifndef __APPLE__
+	// software drivers such as Mesa llvmpipe stop at OpenGL 4.5,
+	// which still provides the compute and storage buffer features
+	if (window == NULL)
+	{
+		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+		window = glfwCreateWindow(
+			WINDOW_WIDTH,
+			WINDOW_HEIGHT,
+			windowTitle,
+			NULL, NULL);
+	}
+#endif
+	if (window == NULL)
+	{
+		std::cout << "Failed to create GLFW window" << std::endl;
+		glfwTerminate();
+		return NULL;
+	}
+	glfwMakeContextCurrent(window);
+
+	// this callback is used to receive mouse moving events
+	glfwSetCursorPosCallback(window, &ViewManager::Mouse_Position_Callback);
+
+	// tell GLFW to capture all mouse events
+	glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+
+	// enable blending for supporting tranparent rendering
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	m_pWindow = window;
+
+	return(window);
+}
+
+/***********************************************************
+ *  Mouse_Position_Callback()
+ *
+ *  This method is automatically called from GLFW whenever
+ *  the mouse is moved within the active GLFW display window.
+ ***********************************************************/
+void ViewManager::Mouse_Position_Callback(GLFWwindow* window, double xMousePos, double yMousePos)
+{
+	// when the first mouse move event is received, this needs to be recorded so that
+	// all subsequent mouse moves can correctly calculate the X position offset and Y
+	// position offset for proper operation
+	if (gFirstMouse)
+	{
+		gLastX = xMousePos;
+		gLastY = yMousePos;
+		gFirstMouse = false;
+	}
+
+	// calculate the X offset and Y offset values for moving the 3D camera accordingly
+	float xOffset = xMousePos - gLastX;
+	float yOffset = gLastY - yMousePos; // reversed since y-coordinates go from bottom to top
+
+	// set the current positions into the last position variables
+	gLastX = xMousePos;
+	gLastY = yMousePos;
+
+	// move the 3D camera according to the calculated offsets
+	g_pCamera->ProcessMouseMovement(xOffset, yOffset);
+}
+
+/***********************************************************
+ *  ProcessKeyboardEvents()
+ *
+ *  This method is called to process any keyboard events
+ *  that may be waiting in the event queue.
+ ***********************************************************/
+void ViewManager::ProcessKeyboardEvents()
+{
+	// close the window if the escape key has been pressed
+	if (glfwGetKey(m_pWindow, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+	{
+		glfwSetWindowShouldClose(m_pWindow, true);
+	}
+
+	// if the camera object is null, then exit this method
+	if (NULL == g_pCamera)
+	{
+		return;
+	}
+
+	// process camera zooming in and out
+	if (glfwGetKey(m_pWindow, GLFW_KEY_W) == GLFW_PRESS)
+	{
+		g_pCamera->ProcessKeyboard(FORWARD, gDeltaTime);
+	}
+	if (glfwGetKey(m_pWindow, GLFW_KEY_S) == GLFW_PRESS)
+	{
+		g_pCamera->ProcessKeyboard(BACKWARD, gDeltaTime);
+	}
+
+	// process camera panning left and right
+	if (glfwGetKey(m_pWindow, GLFW_KEY_A) == GLFW_PRESS)
+	{
+		g_pCamera->ProcessKeyboard(LEFT, gDeltaTime);
+	}
+	if (glfwGetKey(m_pWindow, GLFW_KEY_D) == GLFW_PRESS)
+	{
+		g_pCamera->ProcessKeyboard(RIGHT, gDeltaTime);
+	}
+}
+
+/***********************************************************
+ *  UpdateCamera()
+ *
+ *  This method is used for moving the camera by the keyboard
+ *  input of the current frame.  The input can only be read
+ *  on the thread that created the window.
+ ***********************************************************/
+void ViewManager::UpdateCamera()
+{
+	// per-frame timing
+	float currentFrame = glfwGetTime();
+	gDeltaTime = currentFrame - gLastFrame;
+	gLastFrame = currentFrame;
+
+	// process any keyboard events that may be waiting in the 
+	// event queue
+	ProcessKeyboardEvents();
+}
+
+/***********************************************************
+ *  GetCameraState()
+ *
+ *  This method is used for getting the position, direction
+ *  and zoom of the camera, for drawing the frame later or
+ *  on another thread.
+ ***********************************************************/
+SnapshotBuffer::CAMERA_STATE ViewManager::GetCameraState() const
+{
+	SnapshotBuffer::CAMERA_STATE camera;
+	camera.position = g_pCamera->Position;
+	camera.front = g_pCamera->Front;
+	camera.up = g_pCamera->Up;
+	camera.zoom = g_pCamera->Zoom;
+	return(camera);
+}
+
+/***********************************************************
+ *  SetCameraState()
+ *
+ *  This method is used for drawing the following frames
+ *  from the passed in camera instead of reading the input,
+ *  when the camera is updated on another thread.
+ ***********************************************************/
+void ViewManager::SetCameraState(const SnapshotBuffer::CAMERA_STATE& camera)
+{
+	m_cameraState = camera;
+	m_bUseCameraState = true;
+}
+
+/***********************************************************
+ *  PrepareSceneView()
+ *
+ *  This method is used for preparing the 3D scene by loading
+ *  the shapes, textures in memory to support the 3D scene 
+ *  rendering
+ ***********************************************************/
+void ViewManager::PrepareSceneView()
+{
+	AllocationTracker::BeginScope("PrepareSceneView");
+
+	glm::mat4 view;
+	glm::mat4 projection;
+	float zoom = 0.0f;
+
+	if (m_bUseCameraState == true)
+	{
+		// the camera was moved when the snapshot was updated
+		view = glm::lookAt(m_cameraState.position, m_cameraState.position + m_cameraState.front, m_cameraState.up);
+		zoom = m_cameraState.zoom;
+		m_viewPosition = m_cameraState.position;
+	}
+	else
+	{
+		UpdateCamera();
+
+		// get the current view matrix from the camera
+		view = g_pCamera->GetViewMatrix();
+		zoom = g_pCamera->Zoom;
+		m_viewPosition = g_pCamera->Position;
+	}
+
+	// define the current projection matrix
+	projection = glm::perspective(glm::radians(zoom), (GLfloat)WINDOW_WIDTH / (GLfloat)WINDOW_HEIGHT, NEAR_PLANE, FAR_PLANE);
+
+	// keep the view projection of the last frame for reprojecting
+	// into it, which is calculated once per frame
+	m_previousViewProjection = m_viewProjection;
+	m_viewProjection = projection * view;
+	if (m_bHasViewProjection == false)
+	{
+		m_previousViewProjection = m_viewProjection;
+		m_bHasViewProjection = true;
+	}
+
+	// shift the projection by the jitter, converted from pixels
+	// to the -1 to 1 range of the window
+	projection[2][0] += (m_projectionJitter.x * 2.0f) / WINDOW_WIDTH;
+	projection[2][1] += (m_projectionJitter.y * 2.0f) / WINDOW_HEIGHT;
+
+	// keep the matrices for the passes that need the view frustum
+	m_viewMatrix = view;
+	m_projectionMatrix = projection;
+
+	// if the shader manager object is valid
+	if (NULL != m_pShaderManager)
+	{
+		SetViewUniforms(m_pShaderManager);
+	}
+
+	AllocationTracker::EndScope();
+}
+
+/***********************************************************
+ *  SetViewUniforms()
+ *
+ *  This method is used for passing the view values of the
+ *  current frame into a shader, for render passes that draw
+ *  the scene more than once per frame.
+ ***********************************************************/
+void ViewManager::SetViewUniforms(ShaderManager* pShaderManager)
+{
+	// set the view matrix into the shader for proper rendering
+	pShaderManager->setMat4Value(g_ViewName, m_viewMatrix);
+	// set the view matrix into the shader for proper rendering
+	pShaderManager->setMat4Value(g_ProjectionName, m_projectionMatrix);
+	// set the view position of the camera into the shader for proper rendering
+	pShaderManager->setVec3Value("viewPosition", m_viewPosition);
+}
+
+/***********************************************************
+ *  SetCameraPose()
+ *
+ *  This method is used for placing the camera at a position
+ *  looking toward a target, for following a scripted path.
+ *  The yaw and pitch are matched to the new direction, so
+ *  that moving the mouse afterwards continues from it.
+ ***********************************************************/
+void ViewManager::SetCameraPose(glm::vec3 position, glm::vec3 target)
+{
+	glm::vec3 front = glm::normalize(target - position);
+
+	g_pCamera->Position = position;
+	g_pCamera->Front = front;
+	g_pCamera->Right = glm::normalize(glm::cross(front, g_pCamera->WorldUp));
+	g_pCamera->Yaw = glm::degrees(atan2(front.z, front.x));
+	g_pCamera->Pitch = glm::degrees(asin(front.y));
+}
+
+/***********************************************************
+ *  SetProjectionJitter()
+ *
+ *  This method is used for offsetting the projection by a
+ *  fraction of a pixel, so that successive frames sample
+ *  different points inside each pixel for temporal
+ *  anti-aliasing.  The view projection kept for reprojection
+ *  is calculated without it.
+ ***********************************************************/
+void ViewManager::SetProjectionJitter(glm::vec2 pixelOffset)
+{
+	m_projectionJitter = pixelOffset;
+}
+
+/***********************************************************
+ *  SetShaderManager()
+ *
+ *  This method is used for changing the shader that the view
+ *  and projection values are passed into, for render passes
+ *  that use their own shaders.
+ ***********************************************************/
+void ViewManager::SetShaderManager(ShaderManager* pShaderManager)
+{
+	m_pShaderManager = pShaderManager;
+}
+
+/***********************************************************
+ *  GetNearPlane()
+ *
+ *  This method is used for getting the distance to the near
+ *  plane of the perspective view frustum.
+ ***********************************************************/
+float ViewManager::GetNearPlane() const
+{
+	return(NEAR_PLANE);
+}
+
+/***********************************************************
+ *  GetFarPlane()
+ *
+ *  This method is used for getting the distance to the far
+ *  plane of the perspective view frustum.
+ ***********************************************************/
+float ViewManager::GetFarPlane() const
+{
+	return(FAR_PLANE);
+}
+
+/***********************************************************
+ *  GetWindowWidth()
+ *
+ *  This method is used for getting the width of the display
+ *  window in pixels.
+ ***********************************************************/
+int ViewManager::GetWindowWidth() const
+{
+	return(WINDOW_WIDTH);
+}
+
+/***********************************************************
+ *  GetWindowHeight()
+ *
+ *  This method is used for getting the height of the display
+ *  window in pixels.
+ ***********************************************************/
+int ViewManager::GetWindowHeight() const
+{
+	return(WINDOW_HEIGHT);
 }
\ No newline at end of file
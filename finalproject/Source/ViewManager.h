@@ -1,45 +1,90 @@
-///////////////////////////////////////////////////////////////////////////////
-// viewmanager.h
-// ============
-// manage the viewing of 3D objects within the viewport - camera, projection
-//
-//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
-//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
-///////////////////////////////////////////////////////////////////////////////
-
-#pragma once
-
-#include "ShaderManager.h"
-#include "camera.h"
-
-// GLFW library
-#include "GLFW/glfw3.h" 
-
-class ViewManager
-{
-public:
-	// constructor
-	ViewManager(
-		ShaderManager* pShaderManager);
-	// destructor
-	~ViewManager();
-
-	// mouse position callback for mouse interaction with the 3D scene
-	static void Mouse_Position_Callback(GLFWwindow* window, double xMousePos, double yMousePos);
-
-private:
-	// pointer to shader manager object
-	ShaderManager* m_pShaderManager;
-	// active OpenGL display window
-	GLFWwindow* m_pWindow;
-
-	// process keyboard events for interaction with the 3D scene
-	void ProcessKeyboardEvents();
-
-public:
-	// create the initial OpenGL display window
-	GLFWwindow* CreateDisplayWindow(const char* windowTitle);
-	
-	// prepare the conversion from 3D object display to 2D scene display
-	void PrepareSceneView();
+///////////////////////////////////////////////////////////////////////////////
+// viewmanager.h
+// ============
+// manage the viewing of 3D objects within the viewport - camera, projection
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+#include "SnapshotBuffer.h"
+#include "camera.h"
+
+// GLFW library
+#include "GLFW/glfw3.h" 
+
+class ViewManager
+{
+public:
+	// constructor
+	ViewManager(
+		ShaderManager* pShaderManager);
+	// destructor
+	~ViewManager();
+
+	// mouse position callback for mouse interaction with the 3D scene
+	static void Mouse_Position_Callback(GLFWwindow* window, double xMousePos, double yMousePos);
+
+private:
+	// pointer to shader manager object
+	ShaderManager* m_pShaderManager;
+	// active OpenGL display window
+	GLFWwindow* m_pWindow;
+
+	// process keyboard events for interaction with the 3D scene
+	void ProcessKeyboardEvents();
+
+public:
+	// create the initial OpenGL display window
+	GLFWwindow* CreateDisplayWindow(const char* windowTitle);
+	
+	// move the camera by the keyboard input of the current frame
+	void UpdateCamera();
+	// get the camera of the current frame
+	SnapshotBuffer::CAMERA_STATE GetCameraState() const;
+	// draw the following frames from a camera updated elsewhere
+	void SetCameraState(const SnapshotBuffer::CAMERA_STATE& camera);
+	// prepare the conversion from 3D object display to 2D scene display
+	void PrepareSceneView();
+	// change the shader that the view values are passed into
+	void SetShaderManager(ShaderManager* pShaderManager);
+	// pass the view values of the current frame into another shader
+	void SetViewUniforms(ShaderManager* pShaderManager);
+	// place the camera at a position, looking toward a target
+	void SetCameraPose(glm::vec3 position, glm::vec3 target);
+	// offset the projection by a fraction of a pixel for temporal anti-aliasing
+	void SetProjectionJitter(glm::vec2 pixelOffset);
+
+	// get the view and projection matrices calculated for the current frame
+	glm::mat4 GetViewMatrix() const { return m_viewMatrix; }
+	glm::mat4 GetProjectionMatrix() const { return m_projectionMatrix; }
+	// get the view projection matrix without the jitter, for the current
+	// and the previous frame
+	glm::mat4 GetViewProjection() const { return m_viewProjection; }
+	glm::mat4 GetPreviousViewProjection() const { return m_previousViewProjection; }
+	// get the view frustum depth range and the display window size
+	float GetNearPlane() const;
+	float GetFarPlane() const;
+	int GetWindowWidth() const;
+	int GetWindowHeight() const;
+
+private:
+	// view and projection matrices calculated for the current frame
+	glm::mat4 m_viewMatrix;
+	glm::mat4 m_projectionMatrix;
+	// view projection matrices without the jitter, for reprojection
+	glm::mat4 m_viewProjection;
+	glm::mat4 m_previousViewProjection;
+	// true once a view projection matrix has been calculated
+	bool m_bHasViewProjection;
+	// offset of the projection in pixels
+	glm::vec2 m_projectionJitter;
+	// camera set from a snapshot, used instead of the input
+	SnapshotBuffer::CAMERA_STATE m_cameraState;
+	bool m_bUseCameraState;
+	// position of the camera the current frame is drawn from
+	glm::vec3 m_viewPosition;
 };
\ No newline at end of file
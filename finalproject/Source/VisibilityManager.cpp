@@ -0,0 +1,340 @@
+///////////////////////////////////////////////////////////////////////////////
+// visibilitymanager.cpp
+// ============
+// manage the visibility buffer path - triangle IDs per pixel, resolve pass
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "VisibilityManager.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+// declare the global variables
+namespace
+{
+	const std::string g_VisibilityName = "visibilityTexture";
+	const std::string g_InverseViewProjectionName = "inverseViewProjection";
+
+	// size of one captured triangle, three vertices of two vec4 values
+	const size_t TRIANGLE_BYTES = 3 * 2 * 4 * sizeof(GLfloat);
+	// size of one draw record, four vec4 values
+	const size_t DRAW_BYTES = 4 * 4 * sizeof(GLfloat);
+	// the triangle counter is padded to the alignment of the vertices
+	const size_t TRIANGLE_HEADER_BYTES = 4 * sizeof(GLuint);
+}
+
+/***********************************************************
+ *  VisibilityManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+VisibilityManager::VisibilityManager()
+{
+	m_visibilityFramebuffer = 0;
+	m_visibilityTexture = 0;
+	m_depthTexture = 0;
+	m_width = 0;
+	m_height = 0;
+	m_triangleBuffer = 0;
+	m_drawBuffer = 0;
+	m_pGeometryShader = NULL;
+	m_pResolveShader = NULL;
+	m_fullscreenVAO = 0;
+}
+
+/***********************************************************
+ *  ~VisibilityManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+VisibilityManager::~VisibilityManager()
+{
+	DestroyBuffers();
+
+	if (NULL != m_pGeometryShader)
+	{
+		delete m_pGeometryShader;
+		m_pGeometryShader = NULL;
+	}
+	if (NULL != m_pResolveShader)
+	{
+		delete m_pResolveShader;
+		m_pResolveShader = NULL;
+	}
+}
+
+/***********************************************************
+ *  CreateBuffers()
+ *
+ *  This method is used for creating the visibility buffer
+ *  framebuffer and the storage buffers that the geometry
+ *  pass captures the triangles and materials into.
+ ***********************************************************/
+bool VisibilityManager::CreateBuffers(int width, int height)
+{
+	m_width = width;
+	m_height = height;
+
+	glGenFramebuffers(1, &m_visibilityFramebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_visibilityFramebuffer);
+
+	// one packed draw and triangle ID per pixel
+	glGenTextures(1, &m_visibilityTexture);
+	glBindTexture(GL_TEXTURE_2D, m_visibilityTexture);
+	glTexStorage2D(GL_TEXTURE_2D, 1, GL_R32UI, width, height);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_visibilityTexture, 0);
+
+	glGenTextures(1, &m_depthTexture);
+	glBindTexture(GL_TEXTURE_2D, m_depthTexture);
+	glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH_COMPONENT24, width, height);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_depthTexture, 0);
+
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cout << "Visibility framebuffer is not complete, status:" << status << std::endl;
+		return false;
+	}
+
+	glGenBuffers(1, &m_triangleBuffer);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_triangleBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, TRIANGLE_HEADER_BYTES + (MAX_TRIANGLES * TRIANGLE_BYTES), NULL, GL_DYNAMIC_COPY);
+
+	glGenBuffers(1, &m_drawBuffer);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_drawBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, MAX_DRAWS * DRAW_BYTES, NULL, GL_DYNAMIC_COPY);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	// core profile needs a vertex array bound even when no
+	// vertex attributes are read
+	glGenVertexArrays(1, &m_fullscreenVAO);
+
+	return true;
+}
+
+/***********************************************************
+ *  DestroyBuffers()
+ *
+ *  This method is used for freeing the visibility buffer and
+ *  the capture buffers.
+ ***********************************************************/
+void VisibilityManager::DestroyBuffers()
+{
+	if (m_visibilityFramebuffer != 0)
+	{
+		GLuint textures[2] = { m_visibilityTexture, m_depthTexture };
+
+		glDeleteTextures(2, textures);
+		glDeleteFramebuffers(1, &m_visibilityFramebuffer);
+		m_visibilityFramebuffer = 0;
+		m_visibilityTexture = 0;
+		m_depthTexture = 0;
+	}
+	if (m_triangleBuffer != 0)
+	{
+		glDeleteBuffers(1, &m_triangleBuffer);
+		glDeleteBuffers(1, &m_drawBuffer);
+		m_triangleBuffer = 0;
+		m_drawBuffer = 0;
+	}
+	if (m_fullscreenVAO != 0)
+	{
+		glDeleteVertexArrays(1, &m_fullscreenVAO);
+		m_fullscreenVAO = 0;
+	}
+}
+
+/***********************************************************
+ *  AttachGeometryShader()
+ *
+ *  This method is used for compiling a geometry shader file
+ *  and linking it into a program that ShaderManager already
+ *  loaded, since ShaderManager only loads vertex and fragment
+ *  shaders.
+ ***********************************************************/
+bool VisibilityManager::AttachGeometryShader(GLuint programID, const char* filePath)
+{
+	std::ifstream shaderFile(filePath);
+	if (!shaderFile.is_open())
+	{
+		std::cout << "ERROR::GEOMETRY_SHADER_FILE_NOT_READ: " << filePath << std::endl;
+		return(false);
+	}
+
+	std::stringstream shaderStream;
+	shaderStream << shaderFile.rdbuf();
+	std::string shaderCode = shaderStream.str();
+	const char* pShaderCode = shaderCode.c_str();
+
+	GLint bSuccess = 0;
+	GLchar infoLog[1024];
+
+	GLuint shaderID = glCreateShader(GL_GEOMETRY_SHADER);
+	glShaderSource(shaderID, 1, &pShaderCode, NULL);
+	glCompileShader(shaderID);
+	glGetShaderiv(shaderID, GL_COMPILE_STATUS, &bSuccess);
+	if (bSuccess == 0)
+	{
+		glGetShaderInfoLog(shaderID, sizeof(infoLog), NULL, infoLog);
+		std::cout << "ERROR::GEOMETRY_SHADER_COMPILATION_ERROR: " << filePath << "\n" << infoLog << std::endl;
+		glDeleteShader(shaderID);
+		return(false);
+	}
+
+	glAttachShader(programID, shaderID);
+	glLinkProgram(programID);
+	glDeleteShader(shaderID);
+	glGetProgramiv(programID, GL_LINK_STATUS, &bSuccess);
+	if (bSuccess == 0)
+	{
+		glGetProgramInfoLog(programID, sizeof(infoLog), NULL, infoLog);
+		std::cout << "ERROR::PROGRAM_LINKING_ERROR: " << filePath << "\n" << infoLog << std::endl;
+		return(false);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  LoadShaders()
+ *
+ *  This method is used for loading the geometry pass shader,
+ *  with its geometry shader stage, and the resolve shader.
+ ***********************************************************/
+bool VisibilityManager::LoadShaders()
+{
+	m_pGeometryShader = new ShaderManager();
+	GLuint programID = m_pGeometryShader->LoadShaders(
+		"shaders/visibilityVertexShader.glsl",
+		"shaders/visibilityFragmentShader.glsl");
+	if (AttachGeometryShader(programID, "shaders/visibilityGeometryShader.glsl") == false)
+	{
+		return(false);
+	}
+
+	m_pResolveShader = new ShaderManager();
+	m_pResolveShader->LoadShaders(
+		"shaders/fullscreenVertexShader.glsl",
+		"shaders/visibilityResolveFragmentShader.glsl");
+	m_pResolveShader->use();
+	m_pResolveShader->setSampler2DValue(g_VisibilityName, VISIBILITY_TEXTURE_UNIT);
+	for (int i = 0; i < SCENE_TEXTURE_COUNT; i++)
+	{
+		m_pResolveShader->setSampler2DValue("sceneTextures[" + std::to_string(i) + "]", i);
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  GetGeometryShader()
+ *
+ *  This method is used for getting the shader that the scene
+ *  is drawn with during the geometry pass.
+ ***********************************************************/
+ShaderManager* VisibilityManager::GetGeometryShader()
+{
+	return(m_pGeometryShader);
+}
+
+/***********************************************************
+ *  GetResolveShader()
+ *
+ *  This method is used for getting the shader that shades
+ *  the pixels during the resolve pass.
+ ***********************************************************/
+ShaderManager* VisibilityManager::GetResolveShader()
+{
+	return(m_pResolveShader);
+}
+
+/***********************************************************
+ *  BeginGeometryPass()
+ *
+ *  This method is used for binding and clearing the
+ *  visibility buffer and resetting the triangle counter so
+ *  that the scene can be drawn into it.
+ ***********************************************************/
+void VisibilityManager::BeginGeometryPass()
+{
+	const GLuint clearID = 0;
+
+	glBindFramebuffer(GL_FRAMEBUFFER, m_visibilityFramebuffer);
+	glViewport(0, 0, m_width, m_height);
+	glEnable(GL_DEPTH_TEST);
+	glDisable(GL_BLEND);
+	glClearBufferuiv(GL_COLOR, 0, &clearID);
+	glClear(GL_DEPTH_BUFFER_BIT);
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_triangleBuffer);
+	glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(GLuint), &clearID);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, TRIANGLE_BUFFER_BINDING, m_triangleBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, DRAW_BUFFER_BINDING, m_drawBuffer);
+
+	m_pGeometryShader->use();
+}
+
+/***********************************************************
+ *  EndGeometryPass()
+ *
+ *  This method is used for going back to drawing into the
+ *  window framebuffer.
+ ***********************************************************/
+void VisibilityManager::EndGeometryPass()
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glEnable(GL_BLEND);
+
+	// the captured triangles are read by the resolve pass next
+	glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
+/***********************************************************
+ *  RenderResolve()
+ *
+ *  This method is used for shading every covered pixel of
+ *  the window once from the visibility buffer.  The clusters
+ *  must already be built for the current view.
+ ***********************************************************/
+void VisibilityManager::RenderResolve(
+	LightManager* pLightManager,
+	ClusterManager* pClusterManager,
+	const glm::mat4& view,
+	const glm::mat4& projection)
+{
+	glActiveTexture(GL_TEXTURE0 + VISIBILITY_TEXTURE_UNIT);
+	glBindTexture(GL_TEXTURE_2D, m_visibilityTexture);
+	glActiveTexture(GL_TEXTURE0);
+
+	glDisable(GL_DEPTH_TEST);
+	glDepthMask(GL_FALSE);
+	glDisable(GL_BLEND);
+
+	m_pResolveShader->use();
+	m_pResolveShader->setMat4Value(g_InverseViewProjectionName, glm::inverse(projection * view));
+	m_pResolveShader->setMat4Value("view", view);
+	m_pResolveShader->setVec3Value("viewPosition", glm::vec3(glm::inverse(view)[3]));
+	pLightManager->SetDirectionalLightUniforms(m_pResolveShader);
+	pLightManager->BindLights(m_pResolveShader);
+	pClusterManager->BindClusters(m_pResolveShader);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, TRIANGLE_BUFFER_BINDING, m_triangleBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, DRAW_BUFFER_BINDING, m_drawBuffer);
+
+	glBindVertexArray(m_fullscreenVAO);
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+	glBindVertexArray(0);
+
+	glEnable(GL_BLEND);
+	glDepthMask(GL_TRUE);
+	glEnable(GL_DEPTH_TEST);
+}
@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////////////////////////
+// visibilitymanager.h
+// ============
+// manage the visibility buffer path - triangle IDs per pixel, resolve pass
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ShaderManager.h"
+#include "LightManager.h"
+#include "ClusterManager.h"
+
+/***********************************************************
+ *  VisibilityManager
+ *
+ *  This class contains the code for rendering the scene with
+ *  a visibility buffer.  The geometry pass writes a single
+ *  32 bit value per pixel, the draw ID in the top 8 bits and
+ *  the triangle ID in the low 24 bits.  Its geometry shader
+ *  also stores the world space vertices of every triangle
+ *  and the material of every draw in storage buffers.  A
+ *  full screen resolve pass then fetches the three vertices
+ *  of each pixel's triangle, rebuilds the barycentrics and
+ *  their screen derivatives from the camera ray, and shades
+ *  the pixel once with the clustered lights.
+ ***********************************************************/
+class VisibilityManager
+{
+public:
+	// constructor
+	VisibilityManager();
+	// destructor
+	~VisibilityManager();
+
+	// limits of the packed IDs, must match the shaders
+	static const int TRIANGLE_ID_BITS = 24;
+	static const int MAX_TRIANGLES = 131072;
+	static const int MAX_DRAWS = 256;
+	// number of scene texture units the resolve pass can sample
+	static const int SCENE_TEXTURE_COUNT = 16;
+	// shader storage buffer binding points of the captured scene
+	static const int TRIANGLE_BUFFER_BINDING = 3;
+	static const int DRAW_BUFFER_BINDING = 4;
+	// texture unit the resolve pass reads the visibility buffer from
+	static const int VISIBILITY_TEXTURE_UNIT = 21;
+
+private:
+	// visibility framebuffer and its attachments
+	GLuint m_visibilityFramebuffer;
+	GLuint m_visibilityTexture;
+	GLuint m_depthTexture;
+	int m_width;
+	int m_height;
+	// captured triangle vertices and draw materials
+	GLuint m_triangleBuffer;
+	GLuint m_drawBuffer;
+	// shader used for writing the visibility buffer
+	ShaderManager* m_pGeometryShader;
+	// shader used for the full screen resolve
+	ShaderManager* m_pResolveShader;
+	// empty vertex array used for the full screen triangle
+	GLuint m_fullscreenVAO;
+
+	// compile a geometry shader file into an already loaded program
+	bool AttachGeometryShader(GLuint programID, const char* filePath);
+
+public:
+	// create the visibility buffer and the capture buffers
+	bool CreateBuffers(int width, int height);
+	// free the visibility buffer and the capture buffers
+	void DestroyBuffers();
+	// load the geometry and resolve shaders
+	bool LoadShaders();
+
+	// get the shader that the scene is drawn with in the geometry pass
+	ShaderManager* GetGeometryShader();
+	// get the shader that the resolve pass shades the pixels with
+	ShaderManager* GetResolveShader();
+
+	// bind and clear the visibility buffer before the scene is drawn
+	void BeginGeometryPass();
+	// go back to the window framebuffer after the scene is drawn
+	void EndGeometryPass();
+	// shade the window from the visibility buffer
+	void RenderResolve(
+		LightManager* pLightManager,
+		ClusterManager* pClusterManager,
+		const glm::mat4& view,
+		const glm::mat4& projection);
+};
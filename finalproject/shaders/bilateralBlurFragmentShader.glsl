@@ -0,0 +1,37 @@
+#version 330 core
+layout (location = 0) out float fragmentEffect;
+
+in vec2 fragmentTextureCoordinate;
+
+uniform sampler2D effectTexture;
+uniform sampler2D linearDepthTexture;
+// one pixel along the axis that is blurred
+uniform vec2 blurDirection;
+
+#define BLUR_RADIUS 4
+#define BLUR_SIGMA 2.5
+// how quickly the weight falls with the relative depth difference
+#define DEPTH_SHARPNESS 16.0
+
+// blurs the effect along one axis, leaving out the pixels whose depth
+// differs from this one so that the effect stays inside each object.
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    ivec2 size = textureSize(effectTexture, 0);
+    float centerDepth = texelFetch(linearDepthTexture, pixel, 0).r;
+
+    float total = 0.0;
+    float weightTotal = 0.0;
+    for(int i = -BLUR_RADIUS; i <= BLUR_RADIUS; i++)
+    {
+        ivec2 neighbor = clamp(pixel + ivec2(blurDirection * float(i)), ivec2(0), size - 1);
+        float depth = texelFetch(linearDepthTexture, neighbor, 0).r;
+        float weight = exp(-float(i * i) / (2.0 * BLUR_SIGMA * BLUR_SIGMA)) *
+            exp(-DEPTH_SHARPNESS * abs(depth - centerDepth) / centerDepth);
+        total += texelFetch(effectTexture, neighbor, 0).r * weight;
+        weightTotal += weight;
+    }
+
+    fragmentEffect = total / weightTotal;
+}
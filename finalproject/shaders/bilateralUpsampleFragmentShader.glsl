@@ -0,0 +1,44 @@
+#version 330 core
+layout (location = 0) out float fragmentEffect;
+
+in vec2 fragmentTextureCoordinate;
+
+// window sized depth, and the effect with its depth at the reduced size
+uniform sampler2D depthTexture;
+uniform sampler2D linearDepthTexture;
+uniform sampler2D effectTexture;
+uniform mat4 projection;
+// number of window pixels along each side of an effect pixel
+uniform int resolutionFactor;
+
+// keeps the weight of a matching depth finite
+#define DEPTH_EPSILON 0.001
+
+// blends the four nearest reduced pixels with bilinear weights, each
+// divided by how far its depth is from the depth of this pixel, so
+// the pixels on the other side of an edge hardly count.
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    float depth = projection[3][2] / ((texelFetch(depthTexture, pixel, 0).r * 2.0 - 1.0) + projection[2][2]);
+
+    ivec2 size = textureSize(effectTexture, 0);
+    vec2 position = (vec2(pixel) + 0.5) / float(resolutionFactor) - 0.5;
+    vec2 base = floor(position);
+    vec2 f = position - base;
+
+    float total = 0.0;
+    float weightTotal = 0.0;
+    for(int i = 0; i < 4; i++)
+    {
+        ivec2 offset = ivec2(i & 1, i >> 1);
+        ivec2 neighbor = clamp(ivec2(base) + offset, ivec2(0), size - 1);
+        float bilinear = ((offset.x == 1) ? f.x : 1.0 - f.x) * ((offset.y == 1) ? f.y : 1.0 - f.y);
+        float difference = abs(texelFetch(linearDepthTexture, neighbor, 0).r - depth) / depth;
+        float weight = bilinear / (DEPTH_EPSILON + difference);
+        total += texelFetch(effectTexture, neighbor, 0).r * weight;
+        weightTotal += weight;
+    }
+
+    fragmentEffect = total / max(weightTotal, 1e-6);
+}
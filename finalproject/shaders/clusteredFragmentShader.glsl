@@ -0,0 +1,202 @@
+#version 430 core
+out vec4 fragmentColor;
+
+in vec3 fragmentPosition;
+in vec3 fragmentVertexNormal;
+in vec2 fragmentTextureCoordinate;
+
+struct Material {
+    vec3 diffuseColor;
+    vec3 specularColor;
+    float shininess;
+};
+
+struct DirectionalLight {
+    vec3 direction;
+
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+
+    bool bActive;
+};
+
+// must match LightManager::GPU_LIGHT
+struct GpuLight {
+    vec4 positionRadius;
+    vec4 colorType;
+    vec4 directionCutOff;
+    vec4 spotParams;
+};
+
+// must match the grid size in ClusterManager
+#define GRID_X 16
+#define GRID_Y 12
+#define GRID_Z 24
+// must match the tile size in TileManager
+#define TILE_SIZE 16
+// must match LightManager::MAX_OBJECT_LIGHTS
+#define MAX_OBJECT_LIGHTS 128
+
+#define LIGHT_SPOT 1
+
+layout(std430, binding = 0) readonly buffer LightBuffer {
+    GpuLight lights[];
+};
+// clusters, or screen tiles when the tiled light lists are used
+layout(std430, binding = 1) readonly buffer ClusterBuffer {
+    uvec2 clusters[];
+};
+layout(std430, binding = 2) readonly buffer LightIndexBuffer {
+    uint lightIndices[];
+};
+
+uniform bool bUseTexture=false;
+uniform bool bUseLighting=false;
+uniform vec4 objectColor = vec4(1.0f);
+uniform vec3 viewPosition;
+uniform DirectionalLight directionalLight;
+uniform Material material;
+uniform sampler2D objectTexture;
+uniform vec2 UVscale = vec2(1.0f, 1.0f);
+uniform mat4 view;
+uniform vec2 clusterTileSize;
+uniform float clusterSliceScale;
+uniform float clusterSliceBias;
+// when false every light in the buffer is evaluated, for comparison
+uniform bool bUseClusters = true;
+// when true the light lists are per screen tile from the culling pass
+uniform bool bUseTiles = false;
+uniform int tileCountX;
+uniform int lightCount = 0;
+// when true only the lights listed for the current object are evaluated
+uniform bool bUseObjectLights = false;
+// -1 when too many lights reach the object and all of them are evaluated
+uniform int objectLightCount = -1;
+uniform ivec4 objectLightIndices[MAX_OBJECT_LIGHTS / 4];
+
+// function prototypes
+vec3 CalcDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir, vec3 baseColor);
+vec3 CalcClusteredLight(GpuLight light, vec3 normal, vec3 fragPos, vec3 viewDir, vec3 baseColor);
+uint FindCluster();
+uint FindTile();
+
+void main()
+{
+    vec4 baseColor = objectColor;
+    if(bUseTexture == true)
+    {
+        baseColor = texture(objectTexture, fragmentTextureCoordinate * UVscale);
+    }
+
+    if(bUseLighting == true)
+    {
+        vec3 phongResult = vec3(0.0f);
+        // properties
+        vec3 norm = normalize(fragmentVertexNormal);
+        vec3 viewDir = normalize(viewPosition - fragmentPosition);
+
+        // phase 1: directional lighting
+        if(directionalLight.bActive == true)
+        {
+            phongResult += CalcDirectionalLight(directionalLight, norm, viewDir, baseColor.rgb);
+        }
+        // phase 2: only the point and spot lights binned into this fragment's cluster
+        if(bUseClusters == true)
+        {
+            uvec2 cluster = clusters[(bUseTiles == true) ? FindTile() : FindCluster()];
+            for(uint i = 0u; i < cluster.y; i++)
+            {
+                GpuLight light = lights[lightIndices[cluster.x + i]];
+                phongResult += CalcClusteredLight(light, norm, fragmentPosition, viewDir, baseColor.rgb);
+            }
+        }
+        else if((bUseObjectLights == true) && (objectLightCount >= 0))
+        {
+            for(int i = 0; i < objectLightCount; i++)
+            {
+                GpuLight light = lights[objectLightIndices[i >> 2][i & 3]];
+                phongResult += CalcClusteredLight(light, norm, fragmentPosition, viewDir, baseColor.rgb);
+            }
+        }
+        else
+        {
+            for(int i = 0; i < lightCount; i++)
+            {
+                phongResult += CalcClusteredLight(lights[i], norm, fragmentPosition, viewDir, baseColor.rgb);
+            }
+        }
+
+        fragmentColor = vec4(phongResult, baseColor.a);
+    }
+    else
+    {
+        fragmentColor = baseColor;
+    }
+}
+
+// finds the froxel containing this fragment from its screen position and view depth.
+uint FindCluster()
+{
+    float viewDepth = -(view * vec4(fragmentPosition, 1.0f)).z;
+    uint slice = uint(clamp(floor(log(viewDepth) * clusterSliceScale + clusterSliceBias), 0.0, float(GRID_Z - 1)));
+    uvec2 tile = uvec2(clamp(floor(gl_FragCoord.xy / clusterTileSize), vec2(0.0), vec2(GRID_X - 1, GRID_Y - 1)));
+    return tile.x + (tile.y * GRID_X) + (slice * GRID_X * GRID_Y);
+}
+
+// finds the screen tile containing this fragment.
+uint FindTile()
+{
+    uvec2 tile = uvec2(gl_FragCoord.xy) / uint(TILE_SIZE);
+    return tile.x + (tile.y * uint(tileCountX));
+}
+
+// calculates the color when using a directional light.
+vec3 CalcDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir, vec3 baseColor)
+{
+    vec3 lightDirection = normalize(-light.direction);
+    // diffuse shading
+    float diff = max(dot(normal, lightDirection), 0.0);
+    // specular shading
+    vec3 reflectDir = reflect(-lightDirection, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
+    // combine results
+    vec3 ambient = light.ambient * baseColor;
+    vec3 diffuse = light.diffuse * diff * material.diffuseColor * baseColor;
+    vec3 specular = light.specular * spec * material.specularColor * baseColor;
+
+    return (ambient + diffuse + specular);
+}
+
+// calculates the color for a point or spot light with a finite radius.
+vec3 CalcClusteredLight(GpuLight light, vec3 normal, vec3 fragPos, vec3 viewDir, vec3 baseColor)
+{
+    vec3 toLight = light.positionRadius.xyz - fragPos;
+    float distance = length(toLight);
+    // smooth falloff that reaches zero at the light radius
+    float falloff = clamp(1.0 - (distance * distance) / (light.positionRadius.w * light.positionRadius.w), 0.0, 1.0);
+    falloff *= falloff;
+    if(falloff <= 0.0)
+    {
+        return vec3(0.0f);
+    }
+
+    vec3 lightDir = toLight / distance;
+    // spotlight intensity
+    if(int(light.colorType.w) == LIGHT_SPOT)
+    {
+        float theta = dot(lightDir, -light.directionCutOff.xyz);
+        float epsilon = light.directionCutOff.w - light.spotParams.x;
+        falloff *= clamp((theta - light.spotParams.x) / epsilon, 0.0, 1.0);
+    }
+    // diffuse shading
+    float diff = max(dot(normal, lightDir), 0.0);
+    // specular shading
+    vec3 reflectDir = reflect(-lightDir, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
+    // combine results
+    vec3 diffuse = light.colorType.rgb * diff * material.diffuseColor * baseColor;
+    vec3 specular = light.colorType.rgb * light.spotParams.y * spec * material.specularColor;
+
+    return (diffuse + specular) * falloff;
+}
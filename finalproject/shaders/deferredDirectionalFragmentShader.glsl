@@ -0,0 +1,76 @@
+#version 330 core
+out vec4 fragmentColor;
+
+in vec2 fragmentTextureCoordinate;
+
+struct DirectionalLight {
+    vec3 direction;
+
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+
+    bool bActive;
+};
+
+uniform sampler2D gAlbedo;
+uniform sampler2D gMaterial;
+uniform sampler2D gNormal;
+uniform sampler2D gDepth;
+uniform mat4 inverseViewProjection;
+uniform vec3 viewPosition;
+uniform DirectionalLight directionalLight;
+
+// function prototypes
+vec3 DecodeNormal(vec2 encoded);
+
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    float depth = texelFetch(gDepth, pixel, 0).r;
+    // nothing was drawn here, so leave the clear color
+    if(depth >= 1.0)
+    {
+        discard;
+    }
+
+    // rebuild the world position from the depth
+    vec4 clipPosition = vec4(fragmentTextureCoordinate * 2.0 - 1.0, depth * 2.0 - 1.0, 1.0);
+    vec4 worldPosition = inverseViewProjection * clipPosition;
+    vec3 fragPos = worldPosition.xyz / worldPosition.w;
+
+    vec4 albedo = texelFetch(gAlbedo, pixel, 0);
+    vec4 material = texelFetch(gMaterial, pixel, 0);
+    vec3 normal = DecodeNormal(texelFetch(gNormal, pixel, 0).xy);
+    float shininess = exp2(material.a * 8.0) - 1.0;
+
+    vec3 result = vec3(0.0f);
+    if(directionalLight.bActive == true)
+    {
+        vec3 viewDir = normalize(viewPosition - fragPos);
+        vec3 lightDirection = normalize(-directionalLight.direction);
+        // diffuse shading
+        float diff = max(dot(normal, lightDirection), 0.0);
+        // specular shading
+        vec3 reflectDir = reflect(-lightDirection, normal);
+        float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
+        // combine results
+        vec3 ambient = directionalLight.ambient * albedo.rgb;
+        vec3 diffuse = directionalLight.diffuse * diff * material.rgb * albedo.rgb;
+        vec3 specular = directionalLight.specular * spec * albedo.a * albedo.rgb;
+        result = ambient + diffuse + specular;
+    }
+
+    fragmentColor = vec4(result, 1.0f);
+}
+
+// unfolds an octahedral encoded normal from the G-buffer.
+vec3 DecodeNormal(vec2 encoded)
+{
+    encoded = encoded * 2.0 - 1.0;
+    vec3 normal = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float fold = clamp(-normal.z, 0.0, 1.0);
+    normal.x += normal.x >= 0.0 ? -fold : fold;
+    normal.y += normal.y >= 0.0 ? -fold : fold;
+    return normalize(normal);
+}
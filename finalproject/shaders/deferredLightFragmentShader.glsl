@@ -0,0 +1,91 @@
+#version 430 core
+out vec4 fragmentColor;
+
+flat in int lightIndex;
+
+// must match LightManager::GPU_LIGHT
+struct GpuLight {
+    vec4 positionRadius;
+    vec4 colorType;
+    vec4 directionCutOff;
+    vec4 spotParams;
+};
+
+#define LIGHT_SPOT 1
+
+layout(std430, binding = 0) readonly buffer LightBuffer {
+    GpuLight lights[];
+};
+
+uniform sampler2D gAlbedo;
+uniform sampler2D gMaterial;
+uniform sampler2D gNormal;
+uniform sampler2D gDepth;
+uniform mat4 inverseViewProjection;
+uniform vec3 viewPosition;
+
+// function prototypes
+vec3 DecodeNormal(vec2 encoded);
+
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    float depth = texelFetch(gDepth, pixel, 0).r;
+    if(depth >= 1.0)
+    {
+        discard;
+    }
+
+    // rebuild the world position from the depth
+    vec2 screenPosition = (vec2(pixel) + 0.5) / vec2(textureSize(gDepth, 0));
+    vec4 clipPosition = vec4(screenPosition * 2.0 - 1.0, depth * 2.0 - 1.0, 1.0);
+    vec4 worldPosition = inverseViewProjection * clipPosition;
+    vec3 fragPos = worldPosition.xyz / worldPosition.w;
+
+    // the volume covers more pixels than the light reaches
+    GpuLight light = lights[lightIndex];
+    vec3 toLight = light.positionRadius.xyz - fragPos;
+    float distance = length(toLight);
+    float falloff = clamp(1.0 - (distance * distance) / (light.positionRadius.w * light.positionRadius.w), 0.0, 1.0);
+    falloff *= falloff;
+    if(falloff <= 0.0)
+    {
+        discard;
+    }
+
+    vec4 albedo = texelFetch(gAlbedo, pixel, 0);
+    vec4 material = texelFetch(gMaterial, pixel, 0);
+    vec3 normal = DecodeNormal(texelFetch(gNormal, pixel, 0).xy);
+    float shininess = exp2(material.a * 8.0) - 1.0;
+
+    vec3 lightDir = toLight / distance;
+    // spotlight intensity
+    if(int(light.colorType.w) == LIGHT_SPOT)
+    {
+        float theta = dot(lightDir, -light.directionCutOff.xyz);
+        float epsilon = light.directionCutOff.w - light.spotParams.x;
+        falloff *= clamp((theta - light.spotParams.x) / epsilon, 0.0, 1.0);
+    }
+    vec3 viewDir = normalize(viewPosition - fragPos);
+    // diffuse shading
+    float diff = max(dot(normal, lightDir), 0.0);
+    // specular shading
+    vec3 reflectDir = reflect(-lightDir, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
+    // combine results
+    vec3 diffuse = light.colorType.rgb * diff * material.rgb * albedo.rgb;
+    vec3 specular = light.colorType.rgb * light.spotParams.y * spec * albedo.a;
+
+    fragmentColor = vec4((diffuse + specular) * falloff, 1.0f);
+}
+
+// unfolds an octahedral encoded normal from the G-buffer.
+vec3 DecodeNormal(vec2 encoded)
+{
+    encoded = encoded * 2.0 - 1.0;
+    vec3 normal = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float fold = clamp(-normal.z, 0.0, 1.0);
+    normal.x += normal.x >= 0.0 ? -fold : fold;
+    normal.y += normal.y >= 0.0 ? -fold : fold;
+    return normalize(normal);
+}
@@ -0,0 +1,26 @@
+#version 330 core
+layout (location = 0) out float fragmentDepth;
+
+in vec2 fragmentTextureCoordinate;
+
+uniform sampler2D depthTexture;
+uniform mat4 projection;
+// number of window pixels along each side of an effect pixel
+uniform int resolutionFactor;
+
+// reduces the depth to the effect resolution, keeping the closest depth
+// of each block of window pixels as a positive view space distance.
+void main()
+{
+    ivec2 base = ivec2(gl_FragCoord.xy) * resolutionFactor;
+    ivec2 size = textureSize(depthTexture, 0);
+    float closest = 1.0;
+    for(int y = 0; y < resolutionFactor; y++)
+    {
+        for(int x = 0; x < resolutionFactor; x++)
+        {
+            closest = min(closest, texelFetch(depthTexture, min(base + ivec2(x, y), size - 1), 0).r);
+        }
+    }
+    fragmentDepth = projection[3][2] / ((closest * 2.0 - 1.0) + projection[2][2]);
+}
@@ -0,0 +1,6 @@
+#version 330 core
+
+// only the depth buffer is written during the depth pre-pass
+void main()
+{
+}
@@ -0,0 +1,24 @@
+#version 330 core
+out vec4 fragmentColor;
+
+in vec2 fragmentTextureCoordinate;
+
+uniform sampler2D sceneTexture;
+// width and height multiple of the supersampled scene
+uniform int sampleFactor;
+
+// averages the block of supersampled pixels under each window pixel,
+// after limiting them to the range the window can display.
+void main()
+{
+    ivec2 base = ivec2(gl_FragCoord.xy) * sampleFactor;
+    vec3 color = vec3(0.0f);
+    for(int y = 0; y < sampleFactor; y++)
+    {
+        for(int x = 0; x < sampleFactor; x++)
+        {
+            color += clamp(texelFetch(sceneTexture, base + ivec2(x, y), 0).rgb, 0.0, 1.0);
+        }
+    }
+    fragmentColor = vec4(color / float(sampleFactor * sampleFactor), 1.0f);
+}
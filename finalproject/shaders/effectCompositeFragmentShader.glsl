@@ -0,0 +1,13 @@
+#version 330 core
+out vec4 fragmentColor;
+
+in vec2 fragmentTextureCoordinate;
+
+uniform sampler2D effectTexture;
+
+// outputs the ambient occlusion, which the blending multiplies the scene by
+void main()
+{
+    float occlusion = texelFetch(effectTexture, ivec2(gl_FragCoord.xy), 0).r;
+    fragmentColor = vec4(vec3(occlusion), 1.0f);
+}
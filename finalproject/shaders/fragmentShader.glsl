@@ -1,225 +1,511 @@
-#version 330 core
-out vec4 fragmentColor;
-
-in vec3 fragmentPosition;
-in vec3 fragmentVertexNormal;
-in vec2 fragmentTextureCoordinate;
-
-struct Material {
-    vec3 diffuseColor;
-    vec3 specularColor;
-    float shininess;
-}; 
-
-struct DirectionalLight {
-    vec3 direction;
-	
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-
-    bool bActive;
-};
-
-struct PointLight {
-    vec3 position;
-    
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-
-    bool bActive;
-};
-
-struct SpotLight {
-    vec3 position;
-    vec3 direction;
-    float cutOff;
-    float outerCutOff;
-  
-    float constant;
-    float linear;
-    float quadratic;
-  
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;       
-
-    bool bActive;
-};
-
-#define TOTAL_POINT_LIGHTS 5
-
-uniform bool bUseTexture=false;
-uniform bool bUseLighting=false;
-uniform vec4 objectColor = vec4(1.0f);
-uniform vec3 viewPosition;
-uniform DirectionalLight directionalLight;
-uniform PointLight pointLights[TOTAL_POINT_LIGHTS];
-uniform SpotLight spotLight;
-uniform Material material;
-uniform sampler2D objectTexture;
-uniform vec2 UVscale = vec2(1.0f, 1.0f);
-
-// function prototypes
-vec3 CalcDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir);
-vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
-vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
-
-void main()
-{    
-    if(bUseLighting == true)
-    {
-        vec3 phongResult = vec3(0.0f);
-        // properties
-        vec3 norm = normalize(fragmentVertexNormal);
-        vec3 viewDir = normalize(viewPosition - fragmentPosition);
-    
-        // == =====================================================
-        // Our lighting is set up in 3 phases: directional, point lights and an optional flashlight
-        // For each phase, a calculate function is defined that calculates the corresponding color
-        // per light source. In the main() function we take all the calculated colors and sum them 
-        // up for this fragment's final color.
-        // == =====================================================
-        // phase 1: directional lighting
-        if(directionalLight.bActive == true)
-        {
-            phongResult += CalcDirectionalLight(directionalLight, norm, viewDir);
-        }
-        // phase 2: point lights
-        for(int i = 0; i < TOTAL_POINT_LIGHTS; i++)
-        {
-	    if(pointLights[i].bActive == true)
-            {
-                phongResult += CalcPointLight(pointLights[i], norm, fragmentPosition, viewDir);   
-            }
-        } 
-        // phase 3: spot light
-        if(spotLight.bActive == true)
-        {
-            phongResult += CalcSpotLight(spotLight, norm, fragmentPosition, viewDir);    
-        }
-    
-        if(bUseTexture == true)
-        {
-            fragmentColor = vec4(phongResult, (texture(objectTexture, fragmentTextureCoordinate)).a);
-        }
-        else
-        {
-            fragmentColor = vec4(phongResult, objectColor.a);
-        }
-    }
-    else
-    {
-        if(bUseTexture == true)
-        {
-            fragmentColor = texture(objectTexture, fragmentTextureCoordinate * UVscale);
-        }
-        else
-        {
-            fragmentColor = objectColor;
-        }
-    }
-}
-
-// calculates the color when using a directional light.
-vec3 CalcDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir)
-{
-    vec3 ambient = vec3(0.0f);
-    vec3 diffuse = vec3(0.0f);
-    vec3 specular = vec3(0.0f);
-
-    vec3 lightDirection = normalize(-light.direction);
-    // diffuse shading
-    float diff = max(dot(normal, lightDirection), 0.0);
-    // specular shading
-    vec3 reflectDir = reflect(-lightDirection, normal);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
-    // combine results
-    if(bUseTexture == true)
-    {
-        ambient = light.ambient * vec3(texture(objectTexture, fragmentTextureCoordinate));
-        diffuse = light.diffuse * diff * material.diffuseColor * vec3(texture(objectTexture, fragmentTextureCoordinate));
-        specular = light.specular * spec * material.specularColor * vec3(texture(objectTexture, fragmentTextureCoordinate));
-    }
-    else
-    {
-        ambient = light.ambient * vec3(objectColor);
-        diffuse = light.diffuse * diff * material.diffuseColor * vec3(objectColor);
-        specular = light.specular * spec * material.specularColor * vec3(objectColor);
-    }
-    
-    return (ambient + diffuse + specular);
-}
-
-// calculates the color when using a point light.
-vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir)
-{
-    vec3 ambient = vec3(0.0f);
-    vec3 diffuse = vec3(0.0f);
-    vec3 specular= vec3(0.0f);
-
-    vec3 lightDir = normalize(light.position - fragPos);
-    // diffuse shading
-    float diff = max(dot(normal, lightDir), 0.0);
-    // specular shading
-    vec3 reflectDir = reflect(-lightDir, normal);
-    // Calculate specular component
-    float specularComponent = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
-   
-    // combine results
-    if(bUseTexture == true)
-    {
-        ambient = light.ambient * vec3(texture(objectTexture, fragmentTextureCoordinate));
-        diffuse = light.diffuse * diff * material.diffuseColor * vec3(texture(objectTexture, fragmentTextureCoordinate));
-        specular = light.specular * specularComponent * material.specularColor;
-    }
-    else
-    {
-        ambient = light.ambient * vec3(objectColor);
-        diffuse = light.diffuse * diff * material.diffuseColor * vec3(objectColor);
-        specular = light.specular * specularComponent * material.specularColor;
-    }
-    
-    return (ambient + diffuse + specular);
-}
-
-// calculates the color when using a spot light.
-vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir)
-{
-    vec3 ambient = vec3(0.0f);
-    vec3 diffuse = vec3(0.0f);
-    vec3 specular = vec3(0.0f);
-
-    vec3 lightDir = normalize(light.position - fragPos);
-    // diffuse shading
-    float diff = max(dot(normal, lightDir), 0.0);
-    // specular shading
-    vec3 reflectDir = reflect(-lightDir, normal);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
-    // attenuation
-    float distance = length(light.position - fragPos);
-    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));    
-    // spotlight intensity
-    float theta = dot(lightDir, normalize(-light.direction)); 
-    float epsilon = light.cutOff - light.outerCutOff;
-    float intensity = clamp((theta - light.outerCutOff) / epsilon, 0.0, 1.0);
-    // combine results
-    if(bUseTexture == true)
-    {
-        ambient = light.ambient * vec3(texture(objectTexture, fragmentTextureCoordinate));
-        diffuse = light.diffuse * diff * material.diffuseColor * vec3(texture(objectTexture, fragmentTextureCoordinate));
-        specular = light.specular * spec * material.specularColor * vec3(texture(objectTexture, fragmentTextureCoordinate));
-    }
-    else
-    {
-        ambient = light.ambient * vec3(objectColor);
-        diffuse = light.diffuse * diff * material.diffuseColor * vec3(objectColor);
-        specular = light.specular * spec * material.specularColor * vec3(objectColor);
-    }
-    
-    ambient *= attenuation * intensity;
-    diffuse *= attenuation * intensity;
-    specular *= attenuation * intensity;
-    return (ambient + diffuse + specular);
-}
+#version 330 core
+layout(location = 0) out vec4 fragmentColor;
+// only written while the translucent objects are blended by weight
+layout(location = 1) out vec4 fragmentRevealage;
+
+in vec3 fragmentPosition;
+in vec3 fragmentVertexNormal;
+in vec2 fragmentTextureCoordinate;
+in vec3 fragmentObjectPosition;
+
+struct Material {
+    vec3 diffuseColor;
+    vec3 specularColor;
+    float shininess;
+    float opacity;
+}; 
+
+struct DirectionalLight {
+    vec3 direction;
+	
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+
+    bool bActive;
+};
+
+struct PointLight {
+    vec3 position;
+    
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+
+    bool bActive;
+};
+
+struct SpotLight {
+    vec3 position;
+    vec3 direction;
+    float cutOff;
+    float outerCutOff;
+  
+    float constant;
+    float linear;
+    float quadratic;
+  
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;       
+
+    bool bActive;
+};
+
+struct PointShadow {
+    vec3 position;
+    float farPlane;
+
+    bool bActive;
+};
+
+#define TOTAL_POINT_LIGHTS 5
+
+// must match the shadow maps in ShadowManager
+#define CASCADE_COUNT 3
+#define MAX_SHADOW_POINT_LIGHTS 2
+#define POINT_SHADOW_NEAR_PLANE 0.1
+#define CASCADE_SHADOW_BIAS 0.0005
+#define POINT_SHADOW_BIAS 0.015
+
+// must match the chart table in LightmapManager
+#define LIGHTMAP_CHART_TEXELS 8
+
+// must match the probe grid in ProbeManager
+#define SH_COEFFICIENT_COUNT 9
+
+// passes that the opaque and the translucent objects are drawn in, the
+// scene only draws the objects of the pass so no fragment is discarded
+#define DRAW_ALL_MATERIALS 0
+#define DRAW_OPAQUE_MATERIALS 1
+#define DRAW_TRANSLUCENT_MATERIALS 2
+
+uniform bool bUseTexture=false;
+uniform bool bUseLighting=false;
+uniform vec4 objectColor = vec4(1.0f);
+uniform vec3 viewPosition;
+uniform DirectionalLight directionalLight;
+uniform PointLight pointLights[TOTAL_POINT_LIGHTS];
+uniform SpotLight spotLight;
+uniform Material material;
+uniform sampler2D objectTexture;
+uniform vec2 UVscale = vec2(1.0f, 1.0f);
+
+uniform mat4 view;
+uniform bool bUseShadows = false;
+uniform bool bUseDirectionalShadow = false;
+uniform sampler2DArrayShadow directionalShadowMap;
+uniform mat4 cascadeMatrices[CASCADE_COUNT];
+uniform float cascadeSplits[CASCADE_COUNT];
+uniform samplerCubeShadow pointShadowMaps[MAX_SHADOW_POINT_LIGHTS];
+uniform PointShadow pointShadows[MAX_SHADOW_POINT_LIGHTS];
+
+uniform bool bUseLightmap = false;
+uniform sampler2D lightmap;
+uniform sampler2D lightmapCharts;
+uniform int drawID = 0;
+
+uniform bool bUseProbes = false;
+uniform sampler3D probeGrid;
+uniform vec3 probeGridMin;
+uniform float probeGridSpacing;
+uniform vec3 probeGridSize;
+
+uniform int transparencyPass = DRAW_ALL_MATERIALS;
+// true when the translucent objects write the weighted blend targets
+uniform bool bWeightedBlend = false;
+
+// set to zero when the probes replace the constant ambient light
+float constantAmbient = 1.0f;
+
+// function prototypes
+vec3 CalcDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir, float shadow);
+vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir, float shadow);
+vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
+float CalcDirectionalShadow(vec3 fragPos);
+float CalcPointShadow(int index, vec3 fragPos);
+float SamplePointShadow(int index, vec4 coordinate);
+bool SampleLightmap(out vec3 bakedLight);
+vec3 CalcLightmapLight(vec3 bakedLight);
+vec3 CalcProbeLight(vec3 fragPos, vec3 normal);
+void WriteWeightedBlend(vec4 color);
+
+void main()
+{    
+    if(bUseLighting == true)
+    {
+        vec3 phongResult = vec3(0.0f);
+        // properties
+        vec3 norm = normalize(fragmentVertexNormal);
+        vec3 viewDir = normalize(viewPosition - fragmentPosition);
+    
+        // == =====================================================
+        // Our lighting is set up in 3 phases: directional, point lights and an optional flashlight
+        // For each phase, a calculate function is defined that calculates the corresponding color
+        // per light source. In the main() function we take all the calculated colors and sum them 
+        // up for this fragment's final color.
+        // == =====================================================
+        // phases 1 and 2 come from the lightmap on the baked objects
+        vec3 bakedLight = vec3(0.0f);
+        if((bUseLightmap == true) && (SampleLightmap(bakedLight) == true))
+        {
+            phongResult += CalcLightmapLight(bakedLight);
+        }
+        else
+        {
+            // the probes give the ambient light of the unbaked objects
+            if(bUseProbes == true)
+            {
+                constantAmbient = 0.0f;
+                phongResult += CalcProbeLight(fragmentPosition, norm);
+            }
+            // phase 1: directional lighting
+            if(directionalLight.bActive == true)
+            {
+                float shadow = 1.0f;
+                if((bUseShadows == true) && (bUseDirectionalShadow == true))
+                {
+                    shadow = CalcDirectionalShadow(fragmentPosition);
+                }
+                phongResult += CalcDirectionalLight(directionalLight, norm, viewDir, shadow);
+            }
+            // phase 2: point lights
+            for(int i = 0; i < TOTAL_POINT_LIGHTS; i++)
+            {
+                if(pointLights[i].bActive == true)
+                {
+                    float shadow = 1.0f;
+                    if((bUseShadows == true) && (i < MAX_SHADOW_POINT_LIGHTS))
+                    {
+                        shadow = CalcPointShadow(i, fragmentPosition);
+                    }
+                    phongResult += CalcPointLight(pointLights[i], norm, fragmentPosition, viewDir, shadow);
+                }
+            }
+        }
+        // phase 3: spot light
+        if(spotLight.bActive == true)
+        {
+            phongResult += CalcSpotLight(spotLight, norm, fragmentPosition, viewDir);    
+        }
+    
+        if(bUseTexture == true)
+        {
+            fragmentColor = vec4(phongResult, (texture(objectTexture, fragmentTextureCoordinate)).a);
+        }
+        else
+        {
+            fragmentColor = vec4(phongResult, objectColor.a);
+        }
+    }
+    else
+    {
+        if(bUseTexture == true)
+        {
+            fragmentColor = texture(objectTexture, fragmentTextureCoordinate * UVscale);
+        }
+        else
+        {
+            fragmentColor = objectColor;
+        }
+    }
+
+    if(transparencyPass == DRAW_TRANSLUCENT_MATERIALS)
+    {
+        fragmentColor.a *= material.opacity;
+        if(bWeightedBlend == true)
+        {
+            WriteWeightedBlend(fragmentColor);
+        }
+    }
+}
+
+// writes the color weighted by its coverage and depth into the accumulation
+// target and the coverage into the revealage target, so that the translucent
+// fragments can be blended in any order.
+void WriteWeightedBlend(vec4 color)
+{
+    // closer and more opaque fragments count for more
+    float depthWeight = 1.0f - (gl_FragCoord.z * 0.9f);
+    float weight = clamp(pow(min(1.0f, color.a * 10.0f) + 0.01f, 3.0f) * 1e8 * pow(depthWeight, 3.0f), 1e-2, 3e3);
+
+    fragmentColor = vec4(color.rgb * color.a, color.a) * weight;
+    fragmentRevealage = vec4(color.a);
+}
+
+// calculates the color when using a directional light.
+vec3 CalcDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir, float shadow)
+{
+    vec3 ambient = vec3(0.0f);
+    vec3 diffuse = vec3(0.0f);
+    vec3 specular = vec3(0.0f);
+
+    vec3 lightDirection = normalize(-light.direction);
+    // diffuse shading
+    float diff = max(dot(normal, lightDirection), 0.0);
+    // specular shading
+    vec3 reflectDir = reflect(-lightDirection, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
+    // combine results
+    if(bUseTexture == true)
+    {
+        ambient = light.ambient * vec3(texture(objectTexture, fragmentTextureCoordinate));
+        diffuse = light.diffuse * diff * material.diffuseColor * vec3(texture(objectTexture, fragmentTextureCoordinate));
+        specular = light.specular * spec * material.specularColor * vec3(texture(objectTexture, fragmentTextureCoordinate));
+    }
+    else
+    {
+        ambient = light.ambient * vec3(objectColor);
+        diffuse = light.diffuse * diff * material.diffuseColor * vec3(objectColor);
+        specular = light.specular * spec * material.specularColor * vec3(objectColor);
+    }
+    
+    return ((ambient * constantAmbient) + (shadow * (diffuse + specular)));
+}
+
+// calculates the color when using a point light.
+vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir, float shadow)
+{
+    vec3 ambient = vec3(0.0f);
+    vec3 diffuse = vec3(0.0f);
+    vec3 specular= vec3(0.0f);
+
+    vec3 lightDir = normalize(light.position - fragPos);
+    // diffuse shading
+    float diff = max(dot(normal, lightDir), 0.0);
+    // specular shading
+    vec3 reflectDir = reflect(-lightDir, normal);
+    // Calculate specular component
+    float specularComponent = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
+   
+    // combine results
+    if(bUseTexture == true)
+    {
+        ambient = light.ambient * vec3(texture(objectTexture, fragmentTextureCoordinate));
+        diffuse = light.diffuse * diff * material.diffuseColor * vec3(texture(objectTexture, fragmentTextureCoordinate));
+        specular = light.specular * specularComponent * material.specularColor;
+    }
+    else
+    {
+        ambient = light.ambient * vec3(objectColor);
+        diffuse = light.diffuse * diff * material.diffuseColor * vec3(objectColor);
+        specular = light.specular * specularComponent * material.specularColor;
+    }
+    
+    return ((ambient * constantAmbient) + (shadow * (diffuse + specular)));
+}
+
+// calculates the color when using a spot light.
+vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir)
+{
+    vec3 ambient = vec3(0.0f);
+    vec3 diffuse = vec3(0.0f);
+    vec3 specular = vec3(0.0f);
+
+    vec3 lightDir = normalize(light.position - fragPos);
+    // diffuse shading
+    float diff = max(dot(normal, lightDir), 0.0);
+    // specular shading
+    vec3 reflectDir = reflect(-lightDir, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
+    // attenuation
+    float distance = length(light.position - fragPos);
+    float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));    
+    // spotlight intensity
+    float theta = dot(lightDir, normalize(-light.direction)); 
+    float epsilon = light.cutOff - light.outerCutOff;
+    float intensity = clamp((theta - light.outerCutOff) / epsilon, 0.0, 1.0);
+    // combine results
+    if(bUseTexture == true)
+    {
+        ambient = light.ambient * vec3(texture(objectTexture, fragmentTextureCoordinate));
+        diffuse = light.diffuse * diff * material.diffuseColor * vec3(texture(objectTexture, fragmentTextureCoordinate));
+        specular = light.specular * spec * material.specularColor * vec3(texture(objectTexture, fragmentTextureCoordinate));
+    }
+    else
+    {
+        ambient = light.ambient * vec3(objectColor);
+        diffuse = light.diffuse * diff * material.diffuseColor * vec3(objectColor);
+        specular = light.specular * spec * material.specularColor * vec3(objectColor);
+    }
+    
+    ambient *= attenuation * intensity * constantAmbient;
+    diffuse *= attenuation * intensity;
+    specular *= attenuation * intensity;
+    return (ambient + diffuse + specular);
+}
+
+// calculates how much of the directional light reaches the fragment,
+// filtering a 3x3 block of texels from the cascade it falls in.
+float CalcDirectionalShadow(vec3 fragPos)
+{
+    float viewDepth = -(view * vec4(fragPos, 1.0)).z;
+    int cascade = CASCADE_COUNT;
+    for(int i = CASCADE_COUNT - 1; i >= 0; i--)
+    {
+        if(viewDepth <= cascadeSplits[i])
+        {
+            cascade = i;
+        }
+    }
+    if(cascade == CASCADE_COUNT)
+    {
+        return 1.0;
+    }
+
+    vec4 lightSpace = cascadeMatrices[cascade] * vec4(fragPos, 1.0);
+    vec3 coordinate = (lightSpace.xyz / lightSpace.w) * 0.5 + 0.5;
+    if(coordinate.z > 1.0)
+    {
+        return 1.0;
+    }
+
+    vec2 texelSize = 1.0 / vec2(textureSize(directionalShadowMap, 0).xy);
+    float lit = 0.0;
+    for(int x = -1; x <= 1; x++)
+    {
+        for(int y = -1; y <= 1; y++)
+        {
+            vec2 offset = vec2(float(x), float(y)) * texelSize;
+            lit += texture(directionalShadowMap, vec4(coordinate.xy + offset, float(cascade), coordinate.z - CASCADE_SHADOW_BIAS));
+        }
+    }
+    return lit / 9.0;
+}
+
+// calculates how much of a point light reaches the fragment, filtering
+// samples spread around the direction from the light.
+float CalcPointShadow(int index, vec3 fragPos)
+{
+    if(pointShadows[index].bActive == false)
+    {
+        return 1.0;
+    }
+
+    vec3 toFragment = fragPos - pointShadows[index].position;
+    float farPlane = pointShadows[index].farPlane;
+    // the cube map face stores the depth along its own axis
+    float axisDistance = max(abs(toFragment.x), max(abs(toFragment.y), abs(toFragment.z)));
+    if(axisDistance >= farPlane)
+    {
+        return 1.0;
+    }
+    axisDistance *= (1.0 - POINT_SHADOW_BIAS);
+    float ndcDepth = ((farPlane + POINT_SHADOW_NEAR_PLANE) / (farPlane - POINT_SHADOW_NEAR_PLANE)) -
+        ((2.0 * farPlane * POINT_SHADOW_NEAR_PLANE) / ((farPlane - POINT_SHADOW_NEAR_PLANE) * axisDistance));
+    float depth = ndcDepth * 0.5 + 0.5;
+
+    float spread = length(toFragment) * 0.005;
+    float lit = SamplePointShadow(index, vec4(toFragment, depth));
+    for(int i = 0; i < 8; i++)
+    {
+        vec3 offset = vec3(((i & 1) == 0) ? -1.0 : 1.0, ((i & 2) == 0) ? -1.0 : 1.0, ((i & 4) == 0) ? -1.0 : 1.0);
+        lit += SamplePointShadow(index, vec4(toFragment + (offset * spread), depth));
+    }
+    return lit / 9.0;
+}
+
+// samples a point light cube map, the sampler arrays can only be
+// indexed with constant expressions.
+float SamplePointShadow(int index, vec4 coordinate)
+{
+    if(index == 0)
+    {
+        return texture(pointShadowMaps[0], coordinate);
+    }
+    return texture(pointShadowMaps[1], coordinate);
+}
+
+// finds the baked light of the fragment, from the chart of the box face
+// that its object space normal points at.  returns false when the object
+// was not baked.
+bool SampleLightmap(out vec3 bakedLight)
+{
+    bakedLight = vec3(0.0);
+    vec4 boxMin = texelFetch(lightmapCharts, ivec2(0, drawID), 0);
+    if(boxMin.w < 0.5)
+    {
+        return false;
+    }
+    vec3 boxSize = texelFetch(lightmapCharts, ivec2(1, drawID), 0).xyz;
+
+    // the same face the baker picked when it drew the charts
+    vec3 normal = fragmentVertexNormal;
+    vec3 size = abs(normal);
+    int axis = 0;
+    if((size.y > size.x) && (size.y >= size.z))
+    {
+        axis = 1;
+    }
+    else if((size.z > size.x) && (size.z > size.y))
+    {
+        axis = 2;
+    }
+    int face = (axis * 2) + ((normal[axis] < 0.0) ? 1 : 0);
+    vec4 chart = texelFetch(lightmapCharts, ivec2(2 + face, drawID), 0);
+
+    vec3 local = clamp((fragmentObjectPosition - boxMin.xyz) / boxSize, 0.0, 1.0);
+    vec2 chartPosition = vec2(local[(axis + 1) % 3], local[(axis + 2) % 3]);
+    bakedLight = texture(lightmap, chart.xy + (chartPosition * chart.zw)).rgb;
+    return true;
+}
+
+// calculates the color from the baked diffuse light of the static lights,
+// with their ambient light added the same way as the light functions.
+vec3 CalcLightmapLight(vec3 bakedLight)
+{
+    vec3 ambient = vec3(0.0f);
+    if(directionalLight.bActive == true)
+    {
+        ambient += directionalLight.ambient;
+    }
+    for(int i = 0; i < TOTAL_POINT_LIGHTS; i++)
+    {
+        if(pointLights[i].bActive == true)
+        {
+            ambient += pointLights[i].ambient;
+        }
+    }
+
+    vec3 baseColor = vec3(objectColor);
+    if(bUseTexture == true)
+    {
+        baseColor = vec3(texture(objectTexture, fragmentTextureCoordinate));
+    }
+    return (ambient + (bakedLight * material.diffuseColor)) * baseColor;
+}
+
+// calculates the color from the indirect light of the probe grid, blending
+// the spherical harmonics of the eight closest probes in each texture fetch.
+vec3 CalcProbeLight(vec3 fragPos, vec3 normal)
+{
+    vec3 n = normalize(normal);
+    float basis[SH_COEFFICIENT_COUNT];
+    basis[0] = 0.282095;
+    basis[1] = 0.488603 * n.y;
+    basis[2] = 0.488603 * n.z;
+    basis[3] = 0.488603 * n.x;
+    basis[4] = 1.092548 * n.x * n.y;
+    basis[5] = 1.092548 * n.y * n.z;
+    basis[6] = 0.315392 * ((3.0 * n.z * n.z) - 1.0);
+    basis[7] = 1.092548 * n.x * n.z;
+    basis[8] = 0.546274 * ((n.x * n.x) - (n.y * n.y));
+
+    // stay between the probe centers, so that no coefficient slab
+    // is filtered with the next one
+    vec3 grid = clamp((fragPos - probeGridMin) / probeGridSpacing, vec3(0.0), probeGridSize - 1.0);
+    vec2 gridXY = (grid.xy + 0.5) / probeGridSize.xy;
+    vec3 irradiance = vec3(0.0f);
+    for(int k = 0; k < SH_COEFFICIENT_COUNT; k++)
+    {
+        float gridZ = ((float(k) * probeGridSize.z) + grid.z + 0.5) / (probeGridSize.z * float(SH_COEFFICIENT_COUNT));
+        irradiance += texture(probeGrid, vec3(gridXY, gridZ)).rgb * basis[k];
+    }
+
+    vec3 baseColor = vec3(objectColor);
+    if(bUseTexture == true)
+    {
+        baseColor = vec3(texture(objectTexture, fragmentTextureCoordinate));
+    }
+    return max(irradiance, vec3(0.0f)) * baseColor;
+}
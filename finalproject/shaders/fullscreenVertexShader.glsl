@@ -0,0 +1,10 @@
+#version 330 core
+out vec2 fragmentTextureCoordinate;
+
+// draws one triangle that covers the whole screen without any vertex data
+void main()
+{
+   vec2 corner = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+   fragmentTextureCoordinate = corner;
+   gl_Position = vec4(corner * 2.0f - 1.0f, 0.0f, 1.0f);
+}
@@ -0,0 +1,154 @@
+#version 330 core
+out vec4 fragmentColor;
+
+in vec2 fragmentTextureCoordinate;
+
+uniform sampler2D sceneTexture;
+uniform vec2 texelSize;
+
+// contrast below which a pixel is not treated as an edge
+#define EDGE_THRESHOLD_MIN 0.0312
+#define EDGE_THRESHOLD_MAX 0.125
+// amount of the sub-pixel aliasing that is removed
+#define SUBPIXEL_QUALITY 0.75
+#define SEARCH_STEPS 12
+
+const float STEP_SIZES[SEARCH_STEPS] = float[](1.0, 1.0, 1.0, 1.0, 1.0, 1.5, 2.0, 2.0, 2.0, 2.0, 4.0, 8.0);
+
+vec3 SampleColor(vec2 uv);
+float SampleLuma(vec2 uv);
+
+// blends each pixel across the luma edge it lies on, by how far it is
+// from the nearer end of the edge, following FXAA 3.11 quality.
+void main()
+{
+    vec2 uv = fragmentTextureCoordinate;
+    vec3 colorCenter = SampleColor(uv);
+
+    float lumaCenter = SampleLuma(uv);
+    float lumaDown = SampleLuma(uv + vec2(0.0, -texelSize.y));
+    float lumaUp = SampleLuma(uv + vec2(0.0, texelSize.y));
+    float lumaLeft = SampleLuma(uv + vec2(-texelSize.x, 0.0));
+    float lumaRight = SampleLuma(uv + vec2(texelSize.x, 0.0));
+
+    float lumaMin = min(lumaCenter, min(min(lumaDown, lumaUp), min(lumaLeft, lumaRight)));
+    float lumaMax = max(lumaCenter, max(max(lumaDown, lumaUp), max(lumaLeft, lumaRight)));
+    float lumaRange = lumaMax - lumaMin;
+    if(lumaRange < max(EDGE_THRESHOLD_MIN, lumaMax * EDGE_THRESHOLD_MAX))
+    {
+        fragmentColor = vec4(colorCenter, 1.0f);
+        return;
+    }
+
+    float lumaDownLeft = SampleLuma(uv + vec2(-texelSize.x, -texelSize.y));
+    float lumaUpRight = SampleLuma(uv + vec2(texelSize.x, texelSize.y));
+    float lumaUpLeft = SampleLuma(uv + vec2(-texelSize.x, texelSize.y));
+    float lumaDownRight = SampleLuma(uv + vec2(texelSize.x, -texelSize.y));
+
+    float lumaDownUp = lumaDown + lumaUp;
+    float lumaLeftRight = lumaLeft + lumaRight;
+    float lumaLeftCorners = lumaDownLeft + lumaUpLeft;
+    float lumaDownCorners = lumaDownLeft + lumaDownRight;
+    float lumaRightCorners = lumaDownRight + lumaUpRight;
+    float lumaUpCorners = lumaUpRight + lumaUpLeft;
+
+    // the edge runs along the axis with the smaller gradient
+    float edgeHorizontal = abs(-2.0 * lumaLeft + lumaLeftCorners) + abs(-2.0 * lumaCenter + lumaDownUp) * 2.0 + abs(-2.0 * lumaRight + lumaRightCorners);
+    float edgeVertical = abs(-2.0 * lumaUp + lumaUpCorners) + abs(-2.0 * lumaCenter + lumaLeftRight) * 2.0 + abs(-2.0 * lumaDown + lumaDownCorners);
+    bool bHorizontal = (edgeHorizontal >= edgeVertical);
+
+    // find which side of the pixel the edge is on
+    float luma1 = bHorizontal ? lumaDown : lumaLeft;
+    float luma2 = bHorizontal ? lumaUp : lumaRight;
+    float gradient1 = luma1 - lumaCenter;
+    float gradient2 = luma2 - lumaCenter;
+    bool bSteepest1 = abs(gradient1) >= abs(gradient2);
+    float gradientScaled = 0.25 * max(abs(gradient1), abs(gradient2));
+
+    float stepLength = bHorizontal ? texelSize.y : texelSize.x;
+    float lumaLocalAverage = 0.0;
+    if(bSteepest1)
+    {
+        stepLength = -stepLength;
+        lumaLocalAverage = 0.5 * (luma1 + lumaCenter);
+    }
+    else
+    {
+        lumaLocalAverage = 0.5 * (luma2 + lumaCenter);
+    }
+
+    // walk both ways along the edge until its luma changes
+    vec2 currentUv = uv;
+    if(bHorizontal)
+    {
+        currentUv.y += stepLength * 0.5;
+    }
+    else
+    {
+        currentUv.x += stepLength * 0.5;
+    }
+    vec2 offset = bHorizontal ? vec2(texelSize.x, 0.0) : vec2(0.0, texelSize.y);
+    vec2 uv1 = currentUv - offset * STEP_SIZES[0];
+    vec2 uv2 = currentUv + offset * STEP_SIZES[0];
+    float lumaEnd1 = SampleLuma(uv1) - lumaLocalAverage;
+    float lumaEnd2 = SampleLuma(uv2) - lumaLocalAverage;
+    bool bReached1 = abs(lumaEnd1) >= gradientScaled;
+    bool bReached2 = abs(lumaEnd2) >= gradientScaled;
+
+    for(int i = 1; (i < SEARCH_STEPS) && !(bReached1 && bReached2); i++)
+    {
+        if(!bReached1)
+        {
+            uv1 -= offset * STEP_SIZES[i];
+            lumaEnd1 = SampleLuma(uv1) - lumaLocalAverage;
+            bReached1 = abs(lumaEnd1) >= gradientScaled;
+        }
+        if(!bReached2)
+        {
+            uv2 += offset * STEP_SIZES[i];
+            lumaEnd2 = SampleLuma(uv2) - lumaLocalAverage;
+            bReached2 = abs(lumaEnd2) >= gradientScaled;
+        }
+    }
+
+    float distance1 = bHorizontal ? (uv.x - uv1.x) : (uv.y - uv1.y);
+    float distance2 = bHorizontal ? (uv2.x - uv.x) : (uv2.y - uv.y);
+    bool bDirection1 = distance1 < distance2;
+    float distanceFinal = min(distance1, distance2);
+    float edgeLength = distance1 + distance2;
+    float pixelOffset = -distanceFinal / edgeLength + 0.5;
+
+    // only blend when the nearer end agrees with the side of the edge
+    bool bCenterSmaller = lumaCenter < lumaLocalAverage;
+    bool bCorrectVariation = ((bDirection1 ? lumaEnd1 : lumaEnd2) < 0.0) != bCenterSmaller;
+    float finalOffset = bCorrectVariation ? pixelOffset : 0.0;
+
+    // sub-pixel aliasing from the contrast against the 3x3 average
+    float lumaAverage = (1.0 / 12.0) * (2.0 * (lumaDownUp + lumaLeftRight) + lumaLeftCorners + lumaRightCorners);
+    float subPixelOffset1 = clamp(abs(lumaAverage - lumaCenter) / lumaRange, 0.0, 1.0);
+    float subPixelOffset2 = (-2.0 * subPixelOffset1 + 3.0) * subPixelOffset1 * subPixelOffset1;
+    finalOffset = max(finalOffset, subPixelOffset2 * subPixelOffset2 * SUBPIXEL_QUALITY);
+
+    vec2 finalUv = uv;
+    if(bHorizontal)
+    {
+        finalUv.y += finalOffset * stepLength;
+    }
+    else
+    {
+        finalUv.x += finalOffset * stepLength;
+    }
+    fragmentColor = vec4(SampleColor(finalUv), 1.0f);
+}
+
+// reads the scene as it will be displayed, without the range above one.
+vec3 SampleColor(vec2 uv)
+{
+    return clamp(texture(sceneTexture, uv).rgb, 0.0, 1.0);
+}
+
+// reads the perceived brightness of the scene.
+float SampleLuma(vec2 uv)
+{
+    return sqrt(dot(SampleColor(uv), vec3(0.299, 0.587, 0.114)));
+}
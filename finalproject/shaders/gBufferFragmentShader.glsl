@@ -0,0 +1,54 @@
+#version 330 core
+layout (location = 0) out vec4 gAlbedo;
+layout (location = 1) out vec4 gMaterial;
+layout (location = 2) out vec2 gNormal;
+
+in vec3 fragmentPosition;
+in vec3 fragmentVertexNormal;
+in vec2 fragmentTextureCoordinate;
+
+struct Material {
+    vec3 diffuseColor;
+    vec3 specularColor;
+    float shininess;
+};
+
+uniform bool bUseTexture=false;
+uniform vec4 objectColor = vec4(1.0f);
+uniform Material material;
+uniform sampler2D objectTexture;
+uniform vec2 UVscale = vec2(1.0f, 1.0f);
+
+// function prototypes
+vec2 EncodeNormal(vec3 normal);
+
+void main()
+{
+    vec4 baseColor = objectColor;
+    if(bUseTexture == true)
+    {
+        baseColor = texture(objectTexture, fragmentTextureCoordinate * UVscale);
+    }
+
+    // the specular color is stored as a single intensity to keep the G-buffer small
+    float specularIntensity = max(material.specularColor.r, max(material.specularColor.g, material.specularColor.b));
+    // shininess is stored on a log scale so that both rough and very shiny materials keep precision
+    float encodedShininess = clamp(log2(material.shininess + 1.0) / 8.0, 0.0, 1.0);
+
+    gAlbedo = vec4(baseColor.rgb, clamp(specularIntensity, 0.0, 1.0));
+    gMaterial = vec4(material.diffuseColor, encodedShininess);
+    gNormal = EncodeNormal(normalize(fragmentVertexNormal));
+}
+
+// folds the unit normal onto an octahedron and unfolds it into the [0, 1] square.
+vec2 EncodeNormal(vec3 normal)
+{
+    normal /= (abs(normal.x) + abs(normal.y) + abs(normal.z));
+    vec2 encoded = normal.xy;
+    if(normal.z < 0.0)
+    {
+        vec2 signs = vec2(normal.x >= 0.0 ? 1.0 : -1.0, normal.y >= 0.0 ? 1.0 : -1.0);
+        encoded = (1.0 - abs(normal.yx)) * signs;
+    }
+    return encoded * 0.5 + 0.5;
+}
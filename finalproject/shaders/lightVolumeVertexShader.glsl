@@ -0,0 +1,28 @@
+#version 430 core
+layout (location = 0) in vec3 inVertexPosition;
+
+flat out int lightIndex;
+
+// must match LightManager::GPU_LIGHT
+struct GpuLight {
+    vec4 positionRadius;
+    vec4 colorType;
+    vec4 directionCutOff;
+    vec4 spotParams;
+};
+
+layout(std430, binding = 0) readonly buffer LightBuffer {
+    GpuLight lights[];
+};
+
+uniform mat4 view;
+uniform mat4 projection;
+
+// scales the unit light volume to the radius of the light drawn by this instance
+void main()
+{
+   GpuLight light = lights[gl_InstanceID];
+   vec3 worldPosition = light.positionRadius.xyz + inVertexPosition * light.positionRadius.w;
+   lightIndex = gl_InstanceID;
+   gl_Position = projection * view * vec4(worldPosition, 1.0f);
+}
@@ -0,0 +1,45 @@
+#version 330 core
+layout (location = 0) in vec3 inVertexPosition;
+layout (location = 1) in vec3 inVertexNormal;
+layout (location = 2) in vec2 inTextureCoordinate;
+
+// every output is captured with transform feedback, in this order,
+// and must match the vertex layout of the lightmap baker
+out vec3 captureWorldPosition;
+out vec3 captureObjectPosition;
+out vec3 captureObjectNormal;
+out vec3 captureWorldNormal;
+out vec3 captureAlbedo;
+out vec3 captureAxisScale;
+out float captureDrawID;
+
+struct Material {
+    vec3 diffuseColor;
+    vec3 specularColor;
+    float shininess;
+};
+
+uniform mat4 model;
+uniform int drawID = 0;
+uniform bool bUseTexture = false;
+uniform vec4 objectColor = vec4(1.0f);
+uniform sampler2D objectTexture;
+uniform Material material;
+
+void main()
+{
+   captureWorldPosition = vec3(model * vec4(inVertexPosition, 1.0));
+   captureObjectPosition = inVertexPosition;
+   captureObjectNormal = inVertexNormal;
+   captureWorldNormal = normalize(mat3(transpose(inverse(model))) * inVertexNormal);
+   // the smallest mip level is the average color of the texture
+   vec3 baseColor = vec3(objectColor);
+   if(bUseTexture == true)
+   {
+      baseColor = textureLod(objectTexture, inTextureCoordinate, 100.0).rgb;
+   }
+   captureAlbedo = material.diffuseColor * baseColor;
+   captureAxisScale = vec3(length(model[0].xyz), length(model[1].xyz), length(model[2].xyz));
+   captureDrawID = float(drawID);
+   gl_Position = vec4(captureWorldPosition, 1.0);
+}
@@ -0,0 +1,18 @@
+#version 420 core
+out vec4 outputColor;
+
+in vec3 fragmentNormal;
+in vec4 fragmentColor;
+
+layout (std140, binding = 1) uniform FrameBlock
+{
+    mat4 viewProjection;
+    vec4 lightDirection;
+} frame;
+
+// lights the object color from one direction over a constant ambient light
+void main()
+{
+    float diffuse = max(dot(normalize(fragmentNormal), -frame.lightDirection.xyz), 0.0f);
+    outputColor = vec4(fragmentColor.rgb * (0.3f + 0.7f * diffuse), fragmentColor.a);
+}
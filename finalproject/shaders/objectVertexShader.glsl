@@ -0,0 +1,31 @@
+#version 420 core
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec3 normal;
+layout (location = 2) in vec2 textureCoordinate;
+
+// range of the object buffer bound for this draw
+layout (std140, binding = 0) uniform ObjectBlock
+{
+    mat4 model;
+    vec4 color;
+} object;
+
+layout (std140, binding = 1) uniform FrameBlock
+{
+    mat4 viewProjection;
+    vec4 lightDirection;
+} frame;
+
+out vec3 fragmentNormal;
+out vec4 fragmentColor;
+
+// the depth pass and the shading pass must produce identical depths
+invariant gl_Position;
+
+// places the box of the object, every value comes from the uniform blocks
+void main()
+{
+    gl_Position = frame.viewProjection * object.model * vec4(position, 1.0f);
+    fragmentNormal = mat3(object.model) * normal;
+    fragmentColor = object.color;
+}
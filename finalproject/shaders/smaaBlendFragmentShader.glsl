@@ -0,0 +1,55 @@
+#version 330 core
+out vec4 fragmentColor;
+
+in vec2 fragmentTextureCoordinate;
+
+uniform sampler2D sceneTexture;
+uniform sampler2D weightsTexture;
+
+vec4 Weights(ivec2 pixel);
+vec3 SceneColor(ivec2 pixel);
+
+// blends each pixel with its neighbors by the weights found for the
+// edges on its four sides.
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    vec4 weights = Weights(pixel);
+
+    // bottom and left edges belong to this pixel, top and right edges
+    // to the pixels above and on the right
+    float down = weights.x;
+    float left = weights.z;
+    float up = Weights(pixel + ivec2(0, 1)).y;
+    float right = Weights(pixel + ivec2(1, 0)).w;
+
+    vec3 color = SceneColor(pixel);
+    float total = down + up + left + right;
+    if(total > 0.0)
+    {
+        // keep the weights from adding up to more than the whole pixel
+        float scale = 1.0 / max(total, 1.0);
+        vec3 blended = SceneColor(pixel - ivec2(0, 1)) * down + SceneColor(pixel + ivec2(0, 1)) * up +
+            SceneColor(pixel - ivec2(1, 0)) * left + SceneColor(pixel + ivec2(1, 0)) * right;
+        color = color * (1.0 - total * scale) + blended * scale;
+    }
+
+    fragmentColor = vec4(color, 1.0f);
+}
+
+// reads the blend weights of a pixel, none outside the window.
+vec4 Weights(ivec2 pixel)
+{
+    if(any(greaterThanEqual(pixel, textureSize(weightsTexture, 0))))
+    {
+        return vec4(0.0f);
+    }
+    return texelFetch(weightsTexture, pixel, 0);
+}
+
+// reads the scene as it will be displayed, repeating the border pixels.
+vec3 SceneColor(ivec2 pixel)
+{
+    pixel = clamp(pixel, ivec2(0), textureSize(sceneTexture, 0) - 1);
+    return clamp(texelFetch(sceneTexture, pixel, 0).rgb, 0.0, 1.0);
+}
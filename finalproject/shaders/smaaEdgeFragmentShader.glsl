@@ -0,0 +1,46 @@
+#version 330 core
+layout (location = 0) out vec2 fragmentEdges;
+
+in vec2 fragmentTextureCoordinate;
+
+uniform sampler2D sceneTexture;
+
+// luma difference that counts as an edge
+#define EDGE_THRESHOLD 0.1
+// an edge is dropped when a neighboring edge is this much stronger
+#define LOCAL_CONTRAST_FACTOR 2.0
+
+float Luma(ivec2 pixel);
+
+// marks the edges on the left and the bottom side of each pixel, with
+// the local contrast adaptation of SMAA.
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    float luma = Luma(pixel);
+    float lumaLeft = Luma(pixel - ivec2(1, 0));
+    float lumaBottom = Luma(pixel - ivec2(0, 1));
+
+    vec2 delta = abs(luma - vec2(lumaLeft, lumaBottom));
+    vec2 edges = step(EDGE_THRESHOLD, delta);
+    if(dot(edges, vec2(1.0)) == 0.0)
+    {
+        discard;
+    }
+
+    // strongest difference around the two edges
+    vec2 deltaNext = abs(luma - vec2(Luma(pixel + ivec2(1, 0)), Luma(pixel + ivec2(0, 1))));
+    vec2 deltaFar = abs(vec2(lumaLeft, lumaBottom) - vec2(Luma(pixel - ivec2(2, 0)), Luma(pixel - ivec2(0, 2))));
+    vec2 maxDelta = max(max(delta, deltaNext), deltaFar);
+    float finalDelta = max(maxDelta.x, maxDelta.y);
+
+    fragmentEdges = edges * step(finalDelta, LOCAL_CONTRAST_FACTOR * delta);
+}
+
+// reads the perceived brightness of a pixel, repeating the border pixels.
+float Luma(ivec2 pixel)
+{
+    pixel = clamp(pixel, ivec2(0), textureSize(sceneTexture, 0) - 1);
+    vec3 color = clamp(texelFetch(sceneTexture, pixel, 0).rgb, 0.0, 1.0);
+    return sqrt(dot(color, vec3(0.299, 0.587, 0.114)));
+}
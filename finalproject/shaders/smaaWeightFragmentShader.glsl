@@ -0,0 +1,110 @@
+#version 330 core
+layout (location = 0) out vec4 fragmentWeights;
+
+in vec2 fragmentTextureCoordinate;
+
+uniform sampler2D edgesTexture;
+
+// pixels searched along an edge in each direction
+#define MAX_SEARCH_STEPS 16
+
+vec2 Edges(ivec2 pixel);
+int SearchLength(ivec2 pixel, ivec2 direction, int channel);
+vec2 RunArea(float position, float runLength, float startSign, float endSign);
+
+// finds the blend weights of the pixels on each side of the bottom and
+// the left edge of this pixel.  The run of the edge is searched in both
+// directions, and the crossing edges at its ends give the shape of the
+// silhouette, as in MLAA and SMAA.  Instead of the precomputed area
+// texture of SMAA, the area under the silhouette line is integrated
+// directly.
+//
+//   bottom edge  x: this pixel blends with the one below
+//                y: the pixel below blends with this one
+//   left edge    z: this pixel blends with the one on the left
+//                w: the pixel on the left blends with this one
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    vec2 edges = Edges(pixel);
+    vec4 weights = vec4(0.0f);
+
+    if(edges.g > 0.5)
+    {
+        int left = SearchLength(pixel, ivec2(-1, 0), 1);
+        int right = SearchLength(pixel, ivec2(1, 0), 1);
+        // crossing edges are left edges, in this row or the one below
+        ivec2 start = pixel - ivec2(left, 0);
+        ivec2 end = pixel + ivec2(right + 1, 0);
+        float startSign = Edges(start).r - Edges(start - ivec2(0, 1)).r;
+        float endSign = Edges(end).r - Edges(end - ivec2(0, 1)).r;
+        weights.xy = RunArea(float(left), float(left + right + 1), startSign, endSign);
+    }
+    if(edges.r > 0.5)
+    {
+        int bottom = SearchLength(pixel, ivec2(0, -1), 0);
+        int top = SearchLength(pixel, ivec2(0, 1), 0);
+        // crossing edges are bottom edges, in this column or the one on the left
+        ivec2 start = pixel - ivec2(0, bottom);
+        ivec2 end = pixel + ivec2(0, top + 1);
+        float startSign = Edges(start).g - Edges(start - ivec2(1, 0)).g;
+        float endSign = Edges(end).g - Edges(end - ivec2(1, 0)).g;
+        weights.zw = RunArea(float(bottom), float(bottom + top + 1), startSign, endSign);
+    }
+
+    fragmentWeights = weights;
+}
+
+// reads the edges of a pixel, none outside the window.
+vec2 Edges(ivec2 pixel)
+{
+    if(any(lessThan(pixel, ivec2(0))) || any(greaterThanEqual(pixel, textureSize(edgesTexture, 0))))
+    {
+        return vec2(0.0f);
+    }
+    return texelFetch(edgesTexture, pixel, 0).rg;
+}
+
+// counts the pixels next to this one that continue the same edge.
+int SearchLength(ivec2 pixel, ivec2 direction, int channel)
+{
+    int length = 0;
+    for(int i = 1; i <= MAX_SEARCH_STEPS; i++)
+    {
+        if(Edges(pixel + direction * i)[channel] < 0.5)
+        {
+            break;
+        }
+        length = i;
+    }
+    return length;
+}
+
+// integrates the silhouette line over the pixel at the passed in position
+// of an edge run.  Each half of the run has a line from half a pixel at
+// its end, on the side of the crossing edge, down to the edge at the
+// middle of the run.  Returns the area on this side of the edge and the
+// area on the other side.
+vec2 RunArea(float position, float runLength, float startSign, float endSign)
+{
+    float halfLength = runLength * 0.5;
+    vec2 area = vec2(0.0f);
+
+    float a = position;
+    float b = min(position + 1.0, halfLength);
+    if(b > a)
+    {
+        float height = startSign * 0.5 * (1.0 - ((a + b) * 0.5) / halfLength) * (b - a);
+        area += vec2(max(height, 0.0), max(-height, 0.0));
+    }
+
+    a = max(position, halfLength);
+    b = position + 1.0;
+    if(b > a)
+    {
+        float height = endSign * 0.5 * (1.0 - (runLength - (a + b) * 0.5) / halfLength) * (b - a);
+        area += vec2(max(height, 0.0), max(-height, 0.0));
+    }
+
+    return area;
+}
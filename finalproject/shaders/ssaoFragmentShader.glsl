@@ -0,0 +1,93 @@
+#version 330 core
+layout (location = 0) out float fragmentOcclusion;
+
+in vec2 fragmentTextureCoordinate;
+
+uniform sampler2D linearDepthTexture;
+uniform mat4 projection;
+
+// samples taken in the hemisphere above each pixel
+#define SAMPLE_COUNT 12
+// world distance the occluders are searched within
+#define RADIUS 0.5
+// depth difference ignored, so flat surfaces do not occlude themselves
+#define BIAS 0.02
+// darkening of a fully occluded pixel
+#define INTENSITY 1.5
+#define GOLDEN_ANGLE 2.39996
+
+vec3 ViewPosition(ivec2 pixel, ivec2 size);
+
+// estimates how much of the hemisphere above each pixel is blocked by
+// the nearby depth, with the normal rebuilt from the depth alone.  The
+// samples spiral around the normal with a different rotation per pixel,
+// which the blur pass averages away.
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    ivec2 size = textureSize(linearDepthTexture, 0);
+    vec3 position = ViewPosition(pixel, size);
+
+    // nothing was drawn at the far plane
+    float farPlane = projection[3][2] / (1.0 + projection[2][2]);
+    if(-position.z >= farPlane * 0.999)
+    {
+        fragmentOcclusion = 1.0;
+        return;
+    }
+
+    // take the smaller difference on each axis, so that the normal
+    // does not bend across the edge of an object
+    vec3 right = ViewPosition(min(pixel + ivec2(1, 0), size - 1), size) - position;
+    vec3 left = position - ViewPosition(max(pixel - ivec2(1, 0), ivec2(0)), size);
+    vec3 up = ViewPosition(min(pixel + ivec2(0, 1), size - 1), size) - position;
+    vec3 down = position - ViewPosition(max(pixel - ivec2(0, 1), ivec2(0)), size);
+    vec3 dx = (abs(right.z) < abs(left.z)) ? right : left;
+    vec3 dy = (abs(up.z) < abs(down.z)) ? up : down;
+    vec3 normal = normalize(cross(dx, dy));
+
+    vec3 tangent = normalize(cross((abs(normal.z) < 0.999) ? vec3(0.0, 0.0, 1.0) : vec3(1.0, 0.0, 0.0), normal));
+    vec3 bitangent = cross(normal, tangent);
+
+    // interleaved gradient noise for the rotation of the spiral
+    float rotation = 6.28318 * fract(52.9829189 * fract(dot(gl_FragCoord.xy, vec2(0.06711056, 0.00583715))));
+
+    float occlusion = 0.0;
+    for(int i = 0; i < SAMPLE_COUNT; i++)
+    {
+        // cosine weighted directions, closer to the pixel for the first samples
+        float t = (float(i) + 0.5) / float(SAMPLE_COUNT);
+        float angle = float(i) * GOLDEN_ANGLE + rotation;
+        vec3 direction = vec3(cos(angle) * sqrt(t), sin(angle) * sqrt(t), sqrt(1.0 - t));
+        float scale = mix(0.1, 1.0, t * t) * RADIUS;
+        vec3 samplePosition = position + (tangent * direction.x + bitangent * direction.y + normal * direction.z) * scale;
+
+        float sampleDepth = -samplePosition.z;
+        vec2 ndc = vec2(
+            projection[0][0] * samplePosition.x / sampleDepth - projection[2][0],
+            projection[1][1] * samplePosition.y / sampleDepth - projection[2][1]);
+        vec2 uv = ndc * 0.5 + 0.5;
+        if(any(lessThan(uv, vec2(0.0))) || any(greaterThanEqual(uv, vec2(1.0))))
+        {
+            continue;
+        }
+
+        float sceneDepth = texelFetch(linearDepthTexture, ivec2(uv * vec2(size)), 0).r;
+        // occluders far in front of the pixel do not count
+        float rangeCheck = smoothstep(0.0, 1.0, RADIUS / abs(-position.z - sceneDepth));
+        occlusion += ((sceneDepth < sampleDepth - BIAS) ? 1.0 : 0.0) * rangeCheck;
+    }
+
+    fragmentOcclusion = clamp(1.0 - INTENSITY * occlusion / float(SAMPLE_COUNT), 0.0, 1.0);
+}
+
+// rebuilds the view space position of a pixel from its linear depth.
+vec3 ViewPosition(ivec2 pixel, ivec2 size)
+{
+    float depth = texelFetch(linearDepthTexture, pixel, 0).r;
+    vec2 ndc = ((vec2(pixel) + 0.5) / vec2(size)) * 2.0 - 1.0;
+    return vec3(
+        (ndc.x + projection[2][0]) * depth / projection[0][0],
+        (ndc.y + projection[2][1]) * depth / projection[1][1],
+        -depth);
+}
@@ -0,0 +1,96 @@
+#version 330 core
+out vec4 fragmentColor;
+
+in vec2 fragmentTextureCoordinate;
+
+uniform sampler2D sceneTexture;
+uniform sampler2D depthTexture;
+uniform sampler2D historyTexture;
+// view projection of this frame and the last one, without the jitter
+uniform mat4 inverseViewProjection;
+uniform mat4 previousViewProjection;
+uniform bool bHistoryValid = false;
+
+// part of each pixel that comes from its history
+#define HISTORY_WEIGHT 0.9
+
+vec3 RGBToYCoCg(vec3 color);
+vec3 YCoCgToRGB(vec3 color);
+
+// blends the jittered frame with the history of each pixel, found by
+// reprojecting its position into the last frame.  The history is
+// clamped to the colors around the pixel in this frame, so that
+// surfaces that were hidden or moved do not leave ghosts.
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    ivec2 size = textureSize(sceneTexture, 0);
+    vec3 current = texelFetch(sceneTexture, pixel, 0).rgb;
+
+    // color range of the 3x3 neighborhood, and its closest depth so
+    // that the edges of nearer objects are reprojected with them
+    vec3 colorMin = vec3(1e9);
+    vec3 colorMax = vec3(-1e9);
+    float closestDepth = 1.0;
+    ivec2 closestPixel = pixel;
+    for(int y = -1; y <= 1; y++)
+    {
+        for(int x = -1; x <= 1; x++)
+        {
+            ivec2 neighbor = clamp(pixel + ivec2(x, y), ivec2(0), size - 1);
+            vec3 color = RGBToYCoCg(texelFetch(sceneTexture, neighbor, 0).rgb);
+            colorMin = min(colorMin, color);
+            colorMax = max(colorMax, color);
+            float depth = texelFetch(depthTexture, neighbor, 0).r;
+            if(depth < closestDepth)
+            {
+                closestDepth = depth;
+                closestPixel = neighbor;
+            }
+        }
+    }
+
+    // move the pixel by the camera motion since the last frame
+    vec2 closestUv = (vec2(closestPixel) + 0.5) / vec2(size);
+    vec4 worldPosition = inverseViewProjection * vec4(closestUv * 2.0 - 1.0, closestDepth * 2.0 - 1.0, 1.0);
+    worldPosition /= worldPosition.w;
+    vec4 previousClip = previousViewProjection * worldPosition;
+    vec2 previousUv = (previousClip.xy / previousClip.w) * 0.5 + 0.5;
+    vec2 historyUv = fragmentTextureCoordinate + (previousUv - closestUv);
+
+    if(!bHistoryValid || any(lessThan(historyUv, vec2(0.0))) || any(greaterThan(historyUv, vec2(1.0))))
+    {
+        fragmentColor = vec4(current, 1.0f);
+        return;
+    }
+
+    vec3 history = texture(historyTexture, historyUv).rgb;
+    history = YCoCgToRGB(clamp(RGBToYCoCg(history), colorMin, colorMax));
+
+    // weigh by the inverse brightness so single bright pixels of the
+    // HDR scene do not flicker through the average
+    float currentWeight = (1.0 - HISTORY_WEIGHT) / (1.0 + RGBToYCoCg(current).x);
+    float historyWeight = HISTORY_WEIGHT / (1.0 + RGBToYCoCg(history).x);
+    vec3 result = (current * currentWeight + history * historyWeight) / (currentWeight + historyWeight);
+
+    fragmentColor = vec4(result, 1.0f);
+}
+
+// converts to luma and two chroma channels, whose range box fits the
+// colors of a neighborhood more tightly than RGB.
+vec3 RGBToYCoCg(vec3 color)
+{
+    return vec3(
+        0.25 * color.r + 0.5 * color.g + 0.25 * color.b,
+        0.5 * color.r - 0.5 * color.b,
+        -0.25 * color.r + 0.5 * color.g - 0.25 * color.b);
+}
+
+// converts back from luma and chroma.
+vec3 YCoCgToRGB(vec3 color)
+{
+    return vec3(
+        color.x + color.y - color.z,
+        color.x + color.z,
+        color.x - color.y - color.z);
+}
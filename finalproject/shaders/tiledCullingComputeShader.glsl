@@ -0,0 +1,139 @@
+#version 430 core
+
+// must match the tile size and list size in TileManager
+#define TILE_SIZE 16
+#define MAX_LIGHTS_PER_TILE 256
+
+layout(local_size_x = TILE_SIZE, local_size_y = TILE_SIZE) in;
+
+// must match LightManager::GPU_LIGHT
+struct GpuLight {
+    vec4 positionRadius;
+    vec4 colorType;
+    vec4 directionCutOff;
+    vec4 spotParams;
+};
+
+layout(std430, binding = 0) readonly buffer LightBuffer {
+    GpuLight lights[];
+};
+// x = first light index of the tile, y = number of lights, in the
+// same layout the clustered shading reads its clusters from
+layout(std430, binding = 1) writeonly buffer TileBuffer {
+    uvec2 tiles[];
+};
+layout(std430, binding = 2) writeonly buffer LightIndexBuffer {
+    uint lightIndices[];
+};
+
+uniform sampler2D depthTexture;
+uniform mat4 view;
+uniform mat4 inverseProjection;
+uniform vec2 screenSize;
+uniform int lightCount = 0;
+
+shared uint tileMinDepth;
+shared uint tileMaxDepth;
+shared uint tileLightCount;
+
+// function prototypes
+vec3 ViewPosition(vec2 ndc, float depth);
+vec3 SidePlane(vec3 cornerA, vec3 cornerB, vec3 center);
+
+void main()
+{
+    uint localIndex = gl_LocalInvocationIndex;
+    uint tileIndex = gl_WorkGroupID.x + (gl_WorkGroupID.y * gl_NumWorkGroups.x);
+
+    if(localIndex == 0u)
+    {
+        tileMinDepth = 0xFFFFFFFFu;
+        tileMaxDepth = 0u;
+        tileLightCount = 0u;
+    }
+    barrier();
+
+    // phase 1: depth range of the tile, the depth values are positive
+    // so their bit patterns sort the same way as the floats
+    ivec2 pixel = ivec2(gl_GlobalInvocationID.xy);
+    if(all(lessThan(pixel, ivec2(screenSize))))
+    {
+        float depth = texelFetch(depthTexture, pixel, 0).r;
+        // pixels that were not drawn would stretch the range to the far plane
+        if(depth < 1.0)
+        {
+            atomicMin(tileMinDepth, floatBitsToUint(depth));
+            atomicMax(tileMaxDepth, floatBitsToUint(depth));
+        }
+    }
+    barrier();
+
+    // phase 2: test every light against the tile frustum
+    if(tileMinDepth <= tileMaxDepth)
+    {
+        vec2 ndcMin = (vec2(gl_WorkGroupID.xy * uint(TILE_SIZE)) / screenSize) * 2.0 - 1.0;
+        vec2 ndcMax = (vec2((gl_WorkGroupID.xy + 1u) * uint(TILE_SIZE)) / screenSize) * 2.0 - 1.0;
+        ndcMax = min(ndcMax, vec2(1.0));
+
+        float nearDepth = -ViewPosition(vec2(0.0), uintBitsToFloat(tileMinDepth)).z;
+        float farDepth = -ViewPosition(vec2(0.0), uintBitsToFloat(tileMaxDepth)).z;
+
+        // side planes pass through the eye and two corners of the tile
+        vec3 bottomLeft = ViewPosition(ndcMin, 1.0);
+        vec3 bottomRight = ViewPosition(vec2(ndcMax.x, ndcMin.y), 1.0);
+        vec3 topLeft = ViewPosition(vec2(ndcMin.x, ndcMax.y), 1.0);
+        vec3 topRight = ViewPosition(ndcMax, 1.0);
+        vec3 center = ViewPosition((ndcMin + ndcMax) * 0.5, 1.0);
+        vec3 planes[4];
+        planes[0] = SidePlane(bottomLeft, topLeft, center);
+        planes[1] = SidePlane(topRight, bottomRight, center);
+        planes[2] = SidePlane(bottomRight, bottomLeft, center);
+        planes[3] = SidePlane(topLeft, topRight, center);
+
+        for(uint i = localIndex; i < uint(lightCount); i += uint(TILE_SIZE * TILE_SIZE))
+        {
+            // spot lights are tested with their bounding sphere
+            vec3 position = (view * vec4(lights[i].positionRadius.xyz, 1.0)).xyz;
+            float radius = lights[i].positionRadius.w;
+
+            bool bInside = ((-position.z + radius) >= nearDepth) && ((-position.z - radius) <= farDepth);
+            for(int p = 0; (p < 4) && (bInside == true); p++)
+            {
+                bInside = dot(planes[p], position) >= -radius;
+            }
+
+            if(bInside == true)
+            {
+                uint slot = atomicAdd(tileLightCount, 1u);
+                if(slot < uint(MAX_LIGHTS_PER_TILE))
+                {
+                    lightIndices[(tileIndex * uint(MAX_LIGHTS_PER_TILE)) + slot] = i;
+                }
+            }
+        }
+    }
+    barrier();
+
+    if(localIndex == 0u)
+    {
+        tiles[tileIndex] = uvec2(tileIndex * uint(MAX_LIGHTS_PER_TILE), min(tileLightCount, uint(MAX_LIGHTS_PER_TILE)));
+    }
+}
+
+// rebuilds the view space position of a normalized device coordinate and a depth buffer value.
+vec3 ViewPosition(vec2 ndc, float depth)
+{
+    vec4 position = inverseProjection * vec4(ndc, (depth * 2.0) - 1.0, 1.0);
+    return position.xyz / position.w;
+}
+
+// gets the unit normal of a plane through the eye, facing into the tile.
+vec3 SidePlane(vec3 cornerA, vec3 cornerB, vec3 center)
+{
+    vec3 normal = normalize(cross(cornerA, cornerB));
+    if(dot(normal, center) < 0.0)
+    {
+        normal = -normal;
+    }
+    return normal;
+}
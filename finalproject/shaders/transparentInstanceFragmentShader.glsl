@@ -0,0 +1,31 @@
+#version 330 core
+layout(location = 0) out vec4 fragmentColor;
+layout(location = 1) out vec4 fragmentRevealage;
+
+in vec3 fragmentVertexNormal;
+in vec4 fragmentInstanceColor;
+
+uniform vec3 lightDirection = vec3(0.0f, -1.0f, 0.0f);
+// true when the boxes write the weighted blend targets, otherwise they
+// are sorted and blended over the window
+uniform bool bWeightedBlend = false;
+
+void main()
+{
+    float diffuse = max(dot(normalize(fragmentVertexNormal), -lightDirection), 0.0f);
+    vec4 color = vec4(fragmentInstanceColor.rgb * (0.35f + (0.65f * diffuse)), fragmentInstanceColor.a);
+
+    if(bWeightedBlend == true)
+    {
+        // must match WriteWeightedBlend() in the scene fragment shader
+        float depthWeight = 1.0f - (gl_FragCoord.z * 0.9f);
+        float weight = clamp(pow(min(1.0f, color.a * 10.0f) + 0.01f, 3.0f) * 1e8 * pow(depthWeight, 3.0f), 1e-2, 3e3);
+
+        fragmentColor = vec4(color.rgb * color.a, color.a) * weight;
+        fragmentRevealage = vec4(color.a);
+    }
+    else
+    {
+        fragmentColor = color;
+    }
+}
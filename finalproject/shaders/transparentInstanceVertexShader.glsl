@@ -0,0 +1,21 @@
+#version 330 core
+layout (location = 0) in vec3 inVertexPosition;
+layout (location = 1) in vec3 inVertexNormal;
+// must match TransparencyManager::TRANSPARENT_INSTANCE
+layout (location = 2) in vec4 inInstancePositionScale;
+layout (location = 3) in vec4 inInstanceColor;
+
+out vec3 fragmentVertexNormal;
+out vec4 fragmentInstanceColor;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+// places one translucent box of the instanced batch
+void main()
+{
+   vec3 worldPosition = inInstancePositionScale.xyz + (inVertexPosition * inInstancePositionScale.w);
+   fragmentVertexNormal = inVertexNormal;
+   fragmentInstanceColor = inInstanceColor;
+   gl_Position = projection * view * vec4(worldPosition, 1.0f);
+}
@@ -0,0 +1,59 @@
+#version 330 core
+out vec4 fragmentColor;
+
+in vec2 fragmentTextureCoordinate;
+
+uniform sampler2D sceneTexture;
+// size in pixels of the corner the scene was drawn into
+uniform vec2 renderSize;
+// size in pixels of the whole scene texture
+uniform vec2 textureSize;
+
+vec3 SampleScene(vec2 pixel, vec2 minPixel, vec2 maxPixel);
+
+// upscales the scene with a Catmull-Rom filter.  The 4x4 texel
+// footprint is reduced to 9 bilinear samples by folding each pair
+// of middle weights into one sample placed between the two texels.
+void main()
+{
+    vec2 samplePosition = fragmentTextureCoordinate * renderSize;
+    vec2 texel1 = floor(samplePosition - 0.5f) + 0.5f;
+    vec2 f = samplePosition - texel1;
+
+    // Catmull-Rom weights of the four texels along each axis
+    vec2 w0 = f * (-0.5f + f * (1.0f - 0.5f * f));
+    vec2 w1 = 1.0f + f * f * (-2.5f + 1.5f * f);
+    vec2 w2 = f * (0.5f + f * (2.0f - 1.5f * f));
+    vec2 w3 = f * f * (-0.5f + 0.5f * f);
+
+    vec2 w12 = w1 + w2;
+    vec2 texel0 = texel1 - 1.0f;
+    vec2 texel3 = texel1 + 2.0f;
+    vec2 texel12 = texel1 + w2 / w12;
+
+    // never read outside the rendered corner, which holds stale pixels
+    vec2 minPixel = vec2(0.5f);
+    vec2 maxPixel = renderSize - 0.5f;
+
+    vec3 color = vec3(0.0f);
+    color += SampleScene(vec2(texel0.x, texel0.y), minPixel, maxPixel) * w0.x * w0.y;
+    color += SampleScene(vec2(texel12.x, texel0.y), minPixel, maxPixel) * w12.x * w0.y;
+    color += SampleScene(vec2(texel3.x, texel0.y), minPixel, maxPixel) * w3.x * w0.y;
+
+    color += SampleScene(vec2(texel0.x, texel12.y), minPixel, maxPixel) * w0.x * w12.y;
+    color += SampleScene(vec2(texel12.x, texel12.y), minPixel, maxPixel) * w12.x * w12.y;
+    color += SampleScene(vec2(texel3.x, texel12.y), minPixel, maxPixel) * w3.x * w12.y;
+
+    color += SampleScene(vec2(texel0.x, texel3.y), minPixel, maxPixel) * w0.x * w3.y;
+    color += SampleScene(vec2(texel12.x, texel3.y), minPixel, maxPixel) * w12.x * w3.y;
+    color += SampleScene(vec2(texel3.x, texel3.y), minPixel, maxPixel) * w3.x * w3.y;
+
+    // the negative lobes can overshoot past black next to bright edges
+    fragmentColor = vec4(max(color, vec3(0.0f)), 1.0f);
+}
+
+// reads the scene with bilinear filtering at a pixel position inside the rendered corner.
+vec3 SampleScene(vec2 pixel, vec2 minPixel, vec2 maxPixel)
+{
+    return texture(sceneTexture, clamp(pixel, minPixel, maxPixel) / textureSize).rgb;
+}
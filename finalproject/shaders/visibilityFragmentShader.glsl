@@ -0,0 +1,10 @@
+#version 430 core
+layout (location = 0) out uint outVisibility;
+
+flat in uint visibilityID;
+
+// only the packed draw and triangle IDs are written per pixel
+void main()
+{
+    outVisibility = visibilityID;
+}
@@ -0,0 +1,87 @@
+#version 430 core
+layout (triangles) in;
+layout (triangle_strip, max_vertices = 3) out;
+
+// must match the limits in VisibilityManager
+#define TRIANGLE_ID_BITS 24
+#define MAX_TRIANGLES 131072
+#define MAX_DRAWS 256
+
+in vec3 fragmentPosition[];
+in vec3 fragmentVertexNormal[];
+in vec2 fragmentTextureCoordinate[];
+
+flat out uint visibilityID;
+
+struct Material {
+    vec3 diffuseColor;
+    vec3 specularColor;
+    float shininess;
+};
+
+// must match the vertex and draw records read by the resolve pass
+struct VisibilityVertex {
+    vec4 positionU;     // xyz = world position, w = texture u
+    vec4 normalV;       // xyz = vertex normal, w = texture v
+};
+
+struct DrawRecord {
+    vec4 objectColor;
+    vec4 diffuseShininess;      // rgb = material diffuse color, a = shininess
+    vec4 specularTexture;       // rgb = material specular color, a = texture slot or -1
+    vec4 uvScaleLighting;       // xy = UV scale, z = 1 when lit
+};
+
+layout(std430, binding = 3) buffer TriangleBuffer {
+    uint triangleCount;
+    VisibilityVertex vertices[];
+};
+layout(std430, binding = 4) writeonly buffer DrawBuffer {
+    DrawRecord draws[];
+};
+
+uniform int drawID = 0;
+uniform bool bUseTexture = false;
+uniform bool bUseLighting = false;
+uniform vec4 objectColor = vec4(1.0f);
+uniform Material material;
+uniform int objectTextureSlot = 0;
+uniform vec2 UVscale = vec2(1.0f, 1.0f);
+
+// stores every triangle of the frame so the resolve pass can fetch its
+// vertices, and tags the pixels it covers with its draw and triangle IDs
+void main()
+{
+    uint triangle = atomicAdd(triangleCount, 1u);
+    if((triangle >= uint(MAX_TRIANGLES)) || (drawID >= MAX_DRAWS))
+    {
+        return;
+    }
+
+    for(int i = 0; i < 3; i++)
+    {
+        vertices[(triangle * 3u) + uint(i)] = VisibilityVertex(
+            vec4(fragmentPosition[i], fragmentTextureCoordinate[i].x),
+            vec4(fragmentVertexNormal[i], fragmentTextureCoordinate[i].y));
+    }
+
+    // the material values are the same for the whole draw
+    if(gl_PrimitiveIDIn == 0)
+    {
+        draws[drawID] = DrawRecord(
+            objectColor,
+            vec4(material.diffuseColor, material.shininess),
+            vec4(material.specularColor, (bUseTexture == true) ? float(objectTextureSlot) : -1.0),
+            vec4(UVscale, (bUseLighting == true) ? 1.0 : 0.0, 0.0));
+    }
+
+    // zero is kept for the pixels that no triangle covers
+    uint packedID = (uint(drawID) << TRIANGLE_ID_BITS) | (triangle + 1u);
+    for(int i = 0; i < 3; i++)
+    {
+        gl_Position = gl_in[i].gl_Position;
+        visibilityID = packedID;
+        EmitVertex();
+    }
+    EndPrimitive();
+}
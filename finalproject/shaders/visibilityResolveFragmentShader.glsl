@@ -0,0 +1,237 @@
+#version 430 core
+out vec4 fragmentColor;
+
+in vec2 fragmentTextureCoordinate;
+
+// must match the limits in VisibilityManager
+#define TRIANGLE_ID_BITS 24
+#define TRIANGLE_ID_MASK 0x00FFFFFFu
+#define SCENE_TEXTURE_COUNT 16
+
+struct DirectionalLight {
+    vec3 direction;
+
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+
+    bool bActive;
+};
+
+// must match LightManager::GPU_LIGHT
+struct GpuLight {
+    vec4 positionRadius;
+    vec4 colorType;
+    vec4 directionCutOff;
+    vec4 spotParams;
+};
+
+struct VisibilityVertex {
+    vec4 positionU;
+    vec4 normalV;
+};
+
+struct DrawRecord {
+    vec4 objectColor;
+    vec4 diffuseShininess;
+    vec4 specularTexture;
+    vec4 uvScaleLighting;
+};
+
+// must match the grid size in ClusterManager
+#define GRID_X 16
+#define GRID_Y 12
+#define GRID_Z 24
+
+#define LIGHT_SPOT 1
+
+layout(std430, binding = 0) readonly buffer LightBuffer {
+    GpuLight lights[];
+};
+layout(std430, binding = 1) readonly buffer ClusterBuffer {
+    uvec2 clusters[];
+};
+layout(std430, binding = 2) readonly buffer LightIndexBuffer {
+    uint lightIndices[];
+};
+layout(std430, binding = 3) readonly buffer TriangleBuffer {
+    uint triangleCount;
+    VisibilityVertex vertices[];
+};
+layout(std430, binding = 4) readonly buffer DrawBuffer {
+    DrawRecord draws[];
+};
+
+uniform usampler2D visibilityTexture;
+uniform sampler2D sceneTextures[SCENE_TEXTURE_COUNT];
+uniform mat4 inverseViewProjection;
+uniform mat4 view;
+uniform vec3 viewPosition;
+uniform DirectionalLight directionalLight;
+uniform vec2 clusterTileSize;
+uniform float clusterSliceScale;
+uniform float clusterSliceBias;
+
+// function prototypes
+vec3 Barycentrics(vec2 pixel, vec3 p0, vec3 p1, vec3 p2);
+vec4 SampleSceneTexture(int slot, vec2 uv, vec2 uvDx, vec2 uvDy);
+uint FindCluster(vec3 fragPos);
+vec3 CalcDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir, vec3 baseColor, DrawRecord draw);
+vec3 CalcClusteredLight(GpuLight light, vec3 normal, vec3 fragPos, vec3 viewDir, vec3 baseColor, DrawRecord draw);
+
+void main()
+{
+    uint visibility = texelFetch(visibilityTexture, ivec2(gl_FragCoord.xy), 0).r;
+    if(visibility == 0u)
+    {
+        fragmentColor = vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        return;
+    }
+
+    DrawRecord draw = draws[visibility >> TRIANGLE_ID_BITS];
+    uint first = ((visibility & TRIANGLE_ID_MASK) - 1u) * 3u;
+    VisibilityVertex v0 = vertices[first];
+    VisibilityVertex v1 = vertices[first + 1u];
+    VisibilityVertex v2 = vertices[first + 2u];
+
+    // barycentrics of this pixel and its neighbours give the
+    // interpolated values and their screen space derivatives
+    vec3 bary = Barycentrics(gl_FragCoord.xy, v0.positionU.xyz, v1.positionU.xyz, v2.positionU.xyz);
+    vec3 baryDx = Barycentrics(gl_FragCoord.xy + vec2(1.0, 0.0), v0.positionU.xyz, v1.positionU.xyz, v2.positionU.xyz);
+    vec3 baryDy = Barycentrics(gl_FragCoord.xy + vec2(0.0, 1.0), v0.positionU.xyz, v1.positionU.xyz, v2.positionU.xyz);
+
+    mat3 positions = mat3(v0.positionU.xyz, v1.positionU.xyz, v2.positionU.xyz);
+    mat3x2 uvs = mat3x2(vec2(v0.positionU.w, v0.normalV.w), vec2(v1.positionU.w, v1.normalV.w), vec2(v2.positionU.w, v2.normalV.w));
+    vec3 fragPos = positions * bary;
+    vec3 norm = normalize(mat3(v0.normalV.xyz, v1.normalV.xyz, v2.normalV.xyz) * bary);
+    vec2 uv = (uvs * bary) * draw.uvScaleLighting.xy;
+    vec2 uvDx = ((uvs * baryDx) * draw.uvScaleLighting.xy) - uv;
+    vec2 uvDy = ((uvs * baryDy) * draw.uvScaleLighting.xy) - uv;
+
+    vec4 baseColor = draw.objectColor;
+    if(draw.specularTexture.a >= 0.0)
+    {
+        baseColor = SampleSceneTexture(int(draw.specularTexture.a), uv, uvDx, uvDy);
+    }
+
+    if(draw.uvScaleLighting.z > 0.5)
+    {
+        vec3 phongResult = vec3(0.0f);
+        vec3 viewDir = normalize(viewPosition - fragPos);
+
+        // phase 1: directional lighting
+        if(directionalLight.bActive == true)
+        {
+            phongResult += CalcDirectionalLight(directionalLight, norm, viewDir, baseColor.rgb, draw);
+        }
+        // phase 2: the point and spot lights binned into this pixel's cluster
+        uvec2 cluster = clusters[FindCluster(fragPos)];
+        for(uint i = 0u; i < cluster.y; i++)
+        {
+            GpuLight light = lights[lightIndices[cluster.x + i]];
+            phongResult += CalcClusteredLight(light, norm, fragPos, viewDir, baseColor.rgb, draw);
+        }
+
+        fragmentColor = vec4(phongResult, 1.0f);
+    }
+    else
+    {
+        fragmentColor = vec4(baseColor.rgb, 1.0f);
+    }
+}
+
+// intersects the camera ray through a pixel with the triangle plane and
+// returns the perspective correct barycentric coordinates of the hit.
+vec3 Barycentrics(vec2 pixel, vec3 p0, vec3 p1, vec3 p2)
+{
+    vec2 ndc = (pixel / vec2(textureSize(visibilityTexture, 0))) * 2.0 - 1.0;
+    vec4 farPoint = inverseViewProjection * vec4(ndc, 1.0, 1.0);
+    vec3 rayDir = (farPoint.xyz / farPoint.w) - viewPosition;
+
+    vec3 edge1 = p1 - p0;
+    vec3 edge2 = p2 - p0;
+    vec3 pvec = cross(rayDir, edge2);
+    float det = dot(edge1, pvec);
+    if(abs(det) < 1e-12)
+    {
+        return vec3(1.0, 0.0, 0.0);
+    }
+    vec3 tvec = viewPosition - p0;
+    float u = dot(tvec, pvec) / det;
+    float v = dot(rayDir, cross(tvec, edge1)) / det;
+    return vec3(1.0 - u - v, u, v);
+}
+
+// samples one of the scene textures, the loop keeps the sampler index
+// dynamically uniform so each pixel only reads the texture it needs.
+vec4 SampleSceneTexture(int slot, vec2 uv, vec2 uvDx, vec2 uvDy)
+{
+    vec4 color = vec4(1.0f);
+    for(int i = 0; i < SCENE_TEXTURE_COUNT; i++)
+    {
+        if(i == slot)
+        {
+            color = textureGrad(sceneTextures[i], uv, uvDx, uvDy);
+        }
+    }
+    return color;
+}
+
+// finds the froxel containing the pixel from its screen position and view depth.
+uint FindCluster(vec3 fragPos)
+{
+    float viewDepth = -(view * vec4(fragPos, 1.0f)).z;
+    uint slice = uint(clamp(floor(log(viewDepth) * clusterSliceScale + clusterSliceBias), 0.0, float(GRID_Z - 1)));
+    uvec2 tile = uvec2(clamp(floor(gl_FragCoord.xy / clusterTileSize), vec2(0.0), vec2(GRID_X - 1, GRID_Y - 1)));
+    return tile.x + (tile.y * GRID_X) + (slice * GRID_X * GRID_Y);
+}
+
+// calculates the color when using a directional light.
+vec3 CalcDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir, vec3 baseColor, DrawRecord draw)
+{
+    vec3 lightDirection = normalize(-light.direction);
+    // diffuse shading
+    float diff = max(dot(normal, lightDirection), 0.0);
+    // specular shading
+    vec3 reflectDir = reflect(-lightDirection, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), draw.diffuseShininess.a);
+    // combine results
+    vec3 ambient = light.ambient * baseColor;
+    vec3 diffuse = light.diffuse * diff * draw.diffuseShininess.rgb * baseColor;
+    vec3 specular = light.specular * spec * draw.specularTexture.rgb * baseColor;
+
+    return (ambient + diffuse + specular);
+}
+
+// calculates the color for a point or spot light with a finite radius.
+vec3 CalcClusteredLight(GpuLight light, vec3 normal, vec3 fragPos, vec3 viewDir, vec3 baseColor, DrawRecord draw)
+{
+    vec3 toLight = light.positionRadius.xyz - fragPos;
+    float distance = length(toLight);
+    // smooth falloff that reaches zero at the light radius
+    float falloff = clamp(1.0 - (distance * distance) / (light.positionRadius.w * light.positionRadius.w), 0.0, 1.0);
+    falloff *= falloff;
+    if(falloff <= 0.0)
+    {
+        return vec3(0.0f);
+    }
+
+    vec3 lightDir = toLight / distance;
+    // spotlight intensity
+    if(int(light.colorType.w) == LIGHT_SPOT)
+    {
+        float theta = dot(lightDir, -light.directionCutOff.xyz);
+        float epsilon = light.directionCutOff.w - light.spotParams.x;
+        falloff *= clamp((theta - light.spotParams.x) / epsilon, 0.0, 1.0);
+    }
+    // diffuse shading
+    float diff = max(dot(normal, lightDir), 0.0);
+    // specular shading
+    vec3 reflectDir = reflect(-lightDir, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), draw.diffuseShininess.a);
+    // combine results
+    vec3 diffuse = light.colorType.rgb * diff * draw.diffuseShininess.rgb * baseColor;
+    vec3 specular = light.colorType.rgb * light.spotParams.y * spec * draw.specularTexture.rgb;
+
+    return (diffuse + specular) * falloff;
+}
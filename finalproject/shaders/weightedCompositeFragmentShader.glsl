@@ -0,0 +1,23 @@
+#version 330 core
+out vec4 fragmentColor;
+
+in vec2 fragmentTextureCoordinate;
+
+uniform sampler2D accumulationTexture;
+uniform sampler2D revealageTexture;
+
+// blends the average translucent color over the opaque scene by the
+// coverage that the revealage target kept
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    float revealage = texelFetch(revealageTexture, pixel, 0).r;
+    if(revealage >= 1.0f)
+    {
+        discard;
+    }
+
+    vec4 accumulation = texelFetch(accumulationTexture, pixel, 0);
+    vec3 averageColor = accumulation.rgb / max(accumulation.a, 1e-5);
+    fragmentColor = vec4(averageColor, 1.0f - revealage);
+}